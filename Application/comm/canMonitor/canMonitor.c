@@ -0,0 +1,313 @@
+/*
+ * canMonitor.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "canMonitor.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define CANMONITOR_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[CANMONITOR_STACK_SIZE];
+
+// Staleness is calculated on demand, only the timeout events run from here
+#define CANMONITOR_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+// Task data
+static TaskHandle_t canMonitorTaskHandle;
+
+/*
+ * Timer wheel. Level 0 has a slot per 1ms tick, level 1 a slot per
+ * 256 ticks. Level 1 slots are moved down to level 0 as their block starts.
+ */
+#define CANMONITOR_WHEEL0_BITS    8U
+#define CANMONITOR_WHEEL0_SLOTS   (1U << CANMONITOR_WHEEL0_BITS)
+#define CANMONITOR_WHEEL0_MASK    (CANMONITOR_WHEEL0_SLOTS - 1U)
+#define CANMONITOR_WHEEL1_SLOTS   64U
+#define CANMONITOR_WHEEL1_MASK    (CANMONITOR_WHEEL1_SLOTS - 1U)
+#define CANMONITOR_NONE           ((uint16_t) 0xFFFFU)
+
+typedef struct
+{
+  CanMonitor_Config_T config;
+  uint32_t lateLimit;           /* Interval counted as late (ticks) */
+
+  // Written from the RX interrupt
+  volatile uint32_t lastRx;     /* Tick count */
+  volatile bool received;
+  volatile uint32_t lateCount;
+  volatile bool rearmQueued;
+
+  // Owned by the monitor task, except expired which the RX interrupt reads
+  volatile bool expired;        /* Timed out, not in the wheel */
+  uint32_t deadline;
+  uint16_t next;                /* Next monitor in the same slot */
+} CanMonitor_T;
+
+static CanMonitor_T monitors[CANMONITOR_MAX_MONITORS];
+static uint16_t numMonitors;
+
+static uint16_t wheel0[CANMONITOR_WHEEL0_SLOTS];
+static uint16_t wheel1[CANMONITOR_WHEEL1_SLOTS];
+static uint32_t wheelTime;      /* Last tick processed */
+
+// Expired monitors received again, queued from the RX interrupt. Each
+// monitor is queued at most once, so this can't overflow.
+#define CANMONITOR_REARM_QUEUE_LEN (CANMONITOR_MAX_MONITORS + 1U)
+static uint16_t rearmQueue[CANMONITOR_REARM_QUEUE_LEN];
+static volatile uint16_t rearmHead;
+static volatile uint16_t rearmTail;
+
+static CanMonitor_Stats_T stats;
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Puts a monitor in the slot for its deadline. The deadline must be
+ * after wheelTime and within CANMONITOR_MAX_TIMEOUT_MS of it.
+ */
+static void CanMonitor_Schedule(uint16_t handle, uint32_t deadline)
+{
+  CanMonitor_T* monitor = &monitors[handle];
+  uint16_t* slot;
+  if (deadline - wheelTime < CANMONITOR_WHEEL0_SLOTS) {
+    slot = &wheel0[deadline & CANMONITOR_WHEEL0_MASK];
+  } else {
+    slot = &wheel1[(deadline >> CANMONITOR_WHEEL0_BITS) & CANMONITOR_WHEEL1_MASK];
+  }
+
+  monitor->deadline = deadline;
+  monitor->next = *slot;
+  *slot = handle;
+}
+
+/**
+ * @brief Handles a monitor whose deadline has come up
+ */
+static void CanMonitor_Expire(uint16_t handle, uint32_t time)
+{
+  CanMonitor_T* monitor = &monitors[handle];
+
+  // Checked and marked together, so a reception either moves the deadline
+  // or sees the monitor expired and queues it to be rearmed
+  taskENTER_CRITICAL();
+  uint32_t deadline = monitor->lastRx + monitor->config.timeoutMs;
+  bool timedOut = !monitor->received || ((int32_t)(deadline - time) <= 0);
+  monitor->expired = timedOut;
+  taskEXIT_CRITICAL();
+
+  if (!timedOut) {
+    CanMonitor_Schedule(handle, deadline);
+    return;
+  }
+
+  stats.timeouts++;
+  if (NULL != monitor->config.callback) {
+    monitor->config.callback(handle, true);
+  }
+}
+
+/**
+ * @brief Moves the wheel on to the given tick, and handles the monitors due
+ */
+static void CanMonitor_Advance(uint32_t time)
+{
+  wheelTime = time;
+
+  uint16_t handle;
+  if (0 == (time & CANMONITOR_WHEEL0_MASK)) {
+    uint16_t* slot = &wheel1[(time >> CANMONITOR_WHEEL0_BITS) & CANMONITOR_WHEEL1_MASK];
+    handle = *slot;
+    *slot = CANMONITOR_NONE;
+    while (CANMONITOR_NONE != handle) {
+      uint16_t next = monitors[handle].next;
+      CanMonitor_Schedule(handle, monitors[handle].deadline);
+      handle = next;
+    }
+  }
+
+  uint16_t* slot = &wheel0[time & CANMONITOR_WHEEL0_MASK];
+  handle = *slot;
+  *slot = CANMONITOR_NONE;
+  while (CANMONITOR_NONE != handle) {
+    uint16_t next = monitors[handle].next;
+    CanMonitor_Expire(handle, time);
+    handle = next;
+  }
+}
+
+static void CanMonitor_Rearm(void)
+{
+  while (rearmTail != rearmHead) {
+    uint16_t handle = rearmQueue[rearmTail];
+    rearmTail = (rearmTail + 1U) % CANMONITOR_REARM_QUEUE_LEN;
+    CanMonitor_T* monitor = &monitors[handle];
+
+    taskENTER_CRITICAL();
+    monitor->expired = false;
+    monitor->rearmQueued = false;
+    uint32_t deadline = monitor->lastRx + monitor->config.timeoutMs;
+    taskEXIT_CRITICAL();
+
+    if ((int32_t)(deadline - wheelTime) <= 0) {
+      deadline = wheelTime + 1U;
+    }
+    CanMonitor_Schedule(handle, deadline);
+
+    stats.recoveries++;
+    if (NULL != monitor->config.callback) {
+      monitor->config.callback(handle, false);
+    }
+  }
+}
+
+static void CanMonitor_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "CanMonitor_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process - catch up on any ticks missed
+      TickType_t now = xTaskGetTickCount();
+      while (wheelTime != now) {
+        CanMonitor_Advance(wheelTime + 1U);
+      }
+
+      CanMonitor_Rearm();
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+CanMonitor_Status_T CanMonitor_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "CanMonitor_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  numMonitors = 0;
+  memset(wheel0, 0xFF, sizeof(wheel0));
+  memset(wheel1, 0xFF, sizeof(wheel1));
+  wheelTime = xTaskGetTickCount();
+  rearmHead = 0;
+  rearmTail = 0;
+  memset(&stats, 0, sizeof(CanMonitor_Stats_T));
+
+  // create main task
+  canMonitorTaskHandle = xTaskCreateStatic(
+      CanMonitor_TaskMain,
+      "CanMonitorTask",
+      CANMONITOR_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      CANMONITOR_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = CANMONITOR_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&canMonitorTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return CANMONITOR_STATUS_ERROR;
+  }
+
+  logPrintS(log, "CanMonitor_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return CANMONITOR_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CanMonitor_Status_T CanMonitor_Register(const CanMonitor_Config_T* config, CanMonitor_Handle_T* handle)
+{
+  if (numMonitors >= CANMONITOR_MAX_MONITORS) {
+    return CANMONITOR_STATUS_ERROR;
+  }
+
+  CanMonitor_T* monitor = &monitors[numMonitors];
+  memset(monitor, 0, sizeof(CanMonitor_T));
+  monitor->config = *config;
+  if (0 == monitor->config.timeoutMs) {
+    monitor->config.timeoutMs = 3U * config->periodMs;
+  }
+  if ((0 == monitor->config.timeoutMs) || (monitor->config.timeoutMs > CANMONITOR_MAX_TIMEOUT_MS)) {
+    char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CanMonitor invalid timeout for 0x%lx\n", config->id);
+    logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return CANMONITOR_STATUS_ERROR;
+  }
+  monitor->lateLimit = (0 == config->periodMs) ? UINT32_MAX : config->periodMs + config->periodMs / 2U;
+
+  *handle = numMonitors;
+  CanMonitor_Schedule(numMonitors, wheelTime + monitor->config.timeoutMs);
+  numMonitors++;
+  stats.monitors = numMonitors;
+
+  return CANMONITOR_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void CanMonitor_Received(CanMonitor_Handle_T handle)
+{
+  if (handle >= numMonitors) {
+    return;
+  }
+
+  CanMonitor_T* monitor = &monitors[handle];
+  uint32_t now = xTaskGetTickCountFromISR();
+  if (monitor->received && (now - monitor->lastRx > monitor->lateLimit)) {
+    monitor->lateCount++;
+  }
+  monitor->lastRx = now;
+  monitor->received = true;
+
+  if (monitor->expired && !monitor->rearmQueued) {
+    monitor->rearmQueued = true;
+    rearmQueue[rearmHead] = handle;
+    rearmHead = (rearmHead + 1U) % CANMONITOR_REARM_QUEUE_LEN;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool CanMonitor_IsStale(CanMonitor_Handle_T handle)
+{
+  return CanMonitor_GetAge(handle) >= monitors[handle].config.timeoutMs;
+}
+
+//------------------------------------------------------------------------------
+uint32_t CanMonitor_GetAge(CanMonitor_Handle_T handle)
+{
+  CanMonitor_T* monitor = &monitors[handle];
+  if (!monitor->received) {
+    return UINT32_MAX;
+  }
+  uint32_t lastRx = monitor->lastRx;
+  return xTaskGetTickCount() - lastRx;
+}
+
+//------------------------------------------------------------------------------
+uint32_t CanMonitor_GetLateCount(CanMonitor_Handle_T handle)
+{
+  return monitors[handle].lateCount;
+}
+
+//------------------------------------------------------------------------------
+void CanMonitor_GetStats(CanMonitor_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
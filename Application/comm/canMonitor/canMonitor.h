@@ -0,0 +1,105 @@
+/*
+ * canMonitor.h
+ *
+ * Freshness and timeout monitoring of received CAN messages.
+ *
+ * Each monitored message is registered alongside its CAN callback with its
+ * expected period and timeout, and the callback reports each reception.
+ * Reporting only records the time, so it is cheap enough for the RX
+ * interrupt. Whether a message is stale is calculated from that time when
+ * asked, so it is always current.
+ *
+ * Timeout events come from a two level timer wheel, advanced every 1ms.
+ * Each monitor sits in the slot of its deadline, so a tick only touches the
+ * monitors that are due. A monitor received since it was scheduled is moved
+ * to its new deadline when its slot comes up, rather than on every
+ * reception. The work per tick does not grow with the number of monitors.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_CANMONITOR_CANMONITOR_H_
+#define COMM_CANMONITOR_CANMONITOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define CANMONITOR_PERIOD_MS        ((uint16_t) 1U)
+
+#define CANMONITOR_MAX_MONITORS     ((uint16_t) 256U)
+
+/* Limited by the span of the wheel */
+#define CANMONITOR_MAX_TIMEOUT_MS   ((uint16_t) 16000U)
+
+typedef enum
+{
+  CANMONITOR_STATUS_OK     = 0x00U,
+  CANMONITOR_STATUS_ERROR  = 0x01U
+} CanMonitor_Status_T;
+
+typedef uint16_t CanMonitor_Handle_T;
+
+/**
+ * Called from the monitor task when a message times out, and when it is
+ * received again afterwards.
+ */
+typedef void (*CanMonitor_Callback_T)(CanMonitor_Handle_T handle, bool timedOut);
+
+typedef struct
+{
+  uint32_t id;                      /* CAN ID, for information */
+  uint16_t periodMs;                /* Expected period */
+  uint16_t timeoutMs;               /* Stale after this long without a message, 0 for 3 periods */
+  CanMonitor_Callback_T callback;   /* May be NULL */
+} CanMonitor_Config_T;
+
+typedef struct
+{
+  uint32_t timeouts;
+  uint32_t recoveries;
+  uint16_t monitors;
+} CanMonitor_Stats_T;
+
+/**
+ * @brief Initialize the monitor
+ * @param logger Pointer to system logger
+ */
+CanMonitor_Status_T CanMonitor_Init(Logging_T* logger);
+
+/**
+ * @brief Start monitoring a message. Must be called during initialization.
+ * The message is stale until first received.
+ * @param config Monitor configuration, copied
+ * @param handle Set to the monitor's handle
+ */
+CanMonitor_Status_T CanMonitor_Register(const CanMonitor_Config_T* config, CanMonitor_Handle_T* handle);
+
+/**
+ * @brief Report that the message has been received. Called from the CAN RX interrupt.
+ */
+void CanMonitor_Received(CanMonitor_Handle_T handle);
+
+/**
+ * @brief True if the message has not been received within its timeout
+ */
+bool CanMonitor_IsStale(CanMonitor_Handle_T handle);
+
+/**
+ * @brief Time since the message was last received (ms), UINT32_MAX if never
+ */
+uint32_t CanMonitor_GetAge(CanMonitor_Handle_T handle);
+
+/**
+ * @brief Number of receptions more than 1.5 periods after the previous one
+ */
+uint32_t CanMonitor_GetLateCount(CanMonitor_Handle_T handle);
+
+/**
+ * @brief Get the monitor statistics
+ */
+void CanMonitor_GetStats(CanMonitor_Stats_T* stats);
+
+#endif /* COMM_CANMONITOR_CANMONITOR_H_ */
@@ -0,0 +1,319 @@
+/*
+ * canRecorder.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "canRecorder.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define CANRECORDER_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[CANRECORDER_STACK_SIZE];
+
+// Only dumps, so below anything with a deadline
+#define CANRECORDER_TASK_PRIORITY (tskIDLE_PRIORITY)
+
+// Task data
+static TaskHandle_t canRecorderTaskHandle;
+
+// Frames stop coming if the bus goes quiet after a trigger
+#define CANRECORDER_POST_TRIGGER_TIMEOUT_MS 1000U
+
+#define CANRECORDER_FLAG_EXT  0x01U
+#define CANRECORDER_FLAG_RTR  0x02U
+
+typedef struct
+{
+  uint64_t timeUs;
+  uint32_t id;
+  uint8_t bus;        /* 1-3 */
+  uint8_t dlc;
+  uint8_t flags;
+  uint8_t data[8];
+} CanRecorder_Frame_T;
+
+static CanRecorder_Frame_T frames[CANRECORDER_MAX_FRAMES];
+static uint16_t head;             /* Next frame written */
+static uint16_t count;
+static uint32_t recorded;
+static uint16_t postRemaining;
+static volatile CanRecorder_State_T state;
+
+// Owned by the task
+static TickType_t triggerTick;
+static uint16_t dumpIndex;
+static uint16_t dumpRemaining;
+
+// Time since start, extended from the cycle counter
+static uint32_t lastCycles;
+static uint32_t spareCycles;      /* Not yet a whole microsecond */
+static uint64_t timeUs;
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Brings the recorder time up to date. Called from the CAN interrupts,
+ * or with them masked, often enough that the cycle counter doesn't wrap.
+ */
+static uint64_t CanRecorder_Now(void)
+{
+  uint32_t cyclesPerUs = SystemCoreClock / 1000000U;
+  uint32_t now = CycleCounter_Get();
+  spareCycles += now - lastCycles;
+  lastCycles = now;
+  timeUs += spareCycles / cyclesPerUs;
+  spareCycles %= cyclesPerUs;
+  return timeUs;
+}
+
+static int8_t CanRecorder_BusNumber(const CAN_HandleTypeDef* hcan)
+{
+  if (CAN1 == hcan->Instance) {
+    return 1;
+  } else if (CAN2 == hcan->Instance) {
+    return 2;
+  } else if (CAN3 == hcan->Instance) {
+    return 3;
+  }
+  return -1;
+}
+
+/**
+ * @brief Stops recording, and starts dumping from the oldest frame.
+ * Called with the CAN interrupts masked.
+ */
+static void CanRecorder_Freeze(void)
+{
+  dumpIndex = (uint16_t)((head + CANRECORDER_MAX_FRAMES - count) % CANRECORDER_MAX_FRAMES);
+  dumpRemaining = count;
+  state = CANRECORDER_STATE_DUMPING;
+}
+
+/**
+ * @brief Adds a frame from the identifier, length and data registers of a
+ * mailbox. RX and TX mailboxes share the register layout.
+ */
+static void CanRecorder_Record(const CAN_HandleTypeDef* hcan, uint32_t ir, uint32_t dtr,
+                               uint32_t dlr, uint32_t dhr)
+{
+  CanRecorder_State_T current = state;
+  if ((CANRECORDER_STATE_RECORDING != current) && (CANRECORDER_STATE_TRIGGERED != current)) {
+    return;
+  }
+
+  int8_t bus = CanRecorder_BusNumber(hcan);
+  if (bus < 0) {
+    return;
+  }
+
+  uint8_t flags = 0;
+  CanRecorder_Frame_T* frame = &frames[head];
+  frame->timeUs = CanRecorder_Now();
+  if (0 != (ir & CAN_RI0R_IDE)) {
+    frame->id = (ir & (CAN_RI0R_STID | CAN_RI0R_EXID)) >> CAN_RI0R_EXID_Pos;
+    flags |= CANRECORDER_FLAG_EXT;
+  } else {
+    frame->id = (ir & CAN_RI0R_STID) >> CAN_RI0R_STID_Pos;
+  }
+  if (0 != (ir & CAN_RI0R_RTR)) {
+    flags |= CANRECORDER_FLAG_RTR;
+  }
+  frame->bus = (uint8_t)bus;
+  frame->dlc = (dtr & CAN_RDT0R_DLC) > 8U ? 8U : (uint8_t)(dtr & CAN_RDT0R_DLC);
+  frame->flags = flags;
+  memcpy(&frame->data[0], &dlr, 4U);
+  memcpy(&frame->data[4], &dhr, 4U);
+
+  head = (uint16_t)((head + 1U) % CANRECORDER_MAX_FRAMES);
+  if (count < CANRECORDER_MAX_FRAMES) {
+    count++;
+  }
+  recorded++;
+
+  if (CANRECORDER_STATE_TRIGGERED == current) {
+    postRemaining--;
+    if (0 == postRemaining) {
+      CanRecorder_Freeze();
+    }
+  }
+}
+
+/**
+ * @brief Logs a frame as a candump log line
+ */
+static void CanRecorder_LogFrame(const CanRecorder_Frame_T* frame)
+{
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+  uint32_t seconds = (uint32_t)(frame->timeUs / 1000000U);
+  uint32_t micros = (uint32_t)(frame->timeUs % 1000000U);
+
+  int len;
+  if (0 != (frame->flags & CANRECORDER_FLAG_EXT)) {
+    len = snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "(%lu.%06lu) can%u %08lX#",
+        seconds, micros, frame->bus, frame->id);
+  } else {
+    len = snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "(%lu.%06lu) can%u %03lX#",
+        seconds, micros, frame->bus, frame->id);
+  }
+
+  if (0 != (frame->flags & CANRECORDER_FLAG_RTR)) {
+    len += snprintf(&logBuffer[len], LOGGING_DEFAULT_BUFF_LEN - len, "R");
+  } else {
+    uint8_t i;
+    for (i = 0; i < frame->dlc; ++i) {
+      len += snprintf(&logBuffer[len], LOGGING_DEFAULT_BUFF_LEN - len, "%02X", frame->data[i]);
+    }
+  }
+  snprintf(&logBuffer[len], LOGGING_DEFAULT_BUFF_LEN - len, "\n");
+
+  logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+}
+
+static void CanRecorder_Dump(void)
+{
+  if (dumpRemaining == count) {
+    logPrintS(log, "CanRecorder dump begin\n", LOGGING_DEFAULT_BUFF_LEN);
+  }
+
+  uint16_t i;
+  for (i = 0; (i < CANRECORDER_DUMP_PER_PERIOD) && (dumpRemaining > 0); ++i) {
+    CanRecorder_LogFrame(&frames[dumpIndex]);
+    dumpIndex = (uint16_t)((dumpIndex + 1U) % CANRECORDER_MAX_FRAMES);
+    dumpRemaining--;
+  }
+
+  if (0 == dumpRemaining) {
+    logPrintS(log, "CanRecorder dump complete\n", LOGGING_DEFAULT_BUFF_LEN);
+    state = CANRECORDER_STATE_STOPPED;
+  }
+}
+
+static void CanRecorder_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "CanRecorder_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      taskENTER_CRITICAL();
+      CanRecorder_Now();
+      if ((CANRECORDER_STATE_TRIGGERED == state) &&
+          (xTaskGetTickCount() - triggerTick >= CANRECORDER_POST_TRIGGER_TIMEOUT_MS / portTICK_PERIOD_MS)) {
+        CanRecorder_Freeze();
+      }
+      taskEXIT_CRITICAL();
+
+      if (CANRECORDER_STATE_DUMPING == state) {
+        CanRecorder_Dump();
+      }
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+CanRecorder_Status_T CanRecorder_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "CanRecorder_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  lastCycles = CycleCounter_Get();
+  spareCycles = 0;
+  timeUs = 0;
+  head = 0;
+  count = 0;
+  recorded = 0;
+  state = CANRECORDER_STATE_RECORDING;
+
+  // create main task
+  canRecorderTaskHandle = xTaskCreateStatic(
+      CanRecorder_TaskMain,
+      "CanRecorderTask",
+      CANRECORDER_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      CANRECORDER_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 10ms
+  uint16_t timerDivider = CANRECORDER_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&canRecorderTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return CANRECORDER_STATUS_ERROR;
+  }
+
+  logPrintS(log, "CanRecorder_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return CANRECORDER_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void CanRecorder_Trigger(void)
+{
+  taskENTER_CRITICAL();
+  if (CANRECORDER_STATE_RECORDING == state) {
+    postRemaining = CANRECORDER_POST_TRIGGER;
+    triggerTick = xTaskGetTickCount();
+    state = CANRECORDER_STATE_TRIGGERED;
+  }
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void CanRecorder_Restart(void)
+{
+  taskENTER_CRITICAL();
+  head = 0;
+  count = 0;
+  recorded = 0;
+  dumpRemaining = 0;
+  state = CANRECORDER_STATE_RECORDING;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void CanRecorder_GetStats(CanRecorder_Stats_T* stats)
+{
+  taskENTER_CRITICAL();
+  stats->state = state;
+  stats->recorded = recorded;
+  stats->buffered = count;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void CanRecorder_RxPending(CAN_HandleTypeDef* hcan, uint32_t fifo)
+{
+  CAN_TypeDef* can = hcan->Instance;
+  uint32_t pending = (CAN_RX_FIFO0 == fifo) ?
+      (can->RF0R & CAN_RF0R_FMP0) : (can->RF1R & CAN_RF1R_FMP1);
+  if (0 == pending) {
+    return;
+  }
+
+  const CAN_FIFOMailBox_TypeDef* rx = &can->sFIFOMailBox[fifo];
+  CanRecorder_Record(hcan, rx->RIR, rx->RDTR, rx->RDLR, rx->RDHR);
+}
+
+//------------------------------------------------------------------------------
+void CanRecorder_TxComplete(CAN_HandleTypeDef* hcan, uint32_t mailbox)
+{
+  const CAN_TxMailBox_TypeDef* tx = &hcan->Instance->sTxMailBox[mailbox];
+  CanRecorder_Record(hcan, tx->TIR, tx->TDTR, tx->TDLR, tx->TDHR);
+}
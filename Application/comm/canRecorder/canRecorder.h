@@ -0,0 +1,91 @@
+/*
+ * canRecorder.h
+ *
+ * Records the CAN traffic received and sent on all buses into a RAM ring
+ * buffer, for dumping to the log in candump log format:
+ *
+ *   (1234.567890) can1 182#0011223344556677
+ *
+ * The recorder runs continuously, overwriting the oldest frames. A trigger
+ * keeps recording for half the buffer more, then freezes the buffer and
+ * dumps it, so the log holds the traffic from either side of the trigger.
+ * The dump is paced over several task periods to keep the log usable.
+ *
+ * Dumped logs can be replayed with the usual tools (canplayer, python-can).
+ * Times are since the recorder started, from the cycle counter.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_CANRECORDER_CANRECORDER_H_
+#define COMM_CANRECORDER_CANRECORDER_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define CANRECORDER_PERIOD_MS         ((uint16_t) 10U)
+
+#define CANRECORDER_MAX_FRAMES        ((uint16_t) 2048U)
+#define CANRECORDER_POST_TRIGGER      ((uint16_t) (CANRECORDER_MAX_FRAMES / 2U))
+#define CANRECORDER_DUMP_PER_PERIOD   ((uint16_t) 8U)  /* Lines logged per period while dumping */
+
+typedef enum
+{
+  CANRECORDER_STATUS_OK     = 0x00U,
+  CANRECORDER_STATUS_ERROR  = 0x01U
+} CanRecorder_Status_T;
+
+typedef enum
+{
+  CANRECORDER_STATE_RECORDING = 0x00U,
+  CANRECORDER_STATE_TRIGGERED = 0x01U,  /* Recording the frames after the trigger */
+  CANRECORDER_STATE_DUMPING   = 0x02U,
+  CANRECORDER_STATE_STOPPED   = 0x03U   /* Dumped, the buffer is kept until restarted */
+} CanRecorder_State_T;
+
+typedef struct
+{
+  CanRecorder_State_T state;
+  uint32_t recorded;      /* Frames recorded since the last restart */
+  uint16_t buffered;      /* Frames currently in the buffer */
+} CanRecorder_Stats_T;
+
+/**
+ * @brief Initialize the recorder and start recording
+ * @param logger Pointer to system logger, the dump is written to it
+ */
+CanRecorder_Status_T CanRecorder_Init(Logging_T* logger);
+
+/**
+ * @brief Freeze and dump the buffer after the post trigger frames. Ignored
+ * unless recording. Safe to call from any task.
+ */
+void CanRecorder_Trigger(void);
+
+/**
+ * @brief Empty the buffer and start recording again
+ */
+void CanRecorder_Restart(void);
+
+/**
+ * @brief Get the recorder statistics
+ */
+void CanRecorder_GetStats(CanRecorder_Stats_T* stats);
+
+/**
+ * @brief Records the frame at the head of an RX FIFO. Called from the CAN RX
+ * interrupts before the HAL handler.
+ */
+void CanRecorder_RxPending(CAN_HandleTypeDef* hcan, uint32_t fifo);
+
+/**
+ * @brief Records a frame sent from a TX mailbox. Called from the CAN TX
+ * complete callbacks.
+ */
+void CanRecorder_TxComplete(CAN_HandleTypeDef* hcan, uint32_t mailbox);
+
+#endif /* COMM_CANRECORDER_CANRECORDER_H_ */
@@ -0,0 +1,291 @@
+/*
+ * canStats.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "canStats.h"
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define CANSTATS_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[CANSTATS_STACK_SIZE];
+
+#define CANSTATS_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+// Task data
+static TaskHandle_t canStatsTaskHandle;
+
+#define CANSTATS_NUM_BUSES 3U
+
+/*
+ * Frame lengths in bits, including the interframe space. The stuffed part
+ * runs from the start of frame to the end of the CRC.
+ */
+#define CANSTATS_STD_FRAME_BITS   47U
+#define CANSTATS_STD_STUFFED_BITS 34U
+#define CANSTATS_EXT_FRAME_BITS   67U
+#define CANSTATS_EXT_STUFFED_BITS 54U
+
+typedef struct
+{
+  CAN_HandleTypeDef* hcan;
+  bool configured;
+
+  // Written from the CAN interrupts
+  volatile uint32_t bits;       /* Since the last period */
+  volatile uint32_t rxFrames;
+  volatile uint32_t txFrames;
+  CanStats_Timestamp_T rxTime;  /* Of the frame being received */
+
+  // Owned by the task
+  CanStats_Bus_T stats;
+} CanStats_BusData_T;
+
+static CanStats_BusData_T buses[CANSTATS_NUM_BUSES];
+
+// ------------------- Private methods -------------------
+static int8_t CanStats_BusIndex(const CAN_HandleTypeDef* hcan)
+{
+  if (CAN1 == hcan->Instance) {
+    return 0;
+  } else if (CAN2 == hcan->Instance) {
+    return 1;
+  } else if (CAN3 == hcan->Instance) {
+    return 2;
+  }
+  return -1;
+}
+
+/**
+ * @brief Worst case length of a data frame, from the identifier and DLC registers
+ */
+static uint32_t CanStats_FrameBits(uint32_t ir, uint32_t dtr)
+{
+  uint32_t dataBits = 8U * ((dtr & CAN_RDT0R_DLC) > 8U ? 8U : (dtr & CAN_RDT0R_DLC));
+  if (0 != (ir & CAN_RI0R_RTR)) {
+    dataBits = 0;
+  }
+
+  // A stuff bit at most every 4 bits after the first 5
+  if (0 != (ir & CAN_RI0R_IDE)) {
+    return CANSTATS_EXT_FRAME_BITS + dataBits + (CANSTATS_EXT_STUFFED_BITS + dataBits - 1U) / 4U;
+  }
+  return CANSTATS_STD_FRAME_BITS + dataBits + (CANSTATS_STD_STUFFED_BITS + dataBits - 1U) / 4U;
+}
+
+static uint32_t CanStats_BitRate(const CAN_HandleTypeDef* hcan)
+{
+  uint32_t quanta = 1U +
+      ((hcan->Init.TimeSeg1 >> CAN_BTR_TS1_Pos) + 1U) +
+      ((hcan->Init.TimeSeg2 >> CAN_BTR_TS2_Pos) + 1U);
+  return HAL_RCC_GetPCLK1Freq() / (hcan->Init.Prescaler * quanta);
+}
+
+/**
+ * @brief Updates the load and error counters of a bus
+ */
+static void CanStats_Update(CanStats_BusData_T* bus)
+{
+  taskENTER_CRITICAL();
+  uint32_t bits = bus->bits;
+  bus->bits = 0;
+  uint32_t rxFrames = bus->rxFrames;
+  uint32_t txFrames = bus->txFrames;
+  taskEXIT_CRITICAL();
+
+  float load = (float)bits / ((float)bus->stats.bitRate * (CANSTATS_PERIOD_MS / 1000.0f));
+
+  CAN_TypeDef* can = bus->hcan->Instance;
+  uint32_t esr = can->ESR;
+  uint8_t lec = (esr & CAN_ESR_LEC) >> CAN_ESR_LEC_Pos;
+
+  // Set the error code to the unused value 7, so a new error can be told
+  // apart from this one. The peripheral clears it after a good frame.
+  if ((0 != lec) && (7U != lec)) {
+    MODIFY_REG(can->ESR, CAN_ESR_LEC, CAN_ESR_LEC);
+  }
+
+  CanStats_ErrorState_T state = CANSTATS_STATE_ACTIVE;
+  if (0 != (esr & CAN_ESR_BOFF)) {
+    state = CANSTATS_STATE_BUS_OFF;
+  } else if (0 != (esr & CAN_ESR_EPVF)) {
+    state = CANSTATS_STATE_PASSIVE;
+  } else if (0 != (esr & CAN_ESR_EWGF)) {
+    state = CANSTATS_STATE_WARNING;
+  }
+
+  taskENTER_CRITICAL();
+  CanStats_Bus_T* stats = &bus->stats;
+  stats->load = load;
+  if (load > stats->peakLoad) {
+    stats->peakLoad = load;
+  }
+  stats->rxFrames = rxFrames;
+  stats->txFrames = txFrames;
+  stats->tec = (esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos;
+  stats->rec = (esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos;
+  if ((0 != lec) && (7U != lec)) {
+    stats->lastError = lec;
+    stats->errorPeriods++;
+  }
+  if ((CANSTATS_STATE_BUS_OFF == state) && (CANSTATS_STATE_BUS_OFF != stats->state)) {
+    stats->busOffCount++;
+  }
+  stats->state = state;
+  taskEXIT_CRITICAL();
+}
+
+static void CanStats_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "CanStats_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      uint8_t i;
+      for (i = 0; i < CANSTATS_NUM_BUSES; ++i) {
+        if (buses[i].configured) {
+          CanStats_Update(&buses[i]);
+        }
+      }
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+CanStats_Status_T CanStats_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "CanStats_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  memset(buses, 0, sizeof(buses));
+
+  // create main task
+  canStatsTaskHandle = xTaskCreateStatic(
+      CanStats_TaskMain,
+      "CanStatsTask",
+      CANSTATS_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      CANSTATS_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 100ms
+  uint16_t timerDivider = CANSTATS_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&canStatsTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return CANSTATS_STATUS_ERROR;
+  }
+
+  logPrintS(log, "CanStats_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return CANSTATS_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CanStats_Status_T CanStats_Config(CAN_HandleTypeDef* hcan)
+{
+  int8_t index = CanStats_BusIndex(hcan);
+  if (index < 0) {
+    return CANSTATS_STATUS_ERROR;
+  }
+
+  // Hardware time stamps are only recorded in time triggered mode
+  if (ENABLE != hcan->Init.TimeTriggeredMode) {
+    logPrintS(log, "CanStats no hardware time stamps\n", LOGGING_DEFAULT_BUFF_LEN);
+  }
+
+  // Transmitted frames are counted as their mailbox completes
+  if (HAL_OK != HAL_CAN_ActivateNotification(hcan, CAN_IT_TX_MAILBOX_EMPTY)) {
+    return CANSTATS_STATUS_ERROR;
+  }
+
+  CanStats_BusData_T* bus = &buses[index];
+  bus->hcan = hcan;
+  bus->stats.bitRate = CanStats_BitRate(hcan);
+  bus->configured = true;
+
+  return CANSTATS_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CanStats_Status_T CanStats_Get(CAN_HandleTypeDef* hcan, CanStats_Bus_T* stats)
+{
+  int8_t index = CanStats_BusIndex(hcan);
+  if ((index < 0) || !buses[index].configured) {
+    return CANSTATS_STATUS_ERROR;
+  }
+
+  taskENTER_CRITICAL();
+  *stats = buses[index].stats;
+  taskEXIT_CRITICAL();
+  return CANSTATS_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void CanStats_GetRxTimestamp(CAN_HandleTypeDef* hcan, CanStats_Timestamp_T* timestamp)
+{
+  int8_t index = CanStats_BusIndex(hcan);
+  if (index >= 0) {
+    *timestamp = buses[index].rxTime;
+  }
+}
+
+//------------------------------------------------------------------------------
+void CanStats_RxPending(CAN_HandleTypeDef* hcan, uint32_t fifo)
+{
+  uint32_t now = CycleCounter_Get();
+  int8_t index = CanStats_BusIndex(hcan);
+  if ((index < 0) || !buses[index].configured) {
+    return;
+  }
+
+  CAN_TypeDef* can = hcan->Instance;
+  uint32_t pending = (CAN_RX_FIFO0 == fifo) ?
+      (can->RF0R & CAN_RF0R_FMP0) : (can->RF1R & CAN_RF1R_FMP1);
+  if (0 == pending) {
+    return;
+  }
+
+  // The head of the FIFO is the frame the HAL dispatches next
+  const CAN_FIFOMailBox_TypeDef* rx = &can->sFIFOMailBox[fifo];
+  uint32_t rdtr = rx->RDTR;
+
+  CanStats_BusData_T* bus = &buses[index];
+  bus->rxTime.cycles = now;
+  bus->rxTime.hwTime = (rdtr & CAN_RDT0R_TIME) >> CAN_RDT0R_TIME_Pos;
+  bus->bits += CanStats_FrameBits(rx->RIR, rdtr);
+  bus->rxFrames++;
+}
+
+//------------------------------------------------------------------------------
+void CanStats_TxComplete(CAN_HandleTypeDef* hcan, uint32_t mailbox)
+{
+  int8_t index = CanStats_BusIndex(hcan);
+  if ((index < 0) || !buses[index].configured) {
+    return;
+  }
+
+  // The mailbox registers keep the frame after it has been sent
+  const CAN_TxMailBox_TypeDef* tx = &hcan->Instance->sTxMailBox[mailbox];
+  CanStats_BusData_T* bus = &buses[index];
+  bus->bits += CanStats_FrameBits(tx->TIR, tx->TDTR);
+  bus->txFrames++;
+}
@@ -0,0 +1,108 @@
+/*
+ * canStats.h
+ *
+ * Receive time stamps, bus load and error counters of the CAN buses.
+ *
+ * The CAN interrupts call in here before the HAL dispatches each frame, so
+ * every frame received or sent is counted and the frame being handled by a
+ * receive callback can be time stamped. Each frame carries two stamps:
+ *  - The cycle counter at interrupt entry, monotonic and comparable with
+ *    other CycleCounter times, but including the interrupt latency.
+ *  - The bxCAN time stamp of the start of frame, counted in bit times by
+ *    the peripheral. This needs time triggered communication mode enabled
+ *    and wraps every 65536 bit times (131ms at 500kbps).
+ *
+ * Bus load is the estimated length of the frames received and sent over each
+ * period, against the bit rate. Frame lengths assume worst case bit stuffing,
+ * so the load is slightly pessimistic. Frames rejected by the filters,
+ * frames in error and error frames aren't seen, so aren't counted.
+ *
+ * The error counters and state are read from the peripheral each period.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_CANSTATS_CANSTATS_H_
+#define COMM_CANSTATS_CANSTATS_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define CANSTATS_PERIOD_MS    ((uint16_t) 100U)
+
+typedef enum
+{
+  CANSTATS_STATUS_OK     = 0x00U,
+  CANSTATS_STATUS_ERROR  = 0x01U
+} CanStats_Status_T;
+
+typedef enum
+{
+  CANSTATS_STATE_ACTIVE   = 0x00U,
+  CANSTATS_STATE_WARNING  = 0x01U,  /* TEC or REC at least 96 */
+  CANSTATS_STATE_PASSIVE  = 0x02U,  /* TEC or REC over 127 */
+  CANSTATS_STATE_BUS_OFF  = 0x03U   /* TEC over 255 */
+} CanStats_ErrorState_T;
+
+typedef struct
+{
+  uint32_t cycles;      /* CycleCounter at interrupt entry */
+  uint16_t hwTime;      /* bxCAN time stamp of the start of frame, bit times */
+} CanStats_Timestamp_T;
+
+typedef struct
+{
+  float load;           /* Fraction of the last period, 0-1 */
+  float peakLoad;       /* Highest load since initialization */
+  uint32_t bitRate;     /* bits/s */
+  uint32_t rxFrames;
+  uint32_t txFrames;
+
+  CanStats_ErrorState_T state;
+  uint8_t tec;          /* Transmit error counter */
+  uint8_t rec;          /* Receive error counter */
+  uint8_t lastError;    /* Last error code (ESR.LEC) seen, 0 if none */
+  uint32_t errorPeriods;  /* Periods in which a bus error occurred */
+  uint32_t busOffCount;   /* Times the bus went off */
+} CanStats_Bus_T;
+
+/**
+ * @brief Initialize the statistics
+ * @param logger Pointer to system logger
+ */
+CanStats_Status_T CanStats_Init(Logging_T* logger);
+
+/**
+ * @brief Start collecting statistics for a bus. The bus must already be
+ * configured and started.
+ */
+CanStats_Status_T CanStats_Config(CAN_HandleTypeDef* hcan);
+
+/**
+ * @brief Get the statistics of a bus
+ */
+CanStats_Status_T CanStats_Get(CAN_HandleTypeDef* hcan, CanStats_Bus_T* stats);
+
+/**
+ * @brief Time stamps of the frame being received. Only valid from within
+ * a CAN receive callback.
+ */
+void CanStats_GetRxTimestamp(CAN_HandleTypeDef* hcan, CanStats_Timestamp_T* timestamp);
+
+/**
+ * @brief Counts the frame at the head of an RX FIFO. Called from the CAN RX
+ * interrupts before the HAL handler.
+ */
+void CanStats_RxPending(CAN_HandleTypeDef* hcan, uint32_t fifo);
+
+/**
+ * @brief Counts a frame sent from a TX mailbox. Called from the CAN TX
+ * complete callbacks.
+ */
+void CanStats_TxComplete(CAN_HandleTypeDef* hcan, uint32_t mailbox);
+
+#endif /* COMM_CANSTATS_CANSTATS_H_ */
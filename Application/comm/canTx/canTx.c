@@ -0,0 +1,21 @@
+/*
+ * canTx.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "canTx.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ------------------- Public methods -------------------
+CAN_Status_T CanTx_Send(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len)
+{
+  UBaseType_t savedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+  CAN_Status_T status = CAN_SendMessage(handle, id, data, len);
+  taskEXIT_CRITICAL_FROM_ISR(savedInterruptStatus);
+
+  return status;
+}
@@ -0,0 +1,35 @@
+/*
+ * canTx.h
+ *
+ * Transmit wrapper around the CAN library, for use by every module that
+ * sends from the application.
+ *
+ * The gateway fills TX mailboxes directly from the FIFO 1 interrupt (see
+ * gateway.h), so a send must not be interrupted between the CAN library
+ * finding a free mailbox and filling it. CanTx_Send masks the interrupts
+ * for the duration of the send. It uses the interrupt safe form of the
+ * critical section, so may be called from tasks, from inside an existing
+ * critical section and from interrupts alike.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_CANTX_CANTX_H_
+#define COMM_CANTX_CANTX_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+
+#include "comm/can/can.h"
+
+/**
+ * @brief Send a frame on a CAN bus, safe against the gateway
+ * @param handle CAN bus to send on
+ * @param id Standard ID
+ * @param data Payload
+ * @param len Payload length, at most 8
+ */
+CAN_Status_T CanTx_Send(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len);
+
+#endif /* COMM_CANTX_CANTX_H_ */
@@ -0,0 +1,227 @@
+/*
+ * gateway.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "gateway.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define GATEWAY_NUM_BUSES 3U
+#define GATEWAY_MAX_IDS_PER_BUS (2U * GATEWAY_FILTER_BANKS)
+
+static const uint32_t filterBankBase[GATEWAY_NUM_BUSES] = {
+  GATEWAY_FILTER_BANK_CAN1,
+  GATEWAY_FILTER_BANK_CAN2,
+  GATEWAY_FILTER_BANK_CAN3,
+};
+
+static const Gateway_Config_T* config;
+
+/*
+ * Compiled table: routes by source bus
+ */
+static uint8_t busRoutes[GATEWAY_NUM_BUSES][GATEWAY_MAX_ROUTES];
+static uint8_t busNumRoutes[GATEWAY_NUM_BUSES];
+
+typedef struct
+{
+  TickType_t minInterval;
+  TickType_t lastForward;
+  bool forwarded;           /* lastForward is valid */
+} Gateway_RouteState_T;
+
+static Gateway_RouteState_T routeState[GATEWAY_MAX_ROUTES];
+
+static Gateway_Stats_T stats;
+
+// ------------------- Private methods -------------------
+static int8_t Gateway_BusIndex(const CAN_HandleTypeDef* hcan)
+{
+  if (CAN1 == hcan->Instance) {
+    return 0;
+  } else if (CAN2 == hcan->Instance) {
+    return 1;
+  } else if (CAN3 == hcan->Instance) {
+    return 2;
+  }
+  return -1;
+}
+
+/**
+ * @brief Accepts the routed IDs of one bus into FIFO 1, two per filter bank
+ */
+static Gateway_Status_T Gateway_ConfigFilters(uint8_t bus)
+{
+  uint32_t ids[GATEWAY_MAX_IDS_PER_BUS];
+  uint8_t numIds = 0;
+  CAN_HandleTypeDef* hcan = NULL;
+
+  uint8_t i;
+  for (i = 0; i < busNumRoutes[bus]; ++i) {
+    const Gateway_Route_T* route = &config->routes[busRoutes[bus][i]];
+    hcan = route->src;
+
+    uint8_t j;
+    for (j = 0; j < numIds; ++j) {
+      if (ids[j] == route->srcId) {
+        break;
+      }
+    }
+    if (j == numIds) {
+      if (numIds >= GATEWAY_MAX_IDS_PER_BUS) {
+        return GATEWAY_STATUS_ERROR;
+      }
+      ids[numIds++] = route->srcId;
+    }
+  }
+
+  if (0 == numIds) {
+    return GATEWAY_STATUS_OK;
+  }
+
+  for (i = 0; i < numIds; i += 2U) {
+    uint32_t id0 = ids[i];
+    uint32_t id1 = (i + 1U < numIds) ? ids[i + 1U] : id0;
+
+    CAN_FilterTypeDef filter;
+    filter.FilterBank = filterBankBase[bus] + i / 2U;
+    filter.FilterMode = CAN_FILTERMODE_IDLIST;
+    filter.FilterScale = CAN_FILTERSCALE_32BIT;
+    filter.FilterIdHigh = (id0 << CAN_RI0R_STID_Pos) >> 16;
+    filter.FilterIdLow = 0;
+    filter.FilterMaskIdHigh = (id1 << CAN_RI0R_STID_Pos) >> 16;
+    filter.FilterMaskIdLow = 0;
+    filter.FilterFIFOAssignment = CAN_FILTER_FIFO1;
+    filter.FilterActivation = ENABLE;
+    filter.SlaveStartFilterBank = GATEWAY_SLAVE_START_BANK;
+    if (HAL_OK != HAL_CAN_ConfigFilter(hcan, &filter)) {
+      return GATEWAY_STATUS_ERROR;
+    }
+  }
+
+  if (HAL_OK != HAL_CAN_ActivateNotification(hcan, CAN_IT_RX_FIFO1_MSG_PENDING)) {
+    return GATEWAY_STATUS_ERROR;
+  }
+
+  return GATEWAY_STATUS_OK;
+}
+
+/**
+ * @brief Copies a received frame into a TX mailbox of the route's destination
+ */
+static void Gateway_Forward(uint8_t index, const CAN_FIFOMailBox_TypeDef* rx, TickType_t now)
+{
+  const Gateway_Route_T* route = &config->routes[index];
+  Gateway_RouteState_T* state = &routeState[index];
+
+  if (state->forwarded && (now - state->lastForward < state->minInterval)) {
+    stats.rateLimited++;
+    return;
+  }
+
+  CAN_TypeDef* can = route->dst->Instance;
+  uint32_t tsr = can->TSR;
+  if (0 == (tsr & (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2))) {
+    stats.txDropped++;
+    return;
+  }
+
+  CAN_TxMailBox_TypeDef* tx = &can->sTxMailBox[(tsr & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos];
+  tx->TIR = (route->dstId << CAN_TI0R_STID_Pos) | (rx->RIR & CAN_RI0R_RTR);
+  tx->TDTR = rx->RDTR & CAN_RDT0R_DLC;
+  tx->TDLR = rx->RDLR;
+  tx->TDHR = rx->RDHR;
+  SET_BIT(tx->TIR, CAN_TI0R_TXRQ);
+
+  state->lastForward = now;
+  state->forwarded = true;
+  stats.forwarded++;
+}
+
+// ------------------- Public methods -------------------
+Gateway_Status_T Gateway_Init(Logging_T* logger, const Gateway_Config_T* gatewayConfig)
+{
+  log = logger;
+  logPrintS(log, "Gateway_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  config = gatewayConfig;
+  if (config->numRoutes > GATEWAY_MAX_ROUTES) {
+    return GATEWAY_STATUS_ERROR;
+  }
+
+  memset(busNumRoutes, 0, sizeof(busNumRoutes));
+  memset(routeState, 0, sizeof(routeState));
+  memset(&stats, 0, sizeof(Gateway_Stats_T));
+
+  // Compile the routing table
+  uint8_t i;
+  for (i = 0; i < config->numRoutes; ++i) {
+    const Gateway_Route_T* route = &config->routes[i];
+    int8_t bus = Gateway_BusIndex(route->src);
+    if ((bus < 0) || (Gateway_BusIndex(route->dst) < 0) || (route->src == route->dst) ||
+        (route->srcId > CAN_RI0R_STID >> CAN_RI0R_STID_Pos) ||
+        (route->dstId > CAN_RI0R_STID >> CAN_RI0R_STID_Pos) ||
+        (route->minIntervalMs > GATEWAY_MAX_INTERVAL_MS)) {
+      char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+      snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Gateway_Init invalid route %u\n", i);
+      logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+      return GATEWAY_STATUS_ERROR;
+    }
+
+    busRoutes[bus][busNumRoutes[bus]++] = i;
+    routeState[i].minInterval = pdMS_TO_TICKS(route->minIntervalMs);
+  }
+
+  uint8_t bus;
+  for (bus = 0; bus < GATEWAY_NUM_BUSES; ++bus) {
+    Gateway_Status_T status = Gateway_ConfigFilters(bus);
+    if (GATEWAY_STATUS_OK != status) {
+      return status;
+    }
+  }
+
+  logPrintS(log, "Gateway_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return GATEWAY_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Gateway_GetStats(Gateway_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Gateway_RxFifo1Callback(CAN_HandleTypeDef* hcan)
+{
+  CAN_TypeDef* can = hcan->Instance;
+  const CAN_FIFOMailBox_TypeDef* rx = &can->sFIFOMailBox[CAN_RX_FIFO1];
+  int8_t bus = Gateway_BusIndex(hcan);
+
+  if ((bus >= 0) && (0 == (rx->RIR & CAN_RI0R_IDE))) {
+    uint32_t id = (rx->RIR & CAN_RI0R_STID) >> CAN_RI0R_STID_Pos;
+    TickType_t now = xTaskGetTickCountFromISR();
+
+    uint8_t i;
+    for (i = 0; i < busNumRoutes[bus]; ++i) {
+      uint8_t index = busRoutes[bus][i];
+      if (config->routes[index].srcId == id) {
+        Gateway_Forward(index, rx, now);
+      }
+    }
+  }
+
+  // Release the FIFO output mailbox. The interrupt fires again if more are pending.
+  SET_BIT(can->RF1R, CAN_RF1R_RFOM1);
+}
@@ -0,0 +1,100 @@
+/*
+ * gateway.h
+ *
+ * CAN gateway, forwarding frames between the CAN buses by a routing table.
+ *
+ * Routed IDs are accepted into RX FIFO 1 of the source bus by dedicated
+ * ID list filters, leaving FIFO 0 to the CAN library. The FIFO 1 interrupt
+ * copies each frame from the receive mailbox registers straight into a free
+ * transmit mailbox on the destination bus, so forwarding never waits on a
+ * task. A route can change the ID and limit the rate it forwards at; frames
+ * arriving sooner than the route's minimum interval are dropped.
+ *
+ * Notes:
+ *  - Standard IDs only.
+ *  - ID list filters take priority over mask filters, so routed IDs are no
+ *    longer delivered to callbacks registered on the source bus.
+ *  - Filter banks GATEWAY_FILTER_BANK_CAN1/2/3 onwards must not be used by
+ *    the CAN library.
+ *  - Frames are dropped if the destination bus has no free TX mailbox.
+ *  - As the interrupt takes a TX mailbox directly, every other transmit on
+ *    any bus must go through CanTx_Send (canTx.h), so a mailbox can't be
+ *    taken between the sender finding it free and filling it.
+ *  - The FIFO 1 interrupt is enabled during Gateway_Init, before the ECU is
+ *    fully initialized, so Gateway_RxFifo1Callback must be called
+ *    unconditionally to release each frame.
+ *  - The rate limit is measured in RTOS ticks, so a route's interval is only
+ *    as precise as the 1ms tick.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_GATEWAY_GATEWAY_H_
+#define COMM_GATEWAY_GATEWAY_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define GATEWAY_MAX_ROUTES          ((uint8_t) 16U)
+
+/* Filter banks reserved per source bus, each holds two IDs */
+#define GATEWAY_FILTER_BANKS        ((uint8_t) 4U)
+#define GATEWAY_FILTER_BANK_CAN1    ((uint32_t) 10U)
+#define GATEWAY_FILTER_BANK_CAN2    ((uint32_t) 24U)
+#define GATEWAY_FILTER_BANK_CAN3    ((uint32_t) 10U)
+#define GATEWAY_SLAVE_START_BANK    ((uint32_t) 14U)  /* CAN1/CAN2 filter bank split */
+
+/* Longest minimum interval a route may have */
+#define GATEWAY_MAX_INTERVAL_MS     ((uint16_t) 10000U)
+
+typedef enum
+{
+  GATEWAY_STATUS_OK     = 0x00U,
+  GATEWAY_STATUS_ERROR  = 0x01U
+} Gateway_Status_T;
+
+typedef struct
+{
+  CAN_HandleTypeDef* src;
+  CAN_HandleTypeDef* dst;
+  uint32_t srcId;
+  uint32_t dstId;           /* ID on the destination bus */
+  uint16_t minIntervalMs;   /* Minimum time between forwarded frames, 0 forwards all */
+} Gateway_Route_T;
+
+typedef struct
+{
+  const Gateway_Route_T* routes;  /* The same source ID may be routed to several buses */
+  uint8_t numRoutes;
+} Gateway_Config_T;
+
+typedef struct
+{
+  uint32_t forwarded;
+  uint32_t rateLimited;
+  uint32_t txDropped;       /* No free TX mailbox on the destination bus */
+} Gateway_Stats_T;
+
+/**
+ * @brief Configure the filters and start forwarding. The CAN buses must
+ * already be configured.
+ * @param logger Pointer to system logger
+ * @param config Routing table, must remain valid
+ */
+Gateway_Status_T Gateway_Init(Logging_T* logger, const Gateway_Config_T* config);
+
+/**
+ * @brief Get the gateway statistics
+ */
+void Gateway_GetStats(Gateway_Stats_T* stats);
+
+/**
+ * @brief Callback for a frame pending in RX FIFO 1
+ */
+void Gateway_RxFifo1Callback(CAN_HandleTypeDef* hcan);
+
+#endif /* COMM_GATEWAY_GATEWAY_H_ */
@@ -0,0 +1,578 @@
+/*
+ * isotp.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "isotp.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "comm/can/can.h"
+#include "comm/canTx/canTx.h"
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define ISOTP_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[ISOTP_STACK_SIZE];
+
+#define ISOTP_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+// Task data
+static TaskHandle_t isoTpTaskHandle;
+
+/*
+ * Protocol control information
+ */
+#define ISOTP_PCI_SINGLE            0x00U
+#define ISOTP_PCI_FIRST             0x10U
+#define ISOTP_PCI_CONSECUTIVE       0x20U
+#define ISOTP_PCI_FLOW_CONTROL      0x30U
+#define ISOTP_PCI_MASK              0xF0U
+
+#define ISOTP_FC_CTS                0x00U
+#define ISOTP_FC_WAIT               0x01U
+#define ISOTP_FC_OVERFLOW           0x02U
+
+#define ISOTP_FRAME_LEN             8U
+#define ISOTP_SF_MAX_DATA           7U
+#define ISOTP_FF_DATA               6U
+#define ISOTP_CF_DATA               7U
+
+typedef enum
+{
+  ISOTP_TX_IDLE,
+  ISOTP_TX_WAIT_FC,
+  ISOTP_TX_SENDING
+} IsoTp_TxState_T;
+
+typedef enum
+{
+  ISOTP_RX_IDLE,
+  ISOTP_RX_RECEIVING
+} IsoTp_RxState_T;
+
+typedef struct
+{
+  IsoTp_ChannelConfig_T config;
+
+  // Sending
+  IsoTp_TxState_T txState;
+  const uint8_t* txData;
+  uint16_t txLen;
+  uint16_t txOffset;
+  uint8_t txSeq;
+  uint8_t txBlockSize;        /* From the receiver's flow control */
+  uint8_t txBlockCount;
+  uint32_t txStMinUs;         /* From the receiver's flow control */
+  bool txFirstInBlock;        /* Next frame starts a block, so is not delayed by STmin */
+  uint32_t txTime;            /* CycleCounter time of the last frame sent or received */
+
+  // Receiving
+  IsoTp_RxState_T rxState;
+  uint8_t* rxData;
+  uint16_t rxLen;
+  uint16_t rxOffset;
+  uint8_t rxSeq;
+  uint8_t rxBlockCount;
+  uint32_t rxTime;
+  bool fcPending;             /* Flow control waiting for a free TX mailbox */
+  uint8_t fcStatus;
+} IsoTp_ChannelData_T;
+
+static IsoTp_ChannelData_T channels[ISOTP_MAX_CHANNELS];
+static uint8_t numChannels;
+
+// Buffer pool
+static uint8_t bufferPool[ISOTP_NUM_BUFFERS][ISOTP_MAX_MESSAGE_LEN];
+static bool bufferInUse[ISOTP_NUM_BUFFERS];
+
+static IsoTp_Stats_T stats;
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Converts an STmin byte to microseconds
+ */
+static uint32_t IsoTp_StMinToMicros(uint8_t stMin)
+{
+  if (stMin <= 0x7FU) {
+    return (uint32_t)stMin * 1000U;
+  } else if (stMin >= 0xF1U && stMin <= 0xF9U) {
+    return (uint32_t)(stMin - 0xF0U) * 100U;
+  } else {
+    // Reserved values are treated as the maximum
+    return 127000U;
+  }
+}
+
+static bool IsoTp_Elapsed(uint32_t since, uint32_t micros)
+{
+  return CycleCounter_ToMicros(CycleCounter_Elapsed(since)) >= micros;
+}
+
+/**
+ * @brief Sends a single padded frame
+ * @return false if no TX mailbox is free
+ */
+static bool IsoTp_SendFrame(IsoTp_ChannelData_T* ch, uint8_t* frame, uint8_t len)
+{
+  if (0 == HAL_CAN_GetTxMailboxesFreeLevel(ch->config.hcan)) {
+    return false;
+  }
+
+  memset(&frame[len], ISOTP_PADDING, ISOTP_FRAME_LEN - len);
+  return CAN_STATUS_OK == CanTx_Send(ch->config.hcan, ch->config.txId, frame, ISOTP_FRAME_LEN);
+}
+
+/**
+ * @brief Sends a flow control frame. If no TX mailbox is free it is left
+ * pending, and retried on the next TX complete or by the task. Must be
+ * called with interrupts masked.
+ */
+static void IsoTp_SendFlowControl(IsoTp_ChannelData_T* ch, uint8_t flowStatus)
+{
+  uint8_t frame[ISOTP_FRAME_LEN];
+  frame[0] = ISOTP_PCI_FLOW_CONTROL | flowStatus;
+  frame[1] = ch->config.blockSize;
+  frame[2] = ch->config.stMin;
+  if (IsoTp_SendFrame(ch, frame, 3)) {
+    ch->fcPending = false;
+    // The sender's wait for the next frame starts from the flow control
+    ch->rxTime = CycleCounter_Get();
+  } else {
+    ch->fcPending = true;
+    ch->fcStatus = flowStatus;
+  }
+}
+
+/**
+ * @brief Takes a buffer from the pool. Must be called with interrupts masked.
+ */
+static uint8_t* IsoTp_TakeBuffer(void)
+{
+  size_t i;
+  for (i = 0; i < ISOTP_NUM_BUFFERS; ++i) {
+    if (!bufferInUse[i]) {
+      bufferInUse[i] = true;
+      return bufferPool[i];
+    }
+  }
+  return NULL;
+}
+
+static void IsoTp_TxFinish(IsoTp_ChannelData_T* ch, IsoTp_Status_T status)
+{
+  ch->txState = ISOTP_TX_IDLE;
+  ch->txData = NULL;
+  if (ISOTP_STATUS_OK == status) {
+    stats.messagesSent++;
+  } else {
+    stats.txErrors++;
+  }
+  if (NULL != ch->config.txCallback) {
+    ch->config.txCallback((IsoTp_Channel_T)(ch - channels), status);
+  }
+}
+
+static void IsoTp_RxAbort(IsoTp_ChannelData_T* ch)
+{
+  if (NULL != ch->rxData) {
+    IsoTp_FreeBuffer(ch->rxData);
+    ch->rxData = NULL;
+  }
+  ch->rxState = ISOTP_RX_IDLE;
+  ch->fcPending = false;
+  stats.rxErrors++;
+}
+
+/**
+ * @brief Sends as many consecutive frames as STmin, the block size and the
+ * free TX mailboxes allow. Must be called with interrupts masked.
+ */
+static void IsoTp_TxContinue(IsoTp_ChannelData_T* ch)
+{
+  while (ISOTP_TX_SENDING == ch->txState) {
+    if (!ch->txFirstInBlock && ch->txStMinUs > 0 && !IsoTp_Elapsed(ch->txTime, ch->txStMinUs)) {
+      return;
+    }
+
+    uint8_t frame[ISOTP_FRAME_LEN];
+    uint16_t remaining = ch->txLen - ch->txOffset;
+    uint8_t n = (remaining > ISOTP_CF_DATA) ? ISOTP_CF_DATA : (uint8_t)remaining;
+    frame[0] = ISOTP_PCI_CONSECUTIVE | ch->txSeq;
+    memcpy(&frame[1], &ch->txData[ch->txOffset], n);
+    if (!IsoTp_SendFrame(ch, frame, 1 + n)) {
+      // Retried on the next TX complete, or by the task
+      return;
+    }
+
+    ch->txOffset += n;
+    ch->txSeq = (ch->txSeq + 1U) & 0x0FU;
+    ch->txTime = CycleCounter_Get();
+    ch->txFirstInBlock = false;
+
+    if (ch->txOffset >= ch->txLen) {
+      IsoTp_TxFinish(ch, ISOTP_STATUS_OK);
+      return;
+    }
+
+    if (ch->txBlockSize > 0 && ++ch->txBlockCount >= ch->txBlockSize) {
+      ch->txState = ISOTP_TX_WAIT_FC;
+      return;
+    }
+  }
+}
+
+static void IsoTp_ReceiveFlowControl(IsoTp_ChannelData_T* ch, const uint8_t* frame)
+{
+  if (ISOTP_TX_WAIT_FC != ch->txState) {
+    return;
+  }
+
+  switch (frame[0] & 0x0FU) {
+    case ISOTP_FC_CTS:
+      ch->txBlockSize = frame[1];
+      ch->txBlockCount = 0;
+      ch->txStMinUs = IsoTp_StMinToMicros(frame[2]);
+      ch->txState = ISOTP_TX_SENDING;
+      ch->txFirstInBlock = true;
+      ch->txTime = CycleCounter_Get();
+      IsoTp_TxContinue(ch);
+      break;
+
+    case ISOTP_FC_WAIT:
+      // Restart N_Bs
+      ch->txTime = CycleCounter_Get();
+      break;
+
+    case ISOTP_FC_OVERFLOW:
+    default:
+      IsoTp_TxFinish(ch, ISOTP_STATUS_ERROR_OVERFLOW);
+      break;
+  }
+}
+
+static void IsoTp_ReceiveSingle(IsoTp_ChannelData_T* ch, const uint8_t* frame, uint8_t dlc)
+{
+  uint8_t len = frame[0] & 0x0FU;
+  if (0 == len || len > ISOTP_SF_MAX_DATA || len + 1U > dlc) {
+    return;
+  }
+
+  if (ISOTP_RX_RECEIVING == ch->rxState) {
+    IsoTp_RxAbort(ch);
+  }
+
+  uint8_t* buffer = IsoTp_TakeBuffer();
+  if (NULL == buffer) {
+    stats.rxErrors++;
+    return;
+  }
+  memcpy(buffer, &frame[1], len);
+  stats.messagesReceived++;
+  ch->config.rxCallback((IsoTp_Channel_T)(ch - channels), buffer, len);
+}
+
+static void IsoTp_ReceiveFirst(IsoTp_ChannelData_T* ch, const uint8_t* frame, uint8_t dlc)
+{
+  uint16_t len = ((uint16_t)(frame[0] & 0x0FU) << 8) | frame[1];
+  if (len <= ISOTP_SF_MAX_DATA || dlc < ISOTP_FRAME_LEN) {
+    return;
+  }
+
+  if (ISOTP_RX_RECEIVING == ch->rxState) {
+    IsoTp_RxAbort(ch);
+  }
+
+  ch->rxData = IsoTp_TakeBuffer();
+  if (NULL == ch->rxData) {
+    stats.rxErrors++;
+    IsoTp_SendFlowControl(ch, ISOTP_FC_OVERFLOW);
+    return;
+  }
+
+  memcpy(ch->rxData, &frame[2], ISOTP_FF_DATA);
+  ch->rxLen = len;
+  ch->rxOffset = ISOTP_FF_DATA;
+  ch->rxSeq = 1;
+  ch->rxBlockCount = 0;
+  ch->rxTime = CycleCounter_Get();
+  ch->rxState = ISOTP_RX_RECEIVING;
+
+  IsoTp_SendFlowControl(ch, ISOTP_FC_CTS);
+}
+
+static void IsoTp_ReceiveConsecutive(IsoTp_ChannelData_T* ch, const uint8_t* frame, uint8_t dlc)
+{
+  if (ISOTP_RX_RECEIVING != ch->rxState) {
+    return;
+  }
+
+  if ((frame[0] & 0x0FU) != ch->rxSeq) {
+    IsoTp_RxAbort(ch);
+    return;
+  }
+
+  // Copy straight into the message buffer
+  uint16_t remaining = ch->rxLen - ch->rxOffset;
+  uint8_t n = (remaining > ISOTP_CF_DATA) ? ISOTP_CF_DATA : (uint8_t)remaining;
+  if (n + 1U > dlc) {
+    IsoTp_RxAbort(ch);
+    return;
+  }
+  memcpy(&ch->rxData[ch->rxOffset], &frame[1], n);
+  ch->rxOffset += n;
+  ch->rxSeq = (ch->rxSeq + 1U) & 0x0FU;
+  ch->rxTime = CycleCounter_Get();
+
+  if (ch->rxOffset >= ch->rxLen) {
+    uint8_t* buffer = ch->rxData;
+    ch->rxData = NULL;
+    ch->rxState = ISOTP_RX_IDLE;
+    stats.messagesReceived++;
+    ch->config.rxCallback((IsoTp_Channel_T)(ch - channels), buffer, ch->rxLen);
+    return;
+  }
+
+  if (ch->config.blockSize > 0 && ++ch->rxBlockCount >= ch->config.blockSize) {
+    ch->rxBlockCount = 0;
+    IsoTp_SendFlowControl(ch, ISOTP_FC_CTS);
+  }
+}
+
+static void IsoTp_CanCallback(const CAN_DataFrame_T* data)
+{
+  size_t i;
+  for (i = 0; i < numChannels; ++i) {
+    IsoTp_ChannelData_T* ch = &channels[i];
+    if (ch->config.rxId != data->msgId || data->dlc < 1) {
+      continue;
+    }
+
+    UBaseType_t savedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    switch (data->data[0] & ISOTP_PCI_MASK) {
+      case ISOTP_PCI_SINGLE:
+        IsoTp_ReceiveSingle(ch, data->data, data->dlc);
+        break;
+      case ISOTP_PCI_FIRST:
+        IsoTp_ReceiveFirst(ch, data->data, data->dlc);
+        break;
+      case ISOTP_PCI_CONSECUTIVE:
+        IsoTp_ReceiveConsecutive(ch, data->data, data->dlc);
+        break;
+      case ISOTP_PCI_FLOW_CONTROL:
+        if (data->dlc >= 3) {
+          IsoTp_ReceiveFlowControl(ch, data->data);
+        }
+        break;
+      default:
+        break;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(savedInterruptStatus);
+  }
+}
+
+static void IsoTp_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "IsoTp_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  const uint32_t timeoutUs = ISOTP_TIMEOUT_MS * 1000U;
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      size_t i;
+      for (i = 0; i < numChannels; ++i) {
+        IsoTp_ChannelData_T* ch = &channels[i];
+
+        taskENTER_CRITICAL();
+        if (ch->fcPending) {
+          IsoTp_SendFlowControl(ch, ch->fcStatus);
+        }
+        if (ISOTP_TX_SENDING == ch->txState) {
+          // Paced by STmin, or waiting on a free mailbox
+          IsoTp_TxContinue(ch);
+        }
+        if (ISOTP_TX_IDLE != ch->txState && IsoTp_Elapsed(ch->txTime, timeoutUs)) {
+          IsoTp_TxFinish(ch, ISOTP_STATUS_ERROR_TIMEOUT);
+        }
+        if (ISOTP_RX_RECEIVING == ch->rxState && IsoTp_Elapsed(ch->rxTime, timeoutUs)) {
+          IsoTp_RxAbort(ch);
+        }
+        taskEXIT_CRITICAL();
+      }
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+IsoTp_Status_T IsoTp_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "IsoTp_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  memset(channels, 0, sizeof(channels));
+  memset(bufferInUse, 0, sizeof(bufferInUse));
+  memset(&stats, 0, sizeof(IsoTp_Stats_T));
+  numChannels = 0;
+
+  // create main task
+  isoTpTaskHandle = xTaskCreateStatic(
+      IsoTp_TaskMain,
+      "IsoTpTask",
+      ISOTP_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      ISOTP_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = ISOTP_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&isoTpTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return ISOTP_STATUS_ERROR;
+  }
+
+  logPrintS(log, "IsoTp_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return ISOTP_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+IsoTp_Status_T IsoTp_Open(const IsoTp_ChannelConfig_T* config, IsoTp_Channel_T* channel)
+{
+  if (numChannels >= ISOTP_MAX_CHANNELS || NULL == config->rxCallback) {
+    return ISOTP_STATUS_ERROR;
+  }
+
+  IsoTp_ChannelData_T* ch = &channels[numChannels];
+  memset(ch, 0, sizeof(IsoTp_ChannelData_T));
+  ch->config = *config;
+  ch->txState = ISOTP_TX_IDLE;
+  ch->rxState = ISOTP_RX_IDLE;
+
+  // Notify TX mailbox completion, used to send the next consecutive frame
+  if (HAL_OK != HAL_CAN_ActivateNotification(config->hcan, CAN_IT_TX_MAILBOX_EMPTY)) {
+    return ISOTP_STATUS_ERROR;
+  }
+
+  CAN_Status_T statusCan = CAN_RegisterCallback(config->hcan, config->rxId, IsoTp_CanCallback);
+  if (CAN_STATUS_OK != statusCan) {
+    return ISOTP_STATUS_ERROR;
+  }
+
+  *channel = numChannels;
+  numChannels++;
+  return ISOTP_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+IsoTp_Status_T IsoTp_Send(IsoTp_Channel_T channel, const uint8_t* data, uint16_t len)
+{
+  if (channel >= numChannels) {
+    return ISOTP_STATUS_ERROR;
+  }
+  if (0 == len || len > ISOTP_MAX_MESSAGE_LEN) {
+    return ISOTP_STATUS_ERROR_LENGTH;
+  }
+
+  IsoTp_ChannelData_T* ch = &channels[channel];
+  IsoTp_Status_T ret = ISOTP_STATUS_OK;
+  uint8_t frame[ISOTP_FRAME_LEN];
+
+  taskENTER_CRITICAL();
+  if (ISOTP_TX_IDLE != ch->txState) {
+    ret = ISOTP_STATUS_ERROR_BUSY;
+  } else if (len <= ISOTP_SF_MAX_DATA) {
+    frame[0] = ISOTP_PCI_SINGLE | (uint8_t)len;
+    memcpy(&frame[1], data, len);
+    if (IsoTp_SendFrame(ch, frame, 1 + len)) {
+      stats.messagesSent++;
+    } else {
+      ret = ISOTP_STATUS_ERROR_BUSY;
+    }
+  } else {
+    frame[0] = ISOTP_PCI_FIRST | (uint8_t)(len >> 8);
+    frame[1] = len & 0xFFU;
+    memcpy(&frame[2], data, ISOTP_FF_DATA);
+    if (IsoTp_SendFrame(ch, frame, ISOTP_FRAME_LEN)) {
+      ch->txData = data;
+      ch->txLen = len;
+      ch->txOffset = ISOTP_FF_DATA;
+      ch->txSeq = 1;
+      ch->txTime = CycleCounter_Get();
+      ch->txState = ISOTP_TX_WAIT_FC;
+    } else {
+      ret = ISOTP_STATUS_ERROR_BUSY;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  // Single frames complete immediately
+  if (ISOTP_STATUS_OK == ret && len <= ISOTP_SF_MAX_DATA && NULL != ch->config.txCallback) {
+    ch->config.txCallback(channel, ISOTP_STATUS_OK);
+  }
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+uint8_t* IsoTp_AllocBuffer(void)
+{
+  taskENTER_CRITICAL();
+  uint8_t* buffer = IsoTp_TakeBuffer();
+  taskEXIT_CRITICAL();
+
+  return buffer;
+}
+
+//------------------------------------------------------------------------------
+void IsoTp_FreeBuffer(uint8_t* buffer)
+{
+  size_t i;
+  for (i = 0; i < ISOTP_NUM_BUFFERS; ++i) {
+    if (buffer == bufferPool[i]) {
+      bufferInUse[i] = false;
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void IsoTp_GetStats(IsoTp_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void IsoTp_TxCompleteCallback(CAN_HandleTypeDef* hcan)
+{
+  size_t i;
+  for (i = 0; i < numChannels; ++i) {
+    IsoTp_ChannelData_T* ch = &channels[i];
+    if (ch->config.hcan != hcan) {
+      continue;
+    }
+    if (ch->fcPending) {
+      IsoTp_SendFlowControl(ch, ch->fcStatus);
+    }
+    if (ISOTP_TX_SENDING == ch->txState) {
+      IsoTp_TxContinue(ch);
+    }
+  }
+}
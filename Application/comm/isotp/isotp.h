@@ -0,0 +1,127 @@
+/*
+ * isotp.h
+ *
+ * ISO 15765-2 (ISO-TP) transport over CAN, for messages up to 4095 bytes.
+ *
+ * Messages are segmented directly from the sender's buffer and reassembled
+ * directly into buffers from a shared pool, so no message is copied as a
+ * whole. Each channel is a pair of CAN IDs with its own flow control
+ * settings, and channels run concurrently.
+ *
+ * Transmission is driven from the CAN TX complete interrupt and reception
+ * from the CAN RX callback. A 1ms task only handles timeouts, STmin
+ * separation of 1ms and above, and retries of consecutive and flow control
+ * frames when all TX mailboxes were busy.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_ISOTP_ISOTP_H_
+#define COMM_ISOTP_ISOTP_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define ISOTP_PERIOD_MS           ((uint16_t) 1U)
+
+#define ISOTP_MAX_CHANNELS        ((uint8_t) 4U)
+#define ISOTP_MAX_MESSAGE_LEN     ((uint16_t) 4095U)
+
+/* Reassembly buffer pool */
+#define ISOTP_NUM_BUFFERS         ((uint8_t) 4U)
+
+/* N_Bs and N_Cr: time to wait for a flow control or consecutive frame */
+#define ISOTP_TIMEOUT_MS          ((uint32_t) 1000U)
+
+/* Value padding unused bytes of a frame */
+#define ISOTP_PADDING             ((uint8_t) 0xCCU)
+
+typedef enum
+{
+  ISOTP_STATUS_OK           = 0x00U,
+  ISOTP_STATUS_ERROR        = 0x01U,
+  ISOTP_STATUS_ERROR_BUSY   = 0x02U,  /* Channel is already sending */
+  ISOTP_STATUS_ERROR_LENGTH = 0x03U,
+  ISOTP_STATUS_ERROR_TIMEOUT  = 0x04U,
+  ISOTP_STATUS_ERROR_OVERFLOW = 0x05U   /* Receiver reported overflow */
+} IsoTp_Status_T;
+
+typedef uint8_t IsoTp_Channel_T;
+
+/**
+ * Called from interrupt context when a message has been received.
+ * Ownership of the buffer passes to the callback, which must return it
+ * with IsoTp_FreeBuffer once it has been processed.
+ */
+typedef void (*IsoTp_RxCallback_T)(IsoTp_Channel_T channel, uint8_t* data, uint16_t len);
+
+/**
+ * Called from interrupt or task context when a send has finished
+ */
+typedef void (*IsoTp_TxCallback_T)(IsoTp_Channel_T channel, IsoTp_Status_T status);
+
+typedef struct
+{
+  CAN_HandleTypeDef* hcan;
+  uint32_t txId;
+  uint32_t rxId;
+  uint8_t blockSize;      /* Block size requested from the sender, 0 for no limit */
+  uint8_t stMin;          /* STmin requested from the sender (ISO-TP encoding) */
+  IsoTp_RxCallback_T rxCallback;
+  IsoTp_TxCallback_T txCallback;  /* May be NULL */
+} IsoTp_ChannelConfig_T;
+
+typedef struct
+{
+  uint32_t messagesSent;
+  uint32_t messagesReceived;
+  uint32_t txErrors;          /* Timeouts and overflows while sending */
+  uint32_t rxErrors;          /* Timeouts, sequence errors and dropped messages */
+} IsoTp_Stats_T;
+
+/**
+ * @brief Initialize the ISO-TP layer
+ * @param logger Pointer to system logger
+ */
+IsoTp_Status_T IsoTp_Init(Logging_T* logger);
+
+/**
+ * @brief Open a channel. Must be called during initialization.
+ * @param config Channel configuration, copied
+ * @param channel Set to the channel number
+ */
+IsoTp_Status_T IsoTp_Open(const IsoTp_ChannelConfig_T* config, IsoTp_Channel_T* channel);
+
+/**
+ * @brief Send a message. Returns once the first frame is queued; data must
+ * remain valid until the channel's TX callback.
+ */
+IsoTp_Status_T IsoTp_Send(IsoTp_Channel_T channel, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Take a buffer from the pool, to build a message in. Must be called
+ * from a task.
+ * @return NULL if none are free. Buffers are ISOTP_MAX_MESSAGE_LEN long.
+ */
+uint8_t* IsoTp_AllocBuffer(void);
+
+/**
+ * @brief Return a buffer to the pool
+ */
+void IsoTp_FreeBuffer(uint8_t* buffer);
+
+/**
+ * @brief Get the layer statistics
+ */
+void IsoTp_GetStats(IsoTp_Stats_T* stats);
+
+/**
+ * @brief Callback for a CAN TX mailbox completing
+ */
+void IsoTp_TxCompleteCallback(CAN_HandleTypeDef* hcan);
+
+#endif /* COMM_ISOTP_ISOTP_H_ */
@@ -0,0 +1,282 @@
+/*
+ * spi.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "spi.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+typedef struct
+{
+  SPI_HandleTypeDef* handle;
+
+  // Ring buffer of pending transaction chains
+  SPI_Transaction_T* queue[SPI_QUEUE_LENGTH];
+  uint16_t head;
+  uint16_t tail;
+  uint16_t count;
+
+  // Transaction currently on the bus (NULL when idle)
+  SPI_Transaction_T* active;
+} SPI_Bus_T;
+
+static SPI_Bus_T buses[SPI_NUM_BUSES];
+static uint16_t numBuses = 0;
+
+// ------------------- Private methods -------------------
+static SPI_Bus_T* SPI_GetBus(SPI_HandleTypeDef* hspi)
+{
+  uint16_t i;
+  for (i = 0; i < numBuses; ++i) {
+    if (buses[i].handle == hspi) {
+      return &buses[i];
+    }
+  }
+  return NULL;
+}
+
+static inline void SPI_AssertCS(const SPI_Transaction_T* transaction)
+{
+  HAL_GPIO_WritePin(transaction->csPort, transaction->csPin, GPIO_PIN_RESET);
+}
+
+static inline void SPI_ReleaseCS(const SPI_Transaction_T* transaction)
+{
+  HAL_GPIO_WritePin(transaction->csPort, transaction->csPin, GPIO_PIN_SET);
+}
+
+/**
+ * @brief Starts the DMA transfer for a single transaction.
+ * Chip select is expected to be asserted by the caller.
+ * Called with the bus interrupts masked (critical section or ISR).
+ */
+static HAL_StatusTypeDef SPI_StartTransfer(SPI_Bus_T* bus, SPI_Transaction_T* transaction)
+{
+  bus->active = transaction;
+  transaction->state = SPI_TRANSACTION_ACTIVE;
+
+  if (NULL == transaction->rxData) {
+    return HAL_SPI_Transmit_DMA(bus->handle, (uint8_t*)transaction->txData, transaction->length);
+  } else if (NULL == transaction->txData) {
+    return HAL_SPI_Receive_DMA(bus->handle, transaction->rxData, transaction->length);
+  } else {
+    return HAL_SPI_TransmitReceive_DMA(
+        bus->handle,
+        (uint8_t*)transaction->txData,
+        transaction->rxData,
+        transaction->length);
+  }
+}
+
+/**
+ * @brief Marks a transaction finished and signals its owner.
+ * Called from interrupt context.
+ */
+static void SPI_Finish(SPI_Transaction_T* transaction, SPI_TransactionState_T state, BaseType_t* pxHigherPriorityTaskWoken)
+{
+  transaction->state = state;
+
+  if (NULL != transaction->callback) {
+    transaction->callback(transaction);
+  }
+  if (NULL != transaction->notifyTask) {
+    vTaskNotifyGiveFromISR(transaction->notifyTask, pxHigherPriorityTaskWoken);
+  }
+}
+
+/**
+ * @brief Fails every remaining link in a chain after an error.
+ */
+static void SPI_FailChain(SPI_Transaction_T* transaction, BaseType_t* pxHigherPriorityTaskWoken)
+{
+  while (NULL != transaction) {
+    SPI_Transaction_T* next = transaction->next;
+    SPI_Finish(transaction, SPI_TRANSACTION_ERROR, pxHigherPriorityTaskWoken);
+    transaction = next;
+  }
+}
+
+/**
+ * @brief Pops chains from the queue until one starts successfully.
+ * Called with the bus interrupts masked (critical section or ISR).
+ * @param pxHigherPriorityTaskWoken Set if a notified task should be switched to
+ */
+static void SPI_StartNextChain(SPI_Bus_T* bus, BaseType_t* pxHigherPriorityTaskWoken)
+{
+  bus->active = NULL;
+
+  while (bus->count > 0) {
+    SPI_Transaction_T* transaction = bus->queue[bus->tail];
+    bus->tail = (bus->tail + 1) % SPI_QUEUE_LENGTH;
+    bus->count--;
+
+    SPI_AssertCS(transaction);
+    if (HAL_OK == SPI_StartTransfer(bus, transaction)) {
+      return;
+    }
+
+    SPI_ReleaseCS(transaction);
+    bus->active = NULL;
+    SPI_FailChain(transaction, pxHigherPriorityTaskWoken);
+  }
+}
+
+/**
+ * @brief Common transfer complete handler for TX, RX and TXRX DMA completion.
+ */
+static void SPI_TransferComplete(SPI_HandleTypeDef* hspi, SPI_TransactionState_T state)
+{
+  SPI_Bus_T* bus = SPI_GetBus(hspi);
+  if (NULL == bus || NULL == bus->active) {
+    return;
+  }
+
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  SPI_Transaction_T* transaction = bus->active;
+  SPI_Transaction_T* next = transaction->next;
+
+  if (SPI_TRANSACTION_DONE == state && NULL != next) {
+    // Continue the chain. Only toggle chip select if the next link uses a different device.
+    bool sameDevice = (next->csPort == transaction->csPort) && (next->csPin == transaction->csPin);
+    if (!sameDevice) {
+      SPI_ReleaseCS(transaction);
+    }
+    SPI_Finish(transaction, state, &xHigherPriorityTaskWoken);
+
+    if (!sameDevice) {
+      SPI_AssertCS(next);
+    }
+    if (HAL_OK != SPI_StartTransfer(bus, next)) {
+      SPI_ReleaseCS(next);
+      SPI_FailChain(next, &xHigherPriorityTaskWoken);
+      SPI_StartNextChain(bus, &xHigherPriorityTaskWoken);
+    }
+  } else {
+    SPI_ReleaseCS(transaction);
+    if (SPI_TRANSACTION_DONE == state) {
+      SPI_Finish(transaction, state, &xHigherPriorityTaskWoken);
+    } else {
+      SPI_FailChain(transaction, &xHigherPriorityTaskWoken);
+    }
+    SPI_StartNextChain(bus, &xHigherPriorityTaskWoken);
+  }
+
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// ------------------- Public methods -------------------
+SPI_Status_T SPI_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "SPI_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  memset(buses, 0, sizeof(buses));
+  numBuses = 0;
+
+  logPrintS(log, "SPI_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return SPI_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+SPI_Status_T SPI_Config(SPI_HandleTypeDef* hspi)
+{
+  if (numBuses >= SPI_NUM_BUSES) {
+    return SPI_STATUS_ERROR_CONFIG;
+  }
+
+  // Both directions need DMA for full-duplex transfers
+  if (NULL == hspi->hdmatx || NULL == hspi->hdmarx) {
+    return SPI_STATUS_ERROR_CONFIG;
+  }
+
+  SPI_Bus_T* bus = &buses[numBuses];
+  memset(bus, 0, sizeof(SPI_Bus_T));
+  bus->handle = hspi;
+  numBuses++;
+
+  return SPI_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+SPI_Status_T SPI_Submit(SPI_HandleTypeDef* hspi, SPI_Transaction_T* transaction)
+{
+  SPI_Bus_T* bus = SPI_GetBus(hspi);
+  if (NULL == bus) {
+    return SPI_STATUS_ERROR_CONFIG;
+  }
+
+  // Validate the chain before it is visible to the ISR
+  SPI_Transaction_T* link;
+  for (link = transaction; NULL != link; link = link->next) {
+    if (0 == link->length || (NULL == link->txData && NULL == link->rxData)) {
+      return SPI_STATUS_ERROR;
+    }
+    if (SPI_TRANSACTION_QUEUED == link->state || SPI_TRANSACTION_ACTIVE == link->state) {
+      return SPI_STATUS_ERROR_BUSY;
+    }
+  }
+
+  SPI_Status_T status = SPI_STATUS_OK;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  taskENTER_CRITICAL();
+  if (bus->count >= SPI_QUEUE_LENGTH) {
+    status = SPI_STATUS_ERROR_FULL;
+  } else {
+    for (link = transaction; NULL != link; link = link->next) {
+      link->state = SPI_TRANSACTION_QUEUED;
+    }
+
+    bus->queue[bus->head] = transaction;
+    bus->head = (bus->head + 1) % SPI_QUEUE_LENGTH;
+    bus->count++;
+
+    if (NULL == bus->active) {
+      // Bus is idle - kick it off. Completion is notified from the ISR.
+      SPI_StartNextChain(bus, &xHigherPriorityTaskWoken);
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  // Only set if the chain failed to start and its owner was notified
+  if (pdTRUE == xHigherPriorityTaskWoken) {
+    taskYIELD();
+  }
+
+  return status;
+}
+
+//------------------------------------------------------------------------------
+bool SPI_IsComplete(const SPI_Transaction_T* transaction)
+{
+  return SPI_TRANSACTION_DONE == transaction->state ||
+         SPI_TRANSACTION_ERROR == transaction->state;
+}
+
+// ------------------- HAL callbacks -------------------
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+  SPI_TransferComplete(hspi, SPI_TRANSACTION_DONE);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+  SPI_TransferComplete(hspi, SPI_TRANSACTION_DONE);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+  SPI_TransferComplete(hspi, SPI_TRANSACTION_DONE);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{
+  SPI_TransferComplete(hspi, SPI_TRANSACTION_ERROR);
+}
@@ -0,0 +1,107 @@
+/*
+ * spi.h
+ *
+ * Asynchronous SPI transaction queue.
+ *
+ * Transactions are queued per bus and run back-to-back using full-duplex DMA.
+ * The chip select line for each transaction is driven by the driver, so the
+ * caller never busy-waits on the bus. Completion is signalled from the SPI/DMA
+ * interrupt via task notification and/or a callback.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_SPI_SPI_H_
+#define COMM_SPI_SPI_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lib/logging/logging.h"
+
+#define SPI_NUM_BUSES     ((uint16_t) 1U)
+#define SPI_QUEUE_LENGTH  ((uint16_t) 16U)
+
+typedef enum
+{
+  SPI_STATUS_OK             = 0x00U,
+  SPI_STATUS_ERROR          = 0x01U,
+  SPI_STATUS_ERROR_CONFIG   = 0x02U,
+  SPI_STATUS_ERROR_FULL     = 0x03U,
+  SPI_STATUS_ERROR_BUSY     = 0x04U
+} SPI_Status_T;
+
+typedef enum
+{
+  SPI_TRANSACTION_IDLE      = 0x00U,
+  SPI_TRANSACTION_QUEUED    = 0x01U,
+  SPI_TRANSACTION_ACTIVE    = 0x02U,
+  SPI_TRANSACTION_DONE      = 0x03U,
+  SPI_TRANSACTION_ERROR     = 0x04U
+} SPI_TransactionState_T;
+
+typedef struct SPI_Transaction_S SPI_Transaction_T;
+
+/**
+ * @brief Called from interrupt context when a transaction has finished.
+ * Must be short and may only use FromISR RTOS calls.
+ */
+typedef void (*SPI_Callback)(SPI_Transaction_T* transaction);
+
+struct SPI_Transaction_S
+{
+  const uint8_t* txData;    /* NULL for receive only */
+  uint8_t* rxData;          /* NULL for transmit only */
+  uint16_t length;
+
+  GPIO_TypeDef* csPort;     /* Chip select (active low) */
+  uint16_t csPin;
+
+  /*
+   * Next transaction in the chain. Chained transactions are run back-to-back
+   * without returning to the queue. Chip select stays asserted between links
+   * that share the same chip select.
+   */
+  SPI_Transaction_T* next;
+
+  TaskHandle_t notifyTask;  /* Notified (vTaskNotifyGiveFromISR) on completion, may be NULL */
+  SPI_Callback callback;    /* Called on completion, may be NULL */
+
+  /* Owned by the driver */
+  volatile SPI_TransactionState_T state;
+};
+
+/**
+ * @brief Initialize the SPI driver
+ * @param logger Pointer to system logger
+ */
+SPI_Status_T SPI_Init(Logging_T* logger);
+
+/**
+ * @brief Configure a SPI bus for use with the transaction queue.
+ * The bus must already be initialized by HAL with DMA linked on TX and RX.
+ * @param hspi SPI bus handle
+ */
+SPI_Status_T SPI_Config(SPI_HandleTypeDef* hspi);
+
+/**
+ * @brief Queue a transaction (or chain of transactions) on a bus.
+ * The transaction structures and data buffers must remain valid until the
+ * transaction reaches the DONE or ERROR state.
+ * Not safe to call from an ISR.
+ * @param hspi SPI bus handle
+ * @param transaction Head of the transaction chain
+ */
+SPI_Status_T SPI_Submit(SPI_HandleTypeDef* hspi, SPI_Transaction_T* transaction);
+
+/**
+ * @brief Checks whether a transaction has completed (successfully or not).
+ */
+bool SPI_IsComplete(const SPI_Transaction_T* transaction);
+
+#endif /* COMM_SPI_SPI_H_ */
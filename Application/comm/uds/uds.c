@@ -0,0 +1,692 @@
+/*
+ * uds.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "uds.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "comm/can/can.h"
+#include "comm/canTx/canTx.h"
+#include "comm/isotp/isotp.h"
+#include "time/tasktimer/tasktimer.h"
+#include "startup/bootControl.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define UDS_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[UDS_STACK_SIZE];
+
+// Lowest of the application tasks, periodic data never delays the control loop
+#define UDS_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+// Task data
+static TaskHandle_t udsTaskHandle;
+
+/*
+ * Service identifiers
+ */
+#define UDS_SID_SESSION_CONTROL       0x10U
+#define UDS_SID_ECU_RESET             0x11U
+#define UDS_SID_CLEAR_DTC             0x14U
+#define UDS_SID_READ_DTC              0x19U
+#define UDS_SID_READ_DID              0x22U
+#define UDS_SID_READ_PERIODIC_DID     0x2AU
+#define UDS_SID_TESTER_PRESENT        0x3EU
+#define UDS_POSITIVE_RESPONSE         0x40U
+#define UDS_NEGATIVE_RESPONSE         0x7FU
+
+/* Suppress positive response bit of a sub-function */
+#define UDS_SPRMIB                    0x80U
+
+/*
+ * Negative response codes
+ */
+#define UDS_NRC_SERVICE_NOT_SUPPORTED     0x11U
+#define UDS_NRC_SUBFUNCTION_NOT_SUPPORTED 0x12U
+#define UDS_NRC_INCORRECT_LENGTH          0x13U
+#define UDS_NRC_RESPONSE_TOO_LONG         0x14U
+#define UDS_NRC_CONDITIONS_NOT_CORRECT    0x22U
+#define UDS_NRC_REQUEST_OUT_OF_RANGE      0x31U
+#define UDS_NRC_RESPONSE_PENDING          0x78U
+#define UDS_NRC_SERVICE_NOT_IN_SESSION    0x7FU
+
+/*
+ * Sub-functions and parameters
+ */
+#define UDS_RESET_HARD                0x01U
+#define UDS_RESET_SOFT                0x03U
+#define UDS_DTC_REPORT_NUMBER         0x01U
+#define UDS_DTC_REPORT_BY_MASK        0x02U
+#define UDS_DTC_FORMAT_14229          0x01U
+#define UDS_DTC_GROUP_ALL             ((uint32_t) 0xFFFFFFU)
+#define UDS_PERIODIC_MODE_SLOW        0x01U
+#define UDS_PERIODIC_MODE_MEDIUM      0x02U
+#define UDS_PERIODIC_MODE_FAST        0x03U
+#define UDS_PERIODIC_MODE_STOP        0x04U
+
+/* Session timing reported to the tester */
+#define UDS_P2_MS                     50U
+#define UDS_P2_STAR_MS                5000U
+
+/* DTC status bits */
+#define UDS_DTC_TEST_FAILED           0x01U
+#define UDS_DTC_CONFIRMED             0x08U
+#define UDS_DTC_AVAILABILITY_MASK     (UDS_DTC_TEST_FAILED | UDS_DTC_CONFIRMED)
+
+/*
+ * DID index, by page (high byte) then low byte
+ */
+#define UDS_DID_PAGE_FIRST            0xF1U
+#define UDS_DID_PAGE_PERIODIC         0xF2U
+#define UDS_DID_NUM_PAGES             2U
+#define UDS_DID_NONE                  0xFFU
+
+static uint8_t didIndex[UDS_DID_NUM_PAGES][256];
+
+/*
+ * Periodic rates, indexed by transmission mode - 1. The medium and slow
+ * rates are offset so their frames do not land on the same tick.
+ */
+typedef struct
+{
+  uint16_t periodMs;
+  uint16_t offsetMs;
+} Uds_Rate_T;
+
+static const Uds_Rate_T rates[] = {
+  { UDS_PERIODIC_SLOW_MS,   2U * UDS_PERIOD_MS },
+  { UDS_PERIODIC_MEDIUM_MS, 1U * UDS_PERIOD_MS },
+  { UDS_PERIODIC_FAST_MS,   0U },
+};
+#define UDS_NUM_RATES (sizeof(rates) / sizeof(rates[0]))
+
+/*
+ * Periodic schedule, resolved to DID entries when requested
+ */
+static const Uds_Did_T* periodicDid[UDS_MAX_PERIODIC_DIDS];
+static uint8_t periodicRate[UDS_MAX_PERIODIC_DIDS];
+static uint8_t numPeriodic;
+
+/*
+ * Action taken once the response has been sent
+ */
+typedef enum
+{
+  UDS_ACTION_NONE,
+  UDS_ACTION_RESET,
+  UDS_ACTION_BOOTLOADER
+} Uds_Action_T;
+
+static const Uds_Config_T* config;
+static CAN_HandleTypeDef* canHandle;
+static IsoTp_Channel_T channel;
+
+static volatile Uds_Session_T session;
+static uint32_t s3Time;
+static uint32_t time;
+static Uds_Action_T pendingAction;
+
+static uint8_t dtcStatus[UDS_MAX_DTCS];
+
+// Single request mailbox, filled from the ISO-TP receive interrupt
+static uint8_t* volatile requestData;
+static volatile uint16_t requestLen;
+
+static uint8_t response[UDS_MAX_RESPONSE_LEN];
+static volatile bool txBusy;
+static uint16_t pendingResponseLen;   /* Response waiting for a free mailbox, 0 if none */
+static uint32_t pendingResponseTime;
+
+static Uds_Stats_T stats;
+
+// ------------------- Private methods -------------------
+static const Uds_Did_T* Uds_FindDid(uint16_t did)
+{
+  uint8_t page = (uint8_t)(did >> 8);
+  if ((page < UDS_DID_PAGE_FIRST) || (page >= UDS_DID_PAGE_FIRST + UDS_DID_NUM_PAGES)) {
+    return NULL;
+  }
+
+  uint8_t index = didIndex[page - UDS_DID_PAGE_FIRST][did & 0xFFU];
+  return (UDS_DID_NONE == index) ? NULL : &config->dids[index];
+}
+
+static uint8_t Uds_FindPeriodic(const Uds_Did_T* did)
+{
+  uint8_t i;
+  for (i = 0; i < numPeriodic; ++i) {
+    if (periodicDid[i] == did) {
+      break;
+    }
+  }
+  return i;
+}
+
+static void Uds_StopPeriodic(void)
+{
+  numPeriodic = 0;
+}
+
+static uint16_t Uds_Negative(uint8_t sid, uint8_t nrc)
+{
+  response[0] = UDS_NEGATIVE_RESPONSE;
+  response[1] = sid;
+  response[2] = nrc;
+  return 3U;
+}
+
+static uint16_t Uds_SessionControl(const uint8_t* req, uint16_t len)
+{
+  if (2U != len) {
+    return Uds_Negative(UDS_SID_SESSION_CONTROL, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  uint8_t sub = req[1] & ~UDS_SPRMIB;
+  switch (sub) {
+    case UDS_SESSION_DEFAULT:
+      Uds_StopPeriodic();
+      break;
+
+    case UDS_SESSION_EXTENDED:
+      break;
+
+    case UDS_SESSION_PROGRAMMING:
+      if (!config->resetAllowed()) {
+        return Uds_Negative(UDS_SID_SESSION_CONTROL, UDS_NRC_CONDITIONS_NOT_CORRECT);
+      }
+      // The bootloader sends the final response once it is running
+      pendingAction = UDS_ACTION_BOOTLOADER;
+      return Uds_Negative(UDS_SID_SESSION_CONTROL, UDS_NRC_RESPONSE_PENDING);
+
+    default:
+      return Uds_Negative(UDS_SID_SESSION_CONTROL, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+  }
+
+  session = (Uds_Session_T)sub;
+  if (req[1] & UDS_SPRMIB) {
+    return 0;
+  }
+
+  response[0] = UDS_SID_SESSION_CONTROL + UDS_POSITIVE_RESPONSE;
+  response[1] = sub;
+  response[2] = (uint8_t)(UDS_P2_MS >> 8);
+  response[3] = (uint8_t)UDS_P2_MS;
+  response[4] = (uint8_t)((UDS_P2_STAR_MS / 10U) >> 8);
+  response[5] = (uint8_t)(UDS_P2_STAR_MS / 10U);
+  return 6U;
+}
+
+static uint16_t Uds_EcuReset(const uint8_t* req, uint16_t len)
+{
+  if (2U != len) {
+    return Uds_Negative(UDS_SID_ECU_RESET, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  uint8_t sub = req[1] & ~UDS_SPRMIB;
+  if ((UDS_RESET_HARD != sub) && (UDS_RESET_SOFT != sub)) {
+    return Uds_Negative(UDS_SID_ECU_RESET, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+  }
+  if (!config->resetAllowed()) {
+    return Uds_Negative(UDS_SID_ECU_RESET, UDS_NRC_CONDITIONS_NOT_CORRECT);
+  }
+
+  pendingAction = UDS_ACTION_RESET;
+  if (req[1] & UDS_SPRMIB) {
+    return 0;
+  }
+
+  response[0] = UDS_SID_ECU_RESET + UDS_POSITIVE_RESPONSE;
+  response[1] = sub;
+  return 2U;
+}
+
+static uint16_t Uds_ClearDtc(const uint8_t* req, uint16_t len)
+{
+  if (4U != len) {
+    return Uds_Negative(UDS_SID_CLEAR_DTC, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  uint32_t group = ((uint32_t)req[1] << 16) | ((uint32_t)req[2] << 8) | req[3];
+  bool found = false;
+  uint8_t i;
+  for (i = 0; i < config->numDtcs; ++i) {
+    if ((UDS_DTC_GROUP_ALL == group) || (config->dtcs[i].code == group)) {
+      dtcStatus[i] = 0;
+      found = true;
+    }
+  }
+  if (!found && (UDS_DTC_GROUP_ALL != group)) {
+    return Uds_Negative(UDS_SID_CLEAR_DTC, UDS_NRC_REQUEST_OUT_OF_RANGE);
+  }
+
+  response[0] = UDS_SID_CLEAR_DTC + UDS_POSITIVE_RESPONSE;
+  return 1U;
+}
+
+static uint16_t Uds_ReadDtc(const uint8_t* req, uint16_t len)
+{
+  if (len < 2U) {
+    return Uds_Negative(UDS_SID_READ_DTC, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  uint8_t sub = req[1];
+  if ((UDS_DTC_REPORT_NUMBER != sub) && (UDS_DTC_REPORT_BY_MASK != sub)) {
+    return Uds_Negative(UDS_SID_READ_DTC, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+  }
+  if (3U != len) {
+    return Uds_Negative(UDS_SID_READ_DTC, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  uint8_t mask = req[2];
+  response[0] = UDS_SID_READ_DTC + UDS_POSITIVE_RESPONSE;
+  response[1] = sub;
+  response[2] = UDS_DTC_AVAILABILITY_MASK;
+
+  uint16_t pos = 3U;
+  uint16_t count = 0;
+  uint8_t i;
+  for (i = 0; i < config->numDtcs; ++i) {
+    if (0 == (dtcStatus[i] & mask)) {
+      continue;
+    }
+    count++;
+    if (UDS_DTC_REPORT_BY_MASK == sub) {
+      uint32_t code = config->dtcs[i].code;
+      response[pos++] = (uint8_t)(code >> 16);
+      response[pos++] = (uint8_t)(code >> 8);
+      response[pos++] = (uint8_t)code;
+      response[pos++] = dtcStatus[i];
+    }
+  }
+
+  if (UDS_DTC_REPORT_NUMBER == sub) {
+    response[pos++] = UDS_DTC_FORMAT_14229;
+    response[pos++] = (uint8_t)(count >> 8);
+    response[pos++] = (uint8_t)count;
+  }
+  return pos;
+}
+
+static uint16_t Uds_ReadDid(const uint8_t* req, uint16_t len)
+{
+  if ((len < 3U) || (0 == (len & 1U))) {
+    return Uds_Negative(UDS_SID_READ_DID, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  response[0] = UDS_SID_READ_DID + UDS_POSITIVE_RESPONSE;
+  uint16_t pos = 1U;
+  uint16_t i;
+  for (i = 1U; i < len; i += 2U) {
+    uint16_t id = ((uint16_t)req[i] << 8) | req[i + 1U];
+    const Uds_Did_T* did = Uds_FindDid(id);
+    if (NULL == did) {
+      // Unsupported DIDs are left out, unless none are supported
+      continue;
+    }
+    if (pos + 2U + did->len > UDS_MAX_RESPONSE_LEN) {
+      return Uds_Negative(UDS_SID_READ_DID, UDS_NRC_RESPONSE_TOO_LONG);
+    }
+    response[pos++] = req[i];
+    response[pos++] = req[i + 1U];
+    did->read(&response[pos]);
+    pos += did->len;
+  }
+
+  if (1U == pos) {
+    return Uds_Negative(UDS_SID_READ_DID, UDS_NRC_REQUEST_OUT_OF_RANGE);
+  }
+  return pos;
+}
+
+static uint16_t Uds_ReadPeriodicDid(const uint8_t* req, uint16_t len)
+{
+  if (UDS_SESSION_EXTENDED != session) {
+    return Uds_Negative(UDS_SID_READ_PERIODIC_DID, UDS_NRC_SERVICE_NOT_IN_SESSION);
+  }
+  if (len < 2U) {
+    return Uds_Negative(UDS_SID_READ_PERIODIC_DID, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  uint8_t mode = req[1];
+  if ((mode < UDS_PERIODIC_MODE_SLOW) || (mode > UDS_PERIODIC_MODE_STOP)) {
+    return Uds_Negative(UDS_SID_READ_PERIODIC_DID, UDS_NRC_REQUEST_OUT_OF_RANGE);
+  }
+  if ((UDS_PERIODIC_MODE_STOP != mode) && (len < 3U)) {
+    return Uds_Negative(UDS_SID_READ_PERIODIC_DID, UDS_NRC_INCORRECT_LENGTH);
+  }
+
+  // Check the whole request before changing the schedule
+  uint8_t added = 0;
+  uint16_t i;
+  for (i = 2U; i < len; ++i) {
+    const Uds_Did_T* did = Uds_FindDid(((uint16_t)UDS_DID_PAGE_PERIODIC << 8) | req[i]);
+    if ((NULL == did) || (did->len > UDS_MAX_PERIODIC_LEN)) {
+      return Uds_Negative(UDS_SID_READ_PERIODIC_DID, UDS_NRC_REQUEST_OUT_OF_RANGE);
+    }
+    if (Uds_FindPeriodic(did) == numPeriodic) {
+      added++;
+    }
+  }
+  if ((UDS_PERIODIC_MODE_STOP != mode) && (numPeriodic + added > UDS_MAX_PERIODIC_DIDS)) {
+    return Uds_Negative(UDS_SID_READ_PERIODIC_DID, UDS_NRC_REQUEST_OUT_OF_RANGE);
+  }
+
+  if ((UDS_PERIODIC_MODE_STOP == mode) && (2U == len)) {
+    Uds_StopPeriodic();
+  }
+
+  for (i = 2U; i < len; ++i) {
+    const Uds_Did_T* did = Uds_FindDid(((uint16_t)UDS_DID_PAGE_PERIODIC << 8) | req[i]);
+    uint8_t index = Uds_FindPeriodic(did);
+
+    if (UDS_PERIODIC_MODE_STOP == mode) {
+      if (index < numPeriodic) {
+        numPeriodic--;
+        periodicDid[index] = periodicDid[numPeriodic];
+        periodicRate[index] = periodicRate[numPeriodic];
+      }
+    } else {
+      if (index == numPeriodic) {
+        periodicDid[numPeriodic++] = did;
+      }
+      periodicRate[index] = mode - 1U;
+    }
+  }
+
+  response[0] = UDS_SID_READ_PERIODIC_DID + UDS_POSITIVE_RESPONSE;
+  return 1U;
+}
+
+static uint16_t Uds_TesterPresent(const uint8_t* req, uint16_t len)
+{
+  if (2U != len) {
+    return Uds_Negative(UDS_SID_TESTER_PRESENT, UDS_NRC_INCORRECT_LENGTH);
+  }
+  if (0 != (req[1] & ~UDS_SPRMIB)) {
+    return Uds_Negative(UDS_SID_TESTER_PRESENT, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+  }
+  if (req[1] & UDS_SPRMIB) {
+    return 0;
+  }
+
+  response[0] = UDS_SID_TESTER_PRESENT + UDS_POSITIVE_RESPONSE;
+  response[1] = 0;
+  return 2U;
+}
+
+/**
+ * @brief Sends the pending response. While ISO-TP is busy it stays pending,
+ * and is retried on the next tick until UDS_P2_SERVER_MS has passed.
+ */
+static void Uds_SendResponse(void)
+{
+  // Single frames complete within IsoTp_Send
+  txBusy = true;
+  IsoTp_Status_T status = IsoTp_Send(channel, response, pendingResponseLen);
+  if (ISOTP_STATUS_OK == status) {
+    pendingResponseLen = 0;
+    return;
+  }
+
+  txBusy = false;
+  if ((ISOTP_STATUS_ERROR_BUSY == status) && (pendingResponseTime < UDS_P2_SERVER_MS)) {
+    pendingResponseTime += UDS_PERIOD_MS;
+    return;
+  }
+  pendingResponseLen = 0;
+  stats.txErrors++;
+}
+
+static void Uds_ProcessRequest(const uint8_t* req, uint16_t len)
+{
+  stats.requests++;
+  s3Time = 0;
+
+  uint16_t responseLen;
+  switch (req[0]) {
+    case UDS_SID_SESSION_CONTROL:
+      responseLen = Uds_SessionControl(req, len);
+      break;
+    case UDS_SID_ECU_RESET:
+      responseLen = Uds_EcuReset(req, len);
+      break;
+    case UDS_SID_CLEAR_DTC:
+      responseLen = Uds_ClearDtc(req, len);
+      break;
+    case UDS_SID_READ_DTC:
+      responseLen = Uds_ReadDtc(req, len);
+      break;
+    case UDS_SID_READ_DID:
+      responseLen = Uds_ReadDid(req, len);
+      break;
+    case UDS_SID_READ_PERIODIC_DID:
+      responseLen = Uds_ReadPeriodicDid(req, len);
+      break;
+    case UDS_SID_TESTER_PRESENT:
+      responseLen = Uds_TesterPresent(req, len);
+      break;
+    default:
+      responseLen = Uds_Negative(req[0], UDS_NRC_SERVICE_NOT_SUPPORTED);
+      break;
+  }
+
+  if (0 == responseLen) {
+    return;
+  }
+  if ((UDS_NEGATIVE_RESPONSE == response[0]) && (UDS_NRC_RESPONSE_PENDING != response[2])) {
+    stats.negativeResponses++;
+  }
+
+  pendingResponseLen = responseLen;
+  pendingResponseTime = 0;
+  Uds_SendResponse();
+}
+
+static void Uds_TestDtcs(void)
+{
+  uint8_t i;
+  for (i = 0; i < config->numDtcs; ++i) {
+    if (config->dtcs[i].test()) {
+      dtcStatus[i] |= UDS_DTC_TEST_FAILED | UDS_DTC_CONFIRMED;
+    } else {
+      dtcStatus[i] &= ~UDS_DTC_TEST_FAILED;
+    }
+  }
+}
+
+static void Uds_SendPeriodic(void)
+{
+  bool due[UDS_NUM_RATES];
+  size_t r;
+  for (r = 0; r < UDS_NUM_RATES; ++r) {
+    due[r] = (rates[r].offsetMs == time % rates[r].periodMs);
+  }
+
+  uint8_t i;
+  for (i = 0; i < numPeriodic; ++i) {
+    if (!due[periodicRate[i]]) {
+      continue;
+    }
+
+    const Uds_Did_T* did = periodicDid[i];
+    uint8_t frame[1U + UDS_MAX_PERIODIC_LEN];
+    frame[0] = (uint8_t)did->did;
+    did->read(&frame[1]);
+
+    CAN_Status_T status = CanTx_Send(canHandle, UDS_CAN_ID_PERIODIC, frame, 1U + did->len);
+    if (CAN_STATUS_OK == status) {
+      stats.periodicSent++;
+    } else {
+      stats.periodicDropped++;
+    }
+  }
+}
+
+static void Uds_RxCallback(IsoTp_Channel_T ch, uint8_t* data, uint16_t len)
+{
+  if ((NULL != requestData) || (0 == len)) {
+    stats.requestsDropped++;
+    IsoTp_FreeBuffer(data);
+    return;
+  }
+
+  requestLen = len;
+  requestData = data;
+}
+
+static void Uds_TxCallback(IsoTp_Channel_T ch, IsoTp_Status_T status)
+{
+  if (ISOTP_STATUS_OK != status) {
+    stats.txErrors++;
+  }
+  txBusy = false;
+}
+
+static void Uds_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Uds_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      time += UDS_PERIOD_MS;
+
+      if (0 != pendingResponseLen) {
+        Uds_SendResponse();
+      }
+      bool responding = txBusy || (0 != pendingResponseLen);
+
+      // Requests wait until the previous response has gone
+      uint8_t* request = requestData;
+      if ((NULL != request) && !responding) {
+        Uds_ProcessRequest(request, requestLen);
+        IsoTp_FreeBuffer(request);
+        requestData = NULL;
+      } else if (UDS_SESSION_DEFAULT != session) {
+        s3Time += UDS_PERIOD_MS;
+        if (s3Time >= UDS_S3_TIMEOUT_MS) {
+          session = UDS_SESSION_DEFAULT;
+          Uds_StopPeriodic();
+        }
+      }
+
+      if ((UDS_ACTION_NONE != pendingAction) && !txBusy && (0 == pendingResponseLen)) {
+        if (UDS_ACTION_BOOTLOADER == pendingAction) {
+          BootControl_EnterBootloader();
+        } else {
+          NVIC_SystemReset();
+        }
+      }
+
+      if (0 == time % UDS_DTC_PERIOD_MS) {
+        Uds_TestDtcs();
+      }
+
+      Uds_SendPeriodic();
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Uds_Status_T Uds_Init(Logging_T* logger, CAN_HandleTypeDef* hcan, const Uds_Config_T* udsConfig)
+{
+  log = logger;
+  logPrintS(log, "Uds_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  config = udsConfig;
+  canHandle = hcan;
+
+  if ((config->numDids > UDS_MAX_DIDS) || (config->numDtcs > UDS_MAX_DTCS)) {
+    return UDS_STATUS_ERROR;
+  }
+
+  // Build the DID index
+  memset(didIndex, UDS_DID_NONE, sizeof(didIndex));
+  uint16_t i;
+  for (i = 0; i < config->numDids; ++i) {
+    uint16_t did = config->dids[i].did;
+    uint8_t page = (uint8_t)(did >> 8);
+    if ((page < UDS_DID_PAGE_FIRST) || (page >= UDS_DID_PAGE_FIRST + UDS_DID_NUM_PAGES) ||
+        (NULL != Uds_FindDid(did)) || (0 == config->dids[i].len)) {
+      char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+      snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Uds_Init invalid DID 0x%04X\n", did);
+      logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+      return UDS_STATUS_ERROR;
+    }
+    didIndex[page - UDS_DID_PAGE_FIRST][did & 0xFFU] = (uint8_t)i;
+  }
+
+  session = UDS_SESSION_DEFAULT;
+  s3Time = 0;
+  time = 0;
+  pendingAction = UDS_ACTION_NONE;
+  numPeriodic = 0;
+  requestData = NULL;
+  txBusy = false;
+  pendingResponseLen = 0;
+  memset(dtcStatus, 0, sizeof(dtcStatus));
+  memset(&stats, 0, sizeof(Uds_Stats_T));
+
+  IsoTp_ChannelConfig_T channelConfig;
+  channelConfig.hcan = hcan;
+  channelConfig.txId = BOOTCONTROL_CAN_ID_RESPONSE;
+  channelConfig.rxId = BOOTCONTROL_CAN_ID_REQUEST;
+  channelConfig.blockSize = 0;
+  channelConfig.stMin = 0;
+  channelConfig.rxCallback = Uds_RxCallback;
+  channelConfig.txCallback = Uds_TxCallback;
+  IsoTp_Status_T statusIsoTp = IsoTp_Open(&channelConfig, &channel);
+  if (ISOTP_STATUS_OK != statusIsoTp) {
+    return UDS_STATUS_ERROR;
+  }
+
+  // create main task
+  udsTaskHandle = xTaskCreateStatic(
+      Uds_TaskMain,
+      "UdsTask",
+      UDS_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      UDS_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 10ms
+  uint16_t timerDivider = UDS_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&udsTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return UDS_STATUS_ERROR;
+  }
+
+  logPrintS(log, "Uds_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return UDS_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+Uds_Session_T Uds_GetSession(void)
+{
+  return session;
+}
+
+//------------------------------------------------------------------------------
+void Uds_GetStats(Uds_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
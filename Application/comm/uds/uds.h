@@ -0,0 +1,136 @@
+/*
+ * uds.h
+ *
+ * UDS (ISO 14229) diagnostic server over ISO-TP.
+ *
+ * Services:
+ *  - 0x10 DiagnosticSessionControl (default, programming, extended)
+ *  - 0x11 ECUReset
+ *  - 0x14 ClearDiagnosticInformation
+ *  - 0x19 ReadDTCInformation (number of and DTCs by status mask)
+ *  - 0x22 ReadDataByIdentifier
+ *  - 0x2A ReadDataByPeriodicIdentifier (extended session)
+ *  - 0x3E TesterPresent
+ *
+ * Data identifiers are looked up through an index built at initialization,
+ * so finding a DID is constant time. Only DIDs 0xF100 to 0xF2FF are
+ * supported; those in 0xF2xx can also be read periodically, identified by
+ * their low byte.
+ *
+ * Periodic DIDs are resolved once when requested. Each period the DID's read
+ * function packs its data straight into a single CAN frame
+ * [pDID][data...] sent on UDS_CAN_ID_PERIODIC, without going through ISO-TP.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_UDS_UDS_H_
+#define COMM_UDS_UDS_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define UDS_PERIOD_MS               ((uint16_t) 10U)
+
+/* Periodic transmission rates, each a multiple of UDS_PERIOD_MS */
+#define UDS_PERIODIC_FAST_MS        ((uint16_t) 10U)
+#define UDS_PERIODIC_MEDIUM_MS      ((uint16_t) 100U)
+#define UDS_PERIODIC_SLOW_MS        ((uint16_t) 1000U)
+
+/* Periodic data frames (UUDT) */
+#define UDS_CAN_ID_PERIODIC         ((uint32_t) 0x5E8U)
+
+/* Maximum DIDs scheduled for periodic transmission, over all rates */
+#define UDS_MAX_PERIODIC_DIDS       ((uint8_t) 16U)
+
+/* Periodic DIDs must fit in one CAN frame after the pDID */
+#define UDS_MAX_PERIODIC_LEN        ((uint8_t) 7U)
+
+#define UDS_MAX_DIDS                ((uint16_t) 255U)
+#define UDS_MAX_DTCS                ((uint8_t) 32U)
+#define UDS_MAX_RESPONSE_LEN        ((uint16_t) 256U)
+
+/* A response is retried for this long while no CAN mailbox is free (P2 server) */
+#define UDS_P2_SERVER_MS            ((uint32_t) 50U)
+
+/* Non-default sessions time out without a request (S3 server) */
+#define UDS_S3_TIMEOUT_MS           ((uint32_t) 5000U)
+
+/* Tests are run against the DTCs at this period */
+#define UDS_DTC_PERIOD_MS           ((uint16_t) 100U)
+
+typedef enum
+{
+  UDS_STATUS_OK     = 0x00U,
+  UDS_STATUS_ERROR  = 0x01U
+} Uds_Status_T;
+
+typedef enum
+{
+  UDS_SESSION_DEFAULT     = 0x01U,
+  UDS_SESSION_PROGRAMMING = 0x02U,
+  UDS_SESSION_EXTENDED    = 0x03U
+} Uds_Session_T;
+
+/*
+ * A data identifier. The read function writes exactly len bytes, and is
+ * called from the UDS task.
+ */
+typedef struct
+{
+  uint16_t did;
+  uint8_t len;
+  void (*read)(uint8_t* out);
+} Uds_Did_T;
+
+/*
+ * A diagnostic trouble code. The test returns true while the fault is present.
+ */
+typedef struct
+{
+  uint32_t code;          /* 3 byte DTC, including the failure type */
+  bool (*test)(void);
+} Uds_Dtc_T;
+
+typedef struct
+{
+  const Uds_Did_T* dids;
+  uint16_t numDids;
+  const Uds_Dtc_T* dtcs;
+  uint8_t numDtcs;
+  bool (*resetAllowed)(void);   /* ECU reset and programming session are allowed */
+} Uds_Config_T;
+
+typedef struct
+{
+  uint32_t requests;
+  uint32_t requestsDropped;     /* Received while the previous request was still pending */
+  uint32_t negativeResponses;
+  uint32_t txErrors;
+  uint32_t periodicSent;
+  uint32_t periodicDropped;     /* No CAN mailbox free */
+} Uds_Stats_T;
+
+/**
+ * @brief Initialize the server
+ * @param logger Pointer to system logger
+ * @param hcan CAN bus the tester is on
+ * @param config DID and DTC tables, must remain valid
+ */
+Uds_Status_T Uds_Init(Logging_T* logger, CAN_HandleTypeDef* hcan, const Uds_Config_T* config);
+
+/**
+ * @brief Get the active diagnostic session
+ */
+Uds_Session_T Uds_GetSession(void);
+
+/**
+ * @brief Get the server statistics
+ */
+void Uds_GetStats(Uds_Stats_T* stats);
+
+#endif /* COMM_UDS_UDS_H_ */
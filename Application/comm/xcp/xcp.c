@@ -0,0 +1,1069 @@
+/*
+ * xcp.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "xcp.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32f7xx_hal.h"
+
+#include "time/tasktimer/tasktimer.h"
+#include "lib/paramStore/paramStore.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define XCP_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[XCP_STACK_SIZE];
+
+// Runs after the control processes, so DAQ samples the results of this tick
+#define XCP_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+// Task data
+static TaskHandle_t xcpTaskHandle;
+
+static Xcp_SendFunc_T sendFunc;
+
+/*
+ * Packet identifiers
+ */
+#define XCP_PID_RES                   0xFFU
+#define XCP_PID_ERR                   0xFEU
+#define XCP_PID_EV                    0xFDU
+#define XCP_PID_CMD_MIN               0xC0U   /* Below this, a received packet is STIM */
+
+/*
+ * Commands
+ */
+#define XCP_CMD_CONNECT               0xFFU
+#define XCP_CMD_DISCONNECT            0xFEU
+#define XCP_CMD_GET_STATUS            0xFDU
+#define XCP_CMD_SYNCH                 0xFCU
+#define XCP_CMD_GET_COMM_MODE_INFO    0xFBU
+#define XCP_CMD_SET_REQUEST           0xF9U
+#define XCP_CMD_SET_MTA               0xF6U
+#define XCP_CMD_UPLOAD                0xF5U
+#define XCP_CMD_SHORT_UPLOAD          0xF4U
+#define XCP_CMD_DOWNLOAD              0xF0U
+#define XCP_CMD_SET_DAQ_PTR           0xE2U
+#define XCP_CMD_WRITE_DAQ             0xE1U
+#define XCP_CMD_SET_DAQ_LIST_MODE     0xE0U
+#define XCP_CMD_START_STOP_DAQ_LIST   0xDEU
+#define XCP_CMD_START_STOP_SYNCH      0xDDU
+#define XCP_CMD_GET_DAQ_PROCESSOR_INFO  0xDAU
+#define XCP_CMD_GET_DAQ_RESOLUTION_INFO 0xD9U
+#define XCP_CMD_GET_DAQ_EVENT_INFO    0xD7U
+#define XCP_CMD_FREE_DAQ              0xD6U
+#define XCP_CMD_ALLOC_DAQ             0xD5U
+#define XCP_CMD_ALLOC_ODT             0xD4U
+#define XCP_CMD_ALLOC_ODT_ENTRY       0xD3U
+
+/*
+ * Error codes
+ */
+#define XCP_ERR_CMD_SYNCH             0x00U
+#define XCP_ERR_CMD_BUSY              0x10U
+#define XCP_ERR_DAQ_ACTIVE            0x11U
+#define XCP_ERR_CMD_UNKNOWN           0x20U
+#define XCP_ERR_CMD_SYNTAX            0x21U
+#define XCP_ERR_OUT_OF_RANGE          0x22U
+#define XCP_ERR_WRITE_PROTECTED       0x23U
+#define XCP_ERR_ACCESS_DENIED         0x24U
+#define XCP_ERR_MODE_NOT_VALID        0x27U
+#define XCP_ERR_SEQUENCE              0x29U
+#define XCP_ERR_DAQ_CONFIG            0x2AU
+#define XCP_ERR_MEMORY_OVERFLOW       0x30U
+#define XCP_ERR_RESOURCE_TEMPORARY_NOT_ACCESSIBLE 0x33U
+
+/*
+ * Resources and modes
+ */
+#define XCP_RESOURCE_DAQ              0x04U
+#define XCP_RESOURCE_STIM             0x08U
+#define XCP_SESSION_STORE_CAL_REQ     0x01U
+#define XCP_SESSION_DAQ_RUNNING       0x40U
+#define XCP_SET_REQUEST_STORE_CAL     0x01U
+#define XCP_EV_STORE_CAL              0x03U
+#define XCP_DAQ_MODE_DIRECTION_STIM   0x02U
+#define XCP_DAQ_PROPERTY_DYNAMIC      0x01U
+#define XCP_DAQ_PROPERTY_PRESCALER    0x02U
+#define XCP_EVENT_PROPERTY_DAQ        0x04U
+#define XCP_EVENT_PROPERTY_STIM       0x08U
+#define XCP_EVENT_UNIT_1MS            0x06U
+
+/*
+ * Readable memory for XCP_ADDR_EXT_MEMORY
+ */
+#define XCP_FLASH_START               ((uint32_t) 0x08000000U)
+#define XCP_FLASH_END                 ((uint32_t) 0x08200000U)
+#define XCP_RAM_START                 ((uint32_t) 0x20000000U)
+#define XCP_RAM_END                   ((uint32_t) 0x20080000U)
+
+/*
+ * Event channels, all run from the XCP task
+ */
+typedef struct
+{
+  const char* name;
+  uint16_t periodMs;
+} Xcp_EventChannel_T;
+
+static const Xcp_EventChannel_T eventChannels[] = {
+  { "1ms",    1U },
+  { "10ms",   10U },
+  { "100ms",  100U },
+};
+#define XCP_NUM_EVENTS (sizeof(eventChannels) / sizeof(eventChannels[0]))
+
+/*
+ * Dynamic DAQ configuration. ODTs and entries are allocated contiguously
+ * from the static pools, so the absolute ODT number is the PID.
+ */
+typedef struct
+{
+  uint32_t address;
+  uint8_t ext;
+  uint8_t size;
+} Xcp_OdtEntry_T;
+
+typedef struct
+{
+  uint8_t entryFirst;
+  uint8_t entryCount;
+  bool stimReceived;
+  uint8_t stimData[XCP_MAX_DTO - 1U];
+} Xcp_Odt_T;
+
+typedef struct
+{
+  uint8_t odtFirst;
+  uint8_t odtCount;
+  uint8_t mode;
+  uint16_t eventChannel;
+  uint8_t prescaler;
+  uint8_t prescalerCount;
+  bool selected;
+  bool running;
+} Xcp_DaqList_T;
+
+typedef enum
+{
+  XCP_ALLOC_FREE,
+  XCP_ALLOC_DAQ,
+  XCP_ALLOC_ODT,
+  XCP_ALLOC_ODT_ENTRY
+} Xcp_AllocState_T;
+
+static Xcp_DaqList_T daqLists[XCP_MAX_DAQ_LISTS];
+static Xcp_Odt_T odts[XCP_MAX_ODTS];
+static Xcp_OdtEntry_T odtEntries[XCP_MAX_ODT_ENTRIES];
+static uint16_t daqCount;
+static uint8_t odtCount;
+static uint8_t entryCount;
+static Xcp_AllocState_T allocState;
+
+// DAQ pointer
+static uint16_t daqPtrList;
+static uint8_t daqPtrOdt;
+static uint8_t daqPtrEntry;
+static bool daqPtrValid;
+
+// Session
+static bool connected;
+static uint32_t mta;
+static uint8_t mtaExt;
+static uint32_t eventTick;
+static bool applyDeferred;    /* Written parameters are waiting for ParamStore_Apply */
+static bool storeCalPending;  /* SET_REQUEST STORE_CAL_REQ, waiting for the save to finish */
+static Xcp_StoreAllowedFunc_T storeAllowedFunc;
+
+/*
+ * Minimum length of each command, indexed from XCP_PID_CMD_MIN. Shorter
+ * commands are rejected, rather than taking their parameters from whatever
+ * the queue slot last held.
+ */
+#define XCP_CMD_INDEX(cmd) ((cmd) - XCP_PID_CMD_MIN)
+static const uint8_t commandLength[0x100U - XCP_PID_CMD_MIN] = {
+  [XCP_CMD_INDEX(XCP_CMD_CONNECT)]                  = 2U,
+  [XCP_CMD_INDEX(XCP_CMD_DISCONNECT)]               = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_GET_STATUS)]               = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_SYNCH)]                    = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_GET_COMM_MODE_INFO)]       = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_SET_REQUEST)]              = 4U,
+  [XCP_CMD_INDEX(XCP_CMD_SET_MTA)]                  = 8U,
+  [XCP_CMD_INDEX(XCP_CMD_UPLOAD)]                   = 2U,
+  [XCP_CMD_INDEX(XCP_CMD_SHORT_UPLOAD)]             = 8U,
+  [XCP_CMD_INDEX(XCP_CMD_DOWNLOAD)]                 = 2U,
+  [XCP_CMD_INDEX(XCP_CMD_SET_DAQ_PTR)]              = 6U,
+  [XCP_CMD_INDEX(XCP_CMD_WRITE_DAQ)]                = 8U,
+  [XCP_CMD_INDEX(XCP_CMD_SET_DAQ_LIST_MODE)]        = 7U,
+  [XCP_CMD_INDEX(XCP_CMD_START_STOP_DAQ_LIST)]      = 4U,
+  [XCP_CMD_INDEX(XCP_CMD_START_STOP_SYNCH)]         = 2U,
+  [XCP_CMD_INDEX(XCP_CMD_GET_DAQ_PROCESSOR_INFO)]   = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_GET_DAQ_RESOLUTION_INFO)]  = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_GET_DAQ_EVENT_INFO)]       = 4U,
+  [XCP_CMD_INDEX(XCP_CMD_FREE_DAQ)]                 = 1U,
+  [XCP_CMD_INDEX(XCP_CMD_ALLOC_DAQ)]                = 4U,
+  [XCP_CMD_INDEX(XCP_CMD_ALLOC_ODT)]                = 5U,
+  [XCP_CMD_INDEX(XCP_CMD_ALLOC_ODT_ENTRY)]          = 6U,
+};
+
+/*
+ * Received packets, written from the transport (possibly an ISR) and
+ * read by the XCP task. Single producer, single consumer.
+ */
+#define XCP_RX_QUEUE_LENGTH 16U
+typedef struct
+{
+  uint8_t len;
+  uint8_t data[XCP_MAX_CTO];
+} Xcp_Packet_T;
+static Xcp_Packet_T rxQueue[XCP_RX_QUEUE_LENGTH];
+static volatile uint8_t rxHead;
+static volatile uint8_t rxTail;
+
+static Xcp_Stats_T stats;
+
+// ------------------- Private methods -------------------
+static inline uint16_t Xcp_GetU16(const uint8_t* data)
+{
+  return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+}
+
+static inline uint32_t Xcp_GetU32(const uint8_t* data)
+{
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+         ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static inline void Xcp_PutU16(uint8_t* data, uint16_t value)
+{
+  data[0] = value & 0xFFU;
+  data[1] = (value >> 8) & 0xFFU;
+}
+
+static void Xcp_Send(const uint8_t* data, uint8_t len)
+{
+  if (sendFunc(data, len)) {
+    stats.txPackets++;
+  } else {
+    stats.txDropped++;
+  }
+}
+
+static void Xcp_SendError(uint8_t error)
+{
+  uint8_t res[2] = { XCP_PID_ERR, error };
+  Xcp_Send(res, sizeof(res));
+}
+
+/**
+ * @brief Checks a memory range can be read without faulting
+ */
+static bool Xcp_MemoryValid(uint32_t address, uint32_t size)
+{
+  uint32_t end = address + size;
+  if (end < address) {
+    return false;
+  }
+  return (address >= XCP_FLASH_START && end <= XCP_FLASH_END) ||
+         (address >= XCP_RAM_START && end <= XCP_RAM_END);
+}
+
+static bool Xcp_ParamValid(uint32_t address, uint32_t size)
+{
+  uint32_t paramBytes = (uint32_t)ParamStore_GetCount() * sizeof(ParamStore_Value_T);
+  return (address < paramBytes) && (size <= paramBytes - address);
+}
+
+static bool Xcp_AddressValid(uint8_t ext, uint32_t address, uint32_t size)
+{
+  switch (ext) {
+    case XCP_ADDR_EXT_MEMORY:
+      return Xcp_MemoryValid(address, size);
+    case XCP_ADDR_EXT_PARAM:
+      return Xcp_ParamValid(address, size);
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Reads from an already validated address
+ * @param params Parameter set to read XCP_ADDR_EXT_PARAM addresses from
+ */
+static void Xcp_Read(const ParamStore_Value_T* params, uint8_t ext, uint32_t address, uint8_t* dest, uint8_t size)
+{
+  if (XCP_ADDR_EXT_PARAM == ext) {
+    memcpy(dest, (const uint8_t*)params + address, size);
+  } else {
+    memcpy(dest, (const void*)address, size);
+  }
+}
+
+/**
+ * @brief Stages a write into the parameter store. Partial words are merged
+ * with the current value. Takes effect on ParamStore_Apply.
+ */
+static void Xcp_WriteParam(uint32_t address, const uint8_t* data, uint8_t size)
+{
+  while (size > 0) {
+    ParamStore_Id_T id = address / sizeof(ParamStore_Value_T);
+    uint32_t offset = address % sizeof(ParamStore_Value_T);
+    uint32_t n = sizeof(ParamStore_Value_T) - offset;
+    if (n > size) {
+      n = size;
+    }
+
+    ParamStore_Value_T value;
+    ParamStore_GetPending(id, &value);
+    memcpy((uint8_t*)&value + offset, data, n);
+    ParamStore_Set(id, value);
+
+    address += n;
+    data += n;
+    size -= n;
+  }
+}
+
+static void Xcp_StopAllDaq(void)
+{
+  size_t i;
+  for (i = 0; i < XCP_MAX_DAQ_LISTS; ++i) {
+    daqLists[i].running = false;
+    daqLists[i].selected = false;
+  }
+}
+
+static bool Xcp_DaqRunning(void)
+{
+  size_t i;
+  for (i = 0; i < daqCount; ++i) {
+    if (daqLists[i].running) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void Xcp_FreeDaq(void)
+{
+  Xcp_StopAllDaq();
+  memset(daqLists, 0, sizeof(daqLists));
+  memset(odts, 0, sizeof(odts));
+  memset(odtEntries, 0, sizeof(odtEntries));
+  daqCount = 0;
+  odtCount = 0;
+  entryCount = 0;
+  allocState = XCP_ALLOC_FREE;
+  daqPtrValid = false;
+}
+
+/**
+ * @brief Checks a DAQ list's entries before it is started
+ */
+static bool Xcp_DaqListValid(const Xcp_DaqList_T* daq)
+{
+  if (0 == daq->odtCount) {
+    return false;
+  }
+
+  bool stim = (daq->mode & XCP_DAQ_MODE_DIRECTION_STIM) != 0;
+  size_t i;
+  for (i = daq->odtFirst; i < daq->odtFirst + daq->odtCount; ++i) {
+    uint32_t payload = 0;
+    size_t j;
+    for (j = odts[i].entryFirst; j < odts[i].entryFirst + odts[i].entryCount; ++j) {
+      const Xcp_OdtEntry_T* entry = &odtEntries[j];
+      if (0 == entry->size) {
+        continue;
+      }
+      // STIM may only write to the parameter store, a whole parameter at a time
+      if (stim && (XCP_ADDR_EXT_PARAM != entry->ext ||
+                   sizeof(ParamStore_Value_T) != entry->size ||
+                   0 != entry->address % sizeof(ParamStore_Value_T))) {
+        return false;
+      }
+      payload += entry->size;
+    }
+    if (payload > XCP_MAX_DTO - 1U) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Samples and sends each ODT of a DAQ list
+ */
+static void Xcp_SampleDaq(const Xcp_DaqList_T* daq, const ParamStore_Value_T* params)
+{
+  size_t i;
+  for (i = daq->odtFirst; i < daq->odtFirst + daq->odtCount; ++i) {
+    uint8_t dto[XCP_MAX_DTO];
+    uint8_t len = 0;
+    dto[len++] = (uint8_t)i;
+
+    size_t j;
+    for (j = odts[i].entryFirst; j < odts[i].entryFirst + odts[i].entryCount; ++j) {
+      const Xcp_OdtEntry_T* entry = &odtEntries[j];
+      if (0 == entry->size) {
+        // Never written, so there is no address to read
+        continue;
+      }
+      Xcp_Read(params, entry->ext, entry->address, &dto[len], entry->size);
+      len += entry->size;
+    }
+
+    Xcp_Send(dto, len);
+  }
+}
+
+/**
+ * @brief Writes the latest received data for each ODT of a STIM list
+ * @return true if any parameters were staged
+ */
+static bool Xcp_ApplyStim(const Xcp_DaqList_T* daq)
+{
+  bool written = false;
+  size_t i;
+  for (i = daq->odtFirst; i < daq->odtFirst + daq->odtCount; ++i) {
+    Xcp_Odt_T* odt = &odts[i];
+    if (!odt->stimReceived) {
+      continue;
+    }
+
+    uint8_t offset = 0;
+    size_t j;
+    for (j = odt->entryFirst; j < odt->entryFirst + odt->entryCount; ++j) {
+      const Xcp_OdtEntry_T* entry = &odtEntries[j];
+      Xcp_WriteParam(entry->address, &odt->stimData[offset], entry->size);
+      offset += entry->size;
+    }
+    odt->stimReceived = false;
+    written = true;
+  }
+  return written;
+}
+
+/**
+ * @brief Applies the written parameters, or retries on the next tick if the
+ * store is busy
+ */
+static void Xcp_ApplyParams(void)
+{
+  applyDeferred = (PARAMSTORE_STATUS_BUSY == ParamStore_Apply());
+}
+
+/**
+ * @brief Starts saving the active parameters for SET_REQUEST STORE_CAL_REQ
+ * @return XCP error code, or XCP_PID_RES if started
+ */
+static uint8_t Xcp_StoreCal(void)
+{
+  if (!storeAllowedFunc()) {
+    return XCP_ERR_RESOURCE_TEMPORARY_NOT_ACCESSIBLE;
+  }
+  // Written values not yet active would be missed, and a second store can't start
+  if (applyDeferred || storeCalPending) {
+    return XCP_ERR_CMD_BUSY;
+  }
+
+  ParamStore_Status_T status = ParamStore_Save();
+  if (PARAMSTORE_STATUS_BUSY == status) {
+    return XCP_ERR_CMD_BUSY;
+  } else if (PARAMSTORE_STATUS_OK != status) {
+    return XCP_ERR_RESOURCE_TEMPORARY_NOT_ACCESSIBLE;
+  }
+
+  storeCalPending = true;
+  logPrintS(log, "Xcp storing calibration\n", LOGGING_DEFAULT_BUFF_LEN);
+  return XCP_PID_RES;
+}
+
+/**
+ * @brief Ends a pending STORE_CAL_REQ once the save has finished. Only a
+ * successful save is reported to the master, with EV_STORE_CAL.
+ */
+static void Xcp_CheckStoreCal(void)
+{
+  ParamStore_Status_T status = ParamStore_GetSaveStatus();
+  if (!storeCalPending || PARAMSTORE_STATUS_BUSY == status) {
+    return;
+  }
+  storeCalPending = false;
+
+  if (PARAMSTORE_STATUS_OK == status) {
+    uint8_t ev[2] = { XCP_PID_EV, XCP_EV_STORE_CAL };
+    Xcp_Send(ev, sizeof(ev));
+    logPrintS(log, "Xcp calibration stored\n", LOGGING_DEFAULT_BUFF_LEN);
+  } else {
+    stats.storeCalFailed++;
+    logPrintS(log, "Xcp calibration store failed\n", LOGGING_DEFAULT_BUFF_LEN);
+  }
+}
+
+static void Xcp_ProcessEvent(uint16_t event)
+{
+  const ParamStore_Value_T* params = ParamStore_Get();
+  bool stimWritten = false;
+
+  size_t i;
+  for (i = 0; i < daqCount; ++i) {
+    Xcp_DaqList_T* daq = &daqLists[i];
+    if (!daq->running || daq->eventChannel != event) {
+      continue;
+    }
+
+    if (++daq->prescalerCount < daq->prescaler) {
+      continue;
+    }
+    daq->prescalerCount = 0;
+
+    if (daq->mode & XCP_DAQ_MODE_DIRECTION_STIM) {
+      stimWritten |= Xcp_ApplyStim(daq);
+    } else {
+      Xcp_SampleDaq(daq, params);
+    }
+  }
+
+  if (stimWritten) {
+    Xcp_ApplyParams();
+  }
+}
+
+/**
+ * @brief Stores a received STIM DTO until its list's next event.
+ * Every entry of the ODT is written from the packet, so a packet too short
+ * to hold them all is rejected, and the last complete one is kept.
+ */
+static void Xcp_ReceiveStim(const Xcp_Packet_T* packet)
+{
+  uint8_t pid = packet->data[0];
+  if (pid >= odtCount) {
+    return;
+  }
+
+  Xcp_Odt_T* odt = &odts[pid];
+  uint32_t payload = 0;
+  size_t j;
+  for (j = odt->entryFirst; j < odt->entryFirst + odt->entryCount; ++j) {
+    payload += odtEntries[j].size;
+  }
+  if (packet->len - 1U < payload) {
+    stats.stimRejected++;
+    return;
+  }
+
+  memcpy(odt->stimData, &packet->data[1], packet->len - 1U);
+  odt->stimReceived = true;
+}
+
+static void Xcp_ProcessCommand(const Xcp_Packet_T* packet)
+{
+  const uint8_t* cmd = packet->data;
+  uint8_t res[XCP_MAX_CTO];
+  uint8_t resLen = 1;
+  memset(res, 0, sizeof(res));
+  res[0] = XCP_PID_RES;
+
+  if (!connected && XCP_CMD_CONNECT != cmd[0]) {
+    // Commands other than CONNECT are ignored until connected
+    return;
+  }
+
+  // Unknown commands have no length, and are rejected below
+  if (packet->len < commandLength[XCP_CMD_INDEX(cmd[0])]) {
+    Xcp_SendError(XCP_ERR_CMD_SYNTAX);
+    return;
+  }
+
+  switch (cmd[0]) {
+    case XCP_CMD_CONNECT:
+      connected = true;
+      // No CAL/PAG: the parameter store has one page, and no page commands are served
+      res[1] = XCP_RESOURCE_DAQ | XCP_RESOURCE_STIM;
+      res[2] = 0x00U;   // Intel byte order, byte granularity, no block mode
+      res[3] = XCP_MAX_CTO;
+      Xcp_PutU16(&res[4], XCP_MAX_DTO);
+      res[6] = 0x01U;   // Protocol layer version
+      res[7] = 0x01U;   // Transport layer version
+      resLen = 8;
+      break;
+
+    case XCP_CMD_DISCONNECT:
+      Xcp_StopAllDaq();
+      connected = false;
+      break;
+
+    case XCP_CMD_GET_STATUS:
+      res[1] = (Xcp_DaqRunning() ? XCP_SESSION_DAQ_RUNNING : 0x00U) |
+               (storeCalPending ? XCP_SESSION_STORE_CAL_REQ : 0x00U);
+      res[2] = 0x00U;   // No resources protected
+      resLen = 6;
+      break;
+
+    case XCP_CMD_SYNCH:
+      Xcp_SendError(XCP_ERR_CMD_SYNCH);
+      return;
+
+    case XCP_CMD_GET_COMM_MODE_INFO:
+      res[2] = 0x00U;   // No optional modes
+      res[7] = 0x01U;   // Driver version
+      resLen = 8;
+      break;
+
+    case XCP_CMD_SET_REQUEST:
+    {
+      // Only STORE_CAL_REQ, there is no DAQ configuration to store
+      if (XCP_SET_REQUEST_STORE_CAL != cmd[1]) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      uint8_t result = Xcp_StoreCal();
+      if (XCP_PID_RES != result) {
+        Xcp_SendError(result);
+        return;
+      }
+      break;
+    }
+
+    case XCP_CMD_SET_MTA:
+      mtaExt = cmd[3];
+      mta = Xcp_GetU32(&cmd[4]);
+      break;
+
+    case XCP_CMD_UPLOAD:
+    case XCP_CMD_SHORT_UPLOAD:
+    {
+      uint8_t size = cmd[1];
+      if (XCP_CMD_SHORT_UPLOAD == cmd[0]) {
+        mtaExt = cmd[3];
+        mta = Xcp_GetU32(&cmd[4]);
+      }
+      if (size > XCP_MAX_CTO - 1U) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      if (!Xcp_AddressValid(mtaExt, mta, size)) {
+        Xcp_SendError(XCP_ERR_ACCESS_DENIED);
+        return;
+      }
+      Xcp_Read(ParamStore_Get(), mtaExt, mta, &res[1], size);
+      mta += size;
+      resLen = 1 + size;
+      break;
+    }
+
+    case XCP_CMD_DOWNLOAD:
+    {
+      uint8_t size = cmd[1];
+      if (size > XCP_MAX_CTO - 2U || packet->len < 2U + size) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      if (XCP_ADDR_EXT_PARAM != mtaExt) {
+        Xcp_SendError(XCP_ERR_WRITE_PROTECTED);
+        return;
+      }
+      if (!Xcp_ParamValid(mta, size)) {
+        Xcp_SendError(XCP_ERR_ACCESS_DENIED);
+        return;
+      }
+      Xcp_WriteParam(mta, &cmd[2], size);
+      Xcp_ApplyParams();
+      mta += size;
+      break;
+    }
+
+    case XCP_CMD_FREE_DAQ:
+      Xcp_FreeDaq();
+      break;
+
+    case XCP_CMD_ALLOC_DAQ:
+    {
+      uint16_t count = Xcp_GetU16(&cmd[2]);
+      if (XCP_ALLOC_FREE != allocState) {
+        Xcp_SendError(XCP_ERR_SEQUENCE);
+        return;
+      }
+      if (count > XCP_MAX_DAQ_LISTS) {
+        Xcp_SendError(XCP_ERR_MEMORY_OVERFLOW);
+        return;
+      }
+      daqCount = count;
+      allocState = XCP_ALLOC_DAQ;
+      break;
+    }
+
+    case XCP_CMD_ALLOC_ODT:
+    {
+      uint16_t daq = Xcp_GetU16(&cmd[2]);
+      uint8_t count = cmd[4];
+      if (XCP_ALLOC_DAQ != allocState && XCP_ALLOC_ODT != allocState) {
+        Xcp_SendError(XCP_ERR_SEQUENCE);
+        return;
+      }
+      if (daq >= daqCount || daqLists[daq].odtCount != 0) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      if (count > XCP_MAX_ODTS - odtCount) {
+        Xcp_SendError(XCP_ERR_MEMORY_OVERFLOW);
+        return;
+      }
+      daqLists[daq].odtFirst = odtCount;
+      daqLists[daq].odtCount = count;
+      odtCount += count;
+      allocState = XCP_ALLOC_ODT;
+      break;
+    }
+
+    case XCP_CMD_ALLOC_ODT_ENTRY:
+    {
+      uint16_t daq = Xcp_GetU16(&cmd[2]);
+      uint8_t odt = cmd[4];
+      uint8_t count = cmd[5];
+      if (XCP_ALLOC_ODT != allocState && XCP_ALLOC_ODT_ENTRY != allocState) {
+        Xcp_SendError(XCP_ERR_SEQUENCE);
+        return;
+      }
+      if (daq >= daqCount || odt >= daqLists[daq].odtCount) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      Xcp_Odt_T* o = &odts[daqLists[daq].odtFirst + odt];
+      if (o->entryCount != 0) {
+        Xcp_SendError(XCP_ERR_SEQUENCE);
+        return;
+      }
+      if (count > XCP_MAX_ODT_ENTRIES - entryCount) {
+        Xcp_SendError(XCP_ERR_MEMORY_OVERFLOW);
+        return;
+      }
+      o->entryFirst = entryCount;
+      o->entryCount = count;
+      entryCount += count;
+      allocState = XCP_ALLOC_ODT_ENTRY;
+      break;
+    }
+
+    case XCP_CMD_SET_DAQ_PTR:
+    {
+      uint16_t daq = Xcp_GetU16(&cmd[2]);
+      uint8_t odt = cmd[4];
+      uint8_t entry = cmd[5];
+      if (daq >= daqCount ||
+          odt >= daqLists[daq].odtCount ||
+          entry >= odts[daqLists[daq].odtFirst + odt].entryCount) {
+        daqPtrValid = false;
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      daqPtrList = daq;
+      daqPtrOdt = odt;
+      daqPtrEntry = entry;
+      daqPtrValid = true;
+      break;
+    }
+
+    case XCP_CMD_WRITE_DAQ:
+    {
+      uint8_t size = cmd[2];
+      uint8_t ext = cmd[3];
+      uint32_t address = Xcp_GetU32(&cmd[4]);
+      if (!daqPtrValid) {
+        Xcp_SendError(XCP_ERR_SEQUENCE);
+        return;
+      }
+      if (daqLists[daqPtrList].running) {
+        Xcp_SendError(XCP_ERR_DAQ_ACTIVE);
+        return;
+      }
+      if (0 == size || size > XCP_MAX_ODT_ENTRY_SIZE) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      if (!Xcp_AddressValid(ext, address, size)) {
+        Xcp_SendError(XCP_ERR_ACCESS_DENIED);
+        return;
+      }
+
+      Xcp_Odt_T* odt = &odts[daqLists[daqPtrList].odtFirst + daqPtrOdt];
+      Xcp_OdtEntry_T* entry = &odtEntries[odt->entryFirst + daqPtrEntry];
+      entry->address = address;
+      entry->ext = ext;
+      entry->size = size;
+
+      // Pointer moves to the next entry in the ODT
+      daqPtrEntry++;
+      if (daqPtrEntry >= odt->entryCount) {
+        daqPtrValid = false;
+      }
+      break;
+    }
+
+    case XCP_CMD_SET_DAQ_LIST_MODE:
+    {
+      uint8_t mode = cmd[1];
+      uint16_t daq = Xcp_GetU16(&cmd[2]);
+      uint16_t event = Xcp_GetU16(&cmd[4]);
+      uint8_t prescaler = cmd[6];
+      if (daq >= daqCount || event >= XCP_NUM_EVENTS) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      if (daqLists[daq].running) {
+        Xcp_SendError(XCP_ERR_DAQ_ACTIVE);
+        return;
+      }
+      if (mode & ~XCP_DAQ_MODE_DIRECTION_STIM) {
+        // Timestamps, PID_OFF and alternating mode are not supported
+        Xcp_SendError(XCP_ERR_MODE_NOT_VALID);
+        return;
+      }
+      daqLists[daq].mode = mode;
+      daqLists[daq].eventChannel = event;
+      daqLists[daq].prescaler = (0 == prescaler) ? 1 : prescaler;
+      daqLists[daq].prescalerCount = 0;
+      break;
+    }
+
+    case XCP_CMD_START_STOP_DAQ_LIST:
+    {
+      uint8_t mode = cmd[1];
+      uint16_t daq = Xcp_GetU16(&cmd[2]);
+      if (daq >= daqCount) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      Xcp_DaqList_T* list = &daqLists[daq];
+      if (0x00U == mode) {
+        list->running = false;
+      } else if (0x01U == mode || 0x02U == mode) {
+        if (!Xcp_DaqListValid(list)) {
+          Xcp_SendError(XCP_ERR_DAQ_CONFIG);
+          return;
+        }
+        if (0x01U == mode) {
+          list->prescalerCount = 0;
+          list->running = true;
+        } else {
+          list->selected = true;
+        }
+      } else {
+        Xcp_SendError(XCP_ERR_MODE_NOT_VALID);
+        return;
+      }
+      res[1] = list->odtFirst;    // First PID
+      resLen = 2;
+      break;
+    }
+
+    case XCP_CMD_START_STOP_SYNCH:
+    {
+      uint8_t mode = cmd[1];
+      if (mode > 0x02U) {
+        Xcp_SendError(XCP_ERR_MODE_NOT_VALID);
+        return;
+      }
+      size_t i;
+      // Entries may have been written since the lists were selected
+      if (0x01U == mode) {
+        for (i = 0; i < daqCount; ++i) {
+          if (daqLists[i].selected && !Xcp_DaqListValid(&daqLists[i])) {
+            Xcp_SendError(XCP_ERR_DAQ_CONFIG);
+            return;
+          }
+        }
+      }
+      for (i = 0; i < daqCount; ++i) {
+        if (0x00U == mode) {
+          daqLists[i].running = false;
+        } else if (daqLists[i].selected) {
+          daqLists[i].running = (0x01U == mode);
+          daqLists[i].prescalerCount = 0;
+        }
+        daqLists[i].selected = false;
+      }
+      break;
+    }
+
+    case XCP_CMD_GET_DAQ_PROCESSOR_INFO:
+      res[1] = XCP_DAQ_PROPERTY_DYNAMIC | XCP_DAQ_PROPERTY_PRESCALER;
+      Xcp_PutU16(&res[2], XCP_MAX_DAQ_LISTS);
+      Xcp_PutU16(&res[4], XCP_NUM_EVENTS);
+      res[6] = 0x00U;   // No predefined lists
+      res[7] = 0x00U;   // Absolute ODT number PID, no optimisation
+      resLen = 8;
+      break;
+
+    case XCP_CMD_GET_DAQ_RESOLUTION_INFO:
+      res[1] = 1U;                        // DAQ entry granularity
+      res[2] = XCP_MAX_ODT_ENTRY_SIZE;    // Max DAQ entry size
+      res[3] = 1U;                        // STIM entry granularity
+      res[4] = XCP_MAX_ODT_ENTRY_SIZE;    // Max STIM entry size
+      res[5] = 0x00U;                     // No timestamps
+      resLen = 8;
+      break;
+
+    case XCP_CMD_GET_DAQ_EVENT_INFO:
+    {
+      uint16_t event = Xcp_GetU16(&cmd[2]);
+      if (event >= XCP_NUM_EVENTS) {
+        Xcp_SendError(XCP_ERR_OUT_OF_RANGE);
+        return;
+      }
+      res[1] = XCP_EVENT_PROPERTY_DAQ | XCP_EVENT_PROPERTY_STIM;
+      res[2] = 0xFFU;   // No limit on DAQ lists per event
+      res[3] = (uint8_t)strlen(eventChannels[event].name);
+      res[4] = (uint8_t)eventChannels[event].periodMs;
+      res[5] = XCP_EVENT_UNIT_1MS;
+      res[6] = 0x00U;   // Priority
+      resLen = 7;
+
+      // Name is read with UPLOAD from the MTA
+      mtaExt = XCP_ADDR_EXT_MEMORY;
+      mta = (uint32_t)eventChannels[event].name;
+      break;
+    }
+
+    default:
+      Xcp_SendError(XCP_ERR_CMD_UNKNOWN);
+      return;
+  }
+
+  Xcp_Send(res, resLen);
+}
+
+static void Xcp_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Xcp_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+
+    // Handle received packets
+    while (rxTail != rxHead) {
+      const Xcp_Packet_T* packet = &rxQueue[rxTail];
+      if (packet->len > 0) {
+        if (packet->data[0] >= XCP_PID_CMD_MIN) {
+          Xcp_ProcessCommand(packet);
+        } else {
+          Xcp_ReceiveStim(packet);
+        }
+      }
+
+      // Done with the slot before the interrupt may reuse it
+      __DMB();
+      rxTail = (rxTail + 1U) % XCP_RX_QUEUE_LENGTH;
+    }
+
+    if (notifiedValue > 0) {
+      // ready to process
+      if (notifiedValue > 1) {
+        stats.eventOverruns += notifiedValue - 1U;
+      }
+
+      // Catch up on missed ticks, so the event channels keep their phase.
+      // Events due in the missed ticks are processed once.
+      uint32_t previousTick = eventTick;
+      eventTick += notifiedValue * XCP_PERIOD_MS;
+      size_t i;
+      for (i = 0; i < XCP_NUM_EVENTS; ++i) {
+        uint16_t period = eventChannels[i].periodMs;
+        if ((eventTick / period) != (previousTick / period)) {
+          Xcp_ProcessEvent(i);
+        }
+      }
+
+      if (applyDeferred) {
+        Xcp_ApplyParams();
+      }
+      Xcp_CheckStoreCal();
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Xcp_Status_T Xcp_Init(Logging_T* logger, Xcp_SendFunc_T send, Xcp_StoreAllowedFunc_T storeAllowed)
+{
+  log = logger;
+  logPrintS(log, "Xcp_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  sendFunc = send;
+  storeAllowedFunc = storeAllowed;
+
+  Xcp_FreeDaq();
+  connected = false;
+  mta = 0;
+  mtaExt = XCP_ADDR_EXT_MEMORY;
+  eventTick = 0;
+  applyDeferred = false;
+  storeCalPending = false;
+  rxHead = 0;
+  rxTail = 0;
+  memset(&stats, 0, sizeof(Xcp_Stats_T));
+
+  // create main task
+  xcpTaskHandle = xTaskCreateStatic(
+      Xcp_TaskMain,
+      "XcpTask",
+      XCP_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      XCP_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = XCP_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&xcpTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return XCP_STATUS_ERROR;
+  }
+
+  logPrintS(log, "Xcp_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return XCP_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Xcp_Receive(const uint8_t* data, uint8_t len)
+{
+  uint8_t next = (rxHead + 1U) % XCP_RX_QUEUE_LENGTH;
+  if (next == rxTail) {
+    stats.rxDropped++;
+    return;
+  }
+
+  if (len > XCP_MAX_CTO) {
+    len = XCP_MAX_CTO;
+  }
+  rxQueue[rxHead].len = len;
+  memcpy(rxQueue[rxHead].data, data, len);
+
+  // Packet is complete before the task can see it
+  __DMB();
+  rxHead = next;
+  stats.rxPackets++;
+}
+
+//------------------------------------------------------------------------------
+void Xcp_GetStats(Xcp_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
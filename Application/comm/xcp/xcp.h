@@ -0,0 +1,103 @@
+/*
+ * xcp.h
+ *
+ * XCP slave (measurement and calibration protocol layer).
+ *
+ * Supports:
+ *  - Memory upload (UPLOAD, SHORT_UPLOAD) for reading RAM and flash.
+ *  - Online calibration (DOWNLOAD) into the parameter store. Each DOWNLOAD
+ *    is applied to the control loop as one atomic parameter set update.
+ *  - Dynamic DAQ lists, sampled on fixed period event channels driven by
+ *    the task timer.
+ *  - STIM lists, writing into the parameter store on their event.
+ *  - Storing the active parameters to flash (SET_REQUEST with
+ *    STORE_CAL_REQ), only while the store allowed function permits, as the
+ *    flash erase stalls the CPU. The session status shows STORE_CAL_REQ until
+ *    the save finishes, then EV_STORE_CAL is sent if it succeeded.
+ *
+ * Address extensions:
+ *  - XCP_ADDR_EXT_MEMORY: absolute address, read only.
+ *  - XCP_ADDR_EXT_PARAM: parameter store, address = parameter ID * 4.
+ *
+ * All DAQ storage is statically allocated, so the work done per event is
+ * bounded by XCP_MAX_ODT_ENTRIES.
+ *
+ * The transport layer passes received packets to Xcp_Receive and provides
+ * the function used to send packets (see xcpCan).
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_XCP_XCP_H_
+#define COMM_XCP_XCP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+/* Maximum packet sizes (CAN) */
+#define XCP_MAX_CTO               ((uint8_t) 8U)
+#define XCP_MAX_DTO               ((uint8_t) 8U)
+
+/* Static DAQ resources */
+#define XCP_MAX_DAQ_LISTS         ((uint16_t) 8U)
+#define XCP_MAX_ODTS              ((uint8_t) 32U)
+#define XCP_MAX_ODT_ENTRIES       ((uint8_t) 64U)
+#define XCP_MAX_ODT_ENTRY_SIZE    ((uint8_t) 4U)
+
+/* Address extensions */
+#define XCP_ADDR_EXT_MEMORY       ((uint8_t) 0x00U)
+#define XCP_ADDR_EXT_PARAM        ((uint8_t) 0x01U)
+
+/* Period of the XCP task, and the base of the event channels */
+#define XCP_PERIOD_MS             ((uint16_t) 1U)
+
+typedef enum
+{
+  XCP_STATUS_OK     = 0x00U,
+  XCP_STATUS_ERROR  = 0x01U
+} Xcp_Status_T;
+
+/**
+ * Transport send function. Returns false if the packet could not be sent.
+ */
+typedef bool (*Xcp_SendFunc_T)(const uint8_t* data, uint8_t len);
+
+/**
+ * Returns true if the parameters may be stored to flash now.
+ */
+typedef bool (*Xcp_StoreAllowedFunc_T)(void);
+
+typedef struct
+{
+  uint32_t rxPackets;
+  uint32_t rxDropped;         /* Receive buffer full */
+  uint32_t txPackets;         /* Responses and DAQ packets sent */
+  uint32_t txDropped;         /* Transport could not send */
+  uint32_t eventOverruns;     /* Timer ticks missed while processing events */
+  uint32_t stimRejected;      /* STIM packets shorter than their ODT */
+  uint32_t storeCalFailed;    /* STORE_CAL_REQ saves that failed */
+} Xcp_Stats_T;
+
+/**
+ * @brief Initialize the XCP slave and create its task
+ * @param logger Pointer to system logger
+ * @param send Transport send function
+ * @param storeAllowed Store allowed function
+ */
+Xcp_Status_T Xcp_Init(Logging_T* logger, Xcp_SendFunc_T send, Xcp_StoreAllowedFunc_T storeAllowed);
+
+/**
+ * @brief Pass a received packet (CTO or STIM DTO) to the slave.
+ * May be called from an interrupt.
+ */
+void Xcp_Receive(const uint8_t* data, uint8_t len);
+
+/**
+ * @brief Get the slave statistics
+ */
+void Xcp_GetStats(Xcp_Stats_T* stats);
+
+#endif /* COMM_XCP_XCP_H_ */
@@ -0,0 +1,58 @@
+/*
+ * xcpCan.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "xcpCan.h"
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "comm/can/can.h"
+#include "comm/canTx/canTx.h"
+#include "comm/xcp/xcp.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+static CAN_HandleTypeDef* canHandle;
+
+// ------------------- Private methods -------------------
+static bool XcpCan_Send(const uint8_t* data, uint8_t len)
+{
+  uint8_t frame[XCP_MAX_DTO];
+  memcpy(frame, data, len);
+
+  return CAN_STATUS_OK == CanTx_Send(canHandle, XCPCAN_CAN_ID_DTO, frame, len);
+}
+
+static void XcpCan_Callback(const CAN_DataFrame_T* data)
+{
+  Xcp_Receive(data->data, (uint8_t)data->dlc);
+}
+
+// ------------------- Public methods -------------------
+XcpCan_Status_T XcpCan_Init(Logging_T* logger, CAN_HandleTypeDef* hcan, Xcp_StoreAllowedFunc_T storeAllowed)
+{
+  log = logger;
+  logPrintS(log, "XcpCan_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  canHandle = hcan;
+
+  Xcp_Status_T statusXcp = Xcp_Init(log, XcpCan_Send, storeAllowed);
+  if (XCP_STATUS_OK != statusXcp) {
+    return XCPCAN_STATUS_ERROR;
+  }
+
+  CAN_Status_T statusCan = CAN_RegisterCallback(canHandle, XCPCAN_CAN_ID_CMD, XcpCan_Callback);
+  if (CAN_STATUS_OK != statusCan) {
+    return XCPCAN_STATUS_ERROR;
+  }
+
+  logPrintS(log, "XcpCan_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return XCPCAN_STATUS_OK;
+}
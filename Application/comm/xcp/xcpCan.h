@@ -0,0 +1,38 @@
+/*
+ * xcpCan.h
+ *
+ * XCP on CAN transport layer.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_XCP_XCPCAN_H_
+#define COMM_XCP_XCPCAN_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+
+#include "lib/logging/logging.h"
+#include "comm/xcp/xcp.h"
+
+/* Master to slave (commands and STIM) */
+#define XCPCAN_CAN_ID_CMD         ((uint32_t) 0x550U)
+/* Slave to master (responses and DAQ) */
+#define XCPCAN_CAN_ID_DTO         ((uint32_t) 0x551U)
+
+typedef enum
+{
+  XCPCAN_STATUS_OK     = 0x00U,
+  XCPCAN_STATUS_ERROR  = 0x01U
+} XcpCan_Status_T;
+
+/**
+ * @brief Initialize the XCP slave on a CAN bus
+ * @param logger Pointer to system logger
+ * @param hcan CAN bus to use
+ * @param storeAllowed Whether the parameters may be stored to flash now
+ */
+XcpCan_Status_T XcpCan_Init(Logging_T* logger, CAN_HandleTypeDef* hcan, Xcp_StoreAllowedFunc_T storeAllowed);
+
+#endif /* COMM_XCP_XCPCAN_H_ */
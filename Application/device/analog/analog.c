@@ -0,0 +1,306 @@
+/*
+ * analog.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "analog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32f7xx_hal.h"
+
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+#include "lib/paramStore/paramStore.h"
+
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define ANALOG_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[ANALOG_STACK_SIZE];
+
+// Runs ahead of the processes reading the converted values on the same tick
+#define ANALOG_TASK_PRIORITY (tskIDLE_PRIORITY + 4)
+
+// Task data
+static TaskHandle_t analogTaskHandle;
+
+static const Analog_ChannelConfig_T* channelConfig;
+static uint8_t numChannels;
+static ADC_Channel_T vrefChannel;
+
+// Wiring diagnostics
+typedef struct
+{
+  const Analog_BiasConfig_T* config;
+  GPIO_PinState normal;
+  uint16_t slotStart;           /* Time in the diagnostic period */
+} Analog_Bias_T;
+
+static Analog_Bias_T biases[ANALOG_MAX_CHANNELS];
+static uint8_t numBiases;
+static uint16_t diagTime;       /* ms, 0..ANALOG_DIAG_PERIOD_MS-1 */
+
+static uint16_t counts[ANALOG_MAX_CHANNELS];  /* Held while the bias is switched */
+static uint32_t heldChannels;                 /* Bit per channel */
+
+static Analog_Health_T health[ANALOG_MAX_CHANNELS];
+static Analog_Health_T pendingHealth[ANALOG_MAX_CHANNELS];
+static uint8_t pendingCount[ANALOG_MAX_CHANNELS];
+
+/* VREFINT counts at 3.3V, measured in production */
+#define ANALOG_VREFINT_CAL (*VREFINT_CAL_ADDR_CMSIS)
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Compares the readings of a bias pin's channels in both states
+ * @param raw Readings with the bias switched
+ */
+static void Analog_Evaluate(const Analog_Bias_T* bias, const uint16_t* raw)
+{
+  uint8_t i;
+  for (i = 0; i < numChannels; ++i) {
+    if (0 == (bias->config->channels & (1UL << i))) {
+      continue;
+    }
+
+    // The held counts are from the normal state
+    bool normalUp = (GPIO_PIN_RESET == bias->normal);
+    uint16_t pulledUp = normalUp ? counts[i] : raw[i];
+    uint16_t pulledDown = normalUp ? raw[i] : counts[i];
+    Analog_Health_T result = Analog_Classify(pulledUp, pulledDown);
+
+    if (result != pendingHealth[i]) {
+      pendingHealth[i] = result;
+      pendingCount[i] = 0;
+    }
+    if (pendingCount[i] < ANALOG_DIAG_DEBOUNCE) {
+      pendingCount[i]++;
+    }
+    if (pendingCount[i] >= ANALOG_DIAG_DEBOUNCE) {
+      taskENTER_CRITICAL();
+      health[i] = result;
+      taskEXIT_CRITICAL();
+    }
+  }
+}
+
+/**
+ * @brief Runs the bias pin slots, and updates the counts of the channels
+ * not held
+ */
+static void Analog_RunDiagnostics(const uint16_t* raw)
+{
+  uint8_t b;
+  for (b = 0; b < numBiases; ++b) {
+    const Analog_Bias_T* bias = &biases[b];
+    uint16_t slotTime = (uint16_t)((diagTime + ANALOG_DIAG_PERIOD_MS - bias->slotStart) % ANALOG_DIAG_PERIOD_MS);
+
+    if (ANALOG_DIAG_SETTLE_MS == slotTime) {
+      Analog_Evaluate(bias, raw);
+      HAL_GPIO_WritePin(bias->config->port, bias->config->pin, bias->normal);
+    } else if (ANALOG_DIAG_SLOT_MS == slotTime) {
+      heldChannels &= ~bias->config->channels;
+    }
+  }
+
+  taskENTER_CRITICAL();
+  uint8_t i;
+  for (i = 0; i < numChannels; ++i) {
+    if (0 == (heldChannels & (1UL << i))) {
+      counts[i] = raw[i];
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  // Start of a slot, after the last normal reading is taken
+  for (b = 0; b < numBiases; ++b) {
+    const Analog_Bias_T* bias = &biases[b];
+    if (diagTime == bias->slotStart) {
+      heldChannels |= bias->config->channels;
+      GPIO_PinState switched = (GPIO_PIN_RESET == bias->normal) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+      HAL_GPIO_WritePin(bias->config->port, bias->config->pin, switched);
+    }
+  }
+
+  diagTime = (uint16_t)((diagTime + ANALOG_PERIOD_MS) % ANALOG_DIAG_PERIOD_MS);
+}
+
+static void Analog_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Analog_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      uint32_t sampleTime = CycleCounter_Get();
+
+      uint16_t raw[ANALOG_MAX_CHANNELS];
+      uint8_t i;
+      for (i = 0; i < numChannels; ++i) {
+        raw[i] = ADC_Get(i);
+      }
+      uint16_t vrefRaw = ADC_Get(vrefChannel);
+
+      Analog_RunDiagnostics(raw);
+
+      // Converted from the held counts, undisturbed by the diagnostics
+      float values[ANALOG_MAX_CHANNELS];
+      Analog_Convert(channelConfig, numChannels, counts, vrefRaw, values);
+
+      float vdda = Analog_Vdda(vrefRaw);
+      bool supplyValid = (vdda >= ANALOG_VDDA_MIN) && (vdda <= ANALOG_VDDA_MAX);
+
+      for (i = 0; i < numChannels; ++i) {
+        bool valid = channelConfig[i].ratiometric || supplyValid;
+        SignalDb_Set(MAPPING_SIGNAL_ANALOG(i), values[i], valid, sampleTime);
+        SignalDb_Set(MAPPING_SIGNAL_ANALOG_HEALTH(i), (float)health[i], true, sampleTime);
+      }
+      SignalDb_Set(MAPPING_SIGNAL_ANALOG(vrefChannel), vdda, supplyValid, sampleTime);
+      SignalDb_Publish(MAPPING_SIGNAL_GROUP_ANALOG);
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Analog_Status_T Analog_Init(Logging_T* logger, const Analog_ChannelConfig_T* channels, uint8_t num,
+                            ADC_Channel_T vref, const Analog_BiasConfig_T* biasConfig, uint8_t numBias)
+{
+  log = logger;
+  logPrintS(log, "Analog_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  // Slots must not overlap, so only one bias pin is switched at a time
+  if ((num > ANALOG_MAX_CHANNELS) || (numBias > ANALOG_MAX_CHANNELS) ||
+      (numBias * ANALOG_DIAG_SLOT_MS > ANALOG_DIAG_PERIOD_MS)) {
+    return ANALOG_STATUS_ERROR;
+  }
+
+  channelConfig = channels;
+  numChannels = num;
+  vrefChannel = vref;
+
+  memset(counts, 0, sizeof(counts));
+  memset(health, 0, sizeof(health));
+  memset(pendingHealth, 0, sizeof(pendingHealth));
+  memset(pendingCount, 0, sizeof(pendingCount));
+  heldChannels = 0;
+  diagTime = 0;
+
+  // Bias pins to their normal state, with their slots spread over the period
+  const ParamStore_Value_T* params = ParamStore_Get();
+  numBiases = numBias;
+  uint8_t b;
+  for (b = 0; b < numBiases; ++b) {
+    biases[b].config = &biasConfig[b];
+    biases[b].normal = params[biasConfig[b].normalParam].u32 ? GPIO_PIN_SET : GPIO_PIN_RESET;
+    biases[b].slotStart = (uint16_t)(b * (ANALOG_DIAG_PERIOD_MS / numBiases));
+    HAL_GPIO_WritePin(biasConfig[b].port, biasConfig[b].pin, biases[b].normal);
+  }
+
+  // create main task
+  analogTaskHandle = xTaskCreateStatic(
+      Analog_TaskMain,
+      "AnalogTask",
+      ANALOG_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      ANALOG_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = ANALOG_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&analogTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return ANALOG_STATUS_ERROR;
+  }
+
+  logPrintS(log, "Analog_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return ANALOG_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+uint16_t Analog_GetCounts(ADC_Channel_T channel)
+{
+  if (channel >= numChannels) {
+    return 0;
+  }
+
+  taskENTER_CRITICAL();
+  uint16_t value = counts[channel];
+  taskEXIT_CRITICAL();
+  return value;
+}
+
+//------------------------------------------------------------------------------
+Analog_Health_T Analog_GetHealth(ADC_Channel_T channel)
+{
+  if (channel >= numChannels) {
+    return ANALOG_HEALTH_NOT_TESTED;
+  }
+
+  taskENTER_CRITICAL();
+  Analog_Health_T value = health[channel];
+  taskEXIT_CRITICAL();
+  return value;
+}
+
+//------------------------------------------------------------------------------
+Analog_Health_T Analog_Classify(uint16_t pulledUp, uint16_t pulledDown)
+{
+  if (pulledUp < ANALOG_DIAG_RAIL_COUNTS) {
+    return ANALOG_HEALTH_SHORT_GROUND;
+  }
+  if (pulledDown > ANALOG_FULL_SCALE - ANALOG_DIAG_RAIL_COUNTS) {
+    return ANALOG_HEALTH_SHORT_SUPPLY;
+  }
+  if ((int32_t)pulledUp - (int32_t)pulledDown > (int32_t)ANALOG_DIAG_OPEN_COUNTS) {
+    return ANALOG_HEALTH_OPEN;
+  }
+  return ANALOG_HEALTH_OK;
+}
+
+//------------------------------------------------------------------------------
+void Analog_Convert(const Analog_ChannelConfig_T* channels, uint8_t num,
+                    const uint16_t* raw, uint16_t vrefRaw, float* values)
+{
+  // Scale from this supply to the nominal one, Q16
+  uint32_t supplyScale = (0U == vrefRaw) ? (1UL << 16) : (((uint32_t)ANALOG_VREFINT_CAL << 16) / vrefRaw);
+
+  uint8_t i;
+  for (i = 0; i < num; ++i) {
+    const Analog_ChannelConfig_T* config = &channels[i];
+
+    int32_t counts = raw[i];
+    if (!config->ratiometric) {
+      counts = (int32_t)(((uint32_t)counts * supplyScale) >> 16);
+    }
+    counts -= config->offset;
+    if (NULL != config->table) {
+      counts = Map_Uniform1D_Q(config->table, counts);
+    }
+    values[i] = (float)counts * config->gain;
+  }
+}
+
+//------------------------------------------------------------------------------
+float Analog_Vdda(uint16_t vrefRaw)
+{
+  if (0U == vrefRaw) {
+    return 0.0f;
+  }
+  return ANALOG_VDDA_NOMINAL * (float)ANALOG_VREFINT_CAL / (float)vrefRaw;
+}
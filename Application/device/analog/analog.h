@@ -0,0 +1,155 @@
+/*
+ * analog.h
+ *
+ * Conversion of the ADC channels to engineering units.
+ *
+ * Every tick, all channels are read once and converted in a single pass,
+ * configured per channel in analogMapping:
+ *  1. Supply correction. Channels measuring an absolute voltage are scaled
+ *     to the counts a 3.3V supply would give, from the internal reference
+ *     (VREFINT) and its factory calibration. Ratiometric channels, supplied
+ *     from VDDA themselves, are left as they are.
+ *  2. Calibration offset, in counts.
+ *  3. Linearisation through a lookup table (thermistors), if there is one.
+ *  4. Gain to engineering units.
+ * Steps 1 to 3 are integer. The results are published to the signal
+ * database, as MAPPING_SIGNAL_ANALOG(channel). Absolute channels are invalid
+ * while the supply measurement is implausible.
+ *
+ * Wiring diagnostics: inputs have a weak bias resistor, switched between
+ * pull-up and pull-down by a bias pin. A connected sensor drives its input
+ * whichever way it is biased, an open circuit follows the bias, and a short
+ * holds the input at a rail. Each bias pin is switched away from its normal
+ * state once per ANALOG_DIAG_PERIOD_MS, in its own slot:
+ *   0                  switch, hold the channels at their last reading
+ *   SETTLE             compare the readings of the two states, switch back
+ *   SETTLE + 1         release the channels
+ * While held, a channel's converted value and counts stay at the reading
+ * from before the switch, so the control samples never see the bias move.
+ * The hold is SETTLE readings. It only needs to cover the bias being
+ * switched: SETTLE is how long an open input takes to follow the weak bias,
+ * whereas a connected sensor drives its input back within a conversion.
+ * Health changes after ANALOG_DIAG_DEBOUNCE tests in a row agree, so a
+ * fault is reported within DEBOUNCE * PERIOD + SLOT (84ms). Health is
+ * published as MAPPING_SIGNAL_ANALOG_HEALTH(channel).
+ *
+ * Channels on different bias pins are held at different times. A held
+ * channel lags a moving sensor by up to SETTLE readings, so two channels
+ * that are compared, such as APPS1 and APPS2, may disagree for that long
+ * while the pedal moves. Their plausibility debounce must be longer.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef DEVICE_ANALOG_ANALOG_H_
+#define DEVICE_ANALOG_ANALOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+#include "lib/map/map.h"
+#include "io/adc/adc.h"
+#include "stm32f7xx_hal.h"
+
+#define ANALOG_PERIOD_MS            ((uint16_t) 1U)
+
+#define ANALOG_MAX_CHANNELS         ((uint8_t) 16U)
+
+/* Nominal supply, that VREFINT is calibrated at */
+#define ANALOG_VDDA_NOMINAL         3.3f
+#define ANALOG_FULL_SCALE           ((uint16_t) 4095U)
+
+/* Plausible supply, outside of which absolute channels are invalid */
+#define ANALOG_VDDA_MIN             3.0f
+#define ANALOG_VDDA_MAX             3.6f
+
+/* Wiring diagnostics */
+#define ANALOG_DIAG_PERIOD_MS       ((uint16_t) 40U)  /* Each bias pin is tested once per period */
+#define ANALOG_DIAG_SETTLE_MS       ((uint16_t) 3U)   /* After switching, before the reading is used */
+#define ANALOG_DIAG_SLOT_MS         ((uint16_t) (ANALOG_DIAG_SETTLE_MS + 1U))
+#define ANALOG_DIAG_DEBOUNCE        ((uint8_t) 2U)    /* Tests in a row that agree to change health */
+#define ANALOG_DIAG_OPEN_COUNTS     ((uint16_t) 1000U)/* Pull-up reading above pull-down by this is open */
+#define ANALOG_DIAG_RAIL_COUNTS     ((uint16_t) 50U)  /* Within this of a rail both ways is a short */
+
+typedef enum
+{
+  ANALOG_STATUS_OK     = 0x00U,
+  ANALOG_STATUS_ERROR  = 0x01U
+} Analog_Status_T;
+
+typedef struct
+{
+  const char* name;
+  bool ratiometric;             /* Supplied from VDDA, so not supply corrected */
+  int16_t offset;               /* Counts, subtracted */
+  const Map_Uniform1D_Q_T* table; /* Counts to table units, or NULL */
+  float gain;                   /* Engineering units per count, or per table unit */
+} Analog_ChannelConfig_T;
+
+typedef enum
+{
+  ANALOG_HEALTH_NOT_TESTED    = 0U,   /* No bias pin, or not tested yet */
+  ANALOG_HEALTH_OK            = 1U,
+  ANALOG_HEALTH_OPEN          = 2U,
+  ANALOG_HEALTH_SHORT_GROUND  = 3U,
+  ANALOG_HEALTH_SHORT_SUPPLY  = 4U
+} Analog_Health_T;
+
+/*
+ * A bias pin. RESET pulls its channels up, SET pulls them down.
+ */
+typedef struct
+{
+  const char* name;
+  GPIO_TypeDef* port;
+  uint16_t pin;
+  uint8_t normalParam;          /* ParamStore index of the normal state, 0 => pull up */
+  uint32_t channels;            /* Bit per ADC channel biased */
+} Analog_BiasConfig_T;
+
+/**
+ * @brief Initialize and start the conversion
+ * @param logger Pointer to system logger
+ * @param channels Channel table, indexed by ADC channel, must remain valid
+ * @param vrefChannel ADC channel sampling VREFINT
+ * @param biases Bias pin table, must remain valid. The slots of all of the
+ * pins must fit in ANALOG_DIAG_PERIOD_MS.
+ */
+Analog_Status_T Analog_Init(Logging_T* logger, const Analog_ChannelConfig_T* channels, uint8_t numChannels,
+                            ADC_Channel_T vrefChannel, const Analog_BiasConfig_T* biases, uint8_t numBiases);
+
+/**
+ * @brief Latest ADC counts of a channel, held while its bias is switched
+ */
+uint16_t Analog_GetCounts(ADC_Channel_T channel);
+
+/**
+ * @brief Wiring health of a channel
+ */
+Analog_Health_T Analog_GetHealth(ADC_Channel_T channel);
+
+/**
+ * @brief Wiring health from the readings of a channel in both bias states
+ * @param pulledUp Counts with the bias pulling up
+ * @param pulledDown Counts with the bias pulling down
+ */
+Analog_Health_T Analog_Classify(uint16_t pulledUp, uint16_t pulledDown);
+
+/**
+ * @brief Converts one reading of every channel
+ * @param raw ADC counts, per channel
+ * @param vrefRaw ADC counts of VREFINT
+ * @param values Set to the engineering units, per channel
+ */
+void Analog_Convert(const Analog_ChannelConfig_T* channels, uint8_t numChannels,
+                    const uint16_t* raw, uint16_t vrefRaw, float* values);
+
+/**
+ * @brief Supply voltage, measured from VREFINT
+ * @param vrefRaw ADC counts of VREFINT
+ */
+float Analog_Vdda(uint16_t vrefRaw);
+
+#endif /* DEVICE_ANALOG_ANALOG_H_ */
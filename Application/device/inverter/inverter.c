@@ -0,0 +1,363 @@
+/*
+ * inverter.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "inverter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "comm/can/can.h"
+#include "comm/canTx/canTx.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+#include "time/deferred/deferred.h"
+
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define INVERTER_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[INVERTER_STACK_SIZE];
+
+// Below the processes producing the command so that it is sent on the same tick
+#define INVERTER_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
+
+// Task data
+static TaskHandle_t inverterTaskHandle;
+
+// Devices used
+static CAN_HandleTypeDef* canHandle;
+
+/*
+ * Frame layout (little endian)
+ * Command: [0..1] torque (0.1Nm), [2..3] speed limit (rpm), [4] flags,
+ *          [6] rolling counter (low nibble), [7] checksum
+ * Status:  [0..1] motor speed (rpm), [2..3] torque (0.1Nm), [4..5] DC voltage (0.1V),
+ *          [6] rolling counter (low nibble), state (bits 4-6), fault (bit 7), [7] checksum
+ * The checksum is the inverted 8-bit sum of bytes 0..6.
+ */
+#define INVERTER_FLAG_ENABLE      0x01U
+#define INVERTER_COUNTER_MASK     0x0FU
+#define INVERTER_STATE_MASK       0x70U
+#define INVERTER_STATE_SHIFT      4U
+#define INVERTER_FAULT_MASK       0x80U
+
+static Inverter_Command_T command;
+static bool commandSet;
+static TickType_t commandTick;
+static float torqueLimit;
+static bool enabled;
+static uint8_t txCounter;
+
+static Inverter_Feedback_T feedback;
+static uint32_t feedbackTime;       /* CycleCounter time the status was decoded */
+static CanMonitor_Handle_T statusMonitor;
+static Deferred_Source_T statusSource;
+static uint8_t rxCounter;
+
+static Inverter_Stats_T stats;
+
+// ------------------- Private methods -------------------
+static uint8_t Inverter_Checksum(const uint8_t* data)
+{
+  uint8_t sum = 0;
+  size_t i;
+  for (i = 0; i < 7; ++i) {
+    sum += data[i];
+  }
+  return (uint8_t)~sum;
+}
+
+static int16_t Inverter_ToInt16(float value)
+{
+  if (value > 32767.0f) {
+    return INT16_MAX;
+  } else if (value < -32768.0f) {
+    return INT16_MIN;
+  }
+  return (int16_t)(value + ((value >= 0.0f) ? 0.5f : -0.5f));
+}
+
+static void Inverter_SendCommand(void)
+{
+  Inverter_Command_T cmd;
+  bool haveCommand;
+  TickType_t commandAge;
+  float limit;
+  bool enable;
+  taskENTER_CRITICAL();
+  cmd = command;
+  haveCommand = commandSet;
+  commandAge = xTaskGetTickCount() - commandTick;
+  limit = torqueLimit;
+  enable = enabled;
+  taskEXIT_CRITICAL();
+
+  // The process producing the command has stopped, don't hold its last torque
+  if (haveCommand && (commandAge > pdMS_TO_TICKS(INVERTER_COMMAND_TIMEOUT_MS))) {
+    haveCommand = false;
+    stats.commandTimeouts++;
+  }
+  if (!haveCommand) {
+    cmd.torque = 0.0f;
+  }
+
+  if (cmd.torque > limit) {
+    cmd.torque = limit;
+  }
+  if (!enable) {
+    cmd.torque = 0.0f;
+  }
+
+  uint8_t data[8];
+  Inverter_EncodeCommand(&cmd, enable, txCounter, data);
+
+  txCounter = (txCounter + 1) & INVERTER_COUNTER_MASK;
+
+  CanTx_Send(canHandle, INVERTER_CAN_ID_COMMAND, data, 8);
+  stats.framesSent++;
+  if (!haveCommand) {
+    return;
+  }
+
+  // Latency from the sample that produced this command to it being queued for transmit
+  uint32_t latencyUs = CycleCounter_ToMicros(CycleCounter_Elapsed(cmd.sampleTime));
+  stats.latencyLastUs = latencyUs;
+  if (latencyUs > stats.latencyMaxUs) {
+    stats.latencyMaxUs = latencyUs;
+  }
+  if (latencyUs > INVERTER_LATENCY_BUDGET_US) {
+    stats.latencyOverruns++;
+  }
+}
+
+/**
+ * @brief Publishes the latest feedback, invalid once the status is stale
+ */
+static void Inverter_PublishFeedback(void)
+{
+  Inverter_Feedback_T fb;
+  Inverter_GetFeedback(&fb);
+
+  taskENTER_CRITICAL();
+  uint32_t time = feedbackTime;
+  taskEXIT_CRITICAL();
+
+  SignalDb_Set(MAPPING_SIGNAL_MOTOR_SPEED, fb.motorSpeed, fb.valid, time);
+  SignalDb_Set(MAPPING_SIGNAL_MOTOR_TORQUE, fb.torqueActual, fb.valid, time);
+  SignalDb_Set(MAPPING_SIGNAL_DC_VOLTAGE, fb.dcVoltage, fb.valid, time);
+  SignalDb_Set(MAPPING_SIGNAL_INVERTER_FAULTED, fb.faulted ? 1.0f : 0.0f, fb.valid, time);
+  SignalDb_Publish(MAPPING_SIGNAL_GROUP_INVERTER);
+}
+
+static void Inverter_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Inverter_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      Inverter_SendCommand();
+      Inverter_PublishFeedback();
+    }
+
+  }
+}
+
+/**
+ * @brief Decodes a status frame, from the deferred dispatcher
+ */
+static void Inverter_ProcessStatus(const void* item)
+{
+  const CAN_DataFrame_T* data = item;
+
+  uint8_t counter = data->data[6] & INVERTER_COUNTER_MASK;
+  if (stats.statusReceived > 0 && counter != ((rxCounter + 1) & INVERTER_COUNTER_MASK)) {
+    stats.statusCounterErrors++;
+  }
+  rxCounter = counter;
+  stats.statusReceived++;
+
+  Inverter_Feedback_T fb;
+  Inverter_DecodeStatus(data->data, &fb);
+
+  taskENTER_CRITICAL();
+  feedback.motorSpeed = fb.motorSpeed;
+  feedback.torqueActual = fb.torqueActual;
+  feedback.dcVoltage = fb.dcVoltage;
+  feedback.state = fb.state;
+  feedback.faulted = fb.faulted;
+  feedbackTime = CycleCounter_Get();
+  taskEXIT_CRITICAL();
+}
+
+static void Inverter_StatusCallback(const CAN_DataFrame_T* data)
+{
+  if (data->dlc < 8) {
+    return;
+  }
+
+  if (Inverter_Checksum(data->data) != data->data[7]) {
+    stats.statusChecksumErrors++;
+    return;
+  }
+
+  CanMonitor_Received(statusMonitor);
+  Deferred_Post(statusSource, data);
+}
+
+// ------------------- Public methods -------------------
+Inverter_Status_T Inverter_Init(Logging_T* logger, CAN_HandleTypeDef* hcan)
+{
+  log = logger;
+  logPrintS(log, "Inverter_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  canHandle = hcan;
+
+  memset(&command, 0, sizeof(Inverter_Command_T));
+  commandSet = false;
+  commandTick = 0;
+  torqueLimit = INVERTER_MAX_TORQUE_NM;
+  enabled = false;
+  memset(&feedback, 0, sizeof(Inverter_Feedback_T));
+  memset(&stats, 0, sizeof(Inverter_Stats_T));
+  txCounter = 0;
+  rxCounter = 0;
+
+  CanMonitor_Config_T monitorConfig = {
+    .id = INVERTER_CAN_ID_STATUS,
+    .periodMs = INVERTER_STATUS_PERIOD_MS,
+    .timeoutMs = INVERTER_STATUS_TIMEOUT_MS,
+    .callback = NULL,
+  };
+  CanMonitor_Status_T statusMonitorReg = CanMonitor_Register(&monitorConfig, &statusMonitor);
+  if (CANMONITOR_STATUS_OK != statusMonitorReg) {
+    return INVERTER_STATUS_ERROR;
+  }
+
+  // Decoded outside the CAN interrupt
+  Deferred_Config_T deferredConfig = {
+    .handler = Inverter_ProcessStatus,
+    .itemSize = sizeof(CAN_DataFrame_T),
+  };
+  Deferred_Status_T statusDeferred = Deferred_Register(&deferredConfig, &statusSource);
+  if (DEFERRED_STATUS_OK != statusDeferred) {
+    return INVERTER_STATUS_ERROR;
+  }
+
+  CAN_Status_T statusCan = CAN_RegisterCallback(canHandle, INVERTER_CAN_ID_STATUS, Inverter_StatusCallback);
+  if (CAN_STATUS_OK != statusCan) {
+    return INVERTER_STATUS_ERROR;
+  }
+
+  // create main task
+  inverterTaskHandle = xTaskCreateStatic(
+      Inverter_TaskMain,
+      "InverterTask",
+      INVERTER_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      INVERTER_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = INVERTER_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&inverterTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return INVERTER_STATUS_ERROR;
+  }
+
+  logPrintS(log, "Inverter_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return INVERTER_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Inverter_SetCommand(const Inverter_Command_T* cmd)
+{
+  taskENTER_CRITICAL();
+  command = *cmd;
+  commandSet = true;
+  commandTick = xTaskGetTickCount();
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Inverter_SetEnable(bool enable)
+{
+  taskENTER_CRITICAL();
+  enabled = enable;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Inverter_SetTorqueLimit(float limit)
+{
+  taskENTER_CRITICAL();
+  torqueLimit = limit;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Inverter_GetFeedback(Inverter_Feedback_T* fb)
+{
+  taskENTER_CRITICAL();
+  *fb = feedback;
+  taskEXIT_CRITICAL();
+
+  fb->valid = !CanMonitor_IsStale(statusMonitor);
+}
+
+//------------------------------------------------------------------------------
+void Inverter_GetStats(Inverter_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Inverter_EncodeCommand(const Inverter_Command_T* cmd, bool enable, uint8_t counter, uint8_t* data)
+{
+  int16_t torque = Inverter_ToInt16(cmd->torque * 10.0f);
+  int16_t speedLimit = Inverter_ToInt16(cmd->speedLimit);
+
+  data[0] = torque & 0xFF;
+  data[1] = (torque >> 8) & 0xFF;
+  data[2] = speedLimit & 0xFF;
+  data[3] = (speedLimit >> 8) & 0xFF;
+  data[4] = enable ? INVERTER_FLAG_ENABLE : 0x00U;
+  data[5] = 0x00U;
+  data[6] = counter;
+  data[7] = Inverter_Checksum(data);
+}
+
+//------------------------------------------------------------------------------
+void Inverter_DecodeStatus(const uint8_t* data, Inverter_Feedback_T* fb)
+{
+  int16_t speed = (int16_t)(data[0] | (data[1] << 8));
+  int16_t torque = (int16_t)(data[2] | (data[3] << 8));
+  uint16_t voltage = (uint16_t)(data[4] | (data[5] << 8));
+  uint8_t state = data[6];
+
+  fb->motorSpeed = (float)speed;
+  fb->torqueActual = (float)torque * 0.1f;
+  fb->dcVoltage = (float)voltage * 0.1f;
+  fb->state = (state & INVERTER_STATE_MASK) >> INVERTER_STATE_SHIFT;
+  fb->faulted = (state & INVERTER_FAULT_MASK) != 0;
+  fb->valid = false;
+}
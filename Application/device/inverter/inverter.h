@@ -0,0 +1,133 @@
+/*
+ * inverter.h
+ *
+ * Motor controller (inverter) CAN interface.
+ *
+ * Sends the torque and speed limit command every 1ms with a rolling counter
+ * and checksum, and parses the inverter's status frame. Tracks the latency
+ * from the pedal sample that produced the command to its CAN transmission.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef DEVICE_INVERTER_INVERTER_H_
+#define DEVICE_INVERTER_INVERTER_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define INVERTER_PERIOD_MS            ((uint16_t) 1U)
+
+#define INVERTER_CAN_ID_COMMAND       ((uint32_t) 0x201U)
+#define INVERTER_CAN_ID_STATUS        ((uint32_t) 0x181U)
+
+/* Maximum torque the inverter will be commanded to (Nm) */
+#define INVERTER_MAX_TORQUE_NM        140.0f
+
+/* Motor speed limit sent with each command */
+#define INVERTER_MAX_SPEED_RPM        6000.0f
+
+/* Pedal sample to CAN transmit latency budget */
+#define INVERTER_LATENCY_BUDGET_US    ((uint32_t) 2000U)
+
+/* A command older than this is stale, and zero torque is sent in its place */
+#define INVERTER_COMMAND_TIMEOUT_MS   ((uint32_t) 5U)
+
+/* Status frame is expected at this period, and is stale if not received within the timeout */
+#define INVERTER_STATUS_PERIOD_MS     ((uint32_t) 10U)
+#define INVERTER_STATUS_TIMEOUT_MS    ((uint32_t) 50U)
+
+typedef enum
+{
+  INVERTER_STATUS_OK     = 0x00U,
+  INVERTER_STATUS_ERROR  = 0x01U
+} Inverter_Status_T;
+
+typedef struct
+{
+  float torque;           /* Nm */
+  float speedLimit;       /* rpm */
+  uint32_t sampleTime;    /* CycleCounter time of the input sample this command derives from */
+} Inverter_Command_T;
+
+typedef struct
+{
+  float motorSpeed;       /* rpm */
+  float torqueActual;     /* Nm */
+  float dcVoltage;        /* V */
+  uint8_t state;          /* Inverter reported state */
+  bool faulted;           /* Inverter reported fault */
+  bool valid;             /* Status received within INVERTER_STATUS_TIMEOUT_MS */
+} Inverter_Feedback_T;
+
+typedef struct
+{
+  uint32_t latencyLastUs;
+  uint32_t latencyMaxUs;
+  uint32_t latencyOverruns;   /* Commands sent outside of INVERTER_LATENCY_BUDGET_US */
+  uint32_t framesSent;
+  uint32_t commandTimeouts;   /* Frames sent with zero torque as the command was stale */
+  uint32_t statusReceived;
+  uint32_t statusCounterErrors;
+  uint32_t statusChecksumErrors;
+} Inverter_Stats_T;
+
+/**
+ * @brief Initialize the inverter interface
+ * @param logger Pointer to system logger
+ * @param hcan CAN bus the inverter is on
+ */
+Inverter_Status_T Inverter_Init(Logging_T* logger, CAN_HandleTypeDef* hcan);
+
+/**
+ * @brief Set the command to send on the next cycle.
+ * Must be refreshed every cycle: once it is older than INVERTER_COMMAND_TIMEOUT_MS
+ * zero torque is sent instead.
+ */
+void Inverter_SetCommand(const Inverter_Command_T* command);
+
+/**
+ * @brief Enable or disable the inverter power stage.
+ * While disabled, the command is sent with zero torque and the enable flag cleared.
+ * Owned by the vehicle state machine. Disabled at initialization.
+ */
+void Inverter_SetEnable(bool enable);
+
+/**
+ * @brief Limit the drive torque sent to the inverter, regardless of the command.
+ * Used by processes that intervene on the driver's request (e.g. traction control).
+ * @param limit Maximum drive torque (Nm)
+ */
+void Inverter_SetTorqueLimit(float limit);
+
+/**
+ * @brief Get the latest feedback from the inverter
+ */
+void Inverter_GetFeedback(Inverter_Feedback_T* feedback);
+
+/**
+ * @brief Get the interface statistics
+ */
+void Inverter_GetStats(Inverter_Stats_T* stats);
+
+/**
+ * @brief Encode a command frame, as it is sent
+ * @param cmd Torque and speed limit to send, already limited
+ * @param enable Power stage enable flag
+ * @param counter Rolling counter
+ * @param data Frame to fill, 8 bytes
+ */
+void Inverter_EncodeCommand(const Inverter_Command_T* cmd, bool enable, uint8_t counter, uint8_t* data);
+
+/**
+ * @brief Decode a status frame. The checksum and counter are not checked.
+ * @param data Frame received, 8 bytes
+ * @param fb Decoded feedback, with valid left false
+ */
+void Inverter_DecodeStatus(const uint8_t* data, Inverter_Feedback_T* fb);
+
+#endif /* DEVICE_INVERTER_INVERTER_H_ */
@@ -8,13 +8,16 @@
 #include "wheelspeed.h"
 
 #include <stdio.h>
+#include <string.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "stm32f7xx_hal.h"
 
 #include "vehicleInterface/deviceMapping/deviceMapping.h" /* Fetch auto-generated GPIO names */
+#include "vehicleInterface/signalMapping/signalMapping.h"
 
 #include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
 #include "lib/logging/logging.h"
 
 // ------------------- Private data -------------------
@@ -24,9 +27,94 @@ static Logging_T* log;
 static StaticTask_t taskBuffer;
 static StackType_t taskStack[STACK_SIZE];
 
+// Sensor data is produced ahead of the control processes on the same tick
+#define WHEELSPEED_TASK_PRIORITY (tskIDLE_PRIORITY + 4)
+
 // Task data
 static TaskHandle_t wheelSpeedTaskHandle;
+
+// Pulse capture - written from the EXTI interrupt
+typedef struct
+{
+  volatile uint32_t pulseCount;
+  volatile uint32_t lastPulseTime;  // CycleCounter time of the most recent pulse
+} WheelSpeed_Capture_T;
+
+static WheelSpeed_Capture_T capture[WHEELSPEED_NUM_WHEELS];
+
+// Calculation state - owned by the task
+typedef struct
+{
+  uint32_t pulseCount;
+  uint32_t pulseTime;
+  bool stopped;       // Timed out, or no pulse yet. The next pulse only restarts the measurement.
+} WheelSpeed_Last_T;
+
+static WheelSpeed_Last_T last[WHEELSPEED_NUM_WHEELS];
+
+static WheelSpeed_Data_T wheelSpeedData;
+
+static const SignalDb_Signal_T signals[WHEELSPEED_NUM_WHEELS] = {
+  [WHEELSPEED_FL] = MAPPING_SIGNAL_WHEELSPEED_FL,
+  [WHEELSPEED_FR] = MAPPING_SIGNAL_WHEELSPEED_FR,
+  [WHEELSPEED_RL] = MAPPING_SIGNAL_WHEELSPEED_RL,
+  [WHEELSPEED_RR] = MAPPING_SIGNAL_WHEELSPEED_RR,
+};
+
 // ------------------- Private methods -------------------
+/**
+ * @brief Calculates the speed of a single wheel from the pulses seen since
+ * the last calculation. With no new pulses, the speed decays as if a pulse
+ * was about to arrive, until the timeout.
+ * Once stopped, the wheel reads zero until a second pulse. The CycleCounter
+ * wraps every 21s, so the time since a pulse from before the stop can't be
+ * measured, and the first pulse is only taken as the new reference.
+ */
+static float WheelSpeed_Calculate(WheelSpeed_Wheel_T wheel, uint32_t now, float previous)
+{
+  const float distPerPulse = WHEELSPEED_TYRE_CIRC_M / (float)WHEELSPEED_TEETH;
+  const float cyclesPerSec = (float)SystemCoreClock;
+
+  uint32_t pulseCount;
+  uint32_t pulseTime;
+  taskENTER_CRITICAL();
+  pulseCount = capture[wheel].pulseCount;
+  pulseTime = capture[wheel].lastPulseTime;
+  taskEXIT_CRITICAL();
+
+  uint32_t newPulses = pulseCount - last[wheel].pulseCount;
+  uint32_t sinceLastPulse = now - pulseTime;
+  float speed = previous;
+
+  if (last[wheel].stopped) {
+    speed = 0.0f;
+    if (newPulses > 0) {
+      last[wheel].stopped = false;
+    }
+  } else if (sinceLastPulse > (WHEELSPEED_TIMEOUT_MS * (SystemCoreClock / 1000U))) {
+    speed = 0.0f;
+    last[wheel].stopped = true;
+  } else if (newPulses > 0) {
+    uint32_t dt = pulseTime - last[wheel].pulseTime;
+    if (dt > 0) {
+      speed = (float)newPulses * distPerPulse * cyclesPerSec / (float)dt;
+    }
+  } else if (sinceLastPulse > 0) {
+    // No pulse yet - speed can be at most what the next pulse would give
+    float upperBound = distPerPulse * cyclesPerSec / (float)sinceLastPulse;
+    if (upperBound < speed) {
+      speed = upperBound;
+    }
+  }
+
+  if (newPulses > 0) {
+    last[wheel].pulseCount = pulseCount;
+    last[wheel].pulseTime = pulseTime;
+  }
+
+  return speed;
+}
+
 static void WheelSpeed_TaskMain(void* pvParameters)
 {
   logPrintS(log, "WheelSpeed_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
@@ -42,6 +130,20 @@ static void WheelSpeed_TaskMain(void* pvParameters)
 
       // Just toggle this pin really quickly
       HAL_GPIO_TogglePin(SPEED_TEST_GPO_GPIO_Port, SPEED_TEST_GPO_Pin);
+
+      WheelSpeed_Data_T data;
+      data.updateTime = CycleCounter_Get();
+
+      size_t i;
+      for (i = 0; i < WHEELSPEED_NUM_WHEELS; ++i) {
+        data.speed[i] = WheelSpeed_Calculate((WheelSpeed_Wheel_T)i, data.updateTime, wheelSpeedData.speed[i]);
+        SignalDb_Set(signals[i], data.speed[i], true, data.updateTime);
+      }
+      SignalDb_Publish(MAPPING_SIGNAL_GROUP_WHEELSPEED);
+
+      taskENTER_CRITICAL();
+      wheelSpeedData = data;
+      taskEXIT_CRITICAL();
     }
 
   }
@@ -54,18 +156,27 @@ WheelSpeed_Status_T WheelSpeed_Init(Logging_T* logger)
   log = logger;
   logPrintS(log, "WheelSpeed_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
 
+  memset(capture, 0, sizeof(capture));
+  memset(last, 0, sizeof(last));
+  memset(&wheelSpeedData, 0, sizeof(WheelSpeed_Data_T));
+
+  size_t i;
+  for (i = 0; i < WHEELSPEED_NUM_WHEELS; ++i) {
+    last[i].stopped = true;
+  }
+
   // create main task
   wheelSpeedTaskHandle = xTaskCreateStatic(
       WheelSpeed_TaskMain,
       "WheelSpeedTask",
       STACK_SIZE,   /* Stack size */
       NULL,  /* Parameter passed as pointer */
-      tskIDLE_PRIORITY,
+      WHEELSPEED_TASK_PRIORITY,
       taskStack,
       &taskBuffer);
 
   // Register the task for timer notifications every 1ms
-  uint16_t timerDivider = 1 * TASKTIMER_BASE_PERIOD_MS;
+  uint16_t timerDivider = WHEELSPEED_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
   TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&wheelSpeedTaskHandle, timerDivider);
   if (TASKTIMER_STATUS_OK != statusTimer) {
     return WHEELSPEED_STATUS_ERROR;
@@ -74,3 +185,27 @@ WheelSpeed_Status_T WheelSpeed_Init(Logging_T* logger)
   logPrintS(log, "WheelSpeed_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
   return WHEELSPEED_STATUS_OK;
 }
+
+//------------------------------------------------------------------------------
+void WheelSpeed_Get(WheelSpeed_Data_T* data)
+{
+  taskENTER_CRITICAL();
+  *data = wheelSpeedData;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void WheelSpeed_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  WheelSpeed_Wheel_T wheel;
+  switch (GPIO_Pin) {
+    case WHEELSPEED_FL_Pin: wheel = WHEELSPEED_FL; break;
+    case WHEELSPEED_FR_Pin: wheel = WHEELSPEED_FR; break;
+    case WHEELSPEED_RL_Pin: wheel = WHEELSPEED_RL; break;
+    case WHEELSPEED_RR_Pin: wheel = WHEELSPEED_RR; break;
+    default: return;
+  }
+
+  capture[wheel].lastPulseTime = CycleCounter_Get();
+  capture[wheel].pulseCount++;
+}
@@ -8,19 +8,58 @@
 #ifndef DEVICE_WHEELSPEED_WHEELSPEED_H_
 #define DEVICE_WHEELSPEED_WHEELSPEED_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "lib/logging/logging.h"
 
+#define WHEELSPEED_PERIOD_MS        ((uint16_t) 1U)
+
+/* Sensor tone wheel and tyre geometry */
+#define WHEELSPEED_TEETH            ((uint16_t) 24U)
+#define WHEELSPEED_TYRE_CIRC_M      1.60f
+
+/* Wheel is considered stopped if no pulse is seen for this long */
+#define WHEELSPEED_TIMEOUT_MS       ((uint32_t) 250U)
+
 typedef enum
 {
   WHEELSPEED_STATUS_OK     = 0x00U,
   WHEELSPEED_STATUS_ERROR  = 0x01U
 } WheelSpeed_Status_T;
 
+typedef enum
+{
+  WHEELSPEED_FL = 0U,
+  WHEELSPEED_FR = 1U,
+  WHEELSPEED_RL = 2U,
+  WHEELSPEED_RR = 3U,
+  WHEELSPEED_NUM_WHEELS = 4U
+} WheelSpeed_Wheel_T;
+
+typedef struct
+{
+  float speed[WHEELSPEED_NUM_WHEELS];   /* Wheel surface speed (m/s) */
+  uint32_t updateTime;                  /* CycleCounter time of the calculation */
+} WheelSpeed_Data_T;
+
 /**
  * @brief Initialize the process
  * @param logger Pointer to logging settings
  */
 WheelSpeed_Status_T WheelSpeed_Init(Logging_T* logger);
 
+/**
+ * @brief Get the most recent wheel speeds
+ */
+void WheelSpeed_Get(WheelSpeed_Data_T* data);
+
+/**
+ * @brief Wheel speed sensor pulse interrupt handler.
+ * Called from HAL_GPIO_EXTI_Callback.
+ * @param GPIO_Pin Pin that triggered the interrupt
+ */
+void WheelSpeed_EXTI_Callback(uint16_t GPIO_Pin);
+
 
 #endif /* DEVICE_WHEELSPEED_WHEELSPEED_H_ */
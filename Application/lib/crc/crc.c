@@ -0,0 +1,36 @@
+/*
+ * crc.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "crc.h"
+
+// ------------------- Public methods -------------------
+void Crc_Init(void)
+{
+  __HAL_RCC_CRC_CLK_ENABLE();
+
+  // Default polynomial and initial value, 32-bit input, no reversal
+  CRC->POL = 0x04C11DB7U;
+  CRC->INIT = 0xFFFFFFFFU;
+  CRC->CR = CRC_CR_RESET;
+}
+
+//------------------------------------------------------------------------------
+uint32_t Crc_Calculate(const uint32_t* data, uint32_t numWords)
+{
+  CRC->CR = CRC_CR_RESET;
+  return Crc_Accumulate(data, numWords);
+}
+
+//------------------------------------------------------------------------------
+uint32_t Crc_Accumulate(const uint32_t* data, uint32_t numWords)
+{
+  uint32_t i;
+  for (i = 0; i < numWords; ++i) {
+    CRC->DR = data[i];
+  }
+  return CRC->DR;
+}
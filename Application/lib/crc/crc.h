@@ -0,0 +1,39 @@
+/*
+ * crc.h
+ *
+ * CRC-32 using the hardware CRC unit
+ * (polynomial 0x04C11DB7, initial value 0xFFFFFFFF, 32-bit words, no reflection).
+ *
+ * The CRC unit is shared, so calculations must not run concurrently
+ * from different tasks.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_CRC_CRC_H_
+#define LIB_CRC_CRC_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+
+/**
+ * @brief Enables the CRC unit and sets its default configuration
+ */
+void Crc_Init(void);
+
+/**
+ * @brief Calculates the CRC of a block of words, starting from the initial value
+ * @param data Word aligned data
+ * @param numWords Number of 32-bit words
+ */
+uint32_t Crc_Calculate(const uint32_t* data, uint32_t numWords);
+
+/**
+ * @brief Continues a CRC started with Crc_Calculate over another block
+ * @param data Word aligned data
+ * @param numWords Number of 32-bit words
+ */
+uint32_t Crc_Accumulate(const uint32_t* data, uint32_t numWords);
+
+#endif /* LIB_CRC_CRC_H_ */
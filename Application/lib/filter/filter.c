@@ -0,0 +1,276 @@
+/*
+ * filter.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "filter.h"
+
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "filterDsp.h"
+
+// ------------------- Private data -------------------
+#define FILTER_PI 3.14159265f
+
+// ------------------- Private methods -------------------
+static inline int16_t Filter_Sat64To16(int64_t x)
+{
+  return (x > INT16_MAX) ? INT16_MAX : ((x < INT16_MIN) ? INT16_MIN : (int16_t)x);
+}
+
+static inline int32_t Filter_Sat64To32(int64_t x)
+{
+  return (x > INT32_MAX) ? INT32_MAX : ((x < INT32_MIN) ? INT32_MIN : (int32_t)x);
+}
+
+static inline int32_t Filter_Clamp32(int32_t x, int32_t lo, int32_t hi)
+{
+  return (x < lo) ? lo : ((x > hi) ? hi : x);
+}
+
+/**
+ * @brief Rounds a float to a fixed point value, saturating
+ * @param scale 2^(fractional bits)
+ */
+static int64_t Filter_ToFixed(float x, float scale, int64_t max)
+{
+  float scaled = roundf(x * scale);
+  if (scaled >= (float)max) {
+    return max;
+  }
+  if (scaled <= (float)(-max - 1)) {
+    return -max - 1;
+  }
+  return (int64_t)scaled;
+}
+
+/**
+ * @brief One sample through one Q15 stage.
+ * The taps are paired as (x0, x1), (x2, y1) and (y2, 0), matching the
+ * coefficient pairs, so each pair is one dual multiply-accumulate.
+ */
+static inline int16_t Filter_BiquadQ15_Stage(const int16_t* coeffs, int16_t* state, int16_t x, uint8_t shift)
+{
+  uint32_t b0b1;
+  uint32_t b2a1;
+  uint32_t a2;
+  memcpy(&b0b1, &coeffs[0], sizeof(uint32_t));
+  memcpy(&b2a1, &coeffs[2], sizeof(uint32_t));
+  memcpy(&a2, &coeffs[4], sizeof(uint32_t));
+
+  uint32_t x2y1;
+  memcpy(&x2y1, &state[1], sizeof(uint32_t));
+
+  int64_t acc = Filter_Smlald(FILTER_PACK(x, state[0]), b0b1, 0);
+  acc = Filter_Smlald(x2y1, b2a1, acc);
+  acc = Filter_Smlald(FILTER_PACK(state[3], 0), a2, acc);
+
+  int16_t y = Filter_Sat64To16(acc >> shift);
+
+  state[1] = state[0];
+  state[0] = x;
+  state[3] = state[2];
+  state[2] = y;
+  return y;
+}
+
+static inline int32_t Filter_BiquadQ31_Stage(const int32_t* coeffs, int32_t* state, int32_t x, uint8_t shift)
+{
+  int64_t acc = (int64_t)coeffs[0] * x;
+  acc += (int64_t)coeffs[1] * state[0];
+  acc += (int64_t)coeffs[2] * state[1];
+  acc += (int64_t)coeffs[3] * state[2];
+  acc += (int64_t)coeffs[4] * state[3];
+
+  int32_t y = Filter_Sat64To32(acc >> shift);
+
+  state[1] = state[0];
+  state[0] = x;
+  state[3] = state[2];
+  state[2] = y;
+  return y;
+}
+
+// ------------------- Public methods -------------------
+void Filter_DesignLowPass(float cutoffHz, float sampleHz, float* coeffs)
+{
+  // Q of 1/sqrt(2) for a Butterworth response
+  float w0 = 2.0f * FILTER_PI * cutoffHz / sampleHz;
+  float cosW0 = cosf(w0);
+  float alpha = sinf(w0) * 0.70710678f;
+  float a0 = 1.0f + alpha;
+
+  coeffs[0] = (1.0f - cosW0) * 0.5f / a0;
+  coeffs[1] = (1.0f - cosW0) / a0;
+  coeffs[2] = coeffs[0];
+  coeffs[3] = 2.0f * cosW0 / a0;
+  coeffs[4] = -(1.0f - alpha) / a0;
+}
+
+//------------------------------------------------------------------------------
+void Filter_CoeffsToQ15(const float* coeffs, uint8_t postShift, int16_t* out)
+{
+  float scale = ldexpf(1.0f, 15 - postShift);
+  uint8_t i;
+  for (i = 0; i < FILTER_BIQUAD_COEFFS; ++i) {
+    out[i] = (int16_t)Filter_ToFixed(coeffs[i], scale, INT16_MAX);
+  }
+  out[FILTER_BIQUAD_COEFFS] = 0;
+}
+
+//------------------------------------------------------------------------------
+void Filter_CoeffsToQ31(const float* coeffs, uint8_t postShift, int32_t* out)
+{
+  float scale = ldexpf(1.0f, 31 - postShift);
+  uint8_t i;
+  for (i = 0; i < FILTER_BIQUAD_COEFFS; ++i) {
+    out[i] = (int32_t)Filter_ToFixed(coeffs[i], scale, INT32_MAX);
+  }
+}
+
+//------------------------------------------------------------------------------
+int16_t Filter_LowPassAlpha(float cutoffHz, float periodS)
+{
+  float rc = 1.0f / (2.0f * FILTER_PI * cutoffHz);
+  return (int16_t)Filter_ToFixed(periodS / (rc + periodS), 32768.0f, INT16_MAX);
+}
+
+//------------------------------------------------------------------------------
+void Filter_BiquadQ15(const Filter_BiquadQ15_T* filter, const int16_t* in, int16_t* out, uint16_t numSamples)
+{
+  uint8_t shift = 15U - filter->postShift;
+
+  uint16_t n;
+  for (n = 0; n < numSamples; ++n) {
+    int16_t x = in[n];
+    uint8_t stage;
+    for (stage = 0; stage < filter->numStages; ++stage) {
+      x = Filter_BiquadQ15_Stage(&filter->coeffs[stage * FILTER_BIQUAD_COEFFS_Q15],
+                                 &filter->state[stage * FILTER_BIQUAD_STATE], x, shift);
+    }
+    out[n] = x;
+  }
+}
+
+//------------------------------------------------------------------------------
+void Filter_BiquadQ15_Batch(const Filter_BiquadQ15_T* filters, uint8_t numChannels,
+                            const int16_t* in, int16_t* out)
+{
+  uint8_t channel;
+  for (channel = 0; channel < numChannels; ++channel) {
+    Filter_BiquadQ15(&filters[channel], &in[channel], &out[channel], 1U);
+  }
+}
+
+//------------------------------------------------------------------------------
+void Filter_BiquadQ31(const Filter_BiquadQ31_T* filter, const int32_t* in, int32_t* out, uint16_t numSamples)
+{
+  uint8_t shift = 31U - filter->postShift;
+
+  uint16_t n;
+  for (n = 0; n < numSamples; ++n) {
+    int32_t x = in[n];
+    uint8_t stage;
+    for (stage = 0; stage < filter->numStages; ++stage) {
+      x = Filter_BiquadQ31_Stage(&filter->coeffs[stage * FILTER_BIQUAD_COEFFS],
+                                 &filter->state[stage * FILTER_BIQUAD_STATE], x, shift);
+    }
+    out[n] = x;
+  }
+}
+
+//------------------------------------------------------------------------------
+void Filter_LowPassQ15_Batch(const Filter_LowPassQ15_T* filter, const int16_t* in, int16_t* out)
+{
+  uint8_t i;
+  for (i = 0; i < filter->numChannels; ++i) {
+    // Fits 32 bits as alpha is below 1
+    int32_t diff = (int32_t)in[i] - (filter->state[i] >> 15);
+    filter->state[i] += diff * filter->alpha[i];
+    out[i] = (int16_t)(filter->state[i] >> 15);
+  }
+}
+
+//------------------------------------------------------------------------------
+void Filter_LowPassQ15_Reset(const Filter_LowPassQ15_T* filter, const int16_t* values)
+{
+  uint8_t i;
+  for (i = 0; i < filter->numChannels; ++i) {
+    filter->state[i] = (int32_t)values[i] * 32768;
+  }
+}
+
+//------------------------------------------------------------------------------
+void Filter_RateLimitQ15_Batch(const Filter_RateLimitQ15_T* filter, const int16_t* in, int16_t* out)
+{
+  uint8_t i;
+  for (i = 0; i < filter->numChannels; ++i) {
+    int32_t step = filter->maxStep[i];
+    int32_t diff = Filter_Clamp32((int32_t)in[i] - filter->state[i], -step, step);
+    filter->state[i] = (int16_t)(filter->state[i] + diff);
+    out[i] = filter->state[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+void Filter_RateLimitQ15_Reset(const Filter_RateLimitQ15_T* filter, const int16_t* values)
+{
+  memcpy(filter->state, values, filter->numChannels * sizeof(int16_t));
+}
+
+//------------------------------------------------------------------------------
+void Filter_MovingAverageQ15_Batch(Filter_MovingAverageQ15_T* filter, const int16_t* in, int16_t* out)
+{
+  uint8_t numChannels = filter->numChannels;
+  uint8_t shift = filter->windowShift;
+  uint8_t pairs = FILTER_MOVAVG_PAIRS(numChannels);
+  uint32_t* oldest = &filter->history[filter->index * pairs];
+
+  uint8_t p;
+  for (p = 0; p < pairs; ++p) {
+    uint8_t channel = 2U * p;
+    bool hasHigh = (channel + 1U) < numChannels;
+    int16_t lo = (int16_t)(in[channel] >> shift);
+    int16_t hi = hasHigh ? (int16_t)(in[channel + 1U] >> shift) : 0;
+    uint32_t sample = FILTER_PACK(lo, hi);
+
+    // Swap the oldest sample for the new one, in both channels at once
+    uint32_t sum = Filter_Qadd16(Filter_Qsub16(filter->sums[p], oldest[p]), sample);
+    filter->sums[p] = sum;
+    oldest[p] = sample;
+
+    out[channel] = (int16_t)sum;
+    if (hasHigh) {
+      out[channel + 1U] = (int16_t)(sum >> 16);
+    }
+  }
+
+  filter->index = (uint8_t)((filter->index + 1U) & ((1U << shift) - 1U));
+}
+
+//------------------------------------------------------------------------------
+void Filter_MovingAverageQ15_Reset(Filter_MovingAverageQ15_T* filter, const int16_t* values)
+{
+  uint8_t numChannels = filter->numChannels;
+  uint8_t shift = filter->windowShift;
+  uint8_t pairs = FILTER_MOVAVG_PAIRS(numChannels);
+
+  uint8_t p;
+  for (p = 0; p < pairs; ++p) {
+    uint8_t channel = 2U * p;
+    int16_t lo = (int16_t)(values[channel] >> shift);
+    int16_t hi = ((channel + 1U) < numChannels) ? (int16_t)(values[channel + 1U] >> shift) : 0;
+
+    uint16_t n;
+    for (n = 0; n < (1U << shift); ++n) {
+      filter->history[n * pairs + p] = FILTER_PACK(lo, hi);
+    }
+    filter->sums[p] = FILTER_PACK(lo * (1 << shift), hi * (1 << shift));
+  }
+
+  filter->index = 0;
+}
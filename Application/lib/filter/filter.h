@@ -0,0 +1,183 @@
+/*
+ * filter.h
+ *
+ * Fixed point signal filters, in Q15 and Q31.
+ *
+ *  - Biquad: cascade of second order sections, Direct Form I. The Q15
+ *    version does its multiply-accumulates two taps at a time (SMLALD).
+ *  - Low pass: first order, with a Q30 state so small alphas don't stall.
+ *  - Rate limiter: limits the change per call.
+ *  - Moving average: over a power of two window, two channels per word
+ *    (QADD16/QSUB16).
+ *
+ * On target the DSP instructions of the Cortex-M7 are used. Elsewhere they
+ * are replaced by portable C with the same results, so the filters can be
+ * run on a host.
+ *
+ * Each filter is an instance holding its configuration and pointers to its
+ * state, declared by the caller. The batch functions filter one sample of
+ * every channel in one call, for filtering a whole ADC scan.
+ *
+ * Q15 values are -1..1 in an int16_t, Q31 values the same in an int32_t.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_FILTER_FILTER_H_
+#define LIB_FILTER_FILTER_H_
+
+#include <stdint.h>
+
+/*
+ * Coefficients per biquad stage: b0, b1, b2, a1, a2. The a coefficients are
+ * negated, so y = b0.x0 + b1.x1 + b2.x2 + a1.y1 + a2.y2. Q15 stages carry a
+ * zero after a2 to keep the taps in pairs.
+ */
+#define FILTER_BIQUAD_COEFFS      5U
+#define FILTER_BIQUAD_COEFFS_Q15  6U
+#define FILTER_BIQUAD_STATE       4U        /* x1, x2, y1, y2 */
+
+/* Words of moving average history or sums for a number of channels */
+#define FILTER_MOVAVG_PAIRS(numChannels)  (((numChannels) + 1U) / 2U)
+
+/*
+ * Biquad cascade. Coefficients are scaled down by 2^postShift, so they can
+ * be above 1 (a1 of a low pass is close to -2), and the result is scaled
+ * back up. A postShift of 1 suits most filters. The coefficients of a low
+ * pass shrink with its cutoff, so below about a fiftieth of the sample rate
+ * their rounding gives a noticeable gain error: use the Q31 cascade there.
+ */
+typedef struct
+{
+  uint8_t numStages;
+  uint8_t postShift;
+  const int16_t* coeffs;    /* FILTER_BIQUAD_COEFFS_Q15 per stage, 4 byte aligned */
+  int16_t* state;           /* FILTER_BIQUAD_STATE per stage */
+} Filter_BiquadQ15_T;
+
+/*
+ * Q31 biquad cascade, accumulating in 64 bits. To keep the accumulator from
+ * overflowing, the magnitudes of each stage's coefficients must sum to less
+ * than 2^(postShift + 1), which low pass stages do with a postShift of 1.
+ */
+typedef struct
+{
+  uint8_t numStages;
+  uint8_t postShift;
+  const int32_t* coeffs;    /* FILTER_BIQUAD_COEFFS per stage */
+  int32_t* state;           /* FILTER_BIQUAD_STATE per stage */
+} Filter_BiquadQ31_T;
+
+/*
+ * First order low pass, y += alpha.(x - y), per channel
+ */
+typedef struct
+{
+  uint8_t numChannels;
+  const int16_t* alpha;     /* Q15, per channel, see Filter_LowPassAlpha */
+  int32_t* state;           /* Q30, per channel */
+} Filter_LowPassQ15_T;
+
+/*
+ * Rate limiter, the output moves towards the input by at most maxStep per
+ * call, per channel
+ */
+typedef struct
+{
+  uint8_t numChannels;
+  const int16_t* maxStep;   /* Q15, per channel, positive */
+  int16_t* state;           /* Last output, per channel */
+} Filter_RateLimitQ15_T;
+
+/*
+ * Moving average over 2^windowShift samples. Samples are kept divided by
+ * the window, so the sums fit 16 bits and are exact, at the cost of
+ * windowShift bits of resolution. A 12 bit ADC reading in Q15 has 3 bits
+ * to spare, so windows of up to 8 lose nothing.
+ */
+typedef struct
+{
+  uint8_t numChannels;
+  uint8_t windowShift;
+  uint8_t index;            /* Oldest sample in the history */
+  uint32_t* history;        /* FILTER_MOVAVG_PAIRS words per sample */
+  uint32_t* sums;           /* FILTER_MOVAVG_PAIRS words */
+} Filter_MovingAverageQ15_T;
+
+/**
+ * @brief Butterworth low pass biquad coefficients
+ * @param coeffs Set to FILTER_BIQUAD_COEFFS floating point coefficients
+ */
+void Filter_DesignLowPass(float cutoffHz, float sampleHz, float* coeffs);
+
+/**
+ * @brief Converts the coefficients of one stage to Q15
+ * @param coeffs FILTER_BIQUAD_COEFFS floating point coefficients
+ * @param out Set to FILTER_BIQUAD_COEFFS_Q15 coefficients
+ */
+void Filter_CoeffsToQ15(const float* coeffs, uint8_t postShift, int16_t* out);
+
+/**
+ * @brief Converts the coefficients of one stage to Q31
+ * @param coeffs FILTER_BIQUAD_COEFFS floating point coefficients
+ * @param out Set to FILTER_BIQUAD_COEFFS coefficients
+ */
+void Filter_CoeffsToQ31(const float* coeffs, uint8_t postShift, int32_t* out);
+
+/**
+ * @brief Low pass alpha for a cutoff, at a sample period
+ * @return alpha in Q15
+ */
+int16_t Filter_LowPassAlpha(float cutoffHz, float periodS);
+
+/**
+ * @brief Filters a block of samples through a biquad cascade
+ * @param in May be the same as out
+ */
+void Filter_BiquadQ15(const Filter_BiquadQ15_T* filter, const int16_t* in, int16_t* out, uint16_t numSamples);
+
+/**
+ * @brief Filters one sample per channel, each through its own cascade
+ * @param filters One per channel
+ */
+void Filter_BiquadQ15_Batch(const Filter_BiquadQ15_T* filters, uint8_t numChannels,
+                            const int16_t* in, int16_t* out);
+
+/**
+ * @brief Filters a block of samples through a biquad cascade
+ * @param in May be the same as out
+ */
+void Filter_BiquadQ31(const Filter_BiquadQ31_T* filter, const int32_t* in, int32_t* out, uint16_t numSamples);
+
+/**
+ * @brief Filters one sample per channel
+ */
+void Filter_LowPassQ15_Batch(const Filter_LowPassQ15_T* filter, const int16_t* in, int16_t* out);
+
+/**
+ * @brief Sets every channel's output, without filtering
+ */
+void Filter_LowPassQ15_Reset(const Filter_LowPassQ15_T* filter, const int16_t* values);
+
+/**
+ * @brief Limits one sample per channel
+ */
+void Filter_RateLimitQ15_Batch(const Filter_RateLimitQ15_T* filter, const int16_t* in, int16_t* out);
+
+/**
+ * @brief Sets every channel's output, without limiting
+ */
+void Filter_RateLimitQ15_Reset(const Filter_RateLimitQ15_T* filter, const int16_t* values);
+
+/**
+ * @brief Averages one sample per channel
+ */
+void Filter_MovingAverageQ15_Batch(Filter_MovingAverageQ15_T* filter, const int16_t* in, int16_t* out);
+
+/**
+ * @brief Fills every channel's window with a value
+ */
+void Filter_MovingAverageQ15_Reset(Filter_MovingAverageQ15_T* filter, const int16_t* values);
+
+#endif /* LIB_FILTER_FILTER_H_ */
@@ -0,0 +1,69 @@
+/*
+ * filterDsp.h
+ *
+ * The DSP instructions the filters are built on: the Cortex-M7 intrinsics on
+ * target, or portable C with the same results elsewhere. Private to
+ * lib/filter, and included by its host tests to check the portable versions.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_FILTER_FILTERDSP_H_
+#define LIB_FILTER_FILTERDSP_H_
+
+#include <stdint.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include "stm32f7xx.h"
+#endif
+
+/* Two 16 bit lanes in a word, the first in the low half */
+#define FILTER_PACK(lo, hi) ((uint32_t)(uint16_t)(lo) | ((uint32_t)(uint16_t)(hi) << 16))
+
+#if defined(__ARM_FEATURE_DSP)
+/* Dual 16 bit multiply, both products added to a 64 bit accumulator */
+static inline int64_t Filter_Smlald(uint32_t x, uint32_t y, int64_t acc)
+{
+  return (int64_t)__SMLALD(x, y, (uint64_t)acc);
+}
+
+/* Saturating add and subtract of two 16 bit lanes */
+static inline uint32_t Filter_Qadd16(uint32_t x, uint32_t y)
+{
+  return __QADD16(x, y);
+}
+
+static inline uint32_t Filter_Qsub16(uint32_t x, uint32_t y)
+{
+  return __QSUB16(x, y);
+}
+#else
+static inline int16_t Filter_Sat16(int32_t x)
+{
+  return (x > INT16_MAX) ? INT16_MAX : ((x < INT16_MIN) ? INT16_MIN : (int16_t)x);
+}
+
+static inline int64_t Filter_Smlald(uint32_t x, uint32_t y, int64_t acc)
+{
+  acc += (int32_t)(int16_t)x * (int32_t)(int16_t)y;
+  acc += (int32_t)(int16_t)(x >> 16) * (int32_t)(int16_t)(y >> 16);
+  return acc;
+}
+
+static inline uint32_t Filter_Qadd16(uint32_t x, uint32_t y)
+{
+  int16_t lo = Filter_Sat16((int32_t)(int16_t)x + (int16_t)y);
+  int16_t hi = Filter_Sat16((int32_t)(int16_t)(x >> 16) + (int16_t)(y >> 16));
+  return FILTER_PACK(lo, hi);
+}
+
+static inline uint32_t Filter_Qsub16(uint32_t x, uint32_t y)
+{
+  int16_t lo = Filter_Sat16((int32_t)(int16_t)x - (int16_t)y);
+  int16_t hi = Filter_Sat16((int32_t)(int16_t)(x >> 16) - (int16_t)(y >> 16));
+  return FILTER_PACK(lo, hi);
+}
+#endif
+
+#endif /* LIB_FILTER_FILTERDSP_H_ */
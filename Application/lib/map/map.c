@@ -0,0 +1,97 @@
+/*
+ * map.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "map.h"
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Finds i such that x[i] <= value < x[i+1], clamped to 0..n-2.
+ * Tries the cached segment and its neighbours before a binary search.
+ * @param frac Position within the segment, 0..1
+ */
+static uint16_t Map_FindSegment(const float* x, uint16_t n, Map_Cache_T* cache, float value, float* frac)
+{
+  uint16_t last = n - 2U;
+  uint16_t i = cache->index;
+  if (i > last) {
+    i = 0;
+  }
+
+  if (value <= x[0]) {
+    cache->index = 0;
+    *frac = 0.0f;
+    return 0;
+  }
+  if (value >= x[n - 1U]) {
+    cache->index = last;
+    *frac = 1.0f;
+    return last;
+  }
+
+  if (value < x[i]) {
+    // Moved down - check the neighbouring segment first
+    if (i > 0 && value >= x[i - 1U]) {
+      i = i - 1U;
+    } else {
+      uint16_t lo = 0;
+      uint16_t hi = i;
+      while ((uint16_t)(hi - lo) > 1U) {
+        uint16_t mid = (lo + hi) / 2U;
+        if (value < x[mid]) {
+          hi = mid;
+        } else {
+          lo = mid;
+        }
+      }
+      i = lo;
+    }
+  } else if (value >= x[i + 1U]) {
+    // Moved up - check the neighbouring segment first
+    if (i + 1U <= last && value < x[i + 2U]) {
+      i = i + 1U;
+    } else {
+      uint16_t lo = i + 1U;
+      uint16_t hi = n - 1U;
+      while ((uint16_t)(hi - lo) > 1U) {
+        uint16_t mid = (lo + hi) / 2U;
+        if (value < x[mid]) {
+          hi = mid;
+        } else {
+          lo = mid;
+        }
+      }
+      i = lo;
+    }
+  }
+
+  cache->index = i;
+  *frac = (value - x[i]) / (x[i + 1U] - x[i]);
+  return i;
+}
+
+// ------------------- Public methods -------------------
+float Map_Table1D(const Map_Table1D_T* map, Map_Cache_T* cache, float x)
+{
+  float frac;
+  uint16_t i = Map_FindSegment(map->x, map->n, cache, x, &frac);
+  return map->y[i] + frac * (map->y[i + 1U] - map->y[i]);
+}
+
+//------------------------------------------------------------------------------
+float Map_Table2D(const Map_Table2D_T* map, Map_Cache_T* cacheX, Map_Cache_T* cacheY, float x, float y)
+{
+  float fx;
+  float fy;
+  uint16_t ix = Map_FindSegment(map->x, map->nx, cacheX, x, &fx);
+  uint16_t iy = Map_FindSegment(map->y, map->ny, cacheY, y, &fy);
+
+  const float* row0 = &map->z[iy * map->nx + ix];
+  const float* row1 = row0 + map->nx;
+  float z0 = row0[0] + fx * (row0[1] - row0[0]);
+  float z1 = row1[0] + fx * (row1[1] - row1[0]);
+  return z0 + fy * (z1 - z0);
+}
@@ -0,0 +1,183 @@
+/*
+ * map.h
+ *
+ * 1D and 2D calibration map (lookup table) interpolation.
+ *
+ * Maps are declared const so the tables stay in flash. Three flavours:
+ *  - Uniform: evenly spaced breakpoints, indexed directly in O(1).
+ *  - Uniform fixed point: integer breakpoints spaced by a power of two, so
+ *    indexing and interpolation are shifts and masks only.
+ *  - Table: arbitrary increasing breakpoints. The segment found on the last
+ *    lookup is cached, so slowly moving inputs are found in O(1) as well.
+ * All lookups clamp to the end points of the map.
+ *
+ * The uniform lookups are inline as they are evaluated every control cycle.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_MAP_MAP_H_
+#define LIB_MAP_MAP_H_
+
+#include <stdint.h>
+
+/*
+ * Uniform float map. Breakpoints are x0, x0 + dx, ... x0 + (n-1)dx.
+ * dxInv is 1/dx, precalculated to avoid a divide on each lookup.
+ */
+typedef struct
+{
+  float x0;
+  float dxInv;
+  uint16_t n;
+  const float* y;
+} Map_Uniform1D_T;
+
+typedef struct
+{
+  float x0;
+  float dxInv;
+  uint16_t nx;
+  float y0;
+  float dyInv;
+  uint16_t ny;
+  const float* z;   /* Row major, z[iy * nx + ix] */
+} Map_Uniform2D_T;
+
+/*
+ * Uniform fixed point map. Breakpoints are x0 + (i << shift). The shift is
+ * at most MAP_Q_MAX_SHIFT, so the interpolation fits in 32 bits.
+ */
+#define MAP_Q_MAX_SHIFT 15U
+
+typedef struct
+{
+  int32_t x0;
+  uint8_t shift;
+  uint16_t n;
+  const int16_t* y;
+} Map_Uniform1D_Q_T;
+
+/*
+ * Non-uniform float map with strictly increasing breakpoints
+ */
+typedef struct
+{
+  uint16_t n;
+  const float* x;
+  const float* y;
+} Map_Table1D_T;
+
+typedef struct
+{
+  uint16_t nx;
+  const float* x;
+  uint16_t ny;
+  const float* y;
+  const float* z;   /* Row major, z[iy * nx + ix] */
+} Map_Table2D_T;
+
+/*
+ * Segment cache for table lookups. Kept separately from the (const) map,
+ * one per call site.
+ */
+typedef struct
+{
+  uint16_t index;
+} Map_Cache_T;
+
+/*
+ * Helpers for declaring uniform maps from their breakpoint spacing
+ */
+#define MAP_UNIFORM1D(x0_, dx_, table_) \
+  { .x0 = (x0_), .dxInv = 1.0f / (dx_), .n = sizeof(table_) / sizeof((table_)[0]), .y = (table_) }
+
+#define MAP_UNIFORM1D_Q(x0_, shift_, table_) \
+  { .x0 = (x0_), .shift = (shift_), .n = sizeof(table_) / sizeof((table_)[0]), .y = (table_) }
+
+#define MAP_TABLE1D(xTable_, yTable_) \
+  { .n = sizeof(xTable_) / sizeof((xTable_)[0]), .x = (xTable_), .y = (yTable_) }
+
+/**
+ * @brief Finds the segment index and fraction for a uniform axis
+ */
+static inline uint16_t Map_UniformIndex(float x, float x0, float dxInv, uint16_t n, float* frac)
+{
+  float pos = (x - x0) * dxInv;
+  // Written so NaN takes the first branch
+  if (!(pos > 0.0f)) {
+    *frac = 0.0f;
+    return 0;
+  }
+  // Clamped before the conversion, which is undefined out of range
+  if (pos >= (float)(n - 1U)) {
+    *frac = 1.0f;
+    return n - 2U;
+  }
+  uint32_t i = (uint32_t)pos;
+  *frac = pos - (float)i;
+  return (uint16_t)i;
+}
+
+/**
+ * @brief Interpolates a uniform 1D map
+ */
+static inline float Map_Uniform1D(const Map_Uniform1D_T* map, float x)
+{
+  float frac;
+  uint16_t i = Map_UniformIndex(x, map->x0, map->dxInv, map->n, &frac);
+  return map->y[i] + frac * (map->y[i + 1U] - map->y[i]);
+}
+
+/**
+ * @brief Bilinear interpolation of a uniform 2D map
+ */
+static inline float Map_Uniform2D(const Map_Uniform2D_T* map, float x, float y)
+{
+  float fx;
+  float fy;
+  uint16_t ix = Map_UniformIndex(x, map->x0, map->dxInv, map->nx, &fx);
+  uint16_t iy = Map_UniformIndex(y, map->y0, map->dyInv, map->ny, &fy);
+
+  const float* row0 = &map->z[iy * map->nx + ix];
+  const float* row1 = row0 + map->nx;
+  float z0 = row0[0] + fx * (row0[1] - row0[0]);
+  float z1 = row1[0] + fx * (row1[1] - row1[0]);
+  return z0 + fy * (z1 - z0);
+}
+
+/**
+ * @brief Interpolates a uniform fixed point 1D map
+ */
+static inline int16_t Map_Uniform1D_Q(const Map_Uniform1D_Q_T* map, int32_t x)
+{
+  if (x <= map->x0) {
+    return map->y[0];
+  }
+  // x - x0 may not fit an int32_t, but it is positive
+  uint32_t pos = (uint32_t)x - (uint32_t)map->x0;
+  uint32_t i = pos >> map->shift;
+  if (i >= (uint32_t)(map->n - 1U)) {
+    return map->y[map->n - 1U];
+  }
+  int32_t frac = (int32_t)(pos & ((1U << map->shift) - 1U));
+  int32_t y0 = map->y[i];
+  int32_t y1 = map->y[i + 1U];
+  return (int16_t)(y0 + (((y1 - y0) * frac) >> map->shift));
+}
+
+/**
+ * @brief Interpolates a non-uniform 1D map
+ * @param cache Segment cache for this call site, updated by the lookup
+ */
+float Map_Table1D(const Map_Table1D_T* map, Map_Cache_T* cache, float x);
+
+/**
+ * @brief Bilinear interpolation of a non-uniform 2D map
+ * @param cacheX Segment cache for the x axis
+ * @param cacheY Segment cache for the y axis
+ */
+float Map_Table2D(const Map_Table2D_T* map, Map_Cache_T* cacheX, Map_Cache_T* cacheY, float x, float y);
+
+#endif /* LIB_MAP_MAP_H_ */
@@ -0,0 +1,369 @@
+/*
+ * paramStore.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "paramStore.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lib/crc/crc.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define PARAMSTORE_STACK_SIZE 1000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[PARAMSTORE_STACK_SIZE];
+
+// Flash writes are background work, below every process
+#define PARAMSTORE_TASK_PRIORITY (tskIDLE_PRIORITY)
+
+// Task data
+static TaskHandle_t paramStoreTaskHandle;
+
+#define PARAMSTORE_MAGIC          ((uint32_t) 0x50415231U)  /* "PAR1" */
+
+/* The erase is polled at this period, and fails if it runs past the timeout */
+#define PARAMSTORE_ERASE_POLL_MS      ((uint32_t) 10U)
+#define PARAMSTORE_ERASE_TIMEOUT_MS   ((uint32_t) 5000U)
+
+/* Words programmed between yields to the rest of the system */
+#define PARAMSTORE_PROGRAM_SLICE      16U
+
+/*
+ * Record written to the start of each flash page
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t sequence;
+  uint32_t count;
+  ParamStore_Value_T values[PARAMSTORE_MAX_PARAMS];
+  uint32_t crc;       /* Over all preceding words */
+} ParamStore_Page_T;
+
+#define PARAMSTORE_PAGE_WORDS     (sizeof(ParamStore_Page_T) / sizeof(uint32_t))
+#define PARAMSTORE_CRC_WORDS      (PARAMSTORE_PAGE_WORDS - 1U)
+
+// RAM mirror: active, pending and retired
+static ParamStore_Value_T paramSets[3][PARAMSTORE_MAX_PARAMS];
+const ParamStore_Value_T* volatile paramStoreActive = paramSets[0];
+static ParamStore_Value_T* pendingSet;
+static ParamStore_Value_T* retiredSet;
+static TickType_t retiredTick;
+static bool pendingDirty;   /* Pending set has edits not yet applied */
+static bool pendingStale;   /* Pending set has not been synced since the last apply */
+
+static uint16_t paramCount;
+static uint32_t sequence;
+static ParamStore_Source_T source;
+
+// Page being saved, owned by the task while a save is in progress
+static ParamStore_Page_T pageBuffer;
+static ParamStore_Status_T saveStatus;
+
+// ------------------- Private methods -------------------
+static bool ParamStore_PageValid(const ParamStore_Page_T* page)
+{
+  if (PARAMSTORE_MAGIC != page->magic ||
+      page->count > PARAMSTORE_MAX_PARAMS) {
+    return false;
+  }
+
+  uint32_t crc = Crc_Calculate((const uint32_t*)page, PARAMSTORE_CRC_WORDS);
+  return crc == page->crc;
+}
+
+/**
+ * @brief Erases a sector, sleeping while the flash is busy rather than
+ * polling it as the HAL does. Flash must be unlocked.
+ */
+static ParamStore_Status_T ParamStore_EraseSector(uint32_t sector)
+{
+  ParamStore_Status_T ret = PARAMSTORE_STATUS_OK;
+
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_ALL_ERRORS);
+  FLASH_Erase_Sector(sector, FLASH_VOLTAGE_RANGE_3);
+
+  TickType_t start = xTaskGetTickCount();
+  while (__HAL_FLASH_GET_FLAG(FLASH_FLAG_BSY)) {
+    if ((xTaskGetTickCount() - start) > pdMS_TO_TICKS(PARAMSTORE_ERASE_TIMEOUT_MS)) {
+      ret = PARAMSTORE_STATUS_ERROR_FLASH;
+      break;
+    }
+    vTaskDelay(pdMS_TO_TICKS(PARAMSTORE_ERASE_POLL_MS));
+  }
+
+  if (__HAL_FLASH_GET_FLAG(FLASH_FLAG_ALL_ERRORS)) {
+    ret = PARAMSTORE_STATUS_ERROR_FLASH;
+  }
+  CLEAR_BIT(FLASH->CR, (FLASH_CR_SER | FLASH_CR_SNB));
+
+  return ret;
+}
+
+static ParamStore_Status_T ParamStore_WritePage(uint32_t sector, uint32_t address, const ParamStore_Page_T* page)
+{
+  HAL_FLASH_Unlock();
+
+  ParamStore_Status_T ret = ParamStore_EraseSector(sector);
+
+  // Program the CRC word last, so an interrupted write leaves an invalid page
+  const uint32_t* words = (const uint32_t*)page;
+  size_t i;
+  for (i = 0; i < PARAMSTORE_PAGE_WORDS && PARAMSTORE_STATUS_OK == ret; ++i) {
+    if (HAL_OK != HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * sizeof(uint32_t), words[i])) {
+      ret = PARAMSTORE_STATUS_ERROR_FLASH;
+    }
+    if (0U == (i + 1U) % PARAMSTORE_PROGRAM_SLICE) {
+      vTaskDelay(1);
+    }
+  }
+
+  HAL_FLASH_Lock();
+
+  if (PARAMSTORE_STATUS_OK == ret && !ParamStore_PageValid((const ParamStore_Page_T*)address)) {
+    ret = PARAMSTORE_STATUS_ERROR_FLASH;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Brings the pending set up to date with the active set, if needed.
+ * Must be called in a critical section.
+ */
+static void ParamStore_SyncPending(void)
+{
+  if (pendingStale) {
+    memcpy(pendingSet, (const void*)paramStoreActive, paramCount * sizeof(ParamStore_Value_T));
+    pendingStale = false;
+  }
+}
+
+static void ParamStore_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "ParamStore_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for a save to be requested
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // Overwrite the older page, so the newest valid copy survives a failed write
+      bool useB = (PARAMSTORE_SOURCE_PAGE_B != source);
+      ParamStore_Status_T status;
+      if (useB) {
+        status = ParamStore_WritePage(PARAMSTORE_PAGE_B_SECTOR, PARAMSTORE_PAGE_B_ADDR, &pageBuffer);
+      } else {
+        status = ParamStore_WritePage(PARAMSTORE_PAGE_A_SECTOR, PARAMSTORE_PAGE_A_ADDR, &pageBuffer);
+      }
+
+      taskENTER_CRITICAL();
+      if (PARAMSTORE_STATUS_OK == status) {
+        sequence = pageBuffer.sequence;
+        source = useB ? PARAMSTORE_SOURCE_PAGE_B : PARAMSTORE_SOURCE_PAGE_A;
+      }
+      saveStatus = status;
+      taskEXIT_CRITICAL();
+
+      if (PARAMSTORE_STATUS_OK == status) {
+        logPrintS(log, "ParamStore saved\n", LOGGING_DEFAULT_BUFF_LEN);
+      } else {
+        logPrintS(log, "ParamStore save failed\n", LOGGING_DEFAULT_BUFF_LEN);
+      }
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+ParamStore_Status_T ParamStore_Init(
+    Logging_T* logger,
+    const ParamStore_Value_T* defaults,
+    uint16_t count)
+{
+  log = logger;
+  logPrintS(log, "ParamStore_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  if (count > PARAMSTORE_MAX_PARAMS) {
+    return PARAMSTORE_STATUS_ERROR;
+  }
+
+  Crc_Init();
+
+  paramCount = count;
+  memset(paramSets, 0, sizeof(paramSets));
+  memcpy(paramSets[0], defaults, count * sizeof(ParamStore_Value_T));
+
+  const ParamStore_Page_T* pageA = (const ParamStore_Page_T*)PARAMSTORE_PAGE_A_ADDR;
+  const ParamStore_Page_T* pageB = (const ParamStore_Page_T*)PARAMSTORE_PAGE_B_ADDR;
+  bool validA = ParamStore_PageValid(pageA);
+  bool validB = ParamStore_PageValid(pageB);
+
+  const ParamStore_Page_T* page = NULL;
+  source = PARAMSTORE_SOURCE_DEFAULTS;
+  sequence = 0;
+  if (validA && (!validB || (int32_t)(pageA->sequence - pageB->sequence) > 0)) {
+    page = pageA;
+    source = PARAMSTORE_SOURCE_PAGE_A;
+  } else if (validB) {
+    page = pageB;
+    source = PARAMSTORE_SOURCE_PAGE_B;
+  }
+
+  if (NULL != page) {
+    // Parameters added since the page was written keep their defaults
+    uint16_t numStored = (page->count < count) ? page->count : count;
+    memcpy(paramSets[0], page->values, numStored * sizeof(ParamStore_Value_T));
+    sequence = page->sequence;
+  }
+
+  memcpy(paramSets[1], paramSets[0], sizeof(paramSets[0]));
+  paramStoreActive = paramSets[0];
+  pendingSet = paramSets[1];
+  retiredSet = paramSets[2];
+  retiredTick = xTaskGetTickCount() - pdMS_TO_TICKS(PARAMSTORE_GRACE_MS);
+  pendingDirty = false;
+  pendingStale = false;
+  saveStatus = PARAMSTORE_STATUS_OK;
+
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+  snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "ParamStore loaded from %s (sequence %lu)\n",
+      (PARAMSTORE_SOURCE_PAGE_A == source) ? "page A" :
+      (PARAMSTORE_SOURCE_PAGE_B == source) ? "page B" : "defaults",
+      (unsigned long)sequence);
+  logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+
+  // create save task
+  paramStoreTaskHandle = xTaskCreateStatic(
+      ParamStore_TaskMain,
+      "ParamStoreTask",
+      PARAMSTORE_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      PARAMSTORE_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  logPrintS(log, "ParamStore_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+uint16_t ParamStore_GetCount(void)
+{
+  return paramCount;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_Set(ParamStore_Id_T id, ParamStore_Value_T value)
+{
+  if (id >= paramCount) {
+    return PARAMSTORE_STATUS_ERROR_ID;
+  }
+
+  taskENTER_CRITICAL();
+  ParamStore_SyncPending();
+  pendingSet[id] = value;
+  pendingDirty = true;
+  taskEXIT_CRITICAL();
+
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_GetPending(ParamStore_Id_T id, ParamStore_Value_T* value)
+{
+  if (id >= paramCount) {
+    return PARAMSTORE_STATUS_ERROR_ID;
+  }
+
+  taskENTER_CRITICAL();
+  *value = pendingStale ? paramStoreActive[id] : pendingSet[id];
+  taskEXIT_CRITICAL();
+
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_Apply(void)
+{
+  ParamStore_Status_T ret = PARAMSTORE_STATUS_OK;
+
+  taskENTER_CRITICAL();
+  if (pendingDirty) {
+    // The retired set becomes the pending set, and is written by the next
+    // edit, so its readers must have had their grace period
+    if ((xTaskGetTickCount() - retiredTick) < pdMS_TO_TICKS(PARAMSTORE_GRACE_MS)) {
+      ret = PARAMSTORE_STATUS_BUSY;
+    } else {
+      ParamStore_Value_T* previous = (ParamStore_Value_T*)paramStoreActive;
+      paramStoreActive = pendingSet;
+      pendingSet = retiredSet;
+      retiredSet = previous;
+      retiredTick = xTaskGetTickCount();
+
+      // Brought up to date on the next edit
+      pendingDirty = false;
+      pendingStale = true;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+void ParamStore_Revert(void)
+{
+  taskENTER_CRITICAL();
+  pendingDirty = false;
+  pendingStale = true;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_Save(void)
+{
+  taskENTER_CRITICAL();
+  if (PARAMSTORE_STATUS_BUSY == saveStatus) {
+    taskEXIT_CRITICAL();
+    return PARAMSTORE_STATUS_BUSY;
+  }
+  saveStatus = PARAMSTORE_STATUS_BUSY;
+  memset(&pageBuffer, 0xFF, sizeof(ParamStore_Page_T));
+  memcpy(pageBuffer.values, (const void*)paramStoreActive, paramCount * sizeof(ParamStore_Value_T));
+  pageBuffer.sequence = sequence + 1U;
+  taskEXIT_CRITICAL();
+
+  pageBuffer.magic = PARAMSTORE_MAGIC;
+  pageBuffer.count = paramCount;
+  pageBuffer.crc = Crc_Calculate((const uint32_t*)&pageBuffer, PARAMSTORE_CRC_WORDS);
+
+  xTaskNotifyGive(paramStoreTaskHandle);
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_GetSaveStatus(void)
+{
+  taskENTER_CRITICAL();
+  ParamStore_Status_T status = saveStatus;
+  taskEXIT_CRITICAL();
+  return status;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Source_T ParamStore_GetSource(void)
+{
+  return source;
+}
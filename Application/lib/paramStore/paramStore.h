@@ -0,0 +1,156 @@
+/*
+ * paramStore.h
+ *
+ * Calibration parameter store.
+ *
+ * Parameters are held in a RAM mirror indexed by parameter ID, and persisted
+ * to two internal flash sectors (pages A and B) with a sequence number and
+ * CRC. At boot the newest valid page is loaded, falling back to the
+ * compiled-in defaults if neither page is valid.
+ *
+ * There are three RAM copies: the active copy read by the control loop, a
+ * pending copy that edits are made to, and the copy retired by the last
+ * apply. ParamStore_Apply makes the pending copy active with a single pointer
+ * write, so a process that takes ParamStore_Get() once at the start of its
+ * cycle sees a consistent set for the whole cycle, and each parameter read is
+ * a single load. A retired copy is only reused for edits once
+ * PARAMSTORE_GRACE_MS has passed, by when its readers have finished.
+ *
+ * Saving is done by a background task at the lowest priority, so the caller
+ * doesn't wait for the flash.
+ *
+ * The parameter IDs and defaults are defined in vehicleInterface/paramMapping.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_PARAMSTORE_PARAMSTORE_H_
+#define LIB_PARAMSTORE_PARAMSTORE_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+/* Size of the RAM mirror and flash record */
+#define PARAMSTORE_MAX_PARAMS     ((uint16_t) 64U)
+
+/*
+ * Flash pages. Must match the PARAMS region reserved in the linker script.
+ * Single bank mode, 256KB sectors.
+ */
+#define PARAMSTORE_PAGE_A_SECTOR  FLASH_SECTOR_10
+#define PARAMSTORE_PAGE_A_ADDR    ((uint32_t) 0x08180000U)
+#define PARAMSTORE_PAGE_B_SECTOR  FLASH_SECTOR_11
+#define PARAMSTORE_PAGE_B_ADDR    ((uint32_t) 0x081C0000U)
+
+/* Longest a process may hold the set from ParamStore_Get */
+#define PARAMSTORE_GRACE_MS       ((uint32_t) 10U)
+
+typedef enum
+{
+  PARAMSTORE_STATUS_OK          = 0x00U,
+  PARAMSTORE_STATUS_ERROR       = 0x01U,
+  PARAMSTORE_STATUS_ERROR_ID    = 0x02U,  /* Parameter ID out of range */
+  PARAMSTORE_STATUS_ERROR_FLASH = 0x03U,  /* Flash erase or program failed */
+  PARAMSTORE_STATUS_BUSY        = 0x04U   /* Retry later */
+} ParamStore_Status_T;
+
+typedef uint16_t ParamStore_Id_T;
+
+/*
+ * A parameter is a single 32-bit word. The type is known by the user of each ID.
+ */
+typedef union
+{
+  uint32_t u32;
+  int32_t i32;
+  float f32;
+} ParamStore_Value_T;
+
+/*
+ * Where the stored parameter set lives
+ */
+typedef enum
+{
+  PARAMSTORE_SOURCE_DEFAULTS = 0x00U,
+  PARAMSTORE_SOURCE_PAGE_A   = 0x01U,
+  PARAMSTORE_SOURCE_PAGE_B   = 0x02U
+} ParamStore_Source_T;
+
+/* Active set. Use ParamStore_Get() rather than accessing directly. */
+extern const ParamStore_Value_T* volatile paramStoreActive;
+
+/**
+ * @brief Initialize the store and load the newest valid flash page.
+ * Must be called before any other process reads parameters.
+ * @param logger Pointer to system logger
+ * @param defaults Default value for each parameter ID
+ * @param count Number of parameters (at most PARAMSTORE_MAX_PARAMS)
+ */
+ParamStore_Status_T ParamStore_Init(
+    Logging_T* logger,
+    const ParamStore_Value_T* defaults,
+    uint16_t count);
+
+/**
+ * @brief Get the active parameter set, indexed by parameter ID.
+ * Take this once at the start of a cycle and use it for the rest of the cycle.
+ * The pointer must not be held across cycles, or for longer than
+ * PARAMSTORE_GRACE_MS.
+ */
+static inline const ParamStore_Value_T* ParamStore_Get(void)
+{
+  return paramStoreActive;
+}
+
+/**
+ * @brief Number of parameters in the store
+ */
+uint16_t ParamStore_GetCount(void);
+
+/**
+ * @brief Stage a new value for a parameter. Not visible until ParamStore_Apply.
+ */
+ParamStore_Status_T ParamStore_Set(ParamStore_Id_T id, ParamStore_Value_T value);
+
+/**
+ * @brief Read back a staged value (or the active value if nothing is staged)
+ */
+ParamStore_Status_T ParamStore_GetPending(ParamStore_Id_T id, ParamStore_Value_T* value);
+
+/**
+ * @brief Make all staged values active at once.
+ * @return PARAMSTORE_STATUS_BUSY if the last apply was within
+ * PARAMSTORE_GRACE_MS. The values stay staged, and the apply must be retried.
+ */
+ParamStore_Status_T ParamStore_Apply(void);
+
+/**
+ * @brief Discard any staged values
+ */
+void ParamStore_Revert(void);
+
+/**
+ * @brief Start writing the active set to the older flash page, in the
+ * background. The result is read with ParamStore_GetSaveStatus.
+ * The sector erase stalls flash reads (including instruction fetch) for up to
+ * a couple of seconds, so this must only be called while the vehicle is not
+ * driving. Must be called from a task.
+ * @return PARAMSTORE_STATUS_BUSY if a save is already in progress
+ */
+ParamStore_Status_T ParamStore_Save(void);
+
+/**
+ * @brief Result of the last save, PARAMSTORE_STATUS_BUSY while one is in progress
+ */
+ParamStore_Status_T ParamStore_GetSaveStatus(void);
+
+/**
+ * @brief Which flash page holds the most recently loaded or saved set
+ */
+ParamStore_Source_T ParamStore_GetSource(void);
+
+#endif /* LIB_PARAMSTORE_PARAMSTORE_H_ */
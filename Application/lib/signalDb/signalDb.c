@@ -0,0 +1,193 @@
+/*
+ * signalDb.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "signalDb.h"
+
+#include <string.h>
+
+#include "stm32f7xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/cycleCounter/cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+typedef struct
+{
+  float value[SIGNALDB_MAX_GROUP_SIGNALS];
+  uint32_t time[SIGNALDB_MAX_GROUP_SIGNALS];
+  bool valid[SIGNALDB_MAX_GROUP_SIGNALS];
+} SignalDb_Copy_T;
+
+typedef struct
+{
+  volatile uint32_t sequence;     /* Copy 0 is being written while odd */
+  volatile TickType_t publishTick; /* Tick of the last publish, which doesn't wrap for days */
+  SignalDb_Copy_T copies[2];
+  SignalDb_Copy_T staging;        /* Owned by the writer */
+} SignalDb_Group_T;
+
+static const SignalDb_GroupConfig_T* groupConfig;
+static uint8_t numGroups;
+static SignalDb_Group_T groups[SIGNALDB_MAX_GROUPS];
+
+// ------------------- Private methods -------------------
+static bool SignalDb_IsValid(SignalDb_Signal_T signal)
+{
+  uint8_t group = SIGNALDB_GROUP(signal);
+  return (group < numGroups) && (SIGNALDB_INDEX(signal) < groupConfig[group].numSignals);
+}
+
+/**
+ * @brief Reads the signals of one group from a list, all from one publish
+ */
+static void SignalDb_ReadGroup(uint8_t group, const SignalDb_Signal_T* signals, uint8_t num,
+                               SignalDb_Value_T* values)
+{
+  const SignalDb_Group_T* g = &groups[group];
+  uint32_t sequence;
+
+  do {
+    sequence = g->sequence;
+    __DMB();
+
+    // The copy not being written
+    const SignalDb_Copy_T* copy = &g->copies[sequence & 1U];
+    uint8_t i;
+    for (i = 0; i < num; ++i) {
+      if ((SIGNALDB_GROUP(signals[i]) == group) && SignalDb_IsValid(signals[i])) {
+        uint8_t index = SIGNALDB_INDEX(signals[i]);
+        values[i].value = copy->value[index];
+        values[i].time = copy->time[index];
+        values[i].valid = copy->valid[index];
+      }
+    }
+
+    __DMB();
+  } while (sequence != g->sequence);
+}
+
+// ------------------- Public methods -------------------
+SignalDb_Status_T SignalDb_Init(Logging_T* logger, const SignalDb_GroupConfig_T* groupTable, uint8_t num)
+{
+  log = logger;
+  logPrintS(log, "SignalDb_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  if (num > SIGNALDB_MAX_GROUPS) {
+    return SIGNALDB_STATUS_ERROR;
+  }
+
+  uint8_t i;
+  for (i = 0; i < num; ++i) {
+    if (groupTable[i].numSignals > SIGNALDB_MAX_GROUP_SIGNALS) {
+      return SIGNALDB_STATUS_ERROR;
+    }
+  }
+
+  groupConfig = groupTable;
+  numGroups = num;
+  memset(groups, 0, sizeof(groups));
+
+  logPrintS(log, "SignalDb_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return SIGNALDB_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void SignalDb_Set(SignalDb_Signal_T signal, float value, bool valid, uint32_t time)
+{
+  if (!SignalDb_IsValid(signal)) {
+    return;
+  }
+
+  SignalDb_Copy_T* staging = &groups[SIGNALDB_GROUP(signal)].staging;
+  uint8_t index = SIGNALDB_INDEX(signal);
+  staging->value[index] = value;
+  staging->time[index] = time;
+  staging->valid[index] = valid;
+}
+
+//------------------------------------------------------------------------------
+void SignalDb_Publish(uint8_t group)
+{
+  if (group >= numGroups) {
+    return;
+  }
+
+  SignalDb_Group_T* g = &groups[group];
+
+  // Readers move to copy 1 while copy 0 is written
+  g->sequence++;
+  __DMB();
+  g->copies[0] = g->staging;
+  __DMB();
+
+  // And back to copy 0 while copy 1 is written
+  g->sequence++;
+  __DMB();
+  g->copies[1] = g->staging;
+  g->publishTick = xTaskGetTickCount();
+}
+
+//------------------------------------------------------------------------------
+void SignalDb_Read(SignalDb_Signal_T signal, SignalDb_Value_T* value)
+{
+  SignalDb_ReadList(&signal, 1U, value);
+}
+
+//------------------------------------------------------------------------------
+void SignalDb_ReadList(const SignalDb_Signal_T* signals, uint8_t numSignals, SignalDb_Value_T* values)
+{
+  uint8_t groupsRead = 0;   /* Bit per group */
+
+  uint8_t i;
+  for (i = 0; i < numSignals; ++i) {
+    if (!SignalDb_IsValid(signals[i])) {
+      memset(&values[i], 0, sizeof(SignalDb_Value_T));
+      continue;
+    }
+
+    uint8_t group = SIGNALDB_GROUP(signals[i]);
+    if (0 == (groupsRead & (1U << group))) {
+      groupsRead |= (uint8_t)(1U << group);
+      SignalDb_ReadGroup(group, signals, numSignals, values);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+uint32_t SignalDb_GetPublishCount(uint8_t group)
+{
+  if (group >= numGroups) {
+    return 0;
+  }
+  return groups[group].sequence / 2U;
+}
+
+//------------------------------------------------------------------------------
+bool SignalDb_IsFresh(SignalDb_Signal_T signal, const SignalDb_Value_T* value, uint32_t maxAgeMs)
+{
+  if (!value->valid || !SignalDb_IsValid(signal)) {
+    return false;
+  }
+
+  uint8_t group = SIGNALDB_GROUP(signal);
+  if (0 == SignalDb_GetPublishCount(group)) {
+    return false;
+  }
+
+  // The writer has stopped. Checked in ticks, as the cycle count of the
+  // sample time wraps every ~21s.
+  uint32_t publishAgeMs = SIGNALDB_STALE_PERIODS * groupConfig[group].periodMs;
+  if ((xTaskGetTickCount() - groups[group].publishTick) > pdMS_TO_TICKS(publishAgeMs)) {
+    return false;
+  }
+
+  // The writer is running, but publishing an old sample
+  return CycleCounter_ToMicros(CycleCounter_Elapsed(value->time)) <= maxAgeMs * 1000U;
+}
@@ -0,0 +1,116 @@
+/*
+ * signalDb.h
+ *
+ * Shared signal database, for passing vehicle signals between tasks
+ * without locks.
+ *
+ * Signals are grouped by the task that produces them, which is the only
+ * writer of the group and runs at the group's rate. Each group is a struct
+ * of arrays: a value, a timestamp and a validity flag per signal. The writer
+ * stages signals with SignalDb_Set, then SignalDb_Publish makes them visible
+ * to readers all at once.
+ *
+ * Groups are published as a sequence lock with two copies. The sequence is
+ * odd while the first copy is being written and even while the second is,
+ * and readers read the copy that is not being written. A reader that
+ * preempts the writer therefore never waits. A reader preempted by the
+ * writer sees the sequence move and reads again. Every signal read from one
+ * group in one call comes from the same publish.
+ *
+ * Readers that act on a signal check it with SignalDb_IsFresh, so a signal
+ * whose writer has not started, or has stopped, is not taken as current.
+ *
+ * The groups and signals are defined in vehicleInterface/signalMapping.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_SIGNALDB_SIGNALDB_H_
+#define LIB_SIGNALDB_SIGNALDB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define SIGNALDB_MAX_GROUPS         ((uint8_t) 8U)
+#define SIGNALDB_MAX_GROUP_SIGNALS  ((uint8_t) 16U)
+
+/* Group periods a signal may be old before it is stale */
+#define SIGNALDB_STALE_PERIODS      ((uint32_t) 3U)
+
+typedef enum
+{
+  SIGNALDB_STATUS_OK     = 0x00U,
+  SIGNALDB_STATUS_ERROR  = 0x01U
+} SignalDb_Status_T;
+
+/* Group in the high byte, index in the group in the low byte */
+typedef uint16_t SignalDb_Signal_T;
+#define SIGNALDB_SIGNAL(group, index) ((SignalDb_Signal_T)(((group) << 8) | (index)))
+#define SIGNALDB_GROUP(signal)        ((uint8_t)((signal) >> 8))
+#define SIGNALDB_INDEX(signal)        ((uint8_t)((signal) & 0xFFU))
+
+typedef struct
+{
+  const char* name;
+  uint16_t periodMs;        /* Rate the writer publishes at */
+  uint8_t numSignals;
+} SignalDb_GroupConfig_T;
+
+typedef struct
+{
+  float value;
+  uint32_t time;            /* CycleCounter time the value was sampled */
+  bool valid;
+} SignalDb_Value_T;
+
+/**
+ * @brief Initialize the database, with every signal invalid
+ * @param logger Pointer to system logger
+ * @param groups Group table, indexed by group, must remain valid
+ */
+SignalDb_Status_T SignalDb_Init(Logging_T* logger, const SignalDb_GroupConfig_T* groups, uint8_t numGroups);
+
+/**
+ * @brief Stage a signal, for the next publish of its group.
+ * Only called by the writer of the group.
+ */
+void SignalDb_Set(SignalDb_Signal_T signal, float value, bool valid, uint32_t time);
+
+/**
+ * @brief Make the staged signals of a group visible to readers.
+ * Only called by the writer of the group.
+ */
+void SignalDb_Publish(uint8_t group);
+
+/**
+ * @brief Read a single signal
+ */
+void SignalDb_Read(SignalDb_Signal_T signal, SignalDb_Value_T* value);
+
+/**
+ * @brief Read a list of signals. Signals in the same group are read from
+ * the same publish. Signals may come from several groups, each group is
+ * read once.
+ * @param values One per signal, in the same order
+ */
+void SignalDb_ReadList(const SignalDb_Signal_T* signals, uint8_t numSignals, SignalDb_Value_T* values);
+
+/**
+ * @brief Number of times a group has been published
+ */
+uint32_t SignalDb_GetPublishCount(uint8_t group);
+
+/**
+ * @brief Whether a signal read is valid and current: its group was published
+ * within SIGNALDB_STALE_PERIODS of its period, and the value was sampled
+ * within maxAgeMs. False before the group's first publish.
+ * @param signal Signal the value was read from
+ * @param value Value read, from SignalDb_Read or SignalDb_ReadList
+ * @param maxAgeMs Oldest sample accepted, under the cycle counter's wrap
+ */
+bool SignalDb_IsFresh(SignalDb_Signal_T signal, const SignalDb_Value_T* value, uint32_t maxAgeMs);
+
+#endif /* LIB_SIGNALDB_SIGNALDB_H_ */
@@ -0,0 +1,365 @@
+/*
+ * vehicleModel.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "vehicleModel.h"
+
+#include <string.h>
+
+// ------------------- Private data -------------------
+#define VEHICLEMODEL_GRAVITY      9.81f
+#define VEHICLEMODEL_AIR_DENSITY  1.2f
+#define VEHICLEMODEL_PI           3.14159265f
+
+/*
+ * Slip is calculated against at least this speed, so it stays finite
+ * and the tyre force stays stable at standstill
+ */
+#define VEHICLEMODEL_SLIP_MIN_SPEED 1.0f
+
+/* Below this the wheel is stopped for the speed sensors */
+#define VEHICLEMODEL_MIN_PULSE_SPEED 0.01f
+
+/* The main contactor closes with the DC link charged to this fraction of the pack */
+#define VEHICLEMODEL_PRECHARGED 0.95f
+
+static const VehicleModel_Params_T defaultParams = {
+  .mass = 300.0f,
+  .wheelbase = 1.55f,
+  .cgRearDistance = 0.75f,
+  .cgHeight = 0.30f,
+  .dragArea = 1.2f,
+  .rollingResistance = 0.015f,
+
+  .gearRatio = 4.0f,
+  .drivelineEfficiency = 0.95f,
+  .wheelRadius = 1.60f / (2.0f * VEHICLEMODEL_PI),  /* As WHEELSPEED_TYRE_CIRC_M */
+  .wheelInertia = 0.4f,
+  .motorInertia = 0.02f,
+
+  .maxTorque = 140.0f,                              /* As INVERTER_MAX_TORQUE_NM */
+  .maxPower = 80000.0f,
+  .maxSpeedRpm = 6000.0f,                           /* As INVERTER_MAX_SPEED_RPM */
+  .torqueTimeConstant = 0.005f,
+  .inverterEfficiency = 0.95f,
+
+  .packVoltageFull = 403.2f,                        /* 96s, 4.2V to 3.0V */
+  .packVoltageEmpty = 288.0f,
+  .packResistance = 0.3f,
+  .packCapacity = 13.0f,
+  .prechargeTimeConstant = 0.5f,
+  .dischargeTimeConstant = 2.0f,
+
+  .peakFriction = 1.6f,
+  .peakSlip = 0.12f,
+  .slidingFriction = 1.2f,
+  .maxBrakeTorque = 2400.0f,
+  .brakeBiasFront = 0.65f,
+
+  .toneWheelTeeth = 24U,                            /* As WHEELSPEED_TEETH */
+
+  .maxStep = 0.0002f,
+};
+
+/*
+ * Tolerance bands for dispersion, as a fraction of the nominal value
+ */
+#define VEHICLEMODEL_TOL_MASS           0.05f
+#define VEHICLEMODEL_TOL_CG             0.05f
+#define VEHICLEMODEL_TOL_DRAG           0.10f
+#define VEHICLEMODEL_TOL_ROLLING        0.20f
+#define VEHICLEMODEL_TOL_EFFICIENCY     0.02f
+#define VEHICLEMODEL_TOL_TORQUE_TAU     0.50f
+#define VEHICLEMODEL_TOL_RESISTANCE     0.30f
+#define VEHICLEMODEL_TOL_CAPACITY       0.05f
+#define VEHICLEMODEL_TOL_FRICTION       0.25f
+#define VEHICLEMODEL_TOL_BRAKE          0.15f
+#define VEHICLEMODEL_TOL_BRAKE_BIAS     0.05f
+
+// ------------------- Private methods -------------------
+static float VehicleModel_Abs(float value)
+{
+  return (value < 0.0f) ? -value : value;
+}
+
+static float VehicleModel_Clamp(float value, float min, float max)
+{
+  return (value < min) ? min : ((value > max) ? max : value);
+}
+
+/**
+ * @brief Tyre friction coefficient, signed as the slip
+ */
+static float VehicleModel_Friction(const VehicleModel_Params_T* p, float slip)
+{
+  float magnitude = VehicleModel_Clamp(VehicleModel_Abs(slip), 0.0f, 1.0f);
+  float mu;
+  if (magnitude < p->peakSlip) {
+    mu = p->peakFriction * magnitude / p->peakSlip;
+  } else {
+    mu = p->peakFriction +
+        (p->slidingFriction - p->peakFriction) * (magnitude - p->peakSlip) / (1.0f - p->peakSlip);
+  }
+  return (slip < 0.0f) ? -mu : mu;
+}
+
+/**
+ * @brief Longitudinal tyre force of an axle
+ */
+static float VehicleModel_TyreForce(const VehicleModel_Params_T* p, float wheelSpeed,
+                                    float vehicleSpeed, float load)
+{
+  float surface = wheelSpeed * p->wheelRadius;
+  float reference = VehicleModel_Abs(vehicleSpeed);
+  if (VehicleModel_Abs(surface) > reference) {
+    reference = VehicleModel_Abs(surface);
+  }
+  if (reference < VEHICLEMODEL_SLIP_MIN_SPEED) {
+    reference = VEHICLEMODEL_SLIP_MIN_SPEED;
+  }
+
+  return VehicleModel_Friction(p, (surface - vehicleSpeed) / reference) * load;
+}
+
+/**
+ * @brief Integrates a wheel, with the brake able to hold it stopped
+ * @return New wheel speed (rad/s)
+ */
+static float VehicleModel_IntegrateWheel(float speed, float torque, float brakeTorque,
+                                         float inertia, float h)
+{
+  speed += torque * h / inertia;
+
+  float brakeChange = brakeTorque * h / inertia;
+  if (VehicleModel_Abs(speed) <= brakeChange) {
+    return 0.0f;
+  }
+  return (speed > 0.0f) ? speed - brakeChange : speed + brakeChange;
+}
+
+/**
+ * @brief xorshift32 random number generator
+ */
+static uint32_t VehicleModel_Random(uint32_t* state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/**
+ * @brief Scales a value by a uniformly distributed factor in 1 +/- tolerance
+ */
+static float VehicleModel_Vary(uint32_t* state, float value, float tolerance)
+{
+  float unit = (float)(VehicleModel_Random(state) >> 8) / 16777216.0f;  /* 0-1 */
+  return value * (1.0f + tolerance * (2.0f * unit - 1.0f));
+}
+
+static float VehicleModel_OpenCircuitVoltage(const VehicleModel_Params_T* p, float stateOfCharge)
+{
+  return p->packVoltageEmpty + (p->packVoltageFull - p->packVoltageEmpty) * stateOfCharge;
+}
+
+/**
+ * @brief Advances the model by one sub-step
+ */
+static void VehicleModel_SubStep(VehicleModel_T* model, const VehicleModel_Input_T* input, float h)
+{
+  const VehicleModel_Params_T* p = model->params;
+
+  // Battery and DC link. Once precharged, the main contactor ties the DC
+  // link to the pack.
+  float ocv = VehicleModel_OpenCircuitVoltage(p, (float)model->stateOfCharge);
+  float packVoltage = ocv - model->dcCurrent * p->packResistance;
+  if (!input->hvConnected) {
+    model->precharged = false;
+    model->dcVoltage -= model->dcVoltage * h / (p->dischargeTimeConstant + h);
+  } else if (model->precharged) {
+    model->dcVoltage = packVoltage;
+  } else {
+    model->dcVoltage += (packVoltage - model->dcVoltage) * h / (p->prechargeTimeConstant + h);
+    model->precharged = model->dcVoltage >= VEHICLEMODEL_PRECHARGED * ocv;
+  }
+
+  // Inverter and motor
+  float motorSpeed = model->rearSpeed * p->gearRatio;
+  float motorRpm = motorSpeed * 60.0f / (2.0f * VEHICLEMODEL_PI);
+  float target = 0.0f;
+  if (input->inverterEnable && model->precharged) {
+    target = VehicleModel_Clamp(input->torqueRequest, -p->maxTorque, p->maxTorque);
+    if (VehicleModel_Abs(motorSpeed) > 1.0f) {
+      float powerLimit = p->maxPower / VehicleModel_Abs(motorSpeed);
+      target = VehicleModel_Clamp(target, -powerLimit, powerLimit);
+    }
+    if ((motorRpm >= p->maxSpeedRpm && target > 0.0f) ||
+        (motorRpm <= -p->maxSpeedRpm && target < 0.0f)) {
+      target = 0.0f;
+    }
+  }
+  model->motorTorque += (target - model->motorTorque) * h / (p->torqueTimeConstant + h);
+
+  float mechanicalPower = model->motorTorque * motorSpeed;
+  float electricalPower = (mechanicalPower >= 0.0f) ?
+      mechanicalPower / p->inverterEfficiency : mechanicalPower * p->inverterEfficiency;
+  model->dcCurrent = model->precharged ? electricalPower / model->dcVoltage : 0.0f;
+  model->stateOfCharge -= (double)(model->dcCurrent * h / (p->packCapacity * 3600.0f));
+  if (model->stateOfCharge < 0.0) {
+    model->stateOfCharge = 0.0;
+  } else if (model->stateOfCharge > 1.0) {
+    model->stateOfCharge = 1.0;
+  }
+
+  // Axle loads, with load transfer from the last acceleration
+  float weight = p->mass * VEHICLEMODEL_GRAVITY;
+  float transfer = p->mass * model->acceleration * p->cgHeight / p->wheelbase;
+  float frontLoad = weight * p->cgRearDistance / p->wheelbase - transfer;
+  float rearLoad = weight * (p->wheelbase - p->cgRearDistance) / p->wheelbase + transfer;
+  frontLoad = VehicleModel_Clamp(frontLoad, 0.0f, weight);
+  rearLoad = VehicleModel_Clamp(rearLoad, 0.0f, weight);
+
+  float frontForce = VehicleModel_TyreForce(p, model->frontSpeed, model->vehicleSpeed, frontLoad);
+  float rearForce = VehicleModel_TyreForce(p, model->rearSpeed, model->vehicleSpeed, rearLoad);
+
+  // Wheels. Driveline losses are taken on the wheel side in both directions.
+  float driveTorque = model->motorTorque * p->gearRatio;
+  driveTorque = (mechanicalPower >= 0.0f) ?
+      driveTorque * p->drivelineEfficiency : driveTorque / p->drivelineEfficiency;
+  float brakeTorque = VehicleModel_Clamp(input->brake, 0.0f, 1.0f) * p->maxBrakeTorque;
+  float rearInertia = 2.0f * p->wheelInertia + p->motorInertia * p->gearRatio * p->gearRatio;
+
+  model->frontSpeed = VehicleModel_IntegrateWheel(model->frontSpeed,
+      -frontForce * p->wheelRadius, brakeTorque * p->brakeBiasFront,
+      2.0f * p->wheelInertia, h);
+  model->rearSpeed = VehicleModel_IntegrateWheel(model->rearSpeed,
+      driveTorque - rearForce * p->wheelRadius, brakeTorque * (1.0f - p->brakeBiasFront),
+      rearInertia, h);
+
+  // Body
+  float drag = 0.5f * VEHICLEMODEL_AIR_DENSITY * p->dragArea *
+      model->vehicleSpeed * VehicleModel_Abs(model->vehicleSpeed);
+  float rolling = p->rollingResistance * weight *
+      VehicleModel_Clamp(model->vehicleSpeed / 0.1f, -1.0f, 1.0f);
+
+  model->acceleration = (frontForce + rearForce - drag - rolling) / p->mass;
+  model->vehicleSpeed += model->acceleration * h;
+  model->distance += (double)model->vehicleSpeed * (double)h;
+  model->time += (double)h;
+}
+
+/**
+ * @brief Time between tone wheel pulses at a wheel surface speed
+ */
+static uint32_t VehicleModel_PulsePeriod(const VehicleModel_Params_T* p, float speed)
+{
+  speed = VehicleModel_Abs(speed);
+  if (speed < VEHICLEMODEL_MIN_PULSE_SPEED) {
+    return 0;
+  }
+
+  float circumference = 2.0f * VEHICLEMODEL_PI * p->wheelRadius;
+  return (uint32_t)(1000000.0f * circumference / ((float)p->toneWheelTeeth * speed));
+}
+
+// ------------------- Public methods -------------------
+const VehicleModel_Params_T* VehicleModel_GetDefaultParams(void)
+{
+  return &defaultParams;
+}
+
+//------------------------------------------------------------------------------
+void VehicleModel_Disperse(const VehicleModel_Params_T* nominal, uint32_t seed,
+                           VehicleModel_Params_T* params)
+{
+  // Scramble the seed, so neighbouring seeds give unrelated draws.
+  // xorshift never leaves zero, so that is avoided.
+  uint32_t state = seed * 2654435761U;
+  if (0 == state) {
+    state = 1U;
+  }
+  uint8_t i;
+  for (i = 0; i < 4U; ++i) {
+    VehicleModel_Random(&state);
+  }
+
+  *params = *nominal;
+  params->mass = VehicleModel_Vary(&state, nominal->mass, VEHICLEMODEL_TOL_MASS);
+  params->cgRearDistance = VehicleModel_Vary(&state, nominal->cgRearDistance, VEHICLEMODEL_TOL_CG);
+  params->cgHeight = VehicleModel_Vary(&state, nominal->cgHeight, VEHICLEMODEL_TOL_CG);
+  params->dragArea = VehicleModel_Vary(&state, nominal->dragArea, VEHICLEMODEL_TOL_DRAG);
+  params->rollingResistance = VehicleModel_Vary(&state, nominal->rollingResistance, VEHICLEMODEL_TOL_ROLLING);
+  params->drivelineEfficiency = VehicleModel_Clamp(
+      VehicleModel_Vary(&state, nominal->drivelineEfficiency, VEHICLEMODEL_TOL_EFFICIENCY), 0.5f, 1.0f);
+  params->inverterEfficiency = VehicleModel_Clamp(
+      VehicleModel_Vary(&state, nominal->inverterEfficiency, VEHICLEMODEL_TOL_EFFICIENCY), 0.5f, 1.0f);
+  params->torqueTimeConstant = VehicleModel_Vary(&state, nominal->torqueTimeConstant, VEHICLEMODEL_TOL_TORQUE_TAU);
+  params->packResistance = VehicleModel_Vary(&state, nominal->packResistance, VEHICLEMODEL_TOL_RESISTANCE);
+  params->packCapacity = VehicleModel_Vary(&state, nominal->packCapacity, VEHICLEMODEL_TOL_CAPACITY);
+
+  // Grip varies with the surface, so peak and sliding friction move together
+  float grip = VehicleModel_Vary(&state, 1.0f, VEHICLEMODEL_TOL_FRICTION);
+  params->peakFriction = nominal->peakFriction * grip;
+  params->slidingFriction = nominal->slidingFriction * grip;
+
+  params->maxBrakeTorque = VehicleModel_Vary(&state, nominal->maxBrakeTorque, VEHICLEMODEL_TOL_BRAKE);
+  params->brakeBiasFront = VehicleModel_Clamp(
+      VehicleModel_Vary(&state, nominal->brakeBiasFront, VEHICLEMODEL_TOL_BRAKE_BIAS), 0.0f, 1.0f);
+}
+
+//------------------------------------------------------------------------------
+void VehicleModel_Init(VehicleModel_T* model, const VehicleModel_Params_T* params)
+{
+  memset(model, 0, sizeof(VehicleModel_T));
+  model->params = params;
+  model->stateOfCharge = 1.0;
+}
+
+//------------------------------------------------------------------------------
+void VehicleModel_Step(VehicleModel_T* model, const VehicleModel_Input_T* input, float dt)
+{
+  // Equal sub-steps no longer than the maximum
+  uint32_t steps = (uint32_t)(dt / model->params->maxStep) + 1U;
+  float h = dt / (float)steps;
+
+  uint32_t i;
+  for (i = 0; i < steps; ++i) {
+    VehicleModel_SubStep(model, input, h);
+  }
+}
+
+//------------------------------------------------------------------------------
+void VehicleModel_GetOutput(const VehicleModel_T* model, VehicleModel_Output_T* output)
+{
+  const VehicleModel_Params_T* p = model->params;
+
+  output->time = model->time;
+  output->vehicleSpeed = model->vehicleSpeed;
+  output->acceleration = model->acceleration;
+  output->distance = model->distance;
+
+  float front = model->frontSpeed * p->wheelRadius;
+  float rear = model->rearSpeed * p->wheelRadius;
+  uint8_t i;
+  for (i = 0; i < VEHICLEMODEL_NUM_WHEELS; ++i) {
+    output->wheelSpeed[i] = (i < 2U) ? front : rear;
+    output->pulsePeriodUs[i] = VehicleModel_PulsePeriod(p, output->wheelSpeed[i]);
+  }
+
+  output->motorSpeedRpm = model->rearSpeed * p->gearRatio * 60.0f / (2.0f * VEHICLEMODEL_PI);
+  output->motorTorque = model->motorTorque;
+  output->dcVoltage = model->dcVoltage;
+  output->dcCurrent = model->dcCurrent;
+  output->stateOfCharge = (float)model->stateOfCharge;
+
+  float reference = VehicleModel_Abs(model->vehicleSpeed);
+  if (reference < VEHICLEMODEL_SLIP_MIN_SPEED) {
+    reference = VEHICLEMODEL_SLIP_MIN_SPEED;
+  }
+  output->rearSlip = (rear - model->vehicleSpeed) / reference;
+}
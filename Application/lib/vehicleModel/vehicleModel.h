@@ -0,0 +1,163 @@
+/*
+ * vehicleModel.h
+ *
+ * Longitudinal vehicle dynamics plant model, for closing the loop around the
+ * control features in simulation.
+ *
+ * Models a rear wheel drive car with a single motor:
+ *  - Inverter: first order torque response to the request, limited by the
+ *    motor torque, power and speed, and only while enabled with the DC link
+ *    charged.
+ *  - Battery: open circuit voltage falling linearly with state of charge,
+ *    behind a series resistance. The DC link charges through the precharge
+ *    resistor once HV is connected, then the main contactor closes.
+ *  - Tyres: friction rising linearly with slip to its peak, then falling to
+ *    the sliding friction. Axle loads include load transfer.
+ *  - Brakes: torque at each axle by the brake bias, able to lock the wheels.
+ *  - Aerodynamic drag and rolling resistance.
+ *
+ * Outputs are the quantities the ECU's sensors see: wheel speeds and the
+ * time between tone wheel pulses, motor speed and torque, and DC voltage.
+ *
+ * The model has no hardware or RTOS dependencies, so it builds for the host
+ * as well as the target. Steps are split into fixed sub-steps, so results do
+ * not depend on the caller's step size. All state is in VehicleModel_T, so
+ * any number of independent instances can run side by side.
+ *
+ * For Monte Carlo runs, VehicleModel_Disperse draws the uncertain parameters
+ * from their tolerance bands. The draw depends only on the seed, so any run
+ * can be repeated exactly.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_VEHICLEMODEL_VEHICLEMODEL_H_
+#define LIB_VEHICLEMODEL_VEHICLEMODEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define VEHICLEMODEL_NUM_WHEELS   ((uint8_t) 4U)  /* FL, FR, RL, RR as wheelspeed */
+
+typedef struct
+{
+  // Chassis
+  float mass;               /* kg, including driver */
+  float wheelbase;          /* m */
+  float cgRearDistance;     /* m, centre of gravity to rear axle */
+  float cgHeight;           /* m */
+  float dragArea;           /* m^2, Cd x frontal area */
+  float rollingResistance;  /* Coefficient */
+
+  // Driveline
+  float gearRatio;          /* Motor to wheel */
+  float drivelineEfficiency;
+  float wheelRadius;        /* m */
+  float wheelInertia;       /* kg m^2, each wheel */
+  float motorInertia;       /* kg m^2 */
+
+  // Motor and inverter
+  float maxTorque;          /* Nm */
+  float maxPower;           /* W, mechanical */
+  float maxSpeedRpm;
+  float torqueTimeConstant; /* s */
+  float inverterEfficiency;
+
+  // Battery
+  float packVoltageFull;    /* V, open circuit */
+  float packVoltageEmpty;   /* V, open circuit */
+  float packResistance;     /* Ohm */
+  float packCapacity;       /* Ah */
+  float prechargeTimeConstant;  /* s */
+  float dischargeTimeConstant;  /* s */
+
+  // Tyres and brakes
+  float peakFriction;
+  float peakSlip;
+  float slidingFriction;    /* At 100% slip */
+  float maxBrakeTorque;     /* Nm, total of all wheels */
+  float brakeBiasFront;     /* Fraction of brake torque at the front */
+
+  // Wheel speed sensors
+  uint16_t toneWheelTeeth;
+
+  float maxStep;            /* s, longest sub-step */
+} VehicleModel_Params_T;
+
+typedef struct
+{
+  float torqueRequest;      /* Nm, motor torque commanded to the inverter */
+  bool inverterEnable;
+  bool hvConnected;         /* Contactors closed */
+  float brake;              /* Driver brake demand, 0-1 */
+} VehicleModel_Input_T;
+
+typedef struct
+{
+  double time;              /* s, simulated */
+  float vehicleSpeed;       /* m/s */
+  float acceleration;       /* m/s^2 */
+  double distance;          /* m */
+  float wheelSpeed[VEHICLEMODEL_NUM_WHEELS];  /* Wheel surface speed (m/s) */
+  uint32_t pulsePeriodUs[VEHICLEMODEL_NUM_WHEELS];  /* Between tone wheel pulses, 0 if stopped */
+  float motorSpeedRpm;
+  float motorTorque;        /* Nm, actual */
+  float dcVoltage;          /* V, DC link */
+  float dcCurrent;          /* A, out of the battery */
+  float stateOfCharge;      /* 0-1 */
+  float rearSlip;           /* Driven axle slip ratio */
+} VehicleModel_Output_T;
+
+typedef struct
+{
+  const VehicleModel_Params_T* params;
+
+  // Accumulated over millions of sub-steps, far below float resolution
+  double time;
+  float vehicleSpeed;
+  float acceleration;
+  double distance;
+  float frontSpeed;         /* rad/s, front wheels */
+  float rearSpeed;          /* rad/s, rear wheels and motor through the gearbox */
+  float motorTorque;
+  float dcVoltage;
+  float dcCurrent;
+  double stateOfCharge;
+  bool precharged;          /* Main contactor closed */
+} VehicleModel_T;
+
+/**
+ * @brief Default parameters, for the prototype car
+ */
+const VehicleModel_Params_T* VehicleModel_GetDefaultParams(void);
+
+/**
+ * @brief Draws parameters within their tolerances of the nominal ones.
+ * Varied: mass, centre of gravity, drag, rolling resistance, efficiencies,
+ * torque response, pack resistance and capacity, tyre friction and brake
+ * torque and bias.
+ * @param seed Any value, the same seed gives the same parameters
+ */
+void VehicleModel_Disperse(const VehicleModel_Params_T* nominal, uint32_t seed,
+                           VehicleModel_Params_T* params);
+
+/**
+ * @brief Initialize the model, at rest with a full battery and HV off
+ * @param params Model parameters, must remain valid
+ */
+void VehicleModel_Init(VehicleModel_T* model, const VehicleModel_Params_T* params);
+
+/**
+ * @brief Advance the model
+ * @param input Held for the whole step
+ * @param dt Step length (s)
+ */
+void VehicleModel_Step(VehicleModel_T* model, const VehicleModel_Input_T* input, float dt);
+
+/**
+ * @brief Get the model outputs
+ */
+void VehicleModel_GetOutput(const VehicleModel_T* model, VehicleModel_Output_T* output);
+
+#endif /* LIB_VEHICLEMODEL_VEHICLEMODEL_H_ */
@@ -0,0 +1,17 @@
+/*
+ * bootControl.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "bootControl.h"
+
+// ------------------- Public methods -------------------
+void BootControl_EnterBootloader(void)
+{
+  HAL_PWR_EnableBkUpAccess();
+  RTC->BKP0R = BOOTCONTROL_REQUEST_MAGIC;
+
+  NVIC_SystemReset();
+}
@@ -0,0 +1,57 @@
+/*
+ * bootControl.h
+ *
+ * Flash layout and hand-over between the CAN bootloader and the application.
+ * Shared with the bootloader (see Bootloader/).
+ *
+ * Flash (single bank):
+ *  - Sectors 0-1   0x08000000  64KB    Bootloader
+ *  - Sector 2      0x08010000  32KB    Boot record (application length and CRC)
+ *  - Sectors 3-9   0x08018000  1440KB  Application
+ *  - Sectors 10-11 0x08180000  512KB   Calibration parameters (lib/paramStore)
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef STARTUP_BOOTCONTROL_H_
+#define STARTUP_BOOTCONTROL_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+
+#define BOOTCONTROL_BOOTLOADER_ADDR     ((uint32_t) 0x08000000U)
+#define BOOTCONTROL_RECORD_ADDR         ((uint32_t) 0x08010000U)
+#define BOOTCONTROL_RECORD_SECTOR       FLASH_SECTOR_2
+#define BOOTCONTROL_APP_ADDR            ((uint32_t) 0x08018000U)
+#define BOOTCONTROL_APP_END             ((uint32_t) 0x08180000U)
+#define BOOTCONTROL_APP_FIRST_SECTOR    FLASH_SECTOR_3
+#define BOOTCONTROL_APP_LAST_SECTOR     FLASH_SECTOR_9
+
+/* Diagnostic request/response CAN IDs, used by both the bootloader and the application */
+#define BOOTCONTROL_CAN_ID_REQUEST      ((uint32_t) 0x7E0U)
+#define BOOTCONTROL_CAN_ID_RESPONSE     ((uint32_t) 0x7E8U)
+
+/* Written to RTC backup register 0 to stay in the bootloader after reset */
+#define BOOTCONTROL_REQUEST_MAGIC       ((uint32_t) 0xB007AB1EU)
+#define BOOTCONTROL_RECORD_MAGIC        ((uint32_t) 0x41505031U)  /* "APP1" */
+
+/*
+ * Written by the bootloader once an image has been downloaded and verified.
+ * The CRC is calculated by the CRC unit (lib/crc) over the image words.
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t appLength;     /* Bytes, multiple of 4 */
+  uint32_t appCrc;
+  uint32_t recordCrc;     /* Over the preceding words */
+} BootControl_Record_T;
+
+/**
+ * @brief Resets into the bootloader, which then waits for a download.
+ * Does not return.
+ */
+void BootControl_EnterBootloader(void);
+
+#endif /* STARTUP_BOOTCONTROL_H_ */
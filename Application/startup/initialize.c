@@ -13,15 +13,40 @@
 #include "lib/logging/logging.h"
 #include "comm/can/can.h"
 #include "comm/uart/uart.h"
+#include "comm/spi/spi.h"
+#include "comm/isotp/isotp.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canStats/canStats.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "comm/xcp/xcpCan.h"
+#include "comm/uds/uds.h"
+#include "comm/gateway/gateway.h"
 #include "io/adc/adc.h"
 #include "time/tasktimer/tasktimer.h"
 #include "time/externalWatchdog/externalWatchdog.h"
 #include "time/rtc/rtc.h"
+#include "time/cycleCounter/cycleCounter.h"
+#include "time/deferred/deferred.h"
+#include "time/benchmark/benchmark.h"
+#include "time/latency/latency.h"
+#include "lib/paramStore/paramStore.h"
+#include "lib/signalDb/signalDb.h"
 
 #include "device/wheelspeed/wheelspeed.h"
+#include "device/inverter/inverter.h"
+#include "device/analog/analog.h"
 
 #include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+#include "vehicleInterface/diagMapping/diagMapping.h"
+#include "vehicleInterface/gatewayMapping/gatewayMapping.h"
+#include "vehicleInterface/benchmarkMapping/benchmarkMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+#include "vehicleInterface/analogMapping/analogMapping.h"
 #include "vehicleProcesses/example/example.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+#include "vehicleProcesses/tractionControl/tractionControl.h"
 #include "vehicleProcesses/watchdogTrigger/watchdogTrigger.h"
 
 // ------------------- Private data -------------------
@@ -105,6 +130,15 @@ static ECU_Init_Status_T ECU_Init_System2(void)
   logPrintS(&log, "###### ECU_Init_System2 ######\n", LOGGING_DEFAULT_BUFF_LEN);
   char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
 
+  // Calibration parameters - loaded first as everything else may use them
+  ParamStore_Status_T statusParams;
+  statusParams = ParamStore_Init(&log, Mapping_GetParamDefaults(), MAPPING_PARAM_NUM_PARAMS);
+  if (PARAMSTORE_STATUS_OK != statusParams) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "ParamStore initialization error %u\n", statusParams);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
   // CAN bus
   CAN_Status_T statusCan;
   statusCan = CAN_Init(&log);
@@ -121,6 +155,36 @@ static ECU_Init_Status_T ECU_Init_System2(void)
     return ECU_INIT_ERROR;
   }
 
+  statusCan = CAN_Config(Mapping_GetCAN2());
+  if (CAN_STATUS_OK != statusCan) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CAN2 config error %u\n", statusCan);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  statusCan = CAN_Config(Mapping_GetCAN3());
+  if (CAN_STATUS_OK != statusCan) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CAN3 config error %u\n", statusCan);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // SPI
+  SPI_Status_T statusSpi;
+  statusSpi = SPI_Init(&log);
+  if (SPI_STATUS_OK != statusSpi) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "SPI Initialization error %u\n", statusSpi);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  statusSpi = SPI_Config(Mapping_GetSPI4());
+  if (SPI_STATUS_OK != statusSpi) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "SPI config error %u\n", statusSpi);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
   // ADC
   ADC_Status_T statusAdc;
   statusAdc = ADC_Init(&log, MAPPING_ADC_NUM_CHANNELS, 16);  // TODO don't use magic number
@@ -145,6 +209,75 @@ static ECU_Init_Status_T ECU_Init_System2(void)
     return ECU_INIT_ERROR;
   }
 
+  // Cycle counter
+  CycleCounter_Status_T statusCycleCounter = CycleCounter_Init(&log);
+  if (CYCLECOUNTER_STATUS_OK != statusCycleCounter) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CycleCounter initialization error %u\n", statusCycleCounter);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // Deferred interrupt processing
+  Deferred_Status_T statusDeferred = Deferred_Init(&log);
+  if (DEFERRED_STATUS_OK != statusDeferred) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Deferred initialization error %u\n", statusDeferred);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // Signal database
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  SignalDb_Status_T statusSignalDb = SignalDb_Init(&log, signalGroups, numSignalGroups);
+  if (SIGNALDB_STATUS_OK != statusSignalDb) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "SignalDb initialization error %u\n", statusSignalDb);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // ISO-TP
+  IsoTp_Status_T statusIsoTp = IsoTp_Init(&log);
+  if (ISOTP_STATUS_OK != statusIsoTp) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "ISO-TP initialization error %u\n", statusIsoTp);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // CAN RX timeout monitoring
+  CanMonitor_Status_T statusCanMonitor = CanMonitor_Init(&log);
+  if (CANMONITOR_STATUS_OK != statusCanMonitor) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CanMonitor initialization error %u\n", statusCanMonitor);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // CAN bus statistics
+  CanStats_Status_T statusCanStats = CanStats_Init(&log);
+  if (CANSTATS_STATUS_OK != statusCanStats) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CanStats initialization error %u\n", statusCanStats);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  CAN_HandleTypeDef* canBuses[] = { Mapping_GetCAN1(), Mapping_GetCAN2(), Mapping_GetCAN3() };
+  uint8_t bus;
+  for (bus = 0; bus < sizeof(canBuses) / sizeof(canBuses[0]); ++bus) {
+    statusCanStats = CanStats_Config(canBuses[bus]);
+    if (CANSTATS_STATUS_OK != statusCanStats) {
+      snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CanStats CAN%u config error %u\n", bus + 1U, statusCanStats);
+      logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+      return ECU_INIT_ERROR;
+    }
+  }
+
+  // CAN traffic recorder
+  CanRecorder_Status_T statusCanRecorder = CanRecorder_Init(&log);
+  if (CANRECORDER_STATUS_OK != statusCanRecorder) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CanRecorder initialization error %u\n", statusCanRecorder);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
   // RTC
   RTC_Status_T rtcStatus = RTC_Init(&log);
   if (RTC_STATUS_OK != rtcStatus) {
@@ -187,6 +320,27 @@ static ECU_Init_Status_T ECU_Init_App1(void)
     return ECU_INIT_ERROR;
   }
 
+  // Inverter
+  Inverter_Status_T statusInverter = Inverter_Init(&log, Mapping_GetCAN1());
+  if (INVERTER_STATUS_OK != statusInverter) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Inverter init error %u", statusInverter);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // Analog inputs
+  uint8_t numAnalogChannels;
+  const Analog_ChannelConfig_T* analogChannels = Mapping_GetAnalogChannels(&numAnalogChannels);
+  uint8_t numAnalogBiases;
+  const Analog_BiasConfig_T* analogBiases = Mapping_GetAnalogBiases(&numAnalogBiases);
+  Analog_Status_T statusAnalog = Analog_Init(&log, analogChannels, numAnalogChannels, MAPPING_ADC1_VREFINT,
+                                             analogBiases, numAnalogBiases);
+  if (ANALOG_STATUS_OK != statusAnalog) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Analog init error %u", statusAnalog);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
   return ECU_INIT_OK;
 }
 
@@ -194,6 +348,31 @@ static ECU_Init_Status_T ECU_Init_App1(void)
 static ECU_Init_Status_T ECU_Init_App2(void)
 {
   logPrintS(&log, "###### ECU_Init_App2 ######\n", LOGGING_DEFAULT_BUFF_LEN);
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+
+  // XCP measurement and calibration
+  XcpCan_Status_T statusXcp = XcpCan_Init(&log, Mapping_GetCAN1(), Mapping_CalStoreAllowed);
+  if (XCPCAN_STATUS_OK != statusXcp) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "XCP init error %u", statusXcp);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // UDS diagnostics
+  Uds_Status_T statusUds = Uds_Init(&log, Mapping_GetCAN1(), Mapping_GetUdsConfig());
+  if (UDS_STATUS_OK != statusUds) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "UDS init error %u", statusUds);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // CAN gateway
+  Gateway_Status_T statusGateway = Gateway_Init(&log, Mapping_GetGatewayConfig());
+  if (GATEWAY_STATUS_OK != statusGateway) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Gateway init error %u", statusGateway);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
 
   return ECU_INIT_OK;
 }
@@ -217,6 +396,30 @@ static ECU_Init_Status_T ECU_Init_App3(void)
     return ECU_INIT_ERROR;
   }
 
+  // Vehicle state machine
+  VehicleState_Status_T statusVs = VehicleState_Init(&log, Mapping_GetCAN1());
+  if (VEHICLESTATE_STATUS_OK != statusVs) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "VehicleState process init error %u", statusVs);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // Pedals
+  Pedals_Status_T statusPedals = Pedals_Init(&log);
+  if (PEDALS_STATUS_OK != statusPedals) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Pedals process init error %u", statusPedals);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
+  // Traction control
+  TractionControl_Status_T statusTc = TractionControl_Init(&log);
+  if (TRACTIONCONTROL_STATUS_OK != statusTc) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "TractionControl process init error %u", statusTc);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+
   // Watchdog Trigger
   WatchdogTrigger_Status_T watchdogTriggerStatus = WatchdogTrigger_Init(&log);
   if (WATCHDOGTRIGGER_STATUS_OK != watchdogTriggerStatus) {
@@ -225,6 +428,28 @@ static ECU_Init_Status_T ECU_Init_App3(void)
     return ECU_INIT_ERROR;
   }
 
+#if ECU_ENABLE_BENCHMARKS
+  // Benchmarks
+  uint8_t numBenchmarks;
+  const Benchmark_T* benchmarks = Mapping_GetBenchmarks(&numBenchmarks);
+  Benchmark_Status_T benchmarkStatus = Benchmark_Init(&log, benchmarks, numBenchmarks);
+  if (BENCHMARK_STATUS_OK != benchmarkStatus) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Benchmark init error %u", benchmarkStatus);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+#endif
+
+#if ECU_ENABLE_LATENCY
+  // Interrupt latency, on the data logger bus
+  Latency_Status_T latencyStatus = Latency_Init(&log, Mapping_GetLatencyTimer(), Mapping_GetCAN3());
+  if (LATENCY_STATUS_OK != latencyStatus) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Latency init error %u", latencyStatus);
+    logPrintS(&log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    return ECU_INIT_ERROR;
+  }
+#endif
+
   return ECU_INIT_OK;
 }
 
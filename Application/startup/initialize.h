@@ -8,6 +8,24 @@
 #ifndef INC_INITIALIZE_H_
 #define INC_INITIALIZE_H_
 
+/*
+ * Development only, off unless defined to 1 in the compiler settings.
+ * The benchmarks mask interrupts for up to a few thousand cycles at a time
+ * while the control tasks are running.
+ */
+#ifndef ECU_ENABLE_BENCHMARKS
+#define ECU_ENABLE_BENCHMARKS   0
+#endif
+
+/*
+ * Development only, as ECU_ENABLE_BENCHMARKS. The latency harness needs
+ * LATENCY_OUT looped back to LATENCY_IN, wakes a task at the control
+ * priority every period and sends its results on CAN3 at about 800 frames/s.
+ * Also gates the LATENCY_IN interrupt in main.c.
+ */
+#ifndef ECU_ENABLE_LATENCY
+#define ECU_ENABLE_LATENCY      0
+#endif
 
 typedef enum
 {
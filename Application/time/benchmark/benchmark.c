@@ -0,0 +1,198 @@
+/*
+ * benchmark.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define BENCHMARK_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[BENCHMARK_STACK_SIZE];
+
+// Lowest priority, so the suite only runs in spare time
+#define BENCHMARK_TASK_PRIORITY (tskIDLE_PRIORITY)
+
+// Task data
+static TaskHandle_t benchmarkTaskHandle;
+
+static const Benchmark_T* benchmarks;
+static uint8_t numBenchmarks;
+static Benchmark_Result_T results[BENCHMARK_MAX_BENCHMARKS];
+static volatile bool runRequested;
+static Benchmark_Stats_T stats;
+
+// ------------------- Private methods -------------------
+static void Benchmark_Empty(void)
+{
+}
+
+/**
+ * @brief Times a kernel
+ * @param overhead Cycles taken off each iteration
+ */
+static void Benchmark_Time(void (*kernel)(void), uint32_t overhead, Benchmark_Result_T* result)
+{
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  uint64_t total = 0;
+
+  uint16_t i;
+  for (i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+    taskENTER_CRITICAL();
+    uint32_t start = CycleCounter_Get();
+    kernel();
+    uint32_t cycles = CycleCounter_Elapsed(start);
+    taskEXIT_CRITICAL();
+
+    cycles = (cycles > overhead) ? cycles - overhead : 0;
+    if (cycles < min) {
+      min = cycles;
+    }
+    if (cycles > max) {
+      max = cycles;
+    }
+    total += cycles;
+  }
+
+  result->minCycles = min;
+  result->meanCycles = (uint32_t)(total / BENCHMARK_ITERATIONS);
+  result->maxCycles = max;
+}
+
+static void Benchmark_RunAll(void)
+{
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+
+  // Cost of the timing itself
+  Benchmark_Result_T calibration;
+  Benchmark_Time(Benchmark_Empty, 0, &calibration);
+
+  uint8_t failed = 0;
+  uint8_t i;
+  for (i = 0; i < numBenchmarks; ++i) {
+    const Benchmark_T* benchmark = &benchmarks[i];
+    Benchmark_Result_T result;
+
+    if (NULL != benchmark->setup) {
+      benchmark->setup();
+    }
+    Benchmark_Time(benchmark->kernel, calibration.minCycles, &result);
+    result.passed = result.minCycles <= benchmark->budgetCycles;
+    if (!result.passed) {
+      failed++;
+    }
+
+    taskENTER_CRITICAL();
+    results[i] = result;
+    taskEXIT_CRITICAL();
+
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "bench,%s,%lu,%lu,%lu,%lu,%s\n",
+        benchmark->name, result.minCycles, result.meanCycles, result.maxCycles,
+        benchmark->budgetCycles, result.passed ? "PASS" : "FAIL");
+    logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+  }
+
+  snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "bench,summary,%u,%u\n", failed, numBenchmarks);
+  logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+
+  taskENTER_CRITICAL();
+  stats.runs++;
+  stats.failed = failed;
+  taskEXIT_CRITICAL();
+}
+
+static void Benchmark_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Benchmark_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if ((notifiedValue > 0) && runRequested) {
+      // ready to process
+      runRequested = false;
+      Benchmark_RunAll();
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Benchmark_Status_T Benchmark_Init(Logging_T* logger, const Benchmark_T* benchmarkTable, uint8_t num)
+{
+  log = logger;
+  logPrintS(log, "Benchmark_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  if (num > BENCHMARK_MAX_BENCHMARKS) {
+    return BENCHMARK_STATUS_ERROR;
+  }
+  benchmarks = benchmarkTable;
+  numBenchmarks = num;
+  memset(results, 0, sizeof(results));
+  memset(&stats, 0, sizeof(Benchmark_Stats_T));
+  runRequested = true;
+
+  // create main task
+  benchmarkTaskHandle = xTaskCreateStatic(
+      Benchmark_TaskMain,
+      "BenchmarkTask",
+      BENCHMARK_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      BENCHMARK_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 100ms
+  uint16_t timerDivider = BENCHMARK_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&benchmarkTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return BENCHMARK_STATUS_ERROR;
+  }
+
+  logPrintS(log, "Benchmark_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return BENCHMARK_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Benchmark_Request(void)
+{
+  runRequested = true;
+}
+
+//------------------------------------------------------------------------------
+Benchmark_Status_T Benchmark_GetResult(uint8_t index, Benchmark_Result_T* result)
+{
+  if (index >= numBenchmarks) {
+    return BENCHMARK_STATUS_ERROR;
+  }
+
+  taskENTER_CRITICAL();
+  *result = results[index];
+  taskEXIT_CRITICAL();
+  return BENCHMARK_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Benchmark_GetStats(Benchmark_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
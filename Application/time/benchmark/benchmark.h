@@ -0,0 +1,92 @@
+/*
+ * benchmark.h
+ *
+ * Micro-benchmarks of the firmware's building blocks, timed with the DWT
+ * cycle counter.
+ *
+ * Each kernel is timed over a number of iterations, one iteration at a time
+ * with interrupts masked, so the results are free of preemption. The cost of
+ * reading the cycle counter is measured first and taken off. A kernel fails
+ * if its fastest iteration exceeds its budget. The fastest iteration is the
+ * most repeatable figure, so it is the one gated on.
+ *
+ * The suite runs once after start up, at the lowest priority, and again
+ * whenever requested. It is only started in builds with
+ * ECU_ENABLE_BENCHMARKS defined to 1, see initialize.h. Results are logged
+ * one line per kernel, in CSV:
+ *
+ *   bench,<name>,<min>,<mean>,<max>,<budget>,<PASS|FAIL>
+ *   bench,summary,<failed>,<total>
+ *
+ * Times are in cycles. Interrupts are masked for one iteration at a time,
+ * so kernels should take no more than a few microseconds.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef TIME_BENCHMARK_BENCHMARK_H_
+#define TIME_BENCHMARK_BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define BENCHMARK_PERIOD_MS         ((uint16_t) 100U)
+
+#define BENCHMARK_MAX_BENCHMARKS    ((uint8_t) 32U)
+#define BENCHMARK_ITERATIONS        ((uint16_t) 1000U)
+
+typedef enum
+{
+  BENCHMARK_STATUS_OK     = 0x00U,
+  BENCHMARK_STATUS_ERROR  = 0x01U
+} Benchmark_Status_T;
+
+typedef struct
+{
+  const char* name;
+  void (*setup)(void);      /* Called once before timing, may be NULL */
+  void (*kernel)(void);     /* One iteration */
+  uint32_t budgetCycles;    /* Fastest iteration must be within this */
+} Benchmark_T;
+
+typedef struct
+{
+  uint32_t minCycles;
+  uint32_t meanCycles;
+  uint32_t maxCycles;
+  bool passed;
+} Benchmark_Result_T;
+
+typedef struct
+{
+  uint32_t runs;            /* Complete runs of the suite */
+  uint8_t failed;           /* In the last run */
+} Benchmark_Stats_T;
+
+/**
+ * @brief Initialize and start the benchmarks
+ * @param logger Pointer to system logger
+ * @param benchmarks Benchmark table, must remain valid
+ * @param numBenchmarks Number of benchmarks in the table
+ */
+Benchmark_Status_T Benchmark_Init(Logging_T* logger, const Benchmark_T* benchmarks, uint8_t numBenchmarks);
+
+/**
+ * @brief Run the suite again
+ */
+void Benchmark_Request(void);
+
+/**
+ * @brief Get the result of a benchmark from the last run
+ */
+Benchmark_Status_T Benchmark_GetResult(uint8_t index, Benchmark_Result_T* result);
+
+/**
+ * @brief Get the benchmark statistics
+ */
+void Benchmark_GetStats(Benchmark_Stats_T* stats);
+
+#endif /* TIME_BENCHMARK_BENCHMARK_H_ */
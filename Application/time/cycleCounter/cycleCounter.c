@@ -0,0 +1,38 @@
+/*
+ * cycleCounter.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+// Software lock access register (not in the CMSIS DWT definition for the M7)
+#define DWT_LAR         (*(volatile uint32_t*)0xE0001FB0U)
+#define DWT_LAR_UNLOCK  0xC5ACCE55U
+
+// ------------------- Public methods -------------------
+CycleCounter_Status_T CycleCounter_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "CycleCounter_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT_LAR = DWT_LAR_UNLOCK;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  // Check that the counter is implemented and running
+  uint32_t start = DWT->CYCCNT;
+  __NOP();
+  __NOP();
+  if (DWT->CYCCNT == start) {
+    return CYCLECOUNTER_STATUS_ERROR;
+  }
+
+  logPrintS(log, "CycleCounter_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return CYCLECOUNTER_STATUS_OK;
+}
@@ -0,0 +1,57 @@
+/*
+ * cycleCounter.h
+ *
+ * Cycle-accurate timestamps from the Cortex-M7 DWT cycle counter.
+ * Used for measuring latencies and execution time within the control loop.
+ * The counter wraps every ~21s at 200MHz, so only differences of shorter
+ * intervals than that are meaningful.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef TIME_CYCLECOUNTER_CYCLECOUNTER_H_
+#define TIME_CYCLECOUNTER_CYCLECOUNTER_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+
+#include "lib/logging/logging.h"
+
+typedef enum
+{
+  CYCLECOUNTER_STATUS_OK     = 0x00U,
+  CYCLECOUNTER_STATUS_ERROR  = 0x01U
+} CycleCounter_Status_T;
+
+/**
+ * @brief Enables the DWT cycle counter
+ * @param logger Pointer to system logger
+ */
+CycleCounter_Status_T CycleCounter_Init(Logging_T* logger);
+
+/**
+ * @brief Current cycle count. Safe to call from any context.
+ */
+static inline uint32_t CycleCounter_Get(void)
+{
+  return DWT->CYCCNT;
+}
+
+/**
+ * @brief Cycles elapsed since an earlier CycleCounter_Get value (handles wrap)
+ */
+static inline uint32_t CycleCounter_Elapsed(uint32_t start)
+{
+  return DWT->CYCCNT - start;
+}
+
+/**
+ * @brief Converts a number of cycles to microseconds
+ */
+static inline uint32_t CycleCounter_ToMicros(uint32_t cycles)
+{
+  return cycles / (SystemCoreClock / 1000000U);
+}
+
+#endif /* TIME_CYCLECOUNTER_CYCLECOUNTER_H_ */
@@ -0,0 +1,211 @@
+/*
+ * deferred.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "deferred.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "vehicleInterface/deviceMapping/deviceMapping.h" /* RTOS interrupt priorities */
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define DEFERRED_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[DEFERRED_STACK_SIZE];
+
+// Above every other task, so processing follows its interrupt directly
+#define DEFERRED_TASK_PRIORITY (tskIDLE_PRIORITY + 5)
+
+// Task data
+static TaskHandle_t deferredTaskHandle;
+
+typedef struct
+{
+  Deferred_Config_T config;
+  uint8_t items[DEFERRED_QUEUE_LENGTH][DEFERRED_MAX_ITEM_SIZE];
+  volatile uint8_t head;          /* Written by the interrupt */
+  volatile uint8_t tail;          /* Written by the dispatcher */
+  Deferred_Stats_T stats;
+} Deferred_T;
+
+static Deferred_T sources[DEFERRED_MAX_SOURCES];
+static uint8_t numSources;
+
+// Every interrupt that calls the RTOS must be masked by its critical sections
+#define DEFERRED_CHECK_IRQ(irq, priority) \
+  _Static_assert((priority) >= configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, \
+      #irq " priority is above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY");
+MAPPING_RTOS_IRQS(DEFERRED_CHECK_IRQ)
+
+typedef struct
+{
+  const char* name;
+  IRQn_Type irq;
+  uint32_t priority;
+} Deferred_Irq_T;
+
+#define DEFERRED_IRQ_ENTRY(irq, priority) { #irq, irq, priority },
+static const Deferred_Irq_T rtosIrqs[] = {
+  MAPPING_RTOS_IRQS(DEFERRED_IRQ_ENTRY)
+};
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Checks the NVIC has the priorities listed in the mapping
+ */
+static Deferred_Status_T Deferred_CheckPriorities(void)
+{
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+  Deferred_Status_T status = DEFERRED_STATUS_OK;
+
+  uint8_t i;
+  for (i = 0; i < sizeof(rtosIrqs) / sizeof(Deferred_Irq_T); ++i) {
+    uint32_t priority = NVIC_GetPriority(rtosIrqs[i].irq);
+    if (priority != rtosIrqs[i].priority) {
+      snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Deferred: %s priority %lu, expected %lu\n",
+          rtosIrqs[i].name, priority, rtosIrqs[i].priority);
+      logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+      status = DEFERRED_STATUS_ERROR;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief Runs the handler for every item waiting in a source
+ */
+static void Deferred_Drain(Deferred_T* source)
+{
+  uint8_t tail = source->tail;
+  while (tail != source->head) {
+    source->config.handler(source->items[tail]);
+
+    // Handler is done with the slot before the interrupt may reuse it
+    __DMB();
+    tail = (uint8_t)((tail + 1U) % DEFERRED_QUEUE_LENGTH);
+    source->tail = tail;
+
+    taskENTER_CRITICAL();
+    source->stats.handled++;
+    taskEXIT_CRITICAL();
+  }
+}
+
+static void Deferred_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Deferred_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up, from any source
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      uint8_t i;
+      for (i = 0; i < numSources; ++i) {
+        Deferred_Drain(&sources[i]);
+      }
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Deferred_Status_T Deferred_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "Deferred_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  memset(sources, 0, sizeof(sources));
+  numSources = 0;
+
+  if (DEFERRED_STATUS_OK != Deferred_CheckPriorities()) {
+    return DEFERRED_STATUS_ERROR;
+  }
+
+  // create main task
+  deferredTaskHandle = xTaskCreateStatic(
+      Deferred_TaskMain,
+      "DeferredTask",
+      DEFERRED_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      DEFERRED_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  logPrintS(log, "Deferred_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return DEFERRED_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+Deferred_Status_T Deferred_Register(const Deferred_Config_T* config, Deferred_Source_T* source)
+{
+  if ((numSources >= DEFERRED_MAX_SOURCES) || (NULL == config->handler) ||
+      (0 == config->itemSize) || (config->itemSize > DEFERRED_MAX_ITEM_SIZE)) {
+    return DEFERRED_STATUS_ERROR;
+  }
+
+  sources[numSources].config = *config;
+  *source = numSources;
+  numSources++;
+
+  return DEFERRED_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+bool Deferred_Post(Deferred_Source_T source, const void* item)
+{
+  if (source >= numSources) {
+    return false;
+  }
+
+  Deferred_T* s = &sources[source];
+  uint8_t head = s->head;
+  uint8_t next = (uint8_t)((head + 1U) % DEFERRED_QUEUE_LENGTH);
+  if (next == s->tail) {
+    s->stats.dropped++;
+    return false;
+  }
+
+  memcpy(s->items[head], item, s->config.itemSize);
+
+  // Item is complete before the dispatcher can see it
+  __DMB();
+  s->head = next;
+
+  s->stats.posted++;
+  uint8_t depth = (uint8_t)((next + DEFERRED_QUEUE_LENGTH - s->tail) % DEFERRED_QUEUE_LENGTH);
+  if (depth > s->stats.maxDepth) {
+    s->stats.maxDepth = depth;
+  }
+
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(deferredTaskHandle, &higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+Deferred_Status_T Deferred_GetStats(Deferred_Source_T source, Deferred_Stats_T* stats)
+{
+  if (source >= numSources) {
+    return DEFERRED_STATUS_ERROR;
+  }
+
+  taskENTER_CRITICAL();
+  *stats = sources[source].stats;
+  taskEXIT_CRITICAL();
+  return DEFERRED_STATUS_OK;
+}
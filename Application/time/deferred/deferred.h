@@ -0,0 +1,86 @@
+/*
+ * deferred.h
+ *
+ * Deferred interrupt processing. An interrupt handler captures what it needs
+ * into its source's queue and returns; the processing is done later by a
+ * single dispatcher task, above every other task. This keeps the handlers
+ * short, and lets the processing use the RTOS like any task.
+ *
+ * Each source has its own single producer, single consumer ring, so posting
+ * needs no locks. A source must only be posted to from interrupts of one
+ * priority, which then cannot preempt each other. Items posted to a full
+ * queue are dropped and counted.
+ *
+ * Interrupts may only call the RTOS if they are at or below
+ * configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY. The interrupts that do are
+ * listed in deviceMapping with their priorities: the list is checked against
+ * the limit when building, and against the NVIC when initializing.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef TIME_DEFERRED_DEFERRED_H_
+#define TIME_DEFERRED_DEFERRED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define DEFERRED_MAX_SOURCES      ((uint8_t) 16U)
+#define DEFERRED_QUEUE_LENGTH     ((uint8_t) 16U)   /* Holds one less */
+#define DEFERRED_MAX_ITEM_SIZE    ((uint8_t) 24U)   /* Bytes */
+
+typedef enum
+{
+  DEFERRED_STATUS_OK     = 0x00U,
+  DEFERRED_STATUS_ERROR  = 0x01U
+} Deferred_Status_T;
+
+typedef uint8_t Deferred_Source_T;
+
+/**
+ * @brief Processes an item, from the dispatcher task
+ */
+typedef void (*Deferred_Handler)(const void* item);
+
+typedef struct
+{
+  Deferred_Handler handler;
+  uint8_t itemSize;         /* Bytes copied from each post */
+} Deferred_Config_T;
+
+typedef struct
+{
+  uint32_t posted;
+  uint32_t dropped;         /* Queue full */
+  uint32_t handled;
+  uint8_t maxDepth;         /* Most items waiting at once */
+} Deferred_Stats_T;
+
+/**
+ * @brief Check the interrupt priorities, and start the dispatcher
+ * @param logger Pointer to system logger
+ */
+Deferred_Status_T Deferred_Init(Logging_T* logger);
+
+/**
+ * @brief Add a source. Called before the scheduler starts.
+ * @param source Set to the handle for posting to
+ */
+Deferred_Status_T Deferred_Register(const Deferred_Config_T* config, Deferred_Source_T* source);
+
+/**
+ * @brief Queue an item for the source's handler. Called from interrupts.
+ * @param item Copied, itemSize bytes
+ * @return false if the queue was full
+ */
+bool Deferred_Post(Deferred_Source_T source, const void* item);
+
+/**
+ * @brief Get the statistics of a source
+ */
+Deferred_Status_T Deferred_GetStats(Deferred_Source_T source, Deferred_Stats_T* stats);
+
+#endif /* TIME_DEFERRED_DEFERRED_H_ */
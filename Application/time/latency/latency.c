@@ -0,0 +1,309 @@
+/*
+ * latency.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "latency.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "vehicleInterface/deviceMapping/deviceMapping.h" /* Fetch auto-generated GPIO names */
+
+#include "comm/can/can.h"
+#include "comm/canTx/canTx.h"
+#include "time/cycleCounter/cycleCounter.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define LATENCY_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[LATENCY_STACK_SIZE];
+
+// Same as the control processes, to see the wake up latency they see
+#define LATENCY_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
+
+// Task data
+static TaskHandle_t latencyTaskHandle;
+
+static TIM_HandleTypeDef* timerHandle;
+static CAN_HandleTypeDef* canHandle;
+static uint32_t cyclesPerTick;    /* CPU cycles per timer count */
+static volatile bool initialized; /* The EXTI can fire in builds that don't start the harness */
+
+// Sample in progress, from the edge until the frame is sent
+typedef enum
+{
+  LATENCY_SAMPLE_IDLE     = 0U,
+  LATENCY_SAMPLE_EDGE     = 1U,   /* Waiting for the task */
+  LATENCY_SAMPLE_TX       = 2U    /* Waiting for the frame */
+} Latency_Sample_T;
+
+static volatile Latency_Sample_T sample;
+static uint32_t edgeCycles;       /* CycleCounter time of the edge */
+static uint32_t edgeIsrNs;
+
+// Frame given up on, if the bus is off or busy
+#define LATENCY_TX_TIMEOUT_MS 100U
+
+static Latency_Histogram_T hist[LATENCY_NUM_STAGES];
+static Latency_Stats_T stats;
+
+static const char* const stageNames[LATENCY_NUM_STAGES] = {
+  "isr",
+  "task",
+  "can"
+};
+
+// ------------------- Private methods -------------------
+static uint32_t Latency_CyclesToNs(uint32_t cycles)
+{
+  return (uint32_t)(((uint64_t)cycles * 1000U) / (SystemCoreClock / 1000000U));
+}
+
+/**
+ * @brief Adds a sample to a histogram. Called with the EXTI and CAN
+ * interrupts masked, or from them.
+ */
+static void Latency_Add(Latency_Stage_T stage, uint32_t ns)
+{
+  Latency_Histogram_T* h = &hist[stage];
+
+  uint8_t bin = (0 == ns) ? 0U : (uint8_t)(31U - __CLZ(ns));
+  if (bin >= LATENCY_HIST_BINS) {
+    bin = LATENCY_HIST_BINS - 1U;
+  }
+  h->bins[bin]++;
+
+  if ((0 == h->count) || (ns < h->minNs)) {
+    h->minNs = ns;
+  }
+  if (ns > h->maxNs) {
+    h->maxNs = ns;
+  }
+  h->totalNs += ns;
+  h->count++;
+}
+
+static void Latency_LogStage(Latency_Stage_T stage)
+{
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+  Latency_Histogram_T h;
+  Latency_GetHistogram(stage, &h);
+
+  uint32_t mean = (0 == h.count) ? 0U : (uint32_t)(h.totalNs / h.count);
+  snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "latency,%s,%lu,%lu,%lu,%lu\n",
+      stageNames[stage], h.count, h.minNs, mean, h.maxNs);
+  logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+
+  if (0 == h.count) {
+    return;
+  }
+
+  uint8_t first = 0;
+  while (0 == h.bins[first]) {
+    first++;
+  }
+  uint8_t last = LATENCY_HIST_BINS - 1U;
+  while (0 == h.bins[last]) {
+    last--;
+  }
+
+  int len = snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "latency_hist,%s,%u",
+      stageNames[stage], first);
+  uint8_t i;
+  for (i = first; (i <= last) && (len < LOGGING_DEFAULT_BUFF_LEN - 12); ++i) {
+    len += snprintf(&logBuffer[len], LOGGING_DEFAULT_BUFF_LEN - len, ",%lu", h.bins[i]);
+  }
+  snprintf(&logBuffer[len], LOGGING_DEFAULT_BUFF_LEN - len, "\n");
+  logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+}
+
+/**
+ * @brief Takes the task sample, and sends the frame for the CAN sample
+ */
+static void Latency_Measure(void)
+{
+  uint32_t now = CycleCounter_Get();
+
+  taskENTER_CRITICAL();
+  uint32_t isrNs = edgeIsrNs;
+  uint32_t taskNs = Latency_CyclesToNs(now - edgeCycles);
+  Latency_Add(LATENCY_STAGE_TASK, taskNs);
+  sample = LATENCY_SAMPLE_TX;
+  taskEXIT_CRITICAL();
+
+  uint8_t data[8];
+  memcpy(&data[0], &isrNs, 4U);
+  memcpy(&data[4], &taskNs, 4U);
+  CAN_Status_T status = CanTx_Send(canHandle, LATENCY_CAN_ID, data, 8);
+  if (CAN_STATUS_OK != status) {
+    taskENTER_CRITICAL();
+    stats.txFailed++;
+    sample = LATENCY_SAMPLE_IDLE;
+    taskEXIT_CRITICAL();
+  }
+}
+
+/**
+ * @brief Gives up on a frame that hasn't been sent, so the next edge is taken
+ */
+static void Latency_CheckTimeout(void)
+{
+  const uint32_t timeoutCycles = LATENCY_TX_TIMEOUT_MS * (SystemCoreClock / 1000U);
+
+  taskENTER_CRITICAL();
+  if ((LATENCY_SAMPLE_TX == sample) && (CycleCounter_Get() - edgeCycles > timeoutCycles)) {
+    stats.txFailed++;
+    sample = LATENCY_SAMPLE_IDLE;
+  }
+  taskEXIT_CRITICAL();
+}
+
+static void Latency_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Latency_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  const TickType_t reportTicks = LATENCY_REPORT_PERIOD_MS / portTICK_PERIOD_MS;
+  TickType_t lastReport = xTaskGetTickCount();
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up, from the loopback edge
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if ((notifiedValue > 0) && (LATENCY_SAMPLE_EDGE == sample)) {
+      // ready to process
+      Latency_Measure();
+    }
+    Latency_CheckTimeout();
+
+    if (xTaskGetTickCount() - lastReport >= reportTicks) {
+      lastReport += reportTicks;
+
+      uint8_t i;
+      for (i = 0; i < LATENCY_NUM_STAGES; ++i) {
+        Latency_LogStage((Latency_Stage_T)i);
+      }
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Latency_Status_T Latency_Init(Logging_T* logger, TIM_HandleTypeDef* htim, CAN_HandleTypeDef* hcan)
+{
+  log = logger;
+  logPrintS(log, "Latency_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  timerHandle = htim;
+  canHandle = hcan;
+  sample = LATENCY_SAMPLE_IDLE;
+  memset(hist, 0, sizeof(hist));
+  memset(&stats, 0, sizeof(Latency_Stats_T));
+
+  // APB1 timers run at twice PCLK1 while it is divided down
+  uint32_t timerClock = HAL_RCC_GetPCLK1Freq();
+  if (RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1)) {
+    timerClock *= 2U;
+  }
+  cyclesPerTick = SystemCoreClock / (timerClock / (timerHandle->Init.Prescaler + 1U));
+
+  // create main task
+  latencyTaskHandle = xTaskCreateStatic(
+      Latency_TaskMain,
+      "LatencyTask",
+      LATENCY_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      LATENCY_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Start toggling LATENCY_OUT
+  if (HAL_OK != HAL_TIM_OC_Start(timerHandle, TIM_CHANNEL_1)) {
+    return LATENCY_STATUS_ERROR;
+  }
+  initialized = true;
+
+  logPrintS(log, "Latency_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return LATENCY_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Latency_GetHistogram(Latency_Stage_T stage, Latency_Histogram_T* h)
+{
+  taskENTER_CRITICAL();
+  *h = hist[stage];
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Latency_GetStats(Latency_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Latency_Reset(void)
+{
+  taskENTER_CRITICAL();
+  memset(hist, 0, sizeof(hist));
+  memset(&stats, 0, sizeof(Latency_Stats_T));
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Latency_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (!initialized || (LATENCY_IN_Pin != GPIO_Pin)) {
+    return;
+  }
+
+  // The edge was at the compare match, this many timer counts ago
+  uint32_t now = CycleCounter_Get();
+  uint32_t counter = __HAL_TIM_GET_COUNTER(timerHandle);
+  uint32_t compare = __HAL_TIM_GET_COMPARE(timerHandle, TIM_CHANNEL_1);
+  uint32_t period = __HAL_TIM_GET_AUTORELOAD(timerHandle) + 1U;
+  uint32_t ticks = (counter + period - compare) % period;
+
+  stats.edges++;
+  if (LATENCY_SAMPLE_IDLE != sample) {
+    stats.missed++;
+    return;
+  }
+
+  uint32_t isrCycles = ticks * cyclesPerTick;
+  edgeCycles = now - isrCycles;
+  edgeIsrNs = Latency_CyclesToNs(isrCycles);
+  Latency_Add(LATENCY_STAGE_ISR, edgeIsrNs);
+  sample = LATENCY_SAMPLE_EDGE;
+
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(latencyTaskHandle, &higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+//------------------------------------------------------------------------------
+void Latency_TxComplete(CAN_HandleTypeDef* hcan, uint32_t mailbox)
+{
+  if ((hcan != canHandle) || (LATENCY_SAMPLE_TX != sample)) {
+    return;
+  }
+
+  const CAN_TxMailBox_TypeDef* tx = &hcan->Instance->sTxMailBox[mailbox];
+  if ((0 != (tx->TIR & CAN_TI0R_IDE)) ||
+      (LATENCY_CAN_ID != ((tx->TIR & CAN_TI0R_STID) >> CAN_TI0R_STID_Pos))) {
+    return;
+  }
+
+  Latency_Add(LATENCY_STAGE_CAN, Latency_CyclesToNs(CycleCounter_Get() - edgeCycles));
+  sample = LATENCY_SAMPLE_IDLE;
+}
@@ -0,0 +1,116 @@
+/*
+ * latency.h
+ *
+ * Interrupt and task latency measurement, from a timer edge looped back to an
+ * EXTI input.
+ *
+ * A timer toggles LATENCY_OUT in output compare mode, at a period that is not
+ * a multiple of the 1ms tick, so the edges fall at every phase of the control
+ * loop. LATENCY_OUT is wired to LATENCY_IN, an EXTI input at the same
+ * priority as the wheel speed sensors. The edge is timestamped by the timer
+ * itself, so each sample is measured from the true edge time:
+ *  - ISR:  edge to the EXTI callback
+ *  - Task: edge to the measuring task waking up
+ *  - CAN:  edge to the end of transmission of a frame sent by the task
+ *
+ * The task runs at the priority of the control processes, so its samples
+ * show the wake up latency they see. Each stage keeps a histogram with
+ * power of two bins: bin n counts samples from 2^n up to 2^(n+1) ns. The
+ * histograms are logged every 10s, in CSV:
+ *
+ *   latency,<stage>,<count>,<min>,<mean>,<max>
+ *   latency_hist,<stage>,<first bin>,<count>,<count>,...
+ *
+ * Times are in ns. Only the bins from the first to the last non empty one
+ * are logged. Without the loopback wire, no samples are taken.
+ *
+ * Only started in builds with ECU_ENABLE_LATENCY defined to 1, see
+ * initialize.h. Otherwise TIM3 is configured but never started.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef TIME_LATENCY_LATENCY_H_
+#define TIME_LATENCY_LATENCY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "stm32f7xx_hal.h"
+
+#include "lib/logging/logging.h"
+
+#define LATENCY_REPORT_PERIOD_MS  ((uint32_t) 10000U)
+
+#define LATENCY_HIST_BINS         ((uint8_t) 24U)   /* Last bin is 16.7ms and above */
+
+/* Frame sent on each edge, carrying the ISR and task latencies (ns) */
+#define LATENCY_CAN_ID            ((uint32_t) 0x7F0U)
+
+typedef enum
+{
+  LATENCY_STATUS_OK     = 0x00U,
+  LATENCY_STATUS_ERROR  = 0x01U
+} Latency_Status_T;
+
+typedef enum
+{
+  LATENCY_STAGE_ISR     = 0U,
+  LATENCY_STAGE_TASK    = 1U,
+  LATENCY_STAGE_CAN     = 2U,
+  LATENCY_NUM_STAGES    = 3U
+} Latency_Stage_T;
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t minNs;
+  uint32_t maxNs;
+  uint64_t totalNs;
+  uint32_t bins[LATENCY_HIST_BINS];
+} Latency_Histogram_T;
+
+typedef struct
+{
+  uint32_t edges;           /* Edges seen by the EXTI input */
+  uint32_t missed;          /* Edges dropped, the last one still in progress */
+  uint32_t txFailed;        /* Frames not queued, or not sent within 100ms */
+} Latency_Stats_T;
+
+/**
+ * @brief Initialize and start the measurement
+ * @param logger Pointer to system logger
+ * @param htim Timer driving LATENCY_OUT from channel 1
+ * @param hcan Bus to send the frame on
+ */
+Latency_Status_T Latency_Init(Logging_T* logger, TIM_HandleTypeDef* htim, CAN_HandleTypeDef* hcan);
+
+/**
+ * @brief Get the histogram of a stage
+ */
+void Latency_GetHistogram(Latency_Stage_T stage, Latency_Histogram_T* hist);
+
+/**
+ * @brief Get the measurement statistics
+ */
+void Latency_GetStats(Latency_Stats_T* stats);
+
+/**
+ * @brief Clear the histograms and statistics
+ */
+void Latency_Reset(void);
+
+/**
+ * @brief Loopback edge interrupt handler.
+ * Called from HAL_GPIO_EXTI_Callback.
+ * @param GPIO_Pin Pin that triggered the interrupt
+ */
+void Latency_EXTI_Callback(uint16_t GPIO_Pin);
+
+/**
+ * @brief Called from the CAN TX mailbox complete interrupts
+ */
+void Latency_TxComplete(CAN_HandleTypeDef* hcan, uint32_t mailbox);
+
+#endif /* TIME_LATENCY_LATENCY_H_ */
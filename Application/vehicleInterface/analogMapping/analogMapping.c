@@ -0,0 +1,96 @@
+/*
+ * analogMapping.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "analogMapping.h"
+
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+
+// ------------------- Private data -------------------
+#define MAPPING_VOLTS_PER_COUNT (ANALOG_VDDA_NOMINAL / (float)ANALOG_FULL_SCALE)
+
+/*
+ * 10k NTC (B 3435) to ground, 10k pull-up, as 0.1degC every 128 counts.
+ * Clamped to -40..150degC, which also covers open and short circuits.
+ */
+static const int16_t thermistorTable[] = {
+  1500, 1500, 1166,  981,  856,  761,  685,  620,
+   564,  514,  469,  427,  388,  352,  316,  283,
+   250,  218,  186,  155,  123,   92,   59,   25,
+   -10,  -47,  -87, -131, -181, -241, -317, -400,
+  -400
+};
+static const Map_Uniform1D_Q_T thermistorMap = MAP_UNIFORM1D_Q(0, 7U, thermistorTable);
+
+static const Analog_ChannelConfig_T channels[MAPPING_ADC_NUM_INPUTS] = {
+  [MAPPING_ADC_APPS1] = {
+    .name = "apps1",
+    .ratiometric = false,
+    .offset = 0,
+    .table = NULL,
+    .gain = MAPPING_VOLTS_PER_COUNT,
+  },
+  [MAPPING_ADC_APPS2] = {
+    .name = "apps2",
+    .ratiometric = false,
+    .offset = 0,
+    .table = NULL,
+    .gain = MAPPING_VOLTS_PER_COUNT,
+  },
+  [MAPPING_ADC_BRAKE] = {
+    .name = "brake",
+    .ratiometric = false,
+    .offset = 0,
+    .table = NULL,
+    .gain = MAPPING_VOLTS_PER_COUNT,
+  },
+  [MAPPING_ADC_TEMP1] = {
+    .name = "temp1",
+    .ratiometric = true,
+    .offset = 0,
+    .table = &thermistorMap,
+    .gain = 0.1f,
+  },
+  [MAPPING_ADC_TEMP2] = {
+    .name = "temp2",
+    .ratiometric = true,
+    .offset = 0,
+    .table = &thermistorMap,
+    .gain = 0.1f,
+  },
+};
+
+static const Analog_BiasConfig_T biases[] = {
+  {
+    .name = "adc1_pup",
+    .port = ADC1_PUP_GPIO_Port,
+    .pin = ADC1_PUP_Pin,
+    .normalParam = MAPPING_PARAM_ADC1_PUP,
+    .channels = MAPPING_ADC1_PUP_CHANNELS,
+  },
+  {
+    .name = "adc2_pup",
+    .port = ADC2_PUP_GPIO_Port,
+    .pin = ADC2_PUP_Pin,
+    .normalParam = MAPPING_PARAM_ADC2_PUP,
+    .channels = MAPPING_ADC2_PUP_CHANNELS,
+  },
+};
+
+// ------------------- Public methods -------------------
+const Analog_ChannelConfig_T* Mapping_GetAnalogChannels(uint8_t* numChannels)
+{
+  *numChannels = MAPPING_ADC_NUM_INPUTS;
+  return channels;
+}
+
+//------------------------------------------------------------------------------
+const Analog_BiasConfig_T* Mapping_GetAnalogBiases(uint8_t* numBiases)
+{
+  *numBiases = sizeof(biases) / sizeof(biases[0]);
+  return biases;
+}
@@ -0,0 +1,31 @@
+/*
+ * analogMapping.h
+ *
+ * Conversion of each analog input to engineering units, see device/analog.
+ *
+ *  - APPS1, APPS2, BRAKE: V at the ADC pin
+ *  - TEMP1, TEMP2: degC
+ *
+ * And the bias pins switched by the wiring diagnostics.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEINTERFACE_ANALOGMAPPING_ANALOGMAPPING_H_
+#define VEHICLEINTERFACE_ANALOGMAPPING_ANALOGMAPPING_H_
+
+#include <stdint.h>
+#include "device/analog/analog.h"
+
+/*
+ * Getter for the channel table, indexed by ADC channel
+ */
+const Analog_ChannelConfig_T* Mapping_GetAnalogChannels(uint8_t* numChannels);
+
+/*
+ * Getter for the bias pin table
+ */
+const Analog_BiasConfig_T* Mapping_GetAnalogBiases(uint8_t* numBiases);
+
+#endif /* VEHICLEINTERFACE_ANALOGMAPPING_ANALOGMAPPING_H_ */
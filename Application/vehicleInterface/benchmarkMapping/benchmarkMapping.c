@@ -0,0 +1,312 @@
+/*
+ * benchmarkMapping.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "benchmarkMapping.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "lib/map/map.h"
+#include "lib/crc/crc.h"
+#include "lib/filter/filter.h"
+#include "device/analog/analog.h"
+#include "device/inverter/inverter.h"
+#include "lib/logging/logging.h"
+
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/analogMapping/analogMapping.h"
+
+// ------------------- Private data -------------------
+/*
+ * Inputs and outputs are volatile, so the kernels can't be optimised away
+ */
+static volatile float input;
+static volatile int32_t inputQ;
+static volatile float output;
+static volatile uint32_t outputU32;
+
+static const float axisTable[] = {
+  0.0f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f, 256.0f
+};
+static const float valueTable[] = {
+  0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f
+};
+// The values don't affect the timing
+static const float surfaceTable[sizeof(axisTable) / sizeof(axisTable[0])][sizeof(axisTable) / sizeof(axisTable[0])];
+
+static const int16_t valueTableQ[] = {
+  0, 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000
+};
+static const Map_Uniform1D_T uniformMap = MAP_UNIFORM1D(0.0f, 0.1f, valueTable);
+static const Map_Uniform1D_Q_T uniformMapQ = MAP_UNIFORM1D_Q(0, 7U, valueTableQ);
+static const Map_Table1D_T tableMap = MAP_TABLE1D(axisTable, valueTable);
+static const Map_Table2D_T tableMap2D = {
+  .nx = sizeof(axisTable) / sizeof(axisTable[0]),
+  .x = axisTable,
+  .ny = sizeof(axisTable) / sizeof(axisTable[0]),
+  .y = axisTable,
+  .z = &surfaceTable[0][0],
+};
+static Map_Cache_T cacheX;
+static Map_Cache_T cacheY;
+
+// Parameter block sized data for the CRC unit
+#define MAPPING_CRC_WORDS 64U
+static uint32_t crcData[MAPPING_CRC_WORDS];
+
+// An inverter sized frame
+typedef struct
+{
+  int16_t speed;
+  int16_t torque;
+  uint16_t voltage;
+  uint8_t state;
+} Mapping_Frame_T;
+static Mapping_Frame_T frame;
+static uint8_t frameData[8];
+
+// A filter per ADC channel, over a whole scan
+#define MAPPING_FILTER_CHANNELS MAPPING_ADC_NUM_INPUTS
+#define MAPPING_FILTER_STAGES   2U
+static int16_t filterIn[MAPPING_FILTER_CHANNELS];
+static int16_t filterOut[MAPPING_FILTER_CHANNELS];
+
+static int16_t biquadCoeffs[MAPPING_FILTER_STAGES * FILTER_BIQUAD_COEFFS_Q15] __attribute__((aligned(4)));
+static int16_t biquadState[MAPPING_FILTER_CHANNELS][MAPPING_FILTER_STAGES * FILTER_BIQUAD_STATE] __attribute__((aligned(4)));
+static Filter_BiquadQ15_T biquads[MAPPING_FILTER_CHANNELS];
+
+static int32_t biquadCoeffsQ31[MAPPING_FILTER_STAGES * FILTER_BIQUAD_COEFFS];
+static int32_t biquadStateQ31[MAPPING_FILTER_STAGES * FILTER_BIQUAD_STATE];
+static const Filter_BiquadQ31_T biquadQ31 = {
+  .numStages = MAPPING_FILTER_STAGES,
+  .postShift = 1U,
+  .coeffs = biquadCoeffsQ31,
+  .state = biquadStateQ31,
+};
+static volatile int32_t outputI32;
+
+static int16_t lowPassAlpha[MAPPING_FILTER_CHANNELS];
+static int32_t lowPassState[MAPPING_FILTER_CHANNELS];
+static const Filter_LowPassQ15_T lowPass = {
+  .numChannels = MAPPING_FILTER_CHANNELS,
+  .alpha = lowPassAlpha,
+  .state = lowPassState,
+};
+
+#define MAPPING_MOVAVG_SHIFT 3U
+static uint32_t movingAverageHistory[FILTER_MOVAVG_PAIRS(MAPPING_FILTER_CHANNELS) << MAPPING_MOVAVG_SHIFT];
+static uint32_t movingAverageSums[FILTER_MOVAVG_PAIRS(MAPPING_FILTER_CHANNELS)];
+static Filter_MovingAverageQ15_T movingAverage = {
+  .numChannels = MAPPING_FILTER_CHANNELS,
+  .windowShift = MAPPING_MOVAVG_SHIFT,
+  .history = movingAverageHistory,
+  .sums = movingAverageSums,
+};
+
+static uint16_t analogRaw[MAPPING_ADC_NUM_INPUTS];
+static float analogValues[MAPPING_ADC_NUM_INPUTS];
+
+#define MAPPING_QUEUE_LENGTH 4U
+static StaticQueue_t queueBuffer;
+static uint8_t queueStorage[MAPPING_QUEUE_LENGTH * sizeof(frameData)];
+static QueueHandle_t queue;
+
+// ------------------- Private methods -------------------
+/*
+ * Inputs step through the table, so the lookups don't always hit the
+ * same segment
+ */
+static void Mapping_NextInput(void)
+{
+  float next = input + 0.37f;
+  input = (next > 1.0f) ? next - 1.0f : next;
+}
+
+static void Mapping_BenchMapUniform(void)
+{
+  Mapping_NextInput();
+  output = Map_Uniform1D(&uniformMap, input);
+}
+
+/*
+ * The same steps through the fixed point map's 0..1280 counts
+ */
+static void Mapping_BenchMapUniformQ(void)
+{
+  int32_t next = inputQ + 473;
+  inputQ = (next > 1280) ? next - 1280 : next;
+  outputU32 = (uint32_t)Map_Uniform1D_Q(&uniformMapQ, inputQ);
+}
+
+static void Mapping_BenchMapTable(void)
+{
+  Mapping_NextInput();
+  output = Map_Table1D(&tableMap, &cacheX, input * 256.0f);
+}
+
+static void Mapping_BenchMapTable2D(void)
+{
+  Mapping_NextInput();
+  output = Map_Table2D(&tableMap2D, &cacheX, &cacheY, input * 256.0f, (1.0f - input) * 256.0f);
+}
+
+static void Mapping_BenchCrc(void)
+{
+  outputU32 = Crc_Calculate(crcData, MAPPING_CRC_WORDS);
+}
+
+/*
+ * The inverter's own command encode and status decode, one of each per 1ms cycle
+ */
+static void Mapping_BenchCanPackUnpack(void)
+{
+  frame.speed++;
+  Inverter_Command_T command = {
+    .torque = (float)frame.speed * 0.01f,
+    .speedLimit = INVERTER_MAX_SPEED_RPM,
+  };
+  Inverter_EncodeCommand(&command, true, (uint8_t)frame.speed, frameData);
+
+  Inverter_Feedback_T feedback;
+  Inverter_DecodeStatus(frameData, &feedback);
+  output = feedback.motorSpeed + feedback.torqueActual;
+}
+
+static void Mapping_BenchLogEncode(void)
+{
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
+  frame.speed++;
+  outputU32 = (uint32_t)snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN,
+      "Inverter speed %d torque %d voltage %u\n", frame.speed, frame.torque, frame.voltage);
+}
+
+/*
+ * Filter inputs step like the ADC readings, in Q15
+ */
+static void Mapping_NextFilterInput(void)
+{
+  uint8_t i;
+  for (i = 0; i < MAPPING_FILTER_CHANNELS; ++i) {
+    filterIn[i] = (int16_t)(filterIn[i] + 1237 * (i + 1U));
+  }
+}
+
+static void Mapping_SetupFilters(void)
+{
+  // 50Hz low pass at the 1kHz control rate
+  float coeffs[FILTER_BIQUAD_COEFFS];
+  Filter_DesignLowPass(50.0f, 1000.0f, coeffs);
+
+  uint8_t stage;
+  for (stage = 0; stage < MAPPING_FILTER_STAGES; ++stage) {
+    Filter_CoeffsToQ15(coeffs, 1U, &biquadCoeffs[stage * FILTER_BIQUAD_COEFFS_Q15]);
+    Filter_CoeffsToQ31(coeffs, 1U, &biquadCoeffsQ31[stage * FILTER_BIQUAD_COEFFS]);
+  }
+
+  uint8_t i;
+  for (i = 0; i < MAPPING_FILTER_CHANNELS; ++i) {
+    biquads[i].numStages = MAPPING_FILTER_STAGES;
+    biquads[i].postShift = 1U;
+    biquads[i].coeffs = biquadCoeffs;
+    biquads[i].state = biquadState[i];
+    lowPassAlpha[i] = Filter_LowPassAlpha(50.0f, 0.001f);
+  }
+}
+
+static void Mapping_BenchBiquadQ15(void)
+{
+  Mapping_NextFilterInput();
+  Filter_BiquadQ15_Batch(biquads, MAPPING_FILTER_CHANNELS, filterIn, filterOut);
+}
+
+static void Mapping_BenchBiquadQ31(void)
+{
+  Mapping_NextFilterInput();
+  int32_t x = (int32_t)filterIn[0] * 65536;
+  int32_t y;
+  Filter_BiquadQ31(&biquadQ31, &x, &y, 1U);
+  outputI32 = y;
+}
+
+static void Mapping_BenchLowPass(void)
+{
+  Mapping_NextFilterInput();
+  Filter_LowPassQ15_Batch(&lowPass, filterIn, filterOut);
+}
+
+static void Mapping_BenchMovingAverage(void)
+{
+  Mapping_NextFilterInput();
+  Filter_MovingAverageQ15_Batch(&movingAverage, filterIn, filterOut);
+}
+
+static void Mapping_BenchAnalogConvert(void)
+{
+  // Readings step through the thermistor table
+  uint8_t i;
+  for (i = 0; i < MAPPING_ADC_NUM_INPUTS; ++i) {
+    analogRaw[i] = (uint16_t)((analogRaw[i] + 411U * (i + 1U)) & 0x0FFFU);
+  }
+
+  uint8_t numChannels;
+  const Analog_ChannelConfig_T* channels = Mapping_GetAnalogChannels(&numChannels);
+  Analog_Convert(channels, numChannels, analogRaw, 1500U, analogValues);
+}
+
+static void Mapping_SetupQueue(void)
+{
+  if (NULL == queue) {
+    queue = xQueueCreateStatic(MAPPING_QUEUE_LENGTH, sizeof(frameData), queueStorage, &queueBuffer);
+  }
+}
+
+static void Mapping_BenchQueue(void)
+{
+  uint8_t received[sizeof(frameData)];
+  xQueueSend(queue, frameData, 0);
+  xQueueReceive(queue, received, 0);
+}
+
+static void Mapping_BenchNotify(void)
+{
+  // Runs in the benchmark task, which only takes its notifications to
+  // wait for the timer, so one extra taken here is harmless
+  xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+  outputU32 = ulTaskNotifyTake(pdTRUE, 0);
+}
+
+/*
+ * Budgets are for the fastest iteration, at 200MHz with the caches on.
+ * Keep them about half again over the logged figures.
+ */
+static const Benchmark_T benchmarks[] = {
+  { "map_uniform1d",   NULL,                 Mapping_BenchMapUniform,     60U },
+  { "map_uniform1d_q", NULL,                 Mapping_BenchMapUniformQ,    50U },
+  { "map_table1d",     NULL,                 Mapping_BenchMapTable,       120U },
+  { "map_table2d",     NULL,                 Mapping_BenchMapTable2D,     300U },
+  { "crc32_256B",      NULL,                 Mapping_BenchCrc,            250U },
+  { "can_pack_unpack", NULL,                 Mapping_BenchCanPackUnpack,  200U },
+  { "biquad_q15_adc",  Mapping_SetupFilters, Mapping_BenchBiquadQ15,      400U },
+  { "biquad_q31",      Mapping_SetupFilters, Mapping_BenchBiquadQ31,      150U },
+  { "lowpass_q15_adc", Mapping_SetupFilters, Mapping_BenchLowPass,        120U },
+  { "movavg_q15_adc",  Mapping_SetupFilters, Mapping_BenchMovingAverage,  120U },
+  { "analog_convert",  NULL,                 Mapping_BenchAnalogConvert,  250U },
+  { "log_encode",      NULL,                 Mapping_BenchLogEncode,      4000U },
+  { "queue_send_recv", Mapping_SetupQueue,   Mapping_BenchQueue,          1500U },
+  { "task_notify",     NULL,                 Mapping_BenchNotify,         600U },
+};
+
+// ------------------- Public methods -------------------
+const Benchmark_T* Mapping_GetBenchmarks(uint8_t* numBenchmarks)
+{
+  *numBenchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+  return benchmarks;
+}
@@ -0,0 +1,22 @@
+/*
+ * benchmarkMapping.h
+ *
+ * The benchmark suite: kernels for the operations the control loops are
+ * built from, and their cycle budgets.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEINTERFACE_BENCHMARKMAPPING_BENCHMARKMAPPING_H_
+#define VEHICLEINTERFACE_BENCHMARKMAPPING_BENCHMARKMAPPING_H_
+
+#include <stdint.h>
+#include "time/benchmark/benchmark.h"
+
+/*
+ * Getter for the benchmark table
+ */
+const Benchmark_T* Mapping_GetBenchmarks(uint8_t* numBenchmarks);
+
+#endif /* VEHICLEINTERFACE_BENCHMARKMAPPING_BENCHMARKMAPPING_H_ */
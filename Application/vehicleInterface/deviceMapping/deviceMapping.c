@@ -10,11 +10,16 @@
 
 
 extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
 
 extern ADC_HandleTypeDef hadc1;
 extern DMA_HandleTypeDef hdma_adc1;
 
 extern CAN_HandleTypeDef hcan1;
+extern CAN_HandleTypeDef hcan2;
+extern CAN_HandleTypeDef hcan3;
+
+extern SPI_HandleTypeDef hspi4;
 
 extern RTC_HandleTypeDef hrtc;
 
@@ -25,6 +30,11 @@ TIM_HandleTypeDef* Mapping_GetTaskTimer(void)
   return &htim2;
 }
 
+TIM_HandleTypeDef* Mapping_GetLatencyTimer(void)
+{
+  return &htim3;
+}
+
 ADC_HandleTypeDef* Mapping_GetADC(void)
 {
   return &hadc1;
@@ -36,6 +46,16 @@ CAN_HandleTypeDef* Mapping_GetCAN1(void)
   return &hcan1;
 }
 
+CAN_HandleTypeDef* Mapping_GetCAN2(void)
+{
+  return &hcan2;
+}
+
+CAN_HandleTypeDef* Mapping_GetCAN3(void)
+{
+  return &hcan3;
+}
+
 
 UART_HandleTypeDef* Mapping_GetUART1(void)
 {
@@ -43,6 +63,12 @@ UART_HandleTypeDef* Mapping_GetUART1(void)
 }
 
 
+SPI_HandleTypeDef* Mapping_GetSPI4(void)
+{
+  return &hspi4;
+}
+
+
 RTC_HandleTypeDef* Mapping_GetRTC(void)
 {
   return &hrtc;
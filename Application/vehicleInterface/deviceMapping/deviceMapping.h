@@ -21,21 +21,92 @@
  * The ADC channels are read in the "rank" order defined in main.c
  * when the HAL library configures the ADC peripheral
  */
-#define MAPPING_ADC_NUM_CHANNELS  ((uint16_t) 5U)
+#define MAPPING_ADC_NUM_CHANNELS  ((uint16_t) 6U)
 #define MAPPING_ADC1_CHANNEL0     ((ADC_Channel_T) 0U)
 #define MAPPING_ADC1_CHANNEL1     ((ADC_Channel_T) 1U)
 #define MAPPING_ADC1_CHANNEL2     ((ADC_Channel_T) 2U)
 #define MAPPING_ADC1_CHANNEL3     ((ADC_Channel_T) 3U)
 #define MAPPING_ADC1_CHANNEL4     ((ADC_Channel_T) 4U)
+#define MAPPING_ADC1_VREFINT      ((ADC_Channel_T) 5U)  /* Internal reference, for the supply voltage */
+
+/*
+ * External inputs, before VREFINT. Converted to engineering units by
+ * device/analog, see analogMapping.
+ */
+#define MAPPING_ADC_NUM_INPUTS    ((uint8_t) 5U)
+
+/*
+ * Pedal sensors
+ */
+#define MAPPING_ADC_APPS1         MAPPING_ADC1_CHANNEL0
+#define MAPPING_ADC_APPS2         MAPPING_ADC1_CHANNEL1
+#define MAPPING_ADC_BRAKE         MAPPING_ADC1_CHANNEL2
+
+/*
+ * Channels biased by each bias pin of the pedal sensor inputs, for the wiring
+ * diagnostics in device/analog. The two APPS channels are on different pins,
+ * so they are never both under test.
+ */
+#define MAPPING_ADC1_PUP_CHANNELS ((1UL << MAPPING_ADC_APPS1) | (1UL << MAPPING_ADC_BRAKE))
+#define MAPPING_ADC2_PUP_CHANNELS (1UL << MAPPING_ADC_APPS2)
+
+/*
+ * Thermistors, 10k NTC to ground with a 10k pull-up to VDDA
+ */
+#define MAPPING_ADC_TEMP1         MAPPING_ADC1_CHANNEL3
+#define MAPPING_ADC_TEMP2         MAPPING_ADC1_CHANNEL4
+
+/*
+ * CAN buses
+ *  - CAN1: powertrain (inverter, dashboard, diagnostics)
+ *  - CAN2: chassis
+ *  - CAN3: data logger
+ * Frames are bridged between them by comm/gateway, see gatewayMapping.
+ */
+
+/*
+ * Latency loopback: LATENCY_OUT (TIM3 CH1) wired to LATENCY_IN (EXTI),
+ * see time/latency
+ */
+
+/*
+ * Interrupts that call the RTOS, with their NVIC priorities from the .ioc.
+ * time/deferred checks them against the RTOS syscall limit when building,
+ * and against the NVIC at start up. Keep in step with the .ioc.
+ */
+#define MAPPING_RTOS_IRQS(IRQ) \
+  IRQ(TIM2_IRQn,          5U) \
+  IRQ(CAN1_TX_IRQn,       6U) \
+  IRQ(CAN1_RX0_IRQn,      6U) \
+  IRQ(CAN1_RX1_IRQn,      6U) \
+  IRQ(CAN2_TX_IRQn,       6U) \
+  IRQ(CAN2_RX0_IRQn,      6U) \
+  IRQ(CAN2_RX1_IRQn,      6U) \
+  IRQ(CAN3_TX_IRQn,       6U) \
+  IRQ(CAN3_RX0_IRQn,      6U) \
+  IRQ(CAN3_RX1_IRQn,      6U) \
+  IRQ(EXTI9_5_IRQn,       6U) \
+  IRQ(EXTI15_10_IRQn,     6U) \
+  IRQ(DMA2_Stream0_IRQn,  6U) \
+  IRQ(DMA2_Stream2_IRQn,  6U) \
+  IRQ(DMA2_Stream3_IRQn,  6U) \
+  IRQ(DMA2_Stream4_IRQn,  6U) \
+  IRQ(DMA2_Stream7_IRQn,  6U) \
+  IRQ(SPI4_IRQn,          6U) \
+  IRQ(USART1_IRQn,        6U)
 
 /*
  * Getters for device handles
  */
 
 TIM_HandleTypeDef* Mapping_GetTaskTimer(void);
+TIM_HandleTypeDef* Mapping_GetLatencyTimer(void);
 ADC_HandleTypeDef* Mapping_GetADC(void);
 CAN_HandleTypeDef* Mapping_GetCAN1(void);
+CAN_HandleTypeDef* Mapping_GetCAN2(void);
+CAN_HandleTypeDef* Mapping_GetCAN3(void);
 UART_HandleTypeDef* Mapping_GetUART1(void);
+SPI_HandleTypeDef* Mapping_GetSPI4(void);
 RTC_HandleTypeDef* Mapping_GetRTC(void);
 
 #endif /* VEHICLEINTERFACE_DEVICEMAPPING_DEVICEMAPPING_H_ */
@@ -0,0 +1,250 @@
+/*
+ * diagMapping.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "diagMapping.h"
+
+#include <string.h>
+
+#include "stm32f7xx_hal.h"
+
+#include "comm/canStats/canStats.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "device/wheelspeed/wheelspeed.h"
+#include "device/inverter/inverter.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+#include "vehicleProcesses/tractionControl/tractionControl.h"
+
+// ------------------- Private methods -------------------
+static void Mapping_PutU16(uint8_t* out, uint16_t value)
+{
+  out[0] = (uint8_t)(value >> 8);
+  out[1] = (uint8_t)value;
+}
+
+/**
+ * @brief Scales and saturates a value to 16 bits
+ */
+static uint16_t Mapping_ScaleU16(float value, float scale)
+{
+  float scaled = value * scale + 0.5f;
+  return (scaled <= 0.0f) ? 0U : ((scaled >= 65535.0f) ? 65535U : (uint16_t)scaled);
+}
+
+static uint16_t Mapping_ScaleI16(float value, float scale)
+{
+  float scaled = value * scale;
+  int16_t result = (scaled <= -32768.0f) ? INT16_MIN :
+                   ((scaled >= 32767.0f) ? INT16_MAX : (int16_t)scaled);
+  return (uint16_t)result;
+}
+
+static void Mapping_ReadEcuSerial(uint8_t* out)
+{
+  memcpy(out, (const void*)UID_BASE, 12U);
+}
+
+static void Mapping_ReadSwVersion(uint8_t* out)
+{
+  memcpy(out, MAPPING_SW_VERSION, 8U);
+}
+
+static void Mapping_ReadVehicleState(uint8_t* out)
+{
+  out[0] = (uint8_t)VehicleState_Get();
+}
+
+static void Mapping_ReadPedals(uint8_t* out)
+{
+  Pedals_Output_T pedals;
+  Pedals_GetOutput(&pedals);
+
+  out[0] = (uint8_t)Mapping_ScaleU16(pedals.appsPosition, 200.0f);
+  out[1] = (uint8_t)Mapping_ScaleU16(pedals.brakePosition, 200.0f);
+  Mapping_PutU16(&out[2], Mapping_ScaleI16(pedals.torqueRequest, 10.0f));
+  Mapping_PutU16(&out[4], pedals.faults);
+}
+
+static void Mapping_ReadInverter(uint8_t* out)
+{
+  Inverter_Feedback_T feedback;
+  Inverter_GetFeedback(&feedback);
+
+  Mapping_PutU16(&out[0], Mapping_ScaleI16(feedback.motorSpeed, 1.0f));
+  Mapping_PutU16(&out[2], Mapping_ScaleI16(feedback.torqueActual, 10.0f));
+  Mapping_PutU16(&out[4], Mapping_ScaleU16(feedback.dcVoltage, 10.0f));
+  out[6] = (feedback.state & 0x3FU) | (feedback.faulted ? 0x40U : 0U) | (feedback.valid ? 0x80U : 0U);
+}
+
+static void Mapping_ReadWheelSpeedFront(uint8_t* out)
+{
+  WheelSpeed_Data_T data;
+  WheelSpeed_Get(&data);
+
+  Mapping_PutU16(&out[0], Mapping_ScaleU16(data.speed[WHEELSPEED_FL], 100.0f));
+  Mapping_PutU16(&out[2], Mapping_ScaleU16(data.speed[WHEELSPEED_FR], 100.0f));
+}
+
+static void Mapping_ReadWheelSpeedRear(uint8_t* out)
+{
+  WheelSpeed_Data_T data;
+  WheelSpeed_Get(&data);
+
+  Mapping_PutU16(&out[0], Mapping_ScaleU16(data.speed[WHEELSPEED_RL], 100.0f));
+  Mapping_PutU16(&out[2], Mapping_ScaleU16(data.speed[WHEELSPEED_RR], 100.0f));
+}
+
+static void Mapping_ReadTractionControl(uint8_t* out)
+{
+  TractionControl_Output_T output;
+  TractionControl_GetOutput(&output);
+
+  Mapping_PutU16(&out[0], Mapping_ScaleI16(output.slip, 1000.0f));
+  Mapping_PutU16(&out[2], Mapping_ScaleI16(output.torqueLimit, 10.0f));
+  out[4] = output.active ? 1U : 0U;
+}
+
+static void Mapping_ReadCanStats(CAN_HandleTypeDef* hcan, uint8_t* out)
+{
+  CanStats_Bus_T stats;
+  if (CANSTATS_STATUS_OK != CanStats_Get(hcan, &stats)) {
+    memset(out, 0xFF, 5U);
+    return;
+  }
+
+  out[0] = (uint8_t)Mapping_ScaleU16(stats.load, 200.0f);
+  out[1] = (uint8_t)Mapping_ScaleU16(stats.peakLoad, 200.0f);
+  out[2] = stats.tec;
+  out[3] = stats.rec;
+  out[4] = (uint8_t)((stats.state << 4) | (stats.lastError & 0x0FU));
+}
+
+static void Mapping_ReadCan1Stats(uint8_t* out)
+{
+  Mapping_ReadCanStats(Mapping_GetCAN1(), out);
+}
+
+static void Mapping_ReadCan2Stats(uint8_t* out)
+{
+  Mapping_ReadCanStats(Mapping_GetCAN2(), out);
+}
+
+static void Mapping_ReadCan3Stats(uint8_t* out)
+{
+  Mapping_ReadCanStats(Mapping_GetCAN3(), out);
+}
+
+/*
+ * DTC tests
+ */
+static bool Mapping_TestApps1Range(void)
+{
+  Pedals_Output_T pedals;
+  Pedals_GetOutput(&pedals);
+  return 0 != (pedals.faults & PEDALS_FAULT_APPS1_RANGE);
+}
+
+static bool Mapping_TestApps2Range(void)
+{
+  Pedals_Output_T pedals;
+  Pedals_GetOutput(&pedals);
+  return 0 != (pedals.faults & PEDALS_FAULT_APPS2_RANGE);
+}
+
+static bool Mapping_TestAppsDisagree(void)
+{
+  Pedals_Output_T pedals;
+  Pedals_GetOutput(&pedals);
+  return 0 != (pedals.faults & PEDALS_FAULT_APPS_DISAGREE);
+}
+
+static bool Mapping_TestBrakeRange(void)
+{
+  Pedals_Output_T pedals;
+  Pedals_GetOutput(&pedals);
+  return 0 != (pedals.faults & PEDALS_FAULT_BRAKE_RANGE);
+}
+
+static bool Mapping_TestBrakeApps(void)
+{
+  Pedals_Output_T pedals;
+  Pedals_GetOutput(&pedals);
+  return 0 != (pedals.faults & PEDALS_FAULT_BRAKE_APPS);
+}
+
+static bool Mapping_TestInverterLost(void)
+{
+  // The inverter is only powered once HV is requested
+  if (VEHICLESTATE_LV_ON == VehicleState_Get()) {
+    return false;
+  }
+
+  Inverter_Feedback_T feedback;
+  Inverter_GetFeedback(&feedback);
+  return !feedback.valid;
+}
+
+static bool Mapping_TestInverterFault(void)
+{
+  Inverter_Feedback_T feedback;
+  Inverter_GetFeedback(&feedback);
+  return feedback.valid && feedback.faulted;
+}
+
+/*
+ * Reset and reprogramming only with HV off
+ */
+static bool Mapping_ResetAllowed(void)
+{
+  return VEHICLESTATE_LV_ON == VehicleState_Get();
+}
+
+// ------------------- Private data -------------------
+static const Uds_Did_T dids[] = {
+  { MAPPING_DID_ECU_SERIAL,       12U, Mapping_ReadEcuSerial },
+  { MAPPING_DID_SW_VERSION,       8U,  Mapping_ReadSwVersion },
+  { MAPPING_DID_VEHICLE_STATE,    1U,  Mapping_ReadVehicleState },
+  { MAPPING_DID_PEDALS,           6U,  Mapping_ReadPedals },
+  { MAPPING_DID_INVERTER,         7U,  Mapping_ReadInverter },
+  { MAPPING_DID_WHEELSPEED_FRONT, 4U,  Mapping_ReadWheelSpeedFront },
+  { MAPPING_DID_WHEELSPEED_REAR,  4U,  Mapping_ReadWheelSpeedRear },
+  { MAPPING_DID_TRACTION_CONTROL, 5U,  Mapping_ReadTractionControl },
+  { MAPPING_DID_CAN1_STATS,       5U,  Mapping_ReadCan1Stats },
+  { MAPPING_DID_CAN2_STATS,       5U,  Mapping_ReadCan2Stats },
+  { MAPPING_DID_CAN3_STATS,       5U,  Mapping_ReadCan3Stats },
+};
+
+static const Uds_Dtc_T dtcs[] = {
+  { 0x212300U, Mapping_TestApps1Range },    /* P2123 APPS1 circuit */
+  { 0x212800U, Mapping_TestApps2Range },    /* P2128 APPS2 circuit */
+  { 0x213500U, Mapping_TestAppsDisagree },  /* P2135 APPS1/APPS2 correlation */
+  { 0x057100U, Mapping_TestBrakeRange },    /* P0571 Brake sensor circuit */
+  { 0x229900U, Mapping_TestBrakeApps },     /* P2299 Brake/accelerator pedal incompatible */
+  { 0xC29300U, Mapping_TestInverterLost },  /* U0293 Lost communication with inverter */
+  { 0x0A7800U, Mapping_TestInverterFault }, /* P0A78 Inverter performance */
+};
+
+static const Uds_Config_T udsConfig = {
+  .dids = dids,
+  .numDids = sizeof(dids) / sizeof(dids[0]),
+  .dtcs = dtcs,
+  .numDtcs = sizeof(dtcs) / sizeof(dtcs[0]),
+  .resetAllowed = Mapping_ResetAllowed,
+};
+
+// ------------------- Public methods -------------------
+const Uds_Config_T* Mapping_GetUdsConfig(void)
+{
+  return &udsConfig;
+}
+
+//------------------------------------------------------------------------------
+bool Mapping_CalStoreAllowed(void)
+{
+  // HV off, as for a reset. The sector erase stalls the CPU for up to seconds.
+  return Mapping_ResetAllowed();
+}
@@ -0,0 +1,51 @@
+/*
+ * diagMapping.h
+ *
+ * Diagnostic data identifiers and trouble codes served over UDS.
+ *
+ * DIDs 0xF2xx are live data and may be read periodically (0x2A) with the
+ * low byte as the periodic identifier. Multi-byte values are big endian.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEINTERFACE_DIAGMAPPING_DIAGMAPPING_H_
+#define VEHICLEINTERFACE_DIAGMAPPING_DIAGMAPPING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "comm/uds/uds.h"
+
+/*
+ * Identification
+ */
+#define MAPPING_DID_ECU_SERIAL        ((uint16_t) 0xF18CU)  /* 12 bytes, MCU unique ID */
+#define MAPPING_DID_SW_VERSION        ((uint16_t) 0xF195U)  /* 8 bytes, ASCII */
+
+/*
+ * Live data
+ */
+#define MAPPING_DID_VEHICLE_STATE     ((uint16_t) 0xF200U)  /* u8 VehicleState_State_T */
+#define MAPPING_DID_PEDALS            ((uint16_t) 0xF201U)  /* u8 APPS 0.5%, u8 brake 0.5%, i16 torque request 0.1Nm, u16 faults */
+#define MAPPING_DID_INVERTER          ((uint16_t) 0xF202U)  /* i16 speed rpm, i16 torque 0.1Nm, u16 DC voltage 0.1V, u8 [7] valid [6] faulted [5:0] state */
+#define MAPPING_DID_WHEELSPEED_FRONT  ((uint16_t) 0xF203U)  /* u16 left, u16 right, 0.01m/s */
+#define MAPPING_DID_WHEELSPEED_REAR   ((uint16_t) 0xF204U)  /* u16 left, u16 right, 0.01m/s */
+#define MAPPING_DID_TRACTION_CONTROL  ((uint16_t) 0xF205U)  /* i16 slip 0.001, i16 torque limit 0.1Nm, u8 active */
+#define MAPPING_DID_CAN1_STATS        ((uint16_t) 0xF206U)  /* u8 load 0.5%, u8 peak load 0.5%, u8 TEC, u8 REC, u8 [7:4] error state [3:0] last error */
+#define MAPPING_DID_CAN2_STATS        ((uint16_t) 0xF207U)  /* As CAN1 */
+#define MAPPING_DID_CAN3_STATS        ((uint16_t) 0xF208U)  /* As CAN1 */
+
+#define MAPPING_SW_VERSION            "VCU 0.1 "
+
+/*
+ * Getter for the UDS server configuration
+ */
+const Uds_Config_T* Mapping_GetUdsConfig(void);
+
+/*
+ * Whether the parameters may be stored to flash, for XCP
+ */
+bool Mapping_CalStoreAllowed(void);
+
+#endif /* VEHICLEINTERFACE_DIAGMAPPING_DIAGMAPPING_H_ */
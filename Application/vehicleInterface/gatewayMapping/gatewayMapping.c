@@ -0,0 +1,39 @@
+/*
+ * gatewayMapping.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "gatewayMapping.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+
+// ------------------- Private data -------------------
+#define MAPPING_GATEWAY_NUM_ROUTES 3U
+
+static Gateway_Route_T routes[MAPPING_GATEWAY_NUM_ROUTES];
+
+static const Gateway_Config_T gatewayConfig = {
+  .routes = routes,
+  .numRoutes = MAPPING_GATEWAY_NUM_ROUTES,
+};
+
+// ------------------- Public methods -------------------
+const Gateway_Config_T* Mapping_GetGatewayConfig(void)
+{
+  CAN_HandleTypeDef* powertrain = Mapping_GetCAN1();
+  CAN_HandleTypeDef* chassis = Mapping_GetCAN2();
+  CAN_HandleTypeDef* logger = Mapping_GetCAN3();
+
+  /*
+   * Source IDs must not be ones the VCU receives itself on the source bus
+   */
+  // BMS pack limits from the chassis bus, for the inverter
+  routes[0] = (Gateway_Route_T){ .src = chassis, .dst = powertrain, .srcId = 0x6B0U, .dstId = 0x6B0U, .minIntervalMs = 0U };
+  // Inverter temperatures to the chassis bus (dashboard), at a reduced rate
+  routes[1] = (Gateway_Route_T){ .src = powertrain, .dst = chassis, .srcId = 0x182U, .dstId = 0x482U, .minIntervalMs = 100U };
+  // and to the logger at full rate
+  routes[2] = (Gateway_Route_T){ .src = powertrain, .dst = logger, .srcId = 0x182U, .dstId = 0x182U, .minIntervalMs = 0U };
+
+  return &gatewayConfig;
+}
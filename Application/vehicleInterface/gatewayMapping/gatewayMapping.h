@@ -0,0 +1,23 @@
+/*
+ * gatewayMapping.h
+ *
+ * Frames bridged between the CAN buses.
+ *
+ * The powertrain bus (CAN1) carries the 1ms inverter traffic. Only the
+ * signals other buses need are forwarded off it, at the rate they need them.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEINTERFACE_GATEWAYMAPPING_GATEWAYMAPPING_H_
+#define VEHICLEINTERFACE_GATEWAYMAPPING_GATEWAYMAPPING_H_
+
+#include "comm/gateway/gateway.h"
+
+/*
+ * Getter for the gateway routing table
+ */
+const Gateway_Config_T* Mapping_GetGatewayConfig(void);
+
+#endif /* VEHICLEINTERFACE_GATEWAYMAPPING_GATEWAYMAPPING_H_ */
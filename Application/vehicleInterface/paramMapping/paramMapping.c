@@ -0,0 +1,22 @@
+/*
+ * paramMapping.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "paramMapping.h"
+
+// ------------------- Private data -------------------
+static const ParamStore_Value_T paramDefaults[MAPPING_PARAM_NUM_PARAMS] = {
+  [MAPPING_PARAM_EXAMPLE_PERIOD_MS] = { .u32 = 1000U },
+  [MAPPING_PARAM_EXAMPLE_CAN_ID]    = { .u32 = 0x5A1U },
+  [MAPPING_PARAM_ADC1_PUP]          = { .u32 = 0U },
+  [MAPPING_PARAM_ADC2_PUP]          = { .u32 = 1U },
+};
+
+// ------------------- Public methods -------------------
+const ParamStore_Value_T* Mapping_GetParamDefaults(void)
+{
+  return paramDefaults;
+}
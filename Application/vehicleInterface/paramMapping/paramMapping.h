@@ -0,0 +1,34 @@
+/*
+ * paramMapping.h
+ *
+ * Calibration parameter IDs and their defaults.
+ *
+ * New parameters must be added to the end of the list, so IDs saved to
+ * flash by earlier firmware keep their meaning.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEINTERFACE_PARAMMAPPING_PARAMMAPPING_H_
+#define VEHICLEINTERFACE_PARAMMAPPING_PARAMMAPPING_H_
+
+#include <stdint.h>
+#include "lib/paramStore/paramStore.h"
+
+typedef enum
+{
+  MAPPING_PARAM_EXAMPLE_PERIOD_MS = 0,  /* u32: example process period, applied at boot */
+  MAPPING_PARAM_EXAMPLE_CAN_ID,         /* u32: example process status frame ID */
+  MAPPING_PARAM_ADC1_PUP,               /* u32: ADC1_PUP pin normal state, 0 => pull up, 1 => pull down. Applied at boot */
+  MAPPING_PARAM_ADC2_PUP,               /* u32: ADC2_PUP pin normal state, 0 => pull up, 1 => pull down. Applied at boot */
+
+  MAPPING_PARAM_NUM_PARAMS
+} Mapping_Param_T;
+
+/*
+ * Getter for the default parameter values, indexed by Mapping_Param_T
+ */
+const ParamStore_Value_T* Mapping_GetParamDefaults(void);
+
+#endif /* VEHICLEINTERFACE_PARAMMAPPING_PARAMMAPPING_H_ */
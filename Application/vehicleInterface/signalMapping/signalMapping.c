@@ -0,0 +1,44 @@
+/*
+ * signalMapping.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "signalMapping.h"
+
+#include "device/wheelspeed/wheelspeed.h"
+#include "device/inverter/inverter.h"
+#include "device/analog/analog.h"
+#include "vehicleProcesses/pedals/pedals.h"
+
+// ------------------- Private data -------------------
+static const SignalDb_GroupConfig_T groups[MAPPING_SIGNAL_NUM_GROUPS] = {
+  [MAPPING_SIGNAL_GROUP_WHEELSPEED] = {
+    .name = "wheelspeed",
+    .periodMs = WHEELSPEED_PERIOD_MS,
+    .numSignals = MAPPING_SIGNAL_WHEELSPEED_NUM,
+  },
+  [MAPPING_SIGNAL_GROUP_PEDALS] = {
+    .name = "pedals",
+    .periodMs = PEDALS_PERIOD_MS,
+    .numSignals = MAPPING_SIGNAL_PEDALS_NUM,
+  },
+  [MAPPING_SIGNAL_GROUP_INVERTER] = {
+    .name = "inverter",
+    .periodMs = INVERTER_PERIOD_MS,
+    .numSignals = MAPPING_SIGNAL_INVERTER_NUM,
+  },
+  [MAPPING_SIGNAL_GROUP_ANALOG] = {
+    .name = "analog",
+    .periodMs = ANALOG_PERIOD_MS,
+    .numSignals = MAPPING_SIGNAL_ANALOG_NUM,
+  },
+};
+
+// ------------------- Public methods -------------------
+const SignalDb_GroupConfig_T* Mapping_GetSignalGroups(uint8_t* numGroups)
+{
+  *numGroups = MAPPING_SIGNAL_NUM_GROUPS;
+  return groups;
+}
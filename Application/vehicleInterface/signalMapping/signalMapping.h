@@ -0,0 +1,72 @@
+/*
+ * signalMapping.h
+ *
+ * Signal database groups and signals. Each group has one writer, named
+ * below, and is published once per period of that writer.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEINTERFACE_SIGNALMAPPING_SIGNALMAPPING_H_
+#define VEHICLEINTERFACE_SIGNALMAPPING_SIGNALMAPPING_H_
+
+#include <stdint.h>
+#include "lib/signalDb/signalDb.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+
+typedef enum
+{
+  MAPPING_SIGNAL_GROUP_WHEELSPEED = 0,  /* 1ms, device/wheelspeed */
+  MAPPING_SIGNAL_GROUP_PEDALS,          /* 1ms, vehicleProcesses/pedals */
+  MAPPING_SIGNAL_GROUP_INVERTER,        /* 1ms, device/inverter */
+  MAPPING_SIGNAL_GROUP_ANALOG,          /* 1ms, device/analog */
+
+  MAPPING_SIGNAL_NUM_GROUPS
+} Mapping_SignalGroup_T;
+
+/*
+ * Wheel speeds, wheel surface speed (m/s)
+ */
+#define MAPPING_SIGNAL_WHEELSPEED_FL      SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_WHEELSPEED, 0U)
+#define MAPPING_SIGNAL_WHEELSPEED_FR      SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_WHEELSPEED, 1U)
+#define MAPPING_SIGNAL_WHEELSPEED_RL      SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_WHEELSPEED, 2U)
+#define MAPPING_SIGNAL_WHEELSPEED_RR      SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_WHEELSPEED, 3U)
+#define MAPPING_SIGNAL_WHEELSPEED_NUM     ((uint8_t) 4U)
+
+/*
+ * Pedals, invalid while the sensors they come from are faulted
+ */
+#define MAPPING_SIGNAL_APPS_POSITION      SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_PEDALS, 0U)  /* 0..1 */
+#define MAPPING_SIGNAL_BRAKE_POSITION     SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_PEDALS, 1U)  /* 0..1 */
+#define MAPPING_SIGNAL_BRAKE_PRESSED      SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_PEDALS, 2U)  /* 0 or 1 */
+#define MAPPING_SIGNAL_TORQUE_REQUEST     SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_PEDALS, 3U)  /* Nm */
+#define MAPPING_SIGNAL_PEDAL_FAULTS       SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_PEDALS, 4U)  /* PEDALS_FAULT_* flags, always valid */
+#define MAPPING_SIGNAL_PEDALS_NUM         ((uint8_t) 5U)
+
+/*
+ * Inverter feedback, invalid while the status frame is stale
+ */
+#define MAPPING_SIGNAL_MOTOR_SPEED        SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_INVERTER, 0U)  /* rpm */
+#define MAPPING_SIGNAL_MOTOR_TORQUE       SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_INVERTER, 1U)  /* Nm */
+#define MAPPING_SIGNAL_DC_VOLTAGE         SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_INVERTER, 2U)  /* V */
+#define MAPPING_SIGNAL_INVERTER_FAULTED   SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_INVERTER, 3U)  /* 0 or 1 */
+#define MAPPING_SIGNAL_INVERTER_NUM       ((uint8_t) 4U)
+
+/*
+ * Analog inputs, indexed by ADC channel, in the units given in analogMapping.
+ * Inputs measuring an absolute voltage are invalid while the supply is.
+ * Then the wiring health of each, always valid.
+ */
+#define MAPPING_SIGNAL_ANALOG(channel)    SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_ANALOG, (channel))
+#define MAPPING_SIGNAL_VDDA               MAPPING_SIGNAL_ANALOG(MAPPING_ADC1_VREFINT)  /* V */
+#define MAPPING_SIGNAL_ANALOG_HEALTH(channel) \
+  SIGNALDB_SIGNAL(MAPPING_SIGNAL_GROUP_ANALOG, MAPPING_ADC_NUM_CHANNELS + (channel))  /* Analog_Health_T */
+#define MAPPING_SIGNAL_ANALOG_NUM         ((uint8_t) (2U * MAPPING_ADC_NUM_CHANNELS))
+
+/*
+ * Getter for the group table, indexed by Mapping_SignalGroup_T
+ */
+const SignalDb_GroupConfig_T* Mapping_GetSignalGroups(uint8_t* numGroups);
+
+#endif /* VEHICLEINTERFACE_SIGNALMAPPING_SIGNALMAPPING_H_ */
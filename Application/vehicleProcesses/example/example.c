@@ -15,12 +15,17 @@
 #include "stm32f7xx_hal.h"
 
 #include "comm/can/can.h"
+#include "comm/canTx/canTx.h"
+#include "comm/canMonitor/canMonitor.h"
 #include "comm/uart/uart.h"
-#include "io/adc/adc.h"
 #include "time/tasktimer/tasktimer.h"
 #include "time/rtc/rtc.h"
+#include "time/deferred/deferred.h"
+#include "lib/paramStore/paramStore.h"
 
 #include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
 
 // ------------------- Private data -------------------
 static Logging_T* log;
@@ -28,6 +33,9 @@ static Logging_T* log;
 static unsigned int count = 0;
 
 #define EX_STACK_SIZE 2000
+
+// Longest period the task timer divider holds
+#define EX_PERIOD_MAX_MS (UINT16_MAX / TASKTIMER_BASE_PERIOD_MS)
 static StaticTask_t taskBuffer;
 static StackType_t taskStack[EX_STACK_SIZE];
 
@@ -46,7 +54,29 @@ static RTC_HandleTypeDef* rtcHandle;
 // RTC data
 static RTC_DateTime_T rtcDateTime;
 
+// Freshness of the 0x3A1 message
+static CanMonitor_Handle_T canMonitor;
+
+// Received data is logged outside the interrupts
+static Deferred_Source_T canSource;
+static Deferred_Source_T uartSource;
+
+// Analog inputs sent on the CAN bus
+static const SignalDb_Signal_T analogSignals[MAPPING_ADC_NUM_INPUTS] = {
+  MAPPING_SIGNAL_ANALOG(MAPPING_ADC1_CHANNEL0),
+  MAPPING_SIGNAL_ANALOG(MAPPING_ADC1_CHANNEL1),
+  MAPPING_SIGNAL_ANALOG(MAPPING_ADC1_CHANNEL2),
+  MAPPING_SIGNAL_ANALOG(MAPPING_ADC1_CHANNEL3),
+  MAPPING_SIGNAL_ANALOG(MAPPING_ADC1_CHANNEL4),
+};
+
 // ------------------- Private methods -------------------
+static inline int16_t Example_ToHundredths(float value)
+{
+  float scaled = value * 100.0f;
+  return (scaled > 32767.0f) ? 32767 : ((scaled < -32768.0f) ? -32768 : (int16_t)scaled);
+}
+
 static void Example_TaskMain(void* pvParameters)
 {
   logPrintS(log, "Example_TaskMain complete\n", LOGGING_DEFAULT_BUFF_LEN);
@@ -60,6 +90,7 @@ static void Example_TaskMain(void* pvParameters)
     notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
     if (notifiedValue > 0) {
       // ready to process
+      const ParamStore_Value_T* params = ParamStore_Get();
 
       HAL_GPIO_TogglePin(LED_STATUS_GPIO_Port, LED_STATUS_Pin);
 
@@ -73,14 +104,16 @@ static void Example_TaskMain(void* pvParameters)
       TxData[5] = 0xAF;
 
       /* Start the Transmission process */
-      CAN_SendMessage(canHandle, 0x5A1, TxData, 8);
+      CanTx_Send(canHandle, params[MAPPING_PARAM_EXAMPLE_CAN_ID].u32, TxData, 8);
 
-      // Send all the ADCs out on the CAN bus
-      uint16_t adc0 = ADC_Get(MAPPING_ADC1_CHANNEL0);
-      uint16_t adc1 = ADC_Get(MAPPING_ADC1_CHANNEL1);
-      uint16_t adc2 = ADC_Get(MAPPING_ADC1_CHANNEL2);
-      uint16_t adc3 = ADC_Get(MAPPING_ADC1_CHANNEL3);
-      uint16_t adc4 = ADC_Get(MAPPING_ADC1_CHANNEL4);
+      // Send all the analog inputs out on the CAN bus, in hundredths of their units
+      SignalDb_Value_T analog[MAPPING_ADC_NUM_INPUTS];
+      SignalDb_ReadList(analogSignals, MAPPING_ADC_NUM_INPUTS, analog);
+      int16_t adc0 = Example_ToHundredths(analog[MAPPING_ADC1_CHANNEL0].value);
+      int16_t adc1 = Example_ToHundredths(analog[MAPPING_ADC1_CHANNEL1].value);
+      int16_t adc2 = Example_ToHundredths(analog[MAPPING_ADC1_CHANNEL2].value);
+      int16_t adc3 = Example_ToHundredths(analog[MAPPING_ADC1_CHANNEL3].value);
+      int16_t adc4 = Example_ToHundredths(analog[MAPPING_ADC1_CHANNEL4].value);
 
       uint8_t canMsg1[8] = {0};
       canMsg1[0] = adc0 & 0xFF;
@@ -96,8 +129,8 @@ static void Example_TaskMain(void* pvParameters)
       canMsg2[0] = adc4 & 0xFF;
       canMsg2[1] = (adc4 >> 8) & 0xFF;
 
-      CAN_SendMessage(canHandle, 0x100, canMsg1, 8);
-      CAN_SendMessage(canHandle, 0x101, canMsg2, 8);
+      CanTx_Send(canHandle, 0x100, canMsg1, 8);
+      CanTx_Send(canHandle, 0x101, canMsg2, 8);
 
       /* Send something on UART */
       char hellomsg[] = "Hey..;)\n";
@@ -124,14 +157,18 @@ static void Example_TaskMain(void* pvParameters)
   }
 }
 
-static void Example_canCallback(const CAN_DataFrame_T* data)
+static void Example_canProcess(const void* item)
 {
+  const CAN_DataFrame_T* data = item;
+
   char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
   snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "CAN received from %lx: ", data->msgId);
   logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
 
+  // DLC 9-15 is valid on classic CAN, and still means 8 bytes
+  size_t len = (data->dlc > 8U) ? 8U : data->dlc;
   size_t i;
-  for (i = 0; i < data->dlc; ++i)
+  for (i = 0; i < len; ++i)
   {
     snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, " %x", data->data[i]);
     logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
@@ -141,13 +178,35 @@ static void Example_canCallback(const CAN_DataFrame_T* data)
   logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
 }
 
-static void Example_uartCallback(const USART_Data_T* data)
+static void Example_canCallback(const CAN_DataFrame_T* data)
+{
+  CanMonitor_Received(canMonitor);
+  Deferred_Post(canSource, data);
+}
+
+static void Example_canTimeoutCallback(CanMonitor_Handle_T handle, bool timedOut)
+{
+  if (timedOut) {
+    logPrintS(log, "CAN 0x3A1 timed out\n", LOGGING_DEFAULT_BUFF_LEN);
+  } else {
+    logPrintS(log, "CAN 0x3A1 received again\n", LOGGING_DEFAULT_BUFF_LEN);
+  }
+}
+
+static void Example_uartProcess(const void* item)
 {
+  const USART_Data_T* data = item;
+
   char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
   snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "UART received byte: %x\n", data->data);
   logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
 }
 
+static void Example_uartCallback(const USART_Data_T* data)
+{
+  Deferred_Post(uartSource, data);
+}
+
 // ------------------- Public methods -------------------
 Example_Status_T Example_Init(
     Logging_T* logger,
@@ -157,19 +216,40 @@ Example_Status_T Example_Init(
 {
   log = logger;
   logPrintS(log, "Example_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+  char logBuffer[LOGGING_DEFAULT_BUFF_LEN];
 
   canHandle = hcan;
   uartHandle = huart;
   rtcHandle = hrtc;
 
-  // Register to receive messages from CAN1
+  // Register to receive messages from CAN1, expected every 100ms
+  CanMonitor_Config_T monitorConfig = {
+    .id = 0x3A1,
+    .periodMs = 100,
+    .timeoutMs = 500,
+    .callback = Example_canTimeoutCallback,
+  };
+  CanMonitor_Register(&monitorConfig, &canMonitor);
+
+  Deferred_Config_T canDeferred = {
+    .handler = Example_canProcess,
+    .itemSize = sizeof(CAN_DataFrame_T),
+  };
+  Deferred_Config_T uartDeferred = {
+    .handler = Example_uartProcess,
+    .itemSize = sizeof(USART_Data_T),
+  };
+  if ((DEFERRED_STATUS_OK != Deferred_Register(&canDeferred, &canSource)) ||
+      (DEFERRED_STATUS_OK != Deferred_Register(&uartDeferred, &uartSource))) {
+    return EXAMPLE_STATUS_ERROR;
+  }
+
   CAN_RegisterCallback(canHandle, 0x3A1, Example_canCallback);
   UART_RegisterCallback(uartHandle, Example_uartCallback);
 
-  // ADC1_PUP
-  HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, GPIO_PIN_RESET); // 0 (RESET) => pull up
-  // ADC2_PUP
-  HAL_GPIO_WritePin(GPIOA, GPIO_PIN_6, GPIO_PIN_SET);   // 1 (SET) => pull down
+  const ParamStore_Value_T* params = ParamStore_Get();
+
+  // ADC1_PUP and ADC2_PUP are driven by the wiring diagnostics in device/analog
 
   // set RTC
   memset(&rtcDateTime, 0, sizeof(RTC_DateTime_T));
@@ -194,8 +274,15 @@ Example_Status_T Example_Init(
       taskStack,
       &taskBuffer);
 
-  // Register the task for timer notifications every 1s
-  uint16_t timerDivider = 1000 * TASKTIMER_BASE_PERIOD_MS;
+  // Register the task for timer notifications (1s by default)
+  uint32_t periodMs = params[MAPPING_PARAM_EXAMPLE_PERIOD_MS].u32;
+  if ((0U == periodMs) || (periodMs > EX_PERIOD_MAX_MS)) {
+    snprintf(logBuffer, LOGGING_DEFAULT_BUFF_LEN, "Example period %lums out of range, using default\n",
+        (unsigned long)periodMs);
+    logPrintS(log, logBuffer, LOGGING_DEFAULT_BUFF_LEN);
+    periodMs = Mapping_GetParamDefaults()[MAPPING_PARAM_EXAMPLE_PERIOD_MS].u32;
+  }
+  uint16_t timerDivider = (uint16_t)(periodMs * TASKTIMER_BASE_PERIOD_MS);
   TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&exampleTaskHandle, timerDivider);
   if (TASKTIMER_STATUS_OK != statusTimer) {
     return EXAMPLE_STATUS_ERROR;
@@ -0,0 +1,268 @@
+/*
+ * pedals.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "pedals.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+#include "lib/map/map.h"
+
+#include "device/inverter/inverter.h"
+#include "device/analog/analog.h"
+
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define PEDALS_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[PEDALS_STACK_SIZE];
+
+// Runs ahead of the processes consuming the torque request on the same tick
+#define PEDALS_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
+
+// Task data
+static TaskHandle_t pedalsTaskHandle;
+
+static Pedals_State_T pedalsState;
+static Pedals_Output_T pedalsOutput;
+
+static const Pedals_Config_T pedalsConfig = {
+  .apps1 = { .rawMin = 400U, .rawMax = 3600U, .rangeMargin = 200U },
+  .apps2 = { .rawMin = 3600U, .rawMax = 400U, .rangeMargin = 200U }, // inverted
+  .brake = { .rawMin = 400U, .rawMax = 3600U, .rangeMargin = 200U },
+
+  .deadbandLow = 0.05f,
+  .deadbandHigh = 0.95f,
+
+  .appsDisagreeLimit = 0.10f,
+  .appsDisagreeCycles = 100U / PEDALS_PERIOD_MS,  // 100ms, over the analog diagnostic hold
+
+  .brakePressedLimit = 0.10f,
+  .brakeAppsLimit = 0.25f,
+  .brakeAppsReset = 0.05f,
+
+  .maxTorque = INVERTER_MAX_TORQUE_NM,
+};
+
+/*
+ * Pedal position to torque fraction. Uniformly spaced over 0..1 pedal.
+ */
+static const float torqueMapTable[] = {
+  0.00f, 0.04f, 0.09f, 0.16f, 0.25f, 0.36f, 0.48f, 0.61f, 0.74f, 0.87f, 1.00f
+};
+static const Map_Uniform1D_T torqueMap = MAP_UNIFORM1D(0.0f, 0.1f, torqueMapTable);
+
+// ------------------- Private methods -------------------
+static inline float Pedals_Clamp(float x, float lo, float hi)
+{
+  return (x < lo) ? lo : ((x > hi) ? hi : x);
+}
+
+/**
+ * @brief Converts raw ADC counts to a 0..1 position
+ * @param rangeFault Set to true if the reading is outside the plausible range
+ */
+static float Pedals_Calibrate(const Pedals_SensorCal_T* cal, uint16_t raw, bool* rangeFault)
+{
+  int32_t lo = (cal->rawMin < cal->rawMax) ? cal->rawMin : cal->rawMax;
+  int32_t hi = (cal->rawMin < cal->rawMax) ? cal->rawMax : cal->rawMin;
+  *rangeFault = ((int32_t)raw < lo - cal->rangeMargin) || ((int32_t)raw > hi + cal->rangeMargin);
+
+  float position = (float)((int32_t)raw - (int32_t)cal->rawMin) /
+                   (float)((int32_t)cal->rawMax - (int32_t)cal->rawMin);
+  return Pedals_Clamp(position, 0.0f, 1.0f);
+}
+
+static float Pedals_ApplyDeadband(const Pedals_Config_T* config, float position)
+{
+  float scaled = (position - config->deadbandLow) / (config->deadbandHigh - config->deadbandLow);
+  return Pedals_Clamp(scaled, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Range fault flag for a sensor whose wiring is faulted
+ */
+static uint16_t Pedals_WiringFault(ADC_Channel_T channel, uint16_t fault)
+{
+  Analog_Health_T health = Analog_GetHealth(channel);
+  bool faulted = (ANALOG_HEALTH_OK != health) && (ANALOG_HEALTH_NOT_TESTED != health);
+  return faulted ? fault : PEDALS_FAULT_NONE;
+}
+
+static void Pedals_Publish(const Pedals_Output_T* output)
+{
+  const uint16_t appsFaults = PEDALS_FAULT_APPS1_RANGE | PEDALS_FAULT_APPS2_RANGE | PEDALS_FAULT_APPS_DISAGREE;
+  bool appsValid = 0 == (output->faults & appsFaults);
+  bool brakeValid = 0 == (output->faults & PEDALS_FAULT_BRAKE_RANGE);
+  uint32_t time = output->sampleTime;
+
+  SignalDb_Set(MAPPING_SIGNAL_APPS_POSITION, output->appsPosition, appsValid, time);
+  SignalDb_Set(MAPPING_SIGNAL_BRAKE_POSITION, output->brakePosition, brakeValid, time);
+  SignalDb_Set(MAPPING_SIGNAL_BRAKE_PRESSED, output->brakePressed ? 1.0f : 0.0f, brakeValid, time);
+  SignalDb_Set(MAPPING_SIGNAL_TORQUE_REQUEST, output->torqueRequest, appsValid, time);
+  SignalDb_Set(MAPPING_SIGNAL_PEDAL_FAULTS, (float)output->faults, true, time);
+  SignalDb_Publish(MAPPING_SIGNAL_GROUP_PEDALS);
+}
+
+static void Pedals_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "Pedals_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      uint32_t sampleTime = CycleCounter_Get();
+
+      Pedals_Input_T input;
+      input.apps1 = Analog_GetCounts(MAPPING_ADC_APPS1);
+      input.apps2 = Analog_GetCounts(MAPPING_ADC_APPS2);
+      input.brake = Analog_GetCounts(MAPPING_ADC_BRAKE);
+      input.wiringFaults = Pedals_WiringFault(MAPPING_ADC_APPS1, PEDALS_FAULT_APPS1_RANGE) |
+                           Pedals_WiringFault(MAPPING_ADC_APPS2, PEDALS_FAULT_APPS2_RANGE) |
+                           Pedals_WiringFault(MAPPING_ADC_BRAKE, PEDALS_FAULT_BRAKE_RANGE);
+
+      Pedals_Output_T output;
+      Pedals_Step(&pedalsConfig, &pedalsState, &input, &output);
+      output.sampleTime = sampleTime;
+
+      taskENTER_CRITICAL();
+      pedalsOutput = output;
+      taskEXIT_CRITICAL();
+      Pedals_Publish(&output);
+
+      // Hand straight to the inverter, which transmits later on this tick
+      Inverter_Command_T command;
+      command.torque = output.torqueRequest;
+      command.speedLimit = INVERTER_MAX_SPEED_RPM;
+      command.sampleTime = sampleTime;
+      Inverter_SetCommand(&command);
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+Pedals_Status_T Pedals_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "Pedals_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  memset(&pedalsState, 0, sizeof(Pedals_State_T));
+  memset(&pedalsOutput, 0, sizeof(Pedals_Output_T));
+
+  // create main task
+  pedalsTaskHandle = xTaskCreateStatic(
+      Pedals_TaskMain,
+      "PedalsTask",
+      PEDALS_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      PEDALS_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = PEDALS_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&pedalsTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return PEDALS_STATUS_ERROR;
+  }
+
+  logPrintS(log, "Pedals_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return PEDALS_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void Pedals_GetOutput(Pedals_Output_T* output)
+{
+  taskENTER_CRITICAL();
+  *output = pedalsOutput;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void Pedals_Step(
+    const Pedals_Config_T* config,
+    Pedals_State_T* state,
+    const Pedals_Input_T* input,
+    Pedals_Output_T* output)
+{
+  bool apps1Fault;
+  bool apps2Fault;
+  bool brakeFault;
+
+  output->faults = PEDALS_FAULT_NONE;
+  output->sampleTime = 0;
+  output->apps1 = Pedals_Calibrate(&config->apps1, input->apps1, &apps1Fault);
+  output->apps2 = Pedals_Calibrate(&config->apps2, input->apps2, &apps2Fault);
+  output->brakePosition = Pedals_Calibrate(&config->brake, input->brake, &brakeFault);
+
+  // Open and short circuits can still read in range, the wiring diagnostics find those
+  apps1Fault = apps1Fault || (input->wiringFaults & PEDALS_FAULT_APPS1_RANGE);
+  apps2Fault = apps2Fault || (input->wiringFaults & PEDALS_FAULT_APPS2_RANGE);
+  brakeFault = brakeFault || (input->wiringFaults & PEDALS_FAULT_BRAKE_RANGE);
+
+  if (apps1Fault) {
+    output->faults |= PEDALS_FAULT_APPS1_RANGE;
+  }
+  if (apps2Fault) {
+    output->faults |= PEDALS_FAULT_APPS2_RANGE;
+  }
+  if (brakeFault) {
+    output->faults |= PEDALS_FAULT_BRAKE_RANGE;
+  }
+
+  // APPS plausibility - channels must agree, with a short debounce
+  float diff = output->apps1 - output->apps2;
+  if (diff < 0.0f) {
+    diff = -diff;
+  }
+  if (diff > config->appsDisagreeLimit) {
+    if (state->disagreeCount < config->appsDisagreeCycles) {
+      state->disagreeCount++;
+    }
+  } else {
+    state->disagreeCount = 0;
+  }
+  if (state->disagreeCount >= config->appsDisagreeCycles) {
+    output->faults |= PEDALS_FAULT_APPS_DISAGREE;
+  }
+
+  // Use the lower of the two channels so a single stuck sensor can't raise torque
+  float apps = (output->apps1 < output->apps2) ? output->apps1 : output->apps2;
+  output->appsPosition = Pedals_ApplyDeadband(config, apps);
+
+  // Brake plausibility - latched until the accelerator is released
+  output->brakePressed = (output->brakePosition > config->brakePressedLimit) && !brakeFault;
+  if (output->brakePressed && apps > config->brakeAppsLimit) {
+    state->brakeAppsLatched = true;
+  } else if (apps < config->brakeAppsReset) {
+    state->brakeAppsLatched = false;
+  }
+  if (state->brakeAppsLatched) {
+    output->faults |= PEDALS_FAULT_BRAKE_APPS;
+  }
+
+  if (PEDALS_FAULT_NONE == output->faults) {
+    output->torqueRequest = Map_Uniform1D(&torqueMap, output->appsPosition) * config->maxTorque;
+  } else {
+    output->torqueRequest = 0.0f;
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ * pedals.h
+ *
+ * Accelerator and brake pedal processing.
+ *
+ * Converts the two redundant accelerator pedal position sensors (APPS) and
+ * the brake sensor into a calibrated pedal position and torque request,
+ * running each 1ms alongside the rest of the torque path.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEPROCESSES_PEDALS_PEDALS_H_
+#define VEHICLEPROCESSES_PEDALS_PEDALS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define PEDALS_PERIOD_MS            ((uint16_t) 1U)
+
+/*
+ * Fault flags reported in Pedals_Output_T.faults
+ */
+#define PEDALS_FAULT_NONE           ((uint16_t) 0x00U)
+#define PEDALS_FAULT_APPS1_RANGE    ((uint16_t) 0x01U)  /* APPS1 open or short circuit */
+#define PEDALS_FAULT_APPS2_RANGE    ((uint16_t) 0x02U)  /* APPS2 open or short circuit */
+#define PEDALS_FAULT_BRAKE_RANGE    ((uint16_t) 0x04U)  /* Brake sensor open or short circuit */
+#define PEDALS_FAULT_APPS_DISAGREE  ((uint16_t) 0x08U)  /* APPS channels disagree for too long */
+#define PEDALS_FAULT_BRAKE_APPS     ((uint16_t) 0x10U)  /* Accelerator and brake pressed together */
+
+typedef enum
+{
+  PEDALS_STATUS_OK     = 0x00U,
+  PEDALS_STATUS_ERROR  = 0x01U
+} Pedals_Status_T;
+
+/**
+ * Calibration of a single pedal sensor channel.
+ * rawMin/rawMax are the ADC counts at the released and fully pressed
+ * positions (rawMax may be less than rawMin for inverted sensors).
+ * Readings further than rangeMargin outside of these are treated as a wiring fault.
+ */
+typedef struct
+{
+  uint16_t rawMin;
+  uint16_t rawMax;
+  uint16_t rangeMargin;
+} Pedals_SensorCal_T;
+
+typedef struct
+{
+  Pedals_SensorCal_T apps1;
+  Pedals_SensorCal_T apps2;
+  Pedals_SensorCal_T brake;
+
+  float deadbandLow;          /* Position below which the pedal reads 0 */
+  float deadbandHigh;         /* Position above which the pedal reads 1 */
+
+  float appsDisagreeLimit;    /* Max difference between APPS channels */
+  uint16_t appsDisagreeCycles;/* Cycles of disagreement before faulting */
+
+  float brakePressedLimit;    /* Brake position considered "pressed" */
+  float brakeAppsLimit;       /* APPS position that, with brake pressed, cuts torque */
+  float brakeAppsReset;       /* APPS position that must be reached to restore torque */
+
+  float maxTorque;            /* Torque request at full pedal (Nm) */
+} Pedals_Config_T;
+
+typedef struct
+{
+  uint16_t apps1;
+  uint16_t apps2;
+  uint16_t brake;
+  uint16_t wiringFaults;      /* PEDALS_FAULT_*_RANGE flags from the wiring diagnostics */
+} Pedals_Input_T;
+
+typedef struct
+{
+  float apps1;                /* Calibrated APPS1 position 0..1 */
+  float apps2;                /* Calibrated APPS2 position 0..1 */
+  float appsPosition;         /* Combined pedal position after deadband 0..1 */
+  float brakePosition;        /* Calibrated brake position 0..1 */
+  bool brakePressed;
+  float torqueRequest;        /* Requested torque (Nm), 0 when faulted */
+  uint16_t faults;            /* PEDALS_FAULT_* flags */
+  uint32_t sampleTime;        /* CycleCounter time the inputs were sampled */
+} Pedals_Output_T;
+
+/*
+ * Persistent state between cycles
+ */
+typedef struct
+{
+  uint16_t disagreeCount;
+  bool brakeAppsLatched;
+} Pedals_State_T;
+
+/**
+ * @brief Initialize the process
+ * @param logger Pointer to system logger
+ */
+Pedals_Status_T Pedals_Init(Logging_T* logger);
+
+/**
+ * @brief Get the most recent pedal output
+ * @param output Copy of the output is placed here
+ */
+void Pedals_GetOutput(Pedals_Output_T* output);
+
+/**
+ * @brief Runs a single cycle of the pedal pipeline.
+ * Has no hardware dependencies, so may be replayed against recorded inputs.
+ * Runs in constant time.
+ * @param config Calibration to use
+ * @param state Persistent state between cycles
+ * @param input Raw ADC readings
+ * @param output Calculated output
+ */
+void Pedals_Step(
+    const Pedals_Config_T* config,
+    Pedals_State_T* state,
+    const Pedals_Input_T* input,
+    Pedals_Output_T* output);
+
+#endif /* VEHICLEPROCESSES_PEDALS_PEDALS_H_ */
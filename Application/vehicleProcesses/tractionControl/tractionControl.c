@@ -0,0 +1,182 @@
+/*
+ * tractionControl.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "tractionControl.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+
+#include "device/wheelspeed/wheelspeed.h"
+#include "device/inverter/inverter.h"
+
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define TC_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[TC_STACK_SIZE];
+
+// Runs ahead of the inverter so the limit applies to this tick's command
+#define TC_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
+
+// Task data
+static TaskHandle_t tcTaskHandle;
+
+static TractionControl_State_T tcState;
+static TractionControl_Output_T tcOutput;
+
+static const TractionControl_Config_T tcConfig = {
+  .targetSlip = 0.10f,
+  .minSpeed = 2.0f,
+  .kp = 400.0f,
+  .ki = 4000.0f,
+  .maxTorque = INVERTER_MAX_TORQUE_NM,
+  .faultTorque = 0.25f * INVERTER_MAX_TORQUE_NM,
+  .dt = (float)TRACTIONCONTROL_PERIOD_MS / 1000.0f,
+};
+
+static const SignalDb_Signal_T wheelSignals[WHEELSPEED_NUM_WHEELS] = {
+  [WHEELSPEED_FL] = MAPPING_SIGNAL_WHEELSPEED_FL,
+  [WHEELSPEED_FR] = MAPPING_SIGNAL_WHEELSPEED_FR,
+  [WHEELSPEED_RL] = MAPPING_SIGNAL_WHEELSPEED_RL,
+  [WHEELSPEED_RR] = MAPPING_SIGNAL_WHEELSPEED_RR,
+};
+
+// The speeds are calculated as they are published
+#define TC_WHEELSPEED_MAX_AGE_MS (SIGNALDB_STALE_PERIODS * WHEELSPEED_PERIOD_MS)
+
+// ------------------- Private methods -------------------
+static void TractionControl_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "TractionControl_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      // All four wheels from the same wheel speed update
+      SignalDb_Value_T wheelSpeed[WHEELSPEED_NUM_WHEELS];
+      SignalDb_ReadList(wheelSignals, WHEELSPEED_NUM_WHEELS, wheelSpeed);
+
+      TractionControl_Input_T input;
+      input.frontLeft = wheelSpeed[WHEELSPEED_FL].value;
+      input.frontRight = wheelSpeed[WHEELSPEED_FR].value;
+      input.rearLeft = wheelSpeed[WHEELSPEED_RL].value;
+      input.rearRight = wheelSpeed[WHEELSPEED_RR].value;
+      input.valid = true;
+      uint8_t i;
+      for (i = 0; i < WHEELSPEED_NUM_WHEELS; ++i) {
+        input.valid = input.valid && SignalDb_IsFresh(wheelSignals[i], &wheelSpeed[i], TC_WHEELSPEED_MAX_AGE_MS);
+      }
+
+      TractionControl_Output_T output;
+      TractionControl_Step(&tcConfig, &tcState, &input, &output);
+
+      Inverter_SetTorqueLimit(output.torqueLimit);
+
+      taskENTER_CRITICAL();
+      tcOutput = output;
+      taskEXIT_CRITICAL();
+    }
+
+  }
+}
+
+// ------------------- Public methods -------------------
+TractionControl_Status_T TractionControl_Init(Logging_T* logger)
+{
+  log = logger;
+  logPrintS(log, "TractionControl_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  memset(&tcState, 0, sizeof(TractionControl_State_T));
+  memset(&tcOutput, 0, sizeof(TractionControl_Output_T));
+  tcOutput.torqueLimit = tcConfig.maxTorque;
+
+  // create main task
+  tcTaskHandle = xTaskCreateStatic(
+      TractionControl_TaskMain,
+      "TractionTask",
+      TC_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      TC_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = TRACTIONCONTROL_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&tcTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return TRACTIONCONTROL_STATUS_ERROR;
+  }
+
+  logPrintS(log, "TractionControl_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return TRACTIONCONTROL_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void TractionControl_GetOutput(TractionControl_Output_T* output)
+{
+  taskENTER_CRITICAL();
+  *output = tcOutput;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+void TractionControl_Step(
+    const TractionControl_Config_T* config,
+    TractionControl_State_T* state,
+    const TractionControl_Input_T* input,
+    TractionControl_Output_T* output)
+{
+  if (!input->valid) {
+    // Held where the limit ramps back up from, as an intervention would
+    state->integral = config->maxTorque - config->faultTorque;
+    output->slip = 0.0f;
+    output->torqueLimit = config->faultTorque;
+    output->active = true;
+    return;
+  }
+
+  float reference = 0.5f * (input->frontLeft + input->frontRight);
+  float driven = (input->rearLeft > input->rearRight) ? input->rearLeft : input->rearRight;
+
+  // Slip against the undriven axle. Below minSpeed the ratio is meaningless,
+  // so the denominator is held at minSpeed to keep low speed launches bounded.
+  float denominator = (reference > config->minSpeed) ? reference : config->minSpeed;
+  output->slip = (driven - reference) / denominator;
+
+  // PI on slip error. The integral only ever reduces torque, so it is
+  // clamped between 0 and maxTorque to prevent wind-up in either direction.
+  float error = output->slip - config->targetSlip;
+  state->integral += config->ki * error * config->dt;
+  if (state->integral < 0.0f) {
+    state->integral = 0.0f;
+  } else if (state->integral > config->maxTorque) {
+    state->integral = config->maxTorque;
+  }
+
+  float reduction = config->kp * error + state->integral;
+  if (reduction < 0.0f) {
+    reduction = 0.0f;
+  } else if (reduction > config->maxTorque) {
+    reduction = config->maxTorque;
+  }
+
+  output->torqueLimit = config->maxTorque - reduction;
+  output->active = reduction > 0.0f;
+}
@@ -0,0 +1,89 @@
+/*
+ * tractionControl.h
+ *
+ * Traction control process.
+ *
+ * Estimates the driven (rear) wheel slip ratio against the undriven front
+ * wheels and runs a PI slip controller each 1ms. The controller output is
+ * applied as a torque limit on the inverter command.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEPROCESSES_TRACTIONCONTROL_TRACTIONCONTROL_H_
+#define VEHICLEPROCESSES_TRACTIONCONTROL_TRACTIONCONTROL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define TRACTIONCONTROL_PERIOD_MS   ((uint16_t) 1U)
+
+typedef enum
+{
+  TRACTIONCONTROL_STATUS_OK     = 0x00U,
+  TRACTIONCONTROL_STATUS_ERROR  = 0x01U
+} TractionControl_Status_T;
+
+typedef struct
+{
+  float targetSlip;       /* Slip ratio the controller regulates to */
+  float minSpeed;         /* Reference speed (m/s) below which slip is not controlled */
+  float kp;               /* Nm per unit slip error */
+  float ki;               /* Nm per unit slip error per second */
+  float maxTorque;        /* Torque limit when not intervening (Nm) */
+  float faultTorque;      /* Torque limit while the wheel speeds are not current (Nm) */
+  float dt;               /* Controller period (s) */
+} TractionControl_Config_T;
+
+typedef struct
+{
+  float frontLeft;        /* Wheel speeds (m/s) */
+  float frontRight;
+  float rearLeft;
+  float rearRight;
+  bool valid;             /* All four speeds valid and current */
+} TractionControl_Input_T;
+
+typedef struct
+{
+  float slip;             /* Estimated driven wheel slip ratio */
+  float torqueLimit;      /* Torque limit to apply (Nm) */
+  bool active;            /* Controller is reducing torque */
+} TractionControl_Output_T;
+
+typedef struct
+{
+  float integral;         /* Integrated torque reduction (Nm) */
+} TractionControl_State_T;
+
+/**
+ * @brief Initialize the process
+ * @param logger Pointer to system logger
+ */
+TractionControl_Status_T TractionControl_Init(Logging_T* logger);
+
+/**
+ * @brief Get the most recent controller output
+ */
+void TractionControl_GetOutput(TractionControl_Output_T* output);
+
+/**
+ * @brief Runs a single cycle of the slip controller.
+ * Has no hardware dependencies, so may be run against a plant model.
+ * Without valid wheel speeds slip can't be seen, so torque is limited to
+ * faultTorque, and ramps back up from there once they return.
+ * @param config Controller tuning
+ * @param state Persistent state between cycles
+ * @param input Wheel speeds
+ * @param output Calculated output
+ */
+void TractionControl_Step(
+    const TractionControl_Config_T* config,
+    TractionControl_State_T* state,
+    const TractionControl_Input_T* input,
+    TractionControl_Output_T* output);
+
+#endif /* VEHICLEPROCESSES_TRACTIONCONTROL_TRACTIONCONTROL_H_ */
@@ -0,0 +1,334 @@
+/*
+ * vehicleState.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "vehicleState.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "comm/can/can.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "time/tasktimer/tasktimer.h"
+#include "time/cycleCounter/cycleCounter.h"
+
+#include "device/inverter/inverter.h"
+#include "vehicleProcesses/pedals/pedals.h"
+
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+#define VS_STACK_SIZE 2000
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[VS_STACK_SIZE];
+
+// Runs ahead of the inverter so a state change gates this tick's command
+#define VS_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
+
+// Task data
+static TaskHandle_t vsTaskHandle;
+
+// Devices used
+static CAN_HandleTypeDef* canHandle;
+
+// Dashboard inputs - written from the CAN callback
+#define DASH_HV_REQUEST   0x01U
+#define DASH_START        0x02U
+static volatile uint8_t dashFlags;
+static CanMonitor_Handle_T dashMonitor;
+
+static volatile VehicleState_State_T currentState;
+static uint32_t timeInState;
+static VehicleState_Stats_T stats;
+
+/*
+ * Transition table. Rows are evaluated in order and the first row whose
+ * source state matches and whose guard passes fires. VEHICLESTATE_ANY rows
+ * apply to all states except their target.
+ */
+#define VEHICLESTATE_ANY VEHICLESTATE_NUM_STATES
+
+typedef bool (*VehicleState_Guard_T)(VehicleState_State_T state, const VehicleState_Input_T* input);
+
+typedef struct
+{
+  VehicleState_State_T from;
+  VehicleState_State_T to;
+  VehicleState_Guard_T guard;
+} VehicleState_Transition_T;
+
+typedef void (*VehicleState_Action_T)(void);
+
+enum
+{
+  VS_SIGNAL_BRAKE_PRESSED,
+  VS_SIGNAL_PEDAL_FAULTS,
+  VS_SIGNAL_INVERTER_FAULTED,
+  VS_SIGNAL_DC_VOLTAGE,
+  VS_NUM_SIGNALS
+};
+
+static const SignalDb_Signal_T inputSignals[VS_NUM_SIGNALS] = {
+  [VS_SIGNAL_BRAKE_PRESSED] = MAPPING_SIGNAL_BRAKE_PRESSED,
+  [VS_SIGNAL_PEDAL_FAULTS] = MAPPING_SIGNAL_PEDAL_FAULTS,
+  [VS_SIGNAL_INVERTER_FAULTED] = MAPPING_SIGNAL_INVERTER_FAULTED,
+  [VS_SIGNAL_DC_VOLTAGE] = MAPPING_SIGNAL_DC_VOLTAGE,
+};
+
+// The pedals publish the ADC scan they read, which may be a period older
+#define VS_PEDALS_MAX_AGE_MS ((SIGNALDB_STALE_PERIODS + 1U) * PEDALS_PERIOD_MS)
+
+// ------------------- Private methods -------------------
+static bool VehicleState_GuardFault(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  bool hvActive = (VEHICLESTATE_PRECHARGE == state) ||
+                  (VEHICLESTATE_READY_TO_DRIVE == state) ||
+                  (VEHICLESTATE_DRIVE == state);
+
+  return input->pedalFault ||
+         input->inverterFault ||
+         (hvActive && !input->inverterValid) ||
+         (hvActive && !input->dashValid);
+}
+
+static bool VehicleState_GuardHvRequested(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  // Held in LV_ON until the pedals are running
+  return input->hvRequest && input->pedalsStarted;
+}
+
+static bool VehicleState_GuardHvDropped(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  return !input->hvRequest;
+}
+
+static bool VehicleState_GuardPrechargeDone(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  return input->dcVoltage >= VEHICLESTATE_PRECHARGE_VOLTAGE;
+}
+
+static bool VehicleState_GuardPrechargeTimeout(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  return input->timeInState >= VEHICLESTATE_PRECHARGE_TIMEOUT_MS;
+}
+
+static bool VehicleState_GuardStart(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  return input->startRequest && input->brakePressed;
+}
+
+static bool VehicleState_GuardFaultCleared(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  return !VehicleState_GuardFault(VEHICLESTATE_LV_ON, input) && !input->hvRequest;
+}
+
+static const VehicleState_Transition_T transitions[] = {
+  { VEHICLESTATE_ANY,             VEHICLESTATE_FAULT,           VehicleState_GuardFault },
+  { VEHICLESTATE_LV_ON,           VEHICLESTATE_PRECHARGE,       VehicleState_GuardHvRequested },
+  { VEHICLESTATE_PRECHARGE,       VEHICLESTATE_LV_ON,           VehicleState_GuardHvDropped },
+  { VEHICLESTATE_PRECHARGE,       VEHICLESTATE_READY_TO_DRIVE,  VehicleState_GuardPrechargeDone },
+  { VEHICLESTATE_PRECHARGE,       VEHICLESTATE_FAULT,           VehicleState_GuardPrechargeTimeout },
+  { VEHICLESTATE_READY_TO_DRIVE,  VEHICLESTATE_LV_ON,           VehicleState_GuardHvDropped },
+  { VEHICLESTATE_READY_TO_DRIVE,  VEHICLESTATE_DRIVE,           VehicleState_GuardStart },
+  { VEHICLESTATE_DRIVE,           VEHICLESTATE_LV_ON,           VehicleState_GuardHvDropped },
+  { VEHICLESTATE_FAULT,           VEHICLESTATE_LV_ON,           VehicleState_GuardFaultCleared },
+};
+#define VEHICLESTATE_NUM_TRANSITIONS (sizeof(transitions) / sizeof(transitions[0]))
+
+/*
+ * Entry actions, indexed by state
+ */
+static void VehicleState_EnterDisabled(void)
+{
+  Inverter_SetEnable(false);
+}
+
+static void VehicleState_EnterDrive(void)
+{
+  Inverter_SetEnable(true);
+}
+
+static void VehicleState_EnterFault(void)
+{
+  Inverter_SetEnable(false);
+
+  // Keep the CAN traffic leading up to the fault
+  CanRecorder_Trigger();
+}
+
+static const VehicleState_Action_T entryActions[VEHICLESTATE_NUM_STATES] = {
+  [VEHICLESTATE_LV_ON]          = VehicleState_EnterDisabled,
+  [VEHICLESTATE_PRECHARGE]      = VehicleState_EnterDisabled,
+  [VEHICLESTATE_READY_TO_DRIVE] = VehicleState_EnterDisabled,
+  [VEHICLESTATE_DRIVE]          = VehicleState_EnterDrive,
+  [VEHICLESTATE_FAULT]          = VehicleState_EnterFault,
+};
+
+static void VehicleState_SampleInputs(VehicleState_Input_T* input)
+{
+  uint8_t flags = dashFlags;
+
+  input->dashValid = !CanMonitor_IsStale(dashMonitor);
+  input->hvRequest = input->dashValid && (flags & DASH_HV_REQUEST);
+  input->startRequest = input->dashValid && (flags & DASH_START);
+
+  SignalDb_Value_T values[VS_NUM_SIGNALS];
+  SignalDb_ReadList(inputSignals, VS_NUM_SIGNALS, values);
+
+  const SignalDb_Value_T* brake = &values[VS_SIGNAL_BRAKE_PRESSED];
+  input->brakePressed = SignalDb_IsFresh(inputSignals[VS_SIGNAL_BRAKE_PRESSED], brake, VS_PEDALS_MAX_AGE_MS) &&
+                        (brake->value > 0.5f);
+
+  // Once the pedals have started, pedal faults that are no longer current
+  // are a fault in themselves. Before then, the pedals task may not have
+  // run yet, and HV can't be requested.
+  input->pedalsStarted = SignalDb_GetPublishCount(MAPPING_SIGNAL_GROUP_PEDALS) > 0;
+  const SignalDb_Value_T* faults = &values[VS_SIGNAL_PEDAL_FAULTS];
+  uint16_t pedalFaults = (uint16_t)faults->value;
+  input->pedalFault = input->pedalsStarted &&
+                      (!SignalDb_IsFresh(inputSignals[VS_SIGNAL_PEDAL_FAULTS], faults, VS_PEDALS_MAX_AGE_MS) ||
+                       ((pedalFaults & ~PEDALS_FAULT_BRAKE_APPS) != PEDALS_FAULT_NONE));
+
+  input->inverterValid = SignalDb_IsFresh(inputSignals[VS_SIGNAL_INVERTER_FAULTED], &values[VS_SIGNAL_INVERTER_FAULTED],
+                                          INVERTER_STATUS_TIMEOUT_MS);
+  input->inverterFault = input->inverterValid && (values[VS_SIGNAL_INVERTER_FAULTED].value > 0.5f);
+  input->dcVoltage = values[VS_SIGNAL_DC_VOLTAGE].valid ? values[VS_SIGNAL_DC_VOLTAGE].value : 0.0f;
+
+  input->timeInState = timeInState;
+}
+
+static void VehicleState_TaskMain(void* pvParameters)
+{
+  logPrintS(log, "VehicleState_TaskMain begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  const TickType_t blockTime = 10 / portTICK_PERIOD_MS; // 10ms
+  uint32_t notifiedValue;
+
+  while (1) {
+    // Wait for notification to wake up
+    notifiedValue = ulTaskNotifyTake(pdTRUE, blockTime);
+    if (notifiedValue > 0) {
+      // ready to process
+      uint32_t sampleTime = CycleCounter_Get();
+
+      VehicleState_Input_T input;
+      VehicleState_SampleInputs(&input);
+
+      VehicleState_State_T next = VehicleState_Step(currentState, &input);
+      if (next != currentState) {
+        currentState = next;
+        timeInState = 0;
+        entryActions[next]();
+
+        uint32_t latencyUs = CycleCounter_ToMicros(CycleCounter_Elapsed(sampleTime));
+        stats.transitions++;
+        stats.latencyLastUs = latencyUs;
+        if (latencyUs > stats.latencyMaxUs) {
+          stats.latencyMaxUs = latencyUs;
+        }
+      } else {
+        timeInState += VEHICLESTATE_PERIOD_MS;
+      }
+    }
+
+  }
+}
+
+static void VehicleState_DashCallback(const CAN_DataFrame_T* data)
+{
+  if (data->dlc < 1) {
+    return;
+  }
+
+  dashFlags = data->data[0];
+  CanMonitor_Received(dashMonitor);
+}
+
+// ------------------- Public methods -------------------
+VehicleState_Status_T VehicleState_Init(Logging_T* logger, CAN_HandleTypeDef* hcan)
+{
+  log = logger;
+  logPrintS(log, "VehicleState_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  canHandle = hcan;
+
+  dashFlags = 0;
+  timeInState = 0;
+  memset(&stats, 0, sizeof(VehicleState_Stats_T));
+
+  currentState = VEHICLESTATE_LV_ON;
+  entryActions[currentState]();
+
+  CanMonitor_Config_T monitorConfig = {
+    .id = VEHICLESTATE_CAN_ID_DASH,
+    .periodMs = VEHICLESTATE_DASH_PERIOD_MS,
+    .timeoutMs = VEHICLESTATE_DASH_TIMEOUT_MS,
+    .callback = NULL,
+  };
+  CanMonitor_Status_T statusMonitor = CanMonitor_Register(&monitorConfig, &dashMonitor);
+  if (CANMONITOR_STATUS_OK != statusMonitor) {
+    return VEHICLESTATE_STATUS_ERROR;
+  }
+
+  CAN_Status_T statusCan = CAN_RegisterCallback(canHandle, VEHICLESTATE_CAN_ID_DASH, VehicleState_DashCallback);
+  if (CAN_STATUS_OK != statusCan) {
+    return VEHICLESTATE_STATUS_ERROR;
+  }
+
+  // create main task
+  vsTaskHandle = xTaskCreateStatic(
+      VehicleState_TaskMain,
+      "VehicleStateTask",
+      VS_STACK_SIZE,   /* Stack size */
+      NULL,  /* Parameter passed as pointer */
+      VS_TASK_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  // Register the task for timer notifications every 1ms
+  uint16_t timerDivider = VEHICLESTATE_PERIOD_MS * TASKTIMER_BASE_PERIOD_MS;
+  TaskTimer_Status_T statusTimer = TaskTimer_RegisterTask(&vsTaskHandle, timerDivider);
+  if (TASKTIMER_STATUS_OK != statusTimer) {
+    return VEHICLESTATE_STATUS_ERROR;
+  }
+
+  logPrintS(log, "VehicleState_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return VEHICLESTATE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+VehicleState_State_T VehicleState_Get(void)
+{
+  return currentState;
+}
+
+//------------------------------------------------------------------------------
+void VehicleState_GetStats(VehicleState_Stats_T* s)
+{
+  taskENTER_CRITICAL();
+  *s = stats;
+  taskEXIT_CRITICAL();
+}
+
+//------------------------------------------------------------------------------
+VehicleState_State_T VehicleState_Step(VehicleState_State_T state, const VehicleState_Input_T* input)
+{
+  size_t i;
+  for (i = 0; i < VEHICLESTATE_NUM_TRANSITIONS; ++i) {
+    const VehicleState_Transition_T* t = &transitions[i];
+    bool fromMatches = (t->from == state) || (VEHICLESTATE_ANY == t->from && t->to != state);
+    if (fromMatches && t->guard(state, input)) {
+      return t->to;
+    }
+  }
+  return state;
+}
@@ -0,0 +1,103 @@
+/*
+ * vehicleState.h
+ *
+ * Vehicle state machine process.
+ *
+ * Evaluates a table of guarded transitions every 1ms (LV on, precharge,
+ * ready-to-drive, drive, fault) and runs the entry action of the new state
+ * in the same cycle. The inverter is only enabled in the drive state.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef VEHICLEPROCESSES_VEHICLESTATE_VEHICLESTATE_H_
+#define VEHICLEPROCESSES_VEHICLESTATE_VEHICLESTATE_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/logging/logging.h"
+
+#define VEHICLESTATE_PERIOD_MS            ((uint16_t) 1U)
+
+/* Dashboard frame: [0] bit 0 = HV request, bit 1 = start button */
+#define VEHICLESTATE_CAN_ID_DASH          ((uint32_t) 0x300U)
+#define VEHICLESTATE_DASH_PERIOD_MS       ((uint32_t) 20U)
+#define VEHICLESTATE_DASH_TIMEOUT_MS      ((uint32_t) 100U)
+
+/* Precharge is complete once the inverter DC bus reaches this voltage */
+#define VEHICLESTATE_PRECHARGE_VOLTAGE    300.0f
+#define VEHICLESTATE_PRECHARGE_TIMEOUT_MS ((uint32_t) 5000U)
+
+typedef enum
+{
+  VEHICLESTATE_STATUS_OK     = 0x00U,
+  VEHICLESTATE_STATUS_ERROR  = 0x01U
+} VehicleState_Status_T;
+
+typedef enum
+{
+  VEHICLESTATE_LV_ON          = 0x00U,
+  VEHICLESTATE_PRECHARGE      = 0x01U,
+  VEHICLESTATE_READY_TO_DRIVE = 0x02U,
+  VEHICLESTATE_DRIVE          = 0x03U,
+  VEHICLESTATE_FAULT          = 0x04U,
+  VEHICLESTATE_NUM_STATES     = 0x05U
+} VehicleState_State_T;
+
+/*
+ * Inputs the transition guards are evaluated against, sampled once per cycle.
+ */
+typedef struct
+{
+  bool hvRequest;           /* Dashboard (CAN) */
+  bool startRequest;        /* Dashboard (CAN) */
+  bool dashValid;           /* Dashboard frame is fresh */
+
+  bool pedalsStarted;       /* Pedals have published at least once */
+  bool brakePressed;        /* Pedals (ADC) */
+  bool pedalFault;          /* Pedals (ADC) range or plausibility fault, or pedals no longer current */
+
+  bool inverterValid;       /* Inverter status (CAN) is fresh */
+  bool inverterFault;
+  float dcVoltage;
+
+  uint32_t timeInState;     /* ms */
+} VehicleState_Input_T;
+
+typedef struct
+{
+  uint32_t transitions;
+  uint32_t latencyLastUs;   /* Input sample to completion of the entry action */
+  uint32_t latencyMaxUs;
+} VehicleState_Stats_T;
+
+/**
+ * @brief Initialize the process
+ * @param logger Pointer to system logger
+ * @param hcan CAN bus the dashboard is on
+ */
+VehicleState_Status_T VehicleState_Init(Logging_T* logger, CAN_HandleTypeDef* hcan);
+
+/**
+ * @brief Get the current vehicle state
+ */
+VehicleState_State_T VehicleState_Get(void);
+
+/**
+ * @brief Get the state machine statistics
+ */
+void VehicleState_GetStats(VehicleState_Stats_T* stats);
+
+/**
+ * @brief Evaluates the transition table once.
+ * Has no hardware dependencies.
+ * @param state Current state
+ * @param input Inputs for this cycle
+ * @return The next state (same as state if no transition fires)
+ */
+VehicleState_State_T VehicleState_Step(VehicleState_State_T state, const VehicleState_Input_T* input);
+
+#endif /* VEHICLEPROCESSES_VEHICLESTATE_VEHICLESTATE_H_ */
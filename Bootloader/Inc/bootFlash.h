@@ -0,0 +1,56 @@
+/*
+ * bootFlash.h
+ *
+ * Application flash erase, programming and verification.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef BOOTFLASH_H_
+#define BOOTFLASH_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Erases the boot record sector, so an interrupted update is never
+ * booted, and restarts the application erase from its first sector
+ */
+bool BootFlash_InvalidateRecord(void);
+
+/**
+ * @brief Whether application sectors below end are yet to be erased
+ */
+bool BootFlash_EraseNeeded(uint32_t end);
+
+/**
+ * @brief Erases the next application sector. Takes up to a few seconds for
+ * the larger sectors, with the CPU stalled.
+ */
+bool BootFlash_EraseNext(void);
+
+/**
+ * @brief Programs data into the (erased) application region
+ * @param address Destination, word aligned
+ * @param len Bytes, multiple of 4
+ */
+bool BootFlash_Program(uint32_t address, const uint8_t* data, uint32_t len);
+
+/**
+ * @brief CRC of the first length bytes of the application region
+ */
+uint32_t BootFlash_AppCrc(uint32_t length);
+
+/**
+ * @brief Writes the boot record marking the application valid
+ */
+bool BootFlash_WriteRecord(uint32_t length, uint32_t crc);
+
+/**
+ * @brief Checks the boot record, the application CRC and its vector table
+ */
+bool BootFlash_AppValid(void);
+
+#endif /* BOOTFLASH_H_ */
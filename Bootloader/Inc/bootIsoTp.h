@@ -0,0 +1,54 @@
+/*
+ * bootIsoTp.h
+ *
+ * Minimal ISO-TP for the bootloader. Receives messages of any length into
+ * two alternating buffers, so the next message can arrive while the
+ * previous one is still being processed. Responses are single frames only.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef BOOTISOTP_H_
+#define BOOTISOTP_H_
+
+#include "stm32f7xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Largest message: TransferData SID + sequence + 2048 bytes */
+#define BOOTISOTP_BUFFER_SIZE     ((uint16_t) 2050U)
+
+/**
+ * @brief Initialize with the CAN bus and IDs to use
+ */
+void BootIsoTp_Init(CAN_HandleTypeDef* hcan, uint32_t rxId, uint32_t txId);
+
+/**
+ * @brief Passes a received CAN frame in. Called from the CAN RX interrupt.
+ */
+void BootIsoTp_RxFrame(const uint8_t* data, uint8_t dlc);
+
+/**
+ * @brief Get the oldest complete message
+ * @param len Set to the message length
+ * @return NULL if there is none. Must be returned with BootIsoTp_Release.
+ */
+uint8_t* BootIsoTp_Receive(uint16_t* len);
+
+/**
+ * @brief Return a buffer from BootIsoTp_Receive, so it can receive again
+ */
+void BootIsoTp_Release(uint8_t* buffer);
+
+/**
+ * @brief Send a single frame message (up to 7 bytes)
+ */
+bool BootIsoTp_Send(const uint8_t* data, uint8_t len);
+
+/**
+ * @brief Waits for all queued frames to be sent
+ */
+void BootIsoTp_Flush(void);
+
+#endif /* BOOTISOTP_H_ */
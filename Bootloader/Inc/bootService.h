@@ -0,0 +1,46 @@
+/*
+ * bootService.h
+ *
+ * Diagnostic services handled by the bootloader (a subset of UDS):
+ *  - 0x10 DiagnosticSessionControl
+ *  - 0x11 ECUReset
+ *  - 0x34 RequestDownload     (whole application image, from BOOTCONTROL_APP_ADDR)
+ *  - 0x36 TransferData
+ *  - 0x37 RequestTransferExit (with the image CRC)
+ *  - 0x3E TesterPresent
+ *
+ * TransferData is acknowledged as soon as a block is received, and the block
+ * is programmed while the tester sends the next one. A programming failure
+ * is reported in the response to the following request.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef BOOTSERVICE_H_
+#define BOOTSERVICE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Data bytes per TransferData block */
+#define BOOTSERVICE_BLOCK_SIZE    ((uint16_t) 2048U)
+
+/**
+ * @brief Initialize the service handler
+ * @param requested Entered at the application's request, which is waiting
+ * for the programming session response
+ */
+void BootService_Init(bool requested);
+
+/**
+ * @brief Handle pending programming and requests. Called from the main loop.
+ */
+void BootService_Process(void);
+
+/**
+ * @brief True once an ECUReset has been acknowledged
+ */
+bool BootService_ResetRequested(void);
+
+#endif /* BOOTSERVICE_H_ */
@@ -0,0 +1,168 @@
+/*
+ * bootFlash.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "bootFlash.h"
+
+#include <string.h>
+
+#include "lib/crc/crc.h"
+#include "startup/bootControl.h"
+
+// ------------------- Private data -------------------
+/*
+ * Start address of each application sector
+ */
+typedef struct
+{
+  uint32_t sector;
+  uint32_t address;
+} BootFlash_Sector_T;
+
+static const BootFlash_Sector_T appSectors[] = {
+  { FLASH_SECTOR_3, 0x08018000U },
+  { FLASH_SECTOR_4, 0x08020000U },
+  { FLASH_SECTOR_5, 0x08040000U },
+  { FLASH_SECTOR_6, 0x08080000U },
+  { FLASH_SECTOR_7, 0x080C0000U },
+  { FLASH_SECTOR_8, 0x08100000U },
+  { FLASH_SECTOR_9, 0x08140000U },
+};
+#define BOOTFLASH_NUM_APP_SECTORS (sizeof(appSectors) / sizeof(appSectors[0]))
+
+// Application sectors erased since the record was invalidated
+static size_t erasedSectors;
+
+#define BOOTFLASH_RAM_START       ((uint32_t) 0x20000000U)
+#define BOOTFLASH_RAM_END         ((uint32_t) 0x20080000U)
+
+// ------------------- Private methods -------------------
+static bool BootFlash_EraseSector(uint32_t sector)
+{
+  FLASH_EraseInitTypeDef erase;
+  erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+  erase.Sector = sector;
+  erase.NbSectors = 1;
+  erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+  uint32_t sectorError;
+  return HAL_OK == HAL_FLASHEx_Erase(&erase, &sectorError);
+}
+
+static bool BootFlash_ProgramWords(uint32_t address, const uint32_t* words, uint32_t numWords)
+{
+  uint32_t i;
+  for (i = 0; i < numWords; ++i) {
+    if (HAL_OK != HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4U, words[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ------------------- Public methods -------------------
+bool BootFlash_InvalidateRecord(void)
+{
+  erasedSectors = 0;
+
+  HAL_FLASH_Unlock();
+  bool ok = BootFlash_EraseSector(BOOTCONTROL_RECORD_SECTOR);
+  HAL_FLASH_Lock();
+
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+bool BootFlash_EraseNeeded(uint32_t end)
+{
+  return erasedSectors < BOOTFLASH_NUM_APP_SECTORS &&
+         appSectors[erasedSectors].address < end;
+}
+
+//------------------------------------------------------------------------------
+bool BootFlash_EraseNext(void)
+{
+  if (erasedSectors >= BOOTFLASH_NUM_APP_SECTORS) {
+    return false;
+  }
+
+  HAL_FLASH_Unlock();
+  bool ok = BootFlash_EraseSector(appSectors[erasedSectors].sector);
+  HAL_FLASH_Lock();
+
+  if (ok) {
+    erasedSectors++;
+  }
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+bool BootFlash_Program(uint32_t address, const uint8_t* data, uint32_t len)
+{
+  if (address < BOOTCONTROL_APP_ADDR ||
+      address + len > BOOTCONTROL_APP_END ||
+      0 != (address % 4U) || 0 != (len % 4U)) {
+    return false;
+  }
+
+  HAL_FLASH_Unlock();
+
+  // Data is not necessarily word aligned in the receive buffer
+  bool ok = true;
+  uint32_t i;
+  for (i = 0; i < len && ok; i += 4U) {
+    uint32_t word;
+    memcpy(&word, &data[i], sizeof(word));
+    ok = (HAL_OK == HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i, word));
+  }
+
+  HAL_FLASH_Lock();
+
+  return ok && (0 == memcmp((const void*)address, data, len));
+}
+
+//------------------------------------------------------------------------------
+uint32_t BootFlash_AppCrc(uint32_t length)
+{
+  return Crc_Calculate((const uint32_t*)BOOTCONTROL_APP_ADDR, length / 4U);
+}
+
+//------------------------------------------------------------------------------
+bool BootFlash_WriteRecord(uint32_t length, uint32_t crc)
+{
+  BootControl_Record_T record;
+  record.magic = BOOTCONTROL_RECORD_MAGIC;
+  record.appLength = length;
+  record.appCrc = crc;
+  record.recordCrc = Crc_Calculate((const uint32_t*)&record, 3U);
+
+  HAL_FLASH_Unlock();
+  bool ok = BootFlash_ProgramWords(BOOTCONTROL_RECORD_ADDR, (const uint32_t*)&record, sizeof(record) / 4U);
+  HAL_FLASH_Lock();
+
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+bool BootFlash_AppValid(void)
+{
+  const BootControl_Record_T* record = (const BootControl_Record_T*)BOOTCONTROL_RECORD_ADDR;
+  if (BOOTCONTROL_RECORD_MAGIC != record->magic ||
+      record->recordCrc != Crc_Calculate((const uint32_t*)record, 3U) ||
+      record->appLength < 8U ||
+      record->appLength > BOOTCONTROL_APP_END - BOOTCONTROL_APP_ADDR) {
+    return false;
+  }
+
+  if (record->appCrc != BootFlash_AppCrc(record->appLength)) {
+    return false;
+  }
+
+  // Initial stack pointer and reset vector must be sensible
+  const uint32_t* vectors = (const uint32_t*)BOOTCONTROL_APP_ADDR;
+  return vectors[0] > BOOTFLASH_RAM_START && vectors[0] <= BOOTFLASH_RAM_END &&
+         vectors[1] >= BOOTCONTROL_APP_ADDR && vectors[1] < BOOTCONTROL_APP_ADDR + record->appLength;
+}
@@ -0,0 +1,248 @@
+/*
+ * bootIsoTp.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "bootIsoTp.h"
+
+#include <string.h>
+
+// ------------------- Private data -------------------
+#define BOOTISOTP_PCI_SINGLE        0x00U
+#define BOOTISOTP_PCI_FIRST         0x10U
+#define BOOTISOTP_PCI_CONSECUTIVE   0x20U
+#define BOOTISOTP_PCI_MASK          0xF0U
+#define BOOTISOTP_FC_CTS            0x30U
+#define BOOTISOTP_FC_OVERFLOW       0x32U
+#define BOOTISOTP_PADDING           0xCCU
+#define BOOTISOTP_FLUSH_TIMEOUT_MS  100U
+
+#define BOOTISOTP_NUM_BUFFERS       2U
+
+typedef enum
+{
+  BOOTISOTP_BUFFER_FREE,
+  BOOTISOTP_BUFFER_FILLING,
+  BOOTISOTP_BUFFER_READY
+} BootIsoTp_BufferState_T;
+
+typedef struct
+{
+  uint8_t data[BOOTISOTP_BUFFER_SIZE];
+  uint16_t len;
+  uint16_t offset;
+  uint32_t order;           /* Order completed in, so messages are processed in sequence */
+  volatile BootIsoTp_BufferState_T state;
+} BootIsoTp_Buffer_T;
+
+static BootIsoTp_Buffer_T buffers[BOOTISOTP_NUM_BUFFERS];
+static BootIsoTp_Buffer_T* filling;
+static uint8_t rxSeq;
+static uint32_t completeCount;
+
+static CAN_HandleTypeDef* canHandle;
+static uint32_t canRxId;
+static uint32_t canTxId;
+
+// ------------------- Private methods -------------------
+static bool BootIsoTp_SendFrame(const uint8_t* data, uint8_t len)
+{
+  uint8_t frame[8];
+  memset(frame, BOOTISOTP_PADDING, sizeof(frame));
+  memcpy(frame, data, len);
+
+  CAN_TxHeaderTypeDef header;
+  header.StdId = canTxId;
+  header.ExtId = 0;
+  header.IDE = CAN_ID_STD;
+  header.RTR = CAN_RTR_DATA;
+  header.DLC = 8;
+  header.TransmitGlobalTime = DISABLE;
+
+  uint32_t mailbox;
+  return HAL_OK == HAL_CAN_AddTxMessage(canHandle, &header, frame, &mailbox);
+}
+
+static BootIsoTp_Buffer_T* BootIsoTp_StartMessage(uint16_t len)
+{
+  if (NULL != filling) {
+    // Previous message was abandoned
+    filling->state = BOOTISOTP_BUFFER_FREE;
+    filling = NULL;
+  }
+
+  if (len > BOOTISOTP_BUFFER_SIZE) {
+    return NULL;
+  }
+
+  size_t i;
+  for (i = 0; i < BOOTISOTP_NUM_BUFFERS; ++i) {
+    if (BOOTISOTP_BUFFER_FREE == buffers[i].state) {
+      buffers[i].state = BOOTISOTP_BUFFER_FILLING;
+      buffers[i].len = len;
+      buffers[i].offset = 0;
+      return &buffers[i];
+    }
+  }
+  return NULL;
+}
+
+static void BootIsoTp_CompleteMessage(BootIsoTp_Buffer_T* buffer)
+{
+  buffer->order = completeCount++;
+  buffer->state = BOOTISOTP_BUFFER_READY;
+}
+
+// ------------------- Public methods -------------------
+void BootIsoTp_Init(CAN_HandleTypeDef* hcan, uint32_t rxId, uint32_t txId)
+{
+  canHandle = hcan;
+  canRxId = rxId;
+  canTxId = txId;
+
+  memset(buffers, 0, sizeof(buffers));
+  filling = NULL;
+  rxSeq = 0;
+  completeCount = 0;
+}
+
+//------------------------------------------------------------------------------
+void BootIsoTp_RxFrame(const uint8_t* data, uint8_t dlc)
+{
+  if (dlc < 1) {
+    return;
+  }
+
+  switch (data[0] & BOOTISOTP_PCI_MASK) {
+    case BOOTISOTP_PCI_SINGLE:
+    {
+      uint8_t len = data[0] & 0x0FU;
+      if (0 == len || len > 7U || len + 1U > dlc) {
+        return;
+      }
+      BootIsoTp_Buffer_T* buffer = BootIsoTp_StartMessage(len);
+      if (NULL != buffer) {
+        memcpy(buffer->data, &data[1], len);
+        BootIsoTp_CompleteMessage(buffer);
+      }
+      break;
+    }
+
+    case BOOTISOTP_PCI_FIRST:
+    {
+      uint16_t len = ((uint16_t)(data[0] & 0x0FU) << 8) | data[1];
+      if (dlc < 8 || len <= 7U) {
+        return;
+      }
+      filling = BootIsoTp_StartMessage(len);
+      if (NULL == filling) {
+        uint8_t fc[3] = { BOOTISOTP_FC_OVERFLOW, 0, 0 };
+        BootIsoTp_SendFrame(fc, sizeof(fc));
+        return;
+      }
+      memcpy(filling->data, &data[2], 6);
+      filling->offset = 6;
+      rxSeq = 1;
+
+      // No block size or separation time limit
+      uint8_t fc[3] = { BOOTISOTP_FC_CTS, 0, 0 };
+      BootIsoTp_SendFrame(fc, sizeof(fc));
+      break;
+    }
+
+    case BOOTISOTP_PCI_CONSECUTIVE:
+    {
+      if (NULL == filling) {
+        return;
+      }
+      uint16_t remaining = filling->len - filling->offset;
+      uint8_t n = (remaining > 7U) ? 7U : (uint8_t)remaining;
+      if ((data[0] & 0x0FU) != rxSeq || n + 1U > dlc) {
+        filling->state = BOOTISOTP_BUFFER_FREE;
+        filling = NULL;
+        return;
+      }
+      memcpy(&filling->data[filling->offset], &data[1], n);
+      filling->offset += n;
+      rxSeq = (rxSeq + 1U) & 0x0FU;
+
+      if (filling->offset >= filling->len) {
+        BootIsoTp_CompleteMessage(filling);
+        filling = NULL;
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+uint8_t* BootIsoTp_Receive(uint16_t* len)
+{
+  BootIsoTp_Buffer_T* oldest = NULL;
+  size_t i;
+  for (i = 0; i < BOOTISOTP_NUM_BUFFERS; ++i) {
+    if (BOOTISOTP_BUFFER_READY == buffers[i].state &&
+        (NULL == oldest || (int32_t)(buffers[i].order - oldest->order) < 0)) {
+      oldest = &buffers[i];
+    }
+  }
+
+  if (NULL == oldest) {
+    return NULL;
+  }
+  *len = oldest->len;
+  return oldest->data;
+}
+
+//------------------------------------------------------------------------------
+void BootIsoTp_Release(uint8_t* buffer)
+{
+  size_t i;
+  for (i = 0; i < BOOTISOTP_NUM_BUFFERS; ++i) {
+    if (buffer == buffers[i].data) {
+      buffers[i].state = BOOTISOTP_BUFFER_FREE;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool BootIsoTp_Send(const uint8_t* data, uint8_t len)
+{
+  if (0 == len || len > 7U) {
+    return false;
+  }
+
+  uint8_t frame[8];
+  frame[0] = BOOTISOTP_PCI_SINGLE | len;
+  memcpy(&frame[1], data, len);
+
+  // Wait briefly for a mailbox, rather than drop a response
+  uint32_t start = HAL_GetTick();
+  while (0 == HAL_CAN_GetTxMailboxesFreeLevel(canHandle)) {
+    if (HAL_GetTick() - start > BOOTISOTP_FLUSH_TIMEOUT_MS) {
+      return false;
+    }
+  }
+
+  // Flow control frames are also sent from the RX interrupt
+  __disable_irq();
+  bool sent = BootIsoTp_SendFrame(frame, 1 + len);
+  __enable_irq();
+  return sent;
+}
+
+//------------------------------------------------------------------------------
+void BootIsoTp_Flush(void)
+{
+  uint32_t start = HAL_GetTick();
+  while (HAL_CAN_GetTxMailboxesFreeLevel(canHandle) < 3U) {
+    if (HAL_GetTick() - start > BOOTISOTP_FLUSH_TIMEOUT_MS) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,314 @@
+/*
+ * bootService.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "bootService.h"
+
+#include <string.h>
+
+#include "bootIsoTp.h"
+#include "bootFlash.h"
+#include "startup/bootControl.h"
+
+// ------------------- Private data -------------------
+#define SID_SESSION_CONTROL       0x10U
+#define SID_ECU_RESET             0x11U
+#define SID_REQUEST_DOWNLOAD      0x34U
+#define SID_TRANSFER_DATA         0x36U
+#define SID_TRANSFER_EXIT         0x37U
+#define SID_TESTER_PRESENT        0x3EU
+#define SID_POSITIVE_OFFSET       0x40U
+#define SID_NEGATIVE_RESPONSE     0x7FU
+
+#define NRC_SERVICE_NOT_SUPPORTED     0x11U
+#define NRC_SUBFUNCTION_NOT_SUPPORTED 0x12U
+#define NRC_INCORRECT_LENGTH          0x13U
+#define NRC_SEQUENCE_ERROR            0x24U
+#define NRC_OUT_OF_RANGE              0x31U
+#define NRC_PROGRAMMING_FAILURE       0x72U
+#define NRC_WRONG_BLOCK_SEQUENCE      0x73U
+#define NRC_RESPONSE_PENDING          0x78U
+
+#define SUPPRESS_POSITIVE_RESPONSE    0x80U
+
+typedef enum
+{
+  BOOTSERVICE_IDLE,
+  BOOTSERVICE_DOWNLOADING
+} BootService_State_T;
+
+static BootService_State_T state;
+static uint32_t downloadAddress;    /* Next address to program */
+static uint32_t downloadEnd;
+static uint32_t downloadLength;
+static uint8_t blockSequence;       /* Expected TransferData sequence counter */
+static bool programFailed;
+static bool resetRequested;
+
+/*
+ * Block received and acknowledged but not yet programmed
+ */
+static uint8_t* pendingBuffer;
+static const uint8_t* pendingData;
+static uint32_t pendingAddress;
+static uint16_t pendingLen;
+
+// ------------------- Private methods -------------------
+static inline uint32_t BootService_GetU32(const uint8_t* data)
+{
+  return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+         ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+static void BootService_Negative(uint8_t sid, uint8_t nrc)
+{
+  uint8_t res[3] = { SID_NEGATIVE_RESPONSE, sid, nrc };
+  BootIsoTp_Send(res, sizeof(res));
+}
+
+static void BootService_SessionResponse(uint8_t session)
+{
+  // P2 50ms, P2* 5000ms
+  uint8_t res[6] = { SID_SESSION_CONTROL + SID_POSITIVE_OFFSET, session, 0x00U, 0x32U, 0x01U, 0xF4U };
+  BootIsoTp_Send(res, sizeof(res));
+}
+
+static void BootService_ProgramPending(void)
+{
+  if (NULL == pendingBuffer) {
+    return;
+  }
+
+  if (!BootFlash_Program(pendingAddress, pendingData, pendingLen)) {
+    programFailed = true;
+  }
+
+  BootIsoTp_Release(pendingBuffer);
+  pendingBuffer = NULL;
+}
+
+static void BootService_RequestDownload(const uint8_t* req, uint16_t len)
+{
+  if (len != 11U || 0x44U != req[2]) {
+    BootService_Negative(req[0], NRC_INCORRECT_LENGTH);
+    return;
+  }
+
+  uint32_t address = BootService_GetU32(&req[3]);
+  uint32_t size = BootService_GetU32(&req[7]);
+  if (0x00U != req[1] ||
+      BOOTCONTROL_APP_ADDR != address ||
+      0 == size || 0 != (size % 4U) ||
+      size > BOOTCONTROL_APP_END - BOOTCONTROL_APP_ADDR) {
+    BootService_Negative(req[0], NRC_OUT_OF_RANGE);
+    return;
+  }
+
+  // Only the record sector here. Application sectors are erased as the
+  // download reaches them, so no single response waits on more than one erase.
+  BootService_Negative(req[0], NRC_RESPONSE_PENDING);
+  BootIsoTp_Flush();
+  if (!BootFlash_InvalidateRecord()) {
+    state = BOOTSERVICE_IDLE;
+    BootService_Negative(req[0], NRC_PROGRAMMING_FAILURE);
+    return;
+  }
+
+  state = BOOTSERVICE_DOWNLOADING;
+  downloadAddress = address;
+  downloadEnd = address + size;
+  downloadLength = size;
+  blockSequence = 1;
+  programFailed = false;
+
+  uint16_t maxBlock = BOOTSERVICE_BLOCK_SIZE + 2U;
+  uint8_t res[4] = { SID_REQUEST_DOWNLOAD + SID_POSITIVE_OFFSET, 0x20U, maxBlock >> 8, maxBlock & 0xFFU };
+  BootIsoTp_Send(res, sizeof(res));
+}
+
+/**
+ * @return true if the buffer is kept for programming
+ */
+static bool BootService_TransferData(uint8_t* req, uint16_t len)
+{
+  if (BOOTSERVICE_DOWNLOADING != state) {
+    BootService_Negative(req[0], NRC_SEQUENCE_ERROR);
+    return false;
+  }
+  if (programFailed) {
+    state = BOOTSERVICE_IDLE;
+    BootService_Negative(req[0], NRC_PROGRAMMING_FAILURE);
+    return false;
+  }
+  if (len < 3U || len > BOOTSERVICE_BLOCK_SIZE + 2U) {
+    BootService_Negative(req[0], NRC_INCORRECT_LENGTH);
+    return false;
+  }
+
+  uint16_t dataLen = len - 2U;
+  if (req[1] == (uint8_t)(blockSequence - 1U)) {
+    // Repeated block after a lost response, already accepted
+    uint8_t res[2] = { SID_TRANSFER_DATA + SID_POSITIVE_OFFSET, req[1] };
+    BootIsoTp_Send(res, sizeof(res));
+    return false;
+  }
+  if (req[1] != blockSequence) {
+    BootService_Negative(req[0], NRC_WRONG_BLOCK_SEQUENCE);
+    return false;
+  }
+  if (0 != (dataLen % 4U) || dataLen > downloadEnd - downloadAddress) {
+    BootService_Negative(req[0], NRC_OUT_OF_RANGE);
+    return false;
+  }
+
+  // Erasing stalls the CPU for up to a few seconds per sector, so each one
+  // gets its own response pending to restart the tester's P2* timer
+  while (BootFlash_EraseNeeded(downloadAddress + dataLen)) {
+    BootService_Negative(req[0], NRC_RESPONSE_PENDING);
+    BootIsoTp_Flush();
+    if (!BootFlash_EraseNext()) {
+      state = BOOTSERVICE_IDLE;
+      BootService_Negative(req[0], NRC_PROGRAMMING_FAILURE);
+      return false;
+    }
+  }
+
+  // Acknowledge first, so the next block is received while this one is programmed
+  uint8_t res[2] = { SID_TRANSFER_DATA + SID_POSITIVE_OFFSET, req[1] };
+  BootIsoTp_Send(res, sizeof(res));
+
+  pendingBuffer = req;
+  pendingData = &req[2];
+  pendingAddress = downloadAddress;
+  pendingLen = dataLen;
+
+  downloadAddress += dataLen;
+  blockSequence++;
+  return true;
+}
+
+static void BootService_TransferExit(const uint8_t* req, uint16_t len)
+{
+  if (BOOTSERVICE_DOWNLOADING != state || downloadAddress != downloadEnd) {
+    BootService_Negative(req[0], NRC_SEQUENCE_ERROR);
+    return;
+  }
+  if (len != 5U) {
+    BootService_Negative(req[0], NRC_INCORRECT_LENGTH);
+    return;
+  }
+
+  state = BOOTSERVICE_IDLE;
+  uint32_t expectedCrc = BootService_GetU32(&req[1]);
+  if (programFailed ||
+      expectedCrc != BootFlash_AppCrc(downloadLength) ||
+      !BootFlash_WriteRecord(downloadLength, expectedCrc)) {
+    BootService_Negative(req[0], NRC_PROGRAMMING_FAILURE);
+    return;
+  }
+
+  uint8_t res[1] = { SID_TRANSFER_EXIT + SID_POSITIVE_OFFSET };
+  BootIsoTp_Send(res, sizeof(res));
+}
+
+/**
+ * @return true if the buffer is kept for programming
+ */
+static bool BootService_Handle(uint8_t* req, uint16_t len)
+{
+  uint8_t sid = req[0];
+  uint8_t sub = (len > 1) ? req[1] : 0;
+  bool suppress = (sub & SUPPRESS_POSITIVE_RESPONSE) != 0;
+
+  switch (sid) {
+    case SID_SESSION_CONTROL:
+      if (len != 2U) {
+        BootService_Negative(sid, NRC_INCORRECT_LENGTH);
+      } else if ((sub & 0x7FU) != 0x01U && (sub & 0x7FU) != 0x02U) {
+        BootService_Negative(sid, NRC_SUBFUNCTION_NOT_SUPPORTED);
+      } else if (!suppress) {
+        // Always in the programming session while in the bootloader
+        BootService_SessionResponse(sub & 0x7FU);
+      }
+      break;
+
+    case SID_ECU_RESET:
+      if (len != 2U) {
+        BootService_Negative(sid, NRC_INCORRECT_LENGTH);
+      } else if ((sub & 0x7FU) != 0x01U) {
+        BootService_Negative(sid, NRC_SUBFUNCTION_NOT_SUPPORTED);
+      } else {
+        if (!suppress) {
+          uint8_t res[2] = { SID_ECU_RESET + SID_POSITIVE_OFFSET, 0x01U };
+          BootIsoTp_Send(res, sizeof(res));
+        }
+        resetRequested = true;
+      }
+      break;
+
+    case SID_TESTER_PRESENT:
+      if (len != 2U) {
+        BootService_Negative(sid, NRC_INCORRECT_LENGTH);
+      } else if (!suppress) {
+        uint8_t res[2] = { SID_TESTER_PRESENT + SID_POSITIVE_OFFSET, 0x00U };
+        BootIsoTp_Send(res, sizeof(res));
+      }
+      break;
+
+    case SID_REQUEST_DOWNLOAD:
+      BootService_RequestDownload(req, len);
+      break;
+
+    case SID_TRANSFER_DATA:
+      return BootService_TransferData(req, len);
+
+    case SID_TRANSFER_EXIT:
+      BootService_TransferExit(req, len);
+      break;
+
+    default:
+      BootService_Negative(sid, NRC_SERVICE_NOT_SUPPORTED);
+      break;
+  }
+  return false;
+}
+
+// ------------------- Public methods -------------------
+void BootService_Init(bool requested)
+{
+  state = BOOTSERVICE_IDLE;
+  programFailed = false;
+  resetRequested = false;
+  pendingBuffer = NULL;
+
+  if (requested) {
+    // Complete the application's programming session request
+    BootService_SessionResponse(0x02U);
+  }
+}
+
+//------------------------------------------------------------------------------
+void BootService_Process(void)
+{
+  // Program the last block. The next is being received meanwhile.
+  BootService_ProgramPending();
+
+  uint16_t len;
+  uint8_t* req = BootIsoTp_Receive(&len);
+  if (NULL == req) {
+    return;
+  }
+
+  if (!BootService_Handle(req, len)) {
+    BootIsoTp_Release(req);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool BootService_ResetRequested(void)
+{
+  return resetRequested;
+}
@@ -0,0 +1,195 @@
+/*
+ * main.c
+ *
+ * CAN bootloader entry point.
+ *
+ * Boots the application if its boot record and CRC are valid, unless the
+ * application requested an update. Otherwise stays in the bootloader and
+ * waits for a download over ISO-TP on CAN1.
+ *
+ * Runs from the 16MHz HSI with no RTOS, so it does not depend on the
+ * application's clock or peripheral configuration.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "stm32f7xx_hal.h"
+#include <stdbool.h>
+
+#include "bootIsoTp.h"
+#include "bootService.h"
+#include "bootFlash.h"
+
+#include "lib/crc/crc.h"
+#include "startup/bootControl.h"
+
+// ------------------- Private data -------------------
+static CAN_HandleTypeDef hcan1;
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Reads and clears the application's request to stay in the bootloader
+ */
+static bool Boot_CheckRequest(void)
+{
+  __HAL_RCC_PWR_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+
+  bool requested = (BOOTCONTROL_REQUEST_MAGIC == RTC->BKP0R);
+  RTC->BKP0R = 0;
+
+  HAL_PWR_DisableBkUpAccess();
+  return requested;
+}
+
+static void Boot_JumpToApp(void)
+{
+  const uint32_t* vectors = (const uint32_t*)BOOTCONTROL_APP_ADDR;
+  uint32_t stack = vectors[0];
+  void (*reset)(void) = (void (*)(void))vectors[1];
+
+  // Leave the core as it was out of reset
+  HAL_RCC_DeInit();
+  HAL_DeInit();
+  SysTick->CTRL = 0;
+  SysTick->LOAD = 0;
+  SysTick->VAL = 0;
+
+  __disable_irq();
+  size_t i;
+  for (i = 0; i < sizeof(NVIC->ICER) / sizeof(NVIC->ICER[0]); ++i) {
+    NVIC->ICER[i] = 0xFFFFFFFFU;
+    NVIC->ICPR[i] = 0xFFFFFFFFU;
+  }
+
+  SCB->VTOR = BOOTCONTROL_APP_ADDR;
+  __set_MSP(stack);
+  __enable_irq();
+
+  reset();
+}
+
+/**
+ * @brief CAN1 at 500kbit/s from the 16MHz HSI (prescaler 2, 16 time quanta), matching the application
+ */
+static bool Boot_CanInit(void)
+{
+  hcan1.Instance = CAN1;
+  hcan1.Init.Prescaler = 2;
+  hcan1.Init.Mode = CAN_MODE_NORMAL;
+  hcan1.Init.SyncJumpWidth = CAN_SJW_1TQ;
+  hcan1.Init.TimeSeg1 = CAN_BS1_13TQ;
+  hcan1.Init.TimeSeg2 = CAN_BS2_2TQ;
+  hcan1.Init.TimeTriggeredMode = DISABLE;
+  hcan1.Init.AutoBusOff = ENABLE;
+  hcan1.Init.AutoWakeUp = DISABLE;
+  hcan1.Init.AutoRetransmission = ENABLE;
+  hcan1.Init.ReceiveFifoLocked = DISABLE;
+  hcan1.Init.TransmitFifoPriority = ENABLE;
+  if (HAL_CAN_Init(&hcan1) != HAL_OK) {
+    return false;
+  }
+
+  // Only the diagnostic request ID
+  CAN_FilterTypeDef filter;
+  filter.FilterBank = 0;
+  filter.FilterMode = CAN_FILTERMODE_IDLIST;
+  filter.FilterScale = CAN_FILTERSCALE_32BIT;
+  filter.FilterIdHigh = BOOTCONTROL_CAN_ID_REQUEST << 5;
+  filter.FilterIdLow = 0;
+  filter.FilterMaskIdHigh = BOOTCONTROL_CAN_ID_REQUEST << 5;
+  filter.FilterMaskIdLow = 0;
+  filter.FilterFIFOAssignment = CAN_RX_FIFO0;
+  filter.FilterActivation = ENABLE;
+  filter.SlaveStartFilterBank = 14;
+  if (HAL_CAN_ConfigFilter(&hcan1, &filter) != HAL_OK) {
+    return false;
+  }
+
+  if (HAL_CAN_Start(&hcan1) != HAL_OK) {
+    return false;
+  }
+  if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK) {
+    return false;
+  }
+
+  HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 1, 0);
+  HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
+  return true;
+}
+
+// ------------------- HAL callbacks -------------------
+void HAL_CAN_MspInit(CAN_HandleTypeDef* hcan)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_CAN1_CLK_ENABLE();
+  __HAL_RCC_GPIOD_CLK_ENABLE();
+
+  // PD0 CAN1_RX, PD1 CAN1_TX
+  GPIO_InitStruct.Pin = GPIO_PIN_0|GPIO_PIN_1;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  GPIO_InitStruct.Alternate = GPIO_AF9_CAN1;
+  HAL_GPIO_Init(GPIOD, &GPIO_InitStruct);
+}
+
+void HAL_CAN_MspDeInit(CAN_HandleTypeDef* hcan)
+{
+  __HAL_RCC_CAN1_CLK_DISABLE();
+  HAL_GPIO_DeInit(GPIOD, GPIO_PIN_0|GPIO_PIN_1);
+  HAL_NVIC_DisableIRQ(CAN1_RX0_IRQn);
+}
+
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
+{
+  CAN_RxHeaderTypeDef header;
+  uint8_t data[8];
+  while (HAL_OK == HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &header, data)) {
+    if (CAN_ID_STD == header.IDE && BOOTCONTROL_CAN_ID_REQUEST == header.StdId) {
+      BootIsoTp_RxFrame(data, (uint8_t)header.DLC);
+    }
+  }
+}
+
+// ------------------- Interrupt handlers -------------------
+void SysTick_Handler(void)
+{
+  HAL_IncTick();
+}
+
+void CAN1_RX0_IRQHandler(void)
+{
+  HAL_CAN_IRQHandler(&hcan1);
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  HAL_Init();
+  Crc_Init();
+
+  bool requested = Boot_CheckRequest();
+  if (!requested && BootFlash_AppValid()) {
+    Boot_JumpToApp();
+  }
+
+  if (!Boot_CanInit()) {
+    // Nothing useful can be done without CAN - retry from reset
+    NVIC_SystemReset();
+  }
+
+  BootIsoTp_Init(&hcan1, BOOTCONTROL_CAN_ID_REQUEST, BOOTCONTROL_CAN_ID_RESPONSE);
+  BootService_Init(requested);
+
+  while (1) {
+    BootService_Process();
+
+    if (BootService_ResetRequested()) {
+      BootIsoTp_Flush();
+      NVIC_SystemReset();
+    }
+  }
+}
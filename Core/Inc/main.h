@@ -50,6 +50,8 @@ extern "C" {
 
 /* USER CODE END EM */
 
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
+
 /* Exported functions prototypes ---------------------------------------------*/
 void Error_Handler(void);
 
@@ -72,6 +74,23 @@ void Error_Handler(void);
 #define WATCHDOG_MR_GPIO_Port GPIOE
 #define LED_STATUS_Pin GPIO_PIN_12
 #define LED_STATUS_GPIO_Port GPIOB
+#define LATENCY_OUT_Pin GPIO_PIN_6
+#define LATENCY_OUT_GPIO_Port GPIOC
+#define LATENCY_IN_Pin GPIO_PIN_7
+#define LATENCY_IN_GPIO_Port GPIOC
+#define LATENCY_IN_EXTI_IRQn EXTI9_5_IRQn
+#define WHEELSPEED_FL_Pin GPIO_PIN_12
+#define WHEELSPEED_FL_GPIO_Port GPIOD
+#define WHEELSPEED_FL_EXTI_IRQn EXTI15_10_IRQn
+#define WHEELSPEED_FR_Pin GPIO_PIN_13
+#define WHEELSPEED_FR_GPIO_Port GPIOD
+#define WHEELSPEED_FR_EXTI_IRQn EXTI15_10_IRQn
+#define WHEELSPEED_RL_Pin GPIO_PIN_14
+#define WHEELSPEED_RL_GPIO_Port GPIOD
+#define WHEELSPEED_RL_EXTI_IRQn EXTI15_10_IRQn
+#define WHEELSPEED_RR_Pin GPIO_PIN_15
+#define WHEELSPEED_RR_GPIO_Port GPIOD
+#define WHEELSPEED_RR_EXTI_IRQn EXTI15_10_IRQn
 /* USER CODE BEGIN Private defines */
 
 /* USER CODE END Private defines */
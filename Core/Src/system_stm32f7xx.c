@@ -78,6 +78,10 @@
 /* #define VECT_TAB_SRAM */
 #define VECT_TAB_OFFSET  0x00 /*!< Vector Table base offset field. 
                                    This value must be a multiple of 0x200. */
+/*!< In flash, the vector table is used where it is linked: after the CAN
+     bootloader and boot record (see bootControl.h), at the start of flash for
+     the Debug link, or the bootloader's own. */
+extern uint32_t g_pfnVectors[];
 /******************************************************************************/
 
 /**
@@ -142,7 +146,7 @@ void SystemInit(void)
 #ifdef VECT_TAB_SRAM
   SCB->VTOR = RAMDTCM_BASE | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal SRAM */
 #else
-  SCB->VTOR = FLASH_BASE | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal FLASH */
+  SCB->VTOR = (uint32_t)g_pfnVectors; /* Vector Table Relocation in Internal FLASH */
 #endif
 }
 
@@ -0,0 +1,350 @@
+/*
+ * canCorpus.c
+ *
+ * Seeds the fuzz corpora from recorded CAN logs, so fuzzing starts from the
+ * traffic the firmware really sees and mutates outwards from it.
+ *
+ *   canCorpus [-f candump|asc] [-i name=bus] [-w frames] -o dir log...
+ *
+ * Writes, for each log:
+ *  - dir/can/<log>-<n>: every frame, in windows of -w frames, for fuzzCan.
+ *  - dir/xcp/<log>: the XCP command and STIM frames, for fuzzXcp.
+ *  - dir/isotp/<log>: the UDS request frames, for fuzzIsoTp.
+ *  - dir/uds/<log>: the UDS requests, reassembled, for fuzzUds.
+ * The timing between frames is kept, in each harness's units. Files are only
+ * written for logs with traffic of their kind.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <errno.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "canLog.h"
+
+#include "comm/xcp/xcpCan.h"
+#include "comm/uds/uds.h"
+#include "startup/bootControl.h"
+
+// ------------------- Private data -------------------
+#define CANCORPUS_MAX_BYTES     4096U
+
+typedef struct
+{
+  uint8_t data[CANCORPUS_MAX_BYTES];
+  size_t size;
+  uint64_t lastNs;      /* Time of the last frame written */
+  uint32_t frames;
+} CanCorpus_File_T;
+
+// A UDS request being reassembled from its ISO-TP frames
+typedef struct
+{
+  uint8_t data[UINT8_MAX];
+  uint16_t len;
+  uint16_t received;
+  uint8_t seq;
+  bool active;
+} CanCorpus_Request_T;
+
+// ------------------- Private methods -------------------
+static bool CanCorpus_Fits(const CanCorpus_File_T* file, size_t size)
+{
+  return file->size + size <= CANCORPUS_MAX_BYTES;
+}
+
+static void CanCorpus_Put(CanCorpus_File_T* file, const uint8_t* data, size_t size)
+{
+  memcpy(&file->data[file->size], data, size);
+  file->size += size;
+}
+
+static bool CanCorpus_Write(const CanCorpus_File_T* file, const char* dir, const char* kind, const char* name)
+{
+  if (0 == file->frames) {
+    return true;
+  }
+
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/%s", dir, kind);
+  if (0 != mkdir(path, 0777) && EEXIST != errno) {
+    fprintf(stderr, "Can't create %s\n", path);
+    return false;
+  }
+  snprintf(path, sizeof(path), "%s/%s/%s", dir, kind, name);
+  FILE* out = fopen(path, "wb");
+  if (NULL == out) {
+    fprintf(stderr, "Can't write %s\n", path);
+    return false;
+  }
+  fwrite(file->data, 1, file->size, out);
+  fclose(out);
+  return true;
+}
+
+/**
+ * @brief A frame record for fuzzCan
+ */
+static void CanCorpus_AddCan(CanCorpus_File_T* file, const CanLog_Frame_T* frame)
+{
+  uint8_t record[14];
+  size_t len = 0;
+  uint64_t delay = (frame->timeNs - file->lastNs) / 100000U;
+  uint8_t bus = (frame->bus > 3U) ? 1U : frame->bus;
+
+  record[len++] = (frame->dlc & 0x0FU) | (uint8_t)(bus << 4) | (frame->extended ? 0x40U : 0x00U);
+  record[len++] = (delay > 0xFFU) ? 0xFFU : (uint8_t)delay;
+  record[len++] = frame->id & 0xFFU;
+  record[len++] = (frame->id >> 8) & 0xFFU;
+  if (frame->extended) {
+    record[len++] = (frame->id >> 16) & 0xFFU;
+    record[len++] = (frame->id >> 24) & 0xFFU;
+  }
+  uint8_t n = (frame->dlc > 8U) ? 8U : frame->dlc;
+  memcpy(&record[len], frame->data, n);
+  len += n;
+
+  if (CanCorpus_Fits(file, len)) {
+    CanCorpus_Put(file, record, len);
+    file->lastNs = frame->timeNs;
+    file->frames++;
+  }
+}
+
+/**
+ * @brief A frame record for fuzzXcp or fuzzIsoTp. The ticks until the next
+ * frame go in the previous record, so they are filled in one frame late.
+ */
+static void CanCorpus_AddTicked(CanCorpus_File_T* file, const CanLog_Frame_T* frame, size_t* ctrlPos)
+{
+  uint8_t n = (frame->dlc > 8U) ? 8U : frame->dlc;
+  if (!CanCorpus_Fits(file, 1U + n)) {
+    return;
+  }
+
+  if (file->frames > 0) {
+    uint64_t ticks = (frame->timeNs / 1000000U) - (file->lastNs / 1000000U);
+    file->data[*ctrlPos] |= (uint8_t)(((ticks > 7U) ? 7U : ticks) << 4);
+  }
+
+  *ctrlPos = file->size;
+  uint8_t ctrl = frame->dlc & 0x0FU;
+  CanCorpus_Put(file, &ctrl, 1U);
+  CanCorpus_Put(file, frame->data, n);
+  file->lastNs = frame->timeNs;
+  file->frames++;
+}
+
+/**
+ * @brief A request record for fuzzUds, once a frame completes a request.
+ * Requests too long for the harness are skipped.
+ */
+static void CanCorpus_AddUds(CanCorpus_File_T* file, CanCorpus_Request_T* request, const CanLog_Frame_T* frame,
+                             size_t* ctrlPos)
+{
+  uint8_t n = (frame->dlc > 8U) ? 8U : frame->dlc;
+  if (n < 1U) {
+    return;
+  }
+
+  const uint8_t* data = frame->data;
+  switch (data[0] & 0xF0U) {
+    case 0x00U:
+      request->len = data[0] & 0x0FU;
+      if ((0 == request->len) || (request->len >= n)) {
+        return;
+      }
+      memcpy(request->data, &data[1], request->len);
+      request->received = request->len;
+      request->active = false;
+      break;
+    case 0x10U:
+      request->len = (((uint16_t)data[0] & 0x0FU) << 8) | data[1];
+      request->active = (8U == n) && (request->len > 6U) && (request->len <= UINT8_MAX);
+      if (request->active) {
+        memcpy(request->data, &data[2], 6U);
+        request->received = 6U;
+        request->seq = 1;
+      }
+      return;
+    case 0x20U:
+    {
+      if (!request->active || (request->seq != (data[0] & 0x0FU))) {
+        request->active = false;
+        return;
+      }
+      uint16_t remaining = request->len - request->received;
+      uint8_t take = (remaining > 7U) ? 7U : (uint8_t)remaining;
+      if (take > n - 1U) {
+        request->active = false;
+        return;
+      }
+      memcpy(&request->data[request->received], &data[1], take);
+      request->received += take;
+      request->seq = (request->seq + 1U) & 0x0FU;
+      if (request->received < request->len) {
+        return;
+      }
+      request->active = false;
+      break;
+    }
+    default:
+      return;
+  }
+
+  if (!CanCorpus_Fits(file, 2U + request->len)) {
+    return;
+  }
+  if (file->frames > 0) {
+    uint64_t passes = (frame->timeNs / 1000000U) / UDS_PERIOD_MS - (file->lastNs / 1000000U) / UDS_PERIOD_MS;
+    file->data[*ctrlPos] |= (uint8_t)((passes > 7U) ? 7U : passes);
+  }
+
+  *ctrlPos = file->size;
+  uint8_t header[2] = { 0x08U, (uint8_t)request->len };
+  CanCorpus_Put(file, header, sizeof(header));
+  CanCorpus_Put(file, request->data, request->len);
+  file->lastNs = frame->timeNs;
+  file->frames++;
+}
+
+static void CanCorpus_Usage(const char* name)
+{
+  fprintf(stderr, "usage: %s [-f candump|asc] [-i name=bus] [-w frames] -o dir log...\n", name);
+}
+
+// ------------------- Public methods -------------------
+int main(int argc, char* argv[])
+{
+  CanLog_Format_T format = CANLOG_FORMAT_AUTO;
+  const char* interfaces[CANLOG_MAX_INTERFACES];
+  uint8_t numInterfaces = 0;
+  uint32_t window = 16U;
+  const char* outDir = NULL;
+
+  int opt;
+  while (-1 != (opt = getopt(argc, argv, "f:i:w:o:"))) {
+    switch (opt) {
+      case 'f':
+        if (0 == strcmp(optarg, "candump")) {
+          format = CANLOG_FORMAT_CANDUMP;
+        } else if (0 == strcmp(optarg, "asc")) {
+          format = CANLOG_FORMAT_ASC;
+        } else {
+          CanCorpus_Usage(argv[0]);
+          return 1;
+        }
+        break;
+      case 'i':
+        if (numInterfaces >= CANLOG_MAX_INTERFACES) {
+          fprintf(stderr, "Too many interfaces\n");
+          return 1;
+        }
+        interfaces[numInterfaces++] = optarg;
+        break;
+      case 'w':
+        window = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'o':
+        outDir = optarg;
+        break;
+      default:
+        CanCorpus_Usage(argv[0]);
+        return 1;
+    }
+  }
+  if (NULL == outDir || optind >= argc || 0 == window) {
+    CanCorpus_Usage(argv[0]);
+    return 1;
+  }
+  if (0 != mkdir(outDir, 0777) && EEXIST != errno) {
+    fprintf(stderr, "Can't create %s\n", outDir);
+    return 1;
+  }
+
+  static CanCorpus_File_T can;
+  static CanCorpus_File_T xcp;
+  static CanCorpus_File_T isoTp;
+  static CanCorpus_File_T uds;
+  CanCorpus_Request_T request;
+  int arg;
+  for (arg = optind; arg < argc; ++arg) {
+    const char* path = argv[arg];
+    CanLog_Reader_T reader;
+    if (CANLOG_STATUS_OK != CanLog_Open(&reader, path, format)) {
+      fprintf(stderr, "Can't open %s\n", path);
+      return 1;
+    }
+    uint8_t i;
+    for (i = 0; i < numInterfaces; ++i) {
+      if (CANLOG_STATUS_OK != CanLog_AddInterface(&reader, interfaces[i])) {
+        fprintf(stderr, "Bad interface mapping %s\n", interfaces[i]);
+        return 1;
+      }
+    }
+
+    char pathCopy[4096];
+    snprintf(pathCopy, sizeof(pathCopy), "%s", path);
+    const char* name = basename(pathCopy);
+
+    memset(&can, 0, sizeof(can));
+    memset(&xcp, 0, sizeof(xcp));
+    memset(&isoTp, 0, sizeof(isoTp));
+    memset(&uds, 0, sizeof(uds));
+    memset(&request, 0, sizeof(request));
+    // fuzzIsoTp's channel configuration: no block size limit or STmin
+    uint8_t channelConfig[2] = { 0, 0 };
+    CanCorpus_Put(&isoTp, channelConfig, sizeof(channelConfig));
+    size_t xcpCtrl = 0;
+    size_t isoTpCtrl = 0;
+    size_t udsCtrl = 0;
+    uint32_t windows = 0;
+
+    CanLog_Frame_T frame;
+    CanLog_Status_T status;
+    while (CANLOG_STATUS_OK == (status = CanLog_Next(&reader, &frame))) {
+      if (frame.remote) {
+        continue;
+      }
+
+      CanCorpus_AddCan(&can, &frame);
+      if (can.frames >= window) {
+        char canName[4096];
+        snprintf(canName, sizeof(canName), "%s-%u", name, windows++);
+        if (!CanCorpus_Write(&can, outDir, "can", canName)) {
+          return 1;
+        }
+        memset(&can, 0, sizeof(can));
+        can.lastNs = frame.timeNs;
+      }
+
+      if (!frame.extended && XCPCAN_CAN_ID_CMD == frame.id) {
+        CanCorpus_AddTicked(&xcp, &frame, &xcpCtrl);
+      } else if (!frame.extended && BOOTCONTROL_CAN_ID_REQUEST == frame.id) {
+        CanCorpus_AddTicked(&isoTp, &frame, &isoTpCtrl);
+        CanCorpus_AddUds(&uds, &request, &frame, &udsCtrl);
+      }
+    }
+    CanLog_Close(&reader);
+    if (CANLOG_STATUS_ERROR == status) {
+      fprintf(stderr, "Error reading %s at line %llu\n", path, (unsigned long long)reader.line);
+      return 1;
+    }
+
+    char canName[4096];
+    snprintf(canName, sizeof(canName), "%s-%u", name, windows);
+    if (!CanCorpus_Write(&can, outDir, "can", canName) ||
+        !CanCorpus_Write(&xcp, outDir, "xcp", name) ||
+        !CanCorpus_Write(&isoTp, outDir, "isotp", name) ||
+        !CanCorpus_Write(&uds, outDir, "uds", name)) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * fuzzCan.c
+ *
+ * Fuzzes the CAN receive dispatch and the parsers of the CAN facing modules
+ * on the simulation, as canReplay runs them: the RX hook into canRecorder,
+ * canMonitor, and the callbacks of inverter and vehicleState.
+ *
+ * Each input is a sequence of frames:
+ *   ctrl    bits 0-3: DLC as the CAN controller reports it, 0-15
+ *           bits 4-5: bus 1-3, 0 is bus 1
+ *           bit 6:    extended ID
+ *   delay   time since the previous frame, in 100us
+ *   id      2 bytes, or 4 if extended, little endian
+ *   data    min(DLC, 8) bytes
+ *
+ * The modules create static tasks, so they are started once and carry their
+ * state from one input to the next, as on a car that stays powered. The
+ * simulated time carries on too. A crash may therefore need the inputs before
+ * it, which libFuzzer keeps in its crash reports. The pedals are stood in for
+ * as in canReplay.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fuzzInput.h"
+
+#include "hostSim.h"
+#include "hostCan.h"
+
+#include "lib/logging/logging.h"
+#include "lib/signalDb/signalDb.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "time/cycleCounter/cycleCounter.h"
+#include "time/deferred/deferred.h"
+#include "device/inverter/inverter.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+int LLVMFuzzerInitialize(int* argc, char*** argv);
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// ------------------- Private data -------------------
+#define FUZZCAN_DELAY_NS    100000U
+
+static Logging_T fuzzLog;
+static uint64_t timeNs;
+
+// ------------------- Private methods -------------------
+static void FuzzCan_Tx(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc)
+{
+  (void)data;
+  if (dlc > 8U) {
+    fprintf(stderr, "Sent %u bytes on bus %u, ID 0x%X\n", dlc, bus, id);
+    abort();
+  }
+  CanRecorder_TxComplete(HostCan_GetHandle(bus), 0);
+}
+
+static void FuzzCan_Rx(CAN_HandleTypeDef* hcan)
+{
+  CanRecorder_RxPending(hcan, CAN_RX_FIFO0);
+}
+
+/**
+ * @brief Released pedals, no faults, published every period
+ */
+static void FuzzCan_Tick(uint64_t tickNs)
+{
+  if (0 != (tickNs / HOSTSIM_TICK_NS) % PEDALS_PERIOD_MS) {
+    return;
+  }
+
+  uint32_t now = CycleCounter_Get();
+  SignalDb_Set(MAPPING_SIGNAL_APPS_POSITION, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_BRAKE_POSITION, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_BRAKE_PRESSED, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_TORQUE_REQUEST, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_PEDAL_FAULTS, (float)PEDALS_FAULT_NONE, true, now);
+  SignalDb_Publish(MAPPING_SIGNAL_GROUP_PEDALS);
+}
+
+/**
+ * @brief The CAN facing modules, in the order initialize.c starts them
+ */
+static bool FuzzCan_InitFirmware(void)
+{
+  Log_Init(&fuzzLog);
+
+  if (DEFERRED_STATUS_OK != Deferred_Init(&fuzzLog)) {
+    return false;
+  }
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  if (SIGNALDB_STATUS_OK != SignalDb_Init(&fuzzLog, signalGroups, numSignalGroups)) {
+    return false;
+  }
+
+  if (CANMONITOR_STATUS_OK != CanMonitor_Init(&fuzzLog) ||
+      CANRECORDER_STATUS_OK != CanRecorder_Init(&fuzzLog) ||
+      INVERTER_STATUS_OK != Inverter_Init(&fuzzLog, &hcan1) ||
+      VEHICLESTATE_STATUS_OK != VehicleState_Init(&fuzzLog, &hcan1)) {
+    return false;
+  }
+  return true;
+}
+
+// ------------------- Fuzzer -------------------
+int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void)argc;
+  (void)argv;
+  if (!FuzzCan_InitFirmware()) {
+    fprintf(stderr, "Firmware initialization failed\n");
+    abort();
+  }
+  HostCan_SetRxHook(FuzzCan_Rx);
+  HostCan_SetTxHook(FuzzCan_Tx);
+  HostSim_SetTickHook(FuzzCan_Tick);
+  HostSim_Start();
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  FuzzInput_T input = { data, size, 0 };
+
+  while (!FuzzInput_Done(&input)) {
+    uint8_t ctrl = FuzzInput_U8(&input);
+    uint8_t dlc = ctrl & 0x0FU;
+    uint8_t bus = (ctrl >> 4) & 0x03U;
+    bool extended = (ctrl & 0x40U) != 0;
+
+    timeNs += (uint64_t)FuzzInput_U8(&input) * FUZZCAN_DELAY_NS;
+    uint32_t id = extended ? (FuzzInput_U32(&input) & 0x1FFFFFFFU) : (FuzzInput_U16(&input) & 0x7FFU);
+    uint8_t frame[8];
+    FuzzInput_Bytes(&input, frame, (dlc > 8U) ? 8U : dlc);
+
+    // HostCan_Receive treats IDs above 0x7FF as extended
+    if (extended && id <= 0x7FFU) {
+      id |= 0x800U;
+    }
+
+    HostSim_AdvanceTo(timeNs);
+    HostSim_EnterIsr();
+    HostCan_Receive((0 == bus) ? 1U : bus, id, frame, dlc);
+    HostSim_ExitIsr();
+    HostSim_RunUntilIdle();
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * fuzzInput.h
+ *
+ * Reads fields from a fuzz input. Reads past the end return zeros, so every
+ * input is a complete, if short, test case.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef FUZZINPUT_H_
+#define FUZZINPUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef struct
+{
+  const uint8_t* data;
+  size_t size;
+  size_t pos;
+} FuzzInput_T;
+
+static inline bool FuzzInput_Done(const FuzzInput_T* input)
+{
+  return input->pos >= input->size;
+}
+
+/**
+ * @brief Copies up to len bytes, zero filling past the end of the input
+ */
+static inline void FuzzInput_Bytes(FuzzInput_T* input, uint8_t* dest, size_t len)
+{
+  size_t n = 0;
+  if (input->pos < input->size) {
+    n = input->size - input->pos;
+    if (n > len) {
+      n = len;
+    }
+    memcpy(dest, &input->data[input->pos], n);
+    input->pos += n;
+  }
+  memset(&dest[n], 0, len - n);
+}
+
+static inline uint8_t FuzzInput_U8(FuzzInput_T* input)
+{
+  uint8_t value;
+  FuzzInput_Bytes(input, &value, 1U);
+  return value;
+}
+
+static inline uint16_t FuzzInput_U16(FuzzInput_T* input)
+{
+  uint8_t bytes[2];
+  FuzzInput_Bytes(input, bytes, sizeof(bytes));
+  return (uint16_t)bytes[0] | ((uint16_t)bytes[1] << 8);
+}
+
+static inline uint32_t FuzzInput_U32(FuzzInput_T* input)
+{
+  uint8_t bytes[4];
+  FuzzInput_Bytes(input, bytes, sizeof(bytes));
+  return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+         ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * @brief Any bit pattern, including NaN and infinities
+ */
+static inline float FuzzInput_Float(FuzzInput_T* input)
+{
+  uint32_t bits = FuzzInput_U32(input);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief A value in [min, max], spread evenly over 16 bits
+ */
+static inline float FuzzInput_Range(FuzzInput_T* input, float min, float max)
+{
+  return min + (max - min) * ((float)FuzzInput_U16(input) / 65535.0f);
+}
+
+#endif /* FUZZINPUT_H_ */
@@ -0,0 +1,256 @@
+/*
+ * fuzzIsoTp.c
+ *
+ * Fuzzes the ISO-TP layer: the frame parsers in its CAN callback, message
+ * reassembly into the buffer pool, flow control, and the sending state
+ * machine paced by the task and TX complete interrupts.
+ *
+ * Each input is the receive channel's block size and STmin, then a sequence
+ * of records:
+ *   ctrl    bits 0-3: DLC as the CAN controller reports it, 0-15
+ *           bits 4-6: timer ticks to run the task for after the record
+ *           bit 7:    send a message of the length in the next two bytes,
+ *                     rather than receive a frame
+ *   data    min(DLC, 8) bytes, for a frame
+ * The three TX mailboxes complete after each record.
+ *
+ * Every input starts from IsoTp_Init and one open channel. Checks, besides
+ * the sanitizers:
+ *  - Every frame sent is a full frame on the channel's TX ID.
+ *  - A message being sent goes out in order, with the bytes it was sent
+ *    with and its sequence numbers counting up.
+ *  - Received messages are within the maximum length and in a pool buffer.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fuzzInput.h"
+#include "fuzzRtos.h"
+
+#include "comm/can/can.h"
+#include "comm/isotp/isotp.h"
+#include "startup/bootControl.h"
+
+int LLVMFuzzerInitialize(int* argc, char*** argv);
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// ------------------- Private data -------------------
+// The UDS channel
+#define FUZZISOTP_RX_ID         BOOTCONTROL_CAN_ID_REQUEST
+#define FUZZISOTP_TX_ID         BOOTCONTROL_CAN_ID_RESPONSE
+#define FUZZISOTP_MAILBOXES     3U
+
+static Logging_T fuzzLog;
+
+// Any bus will do, CAN is stubbed below
+static CAN_HandleTypeDef isoTpCan;
+static CAN_Callback isoTpCallback;
+static uint32_t freeMailboxes;
+
+static IsoTp_Channel_T channel;
+static uint8_t message[ISOTP_MAX_MESSAGE_LEN];
+
+// The message being sent, as seen on the bus
+static bool txActive;
+static uint16_t txLen;
+static uint16_t txOffset;
+static uint8_t txSeq;
+
+// ------------------- Private methods -------------------
+static void FuzzIsoTp_Fail(const char* check, const uint8_t* frame)
+{
+  fprintf(stderr, "%s: frame %02X %02X %02X %02X %02X %02X %02X %02X, sent %u of %u\n", check,
+      frame[0], frame[1], frame[2], frame[3], frame[4], frame[5], frame[6], frame[7], txOffset, txLen);
+  abort();
+}
+
+static void FuzzIsoTp_CheckData(const uint8_t* frame, const uint8_t* data, uint16_t n)
+{
+  if (txOffset + n > txLen || 0 != memcmp(data, &message[txOffset], n)) {
+    FuzzIsoTp_Fail("Message data", frame);
+  }
+  txOffset += n;
+}
+
+static void FuzzIsoTp_Rx(IsoTp_Channel_T ch, uint8_t* data, uint16_t len)
+{
+  (void)ch;
+  if (0 == len || len > ISOTP_MAX_MESSAGE_LEN) {
+    fprintf(stderr, "Received message of %u bytes\n", len);
+    abort();
+  }
+  // Owned by the callback until it is freed, so all of it may be written
+  memset(data, 0, len);
+  IsoTp_FreeBuffer(data);
+}
+
+static void FuzzIsoTp_Tx(IsoTp_Channel_T ch, IsoTp_Status_T status)
+{
+  (void)ch;
+  if (ISOTP_STATUS_OK == status && txActive && txOffset != txLen) {
+    fprintf(stderr, "Send completed at %u of %u\n", txOffset, txLen);
+    abort();
+  }
+  txActive = false;
+}
+
+// ------------------- HAL and CAN -------------------
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef* hcan)
+{
+  (void)hcan;
+  return freeMailboxes;
+}
+
+//------------------------------------------------------------------------------
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef* hcan, uint32_t ActiveITs)
+{
+  (void)hcan;
+  (void)ActiveITs;
+  return HAL_OK;
+}
+
+//------------------------------------------------------------------------------
+CAN_Status_T CAN_SendMessage(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len)
+{
+  if (&isoTpCan != handle || FUZZISOTP_TX_ID != id || 8U != len || 0 == freeMailboxes) {
+    fprintf(stderr, "Bad ISO-TP frame: ID 0x%X, %u bytes, %u mailboxes free\n", id, len, freeMailboxes);
+    abort();
+  }
+  freeMailboxes--;
+
+  switch (data[0] & 0xF0U) {
+    case 0x00U:
+      if (!txActive || txLen != (data[0] & 0x0FU)) {
+        FuzzIsoTp_Fail("Single frame", data);
+      }
+      FuzzIsoTp_CheckData(data, &data[1], txLen);
+      break;
+    case 0x10U:
+      if (!txActive || 0 != txOffset || txLen != ((((uint16_t)data[0] & 0x0FU) << 8) | data[1])) {
+        FuzzIsoTp_Fail("First frame", data);
+      }
+      FuzzIsoTp_CheckData(data, &data[2], 6U);
+      txSeq = 1;
+      break;
+    case 0x20U:
+    {
+      if (!txActive || 0 == txOffset || txSeq != (data[0] & 0x0FU)) {
+        FuzzIsoTp_Fail("Consecutive frame", data);
+      }
+      uint16_t remaining = txLen - txOffset;
+      FuzzIsoTp_CheckData(data, &data[1], (remaining > 7U) ? 7U : remaining);
+      txSeq = (txSeq + 1U) & 0x0FU;
+      break;
+    }
+    case 0x30U:
+      // Flow control for a message being received
+      break;
+    default:
+      FuzzIsoTp_Fail("Frame type", data);
+      break;
+  }
+  return CAN_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CAN_Status_T CAN_RegisterCallback(CAN_HandleTypeDef* handle, uint32_t id, CAN_Callback callback)
+{
+  if (&isoTpCan != handle || FUZZISOTP_RX_ID != id) {
+    return CAN_STATUS_ERROR;
+  }
+  isoTpCallback = callback;
+  return CAN_STATUS_OK;
+}
+
+// ------------------- Fuzzer -------------------
+int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void)argc;
+  (void)argv;
+  Log_Init(&fuzzLog);
+
+  uint32_t i;
+  for (i = 0; i < sizeof(message); ++i) {
+    message[i] = (uint8_t)(i * 7U + 1U);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  FuzzInput_T input = { data, size, 0 };
+
+  IsoTp_ChannelConfig_T config = {
+    .hcan = &isoTpCan,
+    .txId = FUZZISOTP_TX_ID,
+    .rxId = FUZZISOTP_RX_ID,
+    .blockSize = FuzzInput_U8(&input),
+    .stMin = FuzzInput_U8(&input),
+    .rxCallback = FuzzIsoTp_Rx,
+    .txCallback = FuzzIsoTp_Tx
+  };
+
+  FuzzRtos_Reset(0);
+  isoTpCallback = NULL;
+  freeMailboxes = FUZZISOTP_MAILBOXES;
+  txActive = false;
+  if (ISOTP_STATUS_OK != IsoTp_Init(&fuzzLog) ||
+      ISOTP_STATUS_OK != IsoTp_Open(&config, &channel) ||
+      NULL == isoTpCallback) {
+    abort();
+  }
+
+  while (!FuzzInput_Done(&input)) {
+    uint8_t ctrl = FuzzInput_U8(&input);
+
+    if (ctrl & 0x80U) {
+      uint16_t len = FuzzInput_U16(&input);
+      bool wasActive = txActive;
+      if (!wasActive) {
+        txActive = true;
+        txLen = len;
+        txOffset = 0;
+      }
+      IsoTp_Status_T status = IsoTp_Send(channel, message, len);
+      if (ISOTP_STATUS_OK != status && !wasActive) {
+        txActive = false;
+      }
+    } else {
+      CAN_DataFrame_T frame;
+      memset(&frame, 0, sizeof(frame));
+      frame.handle = &isoTpCan;
+      frame.msgId = FUZZISOTP_RX_ID;
+      frame.dlc = ctrl & 0x0FU;
+      FuzzInput_Bytes(&input, frame.data, (frame.dlc > 8U) ? 8U : frame.dlc);
+      isoTpCallback(&frame);
+    }
+
+    if (freeMailboxes < FUZZISOTP_MAILBOXES) {
+      freeMailboxes = FUZZISOTP_MAILBOXES;
+      IsoTp_TxCompleteCallback(&isoTpCan);
+    }
+
+    uint32_t ticks = (ctrl >> 4) & 0x07U;
+    uint32_t i;
+    for (i = 0; i < ticks; ++i) {
+      FuzzRtos_Run(1);
+    }
+  }
+
+  // Every buffer is back in the pool, but for a message still being received
+  uint32_t available = 0;
+  while (NULL != IsoTp_AllocBuffer()) {
+    available++;
+  }
+  if (available + 1U < ISOTP_NUM_BUFFERS) {
+    fprintf(stderr, "Buffers leaked: %u of %u free\n", available, ISOTP_NUM_BUFFERS);
+    abort();
+  }
+  return 0;
+}
@@ -0,0 +1,306 @@
+/*
+ * fuzzMain.c
+ *
+ * Runs a fuzz harness without libFuzzer, for compilers that don't have it.
+ * The same harness builds against libFuzzer with HOST_FUZZ, see README.md.
+ *
+ *   fuzzX [-n mutations] [-s seed] [-m max bytes] [corpus...]
+ *
+ * Each corpus file, or file in a corpus directory, is run once. Then inputs
+ * mutated from the corpus are run: bit flips, byte changes, inserts, erases,
+ * copies and splices of two inputs. With no corpus, mutation starts from an
+ * empty input. Nothing guides the mutations, so this finds shallow bugs
+ * only, but it runs under the same sanitizers.
+ *
+ * If the harness fails, the input is written to crash-<seed>-<n> in the
+ * working directory, and can be run again on its own.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+int LLVMFuzzerInitialize(int* argc, char*** argv) __attribute__((weak));
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+void __sanitizer_set_death_callback(void (*callback)(void)) __attribute__((weak));
+
+// ------------------- Private data -------------------
+#define FUZZMAIN_MAX_INPUTS   4096U
+
+typedef struct
+{
+  uint8_t* data;
+  size_t size;
+} FuzzMain_Input_T;
+
+static FuzzMain_Input_T corpus[FUZZMAIN_MAX_INPUTS];
+static uint32_t corpusCount;
+
+static size_t maxSize = 4096U;
+static uint64_t randomState;
+
+// The input being run, saved if the harness dies
+static const uint8_t* currentData;
+static size_t currentSize;
+static char currentName[64];
+
+// ------------------- Private methods -------------------
+static uint64_t FuzzMain_Random(void)
+{
+  // xorshift64*
+  randomState ^= randomState >> 12;
+  randomState ^= randomState << 25;
+  randomState ^= randomState >> 27;
+  return randomState * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t FuzzMain_Below(size_t n)
+{
+  return (0 == n) ? 0 : (size_t)(FuzzMain_Random() % n);
+}
+
+static void FuzzMain_SaveCrash(void)
+{
+  if (NULL == currentData || '\0' == currentName[0]) {
+    return;
+  }
+  FILE* file = fopen(currentName, "wb");
+  if (NULL != file) {
+    fwrite(currentData, 1, currentSize, file);
+    fclose(file);
+    fprintf(stderr, "Input written to %s\n", currentName);
+  }
+  currentData = NULL;
+}
+
+static void FuzzMain_Signal(int sig)
+{
+  FuzzMain_SaveCrash();
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+static void FuzzMain_Run(const uint8_t* data, size_t size, const char* crashName)
+{
+  currentData = data;
+  currentSize = size;
+  snprintf(currentName, sizeof(currentName), "%s", crashName);
+  LLVMFuzzerTestOneInput(data, size);
+  currentData = NULL;
+}
+
+static void FuzzMain_AddFile(const char* path)
+{
+  if (corpusCount >= FUZZMAIN_MAX_INPUTS) {
+    return;
+  }
+
+  FILE* file = fopen(path, "rb");
+  if (NULL == file) {
+    fprintf(stderr, "Can't read %s\n", path);
+    exit(1);
+  }
+  uint8_t* data = malloc(maxSize);
+  size_t size = fread(data, 1, maxSize, file);
+  fclose(file);
+
+  corpus[corpusCount].data = data;
+  corpus[corpusCount].size = size;
+  corpusCount++;
+}
+
+static void FuzzMain_AddPath(const char* path)
+{
+  struct stat info;
+  if (0 != stat(path, &info)) {
+    fprintf(stderr, "Can't read %s\n", path);
+    exit(1);
+  }
+  if (!S_ISDIR(info.st_mode)) {
+    FuzzMain_AddFile(path);
+    return;
+  }
+
+  DIR* dir = opendir(path);
+  struct dirent* entry;
+  while (NULL != dir && NULL != (entry = readdir(dir))) {
+    char child[4096];
+    snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+    if ('.' != entry->d_name[0] && 0 == stat(child, &info) && S_ISREG(info.st_mode)) {
+      FuzzMain_AddFile(child);
+    }
+  }
+  if (NULL != dir) {
+    closedir(dir);
+  }
+}
+
+/**
+ * @brief Mutates a corpus input into dest
+ * @return The mutated size
+ */
+static size_t FuzzMain_Mutate(uint8_t* dest)
+{
+  const FuzzMain_Input_T* base = &corpus[FuzzMain_Below(corpusCount)];
+  size_t size = base->size;
+  memcpy(dest, base->data, size);
+
+  uint32_t count = 1U + (uint32_t)FuzzMain_Below(4);
+  uint32_t i;
+  for (i = 0; i < count; ++i) {
+    size_t pos = FuzzMain_Below(size);
+    switch (FuzzMain_Below(7)) {
+      case 0:   // Flip a bit
+        if (size > 0) {
+          dest[pos] ^= (uint8_t)(1U << FuzzMain_Below(8));
+        }
+        break;
+      case 1:   // Change a byte
+        if (size > 0) {
+          dest[pos] = (uint8_t)FuzzMain_Random();
+        }
+        break;
+      case 2:   // Interesting byte
+        if (size > 0) {
+          static const uint8_t interesting[] = { 0x00, 0x01, 0x07, 0x08, 0x0F, 0x10, 0x7F, 0x80, 0xFF };
+          dest[pos] = interesting[FuzzMain_Below(sizeof(interesting))];
+        }
+        break;
+      case 3:   // Insert bytes
+      {
+        size_t n = 1U + FuzzMain_Below(64);
+        if (size + n <= maxSize) {
+          memmove(&dest[pos + n], &dest[pos], size - pos);
+          size_t j;
+          for (j = 0; j < n; ++j) {
+            dest[pos + j] = (uint8_t)FuzzMain_Random();
+          }
+          size += n;
+        }
+        break;
+      }
+      case 4:   // Erase bytes
+      {
+        size_t n = 1U + FuzzMain_Below(8);
+        if (pos + n <= size) {
+          memmove(&dest[pos], &dest[pos + n], size - pos - n);
+          size -= n;
+        }
+        break;
+      }
+      case 5:   // Copy a run within the input
+      {
+        size_t from = FuzzMain_Below(size);
+        size_t n = 1U + FuzzMain_Below(16);
+        if (from + n <= size && pos + n <= size) {
+          memmove(&dest[pos], &dest[from], n);
+        }
+        break;
+      }
+      default:  // Splice in the end of another input
+      {
+        const FuzzMain_Input_T* other = &corpus[FuzzMain_Below(corpusCount)];
+        size_t from = FuzzMain_Below(other->size);
+        size_t n = other->size - from;
+        if (pos + n > maxSize) {
+          n = maxSize - pos;
+        }
+        memcpy(&dest[pos], &other->data[from], n);
+        size = pos + n;
+        break;
+      }
+    }
+  }
+  return size;
+}
+
+static void FuzzMain_Usage(const char* name)
+{
+  fprintf(stderr, "usage: %s [-n mutations] [-s seed] [-m max bytes] [corpus...]\n", name);
+}
+
+// ------------------- Public methods -------------------
+int main(int argc, char* argv[])
+{
+  uint64_t mutations = 0;
+  uint64_t seed = 1;
+
+  int opt;
+  while (-1 != (opt = getopt(argc, argv, "n:s:m:"))) {
+    switch (opt) {
+      case 'n':
+        mutations = strtoull(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = strtoull(optarg, NULL, 0);
+        break;
+      case 'm':
+        maxSize = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        FuzzMain_Usage(argv[0]);
+        return 1;
+    }
+  }
+  if (0 == maxSize) {
+    FuzzMain_Usage(argv[0]);
+    return 1;
+  }
+
+  if (NULL != LLVMFuzzerInitialize) {
+    LLVMFuzzerInitialize(&argc, &argv);
+  }
+  if (NULL != __sanitizer_set_death_callback) {
+    __sanitizer_set_death_callback(FuzzMain_SaveCrash);
+  }
+  signal(SIGABRT, FuzzMain_Signal);
+  signal(SIGSEGV, FuzzMain_Signal);
+  signal(SIGBUS, FuzzMain_Signal);
+
+  int i;
+  for (i = optind; i < argc; ++i) {
+    FuzzMain_AddPath(argv[i]);
+  }
+  if (0 == corpusCount) {
+    corpus[0].data = malloc(maxSize);
+    corpus[0].size = 0;
+    corpusCount = 1;
+  }
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  // Crashes in the corpus are reproduced from the corpus file itself
+  uint32_t j;
+  for (j = 0; j < corpusCount; ++j) {
+    FuzzMain_Run(corpus[j].data, corpus[j].size, "");
+  }
+
+  randomState = (seed * 0x9E3779B97F4A7C15ULL) | 1U;
+  uint8_t* input = malloc(maxSize);
+  uint64_t n;
+  for (n = 0; n < mutations; ++n) {
+    char crashName[64];
+    snprintf(crashName, sizeof(crashName), "crash-%llu-%llu", (unsigned long long)seed, (unsigned long long)n);
+    size_t size = FuzzMain_Mutate(input);
+    FuzzMain_Run(input, size, crashName);
+  }
+  free(input);
+
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double seconds = (double)(end.tv_sec - start.tv_sec) + 1e-9 * (double)(end.tv_nsec - start.tv_nsec);
+  uint64_t runs = corpusCount + mutations;
+  printf("%u corpus inputs, %llu mutations, %.0f execs/s\n",
+      corpusCount, (unsigned long long)mutations, (seconds > 0.0) ? (double)runs / seconds : 0.0);
+  return 0;
+}
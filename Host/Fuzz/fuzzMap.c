@@ -0,0 +1,284 @@
+/*
+ * fuzzMap.c
+ *
+ * Fuzzes the lib/map lookups with maps and inputs built from the fuzz input.
+ *
+ * Maps are what the Application could declare: finite breakpoints and values
+ * of a sensible magnitude, strictly increasing table axes, and fixed point
+ * shifts of at most MAP_Q_MAX_SHIFT. The inputs are any value, including NaN
+ * and the infinities.
+ *
+ * Each input is a map kind byte, the map, then lookups until the input ends.
+ * Table lookups share one cache, so the cached, neighbour and binary search
+ * paths are all taken. Checks, besides the sanitizers:
+ *  - Table lookups match a linear search of the same map exactly.
+ *  - Uniform lookups of finite inputs lie within the map's values, and
+ *    inputs beyond the ends give the end values.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fuzzInput.h"
+
+#include "lib/map/map.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// ------------------- Private data -------------------
+#define FUZZMAP_MAX_POINTS    64U
+#define FUZZMAP_MAX_VALUE     1.0e6f
+
+typedef enum
+{
+  FUZZMAP_UNIFORM1D,
+  FUZZMAP_UNIFORM2D,
+  FUZZMAP_UNIFORM1D_Q,
+  FUZZMAP_TABLE1D,
+  FUZZMAP_TABLE2D,
+  FUZZMAP_NUM_KINDS
+} FuzzMap_Kind_T;
+
+static float axisX[FUZZMAP_MAX_POINTS];
+static float axisY[FUZZMAP_MAX_POINTS];
+static float values[FUZZMAP_MAX_POINTS * FUZZMAP_MAX_POINTS];
+static int16_t valuesQ[FUZZMAP_MAX_POINTS];
+
+// ------------------- Private methods -------------------
+static void FuzzMap_Fail(const char* check, float x, float y, float result, float expected)
+{
+  fprintf(stderr, "%s: lookup (%g, %g) gave %g, expected %g\n", check, x, y, result, expected);
+  abort();
+}
+
+static uint16_t FuzzMap_Points(FuzzInput_T* input)
+{
+  return 2U + FuzzInput_U8(input) % (FUZZMAP_MAX_POINTS - 1U);
+}
+
+static void FuzzMap_Values(FuzzInput_T* input, float* dest, uint32_t count, float* min, float* max)
+{
+  *min = INFINITY;
+  *max = -INFINITY;
+  uint32_t i;
+  for (i = 0; i < count; ++i) {
+    dest[i] = FuzzInput_Range(input, -FUZZMAP_MAX_VALUE, FUZZMAP_MAX_VALUE);
+    *min = fminf(*min, dest[i]);
+    *max = fmaxf(*max, dest[i]);
+  }
+}
+
+/**
+ * @brief Strictly increasing breakpoints, some close together
+ */
+static void FuzzMap_Axis(FuzzInput_T* input, float* dest, uint16_t n)
+{
+  dest[0] = FuzzInput_Range(input, -FUZZMAP_MAX_VALUE, FUZZMAP_MAX_VALUE);
+  uint16_t i;
+  for (i = 1; i < n; ++i) {
+    float step = FuzzInput_Range(input, 0.0f, 1000.0f);
+    dest[i] = dest[i - 1U] + step;
+    if (dest[i] <= dest[i - 1U]) {
+      dest[i] = nextafterf(dest[i - 1U], INFINITY);
+    }
+  }
+}
+
+/**
+ * @brief The segment and fraction of a table axis, by linear search
+ */
+static uint16_t FuzzMap_Segment(const float* x, uint16_t n, float value, float* frac)
+{
+  if (value <= x[0]) {
+    *frac = 0.0f;
+    return 0;
+  }
+  if (value >= x[n - 1U]) {
+    *frac = 1.0f;
+    return n - 2U;
+  }
+  uint16_t i = 0;
+  while (value >= x[i + 1U]) {
+    i++;
+  }
+  *frac = (value - x[i]) / (x[i + 1U] - x[i]);
+  return i;
+}
+
+static bool FuzzMap_Same(float a, float b)
+{
+  return (a == b) || (isnan(a) && isnan(b));
+}
+
+static void FuzzMap_CheckRange(const char* check, float x, float y, float result, float min, float max)
+{
+  if (!isfinite(x) || !isfinite(y)) {
+    return;
+  }
+  // Interpolation may round just outside the values
+  float tolerance = 1e-5f * fmaxf(fabsf(min), fabsf(max));
+  if (!(result >= min - tolerance && result <= max + tolerance)) {
+    FuzzMap_Fail(check, x, y, result, (result < min) ? min : max);
+  }
+}
+
+static void FuzzMap_Uniform1D(FuzzInput_T* input)
+{
+  float min;
+  float max;
+  Map_Uniform1D_T map;
+  map.n = FuzzMap_Points(input);
+  map.x0 = FuzzInput_Range(input, -FUZZMAP_MAX_VALUE, FUZZMAP_MAX_VALUE);
+  map.dxInv = 1.0f / FuzzInput_Range(input, 1e-3f, 1e3f);
+  FuzzMap_Values(input, values, map.n, &min, &max);
+  map.y = values;
+
+  while (!FuzzInput_Done(input)) {
+    float x = FuzzInput_Float(input);
+    float result = Map_Uniform1D(&map, x);
+    FuzzMap_CheckRange("Map_Uniform1D", x, 0.0f, result, min, max);
+    if (x <= map.x0 && result != map.y[0]) {
+      FuzzMap_Fail("Map_Uniform1D low end", x, 0.0f, result, map.y[0]);
+    }
+  }
+}
+
+static void FuzzMap_Uniform2D(FuzzInput_T* input)
+{
+  float min;
+  float max;
+  Map_Uniform2D_T map;
+  map.nx = FuzzMap_Points(input);
+  map.ny = FuzzMap_Points(input);
+  map.x0 = FuzzInput_Range(input, -FUZZMAP_MAX_VALUE, FUZZMAP_MAX_VALUE);
+  map.dxInv = 1.0f / FuzzInput_Range(input, 1e-3f, 1e3f);
+  map.y0 = FuzzInput_Range(input, -FUZZMAP_MAX_VALUE, FUZZMAP_MAX_VALUE);
+  map.dyInv = 1.0f / FuzzInput_Range(input, 1e-3f, 1e3f);
+  FuzzMap_Values(input, values, (uint32_t)map.nx * map.ny, &min, &max);
+  map.z = values;
+
+  while (!FuzzInput_Done(input)) {
+    float x = FuzzInput_Float(input);
+    float y = FuzzInput_Float(input);
+    FuzzMap_CheckRange("Map_Uniform2D", x, y, Map_Uniform2D(&map, x, y), min, max);
+  }
+}
+
+static void FuzzMap_Uniform1D_Q(FuzzInput_T* input)
+{
+  Map_Uniform1D_Q_T map;
+  map.n = FuzzMap_Points(input);
+  map.x0 = (int32_t)FuzzInput_U32(input);
+  map.shift = FuzzInput_U8(input) % (MAP_Q_MAX_SHIFT + 1U);
+  int16_t min = INT16_MAX;
+  int16_t max = INT16_MIN;
+  uint16_t i;
+  for (i = 0; i < map.n; ++i) {
+    valuesQ[i] = (int16_t)FuzzInput_U16(input);
+    min = (valuesQ[i] < min) ? valuesQ[i] : min;
+    max = (valuesQ[i] > max) ? valuesQ[i] : max;
+  }
+  map.y = valuesQ;
+
+  while (!FuzzInput_Done(input)) {
+    int32_t x = (int32_t)FuzzInput_U32(input);
+    int16_t result = Map_Uniform1D_Q(&map, x);
+    if (result < min || result > max) {
+      FuzzMap_Fail("Map_Uniform1D_Q", (float)x, 0.0f, result, (result < min) ? min : max);
+    }
+    if (x <= map.x0 && result != map.y[0]) {
+      FuzzMap_Fail("Map_Uniform1D_Q low end", (float)x, 0.0f, result, map.y[0]);
+    }
+  }
+}
+
+static void FuzzMap_Table1D(FuzzInput_T* input)
+{
+  float min;
+  float max;
+  Map_Table1D_T map;
+  map.n = FuzzMap_Points(input);
+  FuzzMap_Axis(input, axisX, map.n);
+  FuzzMap_Values(input, values, map.n, &min, &max);
+  map.x = axisX;
+  map.y = values;
+
+  Map_Cache_T cache = { FuzzInput_U16(input) };
+  while (!FuzzInput_Done(input)) {
+    float x = FuzzInput_Float(input);
+    float result = Map_Table1D(&map, &cache, x);
+
+    float frac;
+    uint16_t i = FuzzMap_Segment(map.x, map.n, x, &frac);
+    float expected = map.y[i] + frac * (map.y[i + 1U] - map.y[i]);
+    if (!FuzzMap_Same(result, expected)) {
+      FuzzMap_Fail("Map_Table1D", x, 0.0f, result, expected);
+    }
+  }
+}
+
+static void FuzzMap_Table2D(FuzzInput_T* input)
+{
+  float min;
+  float max;
+  Map_Table2D_T map;
+  map.nx = FuzzMap_Points(input);
+  map.ny = FuzzMap_Points(input);
+  FuzzMap_Axis(input, axisX, map.nx);
+  FuzzMap_Axis(input, axisY, map.ny);
+  FuzzMap_Values(input, values, (uint32_t)map.nx * map.ny, &min, &max);
+  map.x = axisX;
+  map.y = axisY;
+  map.z = values;
+
+  Map_Cache_T cacheX = { FuzzInput_U16(input) };
+  Map_Cache_T cacheY = { FuzzInput_U16(input) };
+  while (!FuzzInput_Done(input)) {
+    float x = FuzzInput_Float(input);
+    float y = FuzzInput_Float(input);
+    float result = Map_Table2D(&map, &cacheX, &cacheY, x, y);
+
+    float fx;
+    float fy;
+    uint16_t ix = FuzzMap_Segment(map.x, map.nx, x, &fx);
+    uint16_t iy = FuzzMap_Segment(map.y, map.ny, y, &fy);
+    const float* row0 = &map.z[iy * map.nx + ix];
+    const float* row1 = row0 + map.nx;
+    float z0 = row0[0] + fx * (row0[1] - row0[0]);
+    float z1 = row1[0] + fx * (row1[1] - row1[0]);
+    float expected = z0 + fy * (z1 - z0);
+    if (!FuzzMap_Same(result, expected)) {
+      FuzzMap_Fail("Map_Table2D", x, y, result, expected);
+    }
+  }
+}
+
+// ------------------- Fuzzer -------------------
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  FuzzInput_T input = { data, size, 0 };
+
+  switch (FuzzInput_U8(&input) % FUZZMAP_NUM_KINDS) {
+    case FUZZMAP_UNIFORM1D:
+      FuzzMap_Uniform1D(&input);
+      break;
+    case FUZZMAP_UNIFORM2D:
+      FuzzMap_Uniform2D(&input);
+      break;
+    case FUZZMAP_UNIFORM1D_Q:
+      FuzzMap_Uniform1D_Q(&input);
+      break;
+    case FUZZMAP_TABLE1D:
+      FuzzMap_Table1D(&input);
+      break;
+    default:
+      FuzzMap_Table2D(&input);
+      break;
+  }
+  return 0;
+}
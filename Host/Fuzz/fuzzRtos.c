@@ -0,0 +1,121 @@
+/*
+ * fuzzRtos.c
+ *
+ * The kernel calls of a single task module, see fuzzRtos.h.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "fuzzRtos.h"
+
+#include <setjmp.h>
+#include <stddef.h>
+
+#include "stm32f7xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+
+// ------------------- Private data -------------------
+uint32_t SystemCoreClock = 200000000U;
+DWT_Type hostDwt;
+
+static TaskFunction_t taskCode;
+static void* taskParameters;
+
+static TickType_t tickCount;
+static uint32_t pendingNotifications;
+static uint32_t takeCount;
+static jmp_buf blocked;
+
+// ------------------- Public methods -------------------
+void FuzzRtos_Reset(uint32_t tick)
+{
+  taskCode = NULL;
+  taskParameters = NULL;
+  tickCount = tick;
+  DWT->CYCCNT = tickCount * (SystemCoreClock / 1000U);
+}
+
+//------------------------------------------------------------------------------
+bool FuzzRtos_Run(uint32_t notifications)
+{
+  if (NULL == taskCode) {
+    return false;
+  }
+
+  tickCount += notifications;
+  DWT->CYCCNT = tickCount * (SystemCoreClock / 1000U);
+  pendingNotifications = notifications;
+  takeCount = 0;
+  if (0 == setjmp(blocked)) {
+    taskCode(taskParameters);
+  }
+  return true;
+}
+
+// ------------------- Kernel -------------------
+TaskHandle_t xTaskCreateStatic(
+    TaskFunction_t pxTaskCode,
+    const char* const pcName,
+    const uint32_t ulStackDepth,
+    void* const pvParameters,
+    UBaseType_t uxPriority,
+    StackType_t* const puxStackBuffer,
+    StaticTask_t* const pxTaskBuffer)
+{
+  (void)pcName;
+  (void)ulStackDepth;
+  (void)uxPriority;
+  (void)puxStackBuffer;
+
+  taskCode = pxTaskCode;
+  taskParameters = pvParameters;
+  return (TaskHandle_t)pxTaskBuffer;
+}
+
+//------------------------------------------------------------------------------
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+  (void)xTicksToWait;
+
+  // The task is blocking again after its pass
+  if (takeCount++ > 0) {
+    longjmp(blocked, 1);
+  }
+
+  uint32_t value = pendingNotifications;
+  if (pdFALSE != xClearCountOnExit) {
+    pendingNotifications = 0;
+  } else if (pendingNotifications > 0) {
+    pendingNotifications--;
+  }
+  return value;
+}
+
+//------------------------------------------------------------------------------
+TickType_t xTaskGetTickCount(void)
+{
+  return tickCount;
+}
+
+//------------------------------------------------------------------------------
+void vPortEnterCritical(void)
+{
+}
+
+//------------------------------------------------------------------------------
+void vPortExitCritical(void)
+{
+}
+
+// ------------------- Task timer -------------------
+TaskTimer_Status_T TaskTimer_RegisterTask(TaskHandle_t* handle, uint16_t divider)
+{
+  if (NULL == handle || NULL == *handle || 0 == divider) {
+    return TASKTIMER_STATUS_ERROR;
+  }
+  return TASKTIMER_STATUS_OK;
+}
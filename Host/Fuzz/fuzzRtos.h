@@ -0,0 +1,41 @@
+/*
+ * fuzzRtos.h
+ *
+ * Stands in for the kernel, for fuzzing a module with one task without the
+ * simulation. A module's Init can then be called again for every input, so
+ * each input starts from the same state and a crash reproduces from its
+ * input alone.
+ *
+ * The task runs on the caller's stack. FuzzRtos_Run enters the task function
+ * and returns when it blocks in ulTaskNotifyTake for the second time, so one
+ * call is one pass of the task's loop. The task must keep no state in its
+ * locals from one pass to the next, which holds for the Application's task
+ * loops.
+ *
+ * Critical sections are empty, and TaskTimer_RegisterTask only checks its
+ * arguments. The DWT cycle counter follows the tick count.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef FUZZRTOS_H_
+#define FUZZRTOS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Forget the created task and restart the tick count from tick
+ */
+void FuzzRtos_Reset(uint32_t tick);
+
+/**
+ * @brief Run one pass of the created task's loop
+ * @param notifications Value ulTaskNotifyTake returns, the timer ticks since
+ * the last pass. 0 is a timeout. The tick count advances by as much.
+ * @return false if no task has been created
+ */
+bool FuzzRtos_Run(uint32_t notifications);
+
+#endif /* FUZZRTOS_H_ */
@@ -0,0 +1,379 @@
+/*
+ * fuzzUds.c
+ *
+ * Fuzzes the UDS server: the service parsers, the DID index and periodic
+ * schedule, DTC reporting, sessions and their timeout, and the response
+ * retries while the bus is busy.
+ *
+ * Requests are delivered whole, as ISO-TP's receive callback delivers them.
+ * ISO-TP itself is fuzzed by fuzzIsoTp, and its API is stood in for below.
+ * Each request is in a buffer of its own length, so reading past its end
+ * is caught by the sanitizers.
+ *
+ * Each input is a sequence of records:
+ *   ctrl    bits 0-2: UDS task passes to run after the record
+ *           bit 3:    a request follows, a length byte then its bytes
+ *           bit 4:    the bus is busy until the next record: responses
+ *                     and periodic frames fail to send
+ *           bit 5:    a multi-frame response being sent fails, rather
+ *                     than completing, at the next record
+ *           bit 6:    the DTC tests report faults
+ *           bit 7:    ECU reset and the programming session are allowed
+ * An input ends early at a reset, as the ECU would.
+ *
+ * Every input starts from Uds_Init. Checks, besides the sanitizers:
+ *  - Every response answers the request being processed: its SID plus
+ *    0x40, or a negative response naming its SID, within
+ *    UDS_MAX_RESPONSE_LEN. Retries of a response are the same bytes.
+ *  - A response is only sent once the last one has gone, or has been
+ *    retried for UDS_P2_SERVER_MS, and a reset only happens then too.
+ *  - Periodic frames are only sent in the extended session, on
+ *    UDS_CAN_ID_PERIODIC, carrying their DID's whole data.
+ *  - Every request buffer is freed exactly once, and none are held once
+ *    the bus is free again.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fuzzInput.h"
+#include "fuzzRtos.h"
+
+#include "comm/uds/uds.h"
+#include "comm/isotp/isotp.h"
+#include "comm/canTx/canTx.h"
+#include "startup/bootControl.h"
+
+int LLVMFuzzerInitialize(int* argc, char*** argv);
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// ------------------- Private data -------------------
+#define FUZZUDS_SF_MAX_DATA     7U      /* Longest response that is a single frame */
+#define FUZZUDS_SEND_ATTEMPTS   ((UDS_P2_SERVER_MS / UDS_PERIOD_MS) + 1U)
+#define FUZZUDS_FREE_PASSES     (FUZZUDS_SEND_ATTEMPTS + 1U)
+
+static Logging_T fuzzLog;
+
+static CAN_HandleTypeDef udsCan;
+
+/*
+ * Each DID's data is its length, repeated, so a periodic frame can be
+ * checked against the DID it carries
+ */
+#define FUZZUDS_READ(len) static void FuzzUds_Read##len(uint8_t* out) { memset(out, len, len); }
+FUZZUDS_READ(1)
+FUZZUDS_READ(4)
+FUZZUDS_READ(5)
+FUZZUDS_READ(6)
+FUZZUDS_READ(7)
+FUZZUDS_READ(8)
+FUZZUDS_READ(12)
+FUZZUDS_READ(250)
+
+/* diagMapping's DIDs, and two more at the limits */
+static const Uds_Did_T dids[] = {
+  { 0xF18CU, 12U,  FuzzUds_Read12 },
+  { 0xF195U, 8U,   FuzzUds_Read8 },
+  { 0xF1F0U, 250U, FuzzUds_Read250 },   /* Two don't fit a response */
+  { 0xF200U, 1U,   FuzzUds_Read1 },
+  { 0xF201U, 6U,   FuzzUds_Read6 },
+  { 0xF202U, 7U,   FuzzUds_Read7 },
+  { 0xF203U, 4U,   FuzzUds_Read4 },
+  { 0xF205U, 5U,   FuzzUds_Read5 },
+  { 0xF2F0U, 8U,   FuzzUds_Read8 },     /* Too long for a periodic frame */
+};
+
+static bool dtcFaults;
+static bool FuzzUds_TestDtc(void)
+{
+  return dtcFaults;
+}
+
+static const Uds_Dtc_T dtcs[] = {
+  { 0x212300U, FuzzUds_TestDtc },
+  { 0x057100U, FuzzUds_TestDtc },
+  { 0xC29300U, FuzzUds_TestDtc },
+};
+
+static bool resetAllowed;
+static bool FuzzUds_ResetAllowed(void)
+{
+  return resetAllowed;
+}
+
+static const Uds_Config_T udsConfig = {
+  .dids = dids,
+  .numDids = sizeof(dids) / sizeof(dids[0]),
+  .dtcs = dtcs,
+  .numDtcs = sizeof(dtcs) / sizeof(dtcs[0]),
+  .resetAllowed = FuzzUds_ResetAllowed,
+};
+
+// ISO-TP, as the server sees it
+static bool channelOpen;
+static IsoTp_Channel_T udsChannel;
+static IsoTp_RxCallback_T rxCallback;
+static IsoTp_TxCallback_T txCallback;
+static bool busBusy;
+static bool txInProgress;                 /* A multi-frame response */
+
+// Request buffers handed to the server, until it frees them
+static uint8_t* requests[ISOTP_NUM_BUFFERS];
+
+// The last response refused, which is sent again unchanged until it has
+// been tried for UDS_P2_SERVER_MS
+static uint8_t refused[UDS_MAX_RESPONSE_LEN];
+static uint16_t refusedLen;
+static uint8_t refusedAttempts;
+
+static bool reset;
+
+// ------------------- Private methods -------------------
+static void FuzzUds_Fail(const char* check, const uint8_t* data, uint16_t len)
+{
+  fprintf(stderr, "%s:", check);
+  uint16_t i;
+  for (i = 0; i < len && i < 16U; ++i) {
+    fprintf(stderr, " %02X", data[i]);
+  }
+  fprintf(stderr, "%s\n", (len > 16U) ? " ..." : "");
+  abort();
+}
+
+static uint8_t* FuzzUds_HeldRequest(void)
+{
+  size_t i;
+  for (i = 0; i < ISOTP_NUM_BUFFERS; ++i) {
+    if (NULL != requests[i]) {
+      return requests[i];
+    }
+  }
+  return NULL;
+}
+
+static void FuzzUds_FreeRequests(void)
+{
+  size_t i;
+  for (i = 0; i < ISOTP_NUM_BUFFERS; ++i) {
+    free(requests[i]);
+    requests[i] = NULL;
+  }
+}
+
+/**
+ * @brief Delivers a request, as the ISO-TP receive interrupt. With every
+ * buffer in use ISO-TP would have dropped it.
+ */
+static void FuzzUds_Deliver(const uint8_t* data, uint16_t len)
+{
+  size_t i;
+  for (i = 0; i < ISOTP_NUM_BUFFERS; ++i) {
+    if (NULL == requests[i]) {
+      break;
+    }
+  }
+  if (ISOTP_NUM_BUFFERS == i) {
+    return;
+  }
+
+  // A zero length request still needs a distinct buffer
+  requests[i] = malloc((0 == len) ? 1U : len);
+  memcpy(requests[i], data, len);
+  rxCallback(udsChannel, requests[i], len);
+}
+
+static void FuzzUds_CompleteTx(bool error)
+{
+  if (txInProgress) {
+    txInProgress = false;
+    txCallback(udsChannel, error ? ISOTP_STATUS_ERROR_TIMEOUT : ISOTP_STATUS_OK);
+  }
+}
+
+static void FuzzUds_Run(uint8_t passes)
+{
+  uint8_t i;
+  for (i = 0; (i < passes) && !reset; ++i) {
+    FuzzRtos_Run(1);
+  }
+}
+
+// ------------------- ISO-TP -------------------
+IsoTp_Status_T IsoTp_Open(const IsoTp_ChannelConfig_T* config, IsoTp_Channel_T* channel)
+{
+  if (channelOpen || &udsCan != config->hcan ||
+      BOOTCONTROL_CAN_ID_REQUEST != config->rxId || BOOTCONTROL_CAN_ID_RESPONSE != config->txId ||
+      NULL == config->rxCallback || NULL == config->txCallback) {
+    return ISOTP_STATUS_ERROR;
+  }
+  channelOpen = true;
+  rxCallback = config->rxCallback;
+  txCallback = config->txCallback;
+  *channel = udsChannel;
+  return ISOTP_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+IsoTp_Status_T IsoTp_Send(IsoTp_Channel_T channel, const uint8_t* data, uint16_t len)
+{
+  if (udsChannel != channel || 0 == len || len > UDS_MAX_RESPONSE_LEN) {
+    FuzzUds_Fail("Bad response", data, len);
+  }
+  if (txInProgress) {
+    FuzzUds_Fail("Response while the last is being sent", data, len);
+  }
+
+  // A retry is the response refused last, anything else answers the
+  // request being processed
+  bool retry = (len == refusedLen) && (0 == memcmp(data, refused, len));
+  if (!retry) {
+    if ((0 != refusedLen) && (refusedAttempts < FUZZUDS_SEND_ATTEMPTS)) {
+      FuzzUds_Fail("Response while the last is still being retried", data, len);
+    }
+    const uint8_t* request = FuzzUds_HeldRequest();
+    if (NULL == request) {
+      FuzzUds_Fail("Response without a request", data, len);
+    }
+    uint8_t sid = request[0];
+    bool positive = (sid + 0x40U) == data[0];
+    bool negative = (0x7FU == data[0]) && (len >= 3U) && (sid == data[1]);
+    if (!positive && !negative) {
+      FuzzUds_Fail("Response to another request", data, len);
+    }
+  }
+
+  if (busBusy) {
+    refusedAttempts = retry ? refusedAttempts + 1U : 1U;
+    memcpy(refused, data, len);
+    refusedLen = len;
+    return ISOTP_STATUS_ERROR_BUSY;
+  }
+  refusedLen = 0;
+
+  if (len <= FUZZUDS_SF_MAX_DATA) {
+    txCallback(channel, ISOTP_STATUS_OK);
+  } else {
+    txInProgress = true;
+  }
+  return ISOTP_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void IsoTp_FreeBuffer(uint8_t* buffer)
+{
+  size_t i;
+  for (i = 0; i < ISOTP_NUM_BUFFERS; ++i) {
+    if (buffer == requests[i]) {
+      free(requests[i]);
+      requests[i] = NULL;
+      return;
+    }
+  }
+  fprintf(stderr, "Freed a buffer not held: %p\n", (void*)buffer);
+  abort();
+}
+
+// ------------------- CAN and reset -------------------
+CAN_Status_T CanTx_Send(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len)
+{
+  if (&udsCan != handle || UDS_CAN_ID_PERIODIC != id || len < 2U || len > 8U) {
+    FuzzUds_Fail("Bad periodic frame", data, len);
+  }
+  if (UDS_SESSION_EXTENDED != Uds_GetSession()) {
+    FuzzUds_Fail("Periodic frame outside the extended session", data, len);
+  }
+  uint16_t i;
+  for (i = 1U; i < len; ++i) {
+    if ((len - 1U) != data[i]) {
+      FuzzUds_Fail("Periodic frame data", data, len);
+    }
+  }
+  return busBusy ? CAN_STATUS_ERROR : CAN_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+static void FuzzUds_Reset(void)
+{
+  // A response refused until the server gave up on it doesn't hold a reset
+  if (txInProgress || ((0 != refusedLen) && (refusedAttempts < FUZZUDS_SEND_ATTEMPTS))) {
+    fprintf(stderr, "Reset with a response not sent\n");
+    abort();
+  }
+  reset = true;
+}
+
+//------------------------------------------------------------------------------
+void HostHal_SystemReset(void)
+{
+  FuzzUds_Reset();
+}
+
+//------------------------------------------------------------------------------
+void BootControl_EnterBootloader(void)
+{
+  FuzzUds_Reset();
+}
+
+// ------------------- Fuzzer -------------------
+int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void)argc;
+  (void)argv;
+  Log_Init(&fuzzLog);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  FuzzInput_T input = { data, size, 0 };
+
+  FuzzRtos_Reset(0);
+  FuzzUds_FreeRequests();
+  channelOpen = false;
+  busBusy = false;
+  txInProgress = false;
+  refusedLen = 0;
+  refusedAttempts = 0;
+  reset = false;
+  dtcFaults = false;
+  resetAllowed = false;
+  if (UDS_STATUS_OK != Uds_Init(&fuzzLog, &udsCan, &udsConfig) || !channelOpen) {
+    abort();
+  }
+
+  while (!FuzzInput_Done(&input) && !reset) {
+    uint8_t ctrl = FuzzInput_U8(&input);
+
+    FuzzUds_CompleteTx(0 != (ctrl & 0x20U));
+    busBusy = 0 != (ctrl & 0x10U);
+    dtcFaults = 0 != (ctrl & 0x40U);
+    resetAllowed = 0 != (ctrl & 0x80U);
+
+    if (ctrl & 0x08U) {
+      uint8_t request[UINT8_MAX];
+      uint8_t len = FuzzInput_U8(&input);
+      FuzzInput_Bytes(&input, request, len);
+      FuzzUds_Deliver(request, len);
+    }
+
+    FuzzUds_Run(ctrl & 0x07U);
+  }
+
+  // With the bus free, the server catches up and lets every request go
+  busBusy = false;
+  uint8_t i;
+  for (i = 0; (i < FUZZUDS_FREE_PASSES) && !reset; ++i) {
+    FuzzUds_CompleteTx(false);
+    FuzzUds_Run(1U);
+  }
+  if (!reset && (NULL != FuzzUds_HeldRequest())) {
+    fprintf(stderr, "Request never freed\n");
+    abort();
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * fuzzXcp.c
+ *
+ * Fuzzes the XCP slave through its CAN transport: xcpCan's receive callback,
+ * the receive queue, the command and STIM parsers, and the DAQ and STIM
+ * event processing, with the parameter store behind them.
+ *
+ * Each input is a sequence of records:
+ *   ctrl    bits 0-3: DLC as the CAN controller reports it, 0-15
+ *           bits 4-6: timer ticks to run the task for after the frame
+ *           bit 7:    the ticks are late, and reach the task as one wake,
+ *                     or with no ticks, the task wakes on its timeout
+ *   data    min(DLC, 8) bytes
+ * Frames with no ticks after them are queued in the same tick, as a burst
+ * from the master would be.
+ *
+ * Every input starts from XcpCan_Init and the default parameters. Absolute
+ * addresses in the target's flash and RAM ranges are mapped read only, so
+ * UPLOAD and DAQ can read them as on the target.
+ *
+ * Checks, besides the sanitizers: every packet sent fits a CAN frame and goes
+ * out on the DTO ID.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "fuzzInput.h"
+#include "fuzzRtos.h"
+
+#include "comm/can/can.h"
+#include "comm/xcp/xcpCan.h"
+#include "lib/paramStore/paramStore.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+
+int LLVMFuzzerInitialize(int* argc, char*** argv);
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// ------------------- Private data -------------------
+#define FUZZXCP_FLASH_START   0x08000000UL
+#define FUZZXCP_FLASH_SIZE    0x00200000UL
+#define FUZZXCP_RAM_START     0x20000000UL
+#define FUZZXCP_RAM_SIZE      0x00080000UL
+
+static Logging_T fuzzLog;
+
+// Any bus will do, CAN is stubbed below
+static CAN_HandleTypeDef xcpCan;
+static CAN_Callback xcpCallback;
+
+// ------------------- Private methods -------------------
+static void FuzzXcp_Map(unsigned long start, unsigned long size)
+{
+  void* address = mmap((void*)start, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  if ((void*)start != address) {
+    fprintf(stderr, "Can't map 0x%08lX for the target's memory\n", start);
+    abort();
+  }
+}
+
+// ------------------- CAN -------------------
+CAN_Status_T CAN_SendMessage(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len)
+{
+  (void)data;
+  if (&xcpCan != handle || XCPCAN_CAN_ID_DTO != id || len > 8U) {
+    fprintf(stderr, "Bad XCP packet: ID 0x%X, %u bytes\n", id, len);
+    abort();
+  }
+  return CAN_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CAN_Status_T CAN_RegisterCallback(CAN_HandleTypeDef* handle, uint32_t id, CAN_Callback callback)
+{
+  if (&xcpCan != handle || XCPCAN_CAN_ID_CMD != id) {
+    return CAN_STATUS_ERROR;
+  }
+  xcpCallback = callback;
+  return CAN_STATUS_OK;
+}
+
+// ------------------- Mapping -------------------
+static bool FuzzXcp_StoreAllowed(void)
+{
+  // The host parameter store saves at once
+  return true;
+}
+
+// ------------------- Fuzzer -------------------
+int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  (void)argc;
+  (void)argv;
+  FuzzXcp_Map(FUZZXCP_FLASH_START, FUZZXCP_FLASH_SIZE);
+  FuzzXcp_Map(FUZZXCP_RAM_START, FUZZXCP_RAM_SIZE);
+  Log_Init(&fuzzLog);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  FuzzInput_T input = { data, size, 0 };
+
+  FuzzRtos_Reset(0);
+  xcpCallback = NULL;
+  if (PARAMSTORE_STATUS_OK != ParamStore_Init(&fuzzLog, Mapping_GetParamDefaults(), MAPPING_PARAM_NUM_PARAMS) ||
+      XCPCAN_STATUS_OK != XcpCan_Init(&fuzzLog, &xcpCan, FuzzXcp_StoreAllowed) ||
+      NULL == xcpCallback) {
+    abort();
+  }
+  // The task's first pass, before any traffic
+  FuzzRtos_Run(1);
+
+  while (!FuzzInput_Done(&input)) {
+    uint8_t ctrl = FuzzInput_U8(&input);
+
+    CAN_DataFrame_T frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.handle = &xcpCan;
+    frame.msgId = XCPCAN_CAN_ID_CMD;
+    frame.dlc = ctrl & 0x0FU;
+    FuzzInput_Bytes(&input, frame.data, (frame.dlc > 8U) ? 8U : frame.dlc);
+    xcpCallback(&frame);
+
+    uint32_t ticks = (ctrl >> 4) & 0x07U;
+    if (ctrl & 0x80U) {
+      FuzzRtos_Run(ticks);
+    } else {
+      uint32_t i;
+      for (i = 0; i < ticks; ++i) {
+        FuzzRtos_Run(1);
+      }
+    }
+  }
+
+  // Drain whatever is still queued
+  FuzzRtos_Run(1);
+  return 0;
+}
@@ -0,0 +1,41 @@
+/*
+ * can.h
+ *
+ * Host build of the System library CAN driver. Frames are delivered with
+ * HostCan_Receive (hostCan.h) in place of the RX interrupt, and sent frames
+ * are passed to the host's transmit hook.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef COMM_CAN_CAN_H_
+#define COMM_CAN_CAN_H_
+
+#include <stdint.h>
+
+#include "stm32f7xx_hal.h"
+#include "lib/logging/logging.h"
+
+typedef enum
+{
+  CAN_STATUS_OK     = 0x00U,
+  CAN_STATUS_ERROR  = 0x01U
+} CAN_Status_T;
+
+typedef struct
+{
+  CAN_HandleTypeDef* handle;
+  uint32_t msgId;
+  uint8_t data[8];
+  uint32_t dlc;
+} CAN_DataFrame_T;
+
+typedef void (*CAN_Callback)(const CAN_DataFrame_T* data);
+
+CAN_Status_T CAN_Init(Logging_T* logger);
+CAN_Status_T CAN_Config(CAN_HandleTypeDef* handle);
+CAN_Status_T CAN_SendMessage(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len);
+CAN_Status_T CAN_RegisterCallback(CAN_HandleTypeDef* handle, uint32_t id, CAN_Callback callback);
+
+#endif /* COMM_CAN_CAN_H_ */
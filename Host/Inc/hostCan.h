@@ -0,0 +1,91 @@
+/*
+ * hostCan.h
+ *
+ * CAN bus access for host programs, behind the System library CAN API.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef HOSTCAN_H_
+#define HOSTCAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "comm/can/can.h"
+
+#define HOSTCAN_NUM_BUSES         3U
+#define HOSTCAN_MAX_CALLBACKS     64U
+#define HOSTCAN_TX_MAILBOXES      3U
+#define HOSTCAN_FILTER_BANKS      28U
+
+/* The Application's CAN handles, bus 1-3 */
+extern CAN_HandleTypeDef hcan1;
+extern CAN_HandleTypeDef hcan2;
+extern CAN_HandleTypeDef hcan3;
+
+/**
+ * @brief Handle of a bus
+ * @param bus 1-3
+ * @return NULL if out of range
+ */
+CAN_HandleTypeDef* HostCan_GetHandle(uint8_t bus);
+
+/**
+ * @brief Bus number 1-3 of a handle, 0 if unknown
+ */
+uint8_t HostCan_GetBus(const CAN_HandleTypeDef* hcan);
+
+/**
+ * @brief Deliver a received frame to the callback registered for its ID, as
+ * the RX interrupt would. Must be called between HostSim_EnterIsr/ExitIsr.
+ * The frame is loaded into the FIFO 0 mailbox registers first, and stays
+ * there until the next frame. IDs above 0x7FF are extended. The DLC is
+ * passed on as the controller reports it, so 9-15 reach the callbacks with
+ * 8 bytes of data.
+ * Standard IDs in a FIFO 1 ID list filter (HAL_CAN_ConfigFilter) go to
+ * FIFO 1 and the FIFO 1 hook instead, as list filters take priority.
+ * @return true if a callback or a FIFO 1 filter took the frame, false if it
+ * would have been filtered out
+ */
+bool HostCan_Receive(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc);
+
+/**
+ * @brief Called for each received frame with it pending in FIFO 0, before
+ * the callbacks, as the RX interrupt handlers in Core do
+ */
+typedef void (*HostCan_RxHook_T)(CAN_HandleTypeDef* hcan);
+void HostCan_SetRxHook(HostCan_RxHook_T hook);
+
+/**
+ * @brief Called for each received frame a FIFO 1 filter takes, with it
+ * pending in FIFO 1. The host program plays the FIFO 1 interrupt, as the
+ * handlers and HAL_CAN_RxFifo1MsgPendingCallback in Core do. Frames it
+ * requests in the TX mailbox registers are sent as it returns.
+ */
+void HostCan_SetRxFifo1Hook(HostCan_RxHook_T hook);
+
+/**
+ * @brief Called for every frame the Application sends, with it loaded into
+ * TX mailbox 0, or in the mailbox it requested directly
+ */
+typedef void (*HostCan_TxHook_T)(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc);
+void HostCan_SetTxHook(HostCan_TxHook_T hook);
+
+/**
+ * @brief Holds each frame sent on a bus in a TX mailbox until the host
+ * program completes it, for programs that model the time frames take on
+ * the wire. Otherwise frames are sent at once and every mailbox is free.
+ * A send with every mailbox held fails.
+ */
+void HostCan_HoldTxMailboxes(uint8_t bus, bool hold);
+
+/**
+ * @brief Frees the mailbox of the oldest frame held on a bus, as its
+ * transmission completes. The host program then plays the TX complete
+ * interrupt.
+ */
+void HostCan_TxComplete(uint8_t bus);
+
+#endif /* HOSTCAN_H_ */
@@ -0,0 +1,93 @@
+/*
+ * hostSim.h
+ *
+ * Simulated clock and scheduler control for host builds of the Application.
+ *
+ * The host program plays the part of the interrupts. It only runs while
+ * every task is blocked, and the tasks only run when it hands over:
+ *
+ *   Module_Init(...);               // create the tasks as on the target
+ *   HostSim_Start();                // run them until they all block
+ *   HostSim_AdvanceTo(t);           // each 1ms tick up to t, run to idle
+ *   HostSim_EnterIsr();
+ *   HostCan_Receive(...);           // interrupt work at time t
+ *   HostSim_ExitIsr();
+ *   HostSim_RunUntilIdle();         // the tasks it woke
+ *
+ * Time only moves in HostSim_AdvanceTo, so the simulated clock is exact and
+ * independent of how long the host takes. Idle time is skipped, so a log
+ * replays as fast as the host can process it.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef HOSTSIM_H_
+#define HOSTSIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <stm32f7xx_hal.h> /* The wrapper, from the include path */
+
+#define HOSTSIM_TICK_NS   ((uint64_t) 1000000U)
+
+/**
+ * @brief Start the scheduler, and run the created tasks until they all block.
+ * Tasks must be created first.
+ */
+void HostSim_Start(void);
+
+/**
+ * @brief Run the tasks woken by the host since they last blocked, until they
+ * all block again.
+ */
+void HostSim_RunUntilIdle(void);
+
+/**
+ * @brief Move the simulated clock forward. Each 1ms tick on the way
+ * notifies the task timer and runs the tasks to idle.
+ * @param timeNs Simulated time since start, not before the current time
+ */
+void HostSim_AdvanceTo(uint64_t timeNs);
+
+/**
+ * @brief Simulated time since start
+ */
+uint64_t HostSim_GetTimeNs(void);
+
+/**
+ * @brief Bracket calls into interrupt handlers or FromISR functions
+ */
+void HostSim_EnterIsr(void);
+void HostSim_ExitIsr(void);
+
+/**
+ * @brief Set the next conversion of an ADC channel
+ */
+void HostAdc_Set(uint16_t channel, uint16_t raw);
+
+/**
+ * @brief Number of times a task was notified by the task timer while it
+ * still had the previous notification to take, i.e. periods it missed
+ */
+uint32_t HostTaskTimer_GetOverruns(void);
+
+/**
+ * @brief State of a GPIO output, as last written
+ */
+bool HostGpio_IsSet(const GPIO_TypeDef* port, uint16_t pin);
+
+/**
+ * @brief Number of NVIC_SystemReset calls
+ */
+uint32_t HostHal_GetResetCount(void);
+
+/**
+ * @brief Called once per simulated tick, after the task timer, with the
+ * tasks not yet run. Used to step plant models alongside the firmware.
+ */
+typedef void (*HostSim_TickHook_T)(uint64_t timeNs);
+void HostSim_SetTickHook(HostSim_TickHook_T hook);
+
+#endif /* HOSTSIM_H_ */
@@ -0,0 +1,53 @@
+/*
+ * hostSpi.h
+ *
+ * SPI bus access for host programs, behind the HAL DMA transfers the SPI
+ * driver starts.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef HOSTSPI_H_
+#define HOSTSPI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <stm32f7xx_hal.h>
+
+#define HOSTSPI_NUM_BUSES         1U
+
+/* The Application's SPI handle, with both DMA streams linked */
+extern SPI_HandleTypeDef hspi4;
+
+/**
+ * @brief The devices at the far end of a bus. Called once per transfer as
+ * it completes, with the chip selects as the Application left them, see
+ * HostGpio_IsSet. tx is NULL for receive only transfers, rx for transmit
+ * only ones.
+ */
+typedef void (*HostSpi_DeviceHook_T)(SPI_HandleTypeDef* hspi, const uint8_t* tx, uint8_t* rx, uint16_t length);
+void HostSpi_SetDeviceHook(HostSpi_DeviceHook_T hook);
+
+/**
+ * @brief Length of the transfer in progress on a bus, 0 if the bus is idle
+ */
+uint16_t HostSpi_GetPending(const SPI_HandleTypeDef* hspi);
+
+/**
+ * @brief Finish the transfer in progress, as the DMA interrupt would. The
+ * device exchanges the data, then the HAL completion callback runs. With
+ * error set the device isn't called, and the error callback runs instead.
+ * Must be called between HostSim_EnterIsr/ExitIsr.
+ * @return false if the bus was idle
+ */
+bool HostSpi_Complete(SPI_HandleTypeDef* hspi, bool error);
+
+/**
+ * @brief The next transfer started on the bus fails to start, as with the
+ * DMA stream already in use
+ */
+void HostSpi_FailNextStart(const SPI_HandleTypeDef* hspi);
+
+#endif /* HOSTSPI_H_ */
@@ -0,0 +1,31 @@
+/*
+ * adc.h
+ *
+ * Host build of the System library ADC driver. Conversions are set by the
+ * host with HostAdc_Set (hostSim.h).
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef IO_ADC_ADC_H_
+#define IO_ADC_ADC_H_
+
+#include <stdint.h>
+
+#include "stm32f7xx_hal.h"
+#include "lib/logging/logging.h"
+
+typedef uint16_t ADC_Channel_T;
+
+typedef enum
+{
+  ADC_STATUS_OK     = 0x00U,
+  ADC_STATUS_ERROR  = 0x01U
+} ADC_Status_T;
+
+ADC_Status_T ADC_Init(Logging_T* logger, uint16_t numChannels, uint16_t numSamples);
+ADC_Status_T ADC_Config(ADC_HandleTypeDef* handle);
+uint16_t ADC_Get(ADC_Channel_T channel);
+
+#endif /* IO_ADC_ADC_H_ */
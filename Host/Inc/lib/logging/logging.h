@@ -0,0 +1,36 @@
+/*
+ * logging.h
+ *
+ * Host build of the System library logger. Lines go to stderr when enabled.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef LIB_LOGGING_LOGGING_H_
+#define LIB_LOGGING_LOGGING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "stm32f7xx_hal.h"
+
+#define LOGGING_DEFAULT_BUFF_LEN 128
+
+typedef enum
+{
+  LOGGING_STATUS_OK     = 0x00U,
+  LOGGING_STATUS_ERROR  = 0x01U
+} Logging_Status_T;
+
+typedef struct
+{
+  bool enableLogToStderr;
+} Logging_T;
+
+Logging_Status_T Log_Init(Logging_T* logger);
+
+void logPrintS(Logging_T* logger, const char* buffer, size_t bufferLen);
+
+#endif /* LIB_LOGGING_LOGGING_H_ */
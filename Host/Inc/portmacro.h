@@ -0,0 +1,81 @@
+/*
+ * portmacro.h
+ *
+ * FreeRTOS port for host builds. Tasks are coroutines (ucontext) switched
+ * cooperatively on the host thread, so the real kernel schedules them. The
+ * host program plays the part of the interrupts: it only runs while every
+ * task is blocked, see hostSim.h. There is no preemption between tasks
+ * except at kernel calls, so critical sections are no-ops.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type definitions */
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  uintptr_t
+#define portBASE_TYPE   long
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC 1
+
+/* Architecture specifics */
+#define portSTACK_GROWTH      ( -1 )
+#define portTICK_PERIOD_MS    ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT    8
+
+/* Scheduler utilities */
+void vPortYield(void);
+#define portYIELD()                             vPortYield()
+#define portYIELD_WITHIN_API()                  vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired != pdFALSE ) vPortYieldFromISR()
+#define portYIELD_FROM_ISR( x )                 portEND_SWITCHING_ISR( x )
+void vPortYieldFromISR(void);
+
+/* Critical sections */
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+#define portSET_INTERRUPT_MASK_FROM_ISR()       0UL
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    ( void ) ( x )
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+
+/* Task function macros as described on the FreeRTOS.org WEB site */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portMEMORY_BARRIER()  __sync_synchronize()
+
+#define portINLINE        __inline
+#define portFORCE_INLINE  inline __attribute__(( always_inline ))
+
+/* Whether the host is calling in as an interrupt, see hostSim.h */
+BaseType_t xPortIsInsideInterrupt(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,56 @@
+/*
+ * stm32f7xx_hal.h
+ *
+ * Host build wrapper around the real HAL header. The HAL and CMSIS types
+ * and constants are used as they are. The few peripherals the Application
+ * accesses directly are redirected to host RAM, and the core intrinsics
+ * the Application calls are replaced with host equivalents.
+ *
+ * Only HAL functions the simulated modules call are implemented, in
+ * hostHal.c. Linking a module that needs more shows up as undefined symbols.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef HOST_STM32F7XX_HAL_H_
+#define HOST_STM32F7XX_HAL_H_
+
+#include_next "stm32f7xx_hal.h"
+
+/* CAN registers, for the modules that read mailboxes directly */
+extern CAN_TypeDef hostCanRegs[3];
+#undef CAN1
+#undef CAN2
+#undef CAN3
+#define CAN1 (&hostCanRegs[0])
+#define CAN2 (&hostCanRegs[1])
+#define CAN3 (&hostCanRegs[2])
+
+/* CRC unit registers. They only hold what is written, nothing is computed */
+extern CRC_TypeDef hostCrcRegs;
+#undef CRC
+#define CRC (&hostCrcRegs)
+
+/* Cycle counter, advanced with the simulated clock */
+extern DWT_Type hostDwt;
+#undef DWT
+#define DWT (&hostDwt)
+
+/* VREFINT factory calibration, in system memory on the target */
+extern uint16_t hostVrefintCal;
+#undef VREFINT_CAL_ADDR_CMSIS
+#define VREFINT_CAL_ADDR_CMSIS (&hostVrefintCal)
+
+/* Core intrinsics */
+#define __DMB() __sync_synchronize()
+
+uint32_t HostHal_GetPriority(IRQn_Type irq);
+#undef NVIC_GetPriority
+#define NVIC_GetPriority(irq) HostHal_GetPriority(irq)
+
+void HostHal_SystemReset(void);
+#undef NVIC_SystemReset
+#define NVIC_SystemReset() HostHal_SystemReset()
+
+#endif /* HOST_STM32F7XX_HAL_H_ */
@@ -0,0 +1,34 @@
+/*
+ * tasktimer.h
+ *
+ * Host build of the System library task timer. Registered tasks are
+ * notified from the simulated 1ms tick, see hostSim.h.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef TIME_TASKTIMER_TASKTIMER_H_
+#define TIME_TASKTIMER_TASKTIMER_H_
+
+#include <stdint.h>
+
+#include "stm32f7xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lib/logging/logging.h"
+
+/* Timer interrupts per millisecond (TIM2 runs at 1kHz) */
+#define TASKTIMER_BASE_PERIOD_MS 1U
+
+typedef enum
+{
+  TASKTIMER_STATUS_OK     = 0x00U,
+  TASKTIMER_STATUS_ERROR  = 0x01U
+} TaskTimer_Status_T;
+
+TaskTimer_Status_T TaskTimer_Init(Logging_T* logger, TIM_HandleTypeDef* htim);
+TaskTimer_Status_T TaskTimer_RegisterTask(TaskHandle_t* handle, uint16_t divider);
+void TaskTimer_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim);
+
+#endif /* TIME_TASKTIMER_TASKTIMER_H_ */
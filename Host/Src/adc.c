@@ -0,0 +1,46 @@
+/*
+ * adc.c
+ *
+ * Host build of the System library ADC driver.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "io/adc/adc.h"
+
+#include "hostSim.h"
+
+// ------------------- Private data -------------------
+#define ADC_MAX_CHANNELS 16U
+
+static uint16_t conversions[ADC_MAX_CHANNELS];
+
+// ------------------- Public methods -------------------
+ADC_Status_T ADC_Init(Logging_T* logger, uint16_t numChannels, uint16_t numSamples)
+{
+  (void)numSamples;
+  logPrintS(logger, "ADC_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return (numChannels <= ADC_MAX_CHANNELS) ? ADC_STATUS_OK : ADC_STATUS_ERROR;
+}
+
+//------------------------------------------------------------------------------
+ADC_Status_T ADC_Config(ADC_HandleTypeDef* handle)
+{
+  (void)handle;
+  return ADC_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+uint16_t ADC_Get(ADC_Channel_T channel)
+{
+  return (channel < ADC_MAX_CHANNELS) ? conversions[channel] : 0U;
+}
+
+//------------------------------------------------------------------------------
+void HostAdc_Set(uint16_t channel, uint16_t raw)
+{
+  if (channel < ADC_MAX_CHANNELS) {
+    conversions[channel] = raw;
+  }
+}
@@ -0,0 +1,347 @@
+/*
+ * hostCan.c
+ *
+ * Host build of the System library CAN driver.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "comm/can/can.h"
+
+#include <string.h>
+
+#include "hostCan.h"
+#include "hostSim.h"
+
+// ------------------- Private data -------------------
+CAN_HandleTypeDef hcan1 = { .Instance = CAN1 };
+CAN_HandleTypeDef hcan2 = { .Instance = CAN2 };
+CAN_HandleTypeDef hcan3 = { .Instance = CAN3 };
+
+typedef struct
+{
+  CAN_HandleTypeDef* handle;
+  uint32_t id;
+  CAN_Callback callback;
+} HostCan_Callback_T;
+
+static HostCan_Callback_T callbacks[HOSTCAN_MAX_CALLBACKS];
+static uint8_t numCallbacks;
+
+static HostCan_RxHook_T rxHook;
+static HostCan_RxHook_T rxFifo1Hook;
+static HostCan_TxHook_T txHook;
+
+// FIFO 1 ID list filters, two standard IDs a bank
+typedef struct
+{
+  bool active;
+  uint16_t ids[2];
+} HostCan_Filter_T;
+
+static HostCan_Filter_T fifo1Filters[HOSTCAN_NUM_BUSES][HOSTCAN_FILTER_BANKS];
+
+// Mailboxes held until HostCan_TxComplete, per bus
+static bool txHold[HOSTCAN_NUM_BUSES];
+static uint8_t txHeld[HOSTCAN_NUM_BUSES];
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Identifier register value. RX and TX mailboxes share the layout.
+ */
+static uint32_t HostCan_IdRegister(uint32_t id)
+{
+  if (id > 0x7FFU) {
+    return (id << CAN_RI0R_EXID_Pos) | CAN_RI0R_IDE;
+  }
+  return id << CAN_RI0R_STID_Pos;
+}
+
+static void HostCan_DataRegisters(const uint8_t* data, uint8_t dlc, volatile uint32_t* low, volatile uint32_t* high)
+{
+  uint8_t bytes[8] = { 0 };
+  memcpy(bytes, data, dlc);
+
+  uint32_t value;
+  memcpy(&value, &bytes[0], 4U);
+  *low = value;
+  memcpy(&value, &bytes[4], 4U);
+  *high = value;
+}
+
+static bool HostCan_Fifo1Match(uint8_t bus, uint32_t id)
+{
+  if (id > 0x7FFU) {
+    return false;
+  }
+
+  uint8_t bank;
+  for (bank = 0; bank < HOSTCAN_FILTER_BANKS; ++bank) {
+    const HostCan_Filter_T* filter = &fifo1Filters[bus - 1U][bank];
+    if (filter->active && (id == filter->ids[0] || id == filter->ids[1])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint32_t HostCan_FreeMailboxes(uint8_t bus)
+{
+  return txHold[bus - 1U] ? HOSTCAN_TX_MAILBOXES - txHeld[bus - 1U] : HOSTCAN_TX_MAILBOXES;
+}
+
+static void HostCan_Sent(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t len)
+{
+  if (txHold[bus - 1U]) {
+    txHeld[bus - 1U]++;
+  }
+  if (NULL != txHook) {
+    txHook(bus, id, data, len);
+  }
+}
+
+/**
+ * @brief Offers the free mailboxes in TSR, for modules that fill the TX
+ * mailbox registers themselves. Mailbox 0 is always the next one.
+ */
+static void HostCan_UpdateTsr(void)
+{
+  static const uint32_t empty[HOSTCAN_TX_MAILBOXES + 1U] = {
+    0, CAN_TSR_TME0, CAN_TSR_TME0 | CAN_TSR_TME1, CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2
+  };
+
+  uint8_t bus;
+  for (bus = 1; bus <= HOSTCAN_NUM_BUSES; ++bus) {
+    HostCan_GetHandle(bus)->Instance->TSR = empty[HostCan_FreeMailboxes(bus)];
+  }
+}
+
+/**
+ * @brief Sends the frames requested in the TX mailbox registers
+ */
+static void HostCan_TakeTxRequests(void)
+{
+  uint8_t bus;
+  for (bus = 1; bus <= HOSTCAN_NUM_BUSES; ++bus) {
+    CAN_TypeDef* can = HostCan_GetHandle(bus)->Instance;
+
+    uint8_t mailbox;
+    for (mailbox = 0; mailbox < HOSTCAN_TX_MAILBOXES; ++mailbox) {
+      CAN_TxMailBox_TypeDef* tx = &can->sTxMailBox[mailbox];
+      if (0U == (tx->TIR & CAN_TI0R_TXRQ)) {
+        continue;
+      }
+      CLEAR_BIT(tx->TIR, CAN_TI0R_TXRQ);
+
+      uint32_t id = (0U != (tx->TIR & CAN_TI0R_IDE)) ?
+          tx->TIR >> CAN_TI0R_EXID_Pos : (tx->TIR & CAN_TI0R_STID) >> CAN_TI0R_STID_Pos;
+      uint8_t len = (uint8_t)(tx->TDTR & CAN_TDT0R_DLC);
+      if (len > 8U) {
+        len = 8U;
+      }
+      uint32_t registers[2] = { tx->TDLR, tx->TDHR };
+      uint8_t data[8];
+      memcpy(data, registers, sizeof(data));
+
+      HostCan_Sent(bus, id, data, len);
+    }
+  }
+}
+
+// ------------------- Public methods -------------------
+CAN_Status_T CAN_Init(Logging_T* logger)
+{
+  logPrintS(logger, "CAN_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return CAN_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CAN_Status_T CAN_Config(CAN_HandleTypeDef* handle)
+{
+  return (0 != HostCan_GetBus(handle)) ? CAN_STATUS_OK : CAN_STATUS_ERROR;
+}
+
+//------------------------------------------------------------------------------
+CAN_Status_T CAN_SendMessage(CAN_HandleTypeDef* handle, uint32_t id, uint8_t* data, uint16_t len)
+{
+  uint8_t bus = HostCan_GetBus(handle);
+  if (0 == bus || len > 8U) {
+    return CAN_STATUS_ERROR;
+  }
+  if (0U == HostCan_FreeMailboxes(bus)) {
+    return CAN_STATUS_ERROR;
+  }
+
+  CAN_TxMailBox_TypeDef* tx = &handle->Instance->sTxMailBox[0];
+  tx->TIR = HostCan_IdRegister(id);
+  tx->TDTR = len;
+  HostCan_DataRegisters(data, (uint8_t)len, &tx->TDLR, &tx->TDHR);
+
+  HostCan_Sent(bus, id, data, (uint8_t)len);
+  return CAN_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CAN_Status_T CAN_RegisterCallback(CAN_HandleTypeDef* handle, uint32_t id, CAN_Callback callback)
+{
+  if (numCallbacks >= HOSTCAN_MAX_CALLBACKS || 0 == HostCan_GetBus(handle)) {
+    return CAN_STATUS_ERROR;
+  }
+
+  callbacks[numCallbacks].handle = handle;
+  callbacks[numCallbacks].id = id;
+  callbacks[numCallbacks].callback = callback;
+  numCallbacks++;
+  return CAN_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef* hcan)
+{
+  uint8_t bus = HostCan_GetBus(hcan);
+  if (0 == bus) {
+    return 0;
+  }
+  return HostCan_FreeMailboxes(bus);
+}
+
+//------------------------------------------------------------------------------
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef* hcan, CAN_FilterTypeDef* sFilterConfig)
+{
+  uint8_t bus = HostCan_GetBus(hcan);
+  if (0 == bus || sFilterConfig->FilterBank >= HOSTCAN_FILTER_BANKS) {
+    return HAL_ERROR;
+  }
+
+  // Only FIFO 1 lists of standard IDs are kept. Other frames reach the callbacks registered for their IDs.
+  HostCan_Filter_T* filter = &fifo1Filters[bus - 1U][sFilterConfig->FilterBank];
+  filter->active = (0U != sFilterConfig->FilterActivation) &&
+                   (CAN_FILTERMODE_IDLIST == sFilterConfig->FilterMode) &&
+                   (CAN_FILTERSCALE_32BIT == sFilterConfig->FilterScale) &&
+                   (CAN_FILTER_FIFO1 == sFilterConfig->FilterFIFOAssignment);
+  filter->ids[0] = (uint16_t)(sFilterConfig->FilterIdHigh >> (CAN_RI0R_STID_Pos - 16U));
+  filter->ids[1] = (uint16_t)(sFilterConfig->FilterMaskIdHigh >> (CAN_RI0R_STID_Pos - 16U));
+  return HAL_OK;
+}
+
+//------------------------------------------------------------------------------
+CAN_HandleTypeDef* HostCan_GetHandle(uint8_t bus)
+{
+  switch (bus) {
+    case 1: return &hcan1;
+    case 2: return &hcan2;
+    case 3: return &hcan3;
+    default: return NULL;
+  }
+}
+
+//------------------------------------------------------------------------------
+uint8_t HostCan_GetBus(const CAN_HandleTypeDef* hcan)
+{
+  if (NULL == hcan) {
+    return 0;
+  } else if (CAN1 == hcan->Instance) {
+    return 1;
+  } else if (CAN2 == hcan->Instance) {
+    return 2;
+  } else if (CAN3 == hcan->Instance) {
+    return 3;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+bool HostCan_Receive(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc)
+{
+  CAN_HandleTypeDef* handle = HostCan_GetHandle(bus);
+  if (NULL == handle) {
+    return false;
+  }
+
+  CAN_DataFrame_T frame;
+  memset(&frame, 0, sizeof(CAN_DataFrame_T));
+  frame.handle = handle;
+  frame.msgId = id;
+  // DLC 9-15 is valid on classic CAN, and still carries 8 bytes
+  frame.dlc = dlc & 0x0FU;
+  uint8_t len = (frame.dlc > 8U) ? 8U : (uint8_t)frame.dlc;
+  memcpy(frame.data, data, len);
+
+  if (HostCan_Fifo1Match(bus, id)) {
+    CAN_FIFOMailBox_TypeDef* rx = &handle->Instance->sFIFOMailBox[CAN_RX_FIFO1];
+    rx->RIR = HostCan_IdRegister(id);
+    rx->RDTR = frame.dlc;
+    HostCan_DataRegisters(frame.data, len, &rx->RDLR, &rx->RDHR);
+    handle->Instance->RF1R = 1U;   /* FMP1 */
+
+    HostCan_UpdateTsr();
+    if (NULL != rxFifo1Hook) {
+      rxFifo1Hook(handle);
+    }
+    HostCan_TakeTxRequests();
+
+    handle->Instance->RF1R = 0;
+    return true;
+  }
+
+  CAN_FIFOMailBox_TypeDef* rx = &handle->Instance->sFIFOMailBox[0];
+  rx->RIR = HostCan_IdRegister(id);
+  rx->RDTR = frame.dlc;
+  HostCan_DataRegisters(frame.data, len, &rx->RDLR, &rx->RDHR);
+  handle->Instance->RF0R = 1U;   /* FMP0 */
+
+  if (NULL != rxHook) {
+    rxHook(handle);
+  }
+
+  bool taken = false;
+  uint8_t i;
+  for (i = 0; i < numCallbacks; ++i) {
+    if (callbacks[i].handle == handle && callbacks[i].id == id) {
+      callbacks[i].callback(&frame);
+      taken = true;
+    }
+  }
+
+  // Released by the HAL handler
+  handle->Instance->RF0R = 0;
+  return taken;
+}
+
+//------------------------------------------------------------------------------
+void HostCan_SetRxHook(HostCan_RxHook_T hook)
+{
+  rxHook = hook;
+}
+
+//------------------------------------------------------------------------------
+void HostCan_SetRxFifo1Hook(HostCan_RxHook_T hook)
+{
+  rxFifo1Hook = hook;
+}
+
+//------------------------------------------------------------------------------
+void HostCan_SetTxHook(HostCan_TxHook_T hook)
+{
+  txHook = hook;
+}
+
+//------------------------------------------------------------------------------
+void HostCan_HoldTxMailboxes(uint8_t bus, bool hold)
+{
+  if (0 == bus || bus > HOSTCAN_NUM_BUSES) {
+    return;
+  }
+  txHold[bus - 1U] = hold;
+  txHeld[bus - 1U] = 0;
+}
+
+//------------------------------------------------------------------------------
+void HostCan_TxComplete(uint8_t bus)
+{
+  if (0 == bus || bus > HOSTCAN_NUM_BUSES || 0U == txHeld[bus - 1U]) {
+    return;
+  }
+  txHeld[bus - 1U]--;
+}
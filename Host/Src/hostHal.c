@@ -0,0 +1,147 @@
+/*
+ * hostHal.c
+ *
+ * The HAL functions, peripherals and handles used by the simulated modules.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "stm32f7xx_hal.h"
+
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+
+#include "hostSim.h"
+
+// ------------------- Private data -------------------
+/* As set up by SystemClock_Config */
+uint32_t SystemCoreClock = 200000000U;
+
+CAN_TypeDef hostCanRegs[3];
+CRC_TypeDef hostCrcRegs;
+DWT_Type hostDwt;
+
+/* A typical part: VREFINT reads 1.21V at 3.3V */
+uint16_t hostVrefintCal = 1502U;
+
+/* Handles main.c defines on the target. CAN handles are in hostCan.c. */
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
+ADC_HandleTypeDef hadc1;
+DMA_HandleTypeDef hdma_adc1;
+DMA_HandleTypeDef hdma_spi4_rx;
+DMA_HandleTypeDef hdma_spi4_tx;
+SPI_HandleTypeDef hspi4 = { .Instance = SPI4, .hdmatx = &hdma_spi4_tx, .hdmarx = &hdma_spi4_rx };
+RTC_HandleTypeDef hrtc;
+UART_HandleTypeDef huart1;
+
+typedef struct
+{
+  IRQn_Type irq;
+  uint32_t priority;
+} HostHal_Irq_T;
+
+/* The NVIC is configured as the mapping expects */
+#define HOSTHAL_IRQ_ENTRY(irq, priority) { irq, priority },
+static const HostHal_Irq_T irqs[] = {
+  MAPPING_RTOS_IRQS(HOSTHAL_IRQ_ENTRY)
+};
+
+static uint32_t resetCount;
+
+/* Output states, for the host to read back */
+#define HOSTHAL_MAX_GPIO_PORTS 11U
+
+typedef struct
+{
+  const GPIO_TypeDef* port;
+  uint16_t outputs;
+} HostHal_GpioPort_T;
+
+static HostHal_GpioPort_T gpioPorts[HOSTHAL_MAX_GPIO_PORTS];
+
+// ------------------- Private methods -------------------
+static HostHal_GpioPort_T* HostHal_GetGpioPort(const GPIO_TypeDef* port)
+{
+  size_t i;
+  for (i = 0; i < HOSTHAL_MAX_GPIO_PORTS; ++i) {
+    if (gpioPorts[i].port == port) {
+      return &gpioPorts[i];
+    }
+    if (NULL == gpioPorts[i].port) {
+      gpioPorts[i].port = port;
+      return &gpioPorts[i];
+    }
+  }
+  return NULL;
+}
+
+// ------------------- Public methods -------------------
+uint32_t HostHal_GetPriority(IRQn_Type irq)
+{
+  size_t i;
+  for (i = 0; i < sizeof(irqs) / sizeof(irqs[0]); ++i) {
+    if (irqs[i].irq == irq) {
+      return irqs[i].priority;
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+void HostHal_SystemReset(void)
+{
+  resetCount++;
+}
+
+//------------------------------------------------------------------------------
+uint32_t HostHal_GetResetCount(void)
+{
+  return resetCount;
+}
+
+//------------------------------------------------------------------------------
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef* hcan, uint32_t ActiveITs)
+{
+  (void)hcan;
+  (void)ActiveITs;
+  return HAL_OK;
+}
+
+//------------------------------------------------------------------------------
+bool HostGpio_IsSet(const GPIO_TypeDef* port, uint16_t pin)
+{
+  const HostHal_GpioPort_T* gpio = HostHal_GetGpioPort(port);
+  return (NULL != gpio) && (0U != (gpio->outputs & pin));
+}
+
+//------------------------------------------------------------------------------
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  // Recorded only, the host decides what outputs do
+  HostHal_GpioPort_T* gpio = HostHal_GetGpioPort(GPIOx);
+  if (NULL == gpio) {
+    return;
+  }
+
+  if (GPIO_PIN_RESET == PinState) {
+    gpio->outputs &= (uint16_t)~GPIO_Pin;
+  } else {
+    gpio->outputs |= GPIO_Pin;
+  }
+}
+
+//------------------------------------------------------------------------------
+void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  HostHal_GpioPort_T* gpio = HostHal_GetGpioPort(GPIOx);
+  if (NULL != gpio) {
+    gpio->outputs ^= GPIO_Pin;
+  }
+}
+
+//------------------------------------------------------------------------------
+uint32_t HAL_GetTick(void)
+{
+  return (uint32_t)(HostSim_GetTimeNs() / HOSTSIM_TICK_NS);
+}
@@ -0,0 +1,31 @@
+/*
+ * hostPort.h
+ *
+ * Between the host FreeRTOS port and the simulation control in hostSim.c.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef HOSTPORT_H_
+#define HOSTPORT_H_
+
+#include <stdbool.h>
+
+/**
+ * @brief Switch from the host program to the tasks. Returns once every task
+ * is blocked again.
+ */
+void HostPort_RunTasks(void);
+
+/**
+ * @brief Mark whether the host program is running as an interrupt
+ */
+void HostPort_SetInIsr(bool inIsr);
+
+/**
+ * @brief Whether the scheduler has been started
+ */
+bool HostPort_Started(void);
+
+#endif /* HOSTPORT_H_ */
@@ -0,0 +1,100 @@
+/*
+ * hostSim.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "hostSim.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "time/tasktimer/tasktimer.h"
+
+#include "hostPort.h"
+
+extern TIM_HandleTypeDef htim2;
+
+// ------------------- Private data -------------------
+static uint64_t timeNs;
+static uint64_t nextTickNs = HOSTSIM_TICK_NS;
+static HostSim_TickHook_T tickHook;
+
+// ------------------- Private methods -------------------
+static void HostSim_SetTime(uint64_t t)
+{
+  timeNs = t;
+
+  // The cycle counter wraps as on the target
+  uint64_t cyclesPerUs = SystemCoreClock / 1000000U;
+  DWT->CYCCNT = (uint32_t)((t * cyclesPerUs) / 1000U);
+}
+
+/**
+ * @brief The RTOS tick and the task timer interrupt, which both run at 1kHz
+ */
+static void HostSim_Tick(void)
+{
+  HostSim_EnterIsr();
+  (void)xTaskIncrementTick();
+  TaskTimer_TIM_PeriodElapsedCallback(&htim2);
+  HostSim_ExitIsr();
+
+  if (NULL != tickHook) {
+    tickHook(timeNs);
+  }
+}
+
+// ------------------- Public methods -------------------
+void HostSim_Start(void)
+{
+  HostSim_SetTime(0);
+  vTaskStartScheduler();
+}
+
+//------------------------------------------------------------------------------
+void HostSim_RunUntilIdle(void)
+{
+  HostPort_RunTasks();
+}
+
+//------------------------------------------------------------------------------
+void HostSim_AdvanceTo(uint64_t t)
+{
+  while (nextTickNs <= t) {
+    HostSim_SetTime(nextTickNs);
+    nextTickNs += HOSTSIM_TICK_NS;
+
+    HostSim_Tick();
+    HostPort_RunTasks();
+  }
+
+  if (t > timeNs) {
+    HostSim_SetTime(t);
+  }
+}
+
+//------------------------------------------------------------------------------
+uint64_t HostSim_GetTimeNs(void)
+{
+  return timeNs;
+}
+
+//------------------------------------------------------------------------------
+void HostSim_EnterIsr(void)
+{
+  HostPort_SetInIsr(true);
+}
+
+//------------------------------------------------------------------------------
+void HostSim_ExitIsr(void)
+{
+  HostPort_SetInIsr(false);
+}
+
+//------------------------------------------------------------------------------
+void HostSim_SetTickHook(HostSim_TickHook_T hook)
+{
+  tickHook = hook;
+}
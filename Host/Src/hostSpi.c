@@ -0,0 +1,145 @@
+/*
+ * hostSpi.c
+ *
+ * Host build of the HAL SPI DMA transfers. A transfer stays in progress
+ * until the host program completes it.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "hostSpi.h"
+
+#include <string.h>
+
+// ------------------- Private data -------------------
+typedef struct
+{
+  const SPI_HandleTypeDef* handle;
+
+  // Transfer in progress, length 0 when idle
+  const uint8_t* tx;
+  uint8_t* rx;
+  uint16_t length;
+
+  bool failNextStart;
+} HostSpi_Bus_T;
+
+static HostSpi_Bus_T buses[HOSTSPI_NUM_BUSES];
+
+static HostSpi_DeviceHook_T deviceHook;
+
+// ------------------- Private methods -------------------
+static HostSpi_Bus_T* HostSpi_GetBus(const SPI_HandleTypeDef* hspi)
+{
+  size_t i;
+  for (i = 0; i < HOSTSPI_NUM_BUSES; ++i) {
+    if (buses[i].handle == hspi) {
+      return &buses[i];
+    }
+    if (NULL == buses[i].handle) {
+      buses[i].handle = hspi;
+      return &buses[i];
+    }
+  }
+  return NULL;
+}
+
+static HAL_StatusTypeDef HostSpi_Start(SPI_HandleTypeDef* hspi, const uint8_t* tx, uint8_t* rx, uint16_t length)
+{
+  HostSpi_Bus_T* bus = HostSpi_GetBus(hspi);
+  if (NULL == bus || 0 == length) {
+    return HAL_ERROR;
+  }
+  if (0 != bus->length) {
+    return HAL_BUSY;
+  }
+  if (bus->failNextStart) {
+    bus->failNextStart = false;
+    return HAL_ERROR;
+  }
+
+  bus->tx = tx;
+  bus->rx = rx;
+  bus->length = length;
+  hspi->State = HAL_SPI_STATE_BUSY_TX_RX;
+  hspi->ErrorCode = HAL_SPI_ERROR_NONE;
+  return HAL_OK;
+}
+
+// ------------------- Public methods -------------------
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size)
+{
+  return HostSpi_Start(hspi, pData, NULL, Size);
+}
+
+//------------------------------------------------------------------------------
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size)
+{
+  return HostSpi_Start(hspi, NULL, pData, Size);
+}
+
+//------------------------------------------------------------------------------
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData,
+                                              uint16_t Size)
+{
+  return HostSpi_Start(hspi, pTxData, pRxData, Size);
+}
+
+//------------------------------------------------------------------------------
+void HostSpi_SetDeviceHook(HostSpi_DeviceHook_T hook)
+{
+  deviceHook = hook;
+}
+
+//------------------------------------------------------------------------------
+uint16_t HostSpi_GetPending(const SPI_HandleTypeDef* hspi)
+{
+  const HostSpi_Bus_T* bus = HostSpi_GetBus(hspi);
+  return (NULL != bus) ? bus->length : 0;
+}
+
+//------------------------------------------------------------------------------
+bool HostSpi_Complete(SPI_HandleTypeDef* hspi, bool error)
+{
+  HostSpi_Bus_T* bus = HostSpi_GetBus(hspi);
+  if (NULL == bus || 0 == bus->length) {
+    return false;
+  }
+
+  HostSpi_Bus_T transfer = *bus;
+  bus->length = 0;
+  hspi->State = HAL_SPI_STATE_READY;
+
+  // The callbacks may start the next transfer
+  if (error) {
+    hspi->ErrorCode = HAL_SPI_ERROR_DMA;
+    HAL_SPI_ErrorCallback(hspi);
+    return true;
+  }
+
+  if (NULL != deviceHook) {
+    deviceHook(hspi, transfer.tx, transfer.rx, transfer.length);
+  } else if (NULL != transfer.rx) {
+    // Nothing drives MISO
+    memset(transfer.rx, 0xFF, transfer.length);
+  }
+
+  if (NULL == transfer.rx) {
+    HAL_SPI_TxCpltCallback(hspi);
+  } else if (NULL == transfer.tx) {
+    HAL_SPI_RxCpltCallback(hspi);
+  } else {
+    HAL_SPI_TxRxCpltCallback(hspi);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void HostSpi_FailNextStart(const SPI_HandleTypeDef* hspi)
+{
+  HostSpi_Bus_T* bus = HostSpi_GetBus(hspi);
+  if (NULL != bus) {
+    bus->failNextStart = true;
+  }
+}
@@ -0,0 +1,31 @@
+/*
+ * logging.c
+ *
+ * Host build of the System library logger.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "lib/logging/logging.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ------------------- Public methods -------------------
+Logging_Status_T Log_Init(Logging_T* logger)
+{
+  logger->enableLogToStderr = false;
+  return LOGGING_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void logPrintS(Logging_T* logger, const char* buffer, size_t bufferLen)
+{
+  if (NULL == logger || !logger->enableLogToStderr) {
+    return;
+  }
+
+  size_t len = strnlen(buffer, bufferLen);
+  fwrite(buffer, 1, len, stderr);
+}
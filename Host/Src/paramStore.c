@@ -0,0 +1,152 @@
+/*
+ * paramStore.c
+ *
+ * Host build of the parameter store. The same API and RAM copies as the
+ * target, without the flash pages: each run starts from the defaults, and a
+ * save completes at once, to RAM.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "lib/paramStore/paramStore.h"
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ------------------- Private data -------------------
+static Logging_T* log;
+
+// RAM mirror: active, pending and retired
+static ParamStore_Value_T paramSets[3][PARAMSTORE_MAX_PARAMS];
+const ParamStore_Value_T* volatile paramStoreActive = paramSets[0];
+static ParamStore_Value_T* pendingSet;
+static ParamStore_Value_T* retiredSet;
+static TickType_t retiredTick;
+static bool pendingDirty;
+static bool pendingStale;
+
+static uint16_t paramCount;
+
+// Stands in for the flash pages
+static ParamStore_Value_T savedSet[PARAMSTORE_MAX_PARAMS];
+static ParamStore_Source_T source;
+
+// ------------------- Private methods -------------------
+static void ParamStore_SyncPending(void)
+{
+  if (pendingStale) {
+    memcpy(pendingSet, (const void*)paramStoreActive, paramCount * sizeof(ParamStore_Value_T));
+    pendingStale = false;
+  }
+}
+
+// ------------------- Public methods -------------------
+ParamStore_Status_T ParamStore_Init(
+    Logging_T* logger,
+    const ParamStore_Value_T* defaults,
+    uint16_t count)
+{
+  log = logger;
+  logPrintS(log, "ParamStore_Init begin\n", LOGGING_DEFAULT_BUFF_LEN);
+
+  if (count > PARAMSTORE_MAX_PARAMS) {
+    return PARAMSTORE_STATUS_ERROR;
+  }
+
+  paramCount = count;
+  memset(paramSets, 0, sizeof(paramSets));
+  memcpy(paramSets[0], defaults, count * sizeof(ParamStore_Value_T));
+  memcpy(paramSets[1], paramSets[0], sizeof(paramSets[0]));
+  paramStoreActive = paramSets[0];
+  pendingSet = paramSets[1];
+  retiredSet = paramSets[2];
+  retiredTick = xTaskGetTickCount() - pdMS_TO_TICKS(PARAMSTORE_GRACE_MS);
+  pendingDirty = false;
+  pendingStale = false;
+  source = PARAMSTORE_SOURCE_DEFAULTS;
+
+  logPrintS(log, "ParamStore_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+uint16_t ParamStore_GetCount(void)
+{
+  return paramCount;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_Set(ParamStore_Id_T id, ParamStore_Value_T value)
+{
+  if (id >= paramCount) {
+    return PARAMSTORE_STATUS_ERROR_ID;
+  }
+
+  ParamStore_SyncPending();
+  pendingSet[id] = value;
+  pendingDirty = true;
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_GetPending(ParamStore_Id_T id, ParamStore_Value_T* value)
+{
+  if (id >= paramCount) {
+    return PARAMSTORE_STATUS_ERROR_ID;
+  }
+
+  *value = pendingStale ? paramStoreActive[id] : pendingSet[id];
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_Apply(void)
+{
+  if (!pendingDirty) {
+    return PARAMSTORE_STATUS_OK;
+  }
+
+  // The same grace period as the target, so callers see the same retries
+  if ((xTaskGetTickCount() - retiredTick) < pdMS_TO_TICKS(PARAMSTORE_GRACE_MS)) {
+    return PARAMSTORE_STATUS_BUSY;
+  }
+
+  ParamStore_Value_T* previous = (ParamStore_Value_T*)paramStoreActive;
+  paramStoreActive = pendingSet;
+  pendingSet = retiredSet;
+  retiredSet = previous;
+  retiredTick = xTaskGetTickCount();
+  pendingDirty = false;
+  pendingStale = true;
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void ParamStore_Revert(void)
+{
+  pendingDirty = false;
+  pendingStale = true;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_Save(void)
+{
+  memcpy(savedSet, (const void*)paramStoreActive, paramCount * sizeof(ParamStore_Value_T));
+  source = (PARAMSTORE_SOURCE_PAGE_A == source) ? PARAMSTORE_SOURCE_PAGE_B : PARAMSTORE_SOURCE_PAGE_A;
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Status_T ParamStore_GetSaveStatus(void)
+{
+  return PARAMSTORE_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+ParamStore_Source_T ParamStore_GetSource(void)
+{
+  return source;
+}
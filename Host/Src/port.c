@@ -0,0 +1,241 @@
+/*
+ * port.c
+ *
+ * FreeRTOS port for host builds, see portmacro.h.
+ *
+ * Each task runs on its own heap allocated stack as a ucontext coroutine.
+ * The stack the kernel allocates from the task's buffer only holds a
+ * pointer to the coroutine, so the Application's stack sizes don't need to
+ * allow for the host C library.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "hostPort.h"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define HOSTPORT_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define HOSTPORT_ASAN 1
+#endif
+#endif
+
+#ifdef HOSTPORT_ASAN
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+// ------------------- Private data -------------------
+#define HOSTPORT_STACK_SIZE (512U * 1024U)
+
+typedef struct
+{
+  ucontext_t context;
+  void* stack;
+  size_t stackSize;
+  TaskFunction_t code;
+  void* parameters;
+} HostPort_Context_T;
+
+// The kernel's current task. Its first member is the top of stack.
+extern void* volatile pxCurrentTCB;
+
+// The host program, on the process stack
+static HostPort_Context_T hostContext;
+
+static bool started;
+static bool inIsr;
+
+static StaticTask_t idleTaskBuffer;
+static StackType_t idleTaskStack[configMINIMAL_STACK_SIZE];
+
+// ------------------- Private methods -------------------
+static HostPort_Context_T* HostPort_CurrentContext(void)
+{
+  StackType_t* topOfStack = *(StackType_t**)pxCurrentTCB;
+  return (HostPort_Context_T*)*topOfStack;
+}
+
+/**
+ * @brief Completes a switch on the destination side. The sanitizer is told
+ * which stack is now in use, and gives back the bounds of the one left.
+ */
+static void HostPort_FinishSwitch(void* fakeStack, HostPort_Context_T* from)
+{
+#ifdef HOSTPORT_ASAN
+  const void* bottom;
+  size_t size;
+  __sanitizer_finish_switch_fiber(fakeStack, &bottom, &size);
+  if (&hostContext == from) {
+    hostContext.stack = (void*)bottom;
+    hostContext.stackSize = size;
+  }
+#else
+  (void)fakeStack;
+  (void)from;
+#endif
+}
+
+// Set before each switch, for the destination to pass to HostPort_FinishSwitch
+static HostPort_Context_T* switchFrom;
+
+static void HostPort_Switch(HostPort_Context_T* from, HostPort_Context_T* to)
+{
+  void* fakeStack = NULL;
+#ifdef HOSTPORT_ASAN
+  __sanitizer_start_switch_fiber(&fakeStack, to->stack, to->stackSize);
+#endif
+  switchFrom = from;
+  swapcontext(&from->context, &to->context);
+  HostPort_FinishSwitch(fakeStack, switchFrom);
+}
+
+static void HostPort_TaskEntry(void)
+{
+  HostPort_FinishSwitch(NULL, switchFrom);
+
+  HostPort_Context_T* context = HostPort_CurrentContext();
+  context->code(context->parameters);
+
+  // Tasks must not return
+  vAssertCalled(__FILE__, __LINE__);
+}
+
+// ------------------- Port interface -------------------
+StackType_t* pxPortInitialiseStack(StackType_t* pxTopOfStack, TaskFunction_t pxCode, void* pvParameters)
+{
+  HostPort_Context_T* context = calloc(1, sizeof(HostPort_Context_T));
+  configASSERT(NULL != context);
+  context->stackSize = HOSTPORT_STACK_SIZE;
+  context->stack = malloc(context->stackSize);
+  configASSERT(NULL != context->stack);
+  context->code = pxCode;
+  context->parameters = pvParameters;
+
+  getcontext(&context->context);
+  context->context.uc_stack.ss_sp = context->stack;
+  context->context.uc_stack.ss_size = context->stackSize;
+  context->context.uc_link = NULL;
+  makecontext(&context->context, HostPort_TaskEntry, 0);
+
+  *pxTopOfStack = (StackType_t)context;
+  return pxTopOfStack;
+}
+
+//------------------------------------------------------------------------------
+BaseType_t xPortStartScheduler(void)
+{
+  started = true;
+  HostPort_Switch(&hostContext, HostPort_CurrentContext());
+
+  // Every task has blocked, see vApplicationIdleHook
+  return pdTRUE;
+}
+
+//------------------------------------------------------------------------------
+void vPortEndScheduler(void)
+{
+}
+
+//------------------------------------------------------------------------------
+void vPortYield(void)
+{
+  HostPort_Context_T* from = HostPort_CurrentContext();
+  vTaskSwitchContext();
+  HostPort_Context_T* to = HostPort_CurrentContext();
+  if (from != to) {
+    HostPort_Switch(from, to);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vPortYieldFromISR(void)
+{
+  // The host program resumes the tasks when its interrupt work is done.
+  // Called from a task, it takes effect at once, as PendSV would.
+  if (!inIsr) {
+    vPortYield();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vPortEnterCritical(void)
+{
+}
+
+//------------------------------------------------------------------------------
+void vPortExitCritical(void)
+{
+}
+
+//------------------------------------------------------------------------------
+BaseType_t xPortIsInsideInterrupt(void)
+{
+  return inIsr ? pdTRUE : pdFALSE;
+}
+
+//------------------------------------------------------------------------------
+void* pvPortMalloc(size_t xSize)
+{
+  return malloc(xSize);
+}
+
+//------------------------------------------------------------------------------
+void vPortFree(void* pv)
+{
+  free(pv);
+}
+
+// ------------------- Application hooks -------------------
+void vApplicationGetIdleTaskMemory(StaticTask_t** ppxIdleTaskTCBBuffer,
+                                   StackType_t** ppxIdleTaskStackBuffer,
+                                   uint32_t* pulIdleTaskStackSize)
+{
+  *ppxIdleTaskTCBBuffer = &idleTaskBuffer;
+  *ppxIdleTaskStackBuffer = idleTaskStack;
+  *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+//------------------------------------------------------------------------------
+void vApplicationIdleHook(void)
+{
+  // Every task is blocked, so back to the host program
+  HostPort_Switch(HostPort_CurrentContext(), &hostContext);
+
+  // Run whatever the host woke
+  vPortYield();
+}
+
+//------------------------------------------------------------------------------
+void vAssertCalled(const char* file, int line)
+{
+  fprintf(stderr, "configASSERT failed: %s:%d\n", file, line);
+  abort();
+}
+
+// ------------------- Simulation interface -------------------
+void HostPort_RunTasks(void)
+{
+  configASSERT(started && !inIsr);
+  HostPort_Switch(&hostContext, HostPort_CurrentContext());
+}
+
+//------------------------------------------------------------------------------
+void HostPort_SetInIsr(bool isr)
+{
+  inIsr = isr;
+}
+
+//------------------------------------------------------------------------------
+bool HostPort_Started(void)
+{
+  return started;
+}
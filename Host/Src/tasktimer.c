@@ -0,0 +1,75 @@
+/*
+ * tasktimer.c
+ *
+ * Host build of the System library task timer.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "time/tasktimer/tasktimer.h"
+
+#include "hostSim.h"
+
+// ------------------- Private data -------------------
+#define TASKTIMER_MAX_TASKS 32U
+
+typedef struct
+{
+  TaskHandle_t* handle;
+  uint16_t divider;
+} TaskTimer_Task_T;
+
+static TaskTimer_Task_T tasks[TASKTIMER_MAX_TASKS];
+static uint8_t numTasks;
+static uint32_t count;
+static uint32_t overruns;
+
+// ------------------- Public methods -------------------
+TaskTimer_Status_T TaskTimer_Init(Logging_T* logger, TIM_HandleTypeDef* htim)
+{
+  (void)htim;
+  logPrintS(logger, "TaskTimer_Init complete\n", LOGGING_DEFAULT_BUFF_LEN);
+  return TASKTIMER_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+TaskTimer_Status_T TaskTimer_RegisterTask(TaskHandle_t* handle, uint16_t divider)
+{
+  if (numTasks >= TASKTIMER_MAX_TASKS || 0 == divider) {
+    return TASKTIMER_STATUS_ERROR;
+  }
+
+  tasks[numTasks].handle = handle;
+  tasks[numTasks].divider = divider;
+  numTasks++;
+  return TASKTIMER_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+void TaskTimer_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
+{
+  (void)htim;
+  count++;
+
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  uint8_t i;
+  for (i = 0; i < numTasks; ++i) {
+    if (0 == (count % tasks[i].divider)) {
+      // As vTaskNotifyGiveFromISR. A task that hasn't taken the last
+      // notification is still on its previous period.
+      uint32_t previous;
+      (void)xTaskNotifyAndQueryFromISR(*tasks[i].handle, 0, eIncrement, &previous, &higherPriorityTaskWoken);
+      if (previous > 0) {
+        overruns++;
+      }
+    }
+  }
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+//------------------------------------------------------------------------------
+uint32_t HostTaskTimer_GetOverruns(void)
+{
+  return overruns;
+}
@@ -0,0 +1,407 @@
+/*
+ * analogTest.c
+ *
+ * Checks of the analog wiring diagnostics, on the simulation with the
+ * pedals process reading the channels:
+ *  - Analog_Classify, for each wiring state.
+ *  - The slot schedule: each bias pin is switched for SETTLE ticks per
+ *    period, the slots don't overlap, and only the channels of the pin under
+ *    test are held, for SETTLE readings at their reading from before.
+ *  - Faults found through the schedule within the documented time, from
+ *    inputs that follow the bias, and cleared again once reconnected.
+ *  - APPS1 and APPS2, held at different times, disagree for no longer than
+ *    the hold while the pedal moves, and never trip the plausibility check.
+ *
+ * Exits non-zero if any check fails.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hostSim.h"
+
+#include "lib/logging/logging.h"
+#include "lib/paramStore/paramStore.h"
+#include "lib/signalDb/signalDb.h"
+#include "io/adc/adc.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "time/deferred/deferred.h"
+#include "device/analog/analog.h"
+#include "device/inverter/inverter.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleInterface/analogMapping/analogMapping.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+extern CAN_HandleTypeDef hcan1;
+extern uint16_t hostVrefintCal;
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+typedef enum
+{
+  ANALOGTEST_WIRE_CONNECTED,
+  ANALOGTEST_WIRE_OPEN,
+  ANALOGTEST_WIRE_SHORT_GROUND,
+  ANALOGTEST_WIRE_SHORT_SUPPLY
+} AnalogTest_Wire_T;
+
+/*
+ * An input: a sensor driving it, or a wiring fault. A connected sensor is
+ * pulled slightly by the weak bias, an open input follows it.
+ */
+typedef struct
+{
+  AnalogTest_Wire_T wire;
+  uint16_t sensor;              /* Counts driven by a connected sensor */
+} AnalogTest_Input_T;
+
+#define ANALOGTEST_BIAS_PULL      ((uint16_t) 20U)
+#define ANALOGTEST_OPEN_UP        ((uint16_t) 3900U)
+#define ANALOGTEST_OPEN_DOWN      ((uint16_t) 150U)
+
+static AnalogTest_Input_T inputs[MAPPING_ADC_NUM_INPUTS];
+
+static const Analog_BiasConfig_T* biases;
+static uint8_t numBiases;
+static GPIO_PinState biasNormal[ANALOG_MAX_CHANNELS];
+
+// Pedal sensors, as the pedals calibration expects
+#define ANALOGTEST_PEDAL_LOW      400.0f
+#define ANALOGTEST_PEDAL_SPAN     3200.0f
+
+// Faster than any foot, full travel and back
+#define ANALOGTEST_SWEEP_MS       20U
+
+static uint32_t failures;
+static uint64_t tickNs;
+
+// ------------------- Private methods -------------------
+static void AnalogTest_Check(bool pass, const char* what)
+{
+  if (!pass) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static bool AnalogTest_PulledUp(ADC_Channel_T channel)
+{
+  uint8_t b;
+  for (b = 0; b < numBiases; ++b) {
+    if (0 != (biases[b].channels & (1UL << channel))) {
+      // RESET pulls up
+      return !HostGpio_IsSet(biases[b].port, biases[b].pin);
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief The inputs as the ADC sees them, with the bias pins as the
+ * firmware left them
+ */
+static void AnalogTest_TickHook(uint64_t timeNs)
+{
+  (void)timeNs;
+
+  uint8_t i;
+  for (i = 0; i < MAPPING_ADC_NUM_INPUTS; ++i) {
+    bool up = AnalogTest_PulledUp(i);
+    uint16_t raw;
+    switch (inputs[i].wire) {
+      case ANALOGTEST_WIRE_OPEN:
+        raw = up ? ANALOGTEST_OPEN_UP : ANALOGTEST_OPEN_DOWN;
+        break;
+      case ANALOGTEST_WIRE_SHORT_GROUND:
+        raw = 10U;
+        break;
+      case ANALOGTEST_WIRE_SHORT_SUPPLY:
+        raw = ANALOG_FULL_SCALE - 5U;
+        break;
+      default:
+        raw = up ? inputs[i].sensor + ANALOGTEST_BIAS_PULL : inputs[i].sensor - ANALOGTEST_BIAS_PULL;
+        break;
+    }
+    HostAdc_Set(i, raw);
+  }
+}
+
+static void AnalogTest_Tick(void)
+{
+  tickNs += HOSTSIM_TICK_NS;
+  HostSim_AdvanceTo(tickNs);
+}
+
+static void AnalogTest_Connect(void)
+{
+  uint8_t i;
+  for (i = 0; i < MAPPING_ADC_NUM_INPUTS; ++i) {
+    inputs[i].wire = ANALOGTEST_WIRE_CONNECTED;
+    inputs[i].sensor = 2000U;
+  }
+}
+
+/**
+ * @brief The firmware modules the pedals need, in the order initialize.c
+ * starts them
+ */
+static bool AnalogTest_InitFirmware(void)
+{
+  Log_Init(&firmwareLog);
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  uint8_t numAnalogChannels;
+  const Analog_ChannelConfig_T* analogChannels = Mapping_GetAnalogChannels(&numAnalogChannels);
+  biases = Mapping_GetAnalogBiases(&numBiases);
+
+  return PARAMSTORE_STATUS_OK == ParamStore_Init(&firmwareLog, Mapping_GetParamDefaults(), MAPPING_PARAM_NUM_PARAMS) &&
+         ADC_STATUS_OK == ADC_Init(&firmwareLog, MAPPING_ADC_NUM_CHANNELS, 16) &&
+         DEFERRED_STATUS_OK == Deferred_Init(&firmwareLog) &&
+         SIGNALDB_STATUS_OK == SignalDb_Init(&firmwareLog, signalGroups, numSignalGroups) &&
+         CANMONITOR_STATUS_OK == CanMonitor_Init(&firmwareLog) &&
+         CANRECORDER_STATUS_OK == CanRecorder_Init(&firmwareLog) &&
+         INVERTER_STATUS_OK == Inverter_Init(&firmwareLog, &hcan1) &&
+         ANALOG_STATUS_OK == Analog_Init(&firmwareLog, analogChannels, numAnalogChannels, MAPPING_ADC1_VREFINT,
+                                         biases, numBiases) &&
+         PEDALS_STATUS_OK == Pedals_Init(&firmwareLog);
+}
+
+static void AnalogTest_Classify(void)
+{
+  printf("Classify\n");
+  AnalogTest_Check(ANALOG_HEALTH_OK == Analog_Classify(2020U, 1980U), "sensor driving the input is OK");
+  AnalogTest_Check(ANALOG_HEALTH_OK == Analog_Classify(ANALOG_DIAG_RAIL_COUNTS, ANALOG_DIAG_RAIL_COUNTS),
+                   "sensor at the bottom of the rail margin is OK");
+  AnalogTest_Check(ANALOG_HEALTH_OPEN == Analog_Classify(ANALOGTEST_OPEN_UP, ANALOGTEST_OPEN_DOWN),
+                   "input following the bias is open");
+  AnalogTest_Check(ANALOG_HEALTH_OK == Analog_Classify(1000U + ANALOG_DIAG_OPEN_COUNTS, 1000U),
+                   "difference of exactly the open threshold is OK");
+  AnalogTest_Check(ANALOG_HEALTH_OPEN == Analog_Classify(1001U + ANALOG_DIAG_OPEN_COUNTS, 1000U),
+                   "difference over the open threshold is open");
+  AnalogTest_Check(ANALOG_HEALTH_SHORT_GROUND == Analog_Classify(10U, 5U), "input at ground both ways is a short");
+  AnalogTest_Check(ANALOG_HEALTH_SHORT_GROUND == Analog_Classify(10U, 3000U),
+                   "pulled up reading at ground is a short, whatever the other");
+  AnalogTest_Check(ANALOG_HEALTH_SHORT_SUPPLY == Analog_Classify(4090U, 4085U),
+                   "input at the supply both ways is a short");
+  AnalogTest_Check(ANALOG_HEALTH_SHORT_SUPPLY ==
+                   Analog_Classify(ANALOG_FULL_SCALE, ANALOG_FULL_SCALE - ANALOG_DIAG_RAIL_COUNTS + 1U),
+                   "pulled down reading within the rail margin of the supply is a short");
+}
+
+/**
+ * @brief Runs whole diagnostic periods with every sensor moving, so a held
+ * reading can be told from a live one
+ */
+static void AnalogTest_Schedule(void)
+{
+  printf("Slot schedule\n");
+  AnalogTest_Connect();
+
+  const uint16_t periods = 4U;
+  uint16_t switchedTicks[ANALOG_MAX_CHANNELS] = {0};
+  uint16_t heldTicks[MAPPING_ADC_NUM_INPUTS] = {0};
+  uint16_t prevRaw[MAPPING_ADC_NUM_INPUTS] = {0};
+  uint16_t heldRaw[MAPPING_ADC_NUM_INPUTS] = {0};
+  bool held[MAPPING_ADC_NUM_INPUTS] = {0};
+  bool badHoldValue = false;
+  bool overlap = false;
+  bool heldUnbiased = false;
+  bool heldUnswitched = false;
+  uint32_t prevSwitchedChannels = 0;
+  uint16_t longestHold = 0;
+  uint16_t holdRun[MAPPING_ADC_NUM_INPUTS] = {0};
+
+  uint16_t t;
+  for (t = 0; t < periods * ANALOG_DIAG_PERIOD_MS; ++t) {
+    uint8_t i;
+    for (i = 0; i < MAPPING_ADC_NUM_INPUTS; ++i) {
+      inputs[i].sensor = (uint16_t)(1000U + 7U * t + 100U * i);
+    }
+    AnalogTest_Tick();
+
+    uint8_t switched = 0;
+    uint32_t switchedChannels = 0;
+    uint8_t b;
+    for (b = 0; b < numBiases; ++b) {
+      GPIO_PinState state = HostGpio_IsSet(biases[b].port, biases[b].pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+      if (state != biasNormal[b]) {
+        switched++;
+        switchedTicks[b]++;
+        switchedChannels |= biases[b].channels;
+      }
+    }
+    overlap = overlap || (switched > 1U);
+
+    // Held channels read as they did before the hold
+    uint32_t biased = 0;
+    for (b = 0; b < numBiases; ++b) {
+      biased |= biases[b].channels;
+    }
+    for (i = 0; i < MAPPING_ADC_NUM_INPUTS; ++i) {
+      uint16_t raw = ADC_Get(i);
+      uint16_t counts = Analog_GetCounts(i);
+      bool isHeld = (counts != raw);
+      if (isHeld) {
+        if (!held[i]) {
+          heldRaw[i] = prevRaw[i];
+        }
+        badHoldValue = badHoldValue || (counts != heldRaw[i]);
+        heldUnbiased = heldUnbiased || (0 == (biased & (1UL << i)));
+        // The reading was taken with the bias as the last tick left it
+        heldUnswitched = heldUnswitched || (0 == (prevSwitchedChannels & (1UL << i)));
+        heldTicks[i]++;
+        holdRun[i]++;
+        if (holdRun[i] > longestHold) {
+          longestHold = holdRun[i];
+        }
+      } else {
+        holdRun[i] = 0;
+      }
+      held[i] = isHeld;
+      prevRaw[i] = raw;
+    }
+    prevSwitchedChannels = switchedChannels;
+  }
+
+  uint8_t b;
+  for (b = 0; b < numBiases; ++b) {
+    char what[96];
+    snprintf(what, sizeof(what), "%s switched %u ticks over %u periods, expected %u",
+             biases[b].name, switchedTicks[b], periods, periods * ANALOG_DIAG_SETTLE_MS);
+    AnalogTest_Check(switchedTicks[b] == periods * ANALOG_DIAG_SETTLE_MS, what);
+  }
+
+  uint8_t i;
+  for (i = 0; i < MAPPING_ADC_NUM_INPUTS; ++i) {
+    bool isBiased = false;
+    for (b = 0; b < numBiases; ++b) {
+      isBiased = isBiased || (0 != (biases[b].channels & (1UL << i)));
+    }
+    uint16_t expected = isBiased ? (uint16_t)(periods * ANALOG_DIAG_SETTLE_MS) : 0U;
+    char what[96];
+    snprintf(what, sizeof(what), "channel %u held %u readings over %u periods, expected %u",
+             i, heldTicks[i], periods, expected);
+    AnalogTest_Check(heldTicks[i] == expected, what);
+  }
+
+  printf("  Longest hold %u readings of every %u\n", longestHold, ANALOG_DIAG_PERIOD_MS);
+  AnalogTest_Check(longestHold == ANALOG_DIAG_SETTLE_MS, "a hold lasts the settle time");
+  AnalogTest_Check(!overlap, "bias pins never switched together");
+  AnalogTest_Check(!heldUnbiased, "channels without a bias pin never held");
+  AnalogTest_Check(!heldUnswitched, "channels only held while their bias pin is switched");
+  AnalogTest_Check(!badHoldValue, "held channels keep their reading from before the switch");
+}
+
+/**
+ * @brief Sweeps the accelerator faster than a driver can, with both APPS
+ * channels agreeing at their inputs
+ */
+static void AnalogTest_PedalSweep(void)
+{
+  printf("Pedal sweep, full travel in %u ms\n", ANALOGTEST_SWEEP_MS);
+  AnalogTest_Connect();
+  inputs[MAPPING_ADC_BRAKE].sensor = (uint16_t)ANALOGTEST_PEDAL_LOW;
+
+  Pedals_Output_T output;
+  uint16_t run = 0;
+  uint16_t longestRun = 0;
+  uint16_t faults = PEDALS_FAULT_NONE;
+
+  uint16_t t;
+  for (t = 0; t < 10U * ANALOG_DIAG_PERIOD_MS; ++t) {
+    uint16_t phase = t % (2U * ANALOGTEST_SWEEP_MS);
+    float position = (phase < ANALOGTEST_SWEEP_MS) ? (float)phase / ANALOGTEST_SWEEP_MS
+                                                   : (float)(2U * ANALOGTEST_SWEEP_MS - phase) / ANALOGTEST_SWEEP_MS;
+    inputs[MAPPING_ADC_APPS1].sensor = (uint16_t)(ANALOGTEST_PEDAL_LOW + ANALOGTEST_PEDAL_SPAN * position);
+    inputs[MAPPING_ADC_APPS2].sensor =
+        (uint16_t)(ANALOGTEST_PEDAL_LOW + ANALOGTEST_PEDAL_SPAN * (1.0f - position));
+    AnalogTest_Tick();
+
+    Pedals_GetOutput(&output);
+    float diff = output.apps1 - output.apps2;
+    if (diff < 0.0f) {
+      diff = -diff;
+    }
+    run = (diff > 0.10f) ? (uint16_t)(run + 1U) : 0U;
+    if (run > longestRun) {
+      longestRun = run;
+    }
+    faults |= output.faults;
+  }
+
+  printf("  Longest disagreement %u cycles\n", longestRun);
+  AnalogTest_Check(longestRun <= ANALOG_DIAG_SETTLE_MS, "APPS disagree for no longer than the hold");
+  AnalogTest_Check(0 == (faults & PEDALS_FAULT_APPS_DISAGREE), "no APPS disagreement fault");
+  AnalogTest_Check(PEDALS_FAULT_NONE == faults, "no pedal faults");
+}
+
+static void AnalogTest_Faults(void)
+{
+  // Within DEBOUNCE tests of each pin, the last pin's slot ending last
+  const uint16_t reportMs = ANALOG_DIAG_DEBOUNCE * ANALOG_DIAG_PERIOD_MS + ANALOG_DIAG_SLOT_MS;
+  printf("Faults, reported within %u ms\n", reportMs);
+
+  AnalogTest_Connect();
+  inputs[MAPPING_ADC_APPS1].wire = ANALOGTEST_WIRE_OPEN;
+  inputs[MAPPING_ADC_APPS2].wire = ANALOGTEST_WIRE_SHORT_SUPPLY;
+  inputs[MAPPING_ADC_BRAKE].wire = ANALOGTEST_WIRE_SHORT_GROUND;
+
+  uint16_t t;
+  for (t = 0; t < reportMs; ++t) {
+    AnalogTest_Tick();
+  }
+  AnalogTest_Check(ANALOG_HEALTH_OPEN == Analog_GetHealth(MAPPING_ADC_APPS1), "APPS1 open");
+  AnalogTest_Check(ANALOG_HEALTH_SHORT_SUPPLY == Analog_GetHealth(MAPPING_ADC_APPS2), "APPS2 shorted to supply");
+  AnalogTest_Check(ANALOG_HEALTH_SHORT_GROUND == Analog_GetHealth(MAPPING_ADC_BRAKE), "brake shorted to ground");
+  AnalogTest_Check(ANALOG_HEALTH_NOT_TESTED == Analog_GetHealth(MAPPING_ADC_TEMP1), "temp1 has no bias pin");
+
+  Pedals_Output_T output;
+  Pedals_GetOutput(&output);
+  AnalogTest_Check(0 != (output.faults & PEDALS_FAULT_APPS1_RANGE), "pedals see the APPS1 fault");
+  AnalogTest_Check(0.0f == output.torqueRequest, "no torque with a wiring fault");
+
+  AnalogTest_Connect();
+  for (t = 0; t < reportMs; ++t) {
+    AnalogTest_Tick();
+  }
+  AnalogTest_Check(ANALOG_HEALTH_OK == Analog_GetHealth(MAPPING_ADC_APPS1), "APPS1 OK once reconnected");
+  AnalogTest_Check(ANALOG_HEALTH_OK == Analog_GetHealth(MAPPING_ADC_APPS2), "APPS2 OK once reconnected");
+  AnalogTest_Check(ANALOG_HEALTH_OK == Analog_GetHealth(MAPPING_ADC_BRAKE), "brake OK once reconnected");
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  AnalogTest_Connect();
+  HostSim_SetTickHook(AnalogTest_TickHook);
+  HostAdc_Set(MAPPING_ADC1_VREFINT, hostVrefintCal);
+
+  if (!AnalogTest_InitFirmware()) {
+    printf("Firmware failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+
+  uint8_t b;
+  for (b = 0; b < numBiases; ++b) {
+    biasNormal[b] = HostGpio_IsSet(biases[b].port, biases[b].pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+  }
+
+  HostSim_Start();
+
+  AnalogTest_Classify();
+  AnalogTest_Schedule();
+  AnalogTest_PedalSweep();
+  AnalogTest_Faults();
+
+  printf("%u checks failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+/*
+ * benchmarkTest.c
+ *
+ * Runs the benchmark suite's kernels on the host against their budgets, as
+ * a coarse check for a kernel that has become far slower, e.g. a lookup
+ * that now searches a whole table.
+ *
+ * The kernels run in a task on the simulation, as they do in the benchmark
+ * task on the target. Each is timed like the benchmark module does: its
+ * fastest of BENCHMARK_ITERATIONS iterations, less the cost of the timing.
+ * The timing is the host's clock, and a budget in target cycles is taken
+ * as a time at SystemCoreClock. A host is many times faster than the
+ * target, so passing here says nothing of the target's figures, but a
+ * kernel over its budget here is badly over it on the target.
+ *
+ * The CRC kernel is left out: the CRC unit is only registers on the host.
+ *
+ * Exits non-zero if any kernel is over its budget.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "hostSim.h"
+
+#include "lib/logging/logging.h"
+#include "time/benchmark/benchmark.h"
+#include "vehicleInterface/benchmarkMapping/benchmarkMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+/* Kernels of the target's peripherals, which the host doesn't time */
+static const char* const targetOnly[] = {
+  "crc32_256B",
+};
+
+#define STACK_SIZE 2000
+#define BENCHMARKTEST_PRIORITY 1
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[STACK_SIZE];
+
+static uint32_t failures;
+static bool finished;
+
+// ------------------- Private methods -------------------
+static uint64_t BenchmarkTest_Now(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void BenchmarkTest_Empty(void)
+{
+}
+
+/**
+ * @brief Fastest iteration of a kernel
+ * @param overhead Nanoseconds taken off each iteration
+ */
+static uint64_t BenchmarkTest_Time(void (*kernel)(void), uint64_t overhead)
+{
+  uint64_t min = UINT64_MAX;
+  uint16_t i;
+  for (i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+    uint64_t start = BenchmarkTest_Now();
+    kernel();
+    uint64_t elapsed = BenchmarkTest_Now() - start;
+    if (elapsed < min) {
+      min = elapsed;
+    }
+  }
+  return (min > overhead) ? min - overhead : 0;
+}
+
+static bool BenchmarkTest_IsTargetOnly(const char* name)
+{
+  size_t i;
+  for (i = 0; i < sizeof(targetOnly) / sizeof(targetOnly[0]); ++i) {
+    if (0 == strcmp(name, targetOnly[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void BenchmarkTest_TaskMain(void* pvParameters)
+{
+  uint8_t numBenchmarks;
+  const Benchmark_T* benchmarks = Mapping_GetBenchmarks(&numBenchmarks);
+
+  uint64_t overhead = BenchmarkTest_Time(BenchmarkTest_Empty, 0);
+
+  printf("%-16s %10s %10s\n", "kernel", "host ns", "budget ns");
+  uint8_t i;
+  for (i = 0; i < numBenchmarks; ++i) {
+    const Benchmark_T* benchmark = &benchmarks[i];
+    if (BenchmarkTest_IsTargetOnly(benchmark->name)) {
+      printf("%-16s %10s\n", benchmark->name, "target only");
+      continue;
+    }
+
+    if (NULL != benchmark->setup) {
+      benchmark->setup();
+    }
+    uint64_t ns = BenchmarkTest_Time(benchmark->kernel, overhead);
+    uint64_t budgetNs = ((uint64_t)benchmark->budgetCycles * 1000000000ULL) / SystemCoreClock;
+    bool passed = ns <= budgetNs;
+    if (!passed) {
+      failures++;
+    }
+    printf("%-16s %10llu %10llu %s\n", benchmark->name, (unsigned long long)ns,
+        (unsigned long long)budgetNs, passed ? "PASS" : "FAIL");
+  }
+
+  finished = true;
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  Log_Init(&firmwareLog);
+
+  xTaskCreateStatic(
+      BenchmarkTest_TaskMain,
+      "BenchmarkTestTask",
+      STACK_SIZE,
+      NULL,
+      BENCHMARKTEST_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  HostSim_Start();
+  HostSim_RunUntilIdle();
+
+  if (!finished) {
+    printf("The benchmark task didn't finish\n");
+    return EXIT_FAILURE;
+  }
+  printf("%u kernels over budget\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
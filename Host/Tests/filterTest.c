@@ -0,0 +1,420 @@
+/*
+ * filterTest.c
+ *
+ * Checks of lib/filter on the host, where the DSP instructions are replaced
+ * by portable C:
+ *  - The portable SMLALD, QADD16 and QSUB16 against the instructions as the
+ *    Arm architecture defines them, bit for bit: lane pairing of the dual
+ *    multiply, the 64 bit accumulate, and saturation of each lane. Known
+ *    results, every combination of the edge values, and random words.
+ *  - Each filter against a floating point reference of the same filter,
+ *    with the coefficients as converted, over a step, a sine and noise.
+ *  - Biquad outputs saturate rather than wrap.
+ *
+ * Exits non-zero if any check fails.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "lib/filter/filter.h"
+#include "lib/filter/filterDsp.h"
+
+// ------------------- Private data -------------------
+#define FILTERTEST_PI             3.14159265358979
+
+#define FILTERTEST_RANDOM_WORDS   1000000U
+#define FILTERTEST_SAMPLES        4000U
+#define FILTERTEST_SAMPLE_HZ      1000.0f
+#define FILTERTEST_STAGES         2U
+#define FILTERTEST_CHANNELS       5U
+
+/* Lane values at and around the ends of the range, and zero */
+static const uint16_t edges[] = {
+  0x8000U, 0x8001U, 0xC000U, 0xFFFFU, 0x0000U, 0x0001U, 0x4000U, 0x7FFEU, 0x7FFFU
+};
+#define FILTERTEST_NUM_EDGES (sizeof(edges) / sizeof(edges[0]))
+
+static uint32_t failures;
+static uint32_t randomState = 0x12345678U;
+
+// ------------------- Private methods -------------------
+static void FilterTest_Check(bool pass, const char* what)
+{
+  if (!pass) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint32_t FilterTest_Random(void)
+{
+  // xorshift32
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+/*
+ * The instructions as the architecture reference pseudocode defines them,
+ * built from the lanes' integer values
+ */
+static int32_t FilterTest_Lane(uint32_t word, uint8_t lane)
+{
+  int32_t value = (int32_t)((word >> (16U * lane)) & 0xFFFFU);
+  return (value >= 0x8000) ? value - 0x10000 : value;
+}
+
+static int32_t FilterTest_SignedSat16(int32_t x)
+{
+  if (x > 32767) {
+    return 32767;
+  }
+  if (x < -32768) {
+    return -32768;
+  }
+  return x;
+}
+
+static uint32_t FilterTest_Word(int32_t lo, int32_t hi)
+{
+  return ((uint32_t)lo & 0xFFFFU) | (((uint32_t)hi & 0xFFFFU) << 16);
+}
+
+/* SMLALD: the low lanes multiplied together, and the high lanes, never crossed */
+static int64_t FilterTest_RefSmlald(uint32_t x, uint32_t y, int64_t acc)
+{
+  int64_t product1 = (int64_t)FilterTest_Lane(x, 0) * FilterTest_Lane(y, 0);
+  int64_t product2 = (int64_t)FilterTest_Lane(x, 1) * FilterTest_Lane(y, 1);
+  return (int64_t)((uint64_t)acc + (uint64_t)product1 + (uint64_t)product2);
+}
+
+static uint32_t FilterTest_RefQadd16(uint32_t x, uint32_t y)
+{
+  return FilterTest_Word(FilterTest_SignedSat16(FilterTest_Lane(x, 0) + FilterTest_Lane(y, 0)),
+                         FilterTest_SignedSat16(FilterTest_Lane(x, 1) + FilterTest_Lane(y, 1)));
+}
+
+static uint32_t FilterTest_RefQsub16(uint32_t x, uint32_t y)
+{
+  return FilterTest_Word(FilterTest_SignedSat16(FilterTest_Lane(x, 0) - FilterTest_Lane(y, 0)),
+                         FilterTest_SignedSat16(FilterTest_Lane(x, 1) - FilterTest_Lane(y, 1)));
+}
+
+static bool FilterTest_SameAsInstructions(uint32_t x, uint32_t y, int64_t acc)
+{
+  return (Filter_Smlald(x, y, acc) == FilterTest_RefSmlald(x, y, acc)) &&
+         (Filter_Qadd16(x, y) == FilterTest_RefQadd16(x, y)) &&
+         (Filter_Qsub16(x, y) == FilterTest_RefQsub16(x, y));
+}
+
+static void FilterTest_Instructions(void)
+{
+  // Lanes pair low with low and high with high: 2.5 + 3.7, not 2.7 + 3.5
+  FilterTest_Check(31 == Filter_Smlald(FILTER_PACK(2, 3), FILTER_PACK(5, 7), 0), "SMLALD pairs the lanes");
+  FilterTest_Check(131 == Filter_Smlald(FILTER_PACK(2, 3), FILTER_PACK(5, 7), 100), "SMLALD accumulates");
+  FilterTest_Check(-6 == Filter_Smlald(FILTER_PACK(-2, 3), FILTER_PACK(5, -7), 25), "SMLALD signed lanes");
+  // Both products at their largest overflow 32 bits, but not the accumulator
+  FilterTest_Check(0x80000000LL == Filter_Smlald(0x80008000U, 0x80008000U, 0), "SMLALD accumulates in 64 bits");
+  FilterTest_Check(-0x7FFF0000LL == Filter_Smlald(0x7FFF7FFFU, 0x80008000U, 0) + 0x10000LL - 0x10000LL,
+                   "SMLALD largest negative products");
+
+  FilterTest_Check(0x7FFF7FFFU == Filter_Qadd16(0x7FFF0001U, 0x00017FFFU), "QADD16 saturates both lanes high");
+  FilterTest_Check(0x80008000U == Filter_Qadd16(0x8000FFFFU, 0xFFFF8000U), "QADD16 saturates both lanes low");
+  FilterTest_Check(0x7FFF0002U == Filter_Qadd16(0x7FFF0001U, 0x00010001U), "QADD16 saturates one lane only");
+  FilterTest_Check(0x0000FFFFU == Filter_Qadd16(0x0000FFFEU, 0x00000001U), "QADD16 carries no lane into the other");
+  FilterTest_Check(0x8000FFFFU == Filter_Qsub16(0x80000000U, 0x00010001U), "QSUB16 saturates the high lane low");
+  FilterTest_Check(0x7FFF0000U == Filter_Qsub16(0x00000000U, 0x80010000U), "QSUB16 negating the lowest saturates");
+  FilterTest_Check(0x7FFF7FFFU == Filter_Qsub16(0x00000000U, 0x80008000U), "QSUB16 saturates both lanes high");
+  FilterTest_Check(0x0001FFFFU == Filter_Qsub16(0x00010000U, 0x00000001U), "QSUB16 borrows no lane from the other");
+
+  // Every combination of edge lanes, each with a few accumulators
+  static const int64_t accs[] = { 0, -1, 1, INT32_MIN, INT32_MAX, (int64_t)1 << 40, -((int64_t)1 << 40) };
+  bool same = true;
+  size_t xl, xh, yl, yh, a;
+  for (xl = 0; xl < FILTERTEST_NUM_EDGES; ++xl) {
+    for (xh = 0; xh < FILTERTEST_NUM_EDGES; ++xh) {
+      for (yl = 0; yl < FILTERTEST_NUM_EDGES; ++yl) {
+        for (yh = 0; yh < FILTERTEST_NUM_EDGES; ++yh) {
+          uint32_t x = FILTER_PACK(edges[xl], edges[xh]);
+          uint32_t y = FILTER_PACK(edges[yl], edges[yh]);
+          for (a = 0; a < sizeof(accs) / sizeof(accs[0]); ++a) {
+            same = same && FilterTest_SameAsInstructions(x, y, accs[a]);
+          }
+        }
+      }
+    }
+  }
+  FilterTest_Check(same, "every combination of edge lanes matches the instructions");
+
+  // Accumulators kept within +-2^62: the portable version is signed 64 bit
+  // arithmetic, so it must not overflow, where the instruction wraps
+  same = true;
+  uint32_t i;
+  for (i = 0; i < FILTERTEST_RANDOM_WORDS; ++i) {
+    uint32_t x = FilterTest_Random();
+    uint32_t y = FilterTest_Random();
+    int64_t acc = (int64_t)(((uint64_t)FilterTest_Random() << 32) | FilterTest_Random()) >> 2;
+    same = same && FilterTest_SameAsInstructions(x, y, acc);
+  }
+  FilterTest_Check(same, "random words match the instructions");
+}
+
+/*
+ * Test signal in -1..1: a step, a sine and some noise
+ */
+static double FilterTest_Signal(uint32_t n)
+{
+  double step = (n < FILTERTEST_SAMPLES / 4U) ? -0.4 : 0.3;
+  double sine = 0.25 * sin(2.0 * FILTERTEST_PI * 7.0 * n / FILTERTEST_SAMPLE_HZ);
+  double noise = 0.1 * ((double)(FilterTest_Random() & 0xFFFFU) / 65536.0 - 0.5);
+  return step + sine + noise;
+}
+
+/*
+ * Floating point biquad cascade, Direct Form I
+ */
+static double FilterTest_RefBiquad(const double* coeffs, double* state, double x)
+{
+  uint8_t stage;
+  for (stage = 0; stage < FILTERTEST_STAGES; ++stage) {
+    const double* b = &coeffs[stage * FILTER_BIQUAD_COEFFS];
+    double* s = &state[stage * FILTER_BIQUAD_STATE];
+    double y = b[0] * x + b[1] * s[0] + b[2] * s[1] + b[3] * s[2] + b[4] * s[3];
+    s[1] = s[0];
+    s[0] = x;
+    s[3] = s[2];
+    s[2] = y;
+    x = y;
+  }
+  return x;
+}
+
+static void FilterTest_BiquadQ15(float cutoffHz, double tolerance)
+{
+  char what[96];
+  float designed[FILTER_BIQUAD_COEFFS];
+  Filter_DesignLowPass(cutoffHz, FILTERTEST_SAMPLE_HZ, designed);
+
+  int16_t coeffs[FILTERTEST_STAGES * FILTER_BIQUAD_COEFFS_Q15] __attribute__((aligned(4)));
+  int16_t state[FILTERTEST_STAGES * FILTER_BIQUAD_STATE] = { 0 };
+  double refCoeffs[FILTERTEST_STAGES * FILTER_BIQUAD_COEFFS];
+  double refState[FILTERTEST_STAGES * FILTER_BIQUAD_STATE] = { 0 };
+
+  uint8_t stage, i;
+  for (stage = 0; stage < FILTERTEST_STAGES; ++stage) {
+    Filter_CoeffsToQ15(designed, 1U, &coeffs[stage * FILTER_BIQUAD_COEFFS_Q15]);
+    for (i = 0; i < FILTER_BIQUAD_COEFFS; ++i) {
+      refCoeffs[stage * FILTER_BIQUAD_COEFFS + i] = coeffs[stage * FILTER_BIQUAD_COEFFS_Q15 + i] / 16384.0;
+    }
+  }
+  Filter_BiquadQ15_T filter = { FILTERTEST_STAGES, 1U, coeffs, state };
+
+  double worst = 0.0;
+  uint32_t n;
+  for (n = 0; n < FILTERTEST_SAMPLES; ++n) {
+    int16_t x = (int16_t)lrint(FilterTest_Signal(n) * 32768.0);
+    int16_t y;
+    Filter_BiquadQ15(&filter, &x, &y, 1U);
+    double error = fabs(y / 32768.0 - FilterTest_RefBiquad(refCoeffs, refState, x / 32768.0));
+    worst = fmax(worst, error);
+  }
+  snprintf(what, sizeof(what), "biquad Q15 %.0fHz: worst error %.2g", (double)cutoffHz, worst);
+  FilterTest_Check(worst < tolerance, what);
+}
+
+static void FilterTest_BiquadQ31(float cutoffHz, double tolerance)
+{
+  char what[96];
+  float designed[FILTER_BIQUAD_COEFFS];
+  Filter_DesignLowPass(cutoffHz, FILTERTEST_SAMPLE_HZ, designed);
+
+  int32_t coeffs[FILTERTEST_STAGES * FILTER_BIQUAD_COEFFS];
+  int32_t state[FILTERTEST_STAGES * FILTER_BIQUAD_STATE] = { 0 };
+  double refCoeffs[FILTERTEST_STAGES * FILTER_BIQUAD_COEFFS];
+  double refState[FILTERTEST_STAGES * FILTER_BIQUAD_STATE] = { 0 };
+
+  uint8_t stage, i;
+  for (stage = 0; stage < FILTERTEST_STAGES; ++stage) {
+    Filter_CoeffsToQ31(designed, 1U, &coeffs[stage * FILTER_BIQUAD_COEFFS]);
+    for (i = 0; i < FILTER_BIQUAD_COEFFS; ++i) {
+      refCoeffs[stage * FILTER_BIQUAD_COEFFS + i] = coeffs[stage * FILTER_BIQUAD_COEFFS + i] / 1073741824.0;
+    }
+  }
+  Filter_BiquadQ31_T filter = { FILTERTEST_STAGES, 1U, coeffs, state };
+
+  double worst = 0.0;
+  uint32_t n;
+  for (n = 0; n < FILTERTEST_SAMPLES; ++n) {
+    int32_t x = (int32_t)lrint(FilterTest_Signal(n) * 2147483648.0);
+    int32_t y;
+    Filter_BiquadQ31(&filter, &x, &y, 1U);
+    double error = fabs(y / 2147483648.0 - FilterTest_RefBiquad(refCoeffs, refState, x / 2147483648.0));
+    worst = fmax(worst, error);
+  }
+  snprintf(what, sizeof(what), "biquad Q31 %.0fHz: worst error %.2g", (double)cutoffHz, worst);
+  FilterTest_Check(worst < tolerance, what);
+}
+
+static void FilterTest_BiquadSaturates(void)
+{
+  // A gain of 1.5 on a single stage, with no feedback
+  int16_t coeffs[FILTER_BIQUAD_COEFFS_Q15] __attribute__((aligned(4))) = { 24576, 0, 0, 0, 0, 0 };
+  int16_t state[FILTER_BIQUAD_STATE] = { 0 };
+  Filter_BiquadQ15_T filter = { 1U, 1U, coeffs, state };
+
+  int16_t in[4] = { INT16_MAX, INT16_MIN, 25000, -25000 };
+  int16_t out[4];
+  Filter_BiquadQ15(&filter, in, out, 4U);
+  FilterTest_Check(INT16_MAX == out[0] && INT16_MIN == out[1] && INT16_MAX == out[2] && INT16_MIN == out[3],
+                   "biquad Q15 saturates");
+
+  int32_t coeffs31[FILTER_BIQUAD_COEFFS] = { 0x60000000, 0, 0, 0, 0 };
+  int32_t state31[FILTER_BIQUAD_STATE] = { 0 };
+  Filter_BiquadQ31_T filter31 = { 1U, 1U, coeffs31, state31 };
+  int32_t in31[2] = { INT32_MAX, INT32_MIN };
+  int32_t out31[2];
+  Filter_BiquadQ31(&filter31, in31, out31, 2U);
+  FilterTest_Check(INT32_MAX == out31[0] && INT32_MIN == out31[1], "biquad Q31 saturates");
+}
+
+static void FilterTest_LowPass(void)
+{
+  int16_t alpha[FILTERTEST_CHANNELS];
+  int32_t state[FILTERTEST_CHANNELS];
+  double ref[FILTERTEST_CHANNELS];
+  static const float cutoffs[FILTERTEST_CHANNELS] = { 0.5f, 2.0f, 10.0f, 50.0f, 200.0f };
+  Filter_LowPassQ15_T filter = { FILTERTEST_CHANNELS, alpha, state };
+
+  int16_t start[FILTERTEST_CHANNELS];
+  uint8_t c;
+  for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+    alpha[c] = Filter_LowPassAlpha(cutoffs[c], 1.0f / FILTERTEST_SAMPLE_HZ);
+    start[c] = -8000;
+    ref[c] = start[c];
+  }
+  Filter_LowPassQ15_Reset(&filter, start);
+
+  double worst = 0.0;
+  uint32_t n;
+  for (n = 0; n < FILTERTEST_SAMPLES; ++n) {
+    int16_t in[FILTERTEST_CHANNELS];
+    int16_t out[FILTERTEST_CHANNELS];
+    for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+      in[c] = (int16_t)lrint(FilterTest_Signal(n) * 32768.0);
+    }
+    Filter_LowPassQ15_Batch(&filter, in, out);
+    for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+      ref[c] += (alpha[c] / 32768.0) * (in[c] - ref[c]);
+      worst = fmax(worst, fabs(out[c] - ref[c]));
+    }
+  }
+
+  // The state has 15 bits below the output, so only the output's truncation shows
+  char what[96];
+  snprintf(what, sizeof(what), "low pass: worst error %.2f LSB", worst);
+  FilterTest_Check(worst < 2.0, what);
+}
+
+static void FilterTest_RateLimit(void)
+{
+  static const int16_t maxStep[FILTERTEST_CHANNELS] = { 1, 10, 100, 1000, 32767 };
+  int16_t state[FILTERTEST_CHANNELS];
+  double ref[FILTERTEST_CHANNELS] = { 0 };
+  Filter_RateLimitQ15_T filter = { FILTERTEST_CHANNELS, maxStep, state };
+
+  int16_t start[FILTERTEST_CHANNELS] = { 0 };
+  Filter_RateLimitQ15_Reset(&filter, start);
+
+  bool exact = true;
+  uint32_t n;
+  for (n = 0; n < FILTERTEST_SAMPLES; ++n) {
+    int16_t in[FILTERTEST_CHANNELS];
+    int16_t out[FILTERTEST_CHANNELS];
+    uint8_t c;
+    for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+      // Full scale swings, so the largest steps would wrap 16 bits
+      in[c] = ((n / 50U) & 1U) ? INT16_MAX : INT16_MIN;
+    }
+    Filter_RateLimitQ15_Batch(&filter, in, out);
+    for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+      ref[c] += fmax(-maxStep[c], fmin(maxStep[c], in[c] - ref[c]));
+      exact = exact && (out[c] == ref[c]);
+    }
+  }
+  FilterTest_Check(exact, "rate limit matches the reference exactly");
+}
+
+static void FilterTest_MovingAverage(uint8_t windowShift)
+{
+  uint32_t window = 1UL << windowShift;
+  uint32_t history[FILTER_MOVAVG_PAIRS(FILTERTEST_CHANNELS) << 4];
+  uint32_t sums[FILTER_MOVAVG_PAIRS(FILTERTEST_CHANNELS)];
+  Filter_MovingAverageQ15_T filter = { FILTERTEST_CHANNELS, windowShift, 0, history, sums };
+
+  static double samples[FILTERTEST_SAMPLES][FILTERTEST_CHANNELS];
+  int16_t start[FILTERTEST_CHANNELS];
+  uint8_t c;
+  for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+    start[c] = (int16_t)(c * 3000);
+  }
+  Filter_MovingAverageQ15_Reset(&filter, start);
+
+  double worst = 0.0;
+  uint32_t n, k;
+  for (n = 0; n < FILTERTEST_SAMPLES; ++n) {
+    int16_t in[FILTERTEST_CHANNELS];
+    int16_t out[FILTERTEST_CHANNELS];
+    for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+      // 12 bit ADC readings in Q15, channels at different levels
+      double value = (FilterTest_Signal(n) + (c - 2.0) * 0.2) * 0.5;
+      in[c] = (int16_t)(lrint(value * 4096.0) * 8);
+      samples[n][c] = in[c];
+    }
+    Filter_MovingAverageQ15_Batch(&filter, in, out);
+
+    for (c = 0; c < FILTERTEST_CHANNELS; ++c) {
+      double sum = 0.0;
+      for (k = 0; k < window; ++k) {
+        sum += (n >= k) ? samples[n - k][c] : start[c];
+      }
+      worst = fmax(worst, fabs(out[c] - sum / window));
+    }
+  }
+
+  // Samples are kept divided by the window, so a window of 8 or less loses
+  // nothing from a 12 bit reading
+  char what[96];
+  snprintf(what, sizeof(what), "moving average of %lu: worst error %.2f LSB", (unsigned long)window, worst);
+  FilterTest_Check((window <= 8U) ? (0.0 == worst) : (worst < (double)window), what);
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  FilterTest_Instructions();
+
+  // A fiftieth of the sample rate and above for Q15, as filter.h advises
+  FilterTest_BiquadQ15(50.0f, 2.0e-3);
+  FilterTest_BiquadQ15(200.0f, 1.0e-3);
+  // Rounding at a pole this close to 1 is amplified, to a few parts per million
+  FilterTest_BiquadQ31(2.0f, 1.0e-5);
+  FilterTest_BiquadQ31(50.0f, 1.0e-6);
+  FilterTest_BiquadSaturates();
+
+  FilterTest_LowPass();
+  FilterTest_RateLimit();
+  FilterTest_MovingAverage(2U);
+  FilterTest_MovingAverage(3U);
+  FilterTest_MovingAverage(4U);
+
+  printf("%u checks failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,375 @@
+/*
+ * isoTpTest.c
+ *
+ * Loops ISO-TP back between two buses on the simulation and measures its
+ * throughput against the bus line rate.
+ *
+ * Channels on bus 1 and bus 2 are wired to one modelled CAN bus at
+ * ISOTPTEST_BITRATE. Each frame holds its sender's TX mailbox for the time
+ * it takes on the wire, frames wait for the wire, and the lowest ID wins
+ * arbitration. As a frame ends, the sender's TX complete interrupt and the
+ * receiver's RX interrupt run. The ISO-TP task takes no simulated time, so
+ * the figures are the protocol's and the bus's, not the target's CPU.
+ *
+ * Cases, with 4095 byte messages:
+ *  - one way, block size 0 and STmin 0: at least ISOTPTEST_MIN_LINE_RATE
+ *    of the bus time is frames,
+ *  - both ways at once over the same pair, which share the bus,
+ *  - one way, block size 8 and STmin 1ms: no consecutive frames closer
+ *    than STmin, and a frame each tick.
+ * Every message must arrive intact, with no ISO-TP errors.
+ *
+ * Exits non-zero if a case fails.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hostSim.h"
+#include "hostCan.h"
+
+#include "lib/logging/logging.h"
+#include "comm/isotp/isotp.h"
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+// A classic frame of 8 bytes with a standard ID, and the interframe space,
+// without stuff bits
+#define ISOTPTEST_BITRATE         500000U
+#define ISOTPTEST_FRAME_BITS      111U
+#define ISOTPTEST_FRAME_NS        (((uint64_t)ISOTPTEST_FRAME_BITS * 1000000000ULL) / ISOTPTEST_BITRATE)
+
+#define ISOTPTEST_MIN_LINE_RATE   95U     /* % of the bus time */
+#define ISOTPTEST_LIMIT_NS        ((uint64_t) 5000000000ULL)
+
+#define ISOTPTEST_MESSAGE_LEN     ISOTP_MAX_MESSAGE_LEN
+#define ISOTPTEST_CF_DATA         7U
+#define ISOTPTEST_FF_DATA         6U
+#define ISOTPTEST_PCI_CONSECUTIVE 0x20U
+#define ISOTPTEST_PCI_FLOW        0x30U
+
+/*
+ * Channel pairs. The pair's ends request the same flow control.
+ */
+typedef enum
+{
+  ISOTPTEST_PAIR_FAST,      /* Block size 0, STmin 0 */
+  ISOTPTEST_PAIR_PACED,     /* Block size 8, STmin 1ms */
+  ISOTPTEST_NUM_PAIRS
+} IsoTpTest_Pair_T;
+
+typedef struct
+{
+  uint32_t id1;             /* Sent on bus 1 */
+  uint32_t id2;             /* Sent on bus 2 */
+  uint8_t blockSize;
+  uint8_t stMin;
+  uint32_t stMinNs;
+} IsoTpTest_PairConfig_T;
+
+static const IsoTpTest_PairConfig_T pairs[ISOTPTEST_NUM_PAIRS] = {
+  [ISOTPTEST_PAIR_FAST]  = { 0x7E0U, 0x7E8U, 0U, 0x00U, 0U },
+  [ISOTPTEST_PAIR_PACED] = { 0x7E1U, 0x7E9U, 8U, 0x01U, 1000000U },
+};
+
+// Channel of each pair's end, by bus
+static IsoTp_Channel_T channels[ISOTPTEST_NUM_PAIRS][2];
+
+// Messages, from bus 1 and from bus 2
+static uint8_t messages[2][ISOTPTEST_MESSAGE_LEN];
+
+typedef struct
+{
+  uint32_t id;
+  uint8_t data[8];
+} IsoTpTest_Frame_T;
+
+// Frames in each bus's TX mailboxes, oldest first
+static IsoTpTest_Frame_T mailboxes[2][HOSTCAN_TX_MAILBOXES];
+static uint8_t numQueued[2];
+
+// The frame on the wire
+static bool wireBusy;
+static uint8_t wireBus;
+static IsoTpTest_Frame_T wireFrame;
+static uint64_t wireEndNs;
+static uint64_t wireTimeNs;
+
+// STmin of the block in progress from each bus, 0 outside a block
+static uint64_t lastCfNs[2];
+static uint32_t stMinViolations;
+static uint32_t stMinRequiredNs[2];
+
+// Receptions
+static uint32_t received[2];
+static uint64_t receivedNs[2];
+static uint32_t corrupted;
+static uint32_t txFailures;
+
+static uint32_t failures;
+
+// ------------------- Private methods -------------------
+static uint8_t IsoTpTest_Pattern(uint8_t fromBus, uint16_t i)
+{
+  return (1U == fromBus) ? (uint8_t)(i * 7U + 1U) : (uint8_t)(i * 13U + 5U);
+}
+
+static void IsoTpTest_Received(IsoTp_Channel_T channel, uint8_t* data, uint16_t len)
+{
+  // Which message: the channel's receiver is the other bus
+  uint8_t fromBus = 0;
+  size_t p;
+  for (p = 0; p < ISOTPTEST_NUM_PAIRS; ++p) {
+    if (channel == channels[p][1]) {
+      fromBus = 1U;
+    } else if (channel == channels[p][0]) {
+      fromBus = 2U;
+    }
+  }
+
+  bool intact = (ISOTPTEST_MESSAGE_LEN == len) && (0U != fromBus);
+  uint16_t i;
+  for (i = 0; intact && (i < len); ++i) {
+    intact = (IsoTpTest_Pattern(fromBus, i) == data[i]);
+  }
+  if (!intact) {
+    corrupted++;
+  } else {
+    received[fromBus - 1U]++;
+    receivedNs[fromBus - 1U] = HostSim_GetTimeNs();
+  }
+  IsoTp_FreeBuffer(data);
+}
+
+static void IsoTpTest_Sent(IsoTp_Channel_T channel, IsoTp_Status_T status)
+{
+  (void)channel;
+  if (ISOTP_STATUS_OK != status) {
+    txFailures++;
+  }
+}
+
+static void IsoTpTest_Tx(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc)
+{
+  if ((bus < 1U) || (bus > 2U) || (numQueued[bus - 1U] >= HOSTCAN_TX_MAILBOXES)) {
+    return;
+  }
+
+  uint8_t b = bus - 1U;
+  uint64_t now = HostSim_GetTimeNs();
+  if (ISOTPTEST_PCI_CONSECUTIVE == (data[0] & 0xF0U)) {
+    if ((0U != lastCfNs[b]) && (now - lastCfNs[b] < stMinRequiredNs[b])) {
+      stMinViolations++;
+    }
+    lastCfNs[b] = now;
+  }
+
+  IsoTpTest_Frame_T* frame = &mailboxes[b][numQueued[b]++];
+  frame->id = id;
+  memset(frame->data, 0, sizeof(frame->data));
+  memcpy(frame->data, data, dlc);
+}
+
+/**
+ * @brief Puts the winning frame on the wire, if it is free
+ */
+static void IsoTpTest_Arbitrate(void)
+{
+  if (wireBusy) {
+    return;
+  }
+  int8_t winner = -1;
+  uint8_t b;
+  for (b = 0; b < 2U; ++b) {
+    if ((numQueued[b] > 0U) && ((winner < 0) || (mailboxes[b][0].id < mailboxes[winner][0].id))) {
+      winner = (int8_t)b;
+    }
+  }
+  if (winner < 0) {
+    return;
+  }
+
+  wireBusy = true;
+  wireBus = (uint8_t)winner + 1U;
+  wireFrame = mailboxes[winner][0];
+  numQueued[winner]--;
+  memmove(&mailboxes[winner][0], &mailboxes[winner][1], numQueued[winner] * sizeof(IsoTpTest_Frame_T));
+  wireEndNs = HostSim_GetTimeNs() + ISOTPTEST_FRAME_NS;
+}
+
+/**
+ * @brief The frame on the wire ends: the sender's TX complete and the
+ * receiver's RX interrupts
+ */
+static void IsoTpTest_Deliver(void)
+{
+  uint8_t toBus = (1U == wireBus) ? 2U : 1U;
+  wireBusy = false;
+  wireTimeNs += ISOTPTEST_FRAME_NS;
+
+  // A flow control starts the receiver's next block
+  if (ISOTPTEST_PCI_FLOW == (wireFrame.data[0] & 0xF0U)) {
+    lastCfNs[toBus - 1U] = 0;
+  }
+
+  HostSim_EnterIsr();
+  HostCan_TxComplete(wireBus);
+  IsoTp_TxCompleteCallback(HostCan_GetHandle(wireBus));
+  (void)HostCan_Receive(toBus, wireFrame.id, wireFrame.data, 8);
+  HostSim_ExitIsr();
+  HostSim_RunUntilIdle();
+}
+
+/**
+ * @brief Runs the bus until the messages have arrived
+ * @param expected Messages expected from bus 1 and bus 2
+ */
+static bool IsoTpTest_Run(const uint32_t expected[2])
+{
+  uint64_t limitNs = HostSim_GetTimeNs() + ISOTPTEST_LIMIT_NS;
+  while ((received[0] < expected[0]) || (received[1] < expected[1])) {
+    uint64_t now = HostSim_GetTimeNs();
+    if (now >= limitNs) {
+      return false;
+    }
+
+    IsoTpTest_Arbitrate();
+    uint64_t nextTickNs = (now / HOSTSIM_TICK_NS + 1U) * HOSTSIM_TICK_NS;
+    if (wireBusy && (wireEndNs <= nextTickNs)) {
+      HostSim_AdvanceTo(wireEndNs);
+      IsoTpTest_Deliver();
+    } else {
+      HostSim_AdvanceTo(nextTickNs);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Sends a message each way asked for, over a pair, and reports the
+ * throughput
+ * @param minLineRate % of the bus time that must be frames, 0 for no check
+ * @param maxNs Longest the transfer may take, 0 for no check
+ */
+static void IsoTpTest_Case(const char* name, IsoTpTest_Pair_T pair, bool from1, bool from2,
+    uint32_t minLineRate, uint64_t maxNs)
+{
+  uint32_t expected[2] = { received[0] + (from1 ? 1U : 0U), received[1] + (from2 ? 1U : 0U) };
+  uint32_t corruptedBefore = corrupted;
+  uint32_t txFailuresBefore = txFailures;
+  uint32_t violationsBefore = stMinViolations;
+  IsoTp_Stats_T before;
+  IsoTp_GetStats(&before);
+
+  stMinRequiredNs[0] = pairs[pair].stMinNs;
+  stMinRequiredNs[1] = pairs[pair].stMinNs;
+  lastCfNs[0] = 0;
+  lastCfNs[1] = 0;
+  wireTimeNs = 0;
+
+  uint64_t startNs = HostSim_GetTimeNs();
+  bool started = (!from1 || (ISOTP_STATUS_OK == IsoTp_Send(channels[pair][0], messages[0], ISOTPTEST_MESSAGE_LEN))) &&
+                 (!from2 || (ISOTP_STATUS_OK == IsoTp_Send(channels[pair][1], messages[1], ISOTPTEST_MESSAGE_LEN)));
+  bool arrived = started && IsoTpTest_Run(expected);
+
+  IsoTp_Stats_T after;
+  IsoTp_GetStats(&after);
+  bool clean = (corrupted == corruptedBefore) && (txFailures == txFailuresBefore) &&
+               (after.txErrors == before.txErrors) && (after.rxErrors == before.rxErrors) &&
+               (stMinViolations == violationsBefore);
+
+  if (!arrived) {
+    printf("%-16s did not complete\n", name);
+    failures++;
+    return;
+  }
+
+  uint64_t endNs = startNs;
+  if (from1 && (receivedNs[0] > endNs)) {
+    endNs = receivedNs[0];
+  }
+  if (from2 && (receivedNs[1] > endNs)) {
+    endNs = receivedNs[1];
+  }
+  uint64_t elapsedNs = endNs - startNs;
+  uint32_t bytes = ISOTPTEST_MESSAGE_LEN * ((from1 ? 1U : 0U) + (from2 ? 1U : 0U));
+  double kBps = (double)bytes / ((double)elapsedNs * 1e-9) / 1000.0;
+  uint32_t lineRate = (uint32_t)((wireTimeNs * 100U) / elapsedNs);
+
+  bool passed = clean && (lineRate >= minLineRate) && ((0U == maxNs) || (elapsedNs <= maxNs));
+  printf("%-16s %6u %9.1f %7.1f %6u%% %s\n", name, bytes, (double)elapsedNs * 1e-6, kBps, lineRate,
+      passed ? "PASS" : "FAIL");
+  if (!clean) {
+    printf("  corrupt %u, send failures %u, ISO-TP errors %u, STmin violations %u\n",
+        corrupted - corruptedBefore, txFailures - txFailuresBefore,
+        (after.txErrors - before.txErrors) + (after.rxErrors - before.rxErrors),
+        stMinViolations - violationsBefore);
+  }
+  if (!passed) {
+    failures++;
+  }
+}
+
+static bool IsoTpTest_Open(void)
+{
+  size_t p;
+  for (p = 0; p < ISOTPTEST_NUM_PAIRS; ++p) {
+    IsoTp_ChannelConfig_T config = {
+      .hcan = &hcan1,
+      .txId = pairs[p].id1,
+      .rxId = pairs[p].id2,
+      .blockSize = pairs[p].blockSize,
+      .stMin = pairs[p].stMin,
+      .rxCallback = IsoTpTest_Received,
+      .txCallback = IsoTpTest_Sent,
+    };
+    if (ISOTP_STATUS_OK != IsoTp_Open(&config, &channels[p][0])) {
+      return false;
+    }
+    config.hcan = &hcan2;
+    config.txId = pairs[p].id2;
+    config.rxId = pairs[p].id1;
+    if (ISOTP_STATUS_OK != IsoTp_Open(&config, &channels[p][1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  Log_Init(&firmwareLog);
+  uint16_t i;
+  for (i = 0; i < ISOTPTEST_MESSAGE_LEN; ++i) {
+    messages[0][i] = IsoTpTest_Pattern(1U, i);
+    messages[1][i] = IsoTpTest_Pattern(2U, i);
+  }
+
+  HostCan_HoldTxMailboxes(1, true);
+  HostCan_HoldTxMailboxes(2, true);
+  HostCan_SetTxHook(IsoTpTest_Tx);
+  if ((ISOTP_STATUS_OK != IsoTp_Init(&firmwareLog)) || !IsoTpTest_Open()) {
+    printf("ISO-TP failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+  HostSim_Start();
+
+  // Consecutive frames of a message, each a tick apart when paced
+  uint32_t consecutive = (ISOTPTEST_MESSAGE_LEN - ISOTPTEST_FF_DATA + ISOTPTEST_CF_DATA - 1U) / ISOTPTEST_CF_DATA;
+  uint64_t pacedNs = (uint64_t)(consecutive + 2U) * HOSTSIM_TICK_NS;
+
+  printf("%d kbit/s, %llu us a frame\n", ISOTPTEST_BITRATE / 1000U, (unsigned long long)(ISOTPTEST_FRAME_NS / 1000U));
+  printf("%-16s %6s %9s %7s %7s\n", "case", "bytes", "ms", "kB/s", "bus");
+  IsoTpTest_Case("one way", ISOTPTEST_PAIR_FAST, true, false, ISOTPTEST_MIN_LINE_RATE, 0);
+  IsoTpTest_Case("both ways", ISOTPTEST_PAIR_FAST, true, true, ISOTPTEST_MIN_LINE_RATE, 0);
+  IsoTpTest_Case("BS 8, STmin 1ms", ISOTPTEST_PAIR_PACED, true, false, 0, pacedNs);
+
+  printf("%u cases failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
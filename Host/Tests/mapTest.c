@@ -0,0 +1,138 @@
+/*
+ * mapTest.c
+ *
+ * Checks calGen's output for Tools/calGen/samples/maps.cal, which the build
+ * generates and compiles in:
+ *  - each map is declared as the lookup that fits its axes,
+ *  - its sizes are the file's,
+ *  - lookups at breakpoints, between them and beyond the ends give the
+ *    file's values, interpolated and clamped as lib/map does.
+ *
+ * Exits non-zero if any check fails.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "calMaps.h"
+
+// ------------------- Private data -------------------
+#define MAPTEST_TOLERANCE 1.0e-5f
+
+// The qualifiers are dropped from the map's type
+#define MAPTEST_IS(map_, type_) _Generic((map_), type_: true, default: false)
+
+static uint32_t failures;
+
+// ------------------- Private methods -------------------
+static void MapTest_Check(bool condition, const char* what)
+{
+  if (!condition) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void MapTest_CheckValue(float value, float expected, const char* what)
+{
+  if (fabsf(value - expected) > MAPTEST_TOLERANCE * fmaxf(1.0f, fabsf(expected))) {
+    printf("  FAIL: %s: %g, expected %g\n", what, value, expected);
+    failures++;
+  }
+}
+
+static void MapTest_Types(void)
+{
+  printf("Map types\n");
+  MapTest_Check(MAPTEST_IS(pedalTorque, Map_Uniform1D_T), "evenly spaced 1D is Map_Uniform1D_T");
+  MapTest_Check(MAPTEST_IS(powerLimit, Map_Table1D_T), "unevenly spaced 1D is Map_Table1D_T");
+  MapTest_Check(MAPTEST_IS(thermalDerate, Map_Uniform2D_T), "evenly spaced 2D is Map_Uniform2D_T");
+  MapTest_Check(MAPTEST_IS(torqueLimit, Map_Table2D_T), "unevenly spaced 2D is Map_Table2D_T");
+  MapTest_Check(MAPTEST_IS(thermistor, Map_Uniform1D_Q_T), "q map is Map_Uniform1D_Q_T");
+
+  MapTest_Check(11U == pedalTorque.n, "pedalTorque has 11 points");
+  MapTest_Check(6U == powerLimit.n, "powerLimit has 6 points");
+  MapTest_Check((4U == thermalDerate.nx) && (3U == thermalDerate.ny), "thermalDerate is 4 by 3");
+  MapTest_Check((4U == torqueLimit.nx) && (3U == torqueLimit.ny), "torqueLimit is 4 by 3");
+  MapTest_Check((33U == thermistor.n) && (7U == thermistor.shift) && (0 == thermistor.x0),
+      "thermistor has 33 points every 128 counts");
+}
+
+static void MapTest_Uniform1D(void)
+{
+  printf("pedalTorque\n");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, 0.0f), 0.0f, "at 0");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, 0.4f), 0.25f, "at 0.4");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, 1.0f), 1.0f, "at 1");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, 0.25f), 0.125f, "between 0.2 and 0.3");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, 0.95f), 0.935f, "between 0.9 and 1");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, -1.0f), 0.0f, "below the axis");
+  MapTest_CheckValue(Map_Uniform1D(&pedalTorque, 2.0f), 1.0f, "above the axis");
+}
+
+static void MapTest_Table1D(void)
+{
+  printf("powerLimit\n");
+  Map_Cache_T cache = { 0 };
+  MapTest_CheckValue(Map_Table1D(&powerLimit, &cache, 0.0f), 80.0f, "at 0");
+  MapTest_CheckValue(Map_Table1D(&powerLimit, &cache, 1000.0f), 80.0f, "between 0 and 2000");
+  MapTest_CheckValue(Map_Table1D(&powerLimit, &cache, 4500.0f), 70.0f, "between 4000 and 5000");
+  MapTest_CheckValue(Map_Table1D(&powerLimit, &cache, 5250.0f), 45.0f, "between 5000 and 5500");
+  MapTest_CheckValue(Map_Table1D(&powerLimit, &cache, 5500.0f), 30.0f, "at 5500");
+  MapTest_CheckValue(Map_Table1D(&powerLimit, &cache, 7000.0f), 0.0f, "above the axis");
+}
+
+static void MapTest_Uniform2D(void)
+{
+  printf("thermalDerate\n");
+  MapTest_CheckValue(Map_Uniform2D(&thermalDerate, 60.0f, 40.0f), 1.0f, "at (60, 40)");
+  MapTest_CheckValue(Map_Uniform2D(&thermalDerate, 60.0f, 60.0f), 0.8f, "at (60, 60)");
+  MapTest_CheckValue(Map_Uniform2D(&thermalDerate, 100.0f, 50.0f), 0.7f, "at (100, 50)");
+  MapTest_CheckValue(Map_Uniform2D(&thermalDerate, 90.0f, 45.0f), 0.85f, "at (90, 45)");
+  MapTest_CheckValue(Map_Uniform2D(&thermalDerate, 110.0f, 55.0f), 0.3f, "at (110, 55)");
+  MapTest_CheckValue(Map_Uniform2D(&thermalDerate, 150.0f, 0.0f), 0.0f, "beyond both axes");
+}
+
+static void MapTest_Table2D(void)
+{
+  printf("torqueLimit\n");
+  Map_Cache_T cacheX = { 0 };
+  Map_Cache_T cacheY = { 0 };
+  MapTest_CheckValue(Map_Table2D(&torqueLimit, &cacheX, &cacheY, 0.0f, 250.0f), 140.0f, "at (0, 250)");
+  MapTest_CheckValue(Map_Table2D(&torqueLimit, &cacheX, &cacheY, 6000.0f, 400.0f), 70.0f, "at (6000, 400)");
+  MapTest_CheckValue(Map_Table2D(&torqueLimit, &cacheX, &cacheY, 4500.0f, 300.0f), 90.0f, "at (4500, 300)");
+  MapTest_CheckValue(Map_Table2D(&torqueLimit, &cacheX, &cacheY, 3750.0f, 350.0f), 117.5f, "at (3750, 350)");
+  MapTest_CheckValue(Map_Table2D(&torqueLimit, &cacheX, &cacheY, 5250.0f, 275.0f), 62.5f, "at (5250, 275)");
+  MapTest_CheckValue(Map_Table2D(&torqueLimit, &cacheX, &cacheY, 9000.0f, 500.0f), 70.0f, "beyond both axes");
+}
+
+static void MapTest_Uniform1DQ(void)
+{
+  printf("thermistor\n");
+  MapTest_Check(1500 == Map_Uniform1D_Q(&thermistor, 0), "at 0");
+  MapTest_Check(1166 == Map_Uniform1D_Q(&thermistor, 256), "at 256");
+  MapTest_Check(-400 == Map_Uniform1D_Q(&thermistor, 4096), "at 4096");
+  // 1166 + floor((981 - 1166) * 64 / 128)
+  MapTest_Check(1073 == Map_Uniform1D_Q(&thermistor, 320), "between 256 and 384");
+  MapTest_Check(1500 == Map_Uniform1D_Q(&thermistor, -100), "below the axis");
+  MapTest_Check(-400 == Map_Uniform1D_Q(&thermistor, 5000), "above the axis");
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  MapTest_Types();
+  MapTest_Uniform1D();
+  MapTest_Table1D();
+  MapTest_Uniform2D();
+  MapTest_Table2D();
+  MapTest_Uniform1DQ();
+
+  printf("%u checks failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+/*
+ * pedalsTest.c
+ *
+ * Replays pedal traces through the pedal processing, on the simulation with
+ * the readings reaching the pedals process through the ADC and the analog
+ * module, as on the car, with its calibration.
+ *
+ *   pedalsTest trace.csv...
+ *
+ * A trace is CSV, one row per step of the drive:
+ *   hold_ms,apps1,apps2,brake,torque,faults
+ * The readings, in ADC counts, are held for hold_ms. The torque request
+ * (Nm) and the PEDALS_FAULT_* flags are then checked against the row's.
+ * Lines starting with # are comments. Tests/traces has the traces ctest
+ * runs.
+ *
+ * Exits non-zero if any row's outputs differ.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "hostSim.h"
+
+#include "lib/logging/logging.h"
+#include "lib/paramStore/paramStore.h"
+#include "lib/signalDb/signalDb.h"
+#include "io/adc/adc.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "time/deferred/deferred.h"
+#include "device/analog/analog.h"
+#include "device/inverter/inverter.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleInterface/analogMapping/analogMapping.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+extern CAN_HandleTypeDef hcan1;
+extern uint16_t hostVrefintCal;
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+#define PEDALSTEST_TORQUE_TOLERANCE   0.5f    /* Nm */
+#define PEDALSTEST_LINE_LEN           256U
+
+// Readings of the row being replayed
+static uint16_t apps1;
+static uint16_t apps2;
+static uint16_t brake;
+
+static uint32_t failures;
+static uint64_t tickNs;
+
+// ------------------- Private methods -------------------
+static void PedalsTest_TickHook(uint64_t timeNs)
+{
+  (void)timeNs;
+  HostAdc_Set(MAPPING_ADC_APPS1, apps1);
+  HostAdc_Set(MAPPING_ADC_APPS2, apps2);
+  HostAdc_Set(MAPPING_ADC_BRAKE, brake);
+}
+
+/**
+ * @brief The firmware modules the pedals need, in the order initialize.c
+ * starts them
+ */
+static bool PedalsTest_InitFirmware(void)
+{
+  Log_Init(&firmwareLog);
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  uint8_t numAnalogChannels;
+  const Analog_ChannelConfig_T* analogChannels = Mapping_GetAnalogChannels(&numAnalogChannels);
+  uint8_t numBiases;
+  const Analog_BiasConfig_T* biases = Mapping_GetAnalogBiases(&numBiases);
+
+  return PARAMSTORE_STATUS_OK == ParamStore_Init(&firmwareLog, Mapping_GetParamDefaults(), MAPPING_PARAM_NUM_PARAMS) &&
+         ADC_STATUS_OK == ADC_Init(&firmwareLog, MAPPING_ADC_NUM_CHANNELS, 16) &&
+         DEFERRED_STATUS_OK == Deferred_Init(&firmwareLog) &&
+         SIGNALDB_STATUS_OK == SignalDb_Init(&firmwareLog, signalGroups, numSignalGroups) &&
+         CANMONITOR_STATUS_OK == CanMonitor_Init(&firmwareLog) &&
+         CANRECORDER_STATUS_OK == CanRecorder_Init(&firmwareLog) &&
+         INVERTER_STATUS_OK == Inverter_Init(&firmwareLog, &hcan1) &&
+         ANALOG_STATUS_OK == Analog_Init(&firmwareLog, analogChannels, numAnalogChannels, MAPPING_ADC1_VREFINT,
+                                         biases, numBiases) &&
+         PEDALS_STATUS_OK == Pedals_Init(&firmwareLog);
+}
+
+/**
+ * @brief Replays a trace
+ * @return false if it can't be read
+ */
+static bool PedalsTest_Replay(const char* path)
+{
+  FILE* trace = fopen(path, "r");
+  if (NULL == trace) {
+    printf("Can't open %s\n", path);
+    return false;
+  }
+  printf("%s\n", path);
+
+  char line[PEDALSTEST_LINE_LEN];
+  uint32_t lineNumber = 0;
+  uint32_t rows = 0;
+  float worstTorque = 0.0f;
+  bool header = true;
+  while (NULL != fgets(line, sizeof(line), trace)) {
+    lineNumber++;
+    if (('#' == line[0]) || ('\n' == line[0]) || ('\r' == line[0])) {
+      continue;
+    }
+    if (header) {
+      header = false;
+      continue;
+    }
+
+    unsigned holdMs;
+    unsigned raw[3];
+    float torque;
+    unsigned faults;
+    if (6 != sscanf(line, "%u,%u,%u,%u,%f,%x", &holdMs, &raw[0], &raw[1], &raw[2], &torque, &faults)) {
+      printf("  %s:%u: bad row\n", path, lineNumber);
+      fclose(trace);
+      return false;
+    }
+    apps1 = (uint16_t)raw[0];
+    apps2 = (uint16_t)raw[1];
+    brake = (uint16_t)raw[2];
+
+    unsigned t;
+    for (t = 0; t < holdMs; ++t) {
+      tickNs += HOSTSIM_TICK_NS;
+      HostSim_AdvanceTo(tickNs);
+    }
+
+    Pedals_Output_T output;
+    Pedals_GetOutput(&output);
+    float torqueError = fabsf(output.torqueRequest - torque);
+    worstTorque = fmaxf(worstTorque, torqueError);
+    if ((torqueError > PEDALSTEST_TORQUE_TOLERANCE) || (output.faults != faults)) {
+      printf("  FAIL: line %u: torque %.2f, faults 0x%02X, expected %.2f, 0x%02X\n", lineNumber,
+          output.torqueRequest, output.faults, torque, faults);
+      failures++;
+    }
+    rows++;
+  }
+  fclose(trace);
+
+  printf("  %u rows, worst torque error %.2f Nm\n", rows, worstTorque);
+  return true;
+}
+
+// ------------------- Public methods -------------------
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s trace.csv...\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  HostSim_SetTickHook(PedalsTest_TickHook);
+  HostAdc_Set(MAPPING_ADC1_VREFINT, hostVrefintCal);
+  if (!PedalsTest_InitFirmware()) {
+    printf("Firmware failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+  HostSim_Start();
+
+  int arg;
+  for (arg = 1; arg < argc; ++arg) {
+    if (!PedalsTest_Replay(argv[arg])) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  printf("%u rows failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
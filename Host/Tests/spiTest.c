@@ -0,0 +1,363 @@
+/*
+ * spiTest.c
+ *
+ * Checks of the SPI transaction queue, on the simulation with a device that
+ * answers each byte with its complement:
+ *  - A transfer runs with its chip select asserted, the data is exchanged,
+ *    and the owner is called back and notified.
+ *  - Chained links keep the chip select asserted for the same device, and
+ *    move it for a different one.
+ *  - Chains queued on a busy bus start in order as each finishes.
+ *  - A failed transfer fails the rest of its chain and the next chain still
+ *    starts. So does a transfer that fails to start.
+ *  - Submit rejects empty transactions, ones already queued, and a full queue.
+ *
+ * Exits non-zero if any check fails.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hostSim.h"
+#include "hostSpi.h"
+
+#include "lib/logging/logging.h"
+#include "comm/spi/spi.h"
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+#define SPITEST_CS_PORT           GPIOE
+#define SPITEST_CS_A              GPIO_PIN_3
+#define SPITEST_CS_B              GPIO_PIN_4
+#define SPITEST_LENGTH            4U
+
+typedef struct
+{
+  SPI_Transaction_T transaction;
+  uint8_t tx[SPITEST_LENGTH];
+  uint8_t rx[SPITEST_LENGTH];
+} SpiTest_Link_T;
+
+#define SPITEST_NUM_LINKS         (SPI_QUEUE_LENGTH + 2U)
+static SpiTest_Link_T links[SPITEST_NUM_LINKS];
+
+// The owner task submits what it is given and counts its notifications
+#define STACK_SIZE 2000
+#define SPITEST_PRIORITY 2
+static StaticTask_t taskBuffer;
+static StackType_t taskStack[STACK_SIZE];
+static TaskHandle_t ownerTaskHandle;
+
+static SPI_Transaction_T* volatile toSubmit;
+static volatile SPI_Status_T submitStatus;
+static volatile uint32_t notifications;
+
+static uint32_t callbacks;
+static bool csAssertedAtDevice;
+static bool csAssertedAtCallback;   /* Own chip select, in the link's callback */
+
+static uint32_t failures;
+
+// ------------------- Private methods -------------------
+static void SpiTest_Check(bool pass, const char* what)
+{
+  if (!pass) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static bool SpiTest_Asserted(uint16_t pin)
+{
+  // Active low, and released when first written
+  return !HostGpio_IsSet(SPITEST_CS_PORT, pin);
+}
+
+static void SpiTest_Device(SPI_HandleTypeDef* hspi, const uint8_t* tx, uint8_t* rx, uint16_t length)
+{
+  (void)hspi;
+
+  csAssertedAtDevice = SpiTest_Asserted(SPITEST_CS_A) != SpiTest_Asserted(SPITEST_CS_B);
+
+  uint16_t i;
+  for (i = 0; i < length; ++i) {
+    rx[i] = (uint8_t)~tx[i];
+  }
+}
+
+static void SpiTest_Callback(SPI_Transaction_T* transaction)
+{
+  csAssertedAtCallback = SpiTest_Asserted(transaction->csPin);
+  callbacks++;
+}
+
+static void SpiTest_TaskMain(void* pvParameters)
+{
+  while (1) {
+    if (NULL != toSubmit) {
+      submitStatus = SPI_Submit(&hspi4, toSubmit);
+      toSubmit = NULL;
+    }
+    notifications += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+}
+
+/**
+ * @brief Submit from the owner task, as the drivers do
+ */
+static SPI_Status_T SpiTest_Submit(SPI_Transaction_T* transaction)
+{
+  toSubmit = transaction;
+  HostSim_EnterIsr();
+  vTaskNotifyGiveFromISR(ownerTaskHandle, NULL);
+  HostSim_ExitIsr();
+  HostSim_RunUntilIdle();
+
+  // The wake up isn't a completion
+  notifications--;
+  return submitStatus;
+}
+
+static bool SpiTest_Complete(bool error)
+{
+  HostSim_EnterIsr();
+  bool completed = HostSpi_Complete(&hspi4, error);
+  HostSim_ExitIsr();
+  HostSim_RunUntilIdle();
+  return completed;
+}
+
+/**
+ * @brief A fresh link, with its own data
+ */
+static SPI_Transaction_T* SpiTest_Link(uint8_t n, uint16_t csPin)
+{
+  SpiTest_Link_T* link = &links[n];
+  memset(link, 0, sizeof(SpiTest_Link_T));
+
+  uint8_t i;
+  for (i = 0; i < SPITEST_LENGTH; ++i) {
+    link->tx[i] = (uint8_t)((n << 4) | i);
+  }
+
+  link->transaction.txData = link->tx;
+  link->transaction.rxData = link->rx;
+  link->transaction.length = SPITEST_LENGTH;
+  link->transaction.csPort = SPITEST_CS_PORT;
+  link->transaction.csPin = csPin;
+  link->transaction.notifyTask = ownerTaskHandle;
+  link->transaction.callback = SpiTest_Callback;
+  return &link->transaction;
+}
+
+static bool SpiTest_Exchanged(uint8_t n)
+{
+  uint8_t i;
+  for (i = 0; i < SPITEST_LENGTH; ++i) {
+    if (links[n].rx[i] != (uint8_t)~links[n].tx[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void SpiTest_Reset(void)
+{
+  callbacks = 0;
+  notifications = 0;
+}
+
+static void SpiTest_Single(void)
+{
+  SpiTest_Reset();
+  SPI_Transaction_T* a = SpiTest_Link(0, SPITEST_CS_A);
+
+  SpiTest_Check(SPI_STATUS_OK == SpiTest_Submit(a), "single: submitted");
+  SpiTest_Check(SPI_TRANSACTION_ACTIVE == a->state, "single: active once submitted to an idle bus");
+  SpiTest_Check(SpiTest_Asserted(SPITEST_CS_A), "single: chip select asserted during the transfer");
+  SpiTest_Check(SPITEST_LENGTH == HostSpi_GetPending(&hspi4), "single: transfer length");
+
+  SpiTest_Check(SpiTest_Complete(false), "single: transfer in progress");
+  SpiTest_Check(csAssertedAtDevice, "single: device selected");
+  SpiTest_Check(SPI_TRANSACTION_DONE == a->state && SPI_IsComplete(a), "single: done");
+  SpiTest_Check(SpiTest_Exchanged(0), "single: data exchanged");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_A), "single: chip select released");
+  SpiTest_Check(1U == callbacks && 1U == notifications, "single: called back and notified once");
+  SpiTest_Check(0U == HostSpi_GetPending(&hspi4), "single: bus idle");
+}
+
+static void SpiTest_Chain(void)
+{
+  SpiTest_Reset();
+  SPI_Transaction_T* a = SpiTest_Link(0, SPITEST_CS_A);
+  SPI_Transaction_T* b = SpiTest_Link(1, SPITEST_CS_A);
+  SPI_Transaction_T* c = SpiTest_Link(2, SPITEST_CS_B);
+  a->next = b;
+  b->next = c;
+
+  SpiTest_Check(SPI_STATUS_OK == SpiTest_Submit(a), "chain: submitted");
+  SpiTest_Check(SPI_TRANSACTION_QUEUED == b->state && SPI_TRANSACTION_QUEUED == c->state, "chain: links queued");
+
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_DONE == a->state && SPI_TRANSACTION_ACTIVE == b->state, "chain: second link started");
+  SpiTest_Check(csAssertedAtCallback && SpiTest_Asserted(SPITEST_CS_A), "chain: chip select kept for the same device");
+
+  SpiTest_Complete(false);
+  SpiTest_Check(!csAssertedAtCallback, "chain: chip select released before the other device's link");
+  SpiTest_Check(SPI_TRANSACTION_ACTIVE == c->state, "chain: third link started");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_A) && SpiTest_Asserted(SPITEST_CS_B),
+                "chain: chip select moved to the other device");
+
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_DONE == c->state, "chain: done");
+  SpiTest_Check(SpiTest_Exchanged(0) && SpiTest_Exchanged(1) && SpiTest_Exchanged(2), "chain: data exchanged");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_A) && !SpiTest_Asserted(SPITEST_CS_B), "chain: chip selects released");
+  SpiTest_Check(3U == callbacks && 3U == notifications, "chain: every link called back and notified");
+}
+
+static void SpiTest_Queue(void)
+{
+  SpiTest_Reset();
+  SPI_Transaction_T* a = SpiTest_Link(0, SPITEST_CS_A);
+  SPI_Transaction_T* b = SpiTest_Link(1, SPITEST_CS_B);
+  SPI_Transaction_T* c = SpiTest_Link(2, SPITEST_CS_A);
+
+  SpiTest_Submit(a);
+  SpiTest_Submit(b);
+  SpiTest_Submit(c);
+  SpiTest_Check(SPI_TRANSACTION_ACTIVE == a->state && SPI_TRANSACTION_QUEUED == b->state &&
+                SPI_TRANSACTION_QUEUED == c->state, "queue: only the first chain on the bus");
+
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_ACTIVE == b->state && SPI_TRANSACTION_QUEUED == c->state, "queue: second chain next");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_A) && SpiTest_Asserted(SPITEST_CS_B), "queue: second chain's device selected");
+
+  SpiTest_Complete(false);
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_DONE == c->state && 0U == HostSpi_GetPending(&hspi4), "queue: all done in order");
+  SpiTest_Check(3U == notifications, "queue: every chain notified");
+}
+
+static void SpiTest_Errors(void)
+{
+  SpiTest_Reset();
+  SPI_Transaction_T* a = SpiTest_Link(0, SPITEST_CS_A);
+  SPI_Transaction_T* b = SpiTest_Link(1, SPITEST_CS_A);
+  SPI_Transaction_T* c = SpiTest_Link(2, SPITEST_CS_B);
+  a->next = b;
+
+  SpiTest_Submit(a);
+  SpiTest_Submit(c);
+  SpiTest_Complete(true);
+  SpiTest_Check(SPI_TRANSACTION_ERROR == a->state && SPI_TRANSACTION_ERROR == b->state, "error: whole chain failed");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_A), "error: chip select released");
+  SpiTest_Check(SPI_TRANSACTION_ACTIVE == c->state, "error: next chain started");
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_DONE == c->state, "error: next chain done");
+  SpiTest_Check(3U == callbacks && 3U == notifications, "error: failed links called back and notified");
+
+  // Start failures, on an idle bus and when chaining
+  SpiTest_Reset();
+  a = SpiTest_Link(0, SPITEST_CS_A);
+  HostSpi_FailNextStart(&hspi4);
+  SpiTest_Check(SPI_STATUS_OK == SpiTest_Submit(a), "start failure: submitted");
+  SpiTest_Check(SPI_TRANSACTION_ERROR == a->state, "start failure: failed");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_A) && 0U == HostSpi_GetPending(&hspi4), "start failure: bus released");
+  SpiTest_Check(1U == notifications, "start failure: notified");
+
+  SpiTest_Reset();
+  a = SpiTest_Link(0, SPITEST_CS_A);
+  b = SpiTest_Link(1, SPITEST_CS_B);
+  c = SpiTest_Link(2, SPITEST_CS_A);
+  a->next = b;
+  SpiTest_Submit(a);
+  SpiTest_Submit(c);
+  HostSpi_FailNextStart(&hspi4);
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_DONE == a->state && SPI_TRANSACTION_ERROR == b->state,
+                "chain start failure: the link that failed to start failed");
+  SpiTest_Check(!SpiTest_Asserted(SPITEST_CS_B), "chain start failure: its chip select released");
+  SpiTest_Check(SPI_TRANSACTION_ACTIVE == c->state, "chain start failure: next chain started");
+  SpiTest_Complete(false);
+}
+
+static void SpiTest_Submits(void)
+{
+  SpiTest_Reset();
+  SPI_Transaction_T* a = SpiTest_Link(0, SPITEST_CS_A);
+  a->length = 0;
+  SpiTest_Check(SPI_STATUS_ERROR == SpiTest_Submit(a), "submit: empty transaction rejected");
+  a = SpiTest_Link(0, SPITEST_CS_A);
+  a->txData = NULL;
+  a->rxData = NULL;
+  SpiTest_Check(SPI_STATUS_ERROR == SpiTest_Submit(a), "submit: transaction without data rejected");
+
+  // One on the bus, then the queue filled
+  uint8_t n;
+  for (n = 0; n <= SPI_QUEUE_LENGTH; ++n) {
+    SpiTest_Submit(SpiTest_Link(n, SPITEST_CS_A));
+  }
+  SpiTest_Check(SPI_STATUS_ERROR_BUSY == SpiTest_Submit(&links[1].transaction), "submit: queued transaction rejected");
+  SpiTest_Check(SPI_STATUS_ERROR_FULL == SpiTest_Submit(SpiTest_Link(n, SPITEST_CS_A)), "submit: full queue rejected");
+
+  while (SpiTest_Complete(false)) {
+  }
+  for (n = 0; n <= SPI_QUEUE_LENGTH; ++n) {
+    SpiTest_Check(SPI_TRANSACTION_DONE == links[n].transaction.state && SpiTest_Exchanged(n), "submit: queue drained");
+  }
+
+  // Receive and transmit only
+  SpiTest_Reset();
+  a = SpiTest_Link(0, SPITEST_CS_A);
+  a->txData = NULL;
+  SPI_Transaction_T* b = SpiTest_Link(1, SPITEST_CS_A);
+  b->rxData = NULL;
+  HostSpi_SetDeviceHook(NULL);
+  SpiTest_Submit(a);
+  SpiTest_Submit(b);
+  SpiTest_Complete(false);
+  SpiTest_Complete(false);
+  SpiTest_Check(SPI_TRANSACTION_DONE == a->state && 0xFFU == links[0].rx[0], "submit: receive only");
+  SpiTest_Check(SPI_TRANSACTION_DONE == b->state, "submit: transmit only");
+  HostSpi_SetDeviceHook(SpiTest_Device);
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  Log_Init(&firmwareLog);
+  HostSpi_SetDeviceHook(SpiTest_Device);
+
+  // Chip selects idle high, as MX_GPIO_Init leaves them
+  HAL_GPIO_WritePin(SPITEST_CS_PORT, SPITEST_CS_A | SPITEST_CS_B, GPIO_PIN_SET);
+
+  if ((SPI_STATUS_OK != SPI_Init(&firmwareLog)) || (SPI_STATUS_OK != SPI_Config(&hspi4))) {
+    printf("Firmware failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+
+  ownerTaskHandle = xTaskCreateStatic(
+      SpiTest_TaskMain,
+      "SpiTestTask",
+      STACK_SIZE,
+      NULL,
+      SPITEST_PRIORITY,
+      taskStack,
+      &taskBuffer);
+
+  HostSim_Start();
+
+  SpiTest_Single();
+  SpiTest_Chain();
+  SpiTest_Queue();
+  SpiTest_Errors();
+  SpiTest_Submits();
+
+  printf("%u checks failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
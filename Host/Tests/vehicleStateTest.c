@@ -0,0 +1,409 @@
+/*
+ * vehicleStateTest.c
+ *
+ * Measures the vehicle state machine's event-to-action latency on the
+ * simulation, with the torque path's modules as initialize.c starts them.
+ *
+ * Each event happens in DRIVE, between two ticks, and is timed to:
+ *   - the state change,
+ *   - the first inverter command on the bus with the enable cleared.
+ * Events:
+ *   - the inverter reports a fault in its status frame,
+ *   - the dashboard drops the HV request,
+ *   - APPS1 reads above its range,
+ *   - the dashboard frames stop, timed from the monitor's timeout tick,
+ *   - the inverter status frames stop, timed from the status timeout.
+ * Inputs from CAN reach the state machine through the tick's deferred
+ * decode and the inverter's publish, and the APPS through the ADC scan and
+ * the pedals, so each path is allowed its own number of control periods.
+ * Tasks take no simulated time, so this is the scheduling latency, not the
+ * target's.
+ *
+ * Exits non-zero if an event is missed, or its action is late.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hostSim.h"
+#include "hostCan.h"
+
+#include "lib/logging/logging.h"
+#include "lib/paramStore/paramStore.h"
+#include "lib/signalDb/signalDb.h"
+#include "io/adc/adc.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "time/deferred/deferred.h"
+#include "device/analog/analog.h"
+#include "device/inverter/inverter.h"
+#include "device/wheelspeed/wheelspeed.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleProcesses/tractionControl/tractionControl.h"
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+#include "vehicleInterface/analogMapping/analogMapping.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+extern uint16_t hostVrefintCal;
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+// Frames and events arrive this far into a tick
+#define VEHICLESTATETEST_OFFSET_NS      ((uint64_t) 250000U)
+#define VEHICLESTATETEST_PERIOD_NS      ((uint64_t) VEHICLESTATE_PERIOD_MS * HOSTSIM_TICK_NS)
+#define VEHICLESTATETEST_TIMEOUT_MS     2000U
+#define VEHICLESTATETEST_DRIVE_MS       100U
+
+// Pedal readings, in ADC counts
+#define VEHICLESTATETEST_APPS1_RELEASED 400U
+#define VEHICLESTATETEST_APPS1_OVER     3900U
+#define VEHICLESTATETEST_APPS2_RELEASED 3600U
+#define VEHICLESTATETEST_BRAKE_RELEASED 400U
+#define VEHICLESTATETEST_BRAKE_PRESSED  2000U
+
+#define VEHICLESTATETEST_DC_VOLTAGE     350.0f
+#define VEHICLESTATETEST_STATUS_FAULT   0x80U
+
+typedef struct
+{
+  const char* name;
+  uint64_t (*inject)(uint64_t nowNs);   /* Returns the event's time */
+  VehicleState_State_T state;           /* State the event leads to */
+  uint8_t periods;                      /* Control periods allowed */
+} VehicleStateTest_Event_T;
+
+// Bus traffic the test sends
+static bool dashOn;
+static bool dashHv;
+static bool dashStart;
+static uint64_t dashLastNs;
+static bool statusOn;
+static bool statusFault;
+static uint8_t statusCounter;
+static uint64_t statusLastNs;
+
+// Inverter commands seen
+static bool commandEnabled;
+static uint64_t commandOffNs;
+
+static uint64_t stepNs;
+static uint32_t failures;
+
+// ------------------- Private methods -------------------
+static void VehicleStateTest_Check(bool condition, const char* what)
+{
+  if (!condition) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint8_t VehicleStateTest_Checksum(const uint8_t* data)
+{
+  uint8_t sum = 0;
+  uint8_t i;
+  for (i = 0; i < 7U; ++i) {
+    sum += data[i];
+  }
+  return (uint8_t)~sum;
+}
+
+static void VehicleStateTest_Receive(uint32_t id, const uint8_t* data)
+{
+  HostSim_EnterIsr();
+  (void)HostCan_Receive(1, id, data, 8);
+  HostSim_ExitIsr();
+  HostSim_RunUntilIdle();
+}
+
+static void VehicleStateTest_SendDash(void)
+{
+  uint8_t data[8] = { 0 };
+  data[0] = (dashHv ? 0x01U : 0x00U) | (dashStart ? 0x02U : 0x00U);
+  VehicleStateTest_Receive(VEHICLESTATE_CAN_ID_DASH, data);
+  dashLastNs = HostSim_GetTimeNs();
+}
+
+static void VehicleStateTest_SendStatus(void)
+{
+  uint16_t voltage = (uint16_t)(VEHICLESTATETEST_DC_VOLTAGE * 10.0f);
+
+  uint8_t data[8] = { 0 };
+  data[4] = voltage & 0xFF;
+  data[5] = (voltage >> 8) & 0xFF;
+  data[6] = (uint8_t)((statusCounter & 0x0FU) | (statusFault ? VEHICLESTATETEST_STATUS_FAULT : 0x00U));
+  data[7] = VehicleStateTest_Checksum(data);
+  statusCounter++;
+  VehicleStateTest_Receive(INVERTER_CAN_ID_STATUS, data);
+  statusLastNs = HostSim_GetTimeNs();
+}
+
+static void VehicleStateTest_SetPedals(uint16_t apps1, uint16_t brake)
+{
+  HostAdc_Set(MAPPING_ADC_APPS1, apps1);
+  HostAdc_Set(MAPPING_ADC_APPS2, VEHICLESTATETEST_APPS2_RELEASED);
+  HostAdc_Set(MAPPING_ADC_BRAKE, brake);
+}
+
+static void VehicleStateTest_Tx(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc)
+{
+  CanRecorder_TxComplete(HostCan_GetHandle(bus), 0);
+  if (1U != bus || INVERTER_CAN_ID_COMMAND != id || dlc < 8U) {
+    return;
+  }
+
+  bool enable = (data[4] & 0x01U) != 0;
+  if (commandEnabled && !enable && (0U == commandOffNs)) {
+    commandOffNs = HostSim_GetTimeNs();
+  }
+  commandEnabled = enable;
+}
+
+static void VehicleStateTest_Rx(CAN_HandleTypeDef* hcan)
+{
+  CanRecorder_RxPending(hcan, CAN_RX_FIFO0);
+}
+
+/**
+ * @brief One tick: this tick's frames, then the tick
+ * @param inject Event to inject before the frames, or NULL
+ * @param eventNs Set to the event's time
+ */
+static void VehicleStateTest_Step(uint64_t (*inject)(uint64_t nowNs), uint64_t* eventNs)
+{
+  uint64_t ms = stepNs / HOSTSIM_TICK_NS;
+  HostSim_AdvanceTo(stepNs + VEHICLESTATETEST_OFFSET_NS);
+
+  if (NULL != inject) {
+    *eventNs = inject(HostSim_GetTimeNs());
+  }
+  if (dashOn && (0U == ms % VEHICLESTATE_DASH_PERIOD_MS)) {
+    VehicleStateTest_SendDash();
+  }
+  if (statusOn && (0U == ms % INVERTER_STATUS_PERIOD_MS)) {
+    VehicleStateTest_SendStatus();
+  }
+
+  stepNs += HOSTSIM_TICK_NS;
+  HostSim_AdvanceTo(stepNs);
+}
+
+/**
+ * @brief Runs until the state is reached
+ * @return false on timeout
+ */
+static bool VehicleStateTest_RunUntil(VehicleState_State_T state)
+{
+  uint32_t ms;
+  for (ms = 0; ms < VEHICLESTATETEST_TIMEOUT_MS; ++ms) {
+    if (state == VehicleState_Get()) {
+      return true;
+    }
+    VehicleStateTest_Step(NULL, NULL);
+  }
+  return state == VehicleState_Get();
+}
+
+/**
+ * @brief From LV_ON, as a driver would: HV, then start with the brake
+ * pressed, then released pedals
+ */
+static bool VehicleStateTest_Drive(void)
+{
+  dashOn = true;
+  statusOn = true;
+  statusFault = false;
+  dashHv = true;
+  dashStart = true;
+  VehicleStateTest_SetPedals(VEHICLESTATETEST_APPS1_RELEASED, VEHICLESTATETEST_BRAKE_PRESSED);
+  if (!VehicleStateTest_RunUntil(VEHICLESTATE_DRIVE)) {
+    return false;
+  }
+
+  dashStart = false;
+  VehicleStateTest_SetPedals(VEHICLESTATETEST_APPS1_RELEASED, VEHICLESTATETEST_BRAKE_RELEASED);
+  uint32_t ms;
+  for (ms = 0; ms < VEHICLESTATETEST_DRIVE_MS; ++ms) {
+    VehicleStateTest_Step(NULL, NULL);
+  }
+  return (VEHICLESTATE_DRIVE == VehicleState_Get()) && commandEnabled;
+}
+
+/**
+ * @brief Back to LV_ON, with the inputs healthy and HV not requested
+ */
+static bool VehicleStateTest_Recover(void)
+{
+  dashOn = true;
+  statusOn = true;
+  statusFault = false;
+  dashHv = false;
+  dashStart = false;
+  VehicleStateTest_SetPedals(VEHICLESTATETEST_APPS1_RELEASED, VEHICLESTATETEST_BRAKE_RELEASED);
+  return VehicleStateTest_RunUntil(VEHICLESTATE_LV_ON);
+}
+
+/*
+ * Events
+ */
+static uint64_t VehicleStateTest_InverterFault(uint64_t nowNs)
+{
+  statusFault = true;
+  VehicleStateTest_SendStatus();
+  return nowNs;
+}
+
+static uint64_t VehicleStateTest_HvDropped(uint64_t nowNs)
+{
+  dashHv = false;
+  VehicleStateTest_SendDash();
+  return nowNs;
+}
+
+static uint64_t VehicleStateTest_Apps1Over(uint64_t nowNs)
+{
+  VehicleStateTest_SetPedals(VEHICLESTATETEST_APPS1_OVER, VEHICLESTATETEST_BRAKE_RELEASED);
+  return nowNs;
+}
+
+static uint64_t VehicleStateTest_DashLost(uint64_t nowNs)
+{
+  dashOn = false;
+  // The monitor's age is in ticks, from the tick the last frame arrived in
+  uint64_t lastTickNs = (dashLastNs / HOSTSIM_TICK_NS) * HOSTSIM_TICK_NS;
+  return lastTickNs + (uint64_t)VEHICLESTATE_DASH_TIMEOUT_MS * HOSTSIM_TICK_NS;
+}
+
+static uint64_t VehicleStateTest_StatusLost(uint64_t nowNs)
+{
+  statusOn = false;
+  return statusLastNs + (uint64_t)INVERTER_STATUS_TIMEOUT_MS * HOSTSIM_TICK_NS;
+}
+
+/*
+ * CAN inputs are decoded in the tick after they arrive and the inverter
+ * feedback is published after the state machine has run, so a period each.
+ * The APPS wait for the ADC scan and the pedals.
+ */
+static const VehicleStateTest_Event_T events[] = {
+  { "inverter fault",     VehicleStateTest_InverterFault, VEHICLESTATE_FAULT, 2U },
+  { "HV request dropped", VehicleStateTest_HvDropped,     VEHICLESTATE_LV_ON, 1U },
+  { "APPS1 over range",   VehicleStateTest_Apps1Over,     VEHICLESTATE_FAULT, 3U },
+  { "dash lost",          VehicleStateTest_DashLost,      VEHICLESTATE_FAULT, 1U },
+  { "inverter status lost", VehicleStateTest_StatusLost,  VEHICLESTATE_FAULT, 2U },
+};
+#define VEHICLESTATETEST_NUM_EVENTS (sizeof(events) / sizeof(events[0]))
+
+/**
+ * @brief Times an event from DRIVE
+ */
+static void VehicleStateTest_Measure(const VehicleStateTest_Event_T* event)
+{
+  char what[96];
+  if (!VehicleStateTest_Drive()) {
+    snprintf(what, sizeof(what), "%s: didn't reach DRIVE", event->name);
+    VehicleStateTest_Check(false, what);
+    return;
+  }
+
+  commandOffNs = 0;
+  uint64_t eventNs = 0;
+  uint64_t stateNs = 0;
+  VehicleStateTest_Step(event->inject, &eventNs);
+  uint32_t ms;
+  for (ms = 0; ms < VEHICLESTATETEST_TIMEOUT_MS; ++ms) {
+    if ((0U == stateNs) && (VEHICLESTATE_DRIVE != VehicleState_Get())) {
+      stateNs = stepNs;
+      snprintf(what, sizeof(what), "%s: reaches the expected state", event->name);
+      VehicleStateTest_Check(event->state == VehicleState_Get(), what);
+    }
+    if ((0U != stateNs) && (0U != commandOffNs)) {
+      break;
+    }
+    VehicleStateTest_Step(NULL, NULL);
+  }
+
+  if ((0U == stateNs) || (0U == commandOffNs) || (stateNs < eventNs) || (commandOffNs < eventNs)) {
+    snprintf(what, sizeof(what), "%s: state change and disabling command", event->name);
+    VehicleStateTest_Check(false, what);
+  } else {
+    uint64_t stateUs = (stateNs - eventNs) / 1000U;
+    uint64_t commandUs = (commandOffNs - eventNs) / 1000U;
+    uint64_t boundUs = (event->periods * VEHICLESTATETEST_PERIOD_NS) / 1000U;
+    bool passed = (stateUs <= boundUs) && (commandUs <= boundUs);
+    printf("%-22s %8llu %10llu %8llu %s\n", event->name, (unsigned long long)stateUs,
+        (unsigned long long)commandUs, (unsigned long long)boundUs, passed ? "PASS" : "FAIL");
+    if (!passed) {
+      failures++;
+    }
+  }
+
+  if (!VehicleStateTest_Recover()) {
+    snprintf(what, sizeof(what), "%s: recovers to LV_ON", event->name);
+    VehicleStateTest_Check(false, what);
+  }
+}
+
+/**
+ * @brief The firmware modules of the torque path, in the order
+ * initialize.c starts them
+ */
+static bool VehicleStateTest_InitFirmware(void)
+{
+  Log_Init(&firmwareLog);
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  uint8_t numAnalogChannels;
+  const Analog_ChannelConfig_T* analogChannels = Mapping_GetAnalogChannels(&numAnalogChannels);
+  uint8_t numAnalogBiases;
+  const Analog_BiasConfig_T* analogBiases = Mapping_GetAnalogBiases(&numAnalogBiases);
+
+  return PARAMSTORE_STATUS_OK == ParamStore_Init(&firmwareLog, Mapping_GetParamDefaults(), MAPPING_PARAM_NUM_PARAMS) &&
+         ADC_STATUS_OK == ADC_Init(&firmwareLog, MAPPING_ADC_NUM_CHANNELS, 16) &&
+         DEFERRED_STATUS_OK == Deferred_Init(&firmwareLog) &&
+         SIGNALDB_STATUS_OK == SignalDb_Init(&firmwareLog, signalGroups, numSignalGroups) &&
+         CANMONITOR_STATUS_OK == CanMonitor_Init(&firmwareLog) &&
+         CANRECORDER_STATUS_OK == CanRecorder_Init(&firmwareLog) &&
+         WHEELSPEED_STATUS_OK == WheelSpeed_Init(&firmwareLog) &&
+         INVERTER_STATUS_OK == Inverter_Init(&firmwareLog, &hcan1) &&
+         ANALOG_STATUS_OK == Analog_Init(&firmwareLog, analogChannels, numAnalogChannels, MAPPING_ADC1_VREFINT,
+                                         analogBiases, numAnalogBiases) &&
+         VEHICLESTATE_STATUS_OK == VehicleState_Init(&firmwareLog, &hcan1) &&
+         PEDALS_STATUS_OK == Pedals_Init(&firmwareLog) &&
+         TRACTIONCONTROL_STATUS_OK == TractionControl_Init(&firmwareLog);
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  HostAdc_Set(MAPPING_ADC1_VREFINT, hostVrefintCal);
+  VehicleStateTest_SetPedals(VEHICLESTATETEST_APPS1_RELEASED, VEHICLESTATETEST_BRAKE_RELEASED);
+
+  if (!VehicleStateTest_InitFirmware()) {
+    printf("Firmware failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+  HostCan_SetRxHook(VehicleStateTest_Rx);
+  HostCan_SetTxHook(VehicleStateTest_Tx);
+  HostSim_Start();
+
+  printf("%-22s %8s %10s %8s\n", "event", "state us", "command us", "bound us");
+  size_t i;
+  for (i = 0; i < VEHICLESTATETEST_NUM_EVENTS; ++i) {
+    VehicleStateTest_Measure(&events[i]);
+  }
+
+  VehicleState_Stats_T stats;
+  VehicleState_GetStats(&stats);
+  printf("%lu transitions\n", (unsigned long)stats.transitions);
+  printf("%u checks failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+/*
+ * wheelspeedTest.c
+ *
+ * Checks of the wheel speed calculation, on the simulation with pulses on
+ * the front left wheel from its interrupt:
+ *  - A steady speed, from the time between pulses.
+ *  - Zero once no pulse is seen for the timeout.
+ *  - After a stop, the first pulse restarts the measurement and reads zero,
+ *    and the second gives the speed again. Also with the stop lasting a
+ *    CycleCounter wrap, where the first pulse lands just after the last one
+ *    before the stop in cycles.
+ *
+ * Exits non-zero if any check fails.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "hostSim.h"
+
+#include "lib/logging/logging.h"
+#include "lib/signalDb/signalDb.h"
+#include "device/wheelspeed/wheelspeed.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+#define WHEELSPEEDTEST_SPEED        10.0f   /* m/s */
+#define WHEELSPEEDTEST_TOLERANCE    0.02f   /* Of the speed */
+
+static uint32_t failures;
+static uint64_t pulsePeriodNs;
+static uint64_t lastPulseNs;
+
+// ------------------- Private methods -------------------
+static void WheelSpeedTest_Check(bool pass, const char* what)
+{
+  if (!pass) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static float WheelSpeedTest_Speed(void)
+{
+  WheelSpeed_Data_T data;
+  WheelSpeed_Get(&data);
+  return data.speed[WHEELSPEED_FL];
+}
+
+static bool WheelSpeedTest_Near(float speed)
+{
+  return fabsf(speed - WHEELSPEEDTEST_SPEED) < (WHEELSPEEDTEST_SPEED * WHEELSPEEDTEST_TOLERANCE);
+}
+
+static void WheelSpeedTest_Pulse(uint64_t timeNs)
+{
+  HostSim_AdvanceTo(timeNs);
+  HostSim_EnterIsr();
+  WheelSpeed_EXTI_Callback(WHEELSPEED_FL_Pin);
+  HostSim_ExitIsr();
+  lastPulseNs = timeNs;
+}
+
+/**
+ * @brief Pulses at the test speed until the given time
+ */
+static void WheelSpeedTest_Drive(uint64_t untilNs)
+{
+  while ((lastPulseNs + pulsePeriodNs) <= untilNs) {
+    WheelSpeedTest_Pulse(lastPulseNs + pulsePeriodNs);
+  }
+  HostSim_AdvanceTo(untilNs);
+}
+
+/**
+ * @brief A stop of the given length, then two pulses at the test speed
+ */
+static void WheelSpeedTest_Restart(uint64_t stopNs, const char* name)
+{
+  char what[96];
+
+  WheelSpeedTest_Drive(HostSim_GetTimeNs() + 100000000ULL);
+  snprintf(what, sizeof(what), "%s: %.2f m/s before the stop", name, (double)WheelSpeedTest_Speed());
+  WheelSpeedTest_Check(WheelSpeedTest_Near(WheelSpeedTest_Speed()), what);
+
+  uint64_t stoppedNs = lastPulseNs + ((WHEELSPEED_TIMEOUT_MS + 10U) * 1000000ULL);
+  HostSim_AdvanceTo(stoppedNs);
+  snprintf(what, sizeof(what), "%s: %.2f m/s after the timeout", name, (double)WheelSpeedTest_Speed());
+  WheelSpeedTest_Check(0.0f == WheelSpeedTest_Speed(), what);
+
+  WheelSpeedTest_Pulse(lastPulseNs + stopNs);
+  HostSim_AdvanceTo(lastPulseNs + (pulsePeriodNs / 2U));
+  snprintf(what, sizeof(what), "%s: %.2f m/s after the first pulse", name, (double)WheelSpeedTest_Speed());
+  WheelSpeedTest_Check(0.0f == WheelSpeedTest_Speed(), what);
+
+  WheelSpeedTest_Drive(lastPulseNs + pulsePeriodNs + 1000000ULL);
+  snprintf(what, sizeof(what), "%s: %.2f m/s after the second pulse", name, (double)WheelSpeedTest_Speed());
+  WheelSpeedTest_Check(WheelSpeedTest_Near(WheelSpeedTest_Speed()), what);
+}
+
+// ------------------- Public methods -------------------
+int main(void)
+{
+  Log_Init(&firmwareLog);
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  if ((SIGNALDB_STATUS_OK != SignalDb_Init(&firmwareLog, signalGroups, numSignalGroups)) ||
+      (WHEELSPEED_STATUS_OK != WheelSpeed_Init(&firmwareLog))) {
+    printf("Firmware failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+
+  HostSim_Start();
+
+  float distPerPulse = WHEELSPEED_TYRE_CIRC_M / (float)WHEELSPEED_TEETH;
+  pulsePeriodNs = (uint64_t)(1e9f * distPerPulse / WHEELSPEEDTEST_SPEED);
+  lastPulseNs = 1000000ULL;
+
+  // First pulse since boot
+  WheelSpeedTest_Pulse(lastPulseNs);
+  HostSim_AdvanceTo(lastPulseNs + (pulsePeriodNs / 2U));
+  WheelSpeedTest_Check(0.0f == WheelSpeedTest_Speed(), "no speed from the first pulse since boot");
+
+  WheelSpeedTest_Restart(1000000000ULL, "1s stop");
+
+  // The old pulse appears 1ms before the new one in cycles
+  uint64_t wrapNs = (0x100000000ULL * 1000000000ULL) / SystemCoreClock;
+  WheelSpeedTest_Restart(wrapNs + 1000000ULL, "CycleCounter wrap stop");
+
+  printf("%u checks failed\n", failures);
+  return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
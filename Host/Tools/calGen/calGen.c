@@ -0,0 +1,523 @@
+/*
+ * calGen.c
+ *
+ * Generates lib/map maps from calibration files, as const tables for flash.
+ *
+ *   calGen -o base cal...
+ *
+ * Writes base.c with the tables and maps, and base.h declaring the maps.
+ * A calibration file has one or more maps:
+ *
+ *   # Pedal position to torque fraction
+ *   map torqueMap
+ *   x 0 0.1 0.2 ...
+ *   v 0 0.02 0.05 ...
+ *
+ * x is the first axis. A 2D map adds a y axis and has a v line of values
+ * for each y breakpoint, in order. Values are separated by spaces or commas,
+ * and lines starting with # are comments. Each map is generated as the
+ * cheapest lookup that fits it:
+ *  - Map_Uniform1D_T or Map_Uniform2D_T for evenly spaced axes,
+ *  - Map_Table1D_T or Map_Table2D_T otherwise.
+ * "map name q" declares a fixed point map, Map_Uniform1D_Q_T. Its axis must
+ * be integers spaced by a power of two of at most 2^MAP_Q_MAX_SHIFT, and its
+ * values int16_t.
+ *
+ * Errors are reported with their file and line, and nothing is written.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <ctype.h>
+#include <libgen.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lib/map/map.h"
+
+// ------------------- Private data -------------------
+#define CALGEN_MAX_MAPS       128U
+#define CALGEN_MAX_NAME       64U
+#define CALGEN_LINE_LEN       16384U
+#define CALGEN_PATH_LEN       4096U
+
+// Relative to the axis span, how far a breakpoint may be off an even grid
+#define CALGEN_UNIFORM_TOL    1.0e-6
+
+typedef enum
+{
+  CALGEN_UNIFORM1D,
+  CALGEN_UNIFORM2D,
+  CALGEN_UNIFORM1D_Q,
+  CALGEN_TABLE1D,
+  CALGEN_TABLE2D
+} CalGen_Kind_T;
+
+typedef struct
+{
+  double* values;
+  uint32_t count;
+} CalGen_Array_T;
+
+typedef struct
+{
+  char name[CALGEN_MAX_NAME];
+  bool fixed;
+  const char* file;
+  uint32_t line;
+
+  CalGen_Array_T x;
+  CalGen_Array_T y;
+  CalGen_Array_T v;     /* Row major, one row per y breakpoint */
+  uint32_t rows;
+
+  CalGen_Kind_T kind;
+} CalGen_Map_T;
+
+static CalGen_Map_T maps[CALGEN_MAX_MAPS];
+static uint32_t numMaps;
+
+// ------------------- Private methods -------------------
+static void CalGen_Error(const char* file, uint32_t line, const char* what)
+{
+  fprintf(stderr, "%s:%u: %s\n", file, line, what);
+}
+
+static bool CalGen_IsIdentifier(const char* name)
+{
+  if (('\0' == name[0]) || isdigit((unsigned char)name[0])) {
+    return false;
+  }
+  const char* c;
+  for (c = name; '\0' != *c; ++c) {
+    if (!isalnum((unsigned char)*c) && ('_' != *c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Appends the numbers on the rest of a line
+ * @return false if one isn't a finite number
+ */
+static bool CalGen_ParseValues(CalGen_Array_T* array, char* rest)
+{
+  char* token;
+  while (NULL != (token = strtok(rest, " \t,\r\n"))) {
+    rest = NULL;
+    char* end;
+    double value = strtod(token, &end);
+    if (('\0' != *end) || !isfinite(value)) {
+      return false;
+    }
+    double* values = realloc(array->values, (array->count + 1U) * sizeof(double));
+    if (NULL == values) {
+      return false;
+    }
+    array->values = values;
+    array->values[array->count++] = value;
+  }
+  return true;
+}
+
+/**
+ * @brief Whether an axis is evenly spaced
+ */
+static bool CalGen_IsUniform(const CalGen_Array_T* axis)
+{
+  double x0 = axis->values[0];
+  double span = axis->values[axis->count - 1U] - x0;
+  double dx = span / (double)(axis->count - 1U);
+  uint32_t i;
+  for (i = 1; i < axis->count; ++i) {
+    if (fabs(axis->values[i] - (x0 + (double)i * dx)) > CALGEN_UNIFORM_TOL * span) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool CalGen_CheckAxis(const CalGen_Map_T* map, const CalGen_Array_T* axis, const char* name)
+{
+  char what[128];
+  if ((axis->count < 2U) || (axis->count > UINT16_MAX)) {
+    snprintf(what, sizeof(what), "map %s: the %s axis needs 2 to %u breakpoints", map->name, name, UINT16_MAX);
+    CalGen_Error(map->file, map->line, what);
+    return false;
+  }
+  uint32_t i;
+  for (i = 1; i < axis->count; ++i) {
+    if (!(axis->values[i] > axis->values[i - 1U])) {
+      snprintf(what, sizeof(what), "map %s: the %s axis isn't strictly increasing", map->name, name);
+      CalGen_Error(map->file, map->line, what);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Checks a fixed point map fits Map_Uniform1D_Q_T
+ */
+static bool CalGen_CheckFixed(const CalGen_Map_T* map)
+{
+  char what[192];
+  const CalGen_Array_T* x = &map->x;
+  double dx = x->values[1] - x->values[0];
+  bool fits = (x->values[0] >= (double)INT32_MIN) && (x->values[x->count - 1U] <= (double)INT32_MAX) &&
+              (dx >= 1.0) && (dx <= (double)(1U << MAP_Q_MAX_SHIFT)) &&
+              (0U == ((uint32_t)dx & ((uint32_t)dx - 1U)));
+  uint32_t i;
+  for (i = 0; fits && (i < x->count); ++i) {
+    fits = (x->values[i] == x->values[0] + (double)i * dx) && (x->values[i] == floor(x->values[i]));
+  }
+  if (!fits) {
+    snprintf(what, sizeof(what), "map %s: a q map's axis must be integers spaced by a power of two up to %u",
+        map->name, 1U << MAP_Q_MAX_SHIFT);
+    CalGen_Error(map->file, map->line, what);
+    return false;
+  }
+  for (i = 0; i < map->v.count; ++i) {
+    double value = map->v.values[i];
+    if ((value != floor(value)) || (value < (double)INT16_MIN) || (value > (double)INT16_MAX)) {
+      snprintf(what, sizeof(what), "map %s: a q map's values must be int16_t", map->name);
+      CalGen_Error(map->file, map->line, what);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Checks a map once all its lines are read, and picks its kind
+ */
+static bool CalGen_Finish(CalGen_Map_T* map)
+{
+  char what[128];
+  bool is2D = map->y.count > 0U;
+  uint32_t rows = is2D ? map->y.count : 1U;
+
+  if (!CalGen_CheckAxis(map, &map->x, "x") || (is2D && !CalGen_CheckAxis(map, &map->y, "y"))) {
+    return false;
+  }
+  if ((map->rows != rows) || (map->v.count != map->x.count * rows)) {
+    snprintf(what, sizeof(what), "map %s: needs %u v lines of %u values", map->name, rows, map->x.count);
+    CalGen_Error(map->file, map->line, what);
+    return false;
+  }
+
+  if (map->fixed) {
+    if (is2D) {
+      snprintf(what, sizeof(what), "map %s: q maps are 1D only", map->name);
+      CalGen_Error(map->file, map->line, what);
+      return false;
+    }
+    map->kind = CALGEN_UNIFORM1D_Q;
+    return CalGen_CheckFixed(map);
+  }
+
+  if (is2D) {
+    map->kind = (CalGen_IsUniform(&map->x) && CalGen_IsUniform(&map->y)) ? CALGEN_UNIFORM2D : CALGEN_TABLE2D;
+  } else {
+    map->kind = CalGen_IsUniform(&map->x) ? CALGEN_UNIFORM1D : CALGEN_TABLE1D;
+  }
+  return true;
+}
+
+static bool CalGen_Parse(const char* path)
+{
+  FILE* file = fopen(path, "r");
+  if (NULL == file) {
+    fprintf(stderr, "Can't open %s\n", path);
+    return false;
+  }
+
+  static char line[CALGEN_LINE_LEN];
+  uint32_t lineNumber = 0;
+  CalGen_Map_T* map = NULL;
+  bool ok = true;
+  while (ok && (NULL != fgets(line, sizeof(line), file))) {
+    lineNumber++;
+    if ((NULL == strchr(line, '\n')) && !feof(file)) {
+      CalGen_Error(path, lineNumber, "line too long");
+      ok = false;
+      break;
+    }
+
+    char* keyword = strtok(line, " \t\r\n");
+    if ((NULL == keyword) || ('#' == keyword[0])) {
+      continue;
+    }
+
+    if (0 == strcmp(keyword, "map")) {
+      if ((NULL != map) && !CalGen_Finish(map)) {
+        ok = false;
+        break;
+      }
+      char* name = strtok(NULL, " \t\r\n");
+      char* type = strtok(NULL, " \t\r\n");
+      if ((NULL == name) || !CalGen_IsIdentifier(name) || (strlen(name) >= CALGEN_MAX_NAME) ||
+          ((NULL != type) && (0 != strcmp(type, "q")))) {
+        CalGen_Error(path, lineNumber, "expected: map name [q]");
+        ok = false;
+        break;
+      }
+      uint32_t i;
+      for (i = 0; i < numMaps; ++i) {
+        if (0 == strcmp(maps[i].name, name)) {
+          CalGen_Error(path, lineNumber, "map already defined");
+          ok = false;
+        }
+      }
+      if (ok && (numMaps >= CALGEN_MAX_MAPS)) {
+        CalGen_Error(path, lineNumber, "too many maps");
+        ok = false;
+      }
+      if (!ok) {
+        break;
+      }
+      map = &maps[numMaps++];
+      strcpy(map->name, name);
+      map->fixed = (NULL != type);
+      map->file = path;
+      map->line = lineNumber;
+      continue;
+    }
+
+    if (NULL == map) {
+      CalGen_Error(path, lineNumber, "expected a map line first");
+      ok = false;
+      break;
+    }
+    char* rest = strtok(NULL, "");
+    CalGen_Array_T* array;
+    if (0 == strcmp(keyword, "x")) {
+      array = (0U == map->x.count) ? &map->x : NULL;
+    } else if (0 == strcmp(keyword, "y")) {
+      array = (0U == map->y.count) && (0U == map->rows) ? &map->y : NULL;
+    } else if (0 == strcmp(keyword, "v")) {
+      array = &map->v;
+      map->rows++;
+    } else {
+      CalGen_Error(path, lineNumber, "expected x, y or v");
+      ok = false;
+      break;
+    }
+    if (NULL == array) {
+      CalGen_Error(path, lineNumber, "axis repeated, or y after the values");
+      ok = false;
+      break;
+    }
+    uint32_t before = array->count;
+    if (!CalGen_ParseValues(array, rest) || (before == array->count)) {
+      CalGen_Error(path, lineNumber, "expected finite numbers");
+      ok = false;
+    }
+  }
+  if (ok && (NULL != map)) {
+    ok = CalGen_Finish(map);
+  }
+
+  fclose(file);
+  return ok;
+}
+
+/**
+ * @brief Prints a double as a float literal that C reads back to the
+ * nearest float
+ */
+static void CalGen_PrintFloat(FILE* out, double value)
+{
+  char text[32];
+  snprintf(text, sizeof(text), "%.9g", value);
+  bool hasPoint = (NULL != strpbrk(text, ".e"));
+  fprintf(out, "%s%sf", text, hasPoint ? "" : ".0");
+}
+
+/**
+ * @param rowLen Values per row, each row starts a line
+ */
+static void CalGen_PrintArray(FILE* out, const char* type, const char* name, const char* suffix,
+    const CalGen_Array_T* array, uint32_t rowLen, bool fixed)
+{
+  fprintf(out, "static const %s %s_%s[] = {", type, name, suffix);
+  uint32_t i;
+  for (i = 0; i < array->count; ++i) {
+    fprintf(out, "%s", (0U == (i % rowLen) % 8U) ? "\n  " : " ");
+    if (fixed) {
+      fprintf(out, "%d", (int)array->values[i]);
+    } else {
+      CalGen_PrintFloat(out, array->values[i]);
+    }
+    fprintf(out, ",");
+  }
+  fprintf(out, "\n};\n");
+}
+
+static const char* CalGen_TypeName(CalGen_Kind_T kind)
+{
+  switch (kind) {
+    case CALGEN_UNIFORM1D:
+      return "Map_Uniform1D_T";
+    case CALGEN_UNIFORM2D:
+      return "Map_Uniform2D_T";
+    case CALGEN_UNIFORM1D_Q:
+      return "Map_Uniform1D_Q_T";
+    case CALGEN_TABLE1D:
+      return "Map_Table1D_T";
+    case CALGEN_TABLE2D:
+    default:
+      return "Map_Table2D_T";
+  }
+}
+
+static void CalGen_WriteMap(FILE* out, const CalGen_Map_T* map)
+{
+  const char* name = map->name;
+  const CalGen_Array_T* x = &map->x;
+  const CalGen_Array_T* y = &map->y;
+  double dx = (x->values[x->count - 1U] - x->values[0]) / (double)(x->count - 1U);
+
+  const char* slash = strrchr(map->file, '/');
+  fprintf(out, "\n// %s:%u\n", (NULL != slash) ? slash + 1 : map->file, map->line);
+  switch (map->kind) {
+    case CALGEN_UNIFORM1D:
+      CalGen_PrintArray(out, "float", name, "v", &map->v, x->count, false);
+      fprintf(out, "const Map_Uniform1D_T %s = MAP_UNIFORM1D(", name);
+      CalGen_PrintFloat(out, x->values[0]);
+      fprintf(out, ", ");
+      CalGen_PrintFloat(out, dx);
+      fprintf(out, ", %s_v);\n", name);
+      break;
+
+    case CALGEN_UNIFORM1D_Q: {
+      uint8_t shift = 0;
+      while ((1U << shift) < (uint32_t)dx) {
+        shift++;
+      }
+      CalGen_PrintArray(out, "int16_t", name, "v", &map->v, x->count, true);
+      fprintf(out, "const Map_Uniform1D_Q_T %s = MAP_UNIFORM1D_Q(%d, %uU, %s_v);\n",
+          name, (int)x->values[0], shift, name);
+      break;
+    }
+
+    case CALGEN_TABLE1D:
+      CalGen_PrintArray(out, "float", name, "x", x, x->count, false);
+      CalGen_PrintArray(out, "float", name, "v", &map->v, x->count, false);
+      fprintf(out, "const Map_Table1D_T %s = MAP_TABLE1D(%s_x, %s_v);\n", name, name, name);
+      break;
+
+    case CALGEN_UNIFORM2D: {
+      double dy = (y->values[y->count - 1U] - y->values[0]) / (double)(y->count - 1U);
+      CalGen_PrintArray(out, "float", name, "v", &map->v, x->count, false);
+      fprintf(out, "const Map_Uniform2D_T %s = {\n  .x0 = ", name);
+      CalGen_PrintFloat(out, x->values[0]);
+      fprintf(out, ",\n  .dxInv = 1.0f / ");
+      CalGen_PrintFloat(out, dx);
+      fprintf(out, ",\n  .nx = %uU,\n  .y0 = ", x->count);
+      CalGen_PrintFloat(out, y->values[0]);
+      fprintf(out, ",\n  .dyInv = 1.0f / ");
+      CalGen_PrintFloat(out, dy);
+      fprintf(out, ",\n  .ny = %uU,\n  .z = %s_v,\n};\n", y->count, name);
+      break;
+    }
+
+    case CALGEN_TABLE2D:
+      CalGen_PrintArray(out, "float", name, "x", x, x->count, false);
+      CalGen_PrintArray(out, "float", name, "y", y, y->count, false);
+      CalGen_PrintArray(out, "float", name, "v", &map->v, x->count, false);
+      fprintf(out, "const Map_Table2D_T %s = {\n  .nx = %uU,\n  .x = %s_x,\n  .ny = %uU,\n  .y = %s_y,\n"
+          "  .z = %s_v,\n};\n", name, x->count, name, y->count, name, name);
+      break;
+  }
+}
+
+static bool CalGen_Write(const char* base)
+{
+  char path[CALGEN_PATH_LEN];
+  char baseCopy[CALGEN_PATH_LEN];
+  snprintf(baseCopy, sizeof(baseCopy), "%s", base);
+  const char* baseName = basename(baseCopy);
+
+  char guard[CALGEN_PATH_LEN];
+  size_t i;
+  for (i = 0; ('\0' != baseName[i]) && (i < sizeof(guard) - 1U); ++i) {
+    guard[i] = isalnum((unsigned char)baseName[i]) ? (char)toupper((unsigned char)baseName[i]) : '_';
+  }
+  guard[i] = '\0';
+
+  snprintf(path, sizeof(path), "%s.h", base);
+  FILE* header = fopen(path, "w");
+  if (NULL == header) {
+    fprintf(stderr, "Can't write %s\n", path);
+    return false;
+  }
+  fprintf(header, "/*\n * %s.h\n *\n * Generated by calGen from the calibration files. Do not edit.\n */\n\n", baseName);
+  fprintf(header, "#ifndef %s_H_\n#define %s_H_\n\n#include \"lib/map/map.h\"\n\n", guard, guard);
+  uint32_t m;
+  for (m = 0; m < numMaps; ++m) {
+    fprintf(header, "extern const %s %s;\n", CalGen_TypeName(maps[m].kind), maps[m].name);
+  }
+  fprintf(header, "\n#endif /* %s_H_ */\n", guard);
+  bool ok = (0 == fclose(header));
+
+  snprintf(path, sizeof(path), "%s.c", base);
+  FILE* source = fopen(path, "w");
+  if (NULL == source) {
+    fprintf(stderr, "Can't write %s\n", path);
+    return false;
+  }
+  fprintf(source, "/*\n * %s.c\n *\n * Generated by calGen from the calibration files. Do not edit.\n */\n\n", baseName);
+  fprintf(source, "#include \"%s.h\"\n", baseName);
+  for (m = 0; m < numMaps; ++m) {
+    CalGen_WriteMap(source, &maps[m]);
+  }
+  return (0 == fclose(source)) && ok;
+}
+
+static void CalGen_Usage(const char* name)
+{
+  fprintf(stderr,
+      "usage: %s -o base cal...\n"
+      "  -o base   write base.c and base.h\n", name);
+}
+
+// ------------------- Public methods -------------------
+int main(int argc, char* argv[])
+{
+  const char* base = NULL;
+  int opt;
+  while (-1 != (opt = getopt(argc, argv, "o:"))) {
+    switch (opt) {
+      case 'o':
+        base = optarg;
+        break;
+      default:
+        CalGen_Usage(argv[0]);
+        return 1;
+    }
+  }
+  if ((NULL == base) || (optind >= argc)) {
+    CalGen_Usage(argv[0]);
+    return 1;
+  }
+
+  int arg;
+  for (arg = optind; arg < argc; ++arg) {
+    if (!CalGen_Parse(argv[arg])) {
+      return 1;
+    }
+  }
+  if (!CalGen_Write(base)) {
+    return 1;
+  }
+  printf("%u maps\n", numMaps);
+  return 0;
+}
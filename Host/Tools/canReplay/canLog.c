@@ -0,0 +1,325 @@
+/*
+ * canLog.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "canLog.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ------------------- Private data -------------------
+#define CANLOG_MAX_TOKENS   24U
+#define CANLOG_ERROR_FLAG   0x20000000U   /* SocketCAN error frame */
+#define CANLOG_NUM_BUSES    3U
+
+// ------------------- Private methods -------------------
+/**
+ * @brief Parses seconds with an optional fraction, exactly, into nanoseconds
+ */
+static bool CanLog_ParseTime(const char* s, uint64_t* ns)
+{
+  uint64_t seconds = 0;
+  uint64_t fraction = 0;
+  uint32_t scale = 1000000000U;
+
+  if (!isdigit((unsigned char)*s)) {
+    return false;
+  }
+  while (isdigit((unsigned char)*s)) {
+    seconds = seconds * 10U + (uint64_t)(*s - '0');
+    s++;
+  }
+  if ('.' == *s) {
+    s++;
+    while (isdigit((unsigned char)*s)) {
+      if (scale > 1U) {
+        scale /= 10U;
+        fraction += (uint64_t)(*s - '0') * scale;
+      }
+      s++;
+    }
+  }
+  if ('\0' != *s && ')' != *s) {
+    return false;
+  }
+
+  *ns = seconds * 1000000000U + fraction;
+  return true;
+}
+
+static bool CanLog_ParseHexByte(const char* s, uint8_t* byte)
+{
+  if (!isxdigit((unsigned char)s[0]) || !isxdigit((unsigned char)s[1])) {
+    return false;
+  }
+  char pair[3] = { s[0], s[1], '\0' };
+  *byte = (uint8_t)strtoul(pair, NULL, 16);
+  return true;
+}
+
+static bool CanLog_ParseNumber(const char* s, int base, uint32_t* value, char** end)
+{
+  if (!isxdigit((unsigned char)*s)) {
+    return false;
+  }
+  unsigned long parsed = strtoul(s, end, base);
+  if (parsed > UINT32_MAX) {
+    return false;
+  }
+  *value = (uint32_t)parsed;
+  return true;
+}
+
+static uint8_t CanLog_Tokenize(char* line, char* tokens[])
+{
+  uint8_t n = 0;
+  char* save = NULL;
+  char* token = strtok_r(line, " \t\r\n", &save);
+  while (NULL != token && n < CANLOG_MAX_TOKENS) {
+    tokens[n++] = token;
+    token = strtok_r(NULL, " \t\r\n", &save);
+  }
+  return n;
+}
+
+static uint8_t CanLog_InterfaceBus(const CanLog_Reader_T* reader, const char* name)
+{
+  uint8_t i;
+  for (i = 0; i < reader->numInterfaces; ++i) {
+    if (0 == strcmp(reader->interfaces[i].name, name)) {
+      return reader->interfaces[i].bus;
+    }
+  }
+
+  // canN is bus N, as written by comm/canRecorder
+  if (0 == strncmp(name, "can", 3) && isdigit((unsigned char)name[3]) && '\0' == name[4]) {
+    uint8_t bus = (uint8_t)(name[3] - '0');
+    if (bus >= 1U && bus <= CANLOG_NUM_BUSES) {
+      return bus;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief (seconds) interface id#data
+ */
+static bool CanLog_ParseCandump(CanLog_Reader_T* reader, char* line, CanLog_Frame_T* frame, uint64_t* logNs)
+{
+  char* tokens[CANLOG_MAX_TOKENS];
+  uint8_t n = CanLog_Tokenize(line, tokens);
+  if (n < 3 || '(' != tokens[0][0] || !CanLog_ParseTime(&tokens[0][1], logNs)) {
+    return false;
+  }
+
+  frame->bus = CanLog_InterfaceBus(reader, tokens[1]);
+  if (0 == frame->bus) {
+    return false;
+  }
+
+  char* hash = strchr(tokens[2], '#');
+  if (NULL == hash || hash == tokens[2]) {
+    return false;
+  }
+  size_t idLen = (size_t)(hash - tokens[2]);
+  char* end;
+  if (!CanLog_ParseNumber(tokens[2], 16, &frame->id, &end) || end != hash) {
+    return false;
+  }
+  frame->extended = (idLen > 3U);
+  if ((frame->extended && (frame->id & CANLOG_ERROR_FLAG)) || (!frame->extended && frame->id > 0x7FFU)) {
+    return false;
+  }
+
+  char* data = hash + 1;
+  if ('#' == *data) {
+    // CAN FD
+    return false;
+  }
+
+  frame->remote = ('R' == *data);
+  frame->dlc = 0;
+  if (frame->remote) {
+    if (isdigit((unsigned char)data[1])) {
+      frame->dlc = (uint8_t)(data[1] - '0');
+    }
+    return frame->dlc <= 8U;
+  }
+
+  while ('\0' != *data) {
+    if ('.' == *data) {
+      data++;
+      continue;
+    }
+    if (frame->dlc >= 8U || !CanLog_ParseHexByte(data, &frame->data[frame->dlc])) {
+      return false;
+    }
+    frame->dlc++;
+    data += 2;
+  }
+  return true;
+}
+
+/**
+ * @brief Header settings, then: time channel id[x] Rx|Tx d dlc bytes...
+ */
+static bool CanLog_ParseAsc(CanLog_Reader_T* reader, char* line, CanLog_Frame_T* frame, uint64_t* logNs)
+{
+  char* tokens[CANLOG_MAX_TOKENS];
+  uint8_t n = CanLog_Tokenize(line, tokens);
+  if (n >= 4 && 0 == strcmp(tokens[0], "base") && 0 == strcmp(tokens[2], "timestamps")) {
+    reader->ascDecimal = (0 == strcmp(tokens[1], "dec"));
+    reader->ascRelative = (0 == strcmp(tokens[3], "relative"));
+    return false;
+  }
+
+  uint64_t t;
+  if (n < 5 || !CanLog_ParseTime(tokens[0], &t)) {
+    return false;
+  }
+
+  // Relative times count from the previous event of any kind
+  *logNs = reader->ascRelative ? reader->ascLastNs + t : t;
+  reader->ascLastNs = *logNs;
+
+  char* end;
+  uint32_t channel;
+  if (!CanLog_ParseNumber(tokens[1], 10, &channel, &end) || '\0' != *end ||
+      channel < 1U || channel > CANLOG_NUM_BUSES) {
+    return false;
+  }
+  frame->bus = (uint8_t)channel;
+
+  int base = reader->ascDecimal ? 10 : 16;
+  if (!CanLog_ParseNumber(tokens[2], base, &frame->id, &end)) {
+    return false;
+  }
+  frame->extended = ('x' == *end);
+  if ((frame->extended ? '\0' != end[1] : '\0' != *end) ||
+      (!frame->extended && frame->id > 0x7FFU) || frame->id > 0x1FFFFFFFU) {
+    return false;
+  }
+
+  if (0 != strcmp(tokens[3], "Rx") && 0 != strcmp(tokens[3], "Tx")) {
+    return false;
+  }
+
+  uint32_t dlc = 0;
+  if (0 == strcmp(tokens[4], "r")) {
+    frame->remote = true;
+    if (n > 5 && CanLog_ParseNumber(tokens[5], 16, &dlc, &end) && '\0' == *end && dlc <= 8U) {
+      frame->dlc = (uint8_t)dlc;
+    }
+    return true;
+  }
+  if (0 != strcmp(tokens[4], "d") || n < 6 ||
+      !CanLog_ParseNumber(tokens[5], 16, &dlc, &end) || '\0' != *end || dlc > 8U ||
+      n < 6U + dlc) {
+    return false;
+  }
+
+  frame->remote = false;
+  frame->dlc = (uint8_t)dlc;
+  uint8_t i;
+  for (i = 0; i < frame->dlc; ++i) {
+    uint32_t byte;
+    if (!CanLog_ParseNumber(tokens[6 + i], base, &byte, &end) || '\0' != *end || byte > 0xFFU) {
+      return false;
+    }
+    frame->data[i] = (uint8_t)byte;
+  }
+  return true;
+}
+
+// ------------------- Public methods -------------------
+CanLog_Status_T CanLog_Open(CanLog_Reader_T* reader, const char* path, CanLog_Format_T format)
+{
+  memset(reader, 0, sizeof(CanLog_Reader_T));
+
+  if (CANLOG_FORMAT_AUTO == format) {
+    const char* dot = strrchr(path, '.');
+    format = (NULL != dot && 0 == strcasecmp(dot, ".asc")) ? CANLOG_FORMAT_ASC : CANLOG_FORMAT_CANDUMP;
+  }
+  reader->format = format;
+
+  reader->file = fopen(path, "r");
+  if (NULL == reader->file) {
+    return CANLOG_STATUS_ERROR;
+  }
+  return CANLOG_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CanLog_Status_T CanLog_AddInterface(CanLog_Reader_T* reader, const char* mapping)
+{
+  const char* equals = strchr(mapping, '=');
+  if (NULL == equals || equals == mapping ||
+      (size_t)(equals - mapping) >= CANLOG_MAX_INTERFACE_NAME ||
+      reader->numInterfaces >= CANLOG_MAX_INTERFACES) {
+    return CANLOG_STATUS_ERROR;
+  }
+
+  char* end;
+  unsigned long bus = strtoul(equals + 1, &end, 10);
+  if ('\0' != *end || bus < 1U || bus > CANLOG_NUM_BUSES) {
+    return CANLOG_STATUS_ERROR;
+  }
+
+  CanLog_Interface_T* interface = &reader->interfaces[reader->numInterfaces++];
+  memcpy(interface->name, mapping, (size_t)(equals - mapping));
+  interface->name[equals - mapping] = '\0';
+  interface->bus = (uint8_t)bus;
+  return CANLOG_STATUS_OK;
+}
+
+//------------------------------------------------------------------------------
+CanLog_Status_T CanLog_Next(CanLog_Reader_T* reader, CanLog_Frame_T* frame)
+{
+  char line[CANLOG_MAX_LINE];
+
+  while (NULL != fgets(line, sizeof(line), reader->file)) {
+    reader->line++;
+
+    // Blank lines and comments aren't counted as skipped
+    const char* first = line;
+    while (isspace((unsigned char)*first)) {
+      first++;
+    }
+    if ('\0' == *first || '/' == *first) {
+      continue;
+    }
+
+    memset(frame, 0, sizeof(CanLog_Frame_T));
+    uint64_t logNs = 0;
+    bool parsed = (CANLOG_FORMAT_ASC == reader->format) ?
+        CanLog_ParseAsc(reader, line, frame, &logNs) :
+        CanLog_ParseCandump(reader, line, frame, &logNs);
+    if (!parsed) {
+      reader->skipped++;
+      continue;
+    }
+
+    if (!reader->started) {
+      reader->started = true;
+      reader->firstNs = logNs;
+    }
+    // Out of order lines are replayed at the current time
+    frame->timeNs = (logNs > reader->firstNs) ? logNs - reader->firstNs : 0;
+    return CANLOG_STATUS_OK;
+  }
+
+  return ferror(reader->file) ? CANLOG_STATUS_ERROR : CANLOG_STATUS_END;
+}
+
+//------------------------------------------------------------------------------
+void CanLog_Close(CanLog_Reader_T* reader)
+{
+  if (NULL != reader->file) {
+    fclose(reader->file);
+    reader->file = NULL;
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * canLog.h
+ *
+ * Streaming readers for CAN logs:
+ *  - candump log format, as written by candump -l and comm/canRecorder
+ *      (1436509052.249713) can1 182#0011223344556677
+ *  - Vector ASC, absolute or relative timestamps, hex or decimal base
+ *      0.012345 1  182             Rx   d 8 00 11 22 33 44 55 66 77
+ *
+ * Frames are read one at a time, so logs of any length replay in constant
+ * memory. Times are converted exactly to nanoseconds since the first frame.
+ * CAN FD frames, error frames and events are skipped.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef CANLOG_H_
+#define CANLOG_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CANLOG_MAX_LINE           512U
+#define CANLOG_MAX_INTERFACES     8U
+#define CANLOG_MAX_INTERFACE_NAME 16U
+
+typedef enum
+{
+  CANLOG_STATUS_OK    = 0x00U,
+  CANLOG_STATUS_ERROR = 0x01U,
+  CANLOG_STATUS_END   = 0x02U   /* No more frames */
+} CanLog_Status_T;
+
+typedef enum
+{
+  CANLOG_FORMAT_AUTO    = 0x00U,  /* ASC if the file name ends in .asc */
+  CANLOG_FORMAT_CANDUMP = 0x01U,
+  CANLOG_FORMAT_ASC     = 0x02U
+} CanLog_Format_T;
+
+typedef struct
+{
+  uint64_t timeNs;    /* Since the first frame */
+  uint32_t id;
+  uint8_t bus;        /* 1-3 */
+  uint8_t dlc;
+  bool extended;
+  bool remote;
+  uint8_t data[8];
+} CanLog_Frame_T;
+
+typedef struct
+{
+  char name[CANLOG_MAX_INTERFACE_NAME];
+  uint8_t bus;
+} CanLog_Interface_T;
+
+typedef struct
+{
+  FILE* file;
+  CanLog_Format_T format;
+  uint64_t line;
+  uint64_t skipped;     /* Lines that aren't classic CAN frames on a known bus */
+
+  bool started;
+  uint64_t firstNs;     /* Log time of the first frame */
+
+  // ASC header settings
+  bool ascDecimal;
+  bool ascRelative;
+  uint64_t ascLastNs;
+
+  // candump interface names, beyond the default canN for bus N
+  CanLog_Interface_T interfaces[CANLOG_MAX_INTERFACES];
+  uint8_t numInterfaces;
+} CanLog_Reader_T;
+
+/**
+ * @brief Open a log for reading
+ */
+CanLog_Status_T CanLog_Open(CanLog_Reader_T* reader, const char* path, CanLog_Format_T format);
+
+/**
+ * @brief Map a candump interface name to a bus
+ * @param mapping "name=bus", e.g. "can0=1"
+ */
+CanLog_Status_T CanLog_AddInterface(CanLog_Reader_T* reader, const char* mapping);
+
+/**
+ * @brief Read the next frame
+ * @return CANLOG_STATUS_END at the end of the log
+ */
+CanLog_Status_T CanLog_Next(CanLog_Reader_T* reader, CanLog_Frame_T* frame);
+
+void CanLog_Close(CanLog_Reader_T* reader);
+
+#endif /* CANLOG_H_ */
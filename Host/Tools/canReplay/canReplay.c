@@ -0,0 +1,502 @@
+/*
+ * canReplay.c
+ *
+ * Replays a CAN log into a host build of the Application, on the simulated
+ * clock. Each frame is delivered at its exact log time, with the 1ms ticks
+ * before it run first, so the firmware sees the traffic with the timing it
+ * was recorded with. Idle time is skipped, so logs replay as fast as the
+ * host can run the firmware, or paced at a multiple of real time with -s.
+ *
+ * Per-frame latency is the host time from the RX interrupt delivering the
+ * frame until every task it woke has blocked again.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "canLog.h"
+
+#include "hostSim.h"
+#include "hostCan.h"
+
+#include "lib/logging/logging.h"
+#include "lib/signalDb/signalDb.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "time/cycleCounter/cycleCounter.h"
+#include "time/deferred/deferred.h"
+#include "device/inverter/inverter.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T log;
+
+// Log-linear histogram: 32 buckets per power of two
+#define CANREPLAY_HIST_SUB_BITS   5U
+#define CANREPLAY_HIST_SUB        (1U << CANREPLAY_HIST_SUB_BITS)
+#define CANREPLAY_HIST_BUCKETS    (64U * CANREPLAY_HIST_SUB)
+
+// Per-ID statistics, open addressing
+#define CANREPLAY_MAX_IDS         4096U
+#define CANREPLAY_TOP_IDS         20U
+
+typedef struct
+{
+  const char* logPath;
+  CanLog_Format_T format;
+  double speed;             /* Multiple of real time, 0 for as fast as possible */
+  uint64_t stopNs;          /* 0 for the whole log */
+  const char* txPath;
+  const char* csvPath;
+} CanReplay_Options_T;
+
+typedef struct
+{
+  uint64_t key;             /* bus << 32 | id, 0 if unused */
+  uint64_t frames;
+  uint64_t delivered;
+  uint64_t totalNs;
+  uint64_t maxNs;
+} CanReplay_IdStats_T;
+
+static uint64_t histogram[CANREPLAY_HIST_BUCKETS];
+static uint64_t latencyMinNs = UINT64_MAX;
+static uint64_t latencyMaxNs;
+static uint64_t latencyTotalNs;
+
+static CanReplay_IdStats_T idStats[CANREPLAY_MAX_IDS];
+static uint64_t idsDropped;       /* Frames of IDs beyond CANREPLAY_MAX_IDS */
+
+static uint64_t framesReplayed;
+static uint64_t framesDelivered;
+static uint64_t framesRemote;
+static uint64_t framesSent;
+static FILE* txFile;
+
+static const char* const stateNames[VEHICLESTATE_NUM_STATES] = {
+  [VEHICLESTATE_LV_ON]          = "LV_ON",
+  [VEHICLESTATE_PRECHARGE]      = "PRECHARGE",
+  [VEHICLESTATE_READY_TO_DRIVE] = "READY_TO_DRIVE",
+  [VEHICLESTATE_DRIVE]          = "DRIVE",
+  [VEHICLESTATE_FAULT]          = "FAULT",
+};
+
+// ------------------- Private methods -------------------
+static uint64_t CanReplay_WallNs(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t CanReplay_Bucket(uint64_t ns)
+{
+  if (ns < CANREPLAY_HIST_SUB) {
+    return (uint32_t)ns;
+  }
+  uint32_t msb = 63U - (uint32_t)__builtin_clzll(ns);
+  uint32_t sub = (uint32_t)(ns >> (msb - CANREPLAY_HIST_SUB_BITS)) & (CANREPLAY_HIST_SUB - 1U);
+  return (msb - CANREPLAY_HIST_SUB_BITS + 1U) * CANREPLAY_HIST_SUB + sub;
+}
+
+/**
+ * @brief Lowest latency that falls in a bucket
+ */
+static uint64_t CanReplay_BucketValue(uint32_t bucket)
+{
+  if (bucket < CANREPLAY_HIST_SUB) {
+    return bucket;
+  }
+  uint32_t msb = bucket / CANREPLAY_HIST_SUB + CANREPLAY_HIST_SUB_BITS - 1U;
+  uint64_t sub = bucket % CANREPLAY_HIST_SUB;
+  return (CANREPLAY_HIST_SUB + sub) << (msb - CANREPLAY_HIST_SUB_BITS);
+}
+
+static uint64_t CanReplay_Percentile(double fraction)
+{
+  uint64_t target = (uint64_t)(fraction * (double)framesDelivered);
+  uint64_t seen = 0;
+  uint32_t i;
+  for (i = 0; i < CANREPLAY_HIST_BUCKETS; ++i) {
+    seen += histogram[i];
+    if (seen > target) {
+      return CanReplay_BucketValue(i);
+    }
+  }
+  return latencyMaxNs;
+}
+
+static CanReplay_IdStats_T* CanReplay_FindId(uint8_t bus, uint32_t id)
+{
+  uint64_t key = ((uint64_t)bus << 32) | id;
+  uint32_t slot = (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 52) % CANREPLAY_MAX_IDS;
+  uint32_t probes;
+  for (probes = 0; probes < CANREPLAY_MAX_IDS; ++probes) {
+    CanReplay_IdStats_T* entry = &idStats[slot];
+    if (entry->key == key) {
+      return entry;
+    }
+    if (0 == entry->key) {
+      entry->key = key;
+      return entry;
+    }
+    slot = (slot + 1U) % CANREPLAY_MAX_IDS;
+  }
+  return NULL;
+}
+
+static void CanReplay_Record(const CanLog_Frame_T* frame, bool delivered, uint64_t latencyNs)
+{
+  CanReplay_IdStats_T* entry = CanReplay_FindId(frame->bus, frame->id);
+  if (NULL == entry) {
+    idsDropped++;
+  } else {
+    entry->frames++;
+  }
+  if (!delivered) {
+    return;
+  }
+
+  framesDelivered++;
+  histogram[CanReplay_Bucket(latencyNs)]++;
+  latencyTotalNs += latencyNs;
+  if (latencyNs < latencyMinNs) {
+    latencyMinNs = latencyNs;
+  }
+  if (latencyNs > latencyMaxNs) {
+    latencyMaxNs = latencyNs;
+  }
+
+  if (NULL != entry) {
+    entry->delivered++;
+    entry->totalNs += latencyNs;
+    if (latencyNs > entry->maxNs) {
+      entry->maxNs = latencyNs;
+    }
+  }
+}
+
+static int CanReplay_CompareTotal(const void* a, const void* b)
+{
+  const CanReplay_IdStats_T* x = a;
+  const CanReplay_IdStats_T* y = b;
+  if (x->totalNs != y->totalNs) {
+    return (x->totalNs < y->totalNs) ? 1 : -1;
+  }
+  return (x->frames < y->frames) ? 1 : (x->frames > y->frames) ? -1 : 0;
+}
+
+static void CanReplay_WriteFrame(FILE* file, uint64_t timeNs, uint8_t bus, uint32_t id,
+                                 const uint8_t* data, uint8_t dlc)
+{
+  fprintf(file, "(%llu.%06llu) can%u ", (unsigned long long)(timeNs / 1000000000U),
+      (unsigned long long)((timeNs % 1000000000U) / 1000U), bus);
+  fprintf(file, (id > 0x7FFU) ? "%08X#" : "%03X#", id);
+  uint8_t i;
+  for (i = 0; i < dlc; ++i) {
+    fprintf(file, "%02X", data[i]);
+  }
+  fputc('\n', file);
+}
+
+/**
+ * @brief Frames the firmware sends. Recorded as the TX complete callback does.
+ */
+static void CanReplay_Tx(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc)
+{
+  framesSent++;
+  CanRecorder_TxComplete(HostCan_GetHandle(bus), 0);
+  if (NULL != txFile) {
+    CanReplay_WriteFrame(txFile, HostSim_GetTimeNs(), bus, id, data, dlc);
+  }
+}
+
+static void CanReplay_Rx(CAN_HandleTypeDef* hcan)
+{
+  CanRecorder_RxPending(hcan, CAN_RX_FIFO0);
+}
+
+/**
+ * @brief Stands in for the pedals process, which samples the ADC rather than
+ * the bus: released pedals, no faults, published every period.
+ */
+static void CanReplay_Tick(uint64_t timeNs)
+{
+  if (0 != (timeNs / HOSTSIM_TICK_NS) % PEDALS_PERIOD_MS) {
+    return;
+  }
+
+  uint32_t now = CycleCounter_Get();
+  SignalDb_Set(MAPPING_SIGNAL_APPS_POSITION, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_BRAKE_POSITION, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_BRAKE_PRESSED, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_TORQUE_REQUEST, 0.0f, true, now);
+  SignalDb_Set(MAPPING_SIGNAL_PEDAL_FAULTS, (float)PEDALS_FAULT_NONE, true, now);
+  SignalDb_Publish(MAPPING_SIGNAL_GROUP_PEDALS);
+}
+
+/**
+ * @brief The CAN facing modules, in the order initialize.c starts them
+ */
+static bool CanReplay_InitFirmware(void)
+{
+  Log_Init(&log);
+
+  if (DEFERRED_STATUS_OK != Deferred_Init(&log)) {
+    return false;
+  }
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  if (SIGNALDB_STATUS_OK != SignalDb_Init(&log, signalGroups, numSignalGroups)) {
+    return false;
+  }
+
+  if (CANMONITOR_STATUS_OK != CanMonitor_Init(&log) ||
+      CANRECORDER_STATUS_OK != CanRecorder_Init(&log) ||
+      INVERTER_STATUS_OK != Inverter_Init(&log, &hcan1) ||
+      VEHICLESTATE_STATUS_OK != VehicleState_Init(&log, &hcan1)) {
+    return false;
+  }
+  return true;
+}
+
+static void CanReplay_Usage(const char* name)
+{
+  fprintf(stderr,
+      "usage: %s [options] log\n"
+      "  -f candump|asc   log format, from the file name by default\n"
+      "  -i name=bus      map a candump interface to bus 1-3, canN is bus N\n"
+      "  -s factor        pace at a multiple of real time, as fast as possible by default\n"
+      "  -t seconds       stop at this log time\n"
+      "  -o file          write the frames the firmware sends, candump format\n"
+      "  -c file          write per-frame latency, CSV\n"
+      "  -v               firmware log to stderr\n",
+      name);
+}
+
+static void CanReplay_Summary(const CanLog_Reader_T* reader, uint64_t logNs, uint64_t wallNs)
+{
+  double logS = (double)logNs / 1e9;
+  double wallS = (double)wallNs / 1e9;
+  printf("Replayed %llu frames over %.3f s of log in %.3f s (%.0fx real time)\n",
+      (unsigned long long)framesReplayed, logS, wallS, (wallS > 0.0) ? logS / wallS : 0.0);
+  printf("  delivered %llu, filtered %llu, remote %llu, lines skipped %llu\n",
+      (unsigned long long)framesDelivered,
+      (unsigned long long)(framesReplayed - framesDelivered - framesRemote),
+      (unsigned long long)framesRemote, (unsigned long long)reader->skipped);
+
+  if (framesDelivered > 0) {
+    printf("Frame latency (ns): min %llu mean %llu p50 %llu p99 %llu p99.9 %llu max %llu\n",
+        (unsigned long long)latencyMinNs,
+        (unsigned long long)(latencyTotalNs / framesDelivered),
+        (unsigned long long)CanReplay_Percentile(0.5),
+        (unsigned long long)CanReplay_Percentile(0.99),
+        (unsigned long long)CanReplay_Percentile(0.999),
+        (unsigned long long)latencyMaxNs);
+  }
+
+  // Busiest IDs by total processing time
+  static CanReplay_IdStats_T sorted[CANREPLAY_MAX_IDS];
+  uint32_t numIds = 0;
+  uint32_t i;
+  for (i = 0; i < CANREPLAY_MAX_IDS; ++i) {
+    if (0 != idStats[i].key) {
+      sorted[numIds++] = idStats[i];
+    }
+  }
+  qsort(sorted, numIds, sizeof(CanReplay_IdStats_T), CanReplay_CompareTotal);
+
+  printf("%-4s %-9s %10s %10s %12s %12s\n", "bus", "id", "frames", "delivered", "mean ns", "max ns");
+  for (i = 0; i < numIds && i < CANREPLAY_TOP_IDS; ++i) {
+    const CanReplay_IdStats_T* entry = &sorted[i];
+    printf("%-4u %-9X %10llu %10llu %12llu %12llu\n",
+        (unsigned)(entry->key >> 32), (unsigned)(entry->key & 0xFFFFFFFFU),
+        (unsigned long long)entry->frames, (unsigned long long)entry->delivered,
+        (unsigned long long)((entry->delivered > 0) ? entry->totalNs / entry->delivered : 0),
+        (unsigned long long)entry->maxNs);
+  }
+  if (numIds > CANREPLAY_TOP_IDS) {
+    printf("  and %u more IDs\n", (unsigned)(numIds - CANREPLAY_TOP_IDS));
+  }
+  if (idsDropped > 0) {
+    printf("  %llu frames of IDs beyond the first %u not counted per ID\n",
+        (unsigned long long)idsDropped, CANREPLAY_MAX_IDS);
+  }
+
+  Inverter_Stats_T inverter;
+  Inverter_GetStats(&inverter);
+  CanRecorder_Stats_T recorder;
+  CanRecorder_GetStats(&recorder);
+  VehicleState_Stats_T vehicleState;
+  VehicleState_GetStats(&vehicleState);
+
+  printf("Firmware sent %llu frames\n", (unsigned long long)framesSent);
+  printf("Inverter: status %lu, counter errors %lu, checksum errors %lu, command timeouts %lu\n",
+      (unsigned long)inverter.statusReceived, (unsigned long)inverter.statusCounterErrors,
+      (unsigned long)inverter.statusChecksumErrors, (unsigned long)inverter.commandTimeouts);
+  printf("CanRecorder: state %u, recorded %lu\n", recorder.state, (unsigned long)recorder.recorded);
+  printf("Vehicle state: %s, transitions %lu\n",
+      stateNames[VehicleState_Get()], (unsigned long)vehicleState.transitions);
+}
+
+// ------------------- Main -------------------
+int main(int argc, char* argv[])
+{
+  CanReplay_Options_T options = { 0 };
+  CanLog_Reader_T reader;
+  const char* interfaces[CANLOG_MAX_INTERFACES];
+  uint8_t numInterfaces = 0;
+
+  int opt;
+  while (-1 != (opt = getopt(argc, argv, "f:i:s:t:o:c:v"))) {
+    switch (opt) {
+      case 'f':
+        if (0 == strcmp(optarg, "candump")) {
+          options.format = CANLOG_FORMAT_CANDUMP;
+        } else if (0 == strcmp(optarg, "asc")) {
+          options.format = CANLOG_FORMAT_ASC;
+        } else {
+          CanReplay_Usage(argv[0]);
+          return 1;
+        }
+        break;
+      case 'i':
+        if (numInterfaces >= CANLOG_MAX_INTERFACES) {
+          fprintf(stderr, "Too many interfaces\n");
+          return 1;
+        }
+        interfaces[numInterfaces++] = optarg;
+        break;
+      case 's':
+        options.speed = atof(optarg);
+        break;
+      case 't':
+        options.stopNs = (uint64_t)(atof(optarg) * 1e9);
+        break;
+      case 'o':
+        options.txPath = optarg;
+        break;
+      case 'c':
+        options.csvPath = optarg;
+        break;
+      case 'v':
+        log.enableLogToStderr = true;
+        break;
+      default:
+        CanReplay_Usage(argv[0]);
+        return 1;
+    }
+  }
+  if (optind != argc - 1) {
+    CanReplay_Usage(argv[0]);
+    return 1;
+  }
+  options.logPath = argv[optind];
+
+  if (CANLOG_STATUS_OK != CanLog_Open(&reader, options.logPath, options.format)) {
+    fprintf(stderr, "Can't open %s\n", options.logPath);
+    return 1;
+  }
+  uint8_t i;
+  for (i = 0; i < numInterfaces; ++i) {
+    if (CANLOG_STATUS_OK != CanLog_AddInterface(&reader, interfaces[i])) {
+      fprintf(stderr, "Bad interface mapping %s\n", interfaces[i]);
+      return 1;
+    }
+  }
+
+  FILE* csvFile = NULL;
+  if (NULL != options.txPath && NULL == (txFile = fopen(options.txPath, "w"))) {
+    fprintf(stderr, "Can't write %s\n", options.txPath);
+    return 1;
+  }
+  if (NULL != options.csvPath) {
+    csvFile = fopen(options.csvPath, "w");
+    if (NULL == csvFile) {
+      fprintf(stderr, "Can't write %s\n", options.csvPath);
+      return 1;
+    }
+    fprintf(csvFile, "time_s,bus,id,dlc,delivered,latency_ns\n");
+  }
+
+  if (!CanReplay_InitFirmware()) {
+    fprintf(stderr, "Firmware initialization failed\n");
+    return 1;
+  }
+  HostCan_SetRxHook(CanReplay_Rx);
+  HostCan_SetTxHook(CanReplay_Tx);
+  HostSim_SetTickHook(CanReplay_Tick);
+  HostSim_Start();
+
+  uint64_t wallStart = CanReplay_WallNs();
+  uint64_t logNs = 0;
+  CanLog_Frame_T frame;
+  CanLog_Status_T status;
+  while (CANLOG_STATUS_OK == (status = CanLog_Next(&reader, &frame))) {
+    if (0 != options.stopNs && frame.timeNs > options.stopNs) {
+      break;
+    }
+
+    if (options.speed > 0.0) {
+      uint64_t due = wallStart + (uint64_t)((double)frame.timeNs / options.speed);
+      uint64_t now = CanReplay_WallNs();
+      if (due > now) {
+        struct timespec wait = { (time_t)((due - now) / 1000000000U), (long)((due - now) % 1000000000U) };
+        nanosleep(&wait, NULL);
+      }
+    }
+
+    // Earlier log lines out of order are delivered now
+    if (frame.timeNs > logNs) {
+      logNs = frame.timeNs;
+    }
+    HostSim_AdvanceTo(logNs);
+    framesReplayed++;
+
+    // The System library only delivers data frames
+    if (frame.remote) {
+      framesRemote++;
+      CanReplay_Record(&frame, false, 0);
+      continue;
+    }
+
+    uint64_t start = CanReplay_WallNs();
+    HostSim_EnterIsr();
+    bool delivered = HostCan_Receive(frame.bus, frame.id, frame.data, frame.dlc);
+    HostSim_ExitIsr();
+    HostSim_RunUntilIdle();
+    uint64_t latencyNs = CanReplay_WallNs() - start;
+
+    CanReplay_Record(&frame, delivered, latencyNs);
+    if (NULL != csvFile) {
+      fprintf(csvFile, "%llu.%06llu,%u,%X,%u,%u,%llu\n",
+          (unsigned long long)(logNs / 1000000000U), (unsigned long long)((logNs % 1000000000U) / 1000U),
+          frame.bus, frame.id, frame.dlc, delivered ? 1U : 0U,
+          delivered ? (unsigned long long)latencyNs : 0ULL);
+    }
+  }
+  uint64_t wallNs = CanReplay_WallNs() - wallStart;
+
+  if (CANLOG_STATUS_ERROR == status) {
+    fprintf(stderr, "Error reading %s at line %llu\n", options.logPath, (unsigned long long)reader.line);
+  }
+  CanLog_Close(&reader);
+  if (NULL != txFile) {
+    fclose(txFile);
+  }
+  if (NULL != csvFile) {
+    fclose(csvFile);
+  }
+
+  CanReplay_Summary(&reader, logNs, wallNs);
+  return (CANLOG_STATUS_ERROR == status) ? 1 : 0;
+}
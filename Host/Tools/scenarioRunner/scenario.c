@@ -0,0 +1,668 @@
+/*
+ * scenario.c
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include "scenario.h"
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "hostSim.h"
+#include "hostCan.h"
+
+#include "lib/logging/logging.h"
+#include "lib/paramStore/paramStore.h"
+#include "lib/signalDb/signalDb.h"
+#include "lib/vehicleModel/vehicleModel.h"
+#include "io/adc/adc.h"
+#include "comm/canMonitor/canMonitor.h"
+#include "comm/canRecorder/canRecorder.h"
+#include "comm/gateway/gateway.h"
+#include "time/deferred/deferred.h"
+#include "device/analog/analog.h"
+#include "device/inverter/inverter.h"
+#include "device/wheelspeed/wheelspeed.h"
+#include "vehicleProcesses/pedals/pedals.h"
+#include "vehicleProcesses/tractionControl/tractionControl.h"
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+#include "vehicleInterface/analogMapping/analogMapping.h"
+#include "vehicleInterface/deviceMapping/deviceMapping.h"
+#include "vehicleInterface/gatewayMapping/gatewayMapping.h"
+#include "vehicleInterface/paramMapping/paramMapping.h"
+#include "vehicleInterface/signalMapping/signalMapping.h"
+
+// ------------------- Private data -------------------
+static Logging_T firmwareLog;
+
+#define SCENARIO_STEP_NS          HOSTSIM_TICK_NS
+#define SCENARIO_STEP_S           0.001f
+
+// Driver script, s
+#define SCENARIO_HV_TIME          0.1
+#define SCENARIO_START_TIME       2.0
+#define SCENARIO_START_HOLD       0.5
+#define SCENARIO_START_BRAKE      0.5f
+#define SCENARIO_LAUNCH_TIME      3.0
+#define SCENARIO_LAUNCH_RAMP      0.1
+#define SCENARIO_LAUNCH_HOLD      3.0
+#define SCENARIO_STOP_BRAKE       0.4f
+#define SCENARIO_LAUNCH_SPEED     15.0f   /* m/s, end of the timed launch */
+
+// Pedal sensors, as the pedals calibration expects
+#define SCENARIO_PEDAL_RAW_LOW    400.0f
+#define SCENARIO_PEDAL_RAW_HIGH   3600.0f
+
+// Bus: 8 byte frame at 500kbit/s, with stuffing
+#define SCENARIO_FRAME_US         230.0f
+
+// BMS pack frame on the chassis bus, routed to the inverter by gatewayMapping
+#define SCENARIO_BMS_CAN_ID       0x6B0U
+#define SCENARIO_BMS_PERIOD_MS    10U
+
+// A command later than this after the previous one missed its period
+#define SCENARIO_COMMAND_DEADLINE_NS  (2U * INVERTER_PERIOD_MS * HOSTSIM_TICK_NS)
+
+#define SCENARIO_MAX_EVENTS       4096U
+
+typedef enum
+{
+  SCENARIO_EVENT_PULSE,         /* Tone wheel pulse to the EXTI handler */
+  SCENARIO_EVENT_RX,            /* Frame to the firmware */
+  SCENARIO_EVENT_COMMAND        /* Command frame to the simulated inverter */
+} Scenario_EventType_T;
+
+typedef struct
+{
+  uint64_t timeNs;
+  uint32_t sequence;            /* Orders events at the same time */
+  Scenario_EventType_T type;
+  uint8_t bus;                  /* Of a frame to the firmware */
+  uint32_t id;                  /* CAN ID, or wheel */
+  uint8_t data[8];
+} Scenario_Event_T;
+
+typedef enum
+{
+  SCENARIO_STREAM_DASH,
+  SCENARIO_STREAM_STATUS,
+  SCENARIO_STREAM_COMMAND,
+  SCENARIO_STREAM_BMS,
+  SCENARIO_NUM_STREAMS
+} Scenario_Stream_T;
+
+/* Sensor error: raw = nominal * (1 + gain) + offset */
+typedef struct
+{
+  float gain;
+  float offset;
+} Scenario_SensorCal_T;
+
+// Event queue, a binary heap on time
+static Scenario_Event_T events[SCENARIO_MAX_EVENTS];
+static uint32_t numEvents;
+static uint32_t eventSequence;
+static uint32_t eventsDropped;
+
+static uint32_t randomState;
+static const Scenario_Config_T* config;
+static Scenario_Result_T* result;
+
+static Scenario_SensorCal_T apps1Cal;
+static Scenario_SensorCal_T apps2Cal;
+static Scenario_SensorCal_T brakeCal;
+
+// Simulated inverter
+static float commandTorque;
+static bool commandEnable;
+static bool commandReceived;
+static uint64_t lastCommandNs;
+static uint8_t statusCounter;
+
+// Simulated BMS, and the frame the gateway should forward
+static uint8_t bmsCounter;
+static uint8_t bmsData[8];
+
+static uint64_t lastArrivalNs[SCENARIO_NUM_STREAMS];
+
+static const uint16_t wheelPins[VEHICLEMODEL_NUM_WHEELS] = {
+  WHEELSPEED_FL_Pin, WHEELSPEED_FR_Pin, WHEELSPEED_RL_Pin, WHEELSPEED_RR_Pin
+};
+
+// ------------------- Private methods -------------------
+static uint32_t Scenario_Random(void)
+{
+  // xorshift32
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+/**
+ * @brief Uniform in [lo, hi)
+ */
+static float Scenario_Uniform(float lo, float hi)
+{
+  return lo + (hi - lo) * (float)(Scenario_Random() >> 8) / 16777216.0f;
+}
+
+static float Scenario_Gaussian(float sigma)
+{
+  float u1 = Scenario_Uniform(1e-7f, 1.0f);
+  float u2 = Scenario_Uniform(0.0f, 1.0f);
+  return sigma * sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+static void Scenario_Push(const Scenario_Event_T* event)
+{
+  if (numEvents >= SCENARIO_MAX_EVENTS) {
+    eventsDropped++;
+    return;
+  }
+
+  uint32_t i = numEvents++;
+  events[i] = *event;
+  events[i].sequence = eventSequence++;
+  while (i > 0) {
+    uint32_t parent = (i - 1U) / 2U;
+    const Scenario_Event_T* a = &events[i];
+    const Scenario_Event_T* b = &events[parent];
+    if (b->timeNs < a->timeNs || (b->timeNs == a->timeNs && b->sequence < a->sequence)) {
+      break;
+    }
+    Scenario_Event_T swap = events[i];
+    events[i] = events[parent];
+    events[parent] = swap;
+    i = parent;
+  }
+}
+
+static bool Scenario_Earlier(uint32_t a, uint32_t b)
+{
+  return events[a].timeNs < events[b].timeNs ||
+         (events[a].timeNs == events[b].timeNs && events[a].sequence < events[b].sequence);
+}
+
+static void Scenario_Pop(Scenario_Event_T* event)
+{
+  *event = events[0];
+  events[0] = events[--numEvents];
+
+  uint32_t i = 0;
+  while (1) {
+    uint32_t left = 2U * i + 1U;
+    uint32_t right = left + 1U;
+    uint32_t smallest = i;
+    if (left < numEvents && Scenario_Earlier(left, smallest)) {
+      smallest = left;
+    }
+    if (right < numEvents && Scenario_Earlier(right, smallest)) {
+      smallest = right;
+    }
+    if (smallest == i) {
+      break;
+    }
+    Scenario_Event_T swap = events[i];
+    events[i] = events[smallest];
+    events[smallest] = swap;
+    i = smallest;
+  }
+}
+
+/**
+ * @brief Time a frame sent now arrives. Frames of a stream stay in order.
+ */
+static uint64_t Scenario_Arrival(Scenario_Stream_T stream)
+{
+  float delayUs = SCENARIO_FRAME_US + Scenario_Uniform(0.0f, result->busJitterUs);
+  if (Scenario_Uniform(0.0f, 1.0f) < result->burstProbability) {
+    delayUs += Scenario_Uniform(0.0f, config->maxBurstMs * 1000.0f);
+  }
+
+  uint64_t arrival = HostSim_GetTimeNs() + (uint64_t)(delayUs * 1000.0f);
+  if (arrival <= lastArrivalNs[stream]) {
+    arrival = lastArrivalNs[stream] + 1U;
+  }
+  lastArrivalNs[stream] = arrival;
+  return arrival;
+}
+
+static uint8_t Scenario_Checksum(const uint8_t* data)
+{
+  uint8_t sum = 0;
+  uint8_t i;
+  for (i = 0; i < 7U; ++i) {
+    sum += data[i];
+  }
+  return (uint8_t)~sum;
+}
+
+static int16_t Scenario_ToInt16(float value)
+{
+  if (value > 32767.0f) {
+    return INT16_MAX;
+  } else if (value < -32768.0f) {
+    return INT16_MIN;
+  }
+  return (int16_t)lrintf(value);
+}
+
+static void Scenario_SendRx(Scenario_Stream_T stream, uint8_t bus, uint32_t id, const uint8_t* data)
+{
+  Scenario_Event_T event = { 0 };
+  event.timeNs = Scenario_Arrival(stream);
+  event.type = SCENARIO_EVENT_RX;
+  event.bus = bus;
+  event.id = id;
+  memcpy(event.data, data, 8);
+  Scenario_Push(&event);
+}
+
+static void Scenario_SendDash(bool hvRequest, bool startRequest)
+{
+  uint8_t data[8] = { 0 };
+  data[0] = (hvRequest ? 0x01U : 0x00U) | (startRequest ? 0x02U : 0x00U);
+  Scenario_SendRx(SCENARIO_STREAM_DASH, 1U, VEHICLESTATE_CAN_ID_DASH, data);
+}
+
+static void Scenario_SendStatus(const VehicleModel_Output_T* output)
+{
+  int16_t speed = Scenario_ToInt16(output->motorSpeedRpm);
+  int16_t torque = Scenario_ToInt16(output->motorTorque * 10.0f);
+  uint16_t voltage = (uint16_t)lrintf(output->dcVoltage * 10.0f);
+  uint8_t state = commandEnable ? 1U : 0U;
+
+  uint8_t data[8] = { 0 };
+  data[0] = speed & 0xFF;
+  data[1] = (speed >> 8) & 0xFF;
+  data[2] = torque & 0xFF;
+  data[3] = (torque >> 8) & 0xFF;
+  data[4] = voltage & 0xFF;
+  data[5] = (voltage >> 8) & 0xFF;
+  data[6] = (uint8_t)((statusCounter & 0x0FU) | (state << 4));
+  data[7] = Scenario_Checksum(data);
+  statusCounter++;
+
+  Scenario_SendRx(SCENARIO_STREAM_STATUS, 1U, INVERTER_CAN_ID_STATUS, data);
+}
+
+/**
+ * @brief The BMS's pack voltage, current and state of charge, on the
+ * chassis bus
+ */
+static void Scenario_SendBms(const VehicleModel_Output_T* output, const VehicleModel_Params_T* params)
+{
+  float openCircuit = params->packVoltageEmpty +
+                      (params->packVoltageFull - params->packVoltageEmpty) * output->stateOfCharge;
+  uint16_t voltage = (uint16_t)lrintf((openCircuit - output->dcCurrent * params->packResistance) * 10.0f);
+  int16_t current = Scenario_ToInt16(output->dcCurrent * 10.0f);
+
+  uint8_t data[8] = { 0 };
+  data[0] = voltage & 0xFF;
+  data[1] = (voltage >> 8) & 0xFF;
+  data[2] = current & 0xFF;
+  data[3] = (current >> 8) & 0xFF;
+  data[4] = (uint8_t)lrintf(output->stateOfCharge * 200.0f);   /* 0.5% */
+  data[6] = bmsCounter & 0x0FU;
+  data[7] = Scenario_Checksum(data);
+  bmsCounter++;
+
+  Scenario_SendRx(SCENARIO_STREAM_BMS, 2U, SCENARIO_BMS_CAN_ID, data);
+}
+
+/**
+ * @brief The simulated inverter taking a command off the bus
+ */
+static void Scenario_ReceiveCommand(const Scenario_Event_T* event)
+{
+  uint64_t now = event->timeNs;
+  if (commandReceived) {
+    uint64_t gap = now - lastCommandNs;
+    if (gap > SCENARIO_COMMAND_DEADLINE_NS) {
+      result->commandGapMisses++;
+    }
+    if (gap / 1000U > result->commandGapMaxUs) {
+      result->commandGapMaxUs = (uint32_t)(gap / 1000U);
+    }
+  }
+  commandReceived = true;
+  lastCommandNs = now;
+
+  if (Scenario_Checksum(event->data) != event->data[7]) {
+    return;
+  }
+  commandTorque = 0.1f * (float)(int16_t)(event->data[0] | (event->data[1] << 8));
+  commandEnable = (event->data[4] & 0x01U) != 0;
+}
+
+static void Scenario_Deliver(const Scenario_Event_T* event)
+{
+  HostSim_AdvanceTo(event->timeNs);
+
+  switch (event->type) {
+    case SCENARIO_EVENT_PULSE:
+      HostSim_EnterIsr();
+      WheelSpeed_EXTI_Callback(wheelPins[event->id]);
+      HostSim_ExitIsr();
+      HostSim_RunUntilIdle();
+      break;
+    case SCENARIO_EVENT_RX:
+      if (SCENARIO_BMS_CAN_ID == event->id) {
+        memcpy(bmsData, event->data, sizeof(bmsData));
+        result->bmsFrames++;
+      }
+      HostSim_EnterIsr();
+      (void)HostCan_Receive(event->bus, event->id, event->data, 8);
+      HostSim_ExitIsr();
+      HostSim_RunUntilIdle();
+      break;
+    case SCENARIO_EVENT_COMMAND:
+      Scenario_ReceiveCommand(event);
+      break;
+  }
+}
+
+/**
+ * @brief Frames the firmware sends
+ */
+static void Scenario_Tx(uint8_t bus, uint32_t id, const uint8_t* data, uint8_t dlc)
+{
+  CanRecorder_TxComplete(HostCan_GetHandle(bus), 0);
+  if (1U == bus && SCENARIO_BMS_CAN_ID == id) {
+    // Forwarded by the gateway while the frame is being received
+    if (8U == dlc && 0 == memcmp(data, bmsData, sizeof(bmsData))) {
+      result->bmsForwarded++;
+    }
+    return;
+  }
+  if (1U != bus || INVERTER_CAN_ID_COMMAND != id || dlc < 8U) {
+    return;
+  }
+
+  Scenario_Event_T event = { 0 };
+  event.timeNs = Scenario_Arrival(SCENARIO_STREAM_COMMAND);
+  event.type = SCENARIO_EVENT_COMMAND;
+  event.id = id;
+  memcpy(event.data, data, 8);
+  Scenario_Push(&event);
+}
+
+static void Scenario_Rx(CAN_HandleTypeDef* hcan)
+{
+  CanRecorder_RxPending(hcan, CAN_RX_FIFO0);
+}
+
+static void Scenario_RxFifo1(CAN_HandleTypeDef* hcan)
+{
+  CanRecorder_RxPending(hcan, CAN_RX_FIFO1);
+  Gateway_RxFifo1Callback(hcan);
+}
+
+static uint16_t Scenario_SensorRaw(const Scenario_SensorCal_T* cal, float nominal)
+{
+  float raw = nominal * (1.0f + cal->gain) + cal->offset + Scenario_Gaussian(result->adcNoise);
+  if (raw < 0.0f) {
+    raw = 0.0f;
+  } else if (raw > (float)ANALOG_FULL_SCALE) {
+    raw = (float)ANALOG_FULL_SCALE;
+  }
+  return (uint16_t)lrintf(raw);
+}
+
+/**
+ * @brief Pedal positions to the ADC, for the next conversion
+ */
+static void Scenario_SetPedals(float throttle, float brake)
+{
+  const float span = SCENARIO_PEDAL_RAW_HIGH - SCENARIO_PEDAL_RAW_LOW;
+  HostAdc_Set(MAPPING_ADC_APPS1, Scenario_SensorRaw(&apps1Cal, SCENARIO_PEDAL_RAW_LOW + span * throttle));
+  HostAdc_Set(MAPPING_ADC_APPS2, Scenario_SensorRaw(&apps2Cal, SCENARIO_PEDAL_RAW_HIGH - span * throttle));
+  HostAdc_Set(MAPPING_ADC_BRAKE, Scenario_SensorRaw(&brakeCal, SCENARIO_PEDAL_RAW_LOW + span * brake));
+}
+
+/**
+ * @brief Schedules the tone wheel pulses of a step, as each wheel passes
+ * its teeth, assuming a constant speed over the step
+ */
+static void Scenario_SchedulePulses(double* phase, const VehicleModel_Output_T* output,
+                                    const VehicleModel_Params_T* params, uint64_t stepStartNs)
+{
+  const float pulsesPerMetre = (float)params->toneWheelTeeth / (2.0f * (float)M_PI * params->wheelRadius);
+
+  uint8_t w;
+  for (w = 0; w < VEHICLEMODEL_NUM_WHEELS; ++w) {
+    float speed = fabsf(output->wheelSpeed[w]);
+    double start = phase[w];
+    double end = start + (double)(speed * pulsesPerMetre * SCENARIO_STEP_S);
+    double tooth;
+    for (tooth = floor(start) + 1.0; tooth <= end; tooth += 1.0) {
+      double fraction = (tooth - start) / (end - start);
+      double jitterNs = (double)Scenario_Uniform(-result->pulseJitterUs, result->pulseJitterUs) * 1000.0;
+      double at = fraction * (double)SCENARIO_STEP_NS + jitterNs;
+      if (at < 1.0) {
+        at = 1.0;
+      } else if (at > (double)SCENARIO_STEP_NS) {
+        at = (double)SCENARIO_STEP_NS;
+      }
+
+      Scenario_Event_T event = { 0 };
+      event.timeNs = stepStartNs + (uint64_t)at;
+      event.type = SCENARIO_EVENT_PULSE;
+      event.id = w;
+      Scenario_Push(&event);
+    }
+    phase[w] = end;
+  }
+}
+
+/**
+ * @brief The firmware modules of the torque path and the gateway, in the
+ * order initialize.c starts them
+ */
+static bool Scenario_InitFirmware(void)
+{
+  Log_Init(&firmwareLog);
+
+  uint8_t numSignalGroups;
+  const SignalDb_GroupConfig_T* signalGroups = Mapping_GetSignalGroups(&numSignalGroups);
+  uint8_t numAnalogChannels;
+  const Analog_ChannelConfig_T* analogChannels = Mapping_GetAnalogChannels(&numAnalogChannels);
+  uint8_t numAnalogBiases;
+  const Analog_BiasConfig_T* analogBiases = Mapping_GetAnalogBiases(&numAnalogBiases);
+
+  return PARAMSTORE_STATUS_OK == ParamStore_Init(&firmwareLog, Mapping_GetParamDefaults(), MAPPING_PARAM_NUM_PARAMS) &&
+         ADC_STATUS_OK == ADC_Init(&firmwareLog, MAPPING_ADC_NUM_CHANNELS, 16) &&
+         DEFERRED_STATUS_OK == Deferred_Init(&firmwareLog) &&
+         SIGNALDB_STATUS_OK == SignalDb_Init(&firmwareLog, signalGroups, numSignalGroups) &&
+         CANMONITOR_STATUS_OK == CanMonitor_Init(&firmwareLog) &&
+         CANRECORDER_STATUS_OK == CanRecorder_Init(&firmwareLog) &&
+         WHEELSPEED_STATUS_OK == WheelSpeed_Init(&firmwareLog) &&
+         INVERTER_STATUS_OK == Inverter_Init(&firmwareLog, &hcan1) &&
+         ANALOG_STATUS_OK == Analog_Init(&firmwareLog, analogChannels, numAnalogChannels, MAPPING_ADC1_VREFINT,
+                                         analogBiases, numAnalogBiases) &&
+         VEHICLESTATE_STATUS_OK == VehicleState_Init(&firmwareLog, &hcan1) &&
+         PEDALS_STATUS_OK == Pedals_Init(&firmwareLog) &&
+         TRACTIONCONTROL_STATUS_OK == TractionControl_Init(&firmwareLog) &&
+         GATEWAY_STATUS_OK == Gateway_Init(&firmwareLog, Mapping_GetGatewayConfig());
+}
+
+/**
+ * @brief Per-run draws, all from the seed
+ */
+static void Scenario_Draw(VehicleModel_Params_T* params)
+{
+  // Never zero, for xorshift
+  randomState = config->seed * 2654435761U + 0x9E3779B9U;
+  if (0U == randomState) {
+    randomState = 1U;
+  }
+
+  VehicleModel_Disperse(VehicleModel_GetDefaultParams(), config->seed, params);
+  // Rolling radius against the wheel speed calibration
+  params->wheelRadius *= 1.0f + Scenario_Uniform(-0.01f, 0.01f);
+
+  apps1Cal.gain = Scenario_Uniform(-0.015f, 0.015f);
+  apps1Cal.offset = Scenario_Uniform(-30.0f, 30.0f);
+  apps2Cal.gain = Scenario_Uniform(-0.015f, 0.015f);
+  apps2Cal.offset = Scenario_Uniform(-30.0f, 30.0f);
+  brakeCal.gain = Scenario_Uniform(-0.015f, 0.015f);
+  brakeCal.offset = Scenario_Uniform(-30.0f, 30.0f);
+
+  result->adcNoise = Scenario_Uniform(0.0f, 8.0f);
+  result->pulseJitterUs = Scenario_Uniform(0.0f, 5.0f);
+  result->busJitterUs = Scenario_Uniform(0.0f, 300.0f);
+  result->burstProbability = Scenario_Uniform(0.0f, 0.001f);
+}
+
+static double Scenario_WallSeconds(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// ------------------- Public methods -------------------
+uint32_t Scenario_DeadlineMisses(const Scenario_Result_T* r)
+{
+  return r->commandGapMisses + r->latencyOverruns + r->commandTimeouts +
+         r->taskOverruns + r->monitorTimeouts;
+}
+
+//------------------------------------------------------------------------------
+bool Scenario_Run(const Scenario_Config_T* scenarioConfig, Scenario_Result_T* scenarioResult)
+{
+  double wallStart = Scenario_WallSeconds();
+  config = scenarioConfig;
+  result = scenarioResult;
+  memset(result, 0, sizeof(Scenario_Result_T));
+  result->seed = config->seed;
+  result->launchTime = -1.0f;
+  result->prechargeTime = -1.0f;
+
+  VehicleModel_Params_T params;
+  Scenario_Draw(&params);
+  VehicleModel_T model;
+  VehicleModel_Init(&model, &params);
+  VehicleModel_Output_T output;
+  VehicleModel_GetOutput(&model, &output);
+  double phase[VEHICLEMODEL_NUM_WHEELS] = { 0 };
+
+  // The supply at nominal, and released pedals for the first conversion
+  HostAdc_Set(MAPPING_ADC1_VREFINT, hostVrefintCal);
+  Scenario_SetPedals(0.0f, 0.0f);
+
+  if (!Scenario_InitFirmware()) {
+    return false;
+  }
+  HostCan_SetRxHook(Scenario_Rx);
+  HostCan_SetRxFifo1Hook(Scenario_RxFifo1);
+  HostCan_SetTxHook(Scenario_Tx);
+  HostSim_Start();
+
+  uint64_t steps = (uint64_t)(config->duration * 1000.0);
+  double slipTotal = 0.0;
+  uint32_t slipSamples = 0;
+  uint64_t step;
+  for (step = 0; step < steps; ++step) {
+    uint64_t stepStartNs = step * SCENARIO_STEP_NS;
+    double t = (double)step * 1e-3;
+
+    // Driver
+    bool hvRequest = t >= SCENARIO_HV_TIME;
+    bool starting = t >= SCENARIO_START_TIME && t < SCENARIO_START_TIME + SCENARIO_START_HOLD;
+    bool launching = t >= SCENARIO_LAUNCH_TIME && t < SCENARIO_LAUNCH_TIME + SCENARIO_LAUNCH_HOLD;
+    float throttle = 0.0f;
+    float brake = 0.0f;
+    if (starting) {
+      brake = SCENARIO_START_BRAKE;
+    } else if (launching) {
+      throttle = (float)((t - SCENARIO_LAUNCH_TIME) / SCENARIO_LAUNCH_RAMP);
+      if (throttle > 1.0f) {
+        throttle = 1.0f;
+      }
+    } else if (t >= SCENARIO_LAUNCH_TIME + SCENARIO_LAUNCH_HOLD) {
+      brake = SCENARIO_STOP_BRAKE;
+    }
+    Scenario_SetPedals(throttle, brake);
+
+    // Bus traffic from this step's state
+    if (0U == step % VEHICLESTATE_DASH_PERIOD_MS) {
+      Scenario_SendDash(hvRequest, starting);
+    }
+    if (0U == step % INVERTER_STATUS_PERIOD_MS) {
+      Scenario_SendStatus(&output);
+    }
+    if (0U == step % SCENARIO_BMS_PERIOD_MS) {
+      Scenario_SendBms(&output, &params);
+    }
+
+    // Plant over the step, with the command the inverter has now
+    VehicleModel_Input_T input = {
+      .torqueRequest = commandTorque,
+      .inverterEnable = commandEnable,
+      .hvConnected = hvRequest,
+      .brake = brake,
+    };
+    VehicleModel_Step(&model, &input, SCENARIO_STEP_S);
+    VehicleModel_GetOutput(&model, &output);
+    Scenario_SchedulePulses(phase, &output, &params, stepStartNs);
+
+    // Firmware, up to and including the tick ending the step
+    uint64_t stepEndNs = stepStartNs + SCENARIO_STEP_NS;
+    Scenario_Event_T event;
+    while (numEvents > 0 && events[0].timeNs <= stepEndNs) {
+      Scenario_Pop(&event);
+      Scenario_Deliver(&event);
+    }
+    HostSim_AdvanceTo(stepEndNs);
+
+    // KPIs
+    if (result->prechargeTime < 0.0f && VEHICLESTATE_READY_TO_DRIVE == VehicleState_Get()) {
+      result->prechargeTime = (float)(t + 1e-3 - SCENARIO_HV_TIME);
+    }
+    if (!result->reachedDrive && VEHICLESTATE_DRIVE == VehicleState_Get()) {
+      result->reachedDrive = true;
+      result->timeToDrive = (float)(t + 1e-3 - SCENARIO_START_TIME);
+    }
+    if (launching) {
+      if (output.rearSlip > result->launchSlipMax) {
+        result->launchSlipMax = output.rearSlip;
+      }
+      slipTotal += (double)output.rearSlip;
+      slipSamples++;
+      if (result->launchTime < 0.0f && output.vehicleSpeed >= SCENARIO_LAUNCH_SPEED) {
+        result->launchTime = (float)(output.time - SCENARIO_LAUNCH_TIME);
+      }
+    }
+    if (output.vehicleSpeed > result->maxSpeed) {
+      result->maxSpeed = output.vehicleSpeed;
+    }
+  }
+
+  result->launchSlipMean = (slipSamples > 0) ? (float)(slipTotal / slipSamples) : 0.0f;
+  result->distance = (float)output.distance;
+  result->energyUsed = 1.0f - output.stateOfCharge;
+  result->finalState = (uint8_t)VehicleState_Get();
+
+  VehicleState_Stats_T vehicleState;
+  VehicleState_GetStats(&vehicleState);
+  result->transitions = vehicleState.transitions;
+
+  Inverter_Stats_T inverter;
+  Inverter_GetStats(&inverter);
+  result->latencyOverruns = inverter.latencyOverruns;
+  result->latencyMaxUs = inverter.latencyMaxUs;
+  result->commandTimeouts = inverter.commandTimeouts;
+
+  CanMonitor_Stats_T monitor;
+  CanMonitor_GetStats(&monitor);
+  result->monitorTimeouts = monitor.timeouts;
+  result->taskOverruns = HostTaskTimer_GetOverruns();
+
+  result->wallSeconds = Scenario_WallSeconds() - wallStart;
+  return 0U == eventsDropped;
+}
@@ -0,0 +1,95 @@
+/*
+ * scenario.h
+ *
+ * A closed loop drive scenario: the Application's torque path on the host
+ * simulation, driving lib/vehicleModel.
+ *
+ * The firmware runs from the ADC, wheel speed pulses and CAN, as on the car:
+ *  - A scripted driver requests HV, presses the brake and start, launches
+ *    at full throttle, then lifts off and brakes. The pedal sensors are fed
+ *    to the ADC through their calibration, with per-run errors and noise.
+ *  - Tone wheel pulses are delivered to the EXTI handler at the times the
+ *    model's wheels pass each tooth, with jitter.
+ *  - The inverter is simulated at the far end of the bus. It applies the
+ *    command frames it receives to the model and sends status frames from
+ *    the model. Every frame is delayed by its transmission time, random
+ *    queueing and occasional bursts.
+ *  - A BMS on the chassis bus sends the model's pack voltage, current and
+ *    state of charge, which the gateway forwards to the powertrain bus.
+ *
+ * Everything random is drawn from the seed, so a run can be repeated
+ * exactly. Tasks take no simulated time, so deadline misses come from the
+ * timing of the inputs and the bus, not CPU load.
+ *
+ * The firmware modules hold their state in statics and create static tasks,
+ * so Scenario_Run may only be called once per process.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#ifndef SCENARIO_H_
+#define SCENARIO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+  uint32_t seed;
+  double duration;              /* s, simulated */
+  float maxBurstMs;             /* Longest extra bus delay of a burst */
+} Scenario_Config_T;
+
+typedef struct
+{
+  uint32_t seed;
+
+  // Draws
+  float busJitterUs;            /* Longest queueing delay per frame */
+  float burstProbability;       /* Per frame */
+  float adcNoise;               /* Counts, standard deviation */
+  float pulseJitterUs;          /* Longest pulse timing error */
+
+  // Control KPIs
+  bool reachedDrive;
+  float prechargeTime;          /* s, HV request to READY_TO_DRIVE, negative if not reached */
+  float timeToDrive;            /* s, from the start request */
+  float launchTime;             /* s, throttle to 15 m/s, negative if not reached */
+  float launchSlipMax;          /* Driven axle slip during the launch */
+  float launchSlipMean;
+  float maxSpeed;               /* m/s */
+  float distance;               /* m */
+  float energyUsed;             /* Fraction of the battery */
+  uint8_t finalState;           /* VehicleState_State_T */
+  uint32_t transitions;
+
+  // Deadlines
+  uint32_t commandGapMisses;    /* Commands arriving at the inverter over two periods apart */
+  uint32_t commandGapMaxUs;
+  uint32_t latencyOverruns;     /* As counted by the inverter module */
+  uint32_t latencyMaxUs;
+  uint32_t commandTimeouts;     /* As counted by the inverter module */
+  uint32_t taskOverruns;        /* Task periods started with the previous one not taken */
+  uint32_t monitorTimeouts;     /* CAN messages gone stale */
+
+  // Gateway
+  uint32_t bmsFrames;           /* BMS frames received on the chassis bus */
+  uint32_t bmsForwarded;        /* Of those, forwarded to the powertrain bus unchanged */
+
+  double wallSeconds;
+} Scenario_Result_T;
+
+/**
+ * @brief Total of the deadline misses of a run
+ */
+uint32_t Scenario_DeadlineMisses(const Scenario_Result_T* result);
+
+/**
+ * @brief Run a scenario to completion
+ * @return false if the firmware failed to initialise, or the bus delays
+ * outgrew the event queue
+ */
+bool Scenario_Run(const Scenario_Config_T* config, Scenario_Result_T* result);
+
+#endif /* SCENARIO_H_ */
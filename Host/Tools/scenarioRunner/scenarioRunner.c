@@ -0,0 +1,578 @@
+/*
+ * scenarioRunner.c
+ *
+ * Runs many closed loop drive scenarios (see scenario.h) in parallel, and
+ * aggregates their control KPIs and deadline misses.
+ *
+ * Each run is a separate process, forked from a runner that has not
+ * started the firmware, so every run has its own FreeRTOS simulation and
+ * module state, and a crash only loses that run. Up to -j runs are in
+ * flight at once, one per CPU by default. Run i uses seed -s + i, so any
+ * run can be repeated on its own with -n 1 -s seed.
+ *
+ * With -c, every run is checked against the scripted drive, and the runner
+ * fails if any run does not pass. This is what ctest runs.
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Liam Flaherty
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "scenario.h"
+
+#include "vehicleProcesses/vehicleState/vehicleState.h"
+
+// ------------------- Private data -------------------
+typedef struct
+{
+  uint32_t runs;
+  uint32_t jobs;
+  uint32_t seed;
+  Scenario_Config_T scenario;
+  const char* csvPath;
+  bool check;
+} ScenarioRunner_Options_T;
+
+typedef enum
+{
+  SCENARIORUNNER_RUN_PENDING,
+  SCENARIORUNNER_RUN_DONE,
+  SCENARIORUNNER_RUN_FAILED     /* Crashed, or the firmware didn't start */
+} ScenarioRunner_RunStatus_T;
+
+typedef struct
+{
+  ScenarioRunner_RunStatus_T status;
+  int exitStatus;               /* From waitpid, for failed runs */
+  Scenario_Result_T result;
+} ScenarioRunner_Run_T;
+
+typedef struct
+{
+  pid_t pid;
+  int fd;                       /* Read end of the result pipe */
+  uint32_t run;
+} ScenarioRunner_Job_T;
+
+/*
+ * A KPI in the summary
+ */
+typedef struct
+{
+  const char* name;
+  const char* unit;
+  float (*get)(const Scenario_Result_T* result, bool* present);
+} ScenarioRunner_Kpi_T;
+
+static const char* const stateNames[VEHICLESTATE_NUM_STATES] = {
+  [VEHICLESTATE_LV_ON]          = "LV_ON",
+  [VEHICLESTATE_PRECHARGE]      = "PRECHARGE",
+  [VEHICLESTATE_READY_TO_DRIVE] = "READY_TO_DRIVE",
+  [VEHICLESTATE_DRIVE]          = "DRIVE",
+  [VEHICLESTATE_FAULT]          = "FAULT",
+};
+
+// LV_ON, PRECHARGE, READY_TO_DRIVE, DRIVE, with nothing in between
+#define SCENARIORUNNER_DRIVE_TRANSITIONS  3U
+
+// The DC link charges over a few of the model's time constants, well inside
+// the state machine's timeout
+#define SCENARIORUNNER_MIN_PRECHARGE_S    0.2f
+#define SCENARIORUNNER_MAX_PRECHARGE_S    ((float)VEHICLESTATE_PRECHARGE_TIMEOUT_MS / 1000.0f)
+
+// The start request goes out in the next dash frame, so DRIVE follows
+// within a dash period, a bus burst and a cycle to act on it
+#define SCENARIORUNNER_MIN_TIME_TO_DRIVE_S  ((float)VEHICLESTATE_PERIOD_MS / 1000.0f)
+
+// ------------------- Private methods -------------------
+static float ScenarioRunner_PrechargeTime(const Scenario_Result_T* r, bool* present)
+{
+  *present = r->prechargeTime >= 0.0f;
+  return r->prechargeTime;
+}
+
+static float ScenarioRunner_TimeToDrive(const Scenario_Result_T* r, bool* present)
+{
+  *present = r->reachedDrive;
+  return r->timeToDrive;
+}
+
+static float ScenarioRunner_LaunchTime(const Scenario_Result_T* r, bool* present)
+{
+  *present = r->launchTime >= 0.0f;
+  return r->launchTime;
+}
+
+static float ScenarioRunner_LaunchSlipMax(const Scenario_Result_T* r, bool* present)
+{
+  *present = r->reachedDrive;
+  return r->launchSlipMax;
+}
+
+static float ScenarioRunner_LaunchSlipMean(const Scenario_Result_T* r, bool* present)
+{
+  *present = r->reachedDrive;
+  return r->launchSlipMean;
+}
+
+static float ScenarioRunner_MaxSpeed(const Scenario_Result_T* r, bool* present)
+{
+  *present = true;
+  return r->maxSpeed;
+}
+
+static float ScenarioRunner_Distance(const Scenario_Result_T* r, bool* present)
+{
+  *present = true;
+  return r->distance;
+}
+
+static float ScenarioRunner_EnergyUsed(const Scenario_Result_T* r, bool* present)
+{
+  *present = true;
+  return 100.0f * r->energyUsed;
+}
+
+static float ScenarioRunner_LatencyMax(const Scenario_Result_T* r, bool* present)
+{
+  *present = true;
+  return (float)r->latencyMaxUs;
+}
+
+static float ScenarioRunner_CommandGapMax(const Scenario_Result_T* r, bool* present)
+{
+  *present = true;
+  return (float)r->commandGapMaxUs;
+}
+
+static const ScenarioRunner_Kpi_T kpis[] = {
+  { "precharge time",     "s",    ScenarioRunner_PrechargeTime },
+  { "time to drive",      "s",    ScenarioRunner_TimeToDrive },
+  { "0-15 m/s",           "s",    ScenarioRunner_LaunchTime },
+  { "launch slip max",    "",     ScenarioRunner_LaunchSlipMax },
+  { "launch slip mean",   "",     ScenarioRunner_LaunchSlipMean },
+  { "max speed",          "m/s",  ScenarioRunner_MaxSpeed },
+  { "distance",           "m",    ScenarioRunner_Distance },
+  { "energy used",        "%",    ScenarioRunner_EnergyUsed },
+  { "command latency max", "us",  ScenarioRunner_LatencyMax },
+  { "command gap max",    "us",   ScenarioRunner_CommandGapMax },
+};
+#define SCENARIORUNNER_NUM_KPIS (sizeof(kpis) / sizeof(kpis[0]))
+
+static int ScenarioRunner_CompareFloat(const void* a, const void* b)
+{
+  float x = *(const float*)a;
+  float y = *(const float*)b;
+  return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/**
+ * @brief Nearest rank percentile of sorted values
+ */
+static float ScenarioRunner_Percentile(const float* sorted, uint32_t n, float fraction)
+{
+  uint32_t rank = (uint32_t)(fraction * (float)(n - 1U) + 0.5f);
+  return sorted[rank];
+}
+
+static double ScenarioRunner_WallSeconds(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Runs a scenario in a child process, which writes its result to a pipe
+ */
+static bool ScenarioRunner_Start(const ScenarioRunner_Options_T* options, uint32_t run, ScenarioRunner_Job_T* job)
+{
+  int fds[2];
+  if (0 != pipe(fds)) {
+    return false;
+  }
+
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+
+  if (0 == pid) {
+    close(fds[0]);
+    Scenario_Config_T config = options->scenario;
+    config.seed = options->seed + run;
+    Scenario_Result_T result;
+    bool ok = Scenario_Run(&config, &result);
+    ssize_t written = ok ? write(fds[1], &result, sizeof(result)) : 0;
+    _exit((ok && written == (ssize_t)sizeof(result)) ? 0 : 2);
+  }
+
+  close(fds[1]);
+  job->pid = pid;
+  job->fd = fds[0];
+  job->run = run;
+  return true;
+}
+
+static void ScenarioRunner_Finish(ScenarioRunner_Job_T* job, int exitStatus, ScenarioRunner_Run_T* runs)
+{
+  ScenarioRunner_Run_T* run = &runs[job->run];
+  size_t got = 0;
+  while (got < sizeof(Scenario_Result_T)) {
+    ssize_t n = read(job->fd, (uint8_t*)&run->result + got, sizeof(Scenario_Result_T) - got);
+    if (n <= 0) {
+      break;
+    }
+    got += (size_t)n;
+  }
+  close(job->fd);
+
+  bool exited = WIFEXITED(exitStatus) && 0 == WEXITSTATUS(exitStatus);
+  run->status = (exited && got == sizeof(Scenario_Result_T)) ? SCENARIORUNNER_RUN_DONE : SCENARIORUNNER_RUN_FAILED;
+  run->exitStatus = exitStatus;
+  job->pid = 0;
+}
+
+static void ScenarioRunner_WriteCsv(FILE* file, const ScenarioRunner_Run_T* runs, uint32_t numRuns)
+{
+  fprintf(file, "seed,status,final_state,transitions,precharge_time_s,time_to_drive_s,launch_time_s,"
+      "launch_slip_max,launch_slip_mean,max_speed,distance,energy_used,"
+      "command_gap_misses,command_gap_max_us,latency_overruns,latency_max_us,command_timeouts,"
+      "task_overruns,monitor_timeouts,bms_frames,bms_forwarded,bus_jitter_us,burst_probability,adc_noise,pulse_jitter_us\n");
+
+  uint32_t i;
+  for (i = 0; i < numRuns; ++i) {
+    const Scenario_Result_T* r = &runs[i].result;
+    if (SCENARIORUNNER_RUN_DONE != runs[i].status) {
+      fprintf(file, "%u,failed\n", r->seed);
+      continue;
+    }
+    fprintf(file, "%u,ok,%s,%u,%.3f,%.3f,%.3f,%.4f,%.4f,%.3f,%.2f,%.5f,%u,%u,%u,%u,%u,%u,%u,%u,%u,%.1f,%.5f,%.2f,%.2f\n",
+        r->seed, stateNames[r->finalState], r->transitions, r->prechargeTime,
+        r->reachedDrive ? r->timeToDrive : -1.0f, r->launchTime,
+        r->launchSlipMax, r->launchSlipMean, r->maxSpeed, r->distance, r->energyUsed,
+        r->commandGapMisses, r->commandGapMaxUs, r->latencyOverruns, r->latencyMaxUs, r->commandTimeouts,
+        r->taskOverruns, r->monitorTimeouts, r->bmsFrames, r->bmsForwarded,
+        r->busJitterUs, r->burstProbability, r->adcNoise, r->pulseJitterUs);
+  }
+}
+
+static void ScenarioRunner_Summary(const ScenarioRunner_Options_T* options, const ScenarioRunner_Run_T* runs,
+                                   double wallSeconds)
+{
+  uint32_t done = 0;
+  uint32_t reachedDrive = 0;
+  uint32_t finalStates[VEHICLESTATE_NUM_STATES] = { 0 };
+  uint32_t i;
+  for (i = 0; i < options->runs; ++i) {
+    if (SCENARIORUNNER_RUN_DONE == runs[i].status) {
+      done++;
+      reachedDrive += runs[i].result.reachedDrive ? 1U : 0U;
+      finalStates[runs[i].result.finalState]++;
+    }
+  }
+
+  double simulated = options->scenario.duration * (double)done;
+  printf("Ran %u scenarios of %.1f s, %u at a time, in %.2f s (%.0fx real time)\n",
+      options->runs, options->scenario.duration, options->jobs, wallSeconds,
+      (wallSeconds > 0.0) ? simulated / wallSeconds : 0.0);
+  printf("  completed %u, failed %u, reached DRIVE %u\n", done, options->runs - done, reachedDrive);
+  for (i = 0; i < options->runs; ++i) {
+    if (SCENARIORUNNER_RUN_FAILED == runs[i].status) {
+      int status = runs[i].exitStatus;
+      if (WIFSIGNALED(status)) {
+        printf("  seed %u: killed by signal %d\n", options->seed + i, WTERMSIG(status));
+      } else {
+        printf("  seed %u: exit status %d\n", options->seed + i, WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+      }
+    }
+  }
+  printf("  final state:");
+  for (i = 0; i < VEHICLESTATE_NUM_STATES; ++i) {
+    if (finalStates[i] > 0) {
+      printf(" %s %u", stateNames[i], finalStates[i]);
+    }
+  }
+  printf("\n");
+  if (0 == done) {
+    return;
+  }
+
+  // KPI distributions, over the runs they apply to
+  float* values = malloc(done * sizeof(float));
+  if (NULL == values) {
+    return;
+  }
+  printf("%-20s %6s %6s %10s %10s %10s %10s %10s\n", "KPI", "unit", "runs", "min", "p5", "p50", "p95", "max");
+  size_t k;
+  for (k = 0; k < SCENARIORUNNER_NUM_KPIS; ++k) {
+    uint32_t n = 0;
+    for (i = 0; i < options->runs; ++i) {
+      bool present;
+      if (SCENARIORUNNER_RUN_DONE == runs[i].status) {
+        float value = kpis[k].get(&runs[i].result, &present);
+        if (present) {
+          values[n++] = value;
+        }
+      }
+    }
+    if (0 == n) {
+      printf("%-20s %6s %6u\n", kpis[k].name, kpis[k].unit, 0U);
+      continue;
+    }
+    qsort(values, n, sizeof(float), ScenarioRunner_CompareFloat);
+    printf("%-20s %6s %6u %10.4g %10.4g %10.4g %10.4g %10.4g\n", kpis[k].name, kpis[k].unit, n,
+        values[0], ScenarioRunner_Percentile(values, n, 0.05f), ScenarioRunner_Percentile(values, n, 0.5f),
+        ScenarioRunner_Percentile(values, n, 0.95f), values[n - 1U]);
+  }
+  free(values);
+
+  // Deadline misses
+  uint64_t gapMisses = 0;
+  uint64_t latencyOverruns = 0;
+  uint64_t commandTimeouts = 0;
+  uint64_t taskOverruns = 0;
+  uint64_t monitorTimeouts = 0;
+  uint32_t runsWithMisses = 0;
+  uint32_t worstMisses = 0;
+  uint32_t worstSeed = 0;
+  for (i = 0; i < options->runs; ++i) {
+    if (SCENARIORUNNER_RUN_DONE != runs[i].status) {
+      continue;
+    }
+    const Scenario_Result_T* r = &runs[i].result;
+    gapMisses += r->commandGapMisses;
+    latencyOverruns += r->latencyOverruns;
+    commandTimeouts += r->commandTimeouts;
+    taskOverruns += r->taskOverruns;
+    monitorTimeouts += r->monitorTimeouts;
+
+    uint32_t misses = Scenario_DeadlineMisses(r);
+    if (misses > 0) {
+      runsWithMisses++;
+    }
+    if (misses > worstMisses) {
+      worstMisses = misses;
+      worstSeed = r->seed;
+    }
+  }
+  printf("Deadline misses: %u of %u runs\n", runsWithMisses, done);
+  printf("  command gaps over %u ms at the inverter %llu, command latency overruns %llu,\n"
+         "  command timeouts %llu, task overruns %llu, CAN monitor timeouts %llu\n",
+      2U, (unsigned long long)gapMisses, (unsigned long long)latencyOverruns,
+      (unsigned long long)commandTimeouts, (unsigned long long)taskOverruns,
+      (unsigned long long)monitorTimeouts);
+  if (worstMisses > 0) {
+    printf("  most in one run: %u, seed %u\n", worstMisses, worstSeed);
+  }
+}
+
+/**
+ * @brief Checks a run against the scripted drive
+ * @return false, with the reason, if it fails
+ */
+static bool ScenarioRunner_Check(const Scenario_Config_T* config, const Scenario_Result_T* r,
+                                 char* reason, size_t size)
+{
+  const float maxTimeToDrive = ((float)(VEHICLESTATE_DASH_PERIOD_MS + 2U * VEHICLESTATE_PERIOD_MS) +
+                                config->maxBurstMs) / 1000.0f;
+
+  if (!r->reachedDrive) {
+    snprintf(reason, size, "didn't reach DRIVE, final state %s", stateNames[r->finalState]);
+    return false;
+  }
+  if (SCENARIORUNNER_DRIVE_TRANSITIONS != r->transitions) {
+    snprintf(reason, size, "%u transitions, expected %u", r->transitions, SCENARIORUNNER_DRIVE_TRANSITIONS);
+    return false;
+  }
+  if (r->prechargeTime < SCENARIORUNNER_MIN_PRECHARGE_S || r->prechargeTime > SCENARIORUNNER_MAX_PRECHARGE_S) {
+    snprintf(reason, size, "precharge took %.3f s, expected %.3f to %.3f s", r->prechargeTime,
+        SCENARIORUNNER_MIN_PRECHARGE_S, SCENARIORUNNER_MAX_PRECHARGE_S);
+    return false;
+  }
+  if (r->timeToDrive < SCENARIORUNNER_MIN_TIME_TO_DRIVE_S || r->timeToDrive > maxTimeToDrive) {
+    snprintf(reason, size, "time to drive %.3f s, expected %.3f to %.3f s", r->timeToDrive,
+        SCENARIORUNNER_MIN_TIME_TO_DRIVE_S, maxTimeToDrive);
+    return false;
+  }
+  // The firmware's own deadlines. Gaps at the inverter come from the
+  // simulated bus delays, so they are reported but not checked.
+  if (r->latencyOverruns > 0 || r->commandTimeouts > 0) {
+    snprintf(reason, size, "%u command latency overruns, %u command timeouts", r->latencyOverruns,
+        r->commandTimeouts);
+    return false;
+  }
+  if (0U == r->bmsFrames || r->bmsForwarded != r->bmsFrames) {
+    snprintf(reason, size, "%u of %u BMS frames forwarded to the powertrain bus", r->bmsForwarded,
+        r->bmsFrames);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Reports the runs that fail their checks
+ * @return The number that failed
+ */
+static uint32_t ScenarioRunner_CheckRuns(const ScenarioRunner_Options_T* options, const ScenarioRunner_Run_T* runs)
+{
+  uint32_t failed = 0;
+  uint32_t i;
+  for (i = 0; i < options->runs; ++i) {
+    char reason[128];
+    if (SCENARIORUNNER_RUN_DONE == runs[i].status && !ScenarioRunner_Check(&options->scenario, &runs[i].result, reason, sizeof(reason))) {
+      printf("  check failed, seed %u: %s\n", runs[i].result.seed, reason);
+      failed++;
+    }
+  }
+  printf("Checks: %u of %u runs failed\n", failed, options->runs);
+  return failed;
+}
+
+static void ScenarioRunner_Usage(const char* name)
+{
+  fprintf(stderr,
+      "usage: %s [options]\n"
+      "  -n runs          number of scenarios, default 100\n"
+      "  -j jobs          scenarios run at once, one per CPU by default\n"
+      "  -s seed          seed of the first run, default 1\n"
+      "  -t seconds       simulated length of each run, default 8\n"
+      "  -b ms            longest bus delay burst, default 5\n"
+      "  -o file          write a CSV line per run\n"
+      "  -c               check every run against the scripted drive\n",
+      name);
+}
+
+// ------------------- Main -------------------
+int main(int argc, char* argv[])
+{
+  ScenarioRunner_Options_T options = {
+    .runs = 100U,
+    .jobs = 0U,
+    .seed = 1U,
+    .scenario = { .duration = 8.0, .maxBurstMs = 5.0f },
+    .csvPath = NULL,
+    .check = false,
+  };
+
+  int opt;
+  while (-1 != (opt = getopt(argc, argv, "n:j:s:t:b:o:c"))) {
+    switch (opt) {
+      case 'n':
+        options.runs = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'j':
+        options.jobs = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 's':
+        options.seed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 't':
+        options.scenario.duration = atof(optarg);
+        break;
+      case 'b':
+        options.scenario.maxBurstMs = (float)atof(optarg);
+        break;
+      case 'o':
+        options.csvPath = optarg;
+        break;
+      case 'c':
+        options.check = true;
+        break;
+      default:
+        ScenarioRunner_Usage(argv[0]);
+        return 1;
+    }
+  }
+  if (optind != argc || 0U == options.runs || options.scenario.duration <= 0.0 ||
+      options.scenario.maxBurstMs < 0.0f) {
+    ScenarioRunner_Usage(argv[0]);
+    return 1;
+  }
+  if (0U == options.jobs) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    options.jobs = (cpus > 0) ? (uint32_t)cpus : 1U;
+  }
+  if (options.jobs > options.runs) {
+    options.jobs = options.runs;
+  }
+
+  ScenarioRunner_Run_T* runs = calloc(options.runs, sizeof(ScenarioRunner_Run_T));
+  ScenarioRunner_Job_T* jobs = calloc(options.jobs, sizeof(ScenarioRunner_Job_T));
+  if (NULL == runs || NULL == jobs) {
+    fprintf(stderr, "Out of memory\n");
+    return 1;
+  }
+  uint32_t i;
+  for (i = 0; i < options.runs; ++i) {
+    runs[i].result.seed = options.seed + i;
+  }
+
+  double wallStart = ScenarioRunner_WallSeconds();
+  uint32_t next = 0;
+  uint32_t running = 0;
+  while (next < options.runs || running > 0) {
+    // Fill the free job slots
+    for (i = 0; i < options.jobs && next < options.runs; ++i) {
+      if (0 == jobs[i].pid) {
+        if (!ScenarioRunner_Start(&options, next, &jobs[i])) {
+          fprintf(stderr, "Can't start run %u: %s\n", next, strerror(errno));
+          return 1;
+        }
+        next++;
+        running++;
+      }
+    }
+
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      fprintf(stderr, "waitpid: %s\n", strerror(errno));
+      return 1;
+    }
+    for (i = 0; i < options.jobs; ++i) {
+      if (jobs[i].pid == pid) {
+        ScenarioRunner_Finish(&jobs[i], status, runs);
+        running--;
+        break;
+      }
+    }
+  }
+  double wallSeconds = ScenarioRunner_WallSeconds() - wallStart;
+
+  if (NULL != options.csvPath) {
+    FILE* csvFile = fopen(options.csvPath, "w");
+    if (NULL == csvFile) {
+      fprintf(stderr, "Can't write %s\n", options.csvPath);
+      return 1;
+    }
+    ScenarioRunner_WriteCsv(csvFile, runs, options.runs);
+    fclose(csvFile);
+  }
+
+  ScenarioRunner_Summary(&options, runs, wallSeconds);
+
+  bool failed = false;
+  for (i = 0; i < options.runs; ++i) {
+    failed |= (SCENARIORUNNER_RUN_DONE != runs[i].status);
+  }
+  if (options.check) {
+    failed |= (ScenarioRunner_CheckRuns(&options, runs) > 0);
+  }
+  free(jobs);
+  free(runs);
+  return failed ? 1 : 0;
+}